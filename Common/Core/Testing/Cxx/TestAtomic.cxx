@@ -0,0 +1,112 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAtomic.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkAtomicInt.
+// .SECTION Description
+// Hammers vtkAtomicInt and the reference count of a shared vtkObject
+// from several threads and checks that no update is lost.
+
+#include "vtkAtomicInt.h"
+#include "vtkIntArray.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+
+static const int NumberOfIterations = 100000;
+
+struct AtomicTestData
+{
+  vtkAtomicInt<vtkTypeInt32> Count32;
+  vtkAtomicInt<vtkTypeInt64> Count64;
+  vtkAtomicInt<vtkTypeInt32> Down32;
+  vtkObject* Shared;
+};
+
+static VTK_THREAD_RETURN_TYPE AtomicTestThread(void* arg)
+{
+  AtomicTestData* data = static_cast<AtomicTestData*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+  for (int i = 0; i < NumberOfIterations; ++i)
+    {
+    ++data->Count32;
+    data->Count64 += 2;
+    data->Down32--;
+    data->Shared->Register(0);
+    }
+  for (int i = 0; i < NumberOfIterations; ++i)
+    {
+    data->Shared->UnRegister(0);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+int TestAtomic(int, char *[])
+{
+  int result = EXIT_SUCCESS;
+
+  // Single threaded semantics.
+  vtkAtomicInt<vtkTypeInt32> a(5);
+  if (++a != 6 || a++ != 6 || a != 7 || --a != 6 || a-- != 6 || a != 5 ||
+      (a += 10) != 15 || (a -= 20) != -5)
+    {
+    cerr << "vtkAtomicInt<vtkTypeInt32> arithmetic is wrong" << endl;
+    result = EXIT_FAILURE;
+    }
+  const vtkTypeInt64 big = static_cast<vtkTypeInt64>(1) << 40;
+  vtkAtomicInt<vtkTypeInt64> b;
+  b = big - 1;
+  ++b;
+  if (b.Load() != big)
+    {
+    cerr << "vtkAtomicInt<vtkTypeInt64> does not hold 64 bit values" << endl;
+    result = EXIT_FAILURE;
+    }
+
+  // Concurrent updates.
+  AtomicTestData data;
+  data.Down32 = 0;
+  vtkNew<vtkIntArray> shared;
+  data.Shared = shared.GetPointer();
+
+  vtkNew<vtkMultiThreader> threader;
+  threader->SetNumberOfThreads(8);
+  threader->SetSingleMethod(AtomicTestThread, &data);
+  threader->SingleMethodExecute();
+
+  int numThreads = threader->GetNumberOfThreads();
+  if (data.Count32 != numThreads * NumberOfIterations)
+    {
+    cerr << "Count32 is " << data.Count32 << " instead of "
+         << numThreads * NumberOfIterations << endl;
+    result = EXIT_FAILURE;
+    }
+  if (data.Count64 != static_cast<vtkTypeInt64>(2) * numThreads *
+      NumberOfIterations)
+    {
+    cerr << "Count64 is " << data.Count64 << endl;
+    result = EXIT_FAILURE;
+    }
+  if (data.Down32 != -numThreads * NumberOfIterations)
+    {
+    cerr << "Down32 is " << data.Down32 << endl;
+    result = EXIT_FAILURE;
+    }
+  if (shared->GetReferenceCount() != 1)
+    {
+    cerr << "Reference count is " << shared->GetReferenceCount()
+         << " instead of 1" << endl;
+    result = EXIT_FAILURE;
+    }
+
+  return result;
+}
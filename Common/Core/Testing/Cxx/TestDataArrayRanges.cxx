@@ -0,0 +1,227 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayRanges.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the cached component/magnitude ranges of vtkDataArray
+// .SECTION Description
+// Checks GetRange() and GetFiniteRange() on all components and on the
+// magnitude, and that the ranges are cached until the array is modified.
+// Also checks that the native value range of 64 bit arrays is exact.
+
+#include "vtkBitArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkTypeInt64Array.h"
+
+#include <cstdlib>
+
+namespace
+{
+bool RangeIs(double range[2], double lo, double hi)
+{
+  return range[0] == lo && range[1] == hi;
+}
+}
+
+int TestDataArrayRanges(int, char *[])
+{
+  const vtkIdType numTuples = 10000;
+  double range[2];
+
+  // Two components: t and -2t; magnitude is sqrt(5)*t.
+  vtkNew<vtkDoubleArray> array;
+  array->SetNumberOfComponents(2);
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    array->SetTuple2(t, t, -2.0 * t);
+    }
+  array->GetRange(range, 1);
+  if (!RangeIs(range, -2.0 * (numTuples - 1), 0.0))
+    {
+    cerr << "Bad range for component 1: " << range[0] << " " << range[1]
+         << endl;
+    return EXIT_FAILURE;
+    }
+  array->GetRange(range, 0);
+  if (!RangeIs(range, 0.0, numTuples - 1))
+    {
+    cerr << "Bad range for component 0: " << range[0] << " " << range[1]
+         << endl;
+    return EXIT_FAILURE;
+    }
+  array->GetRange(range, -1);
+  if (range[0] != 0.0 || fabs(range[1] - sqrt(5.0) * (numTuples - 1)) >= 1e-9)
+    {
+    cerr << "Bad magnitude range: " << range[0] << " " << range[1]
+         << endl;
+    return EXIT_FAILURE;
+    }
+
+  // All the ranges were cached by the first call: changing the values
+  // without Modified() must not change them.
+  array->GetPointer(0)[0] = -100.0;
+  array->GetRange(range, 0);
+  if (!RangeIs(range, 0.0, numTuples - 1))
+    {
+    cerr << "Range was not cached" << endl;
+    return EXIT_FAILURE;
+    }
+  array->Modified();
+  array->GetRange(range, 0);
+  if (!RangeIs(range, -100.0, numTuples - 1))
+    {
+    cerr << "Range was not recomputed after Modified()" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Non-finite values.
+  array->SetComponent(1, 0, vtkMath::Nan());
+  array->SetComponent(2, 1, vtkMath::Inf());
+  array->SetComponent(3, 1, vtkMath::NegInf());
+  array->Modified();
+  array->GetRange(range, 1);
+  if (!vtkMath::IsInf(range[0]) || !vtkMath::IsInf(range[1]))
+    {
+    cerr << "Infinite values must be part of the range" << endl;
+    return EXIT_FAILURE;
+    }
+  array->GetFiniteRange(range, 1);
+  if (!RangeIs(range, -2.0 * (numTuples - 1), 0.0))
+    {
+    cerr << "Bad finite range: " << range[0] << " " << range[1]
+         << endl;
+    return EXIT_FAILURE;
+    }
+  array->GetFiniteRange(range, 0);
+  if (!RangeIs(range, -100.0, numTuples - 1))
+    {
+    cerr << "Bad finite range: " << range[0] << " " << range[1]
+         << endl;
+    return EXIT_FAILURE;
+    }
+  array->GetFiniteRange(range, -1);
+  if (fabs(range[0] - sqrt(5.0) * 4) >= 1e-9 ||
+      fabs(range[1] - sqrt(5.0) * (numTuples - 1)) >= 1e-9)
+    {
+    cerr << "Bad finite magnitude range: " << range[0] << " " << range[1]
+         << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Integer array and its native value range.
+  vtkNew<vtkIntArray> ints;
+  for (int i = 0; i < 100; ++i)
+    {
+    ints->InsertNextValue(50 - i);
+    }
+  ints->GetFiniteRange(range);
+  if (!RangeIs(range, -49.0, 50.0))
+    {
+    cerr << "Bad int range" << endl;
+    return EXIT_FAILURE;
+    }
+  int* valueRange = ints->GetValueRange(0);
+  if (valueRange[0] != -49 || valueRange[1] != 50)
+    {
+    cerr << "Bad value range" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // 64 bit values that a double rounds: the value range is exact.
+  const vtkTypeInt64 big = static_cast<vtkTypeInt64>(1) << 62;
+  vtkNew<vtkTypeInt64Array> longs;
+  longs->SetNumberOfComponents(2);
+  for (int i = 0; i < 100; ++i)
+    {
+    longs->InsertNextTuple2(0, 0);
+    }
+  for (int i = 0; i < 100; ++i)
+    {
+    longs->SetValue(2 * i, big + 3 * i + 1);
+    longs->SetValue(2 * i + 1, -big - 5 * i - 1);
+    }
+  longs->Modified();
+  vtkTypeInt64 longRange[2];
+  longs->GetValueRange(longRange, 0);
+  if (longRange[0] != big + 1 || longRange[1] != big + 298)
+    {
+    cerr << "Bad 64 bit value range" << endl;
+    return EXIT_FAILURE;
+    }
+  longs->GetValueRange(longRange, 1);
+  if (longRange[0] != -big - 496 || longRange[1] != -big - 1)
+    {
+    cerr << "Bad 64 bit value range" << endl;
+    return EXIT_FAILURE;
+    }
+  longs->SetValue(0, big + 1000);
+  longs->Modified();
+  if (longs->GetValueRange(0)[1] != big + 1000)
+    {
+    cerr << "64 bit value range was not recomputed after Modified()" << endl;
+    return EXIT_FAILURE;
+    }
+#ifdef VTK_USE_64BIT_IDS
+  vtkNew<vtkIdTypeArray> ids;
+  ids->InsertNextValue(big + 7);
+  ids->InsertNextValue(big + 5);
+  if (ids->GetValueRange()[0] != big + 5 || ids->GetValueRange()[1] != big + 7)
+    {
+    cerr << "Bad id value range" << endl;
+    return EXIT_FAILURE;
+    }
+#endif
+
+  // Struct-of-arrays and bit arrays go through the same code.
+  vtkSmartPointer<vtkSOADataArrayTemplate<float> > soa =
+    vtkSmartPointer<vtkSOADataArrayTemplate<float> >::New();
+  soa->SetNumberOfComponents(3);
+  soa->SetNumberOfTuples(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    soa->SetTuple3(t, 1.0, t % 7, -t);
+    }
+  soa->GetRange(range, 1);
+  if (!RangeIs(range, 0.0, 6.0))
+    {
+    cerr << "Bad SOA range" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkBitArray> bits;
+  bits->InsertNextValue(0);
+  bits->InsertNextValue(1);
+  bits->GetRange(range);
+  if (!RangeIs(range, 0.0, 1.0))
+    {
+    cerr << "Bad bit range" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Empty arrays report an invalid range.
+  vtkNew<vtkDoubleArray> empty;
+  empty->GetRange(range);
+  if (!RangeIs(range, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN))
+    {
+    cerr << "Bad range for an empty array" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
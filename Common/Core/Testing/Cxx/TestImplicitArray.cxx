@@ -0,0 +1,263 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkImplicitArray and the functions of
+// vtkImplicitArrayFunctions.h
+// .SECTION Description
+// Checks the values, ranges and materialization of implicit arrays, also
+// from several threads, and that they can be copied into regular arrays.
+
+#include "vtkAtomicInt.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkImplicitArray.h"
+#include "vtkImplicitArrayFunctions.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMPTools.h"
+
+#include <cstdlib>
+
+// Materializes an array from several threads and checks the values.
+class GetVoidPointerFunctor
+{
+public:
+  vtkDataArray* Array;
+  vtkAtomicInt<int> Failures;
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      double* values = static_cast<double*>(this->Array->GetVoidPointer(0));
+      vtkIdType t = i % this->Array->GetNumberOfTuples();
+      if (!values || values[t] != static_cast<double>(t))
+        {
+        ++this->Failures;
+        }
+      }
+  }
+};
+
+int TestImplicitArray(int, char *[])
+{
+  const vtkIdType numTuples = 1000;
+  double range[2];
+
+  // Constant, one value per component.
+  typedef vtkImplicitArray<float, vtkConstantFunction<float> > ConstantArray;
+  vtkSmartPointer<ConstantArray> constant =
+    vtkSmartPointer<ConstantArray>::New();
+  float values[3] = { 1.0f, 2.0f, 3.0f };
+  constant->SetNumberOfComponents(3);
+  constant->SetFunction(vtkConstantFunction<float>(values, 3));
+  constant->SetNumberOfTuples(numTuples);
+  if (constant->GetNumberOfTuples() != numTuples ||
+      constant->GetDataType() != VTK_FLOAT)
+    {
+    cerr << "Wrong shape or type" << endl;
+    return EXIT_FAILURE;
+    }
+  if (constant->GetComponent(999, 2) != 3.0 ||
+      constant->GetTuple(500)[1] != 2.0)
+    {
+    cerr << "Wrong constant values" << endl;
+    return EXIT_FAILURE;
+    }
+  constant->GetRange(range, 1);
+  if (range[0] != 2.0 || range[1] != 2.0)
+    {
+    cerr << "Wrong constant range" << endl;
+    return EXIT_FAILURE;
+    }
+  if (constant->GetActualMemorySize() != 1)
+    {
+    cerr << "Constant array takes memory" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Affine.
+  typedef vtkImplicitArray<double, vtkAffineFunction<double> > AffineArray;
+  vtkSmartPointer<AffineArray> affine = vtkSmartPointer<AffineArray>::New();
+  affine->SetFunction(vtkAffineFunction<double>(0.5, -10.0));
+  affine->SetNumberOfTuples(numTuples);
+  if (affine->GetValue(100) != 40.0)
+    {
+    cerr << "Wrong affine value" << endl;
+    return EXIT_FAILURE;
+    }
+  affine->GetRange(range);
+  if (range[0] != -10.0 || range[1] != 0.5 * 999 - 10.0)
+    {
+    cerr << "Wrong affine range" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Materialization.
+  double* pointer = static_cast<double*>(affine->GetVoidPointer(0));
+  if (!pointer || pointer[998] != 0.5 * 998 - 10.0)
+    {
+    cerr << "Wrong materialized values" << endl;
+    return EXIT_FAILURE;
+    }
+  if (affine->GetVoidPointer(0) != pointer)
+    {
+    cerr << "The values were materialized twice" << endl;
+    return EXIT_FAILURE;
+    }
+  affine->SetFunction(vtkAffineFunction<double>(1.0, 0.0));
+  pointer = static_cast<double*>(affine->GetVoidPointer(0));
+  if (pointer[998] != 998.0)
+    {
+    cerr << "Stale materialized values" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkDataArray* regular = affine->NewMaterializedArray();
+  if (!vtkDoubleArray::SafeDownCast(regular) ||
+      regular->GetNumberOfTuples() != numTuples ||
+      regular->GetComponent(321, 0) != 321.0)
+    {
+    cerr << "Wrong materialized array" << endl;
+    return EXIT_FAILURE;
+    }
+  regular->Delete();
+
+  // Concurrent readers all get the same, complete values.
+  vtkSMPTools::Initialize(4);
+  affine->Modified();
+  GetVoidPointerFunctor readers;
+  readers.Array = affine;
+  vtkSMPTools::For(0, 64, 1, readers);
+  vtkSMPTools::Initialize(0);
+  if (readers.Failures != 0)
+    {
+    cerr << readers.Failures << " concurrent GetVoidPointer calls failed"
+         << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Read-only, and regular arrays from NewInstance().
+  vtkDataArray* typed = affine->NewInstance();
+  if (!vtkDoubleArray::SafeDownCast(typed))
+    {
+    cerr << "NewInstance() did not return a regular array" << endl;
+    return EXIT_FAILURE;
+    }
+  typed->Delete();
+  vtkDataArray* base = affine;
+  vtkDataArray* instance = base->NewInstance();
+  if (!vtkDoubleArray::SafeDownCast(instance))
+    {
+    cerr << "NewInstance() did not return a regular array" << endl;
+    return EXIT_FAILURE;
+    }
+  instance->SetNumberOfTuples(2);
+  instance->SetTuple(0, 42, affine);
+  instance->InsertTuple(1, 43, affine);
+  if (instance->GetComponent(1, 0) != 43.0)
+    {
+    cerr << "Copy into a regular array failed" << endl;
+    return EXIT_FAILURE;
+    }
+  instance->Delete();
+  vtkNew<vtkFloatArray> copy;
+  copy->DeepCopy(constant);
+  if (copy->GetNumberOfTuples() != numTuples ||
+      copy->GetValue(3 * 7 + 2) != 3.0f)
+    {
+    cerr << "DeepCopy failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Index.
+  typedef vtkImplicitArray<vtkIdType, vtkIndexFunction> IndexArray;
+  vtkSmartPointer<IndexArray> index = vtkSmartPointer<IndexArray>::New();
+  index->SetNumberOfTuples(numTuples);
+  if (index->GetValue(77) != 77 || index->LookupValue(123) != 123)
+    {
+    cerr << "Wrong index values" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Uniform grid points.
+  double origin[3] = { 1.0, 2.0, 3.0 };
+  double spacing[3] = { 0.5, 1.0, 2.0 };
+  int extent[6] = { 1, 4, 0, 2, -1, 0 };
+  vtkUniformGridPointsFunction grid(origin, spacing, extent);
+  typedef vtkImplicitArray<double, vtkUniformGridPointsFunction> GridArray;
+  vtkSmartPointer<GridArray> points = vtkSmartPointer<GridArray>::New();
+  points->SetNumberOfComponents(3);
+  points->SetFunction(grid);
+  points->SetNumberOfTuples(grid.GetNumberOfPoints());
+  if (points->GetNumberOfTuples() != 24)
+    {
+    cerr << "Wrong number of points" << endl;
+    return EXIT_FAILURE;
+    }
+  // (i, j, k) = (2, 1, 0) is point 1 + 4 * 1 + 12 * 1.
+  double* x = points->GetTuple(17);
+  if (x[0] != 2.0 || x[1] != 3.0 || x[2] != 3.0)
+    {
+    cerr << "Wrong grid point " << x[0] << " " << x[1] << " " << x[2] << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Rectilinear grid points.
+  vtkNew<vtkDoubleArray> xs, ys, zs;
+  xs->InsertNextValue(0.0);
+  xs->InsertNextValue(0.25);
+  ys->InsertNextValue(-1.0);
+  ys->InsertNextValue(1.0);
+  ys->InsertNextValue(5.0);
+  zs->InsertNextValue(7.0);
+  vtkRectilinearGridPointsFunction rgrid(xs.GetPointer(), ys.GetPointer(),
+                                         zs.GetPointer());
+  typedef vtkImplicitArray<double, vtkRectilinearGridPointsFunction>
+    RectilinearArray;
+  vtkSmartPointer<RectilinearArray> rpoints =
+    vtkSmartPointer<RectilinearArray>::New();
+  rpoints->SetNumberOfComponents(3);
+  rpoints->SetFunction(rgrid);
+  rpoints->SetNumberOfTuples(rgrid.GetNumberOfPoints());
+  x = rpoints->GetTuple(5);
+  if (rpoints->GetNumberOfTuples() != 6 || x[0] != 0.25 || x[1] != 5.0 ||
+      x[2] != 7.0)
+    {
+    cerr << "Wrong rectilinear point" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Concatenation.
+  vtkNew<vtkIntArray> a, b, empty;
+  a->InsertNextValue(1);
+  a->InsertNextValue(2);
+  b->InsertNextValue(3);
+  vtkConcatenateFunction<int> concat;
+  concat.AddArray(a.GetPointer());
+  concat.AddArray(empty.GetPointer());
+  concat.AddArray(b.GetPointer());
+  typedef vtkImplicitArray<int, vtkConcatenateFunction<int> > ConcatArray;
+  vtkSmartPointer<ConcatArray> all = vtkSmartPointer<ConcatArray>::New();
+  all->SetFunction(concat);
+  all->SetNumberOfTuples(concat.GetNumberOfTuples());
+  if (all->GetNumberOfTuples() != 3 || all->GetValue(0) != 1 ||
+      all->GetValue(1) != 2 || all->GetValue(2) != 3)
+    {
+    cerr << "Wrong concatenation" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
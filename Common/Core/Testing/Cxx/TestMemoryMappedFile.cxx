@@ -0,0 +1,260 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMemoryMappedFile.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Map a file and use it as the storage of data arrays.
+
+#include "vtkMemoryMappedFile.h"
+
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdio>
+
+static const int HeaderSize = 24;
+static const int NumberOfValues = 3000;
+
+// Return the values stored after the header of the file.
+static int FileValue(int i)
+{
+  return 7 * i - 1000;
+}
+
+int TestMemoryMappedFile(int argc, char *argv[])
+{
+  if (argc < 2)
+    {
+    cout << "Usage: " << argv[0] << " outputFilename" << endl;
+    return EXIT_FAILURE;
+    }
+  const char *fileName = argv[1];
+
+  // A header followed by the values, as a raw reader would find them.
+  FILE *fp = fopen(fileName, "wb");
+  if (fp == NULL)
+    {
+    cerr << "Cannot write " << fileName << endl;
+    return EXIT_FAILURE;
+    }
+  char header[HeaderSize] = "test header";
+  fwrite(header, 1, HeaderSize, fp);
+  for (int i = 0; i < NumberOfValues; ++i)
+    {
+    int value = FileValue(i);
+    fwrite(&value, sizeof(int), 1, fp);
+    }
+  fclose(fp);
+
+  vtkSmartPointer<vtkMemoryMappedFile> file =
+    vtkSmartPointer<vtkMemoryMappedFile>::New();
+  // The offset does not need to be on a page boundary.
+  if (!file->Map(fileName, HeaderSize, 0, vtkMemoryMappedFile::ReadOnly))
+    {
+    cerr << "Cannot map " << fileName << endl;
+    return EXIT_FAILURE;
+    }
+  if (file->GetLength() !=
+      static_cast<vtkTypeInt64>(NumberOfValues * sizeof(int)))
+    {
+    cerr << "Wrong mapped length " << file->GetLength() << endl;
+    return EXIT_FAILURE;
+    }
+  if (*static_cast<int*>(file->GetPointer()) != FileValue(0))
+    {
+    cerr << "Wrong first mapped value" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Read-only storage, shared by two arrays.
+  vtkSmartPointer<vtkIntArray> a = vtkSmartPointer<vtkIntArray>::New();
+  a->SetNumberOfComponents(3);
+  if (!a->SetMappedStorage(file, 0, NumberOfValues))
+    {
+    cerr << "SetMappedStorage failed" << endl;
+    return EXIT_FAILURE;
+    }
+  if (a->GetNumberOfTuples() != NumberOfValues / 3)
+    {
+    cerr << "Wrong number of tuples " << a->GetNumberOfTuples() << endl;
+    return EXIT_FAILURE;
+    }
+  vtkSmartPointer<vtkIntArray> b = vtkSmartPointer<vtkIntArray>::New();
+  if (!b->SetMappedStorage(file, 10 * sizeof(int), 100))
+    {
+    cerr << "SetMappedStorage with an offset failed" << endl;
+    return EXIT_FAILURE;
+    }
+  if (file->GetReferenceCount() != 3)
+    {
+    cerr << "The arrays do not reference the mapping" << endl;
+    return EXIT_FAILURE;
+    }
+  for (int i = 0; i < NumberOfValues; ++i)
+    {
+    if (a->GetValue(i) != FileValue(i))
+      {
+      cerr << "Wrong value " << i << " in the mapped array" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+  if (b->GetValue(0) != FileValue(10) || b->GetValue(99) != FileValue(109))
+    {
+    cerr << "Wrong values in the mapped array with an offset" << endl;
+    return EXIT_FAILURE;
+    }
+  double range[2];
+  a->GetRange(range, 1);
+  if (range[0] != FileValue(1) || range[1] != FileValue(NumberOfValues - 2))
+    {
+    cerr << "Wrong range " << range[0] << " " << range[1] << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Regions outside the mapping, or not aligned for the value type, are
+  // rejected, and so are user arrays claiming to be mapped.
+  vtkSmartPointer<vtkDoubleArray> d = vtkSmartPointer<vtkDoubleArray>::New();
+  if (d->SetMappedStorage(file, 2, 10))
+    {
+    cerr << "Unaligned region accepted" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkObject::GlobalWarningDisplayOff();
+  if (b->SetMappedStorage(NULL, 0, 1))
+    {
+    cerr << "NULL mapping accepted" << endl;
+    return EXIT_FAILURE;
+    }
+  if (b->SetMappedStorage(file, 0, NumberOfValues + 1))
+    {
+    cerr << "Region past the end of the mapping accepted" << endl;
+    return EXIT_FAILURE;
+    }
+  // Only SetMappedStorage() may give the array an unmap delete method.
+  int *userValues = new int[4];
+  b->SetArray(userValues, 4, 0, vtkIntArray::VTK_DATA_ARRAY_UNMAP);
+  delete [] userValues;
+  vtkObject::GlobalWarningDisplayOn();
+  if (b->GetValue(0) != FileValue(10))
+    {
+    cerr << "Rejected regions changed the array" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Growing the array copies the values out of the mapping.
+  b->InsertNextValue(1);
+  if (b->GetNumberOfTuples() != 101)
+    {
+    cerr << "Wrong number of tuples after growing the array" << endl;
+    return EXIT_FAILURE;
+    }
+  if (b->GetValue(99) != FileValue(109) || b->GetValue(100) != 1)
+    {
+    cerr << "Values lost when growing the array" << endl;
+    return EXIT_FAILURE;
+    }
+  b->SetValue(0, 5);
+  if (file->GetReferenceCount() != 2)
+    {
+    cerr << "The grown array still references the mapping" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The mapping stays valid as long as an array uses it.
+  file = NULL;
+  if (a->GetValue(NumberOfValues - 1) != FileValue(NumberOfValues - 1))
+    {
+    cerr << "The mapping was released while in use" << endl;
+    return EXIT_FAILURE;
+    }
+  a = NULL;
+
+  // Copy-on-write storage can be modified without changing the file.
+  vtkSmartPointer<vtkMemoryMappedFile> copy =
+    vtkSmartPointer<vtkMemoryMappedFile>::New();
+  if (!copy->Map(fileName, HeaderSize, 4 * sizeof(int),
+                 vtkMemoryMappedFile::CopyOnWrite))
+    {
+    cerr << "Cannot map " << fileName << " copy-on-write" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkSmartPointer<vtkIntArray> c = vtkSmartPointer<vtkIntArray>::New();
+  if (!c->SetMappedStorage(copy, 0, 4))
+    {
+    cerr << "SetMappedStorage on a copy-on-write mapping failed" << endl;
+    return EXIT_FAILURE;
+    }
+  c->SetValue(2, 42);
+  if (c->GetValue(2) != 42)
+    {
+    cerr << "Cannot write to a copy-on-write mapping" << endl;
+    return EXIT_FAILURE;
+    }
+  // Allocate() never reuses mapped storage.
+  c->Allocate(2);
+  c->InsertNextValue(3);
+  if (c->GetValue(0) != 3)
+    {
+    cerr << "Allocate() reused the mapped storage" << endl;
+    return EXIT_FAILURE;
+    }
+  if (copy->GetReferenceCount() != 1)
+    {
+    cerr << "The reallocated array still references the mapping" << endl;
+    return EXIT_FAILURE;
+    }
+  copy->Unmap();
+  if (copy->GetPointer() != NULL)
+    {
+    cerr << "Unmap() failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  fp = fopen(fileName, "rb");
+  if (fp == NULL)
+    {
+    cerr << "Cannot read " << fileName << endl;
+    return EXIT_FAILURE;
+    }
+  int values[4];
+  fseek(fp, HeaderSize, SEEK_SET);
+  if (fread(values, sizeof(int), 4, fp) != 4)
+    {
+    cerr << "Cannot read " << fileName << endl;
+    return EXIT_FAILURE;
+    }
+  fclose(fp);
+  if (values[2] != FileValue(2))
+    {
+    cerr << "A copy-on-write change reached the file" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Missing files and regions past the end fail cleanly.
+  vtkObject::GlobalWarningDisplayOff();
+  if (copy->Map("/this/file/does/not/exist", 0, 0,
+                vtkMemoryMappedFile::ReadOnly))
+    {
+    cerr << "Missing file mapped" << endl;
+    return EXIT_FAILURE;
+    }
+  if (copy->Map(fileName, HeaderSize, 4 * NumberOfValues + 1,
+                vtkMemoryMappedFile::ReadOnly))
+    {
+    cerr << "Region past the end of the file mapped" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkObject::GlobalWarningDisplayOn();
+
+  return EXIT_SUCCESS;
+}
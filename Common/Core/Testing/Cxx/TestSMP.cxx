@@ -0,0 +1,194 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkSMPTools.
+// .SECTION Description
+// Tests vtkSMPTools::For with and without Initialize()/Reduce(), its
+// grain handling, nested use and vtkSMPThreadLocal.
+
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+// Marks every visited id. Each id must be visited exactly once.
+class MarkFunctor
+{
+public:
+  vtkIdType* Counts;
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Counts[i]++;
+      }
+  }
+};
+
+// Sums the ids using a per-thread accumulator.
+class SumFunctor
+{
+public:
+  vtkSMPThreadLocal<vtkIdType> Sum;
+  vtkSMPThreadLocal<int> Initialized;
+  vtkIdType Total;
+  int NumberOfInitializations;
+
+  SumFunctor() : Sum(0), Initialized(0), Total(0), NumberOfInitializations(0)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Initialized.Local()++;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType& sum = this->Sum.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      sum += i;
+      }
+  }
+
+  void Reduce()
+  {
+    vtkSMPThreadLocal<vtkIdType>::iterator itr = this->Sum.begin();
+    for (; itr != this->Sum.end(); ++itr)
+      {
+      this->Total += *itr;
+      }
+    vtkSMPThreadLocal<int>::iterator itr2 = this->Initialized.begin();
+    for (; itr2 != this->Initialized.end(); ++itr2)
+      {
+      this->NumberOfInitializations += *itr2;
+      }
+  }
+};
+
+// Runs a nested For() inside every sub-range.
+class NestedFunctor
+{
+public:
+  vtkIdType* Counts;
+  vtkIdType Inner;
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      MarkFunctor mark;
+      mark.Counts = this->Counts + i * this->Inner;
+      vtkSMPTools::For(0, this->Inner, mark);
+      }
+  }
+};
+
+static bool CheckCounts(vtkIdTypeArray* counts, vtkIdType expected,
+                        const char* label)
+{
+  for (vtkIdType i = 0; i < counts->GetNumberOfTuples(); ++i)
+    {
+    if (counts->GetValue(i) != expected)
+      {
+      cerr << label << ": id " << i << " visited " << counts->GetValue(i)
+           << " times instead of " << expected << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+int TestSMP(int, char *[])
+{
+  bool success = true;
+  const vtkIdType n = 100003;
+
+  vtkSMPTools::Initialize(0);
+  int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  cout << "Using " << numThreads << " thread(s), at most "
+       << vtkSMPTools::GetMaximumNumberOfThreads() << endl;
+  if (numThreads < 1 ||
+      numThreads > vtkSMPTools::GetMaximumNumberOfThreads())
+    {
+    cerr << "Invalid number of threads" << endl;
+    success = false;
+    }
+
+  // Every id visited once, for several grains.
+  vtkIdType grains[] = { 0, 1, 7, 1000, n, 2 * n };
+  for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); ++g)
+    {
+    vtkNew<vtkIdTypeArray> counts;
+    counts->SetNumberOfTuples(n);
+    counts->FillComponent(0, 0);
+    MarkFunctor mark;
+    mark.Counts = counts->GetPointer(0);
+    vtkSMPTools::For(0, n, grains[g], mark);
+    success = CheckCounts(counts.GetPointer(), 1, "For") && success;
+    }
+
+  // Empty range must not call the functor.
+  MarkFunctor empty;
+  empty.Counts = 0;
+  vtkSMPTools::For(10, 10, empty);
+
+  // Thread local reduction with Initialize()/Reduce().
+  SumFunctor sum;
+  vtkSMPTools::For(0, n, sum);
+  if (sum.Total != n * (n - 1) / 2)
+    {
+    cerr << "Reduction gave " << sum.Total << " instead of "
+         << n * (n - 1) / 2 << endl;
+    success = false;
+    }
+  if (sum.NumberOfInitializations < 1 ||
+      sum.NumberOfInitializations > numThreads ||
+      static_cast<size_t>(sum.NumberOfInitializations) != sum.Sum.size())
+    {
+    cerr << "Initialize() called " << sum.NumberOfInitializations
+         << " times for " << sum.Sum.size() << " threads" << endl;
+    success = false;
+    }
+
+  // Nested parallel loops.
+  const vtkIdType outer = 100;
+  const vtkIdType inner = 1000;
+  vtkNew<vtkIdTypeArray> nestedCounts;
+  nestedCounts->SetNumberOfTuples(outer * inner);
+  nestedCounts->FillComponent(0, 0);
+  NestedFunctor nested;
+  nested.Counts = nestedCounts->GetPointer(0);
+  nested.Inner = inner;
+  vtkSMPTools::For(0, outer, nested);
+  success = CheckCounts(nestedCounts.GetPointer(), 1, "Nested For") && success;
+
+  // Lowering the number of threads keeps the results intact.
+  vtkSMPTools::Initialize(1);
+  if (vtkSMPTools::GetEstimatedNumberOfThreads() != 1)
+    {
+    cerr << "Could not lower the number of threads" << endl;
+    success = false;
+    }
+  SumFunctor serialSum;
+  vtkSMPTools::For(0, n, serialSum);
+  if (serialSum.Total != n * (n - 1) / 2)
+    {
+    cerr << "Serial reduction gave " << serialSum.Total << endl;
+    success = false;
+    }
+  vtkSMPTools::Initialize(0);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,385 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSOADataArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkSOADataArrayTemplate and vtkDataArrayAccessor
+// .SECTION Description
+// Fills a struct-of-arrays array, checks the vtkDataArray API on it,
+// reads its interleaved copy from several threads and copies values back
+// and forth with regular (interleaved) arrays.
+
+#include "vtkDataArrayAccessor.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkAtomicInt.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMPTools.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+// Sum of all the values, written once for all layouts.
+template <class Accessor>
+double SumValues(Accessor values)
+{
+  double sum = 0.0;
+  for (vtkIdType t = 0; t < values.GetNumberOfTuples(); ++t)
+    {
+    for (int c = 0; c < values.GetNumberOfComponents(); ++c)
+      {
+      sum += static_cast<double>(values.Get(t, c));
+      }
+    }
+  return sum;
+}
+
+// Multiply every value by two in place.
+template <class Accessor>
+void ScaleValues(Accessor values)
+{
+  for (vtkIdType t = 0; t < values.GetNumberOfTuples(); ++t)
+    {
+    for (int c = 0; c < values.GetNumberOfComponents(); ++c)
+      {
+      values.Set(t, c, values.Get(t, c) * 2);
+      }
+    }
+}
+
+// Calls GetVoidPointer() from several threads and checks the copy.
+class GetVoidPointerFunctor
+{
+public:
+  vtkSOADataArrayTemplate<double>* Array;
+  vtkAtomicInt<int> Failures;
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      double* aos = static_cast<double*>(this->Array->GetVoidPointer(0));
+      vtkIdType t = i % this->Array->GetNumberOfTuples();
+      if (!aos || aos[3 * t + 1] != 10.0 * t)
+        {
+        ++this->Failures;
+        }
+      }
+  }
+};
+}
+
+int TestSOADataArray(int, char *[])
+{
+  const vtkIdType numTuples = 100;
+  typedef vtkSOADataArrayTemplate<double> SOAArray;
+
+  // Basic API.
+  vtkSmartPointer<SOAArray> soa = vtkSmartPointer<SOAArray>::New();
+  soa->SetNumberOfComponents(3);
+  soa->SetNumberOfTuples(numTuples);
+  if (soa->GetNumberOfTuples() != numTuples)
+    {
+    cerr << "Wrong number of tuples" << endl;
+    return EXIT_FAILURE;
+    }
+  if (soa->GetDataType() != VTK_DOUBLE)
+    {
+    cerr << "Wrong data type" << endl;
+    return EXIT_FAILURE;
+    }
+  if (soa->HasStandardMemoryLayout())
+    {
+    cerr << "Layout is not standard" << endl;
+    return EXIT_FAILURE;
+    }
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    soa->SetTuple3(t, t, 10 * t, 100 * t);
+    }
+  double* comp1 = soa->GetComponentArrayPointer(1);
+  if (comp1[7] != 70.0)
+    {
+    cerr << "Component buffer is not contiguous" << endl;
+    return EXIT_FAILURE;
+    }
+  if (soa->GetComponent(5, 2) != 500.0)
+    {
+    cerr << "GetComponent failed" << endl;
+    return EXIT_FAILURE;
+    }
+  if (soa->GetValue(3 * 4 + 1) != 40.0)
+    {
+    cerr << "GetValue failed" << endl;
+    return EXIT_FAILURE;
+    }
+  double* tuple = soa->GetTuple(9);
+  if (tuple[0] != 9.0 || tuple[1] != 90.0 || tuple[2] != 900.0)
+    {
+    cerr << "GetTuple failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  double range[2];
+  soa->GetRange(range, 1);
+  if (range[0] != 0.0 || range[1] != 990.0)
+    {
+    cerr << "GetRange failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Growing the array keeps the values.
+  double next[3] = { -1.0, -2.0, -3.0 };
+  vtkIdType id = soa->InsertNextTupleValue(next);
+  if (id != numTuples)
+    {
+    cerr << "InsertNextTupleValue returned " << id << endl;
+    return EXIT_FAILURE;
+    }
+  if (soa->GetComponent(50, 1) != 500.0 ||
+      soa->GetComponent(numTuples, 2) != -3.0)
+    {
+    cerr << "Values lost when growing the array" << endl;
+    return EXIT_FAILURE;
+    }
+  soa->RemoveLastTuple();
+  soa->RemoveTuple(0);
+  if (soa->GetNumberOfTuples() != numTuples - 1 ||
+      soa->GetComponent(0, 0) != 1.0)
+    {
+    cerr << "RemoveTuple failed" << endl;
+    return EXIT_FAILURE;
+    }
+  soa->InsertTuple3(0, 0, 0, 0);
+  if (soa->GetComponent(0, 0) != 0.0 || soa->GetComponent(1, 1) != 20.0)
+    {
+    cerr << "InsertTuple failed" << endl;
+    return EXIT_FAILURE;
+    }
+  soa->Initialize();
+  soa->SetNumberOfTuples(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    soa->SetTuple3(t, t, 10 * t, 100 * t);
+    }
+
+  // Interleaved copy through GetVoidPointer.
+  double* aos = static_cast<double*>(soa->GetVoidPointer(0));
+  if (aos[3 * 11 + 2] != 1100.0)
+    {
+    cerr << "GetVoidPointer copy is wrong" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The copy is reused until the array is modified.
+  if (soa->GetVoidPointer(3) != aos + 3)
+    {
+    cerr << "GetVoidPointer copy was not reused" << endl;
+    return EXIT_FAILURE;
+    }
+  soa->SetComponent(11, 2, -1.0);
+  aos = static_cast<double*>(soa->GetVoidPointer(0));
+  if (aos[3 * 11 + 2] != -1.0)
+    {
+    cerr << "GetVoidPointer copy is stale" << endl;
+    return EXIT_FAILURE;
+    }
+  soa->SetTypedComponent(11, 2, 1100.0);
+  aos = static_cast<double*>(soa->GetVoidPointer(0));
+  if (aos[3 * 11 + 2] != 1100.0)
+    {
+    cerr << "GetVoidPointer copy is stale after SetTypedComponent()" << endl;
+    return EXIT_FAILURE;
+    }
+  soa->SetValue(3 * 11 + 2, -2.0);
+  aos = static_cast<double*>(soa->GetVoidPointer(0));
+  if (aos[3 * 11 + 2] != -2.0)
+    {
+    cerr << "GetVoidPointer copy is stale after SetValue()" << endl;
+    return EXIT_FAILURE;
+    }
+  soa->GetComponentArrayPointer(2)[11] = 1100.0;
+  soa->Modified();
+  aos = static_cast<double*>(soa->GetVoidPointer(0));
+  if (aos[3 * 11 + 2] != 1100.0)
+    {
+    cerr << "GetVoidPointer copy is stale after Modified()" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Concurrent readers all get the same, complete copy.
+  vtkSMPTools::Initialize(4);
+  soa->DataChanged();
+  GetVoidPointerFunctor readers;
+  readers.Array = soa;
+  vtkSMPTools::For(0, 64, 1, readers);
+  vtkSMPTools::Initialize(0);
+  if (readers.Failures != 0)
+    {
+    cerr << readers.Failures << " concurrent GetVoidPointer calls failed"
+         << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Zero-copy adoption of user buffers.
+  std::vector<int> x(numTuples), y(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    x[t] = static_cast<int>(t);
+    y[t] = static_cast<int>(-t);
+    }
+  vtkSmartPointer<vtkSOADataArrayTemplate<int> > user =
+    vtkSmartPointer<vtkSOADataArrayTemplate<int> >::New();
+  user->SetNumberOfComponents(2);
+  user->SetArray(0, &x[0], numTuples, 1);
+  user->SetArray(1, &y[0], numTuples, 1);
+  if (user->GetNumberOfTuples() != numTuples ||
+      user->GetTypedComponent(42, 1) != -42)
+    {
+    cerr << "SetArray failed" << endl;
+    return EXIT_FAILURE;
+    }
+  user->SetTypedComponent(42, 1, 7);
+  if (y[42] != 7)
+    {
+    cerr << "SetArray copied the user buffer" << endl;
+    return EXIT_FAILURE;
+    }
+  y[42] = -42;
+
+  // Copies between layouts.
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->DeepCopy(soa);
+  if (doubles->GetNumberOfComponents() != 3 ||
+      doubles->GetNumberOfTuples() != numTuples ||
+      doubles->GetValue(3 * 12 + 1) != 120.0)
+    {
+    cerr << "DeepCopy from SOA failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkSmartPointer<SOAArray> soa2 = vtkSmartPointer<SOAArray>::New();
+  soa2->DeepCopy(doubles.GetPointer());
+  if (soa2->GetTypedComponent(13, 2) != 1300.0)
+    {
+    cerr << "DeepCopy to SOA failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkIntArray> ints;
+  ints->DeepCopy(soa);
+  if (ints->GetValue(3 * 14 + 2) != 1400)
+    {
+    cerr << "DeepCopy to int failed" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkSmartPointer<SOAArray> soa3 = vtkSmartPointer<SOAArray>::New();
+  soa3->DeepCopy(user);
+  if (soa3->GetNumberOfComponents() != 2 ||
+      soa3->GetTypedComponent(15, 1) != -15.0)
+    {
+    cerr << "DeepCopy of SOA to SOA of different type failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Regular arrays from NewInstance(), that can be written through their
+  // pointer.
+  vtkDataArray* instance = soa->NewInstance();
+  if (!vtkDoubleArray::SafeDownCast(instance))
+    {
+    cerr << "NewInstance() did not return a regular array" << endl;
+    return EXIT_FAILURE;
+    }
+  instance->SetNumberOfComponents(3);
+  instance->SetNumberOfTuples(numTuples);
+  memcpy(instance->GetVoidPointer(0), doubles->GetVoidPointer(0),
+         3 * numTuples * sizeof(double));
+  if (instance->GetComponent(16, 1) != 160.0)
+    {
+    cerr << "Write through the pointer of an instance lost" << endl;
+    return EXIT_FAILURE;
+    }
+  instance->Delete();
+
+  doubles->SetTuple(0, 20, soa);
+  if (doubles->GetValue(1) != 200.0)
+    {
+    cerr << "SetTuple from SOA failed" << endl;
+    return EXIT_FAILURE;
+    }
+  doubles->InsertNextTuple(21, soa);
+  if (doubles->GetNumberOfTuples() != numTuples + 1 ||
+      doubles->GetValue(3 * numTuples + 2) != 2100.0)
+    {
+    cerr << "InsertNextTuple from SOA failed" << endl;
+    return EXIT_FAILURE;
+    }
+  soa2->SetTuple(0, 22, doubles.GetPointer());
+  if (soa2->GetTypedComponent(0, 1) != 220.0)
+    {
+    cerr << "SetTuple from AOS failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkIdList> ids;
+  ids->InsertNextId(2);
+  ids->InsertNextId(4);
+  vtkSmartPointer<SOAArray> picked = vtkSmartPointer<SOAArray>::New();
+  picked->SetNumberOfComponents(3);
+  picked->SetNumberOfTuples(2);
+  soa->GetTuples(ids.GetPointer(), picked);
+  if (picked->GetTypedComponent(1, 2) != 400.0)
+    {
+    cerr << "GetTuples failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  double weights[2] = { 0.5, 0.5 };
+  doubles->InterpolateTuple(0, ids.GetPointer(), soa, weights);
+  if (doubles->GetValue(1) != 30.0)
+    {
+    cerr << "InterpolateTuple from SOA failed" << endl;
+    return EXIT_FAILURE;
+    }
+  soa2->InterpolateTuple(1, 2, soa, 4, soa, 0.25);
+  if (soa2->GetTypedComponent(1, 2) != 250.0)
+    {
+    cerr << "InterpolateTuple into SOA failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Code written once against the accessors.
+  double sum = 0.0;
+  vtkDataArrayAccessorMacro(soa.GetPointer(), sum = SumValues(vtk_accessor));
+  double sumAOS = 0.0;
+  vtkDataArrayAccessorMacro(ints.GetPointer(),
+                            sumAOS = SumValues(vtk_accessor));
+  double expected = 111.0 * numTuples * (numTuples - 1) / 2;
+  if (sum != expected || sumAOS != expected)
+    {
+    cerr << "Accessor sums " << sum << " and " << sumAOS << " instead of "
+         << expected << endl;
+    return EXIT_FAILURE;
+    }
+  vtkDataArrayAccessorMacro(user.GetPointer(), ScaleValues(vtk_accessor));
+  if (x[10] != 20 || y[10] != -20)
+    {
+    cerr << "Accessor Set failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
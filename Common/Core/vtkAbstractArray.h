@@ -159,6 +159,14 @@ public:
   // special pointer manipulation.
   virtual void *GetVoidPointer(vtkIdType id) = 0;
 
+  // Description:
+  // Return 1 if the values are stored contiguously with the components
+  // of each tuple interleaved (the layout returned by GetVoidPointer),
+  // and 0 otherwise (e.g. vtkSOADataArrayTemplate).  Code that walks the
+  // raw memory of an arbitrary array must check this first and fall back
+  // on the tuple/component API when it returns 0.
+  virtual int HasStandardMemoryLayout() { return 1; }
+
   // Description:
   // Deep copy of data. Implementation left to subclasses, which
   // should support as many type conversions as possible given the
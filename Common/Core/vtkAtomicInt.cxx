@@ -0,0 +1,137 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAtomicInt.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAtomicInt.h"
+
+#if defined(WIN32) || defined(_WIN32)
+# include "vtkWindows.h"
+#else
+# include "vtkCriticalSection.h"
+#endif
+
+#if defined(WIN32) || defined(_WIN32)
+
+//----------------------------------------------------------------------------
+vtkTypeInt32 vtkAtomicIntImpl::AddAndFetch(vtkTypeInt32 volatile* ref,
+                                           vtkTypeInt32 val)
+{
+  return InterlockedExchangeAdd(reinterpret_cast<long volatile*>(ref),
+                                val) + val;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt32 vtkAtomicIntImpl::Load(vtkTypeInt32 volatile* ref)
+{
+  return InterlockedCompareExchange(reinterpret_cast<long volatile*>(ref),
+                                    0, 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkAtomicIntImpl::Store(vtkTypeInt32 volatile* ref, vtkTypeInt32 val)
+{
+  InterlockedExchange(reinterpret_cast<long volatile*>(ref), val);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkAtomicIntImpl::AddAndFetch(vtkTypeInt64 volatile* ref,
+                                           vtkTypeInt64 val)
+{
+  return InterlockedExchangeAdd64(ref, val) + val;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkAtomicIntImpl::Load(vtkTypeInt64 volatile* ref)
+{
+  return InterlockedCompareExchange64(ref, 0, 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkAtomicIntImpl::Store(vtkTypeInt64 volatile* ref, vtkTypeInt64 val)
+{
+  InterlockedExchange64(ref, val);
+}
+
+#else
+
+// Platforms without atomic builtins serialize through one lock.
+static vtkSimpleCriticalSection vtkAtomicIntCritSec;
+
+//----------------------------------------------------------------------------
+template <typename T>
+static T vtkAtomicIntLockedAddAndFetch(T volatile* ref, T val)
+{
+  vtkAtomicIntCritSec.Lock();
+  T result = (*ref += val);
+  vtkAtomicIntCritSec.Unlock();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+template <typename T>
+static T vtkAtomicIntLockedLoad(T volatile* ref)
+{
+  vtkAtomicIntCritSec.Lock();
+  T result = *ref;
+  vtkAtomicIntCritSec.Unlock();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+template <typename T>
+static void vtkAtomicIntLockedStore(T volatile* ref, T val)
+{
+  vtkAtomicIntCritSec.Lock();
+  *ref = val;
+  vtkAtomicIntCritSec.Unlock();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt32 vtkAtomicIntImpl::AddAndFetch(vtkTypeInt32 volatile* ref,
+                                           vtkTypeInt32 val)
+{
+  return vtkAtomicIntLockedAddAndFetch(ref, val);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt32 vtkAtomicIntImpl::Load(vtkTypeInt32 volatile* ref)
+{
+  return vtkAtomicIntLockedLoad(ref);
+}
+
+//----------------------------------------------------------------------------
+void vtkAtomicIntImpl::Store(vtkTypeInt32 volatile* ref, vtkTypeInt32 val)
+{
+  vtkAtomicIntLockedStore(ref, val);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkAtomicIntImpl::AddAndFetch(vtkTypeInt64 volatile* ref,
+                                           vtkTypeInt64 val)
+{
+  return vtkAtomicIntLockedAddAndFetch(ref, val);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkAtomicIntImpl::Load(vtkTypeInt64 volatile* ref)
+{
+  return vtkAtomicIntLockedLoad(ref);
+}
+
+//----------------------------------------------------------------------------
+void vtkAtomicIntImpl::Store(vtkTypeInt64 volatile* ref, vtkTypeInt64 val)
+{
+  vtkAtomicIntLockedStore(ref, val);
+}
+
+#endif
@@ -0,0 +1,208 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAtomicInt.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkAtomicInt - Provides support for atomic integers
+// .SECTION Description
+// Objects of atomic types are C++ objects that are free from data races;
+// that is, if one thread writes to an atomic object while another thread
+// reads from it, the behavior is well-defined. vtkAtomicInt provides
+// a subset of the std::atomic API for 32 and 64 bit integers.
+//
+// The implementation uses the __sync builtins of GCC compatible
+// compilers, the Interlocked functions on Windows and falls back to a
+// global critical section everywhere else. All operations have
+// sequentially consistent (full barrier) semantics.
+//
+// \code
+// vtkAtomicInt<vtkTypeInt32> count(0);
+// ++count;          // from any thread
+// int value = count; // loads atomically
+// \endcode
+//
+// .SECTION See Also
+// vtkSMPTools vtkTimeStamp
+
+#ifndef __vtkAtomicInt_h
+#define __vtkAtomicInt_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSystemIncludes.h"
+
+#if defined(VTK_HAVE_SYNC_BUILTINS)
+# define VTK_ATOMIC_INT_USE_SYNC_BUILTINS
+#endif
+
+//BTX
+// Description:
+// Out-of-line atomic primitives used when the compiler does not
+// provide builtins. Not meant to be used directly.
+class VTKCOMMONCORE_EXPORT vtkAtomicIntImpl
+{
+public:
+  static vtkTypeInt32 AddAndFetch(vtkTypeInt32 volatile* ref,
+                                  vtkTypeInt32 val);
+  static vtkTypeInt32 Load(vtkTypeInt32 volatile* ref);
+  static void Store(vtkTypeInt32 volatile* ref, vtkTypeInt32 val);
+
+  static vtkTypeInt64 AddAndFetch(vtkTypeInt64 volatile* ref,
+                                  vtkTypeInt64 val);
+  static vtkTypeInt64 Load(vtkTypeInt64 volatile* ref);
+  static void Store(vtkTypeInt64 volatile* ref, vtkTypeInt64 val);
+};
+
+// Description:
+// Maps the size of an integer type to the fixed size type used by
+// vtkAtomicIntImpl.
+template <int Size> struct vtkAtomicIntTypeOfSize;
+template <> struct vtkAtomicIntTypeOfSize<4> { typedef vtkTypeInt32 Type; };
+template <> struct vtkAtomicIntTypeOfSize<8> { typedef vtkTypeInt64 Type; };
+//ETX
+
+template <typename T>
+class vtkAtomicInt
+{
+public:
+  // Description:
+  // Default constructor. Initializes the value to 0.
+  vtkAtomicInt() : Value(0)
+  {
+  }
+
+  // Description:
+  // Constructor with an initial value.
+  vtkAtomicInt(T val) : Value(val)
+  {
+  }
+
+  // Description:
+  // Copy constructor. Atomically loads the value of the other object.
+  vtkAtomicInt(const vtkAtomicInt<T>& ai) : Value(ai.Load())
+  {
+  }
+
+  // Description:
+  // Atomic pre-increment. Returns the new value.
+  T operator++()
+  {
+    return this->AddAndFetch(1);
+  }
+
+  // Description:
+  // Atomic post-increment. Returns the old value.
+  T operator++(int)
+  {
+    return this->AddAndFetch(1) - 1;
+  }
+
+  // Description:
+  // Atomic pre-decrement. Returns the new value.
+  T operator--()
+  {
+    return this->AddAndFetch(-1);
+  }
+
+  // Description:
+  // Atomic post-decrement. Returns the old value.
+  T operator--(int)
+  {
+    return this->AddAndFetch(-1) + 1;
+  }
+
+  // Description:
+  // Atomic add. Returns the new value.
+  T operator+=(T val)
+  {
+    return this->AddAndFetch(val);
+  }
+
+  // Description:
+  // Atomic subtract. Returns the new value.
+  T operator-=(T val)
+  {
+    return this->AddAndFetch(-val);
+  }
+
+  // Description:
+  // Atomically fetch the value.
+  operator T() const
+  {
+    return this->Load();
+  }
+
+  // Description:
+  // Atomically store a value. Returns the stored value.
+  T operator=(T val)
+  {
+    this->Store(val);
+    return val;
+  }
+
+  // Description:
+  // Atomically copy the value of another object.
+  vtkAtomicInt<T>& operator=(const vtkAtomicInt<T>& ai)
+  {
+    this->Store(ai.Load());
+    return *this;
+  }
+
+  // Description:
+  // Atomically fetch the value.
+  T Load() const
+  {
+#if defined(VTK_ATOMIC_INT_USE_SYNC_BUILTINS)
+    __sync_synchronize();
+    return this->Value;
+#else
+    return static_cast<T>(vtkAtomicIntImpl::Load(this->GetStorage()));
+#endif
+  }
+
+  // Description:
+  // Atomically store a value.
+  void Store(T val)
+  {
+#if defined(VTK_ATOMIC_INT_USE_SYNC_BUILTINS)
+    __sync_synchronize();
+    this->Value = val;
+    __sync_synchronize();
+#else
+    vtkAtomicIntImpl::Store(this->GetStorage(), static_cast<StorageType>(val));
+#endif
+  }
+
+private:
+  T AddAndFetch(T val)
+  {
+#if defined(VTK_ATOMIC_INT_USE_SYNC_BUILTINS)
+    return __sync_add_and_fetch(&this->Value, val);
+#else
+    return static_cast<T>(vtkAtomicIntImpl::AddAndFetch(
+        this->GetStorage(), static_cast<StorageType>(val)));
+#endif
+  }
+
+#if !defined(VTK_ATOMIC_INT_USE_SYNC_BUILTINS)
+  typedef typename vtkAtomicIntTypeOfSize<sizeof(T)>::Type StorageType;
+  StorageType volatile* GetStorage() const
+  {
+    return reinterpret_cast<StorageType volatile*>(
+      const_cast<T volatile*>(&this->Value));
+  }
+#endif
+
+  T volatile Value;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkAtomicInt.h
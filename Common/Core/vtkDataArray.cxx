@@ -15,6 +15,7 @@
 #include "vtkDataArray.h"
 #include "vtkBitArray.h"
 #include "vtkCharArray.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
@@ -29,14 +30,20 @@
 #include "vtkMath.h"
 #include "vtkShortArray.h"
 #include "vtkSignedCharArray.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnsignedLongArray.h"
 #include "vtkUnsignedShortArray.h"
 
+#include <vector>
+
 vtkInformationKeyMacro(vtkDataArray, PER_COMPONENT, InformationVector);
 vtkInformationKeyRestrictedMacro(vtkDataArray, COMPONENT_RANGE, DoubleVector, 2);
 vtkInformationKeyRestrictedMacro(vtkDataArray, L2_NORM_RANGE, DoubleVector, 2);
+vtkInformationKeyRestrictedMacro(vtkDataArray, COMPONENT_FINITE_RANGE, DoubleVector, 2);
+vtkInformationKeyRestrictedMacro(vtkDataArray, L2_NORM_FINITE_RANGE, DoubleVector, 2);
 
 
 //----------------------------------------------------------------------------
@@ -139,6 +146,24 @@ void vtkDataArray::DeepCopy(vtkDataArray *da)
     vtkIdType numTuples = da->GetNumberOfTuples();
     this->NumberOfComponents = da->NumberOfComponents;
     this->SetNumberOfTuples(numTuples);
+
+    // Arrays that do not store interleaved values cannot be walked through
+    // their void pointer; copy them tuple by tuple.
+    if (!this->HasStandardMemoryLayout() || !da->HasStandardMemoryLayout())
+      {
+      for (vtkIdType i=0; i < numTuples; i++)
+        {
+        this->SetTuple(i, da->GetTuple(i));
+        }
+      this->SetLookupTable(0);
+      if (da->LookupTable)
+        {
+        this->LookupTable = da->LookupTable->NewInstance();
+        this->LookupTable->DeepCopy(da->LookupTable);
+        }
+      return;
+      }
+
     void *input=da->GetVoidPointer(0);
 
     switch (da->GetDataType())
@@ -289,6 +314,32 @@ void vtkDataArrayInterpolateTuple(T* from, T* to, int numComp,
     to++;
     }
 }
+//----------------------------------------------------------------------------
+// Interpolation through the component API, for arrays whose values are not
+// stored interleaved.  Integer types are rounded like above.
+void vtkDataArray::InterpolateTupleGeneric(vtkIdType i, vtkIdList *ptIndices,
+  vtkDataArray* fromData, double* weights)
+{
+  int numComp = fromData->GetNumberOfComponents();
+  vtkIdType numIds = ptIndices->GetNumberOfIds();
+  vtkIdType *ids = ptIndices->GetPointer(0);
+  int round = (this->GetDataType() != VTK_FLOAT &&
+               this->GetDataType() != VTK_DOUBLE);
+  for (int k=0; k < numComp; k++)
+    {
+    double c = 0.0;
+    for (vtkIdType j=0; j < numIds; j++)
+      {
+      c += weights[j]*fromData->GetComponent(ids[j], k);
+      }
+    if (round)
+      {
+      c = (c >= 0.0) ? floor(c + 0.5) : ceil(c - 0.5);
+      }
+    this->InsertComponent(i, k, c);
+    }
+}
+
 //----------------------------------------------------------------------------
 // Interpolate array value from other array value given the
 // indices and associated interpolation weights.
@@ -304,7 +355,13 @@ void vtkDataArray::InterpolateTuple(vtkIdType i, vtkIdList *ptIndices,
     }
 
   vtkDataArray* fromData = vtkDataArray::SafeDownCast(source);
-  if (fromData)
+  if (fromData &&
+      (!this->HasStandardMemoryLayout() ||
+       !fromData->HasStandardMemoryLayout()))
+    {
+    this->InterpolateTupleGeneric(i, ptIndices, fromData, weights);
+    }
+  else if (fromData)
     {
     int numComp = fromData->GetNumberOfComponents();
     vtkIdType j, numIds=ptIndices->GetNumberOfIds();
@@ -386,6 +443,19 @@ void vtkDataArray::InterpolateTuple(vtkIdType i,
   double c;
   vtkIdType loc = i * numComp;
 
+  if (!this->HasStandardMemoryLayout() ||
+      !fromData1->HasStandardMemoryLayout() ||
+      !fromData2->HasStandardMemoryLayout())
+    {
+    for (k=0; k<numComp; k++)
+      {
+      c = (1.0 - t) * fromData1->GetComponent(id1, k)
+        + t * fromData2->GetComponent(id2, k);
+      this->InsertComponent(i, k, c);
+      }
+    return;
+    }
+
   switch (fromData1->GetDataType())
     {
     case VTK_BIT:
@@ -815,6 +885,15 @@ void vtkDataArray::GetTuples(vtkIdList *ptIds, vtkAbstractArray *aa)
     return;
     }
 
+  if (!this->HasStandardMemoryLayout() || !da->HasStandardMemoryLayout())
+    {
+    vtkIdType num=ptIds->GetNumberOfIds();
+    for (vtkIdType i=0; i<num; i++)
+      {
+      da->SetTuple(i,this->GetTuple(ptIds->GetId(i)));
+      }
+    return;
+    }
 
   switch (this->GetDataType())
     {
@@ -890,6 +969,16 @@ void vtkDataArray::GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *aa)
     return;
     }
 
+  if (!this->HasStandardMemoryLayout() || !da->HasStandardMemoryLayout())
+    {
+    vtkIdType num=p2-p1+1;
+    for (vtkIdType i=0; i<num; i++)
+      {
+      da->SetTuple(i,this->GetTuple(p1+i));
+      }
+    return;
+    }
+
   switch (this->GetDataType())
     {
     vtkTemplateMacro(vtkCopyTuples1( static_cast<VTK_TT *>(this->GetVoidPointer(0)), da,
@@ -999,6 +1088,10 @@ int vtkDataArray::CopyInformation(vtkInformation *infoFrom, int deep)
     {
     myInfo->Remove( L2_NORM_RANGE() );
     }
+  if (myInfo->Has( L2_NORM_FINITE_RANGE() ))
+    {
+    myInfo->Remove( L2_NORM_FINITE_RANGE() );
+    }
   if (myInfo->Has( PER_COMPONENT() ))
     {
     myInfo->Remove( PER_COMPONENT() );
@@ -1009,6 +1102,18 @@ int vtkDataArray::CopyInformation(vtkInformation *infoFrom, int deep)
 
 //----------------------------------------------------------------------------
 void vtkDataArray::ComputeRange(int comp)
+{
+  this->ComputeCachedRange(comp, 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArray::ComputeFiniteRange(int comp)
+{
+  this->ComputeCachedRange(comp, 1);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArray::ComputeCachedRange(int comp, int finiteOnly)
 {
   if ( comp >= this->NumberOfComponents )
     { // Ignore requests for nonexistent components.
@@ -1021,42 +1126,51 @@ void vtkDataArray::ComputeRange(int comp)
     comp = 0;
     }
 
-  vtkInformation* info = this->GetInformation();
-  vtkInformationDoubleVectorKey* rkey;
-  if ( comp < 0 )
+  vtkInformationDoubleVectorKey* ckey =
+    finiteOnly ? COMPONENT_FINITE_RANGE() : COMPONENT_RANGE();
+  vtkInformationDoubleVectorKey* nkey =
+    finiteOnly ? L2_NORM_FINITE_RANGE() : L2_NORM_RANGE();
+
+  vtkInformation* arrayInfo = this->GetInformation();
+  vtkInformationVector* infoVec;
+  if ( ! arrayInfo->Has( PER_COMPONENT() ) )
     {
-    rkey = L2_NORM_RANGE();
+    infoVec = vtkInformationVector::New();
+    arrayInfo->Set( PER_COMPONENT(), infoVec );
+    infoVec->FastDelete();
     }
   else
     {
-    vtkInformationVector* infoVec;
-    if ( ! info->Has( PER_COMPONENT() ) )
-      {
-      infoVec = vtkInformationVector::New();
-      info->Set( PER_COMPONENT(), infoVec );
-      infoVec->FastDelete();
-      }
-    else
-      {
-      infoVec = info->Get( PER_COMPONENT() );
-      }
-    int vlen = infoVec->GetNumberOfInformationObjects();
-    if ( vlen < this->NumberOfComponents )
+    infoVec = arrayInfo->Get( PER_COMPONENT() );
+    }
+  int vlen = infoVec->GetNumberOfInformationObjects();
+  if ( vlen < this->NumberOfComponents )
+    {
+    infoVec->SetNumberOfInformationObjects( this->NumberOfComponents );
+    double rtmp[2];
+    rtmp[0] = VTK_DOUBLE_MAX;
+    rtmp[1] = VTK_DOUBLE_MIN;
+    // Since the MTime() of these new keys will be newer than this->MTime(), we must
+    // be sure that their ranges are marked "invalid" so that we know they must be
+    // computed.
+    for ( int i = vlen; i < this->NumberOfComponents; ++i )
       {
-      infoVec->SetNumberOfInformationObjects( this->NumberOfComponents );
-      double rtmp[2];
-      rtmp[0] = VTK_DOUBLE_MAX;
-      rtmp[1] = VTK_DOUBLE_MIN;
-      // Since the MTime() of these new keys will be newer than this->MTime(), we must
-      // be sure that their ranges are marked "invalid" so that we know they must be
-      // computed.
-      for ( int i = vlen; i < this->NumberOfComponents; ++i )
-        {
-        infoVec->GetInformationObject( i )->Set( COMPONENT_RANGE(), rtmp, 2 );
-        }
+      infoVec->GetInformationObject( i )->Set( COMPONENT_RANGE(), rtmp, 2 );
+      infoVec->GetInformationObject( i )->Set( COMPONENT_FINITE_RANGE(), rtmp, 2 );
       }
+    }
+
+  vtkInformation* info;
+  vtkInformationDoubleVectorKey* rkey;
+  if ( comp < 0 )
+    {
+    info = arrayInfo;
+    rkey = nkey;
+    }
+  else
+    {
     info = infoVec->GetInformationObject( comp );
-    rkey = COMPONENT_RANGE();
+    rkey = ckey;
     }
 
   if ( info->Has( rkey ) )
@@ -1073,61 +1187,149 @@ void vtkDataArray::ComputeRange(int comp)
       }
     }
 
-  this->Range[0] =  VTK_DOUBLE_MAX;
-  this->Range[1] =  VTK_DOUBLE_MIN;
-  if ( comp < 0 )
+  // Whatever was asked for, compute the ranges of all the components and
+  // of the magnitude in the same pass and cache them all: callers usually
+  // ask for several of them in a row.
+  int numComp = this->NumberOfComponents;
+  std::vector<double> ranges(2*(numComp+1));
+  for (int i = 0; i <= numComp; ++i)
     {
-    this->ComputeVectorRange();
+    ranges[2*i] = VTK_DOUBLE_MAX;
+    ranges[2*i+1] = VTK_DOUBLE_MIN;
     }
-  else
+  this->ComputeRanges(&ranges[0], finiteOnly);
+
+  for (int i = 0; i < numComp; ++i)
     {
-    this->ComputeScalarRange( comp );
+    infoVec->GetInformationObject( i )->Set( ckey, &ranges[2*i], 2 );
     }
+  arrayInfo->Set( nkey, &ranges[2*numComp], 2 );
 
-  info->Set( rkey, this->Range, 2 );
+  int slot = comp < 0 ? numComp : comp;
+  this->Range[0] = ranges[2*slot];
+  this->Range[1] = ranges[2*slot+1];
 }
 
 //----------------------------------------------------------------------------
-void vtkDataArray::ComputeScalarRange(int comp)
+// Values of integral types are always finite.
+template <class T>
+inline bool vtkDataArrayIsFinite(T)
 {
-  vtkIdType numTuples=this->GetNumberOfTuples();
-  for (vtkIdType i=0; i<numTuples; i++)
-    {
-    double s = this->GetComponent(i,comp);
-    if ( s < this->Range[0] )
-      {
-      this->Range[0] = s;
-      }
-    if ( s > this->Range[1] )
-      {
-      this->Range[1] = s;
-      }
-    }
+  return true;
+}
+
+VTK_TEMPLATE_SPECIALIZE
+inline bool vtkDataArrayIsFinite(float v)
+{
+  return !vtkMath::IsNan(v) && !vtkMath::IsInf(v);
 }
 
-//-----------------------------------------------------------------------------
-void vtkDataArray::ComputeVectorRange()
+VTK_TEMPLATE_SPECIALIZE
+inline bool vtkDataArrayIsFinite(double v)
 {
-  vtkIdType numTuples=this->GetNumberOfTuples();
-  for (vtkIdType i=0; i<numTuples; i++)
-    {
-    // Compute range of vector magnitude.
-    double s = 0.0;
-    for (int j=0; j < this->NumberOfComponents; ++j)
+  return !vtkMath::IsNan(v) && !vtkMath::IsInf(v);
+}
+
+//----------------------------------------------------------------------------
+// Computes the range of every component and of the magnitude in a single
+// pass.  Each thread works on its own copy of the ranges, which are merged
+// in Reduce().
+template <class Accessor>
+class vtkDataArrayRangeFunctor
+{
+public:
+  typedef typename Accessor::ValueType ValueType;
+
+  vtkDataArrayRangeFunctor(Accessor values, double* ranges, int finiteOnly)
+    : Values(values), Ranges(ranges), FiniteOnly(finiteOnly),
+      NumberOfComponents(values.GetNumberOfComponents())
+  {
+  }
+
+  void Initialize()
+  {
+    std::vector<double>& r = this->ThreadRanges.Local();
+    r.resize(2*(this->NumberOfComponents+1));
+    for (int i = 0; i <= this->NumberOfComponents; ++i)
       {
-      double t = this->GetComponent(i,j);
-      s += t*t;
+      r[2*i] = VTK_DOUBLE_MAX;
+      r[2*i+1] = VTK_DOUBLE_MIN;
       }
-    s = sqrt(s);
-    if ( s < this->Range[0] )
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<double>& r = this->ThreadRanges.Local();
+    double* range = &r[0];
+    double* normRange = range + 2*this->NumberOfComponents;
+    for (vtkIdType t = begin; t < end; ++t)
       {
-      this->Range[0] = s;
+      double norm = 0.0;
+      bool finiteTuple = true;
+      for (int c = 0; c < this->NumberOfComponents; ++c)
+        {
+        ValueType v = this->Values.Get(t, c);
+        if (this->FiniteOnly && !vtkDataArrayIsFinite(v))
+          {
+          finiteTuple = false;
+          continue;
+          }
+        double s = static_cast<double>(v);
+        range[2*c] = s < range[2*c] ? s : range[2*c];
+        range[2*c+1] = s > range[2*c+1] ? s : range[2*c+1];
+        norm += s*s;
+        }
+      if (this->FiniteOnly &&
+          (!finiteTuple || !vtkDataArrayIsFinite(norm)))
+        {
+        continue;
+        }
+      norm = sqrt(norm);
+      normRange[0] = norm < normRange[0] ? norm : normRange[0];
+      normRange[1] = norm > normRange[1] ? norm : normRange[1];
       }
-    if ( s > this->Range[1] )
+  }
+
+  void Reduce()
+  {
+    int n = 2*(this->NumberOfComponents+1);
+    typedef typename vtkSMPThreadLocal<std::vector<double> >::iterator
+      IteratorType;
+    for (IteratorType itr = this->ThreadRanges.begin();
+         itr != this->ThreadRanges.end(); ++itr)
       {
-      this->Range[1] = s;
+      for (int i = 0; i < n; i += 2)
+        {
+        double lo = (*itr)[i];
+        double hi = (*itr)[i+1];
+        this->Ranges[i] = lo < this->Ranges[i] ? lo : this->Ranges[i];
+        this->Ranges[i+1] = hi > this->Ranges[i+1] ? hi : this->Ranges[i+1];
+        }
       }
-    }
+  }
+
+private:
+  Accessor Values;
+  double* Ranges;
+  int FiniteOnly;
+  int NumberOfComponents;
+  vtkSMPThreadLocal<std::vector<double> > ThreadRanges;
+};
+
+//----------------------------------------------------------------------------
+template <class Accessor>
+void vtkDataArrayComputeRanges(Accessor values, double* ranges,
+                               int finiteOnly)
+{
+  vtkDataArrayRangeFunctor<Accessor> functor(values, ranges, finiteOnly);
+  vtkSMPTools::For(0, values.GetNumberOfTuples(), functor);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArray::ComputeRanges(double* ranges, int finiteOnly)
+{
+  vtkDataArrayAccessorMacro(this,
+    vtkDataArrayComputeRanges(vtk_accessor, ranges, finiteOnly));
 }
 
 //----------------------------------------------------------------------------
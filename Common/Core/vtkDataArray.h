@@ -42,6 +42,7 @@ class vtkIdList;
 class vtkInformationDoubleVectorKey;
 class vtkInformationInformationVectorKey;
 class vtkLookupTable;
+class vtkMemoryMappedFile;
 
 class VTKCOMMONCORE_EXPORT vtkDataArray : public vtkAbstractArray
 {
@@ -265,6 +266,20 @@ public:
   // data values requested.
   virtual void* WriteVoidPointer(vtkIdType id, vtkIdType number) = 0;
 
+  // Description:
+  // Use numberOfValues values of a memory mapped file, starting at the
+  // given byte offset from the start of the mapped region, as the storage
+  // of this array without copying them. The array keeps a reference to
+  // the mapping. The data must have the native byte order and be aligned
+  // for the value type. Writing to a ReadOnly mapping is not allowed;
+  // resizing the array copies the data into ordinary memory. Returns 1
+  // on success and 0 if the region does not fit the mapping or the array
+  // does not support mapped storage.
+  virtual int SetMappedStorage(vtkMemoryMappedFile *vtkNotUsed(file),
+                               vtkIdType vtkNotUsed(offset),
+                               vtkIdType vtkNotUsed(numberOfValues))
+    { return 0; }
+
   // Description:
   // Return the memory in kilobytes consumed by this data array. Used to
   // support streaming and reading/writing data. The value returned is
@@ -312,6 +327,30 @@ public:
     {
     this->GetRange(range,0);
     }
+
+  // Description:
+  // Same as GetRange(), ignoring NaN and infinite values.  When comp is -1
+  // tuples with a NaN or infinite component are left out of the magnitude
+  // range.
+  void GetFiniteRange(double range[2], int comp)
+    {
+    this->ComputeFiniteRange(comp);
+    memcpy(range, this->Range, 2*sizeof(double));
+    }
+  double* GetFiniteRange(int comp)
+    {
+    this->ComputeFiniteRange(comp);
+    return this->Range;
+    }
+  double* GetFiniteRange()
+    {
+    this->ComputeFiniteRange(0);
+    return this->Range;
+    }
+  void GetFiniteRange(double range[2])
+    {
+    this->GetFiniteRange(range,0);
+    }
   // Description:
   // These methods return the Min and Max possible range of the native
   // data type. For example if a vtkScalars consists of unsigned char
@@ -363,6 +402,11 @@ public:
   // When GetRange() is called when no tuples are present in the array
   // this value is set to { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN }.
   static vtkInformationDoubleVectorKey* L2_NORM_RANGE();
+  // Description:
+  // Same as COMPONENT_RANGE and L2_NORM_RANGE, for the ranges returned by
+  // GetFiniteRange().
+  static vtkInformationDoubleVectorKey* COMPONENT_FINITE_RANGE();
+  static vtkInformationDoubleVectorKey* L2_NORM_FINITE_RANGE();
 
   // Description:
   // Copy information instance. Arrays use information objects
@@ -377,11 +421,25 @@ protected:
   // Compute the range for a specific component. If comp is set -1
   // then L2 norm is computed on all components. Call ClearRange
   // to force a recomputation if it is needed.
+  // The ranges of all the components and of the L2 norm are cached in the
+  // information keys above and reused until the array is modified.
   virtual void ComputeRange(int comp);
+  void ComputeFiniteRange(int comp);
+
+  // Description:
+  // Compute in one pass over the tuples the range of each component and
+  // the range of the L2 norm, optionally ignoring NaN and infinite values.
+  // ranges holds 2*(NumberOfComponents+1) values, initialized to
+  // { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN }: the component ranges followed by
+  // the norm range.  The default implementation runs in parallel with
+  // vtkSMPTools.
+  virtual void ComputeRanges(double* ranges, int finiteOnly);
+
   // Description:
-  // Slow range computation methods. Reimplement.
-  virtual void ComputeScalarRange(int comp);
-  virtual void ComputeVectorRange();
+  // Interpolate through GetComponent()/InsertComponent().  Used when
+  // either array does not have the standard memory layout.
+  void InterpolateTupleGeneric(vtkIdType i, vtkIdList *ptIndices,
+                               vtkDataArray *fromData, double *weights);
 
   // Construct object with default tuple dimension (number of components) of 1.
   vtkDataArray(vtkIdType numComp=1);
@@ -392,6 +450,7 @@ protected:
 
 private:
   double* GetTupleN(vtkIdType i, int n);
+  void ComputeCachedRange(int comp, int finiteOnly);
 
 private:
   vtkDataArray(const vtkDataArray&);  // Not implemented.
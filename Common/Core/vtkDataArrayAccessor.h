@@ -0,0 +1,236 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayAccessor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkDataArrayAccessor - Typed access to the values of a
+// vtkDataArray independent of its memory layout.
+//
+// .SECTION Description
+// The accessors below give the same inline Get/Set interface over the
+// values of a vtkDataArray, whatever the way they are laid out in memory:
+//
+//   vtkAOSDataArrayAccessor<T>      interleaved values (vtkDataArrayTemplate)
+//   vtkSOADataArrayAccessor<T>      one buffer per component
+//                                   (vtkSOADataArrayTemplate)
+//   vtkGenericDataArrayAccessor<T>  any other vtkDataArray, through the
+//                                   virtual GetComponent/SetComponent
+//
+// A filter is written once as a template over the accessor type and
+// instantiated for each layout with vtkDataArrayAccessorMacro, which
+// selects both the value type and the layout of an array:
+//
+// \code
+// template <class Accessor>
+// void vtkMyFunction(Accessor input, double* out)
+// {
+//   for (vtkIdType t = 0; t < input.GetNumberOfTuples(); ++t)
+//     {
+//     out[t] = static_cast<double>(input.Get(t, 0));
+//     }
+// }
+//
+// vtkDataArrayAccessorMacro(array, vtkMyFunction(vtk_accessor, out));
+// \endcode
+//
+// Inside the call VTK_TT is the value type of the array, VTK_ACCESSOR the
+// accessor type and vtk_accessor an accessor bound to the array.  As with
+// vtkTemplateMacro, the call must not contain commas outside parentheses.
+// Types not handled by vtkTemplateMacro (e.g. VTK_BIT) are read as double
+// through vtkGenericDataArrayAccessor.
+//
+// .SECTION See Also
+// vtkSOADataArrayTemplate vtkDataArrayTemplate vtkTemplateMacro
+
+#ifndef __vtkDataArrayAccessor_h
+#define __vtkDataArrayAccessor_h
+
+#include "vtkDataArray.h"
+#include "vtkSOADataArrayTemplate.h"
+
+//----------------------------------------------------------------------------
+// Accessor for arrays that store the components of each tuple
+// contiguously (HasStandardMemoryLayout() returns 1).
+template <class T>
+class vtkAOSDataArrayAccessor
+{
+public:
+  typedef T ValueType;
+
+  vtkAOSDataArrayAccessor(vtkDataArray* array)
+    : Array(array),
+      Data(static_cast<T*>(array->GetVoidPointer(0))),
+      NumberOfComponents(array->GetNumberOfComponents())
+    {
+    }
+
+  vtkIdType GetNumberOfTuples() const
+    { return this->Array->GetNumberOfTuples(); }
+  int GetNumberOfComponents() const
+    { return this->NumberOfComponents; }
+
+  T Get(vtkIdType tuple, int comp) const
+    { return this->Data[tuple * this->NumberOfComponents + comp]; }
+  void Set(vtkIdType tuple, int comp, T value) const
+    { this->Data[tuple * this->NumberOfComponents + comp] = value; }
+
+  void GetTuple(vtkIdType tuple, T* values) const
+    {
+    const T* data = this->Data + tuple * this->NumberOfComponents;
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      values[c] = data[c];
+      }
+    }
+  void SetTuple(vtkIdType tuple, const T* values) const
+    {
+    T* data = this->Data + tuple * this->NumberOfComponents;
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      data[c] = values[c];
+      }
+    }
+
+private:
+  vtkDataArray* Array;
+  T* Data;
+  int NumberOfComponents;
+};
+
+//----------------------------------------------------------------------------
+// Accessor for vtkSOADataArrayTemplate.
+template <class T>
+class vtkSOADataArrayAccessor
+{
+public:
+  typedef T ValueType;
+
+  vtkSOADataArrayAccessor(vtkSOADataArrayTemplate<T>* array)
+    : Array(array),
+      NumberOfComponents(array->GetNumberOfComponents())
+    {
+    }
+
+  vtkIdType GetNumberOfTuples() const
+    { return this->Array->GetNumberOfTuples(); }
+  int GetNumberOfComponents() const
+    { return this->NumberOfComponents; }
+
+  T Get(vtkIdType tuple, int comp) const
+    { return this->Array->GetTypedComponent(tuple, comp); }
+  void Set(vtkIdType tuple, int comp, T value) const
+    { this->Array->SetTypedComponent(tuple, comp, value); }
+
+  void GetTuple(vtkIdType tuple, T* values) const
+    {
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      values[c] = this->Array->GetTypedComponent(tuple, c);
+      }
+    }
+  void SetTuple(vtkIdType tuple, const T* values) const
+    {
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      this->Array->SetTypedComponent(tuple, c, values[c]);
+      }
+    }
+
+private:
+  vtkSOADataArrayTemplate<T>* Array;
+  int NumberOfComponents;
+};
+
+//----------------------------------------------------------------------------
+// Fallback accessor going through the virtual vtkDataArray API.
+template <class T>
+class vtkGenericDataArrayAccessor
+{
+public:
+  typedef T ValueType;
+
+  vtkGenericDataArrayAccessor(vtkDataArray* array)
+    : Array(array),
+      NumberOfComponents(array->GetNumberOfComponents())
+    {
+    }
+
+  vtkIdType GetNumberOfTuples() const
+    { return this->Array->GetNumberOfTuples(); }
+  int GetNumberOfComponents() const
+    { return this->NumberOfComponents; }
+
+  T Get(vtkIdType tuple, int comp) const
+    { return static_cast<T>(this->Array->GetComponent(tuple, comp)); }
+  void Set(vtkIdType tuple, int comp, T value) const
+    {
+    this->Array->SetComponent(tuple, comp, static_cast<double>(value));
+    }
+
+  void GetTuple(vtkIdType tuple, T* values) const
+    {
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      values[c] = this->Get(tuple, c);
+      }
+    }
+  void SetTuple(vtkIdType tuple, const T* values) const
+    {
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+      this->Set(tuple, c, values[c]);
+      }
+    }
+
+private:
+  vtkDataArray* Array;
+  int NumberOfComponents;
+};
+
+//----------------------------------------------------------------------------
+#define vtkDataArrayAccessorLayoutMacro(array, call)                        \
+  if ((array)->HasStandardMemoryLayout())                                   \
+    {                                                                       \
+    typedef vtkAOSDataArrayAccessor<VTK_TT> VTK_ACCESSOR;                   \
+    VTK_ACCESSOR vtk_accessor(array);                                       \
+    call;                                                                   \
+    }                                                                       \
+  else if (vtkSOADataArrayTemplate<VTK_TT>::SafeDownCast(array))            \
+    {                                                                       \
+    typedef vtkSOADataArrayAccessor<VTK_TT> VTK_ACCESSOR;                   \
+    VTK_ACCESSOR vtk_accessor(                                              \
+      vtkSOADataArrayTemplate<VTK_TT>::SafeDownCast(array));                \
+    call;                                                                   \
+    }                                                                       \
+  else                                                                      \
+    {                                                                       \
+    typedef vtkGenericDataArrayAccessor<VTK_TT> VTK_ACCESSOR;               \
+    VTK_ACCESSOR vtk_accessor(array);                                       \
+    call;                                                                   \
+    }
+
+#define vtkDataArrayAccessorMacro(array, call)                              \
+  switch ((array)->GetDataType())                                           \
+    {                                                                       \
+    vtkTemplateMacro(vtkDataArrayAccessorLayoutMacro(array, call));         \
+    default:                                                                \
+      {                                                                     \
+      typedef double VTK_TT;                                                \
+      typedef vtkGenericDataArrayAccessor<VTK_TT> VTK_ACCESSOR;             \
+      VTK_ACCESSOR vtk_accessor(array);                                     \
+      call;                                                                 \
+      }                                                                     \
+    }
+
+#endif
+
+// VTK-HeaderTest-Exclude: vtkDataArrayAccessor.h
@@ -26,6 +26,7 @@
 
 template <class T>
 class vtkDataArrayTemplateLookup;
+class vtkMemoryMappedFile;
 
 template <class T>
 class VTKCOMMONCORE_EXPORT vtkDataArrayTemplate: public vtkDataArray
@@ -102,12 +103,10 @@ public:
   // Get the range of array values for the given component in the
   // native data type.
   void GetValueRange(T range[2], int comp) {
-    this->ComputeRange(comp);
-    range[0] = this->ValueRange[0];
-    range[1] = this->ValueRange[1]; }
-  T *GetValueRange(int comp) {
-    this->ComputeRange(comp);
-    return this->ValueRange; }
+    T* r = this->GetValueRange(comp);
+    range[0] = r[0];
+    range[1] = r[1]; }
+  T *GetValueRange(int comp);
 
   // Description:
   // Resize object to just fit data requirement. Reclaims extra memory.
@@ -202,7 +201,8 @@ public:
   enum DeleteMethod
   {
     VTK_DATA_ARRAY_FREE,
-    VTK_DATA_ARRAY_DELETE
+    VTK_DATA_ARRAY_DELETE,
+    VTK_DATA_ARRAY_UNMAP
   };
 //ETX
 
@@ -216,6 +216,8 @@ public:
   // array will be deallocated. If the delete method is
   // VTK_DATA_ARRAY_FREE, free() will be used. If the delete method is
   // DELETE, delete[] will be used. The default is FREE.
+  // VTK_DATA_ARRAY_UNMAP is only set by SetMappedStorage() and is
+  // rejected here.
   void SetArray(T* array, vtkIdType size, int save, int deleteMethod);
   void SetArray(T* array, vtkIdType size, int save)
     { this->SetArray(array, size, save, VTK_DATA_ARRAY_FREE); }
@@ -229,6 +231,14 @@ public:
       this->SetArray(static_cast<T*>(array), size, save, deleteMethod);
     }
 
+  // Description:
+  // Use a region of a memory mapped file as the storage of this array.
+  // The delete method becomes VTK_DATA_ARRAY_UNMAP: the array holds a
+  // reference to the mapping and releases it instead of freeing memory.
+  // See vtkDataArray::SetMappedStorage().
+  virtual int SetMappedStorage(vtkMemoryMappedFile *file, vtkIdType offset,
+                               vtkIdType numberOfValues);
+
   // Description:
   // This method copies the array data to the void pointer specified
   // by the user.  It is up to the user to allocate enough memory for
@@ -273,6 +283,8 @@ protected:
 
   T* Array;   // pointer to data
   T ValueRange[2]; // range of the data
+  int ValueRangeComponent; // component of ValueRange
+  vtkTimeStamp ValueRangeTime; // time ValueRange was computed
   T* ResizeAndExtend(vtkIdType sz);  // function to resize data
   T* Realloc(vtkIdType sz);
 
@@ -281,9 +293,8 @@ protected:
 
   int SaveUserArray;
   int DeleteMethod;
+  vtkMemoryMappedFile *MappedFile; // set when DeleteMethod is UNMAP
 
-  virtual void ComputeScalarRange(int comp);
-  virtual void ComputeVectorRange();
 private:
   vtkDataArrayTemplate(const vtkDataArrayTemplate&);  // Not implemented.
   void operator=(const vtkDataArrayTemplate&);  // Not implemented.
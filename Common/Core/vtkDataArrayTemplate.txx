@@ -23,6 +23,8 @@
 #include "vtkInformationDoubleVectorKey.h"
 #include "vtkInformationInformationVectorKey.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkSOADataArrayTemplate.h"
 #include "vtkSortDataArray.h"
 #include "vtkTypeTraits.h"
 #include <new>
@@ -66,6 +68,28 @@ public:
   bool Rebuild;
 };
 
+//----------------------------------------------------------------------------
+// Copy the jth tuple of a source array that does not have the standard
+// memory layout, so that GetVoidPointer() cannot be used on it.
+template <class T>
+void vtkDataArrayTemplateGetNonStandardTuple(vtkAbstractArray* source,
+                                             vtkIdType j, T* tuple)
+{
+  vtkSOADataArrayTemplate<T>* soa =
+    vtkSOADataArrayTemplate<T>::SafeDownCast(source);
+  if (soa)
+    {
+    soa->GetTupleValue(j, tuple);
+    return;
+    }
+  vtkDataArray* da = vtkDataArray::SafeDownCast(source);
+  int numComp = source->GetNumberOfComponents();
+  for (int c = 0; c < numComp; c++)
+    {
+    tuple[c] = da ? static_cast<T>(da->GetComponent(j, c)) : T();
+    }
+}
+
 //----------------------------------------------------------------------------
 template <class T>
 vtkDataArrayTemplate<T>::vtkDataArrayTemplate(vtkIdType numComp):
@@ -76,9 +100,11 @@ vtkDataArrayTemplate<T>::vtkDataArrayTemplate(vtkIdType numComp):
   this->TupleSize = 0;
   this->SaveUserArray = 0;
   this->DeleteMethod = VTK_DATA_ARRAY_FREE;
+  this->MappedFile = 0;
   this->Lookup = 0;
   this->ValueRange[0] = 0;
   this->ValueRange[1] = 1;
+  this->ValueRangeComponent = -1;
 }
 
 //----------------------------------------------------------------------------
@@ -109,6 +135,12 @@ void vtkDataArrayTemplate<T>::SetArray(T* array,
                                        int save,
                                        int deleteMethod)
 {
+  if (deleteMethod == VTK_DATA_ARRAY_UNMAP)
+    {
+    vtkErrorMacro("VTK_DATA_ARRAY_UNMAP can only be set by "
+                  "SetMappedStorage().");
+    return;
+    }
   this->DeleteArray();
 
   vtkDebugMacro(<<"Setting array to: " << static_cast<void*>(array));
@@ -121,6 +153,41 @@ void vtkDataArrayTemplate<T>::SetArray(T* array,
   this->DataChanged();
 }
 
+//----------------------------------------------------------------------------
+template <class T>
+int vtkDataArrayTemplate<T>::SetMappedStorage(vtkMemoryMappedFile *file,
+                                              vtkIdType offset,
+                                              vtkIdType numberOfValues)
+{
+  if (!file || !file->GetPointer() || offset < 0 || numberOfValues < 0 ||
+      static_cast<vtkTypeInt64>(offset) +
+      static_cast<vtkTypeInt64>(numberOfValues) *
+      static_cast<vtkTypeInt64>(sizeof(T)) > file->GetLength())
+    {
+    vtkErrorMacro("Region is not within the mapped file.");
+    return 0;
+    }
+  char *array = static_cast<char*>(file->GetPointer()) + offset;
+  if (reinterpret_cast<size_t>(array) % sizeof(T) != 0)
+    {
+    vtkDebugMacro("Mapped region is not aligned for the value type.");
+    return 0;
+    }
+
+  // Register before DeleteArray() in case the same mapping is reused.
+  file->Register(this);
+  this->DeleteArray();
+
+  this->Array = reinterpret_cast<T*>(array);
+  this->Size = numberOfValues;
+  this->MaxId = numberOfValues-1;
+  this->SaveUserArray = 0;
+  this->DeleteMethod = VTK_DATA_ARRAY_UNMAP;
+  this->MappedFile = file;
+  this->DataChanged();
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // Allocate memory for this array. Delete old storage only if necessary.
 template <class T>
@@ -128,7 +195,8 @@ int vtkDataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType)
 {
   this->MaxId = -1;
 
-  if(sz > this->Size)
+  // Mapped storage may be read-only, so it is never reused.
+  if(sz > this->Size || this->DeleteMethod == VTK_DATA_ARRAY_UNMAP)
     {
     this->DeleteArray();
 
@@ -228,7 +296,16 @@ void vtkDataArrayTemplate<T>::DeepCopy(vtkDataArray* fa)
     return;
     #endif
     }
-  if (fa->GetSize() > 0)
+  if (!fa->HasStandardMemoryLayout())
+    {
+    vtkIdType numTuples = fa->GetNumberOfTuples();
+    for (vtkIdType t = 0; t < numTuples; ++t)
+      {
+      vtkDataArrayTemplateGetNonStandardTuple(
+        fa, t, this->Array + t*this->NumberOfComponents);
+      }
+    }
+  else if (fa->GetSize() > 0)
     {
     memcpy(this->Array, fa->GetVoidPointer(0),
            static_cast<size_t>(this->Size)*sizeof(T));
@@ -263,11 +340,16 @@ void vtkDataArrayTemplate<T>::DeleteArray()
       {
       free(this->Array);
       }
+    else if (this->DeleteMethod == VTK_DATA_ARRAY_UNMAP)
+      {
+      this->MappedFile->UnRegister(this);
+      }
     else
       {
       delete[] this->Array;
       }
     }
+  this->MappedFile = 0;
   this->SaveUserArray = 0;
   this->DeleteMethod = VTK_DATA_ARRAY_FREE;
   this->Array = 0;
@@ -320,6 +402,7 @@ T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
       &&
       (this->SaveUserArray
        || this->DeleteMethod==VTK_DATA_ARRAY_DELETE
+       || this->DeleteMethod==VTK_DATA_ARRAY_UNMAP
        || dontUseRealloc ))
     {
     newArray = static_cast<T*>(malloc(static_cast<size_t>(newSize)*sizeof(T)));
@@ -430,6 +513,13 @@ void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
   vtkIdType loci = i * this->NumberOfComponents;
   vtkIdType locj = j * source->GetNumberOfComponents();
 
+  if (!source->HasStandardMemoryLayout())
+    {
+    vtkDataArrayTemplateGetNonStandardTuple(source, j, this->Array + loci);
+    this->DataChanged();
+    return;
+    }
+
   T* data = static_cast<T*>(source->GetVoidPointer(0));
 
   for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
@@ -471,10 +561,17 @@ void vtkDataArrayTemplate<T>::InsertTuple(vtkIdType i, vtkIdType j,
   vtkIdType locIn = j * inNumComp;
 
   T* outPtr = this->GetPointer(locOut);
-  T* inPtr = static_cast<T*>(source->GetVoidPointer(locIn));
+  if (!source->HasStandardMemoryLayout())
+    {
+    vtkDataArrayTemplateGetNonStandardTuple(source, j, outPtr);
+    }
+  else
+    {
+    T* inPtr = static_cast<T*>(source->GetVoidPointer(locIn));
 
-  size_t s=static_cast<size_t>(inNumComp);
-  memcpy(outPtr, inPtr, s*sizeof(T));
+    size_t s=static_cast<size_t>(inNumComp);
+    memcpy(outPtr, inPtr, s*sizeof(T));
+    }
 
   vtkIdType maxId = maxSize-1;
   if ( maxId > this->MaxId )
@@ -503,6 +600,13 @@ vtkIdType vtkDataArrayTemplate<T>::InsertNextTuple(vtkIdType j,
     return -1;
     }
 
+  if (!source->HasStandardMemoryLayout())
+    {
+    vtkIdType i = this->GetNumberOfTuples();
+    this->InsertTuple(i, j, source);
+    return i;
+    }
+
   // If this and source are the same, we need to make sure that
   // the array grows before we get the pointer. Growing the array
   // after getting the pointer may make it invalid.
@@ -920,78 +1024,62 @@ vtkIdType vtkDataArrayTemplate<T>::InsertNextValue(T f)
 }
 
 //----------------------------------------------------------------------------
+// The cached double range is exact for the types that a double holds
+// exactly. The 64 bit integers are scanned in their own type, as a double
+// would round the values above 2^53.
 template <class T>
-void vtkDataArrayTemplate<T>::ComputeScalarRange(int comp)
+T *vtkDataArrayTemplate<T>::GetValueRange(int comp)
 {
-  // Compute range only if there are data.
-  T* begin = this->Array+comp;
-  T* end = this->Array+comp+this->MaxId+1;
-  if(begin == end)
+  if (comp < 0 && this->NumberOfComponents == 1)
     {
-    return;
+    comp = 0;
     }
-
-  // Compute the range of scalar values.
-  int numComp = this->NumberOfComponents;
-  T range[2] = {vtkTypeTraits<T>::Max(), vtkTypeTraits<T>::Min()};
-  for(T* i = begin; i != end; i += numComp)
+  bool exactInDouble =
+    sizeof(T) <= 4 || static_cast<T>(0.5) != static_cast<T>(0);
+  if (exactInDouble || comp < 0 || comp >= this->NumberOfComponents)
     {
-    T s = *i;
-    if(s < range[0])
-      {
-      range[0] = s;
-      }
-    if(s > range[1])
+    this->ComputeRange(comp);
+    if (this->Range[0] <= this->Range[1])
       {
-      range[1] = s;
+      this->ValueRange[0] = static_cast<T>(this->Range[0]);
+      this->ValueRange[1] = static_cast<T>(this->Range[1]);
       }
+    return this->ValueRange;
     }
 
-  // Store the range.
-  this->ValueRange[0] = range[0];
-  this->ValueRange[1] = range[1];
-  this->Range[0] = static_cast<double>(range[0]);
-  this->Range[1] = static_cast<double>(range[1]);
-}
+  if (comp == this->ValueRangeComponent &&
+      this->ValueRangeTime > this->GetMTime())
+    {
+    return this->ValueRange;
+    }
 
-//----------------------------------------------------------------------------
-template <class T>
-void vtkDataArrayTemplate<T>::ComputeVectorRange()
-{
   // Compute range only if there are data.
-  T* begin = this->Array;
-  T* end = this->Array+this->MaxId+1;
+  T* begin = this->Array+comp;
+  T* end = this->Array+comp+this->MaxId+1;
   if(begin == end)
     {
-    return;
+    return this->ValueRange;
     }
 
-  // Compute the range of vector magnitude squared.
   int numComp = this->NumberOfComponents;
-  double range[2] = {VTK_DOUBLE_MAX, VTK_DOUBLE_MIN};
+  T range[2] = {vtkTypeTraits<T>::Max(), vtkTypeTraits<T>::Min()};
   for(T* i = begin; i != end; i += numComp)
     {
-    double s = 0.0;
-    for(int j=0; j < numComp; ++j)
-      {
-      double t = static_cast<double>(i[j]);
-      s += t*t;
-      }
+    T s = *i;
     if(s < range[0])
       {
       range[0] = s;
       }
-    // this cannot be an elseif because there may be only one vector in which
-    // case the range[1] would be left at a bad value
     if(s > range[1])
       {
       range[1] = s;
       }
     }
-
-  // Store the range of vector magnitude.
-  this->Range[0] = sqrt(range[0]);
-  this->Range[1] = sqrt(range[1]);
+  this->ValueRange[0] = range[0];
+  this->ValueRange[1] = range[1];
+  this->ValueRangeComponent = comp;
+  this->ValueRangeTime.Modified();
+  return this->ValueRange;
 }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImplicitArray - Read-only vtkDataArray whose values are
+// computed on demand.
+//
+// .SECTION Description
+// vtkImplicitArray<T, F> stores no values. Each value is computed when it
+// is requested by calling a function object of type F:
+//
+// \code
+// struct F
+// {
+//   T operator()(vtkIdType tuple, int comp) const;
+// };
+// \endcode
+//
+// The function must be copyable and safe to call from several threads.
+// vtkImplicitArrayFunctions.h provides functions for constant, affine
+// and index arrays, for the points of uniform and rectilinear grids and
+// for the concatenation of other arrays. The shape of the array is set
+// as usual with SetNumberOfComponents() and SetNumberOfTuples():
+//
+// \code
+// typedef vtkImplicitArray<double, vtkConstantFunction<double> >
+//   ConstantArray;
+// vtkSmartPointer<ConstantArray> ones = vtkSmartPointer<ConstantArray>::New();
+// ones->SetFunction(vtkConstantFunction<double>(1.0));
+// ones->SetNumberOfTuples(numberOfPoints);
+// \endcode
+//
+// The array is read-only: the methods that change values report an error.
+// The vtkDataArray API that reads values works as for any other array.
+// Reading through GetVoidPointer() materializes the values into a buffer
+// owned by the array. The buffer is built under a lock, so several
+// threads may call GetVoidPointer() at the same time, and it is kept
+// until the array is modified. NewMaterializedArray() returns a regular
+// array holding a copy of the values.
+//
+// NewInstance() returns a regular vtkDataArrayTemplate of the same value
+// type, as a vtkDataArray, not a vtkImplicitArray. This lets filters
+// that create output arrays "of the same type" as their input, e.g.
+// through vtkDataSetAttributes::CopyAllocate(), fill them as usual.
+//
+// .SECTION See Also
+// vtkImplicitArrayFunctions vtkSOADataArrayTemplate vtkDataArrayAccessor
+
+#ifndef __vtkImplicitArray_h
+#define __vtkImplicitArray_h
+
+#include "vtkDataArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkTimeStamp.h" // For MaterializedTime
+#include "vtkTypeTemplate.h"
+#include "vtkTypeTraits.h"
+
+class vtkSimpleCriticalSection;
+
+template <class T, class F>
+class vtkImplicitArray :
+  public vtkTypeTemplate<vtkImplicitArray<T, F>, vtkDataArray>
+{
+public:
+  typedef vtkDataArray Superclass;
+  typedef T ValueType;
+  typedef F FunctionType;
+  static vtkImplicitArray<T, F>* New();
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set/Get the function that computes the values.
+  void SetFunction(const F& function)
+    {
+    this->Function = function;
+    this->DataChanged();
+    this->Modified();
+    }
+  const F& GetFunction() const { return this->Function; }
+
+  // Description:
+  // Compute a value by its (tuple, component) pair or by its index in the
+  // equivalent interleaved array.  No range checking is done.
+  inline T GetTypedComponent(vtkIdType tupleIdx, int comp) const
+    { return this->Function(tupleIdx, comp); }
+  inline T GetValue(vtkIdType valueIdx) const
+    {
+    return this->Function(valueIdx / this->NumberOfComponents,
+                          valueIdx % this->NumberOfComponents);
+    }
+  void GetTupleValue(vtkIdType i, T* tuple);
+
+  // Description:
+  // Return a new, empty regular array (vtkDataArrayTemplate) of the same
+  // value type.  See the class description.
+  vtkDataArray* NewInstance() const
+    { return static_cast<vtkDataArray*>(this->NewInstanceInternal()); }
+
+  // Description:
+  // Return a new regular array (vtkDataArrayTemplate) holding a copy of
+  // the values.  The caller must Delete() it.
+  vtkDataArray* NewMaterializedArray();
+
+  // Description:
+  // Implementation of the vtkAbstractArray / vtkDataArray API.
+  int Allocate(vtkIdType sz, vtkIdType ext=1000);
+  void Initialize();
+  int GetDataType() { return vtkTypeTraits<T>::VTKTypeID(); }
+  int GetDataTypeSize() { return static_cast<int>(sizeof(T)); }
+  void SetNumberOfTuples(vtkIdType number);
+  void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray* source);
+  double* GetTuple(vtkIdType i);
+  void GetTuple(vtkIdType i, double* tuple);
+  void SetTuple(vtkIdType i, const float* tuple);
+  void SetTuple(vtkIdType i, const double* tuple);
+  void InsertTuple(vtkIdType i, const float* tuple);
+  void InsertTuple(vtkIdType i, const double* tuple);
+  vtkIdType InsertNextTuple(const float* tuple);
+  vtkIdType InsertNextTuple(const double* tuple);
+  void RemoveTuple(vtkIdType id);
+  void RemoveFirstTuple() { this->RemoveTuple(0); }
+  void RemoveLastTuple();
+  double GetComponent(vtkIdType i, int j);
+  void SetComponent(vtkIdType i, int j, double c);
+  void InsertComponent(vtkIdType i, int j, double c);
+  void* WriteVoidPointer(vtkIdType id, vtkIdType number);
+  void* GetVoidPointer(vtkIdType id);
+  int HasStandardMemoryLayout() { return 0; }
+  void DeepCopy(vtkDataArray* da);
+  void DeepCopy(vtkAbstractArray* aa) { this->Superclass::DeepCopy(aa); }
+  void Squeeze() {}
+  int Resize(vtkIdType numTuples);
+  void SetVoidArray(void* array, vtkIdType size, int save);
+  void SetVoidArray(void* array, vtkIdType size, int save, int deleteMethod);
+  void ExportToVoidPointer(void* out_ptr);
+  unsigned long GetActualMemorySize();
+  vtkArrayIterator* NewIterator();
+  vtkIdType LookupValue(vtkVariant value);
+  void LookupValue(vtkVariant value, vtkIdList* ids);
+  vtkIdType LookupValue(T value);
+  void LookupValue(T value, vtkIdList* ids);
+  vtkVariant GetVariantValue(vtkIdType idx);
+  void SetVariantValue(vtkIdType idx, vtkVariant value);
+  void DataChanged();
+  void ClearLookup() {}
+
+protected:
+  vtkImplicitArray();
+  ~vtkImplicitArray();
+
+  // Regular array of the same value type, see the class description.
+  virtual vtkObjectBase* NewInstanceInternal() const
+    {
+    return vtkDataArray::CreateDataArray(vtkTypeTraits<T>::VTKTypeID());
+    }
+
+  // Report an attempt to modify the values.
+  void ReadOnlyError(const char* method);
+
+  F Function;
+
+  int TupleSize; // used by GetTuple(i)
+  double* Tuple;
+
+  T* Materialized; // buffer returned by GetVoidPointer
+  vtkIdType MaterializedSize; // number of values Materialized can hold
+  vtkTimeStamp MaterializedTime;
+  vtkSimpleCriticalSection* MaterializedLock; // serializes GetVoidPointer
+
+private:
+  vtkImplicitArray(const vtkImplicitArray&);  // Not implemented.
+  void operator=(const vtkImplicitArray&);  // Not implemented.
+
+  typedef vtkImplicitArray<T, F> ThisT;
+};
+
+#include "vtkImplicitArray.txx"
+
+#endif
+
+// VTK-HeaderTest-Exclude: vtkImplicitArray.h
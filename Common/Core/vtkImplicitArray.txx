@@ -0,0 +1,521 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#ifndef __vtkImplicitArray_txx
+#define __vtkImplicitArray_txx
+
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkCriticalSection.h"
+#include "vtkIdList.h"
+#include "vtkSMPTools.h"
+
+#include <cstdlib>
+
+//----------------------------------------------------------------------------
+// Writes the values of a range of tuples into an interleaved buffer.
+template <class T, class F>
+class vtkImplicitArrayExport
+{
+public:
+  const F* Function;
+  T* Output;
+  int NumberOfComponents;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const F& function = *this->Function;
+    int numComps = this->NumberOfComponents;
+    T* out = this->Output + begin * numComps;
+    for (vtkIdType t = begin; t < end; ++t)
+      {
+      for (int c = 0; c < numComps; ++c)
+        {
+        *out++ = function(t, c);
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+vtkImplicitArray<T, F>* vtkImplicitArray<T, F>::New()
+{
+  vtkObject* ret =
+    vtkObjectFactory::CreateInstance(typeid(ThisT).name());
+  if(ret)
+    {
+    return static_cast<ThisT*>(ret);
+    }
+  return new ThisT();
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+vtkImplicitArray<T, F>::vtkImplicitArray()
+{
+  this->TupleSize = 0;
+  this->Tuple = 0;
+  this->Materialized = 0;
+  this->MaterializedSize = 0;
+  this->MaterializedLock = new vtkSimpleCriticalSection;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+vtkImplicitArray<T, F>::~vtkImplicitArray()
+{
+  free(this->Tuple);
+  free(this->Materialized);
+  delete this->MaterializedLock;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Materialized: "
+     << (this->Materialized ? "Yes" : "No") << "\n";
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::ReadOnlyError(const char* method)
+{
+  vtkErrorMacro(<< method << " is not supported: the values of an "
+                "implicit array are read-only.");
+}
+
+//----------------------------------------------------------------------------
+// There is no storage: allocation only sets the number of values.
+template <class T, class F>
+int vtkImplicitArray<T, F>::Allocate(vtkIdType sz, vtkIdType)
+{
+  this->Size = sz > 0 ? sz : 0;
+  this->MaxId = -1;
+  this->DataChanged();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::Initialize()
+{
+  this->Size = 0;
+  this->MaxId = -1;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+int vtkImplicitArray<T, F>::Resize(vtkIdType numTuples)
+{
+  this->SetNumberOfTuples(numTuples > 0 ? numTuples : 0);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::SetNumberOfTuples(vtkIdType number)
+{
+  this->Size = number * this->NumberOfComponents;
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::DataChanged()
+{
+  this->MaterializedLock->Lock();
+  free(this->Materialized);
+  this->Materialized = 0;
+  this->MaterializedSize = 0;
+  this->MaterializedLock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::GetTupleValue(vtkIdType i, T* tuple)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    tuple[c] = this->Function(i, c);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+double* vtkImplicitArray<T, F>::GetTuple(vtkIdType i)
+{
+  if (this->TupleSize < this->NumberOfComponents)
+    {
+    this->TupleSize = this->NumberOfComponents;
+    free(this->Tuple);
+    this->Tuple = static_cast<double*>(
+      malloc(static_cast<size_t>(this->TupleSize) * sizeof(double)));
+    }
+  if (!this->Tuple)
+    {
+    vtkErrorMacro("Unable to allocate " << this->TupleSize
+                  << " elements of size " << sizeof(double)
+                  << " bytes. ");
+    return 0;
+    }
+  this->GetTuple(i, this->Tuple);
+  return this->Tuple;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::GetTuple(vtkIdType i, double* tuple)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    tuple[c] = static_cast<double>(this->Function(i, c));
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+double vtkImplicitArray<T, F>::GetComponent(vtkIdType i, int j)
+{
+  return static_cast<double>(this->Function(i, j));
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::SetTuple(vtkIdType, vtkIdType,
+                                      vtkAbstractArray*)
+{
+  this->ReadOnlyError("SetTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::InsertTuple(vtkIdType, vtkIdType,
+                                         vtkAbstractArray*)
+{
+  this->ReadOnlyError("InsertTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+vtkIdType vtkImplicitArray<T, F>::InsertNextTuple(vtkIdType,
+                                                  vtkAbstractArray*)
+{
+  this->ReadOnlyError("InsertNextTuple");
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::SetTuple(vtkIdType, const float*)
+{
+  this->ReadOnlyError("SetTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::SetTuple(vtkIdType, const double*)
+{
+  this->ReadOnlyError("SetTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::InsertTuple(vtkIdType, const float*)
+{
+  this->ReadOnlyError("InsertTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::InsertTuple(vtkIdType, const double*)
+{
+  this->ReadOnlyError("InsertTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+vtkIdType vtkImplicitArray<T, F>::InsertNextTuple(const float*)
+{
+  this->ReadOnlyError("InsertNextTuple");
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+vtkIdType vtkImplicitArray<T, F>::InsertNextTuple(const double*)
+{
+  this->ReadOnlyError("InsertNextTuple");
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::RemoveTuple(vtkIdType)
+{
+  this->ReadOnlyError("RemoveTuple");
+}
+
+//----------------------------------------------------------------------------
+// Dropping the last tuple does not change the other values, so it is
+// allowed.
+template <class T, class F>
+void vtkImplicitArray<T, F>::RemoveLastTuple()
+{
+  if (this->MaxId >= 0)
+    {
+    this->SetNumberOfTuples(this->GetNumberOfTuples() - 1);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::SetComponent(vtkIdType, int, double)
+{
+  this->ReadOnlyError("SetComponent");
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::InsertComponent(vtkIdType, int, double)
+{
+  this->ReadOnlyError("InsertComponent");
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void* vtkImplicitArray<T, F>::WriteVoidPointer(vtkIdType, vtkIdType)
+{
+  this->ReadOnlyError("WriteVoidPointer");
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::SetVoidArray(void*, vtkIdType, int)
+{
+  this->ReadOnlyError("SetVoidArray");
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::SetVoidArray(void*, vtkIdType, int, int)
+{
+  this->ReadOnlyError("SetVoidArray");
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::SetVariantValue(vtkIdType, vtkVariant)
+{
+  this->ReadOnlyError("SetVariantValue");
+}
+
+//----------------------------------------------------------------------------
+// The values are materialized on first use and kept until the array is
+// modified.  Changes made through the pointer are not seen by the array.
+// The buffer is checked and filled under MaterializedLock so that
+// concurrent readers never see it half written or freed.
+template <class T, class F>
+void* vtkImplicitArray<T, F>::GetVoidPointer(vtkIdType id)
+{
+  vtkIdType numValues = this->MaxId + 1;
+  if (numValues <= 0)
+    {
+    return 0;
+    }
+
+  T* values = 0;
+  this->MaterializedLock->Lock();
+  if (this->Materialized && this->MaterializedTime > this->GetMTime())
+    {
+    values = this->Materialized;
+    }
+  else
+    {
+    if (this->MaterializedSize != numValues)
+      {
+      free(this->Materialized);
+      this->Materialized = static_cast<T*>(
+        malloc(static_cast<size_t>(numValues) * sizeof(T)));
+      this->MaterializedSize = this->Materialized ? numValues : 0;
+      }
+    if (this->Materialized)
+      {
+      this->ExportToVoidPointer(this->Materialized);
+      this->MaterializedTime.Modified();
+      values = this->Materialized;
+      }
+    }
+  this->MaterializedLock->Unlock();
+
+  if (!values)
+    {
+    vtkErrorMacro("Unable to allocate a copy of " << numValues
+                  << " values.");
+    return 0;
+    }
+  return values + id;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::ExportToVoidPointer(void* out_ptr)
+{
+  if (!out_ptr)
+    {
+    return;
+    }
+  vtkImplicitArrayExport<T, F> exporter;
+  exporter.Function = &this->Function;
+  exporter.Output = static_cast<T*>(out_ptr);
+  exporter.NumberOfComponents = this->NumberOfComponents;
+  vtkSMPTools::For(0, this->GetNumberOfTuples(), exporter);
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+vtkDataArray* vtkImplicitArray<T, F>::NewMaterializedArray()
+{
+  vtkDataArray* array =
+    vtkDataArray::CreateDataArray(vtkTypeTraits<T>::VTKTypeID());
+  array->SetNumberOfComponents(this->NumberOfComponents);
+  array->SetNumberOfTuples(this->GetNumberOfTuples());
+  array->SetName(this->GetName());
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    if (this->GetComponentName(c))
+      {
+      array->SetComponentName(c, this->GetComponentName(c));
+      }
+    }
+  this->ExportToVoidPointer(array->GetVoidPointer(0));
+  return array;
+}
+
+//----------------------------------------------------------------------------
+// Only the values of another implicit array of the same kind can be
+// copied, by copying its function.
+template <class T, class F>
+void vtkImplicitArray<T, F>::DeepCopy(vtkDataArray* da)
+{
+  if (!da || da == this)
+    {
+    return;
+    }
+  ThisT* other = ThisT::SafeDownCast(da);
+  if (!other)
+    {
+    this->ReadOnlyError("DeepCopy from a different array type");
+    return;
+    }
+  this->vtkAbstractArray::DeepCopy(da);
+  this->NumberOfComponents = other->NumberOfComponents;
+  this->Function = other->Function;
+  this->SetNumberOfTuples(other->GetNumberOfTuples());
+}
+
+//----------------------------------------------------------------------------
+// Only the materialized copy, if any, takes memory.
+template <class T, class F>
+unsigned long vtkImplicitArray<T, F>::GetActualMemorySize()
+{
+  if (!this->Materialized)
+    {
+    return 1;
+    }
+  return static_cast<unsigned long>(
+    (static_cast<double>(this->MaxId + 1) * sizeof(T)) / 1024.0) + 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+vtkArrayIterator* vtkImplicitArray<T, F>::NewIterator()
+{
+  // The iterator reads the values materialized by GetVoidPointer().
+  vtkArrayIteratorTemplate<T>* iter = vtkArrayIteratorTemplate<T>::New();
+  iter->Initialize(this);
+  return iter;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+vtkIdType vtkImplicitArray<T, F>::LookupValue(T value)
+{
+  vtkIdType numValues = this->MaxId + 1;
+  for (vtkIdType i = 0; i < numValues; ++i)
+    {
+    if (this->GetValue(i) == value)
+      {
+      return i;
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::LookupValue(T value, vtkIdList* ids)
+{
+  ids->Reset();
+  vtkIdType numValues = this->MaxId + 1;
+  for (vtkIdType i = 0; i < numValues; ++i)
+    {
+    if (this->GetValue(i) == value)
+      {
+      ids->InsertNextId(i);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+vtkIdType vtkImplicitArray<T, F>::LookupValue(vtkVariant value)
+{
+  T* dummyPtr = 0;
+  bool valid = true;
+  T tvalue = value.ToNumeric(&valid, dummyPtr);
+  if (valid)
+    {
+    return this->LookupValue(tvalue);
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+void vtkImplicitArray<T, F>::LookupValue(vtkVariant value, vtkIdList* ids)
+{
+  T* dummyPtr = 0;
+  bool valid = true;
+  T tvalue = value.ToNumeric(&valid, dummyPtr);
+  ids->Reset();
+  if (valid)
+    {
+    this->LookupValue(tvalue, ids);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T, class F>
+vtkVariant vtkImplicitArray<T, F>::GetVariantValue(vtkIdType idx)
+{
+  return vtkVariant(this->GetValue(idx));
+}
+
+#endif
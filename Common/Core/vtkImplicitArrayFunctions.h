@@ -0,0 +1,232 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArrayFunctions.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImplicitArrayFunctions - Value functions for vtkImplicitArray.
+//
+// .SECTION Description
+// Function objects that compute the values of a vtkImplicitArray:
+//
+//   vtkConstantFunction<T>           the same value for every tuple, one
+//                                    value per component or for all of them
+//   vtkAffineFunction<T>             Slope * valueIndex + Intercept
+//   vtkIndexFunction                 the tuple index, as vtkIdType
+//   vtkUniformGridPointsFunction     the point coordinates of a
+//                                    vtkImageData (origin, spacing, extent)
+//   vtkRectilinearGridPointsFunction the point coordinates of a
+//                                    vtkRectilinearGrid (three coordinate
+//                                    arrays)
+//   vtkConcatenateFunction<T>        the tuples of several arrays, one
+//                                    array after the other
+//
+// .SECTION See Also
+// vtkImplicitArray
+
+#ifndef __vtkImplicitArrayFunctions_h
+#define __vtkImplicitArrayFunctions_h
+
+#include "vtkDataArray.h"
+#include "vtkSmartPointer.h" // For the arrays referenced by the functions
+
+#include <algorithm> // For std::upper_bound
+#include <vector> // For the values and arrays of the functions
+
+//----------------------------------------------------------------------------
+template <class T>
+class vtkConstantFunction
+{
+public:
+  vtkConstantFunction() : Values(1, T()) {}
+  explicit vtkConstantFunction(T value) : Values(1, value) {}
+
+  // Description:
+  // Use one value per component.
+  vtkConstantFunction(const T* values, int numComps)
+    : Values(values, values + numComps) {}
+
+  T operator()(vtkIdType, int comp) const
+    {
+    return this->Values.size() == 1 ? this->Values[0] : this->Values[comp];
+    }
+
+  std::vector<T> Values;
+};
+
+//----------------------------------------------------------------------------
+// The value index is tuple * NumberOfComponents + comp, as in an
+// interleaved array.
+template <class T>
+class vtkAffineFunction
+{
+public:
+  vtkAffineFunction() : Slope(1), Intercept(0), NumberOfComponents(1) {}
+  vtkAffineFunction(double slope, double intercept, int numComps = 1)
+    : Slope(slope), Intercept(intercept), NumberOfComponents(numComps) {}
+
+  T operator()(vtkIdType tuple, int comp) const
+    {
+    return static_cast<T>(this->Slope * static_cast<double>(
+      tuple * this->NumberOfComponents + comp) + this->Intercept);
+    }
+
+  double Slope;
+  double Intercept;
+  int NumberOfComponents;
+};
+
+//----------------------------------------------------------------------------
+class vtkIndexFunction
+{
+public:
+  vtkIdType operator()(vtkIdType tuple, int) const
+    {
+    return tuple;
+    }
+};
+
+//----------------------------------------------------------------------------
+// Points are ordered with x varying fastest, as in vtkImageData.
+class vtkUniformGridPointsFunction
+{
+public:
+  vtkUniformGridPointsFunction()
+    {
+    for (int i = 0; i < 3; ++i)
+      {
+      this->Origin[i] = 0.0;
+      this->Spacing[i] = 1.0;
+      this->Extent[2 * i] = this->Extent[2 * i + 1] = 0;
+      }
+    }
+  vtkUniformGridPointsFunction(const double origin[3],
+                               const double spacing[3],
+                               const int extent[6])
+    {
+    for (int i = 0; i < 3; ++i)
+      {
+      this->Origin[i] = origin[i];
+      this->Spacing[i] = spacing[i];
+      this->Extent[2 * i] = extent[2 * i];
+      this->Extent[2 * i + 1] = extent[2 * i + 1];
+      }
+    }
+
+  double operator()(vtkIdType tuple, int comp) const
+    {
+    vtkIdType nx = this->Extent[1] - this->Extent[0] + 1;
+    vtkIdType ny = this->Extent[3] - this->Extent[2] + 1;
+    vtkIdType ijk;
+    switch (comp)
+      {
+      case 0: ijk = tuple % nx; break;
+      case 1: ijk = (tuple / nx) % ny; break;
+      default: ijk = tuple / (nx * ny); break;
+      }
+    return this->Origin[comp] +
+      this->Spacing[comp] * static_cast<double>(ijk + this->Extent[2 * comp]);
+    }
+
+  // Description:
+  // Number of points of the grid.
+  vtkIdType GetNumberOfPoints() const
+    {
+    return static_cast<vtkIdType>(this->Extent[1] - this->Extent[0] + 1) *
+      (this->Extent[3] - this->Extent[2] + 1) *
+      (this->Extent[5] - this->Extent[4] + 1);
+    }
+
+  double Origin[3];
+  double Spacing[3];
+  int Extent[6];
+};
+
+//----------------------------------------------------------------------------
+// Points are ordered with x varying fastest, as in vtkRectilinearGrid.
+class vtkRectilinearGridPointsFunction
+{
+public:
+  vtkRectilinearGridPointsFunction() {}
+  vtkRectilinearGridPointsFunction(vtkDataArray* x, vtkDataArray* y,
+                                   vtkDataArray* z)
+    {
+    this->Coordinates[0] = x;
+    this->Coordinates[1] = y;
+    this->Coordinates[2] = z;
+    }
+
+  double operator()(vtkIdType tuple, int comp) const
+    {
+    vtkIdType nx = this->Coordinates[0]->GetNumberOfTuples();
+    vtkIdType ny = this->Coordinates[1]->GetNumberOfTuples();
+    vtkIdType ijk;
+    switch (comp)
+      {
+      case 0: ijk = tuple % nx; break;
+      case 1: ijk = (tuple / nx) % ny; break;
+      default: ijk = tuple / (nx * ny); break;
+      }
+    return this->Coordinates[comp]->GetComponent(ijk, 0);
+    }
+
+  // Description:
+  // Number of points of the grid.
+  vtkIdType GetNumberOfPoints() const
+    {
+    return this->Coordinates[0]->GetNumberOfTuples() *
+      this->Coordinates[1]->GetNumberOfTuples() *
+      this->Coordinates[2]->GetNumberOfTuples();
+    }
+
+  vtkSmartPointer<vtkDataArray> Coordinates[3];
+};
+
+//----------------------------------------------------------------------------
+// All the arrays must have the number of components of the implicit array.
+template <class T>
+class vtkConcatenateFunction
+{
+public:
+  vtkConcatenateFunction() : Offsets(1, 0) {}
+
+  // Description:
+  // Append the tuples of an array.
+  void AddArray(vtkDataArray* array)
+    {
+    this->Arrays.push_back(array);
+    this->Offsets.push_back(this->Offsets.back() +
+                            array->GetNumberOfTuples());
+    }
+
+  // Description:
+  // Total number of tuples of the arrays.
+  vtkIdType GetNumberOfTuples() const
+    {
+    return this->Offsets.back();
+    }
+
+  T operator()(vtkIdType tuple, int comp) const
+    {
+    size_t a = static_cast<size_t>(
+      std::upper_bound(this->Offsets.begin(), this->Offsets.end(), tuple) -
+      this->Offsets.begin()) - 1;
+    return static_cast<T>(
+      this->Arrays[a]->GetComponent(tuple - this->Offsets[a], comp));
+    }
+
+  std::vector<vtkSmartPointer<vtkDataArray> > Arrays;
+  std::vector<vtkIdType> Offsets; // first tuple of each array
+};
+
+#endif
+
+// VTK-HeaderTest-Exclude: vtkImplicitArrayFunctions.h
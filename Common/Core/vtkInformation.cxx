@@ -76,12 +76,14 @@ void vtkInformation::PrintSelf(ostream& os, vtkIndent indent)
 //----------------------------------------------------------------------------
 void vtkInformation::PrintKeys(ostream& os, vtkIndent indent)
 {
-  typedef vtkInformationInternals::MapType MapType;
-  for(MapType::const_iterator i = this->Internal->Map.begin();
-      i != this->Internal->Map.end(); ++i)
+  vtkSmartPointer<vtkInformationIterator> infoIterator =
+    vtkSmartPointer<vtkInformationIterator>::New();
+  infoIterator->SetInformationWeak(this);
+  for (infoIterator->InitTraversal(); !infoIterator->IsDoneWithTraversal();
+    infoIterator->GoToNextItem())
     {
     // Print the key name first.
-    vtkInformationKey* key = i->first;
+    vtkInformationKey* key = infoIterator->GetCurrentKey();
     os << indent << key->GetName() << ": ";
 
     // Ask the key to print its value.
@@ -132,6 +134,22 @@ void vtkInformation::SetAsObjectBase(vtkInformationKey* key,
     {
     return;
     }
+  int slot = key->GetSlot();
+  if(slot >= 0)
+    {
+    vtkObjectBase* oldvalue = this->Internal->Slots[slot];
+    if(newvalue)
+      {
+      newvalue->Register(0);
+      }
+    this->Internal->Slots[slot] = newvalue;
+    if(oldvalue)
+      {
+      oldvalue->UnRegister(0);
+      }
+    this->Modified(key);
+    return;
+    }
   typedef vtkInformationInternals::MapType MapType;
   MapType::iterator i = this->Internal->Map.find(key);
   if(i != this->Internal->Map.end())
@@ -162,6 +180,11 @@ vtkObjectBase* vtkInformation::GetAsObjectBase(vtkInformationKey* key)
 {
   if(key)
     {
+    int slot = key->GetSlot();
+    if(slot >= 0)
+      {
+      return this->Internal->Slots[slot];
+      }
     typedef vtkInformationInternals::MapType MapType;
     MapType::const_iterator i = this->Internal->Map.find(key);
     if(i != this->Internal->Map.end())
@@ -185,6 +208,13 @@ void vtkInformation::Copy(vtkInformation* from, int deep)
   this->Internal = new vtkInformationInternals;
   if(from)
     {
+    for(int slot = 0; slot < VTK_INFORMATION_NUMBER_OF_SLOTS; ++slot)
+      {
+      if(from->Internal->Slots[slot])
+        {
+        this->CopyEntry(from, vtkInformationKey::GetKeyInSlot(slot), deep);
+        }
+      }
     typedef vtkInformationInternals::MapType MapType;
     for(MapType::const_iterator i = from->Internal->Map.begin();
         i != from->Internal->Map.end(); ++i)
@@ -805,6 +835,13 @@ void vtkInformation::ReportReferences(vtkGarbageCollector* collector)
 {
   this->Superclass::ReportReferences(collector);
   // Ask each key/value pair to report any references it holds.
+  for(int slot = 0; slot < VTK_INFORMATION_NUMBER_OF_SLOTS; ++slot)
+    {
+    if(this->Internal->Slots[slot])
+      {
+      vtkInformationKey::GetKeyInSlot(slot)->Report(this, collector);
+      }
+    }
   typedef vtkInformationInternals::MapType MapType;
   for(MapType::const_iterator i = this->Internal->Map.begin();
       i != this->Internal->Map.end(); ++i)
@@ -819,6 +856,16 @@ void vtkInformation::ReportAsObjectBase(vtkInformationKey* key,
 {
   if(key)
     {
+    int slot = key->GetSlot();
+    if(slot >= 0)
+      {
+      if(this->Internal->Slots[slot])
+        {
+        vtkGarbageCollectorReport(collector, this->Internal->Slots[slot],
+                                  key->GetName());
+        }
+      return;
+      }
     typedef vtkInformationInternals::MapType MapType;
     MapType::iterator i = this->Internal->Map.find(key);
     if(i != this->Internal->Map.end())
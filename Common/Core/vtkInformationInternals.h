@@ -17,6 +17,10 @@
 // vtkInformationInternals is used in internal implementation of
 // vtkInformation. This should only be accessed by friends
 // and sub-classes of that class.
+//
+// The values of keys that own a slot (see vtkInformationKey::AllocateSlot)
+// are stored in the Slots array, indexed by the slot.  All other values
+// are stored in Map.
 
 #ifndef __vtkInformationInternals_h
 #define __vtkInformationInternals_h
@@ -50,13 +54,29 @@ public:
   typedef vtksys_stl::map<KeyType, DataType> MapType;
 #endif
   MapType Map;
+  DataType Slots[VTK_INFORMATION_NUMBER_OF_SLOTS];
 
 #ifdef VTK_INFORMATION_USE_HASH_MAP
-  vtkInformationInternals(): Map(33) {}
+  vtkInformationInternals(): Map(33)
+#else
+  vtkInformationInternals()
 #endif
+    {
+    for(int i = 0; i < VTK_INFORMATION_NUMBER_OF_SLOTS; ++i)
+      {
+      this->Slots[i] = 0;
+      }
+    }
 
   ~vtkInformationInternals()
     {
+    for(int i = 0; i < VTK_INFORMATION_NUMBER_OF_SLOTS; ++i)
+      {
+      if(vtkObjectBase* value = this->Slots[i])
+        {
+        value->UnRegister(0);
+        }
+      }
     for(MapType::iterator i = this->Map.begin(); i != this->Map.end(); ++i)
       {
       if(vtkObjectBase* value = i->second)
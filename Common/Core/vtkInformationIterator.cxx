@@ -21,16 +21,30 @@
 
 vtkStandardNewMacro(vtkInformationIterator);
 
+// The slots of the information object are visited first, then its map.
 class vtkInformationIteratorInternals
 {
 public:
+  int Slot;
   vtkInformationInternals::MapType::iterator Iterator;
+
+  // Move Slot to the next slot holding a value, or past the last slot.
+  void NextSlot(vtkInformationInternals* info)
+    {
+    do
+      {
+      ++this->Slot;
+      }
+    while(this->Slot < VTK_INFORMATION_NUMBER_OF_SLOTS &&
+          !info->Slots[this->Slot]);
+    }
 };
 
 //----------------------------------------------------------------------------
 vtkInformationIterator::vtkInformationIterator()
 {
   this->Internal = new vtkInformationIteratorInternals;
+  this->Internal->Slot = VTK_INFORMATION_NUMBER_OF_SLOTS;
   this->Information = 0;
   this->ReferenceIsWeak = false;
 }
@@ -86,6 +100,8 @@ void vtkInformationIterator::GoToFirstItem()
     vtkErrorMacro("No information has been set.");
     return;
     }
+  this->Internal->Slot = -1;
+  this->Internal->NextSlot(this->Information->Internal);
   this->Internal->Iterator = this->Information->Internal->Map.begin();
 }
 
@@ -98,7 +114,14 @@ void vtkInformationIterator::GoToNextItem()
     return;
     }
 
-  ++this->Internal->Iterator;
+  if(this->Internal->Slot < VTK_INFORMATION_NUMBER_OF_SLOTS)
+    {
+    this->Internal->NextSlot(this->Information->Internal);
+    }
+  else
+    {
+    ++this->Internal->Iterator;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -110,7 +133,8 @@ int vtkInformationIterator::IsDoneWithTraversal()
     return 1;
     }
 
-  if(this->Internal->Iterator == this->Information->Internal->Map.end())
+  if(this->Internal->Slot >= VTK_INFORMATION_NUMBER_OF_SLOTS &&
+     this->Internal->Iterator == this->Information->Internal->Map.end())
     {
     return 1;
     }
@@ -125,6 +149,10 @@ vtkInformationKey* vtkInformationIterator::GetCurrentKey()
     return 0;
     }
 
+  if(this->Internal->Slot < VTK_INFORMATION_NUMBER_OF_SLOTS)
+    {
+    return vtkInformationKey::GetKeyInSlot(this->Internal->Slot);
+    }
   return this->Internal->Iterator->first;
 }
 
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkInformationKey.h"
 
+#include "vtkCriticalSection.h"
 #include "vtkDebugLeaks.h"
 #include "vtkInformation.h"
 
@@ -38,20 +39,66 @@ public:
     }
 };
 
+//----------------------------------------------------------------------------
+// The keys that own the dense slots of vtkInformation.  Keys are created
+// lazily, possibly from several threads, so the table is locked while a
+// slot is given out.
+static vtkInformationKey* vtkInformationKeySlots[VTK_INFORMATION_NUMBER_OF_SLOTS];
+
+static vtkSimpleCriticalSection& vtkInformationKeySlotsLock()
+{
+  static vtkSimpleCriticalSection lock;
+  return lock;
+}
+
 //----------------------------------------------------------------------------
 vtkInformationKey::vtkInformationKey(const char* name, const char* location)
 {
   // Save the name and location.
   this->Name = name;
   this->Location = location;
+
+  // Keys are stored in the hash map of vtkInformation by default.
+  this->Slot = -1;
 }
 
 //----------------------------------------------------------------------------
 vtkInformationKey::~vtkInformationKey()
 {
+  // Keys are only destroyed at exit, when the lock may already be gone.
+  if(this->Slot >= 0)
+    {
+    vtkInformationKeySlots[this->Slot] = 0;
+    }
   this->SetReferenceCount(0);
 }
 
+//----------------------------------------------------------------------------
+int vtkInformationKey::AllocateSlot()
+{
+  vtkInformationKeySlotsLock().Lock();
+  for(int i = 0; this->Slot < 0 && i < VTK_INFORMATION_NUMBER_OF_SLOTS; ++i)
+    {
+    if(!vtkInformationKeySlots[i])
+      {
+      vtkInformationKeySlots[i] = this;
+      this->Slot = i;
+      }
+    }
+  vtkInformationKeySlotsLock().Unlock();
+  return this->Slot;
+}
+
+//----------------------------------------------------------------------------
+vtkInformationKey* vtkInformationKey::GetKeyInSlot(int slot)
+{
+  if(slot < 0 || slot >= VTK_INFORMATION_NUMBER_OF_SLOTS)
+    {
+    return 0;
+    }
+  return vtkInformationKeySlots[slot];
+}
+
 //----------------------------------------------------------------------------
 void vtkInformationKey::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -32,6 +32,9 @@
 
 class vtkInformation;
 
+// Number of keys that can be stored in the dense slots of vtkInformation.
+#define VTK_INFORMATION_NUMBER_OF_SLOTS 32
+
 class VTKCOMMONCORE_EXPORT vtkInformationKey : public vtkObjectBase
 {
 public:
@@ -96,9 +99,37 @@ public:
   void Print(vtkInformation* info);
   virtual void Print(ostream& os, vtkInformation* info);
 
+  // Description:
+  // Keys that are used very often, such as the executive keys set and
+  // read during every pipeline pass, can be given one of the
+  // VTK_INFORMATION_NUMBER_OF_SLOTS dense slots.  vtkInformation stores
+  // the values of these keys in a small array indexed by the slot instead
+  // of its hash map.  AllocateSlot() returns the slot of the key, or -1
+  // when all slots are taken.  Slots are given out in the order of the
+  // calls and are kept until the key is destroyed.  Use the
+  // vtkInformationKeySlotMacro to define keys that use a slot.
+  int AllocateSlot();
+  int GetSlot() { return this->Slot; }
+
+  // Description:
+  // Return the key that was given a slot, or NULL.
+  static vtkInformationKey* GetKeyInSlot(int slot);
+
+  //BTX
+  // Description:
+  // Allocate a slot for the key and return it.  Used by the slot macros.
+  template <class KeyType>
+  static KeyType* WithSlot(KeyType* key)
+    {
+    key->AllocateSlot();
+    return key;
+    }
+  //ETX
+
 protected:
   const char* Name;
   const char* Location;
+  int Slot;
 
   // Set/Get the value associated with this key instance in the given
   // information object.
@@ -136,4 +167,23 @@ private:
    return CLASS##_##NAME;                                               \
    }
 
+// Macros to define an information key instance that is stored in one of
+// the dense slots of vtkInformation.  See vtkInformationKey::AllocateSlot().
+#define vtkInformationKeySlotMacro(CLASS, NAME, type)                 \
+ vtkInformation##type##Key* CLASS::NAME()                             \
+   {                                                                  \
+   static vtkInformation##type##Key* CLASS##_##NAME =                 \
+     vtkInformationKey::WithSlot(                                     \
+       new vtkInformation##type##Key(#NAME, #CLASS));                 \
+   return CLASS##_##NAME;                                             \
+   }
+#define vtkInformationKeyRestrictedSlotMacro(CLASS, NAME, type, required) \
+ vtkInformation##type##Key* CLASS::NAME()                                 \
+   {                                                                      \
+   static vtkInformation##type##Key* CLASS##_##NAME =                     \
+     vtkInformationKey::WithSlot(                                         \
+       new vtkInformation##type##Key(#NAME, #CLASS, required));           \
+   return CLASS##_##NAME;                                                 \
+   }
+
 #endif
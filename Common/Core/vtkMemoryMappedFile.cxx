@@ -0,0 +1,220 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryMappedFile.h"
+
+#include "vtkObjectFactory.h"
+
+#if defined(WIN32) || defined(_WIN32)
+# include "vtkWindows.h"
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+vtkStandardNewMacro(vtkMemoryMappedFile);
+
+//----------------------------------------------------------------------------
+vtkMemoryMappedFile::vtkMemoryMappedFile()
+{
+  this->FileName = NULL;
+  this->Mode = vtkMemoryMappedFile::ReadOnly;
+  this->Pointer = NULL;
+  this->Length = 0;
+  this->MappedBase = NULL;
+  this->MappedLength = 0;
+  this->MappingHandle = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryMappedFile::~vtkMemoryMappedFile()
+{
+  this->Unmap();
+  this->SetFileName(NULL);
+}
+
+#if defined(WIN32) || defined(_WIN32)
+
+//----------------------------------------------------------------------------
+int vtkMemoryMappedFile::Map(const char *fileName, vtkTypeInt64 offset,
+                             vtkTypeInt64 length, int mode)
+{
+  this->Unmap();
+  if (!fileName || offset < 0 || length < 0)
+    {
+    vtkErrorMacro("Invalid file name or region.");
+    return 0;
+    }
+
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    {
+    vtkErrorMacro("Cannot open file " << fileName);
+    return 0;
+    }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) ||
+      offset + length > fileSize.QuadPart ||
+      (length == 0 && offset >= fileSize.QuadPart))
+    {
+    vtkErrorMacro("Region is not within file " << fileName);
+    CloseHandle(file);
+    return 0;
+    }
+  if (length == 0)
+    {
+    length = fileSize.QuadPart - offset;
+    }
+
+  HANDLE mapping = CreateFileMappingA(file, NULL,
+    mode == vtkMemoryMappedFile::CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY,
+    0, 0, NULL);
+  // The mapping keeps the file open.
+  CloseHandle(file);
+  if (!mapping)
+    {
+    vtkErrorMacro("Cannot create a file mapping for " << fileName);
+    return 0;
+    }
+
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  vtkTypeInt64 granularity = info.dwAllocationGranularity;
+  vtkTypeInt64 base = (offset / granularity) * granularity;
+  vtkTypeInt64 mappedLength = offset - base + length;
+  void *view = MapViewOfFile(mapping,
+    mode == vtkMemoryMappedFile::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ,
+    static_cast<DWORD>(base >> 32), static_cast<DWORD>(base & 0xffffffff),
+    static_cast<SIZE_T>(mappedLength));
+  if (!view)
+    {
+    vtkErrorMacro("Cannot map " << length << " bytes of " << fileName);
+    CloseHandle(mapping);
+    return 0;
+    }
+
+  this->MappingHandle = mapping;
+  this->MappedBase = view;
+  this->MappedLength = mappedLength;
+  this->Pointer = static_cast<char*>(view) + (offset - base);
+  this->Length = length;
+  this->Mode = mode;
+  this->SetFileName(fileName);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::Unmap()
+{
+  if (this->MappedBase)
+    {
+    UnmapViewOfFile(this->MappedBase);
+    CloseHandle(static_cast<HANDLE>(this->MappingHandle));
+    }
+  this->MappingHandle = NULL;
+  this->MappedBase = NULL;
+  this->MappedLength = 0;
+  this->Pointer = NULL;
+  this->Length = 0;
+}
+
+#else
+
+//----------------------------------------------------------------------------
+int vtkMemoryMappedFile::Map(const char *fileName, vtkTypeInt64 offset,
+                             vtkTypeInt64 length, int mode)
+{
+  this->Unmap();
+  if (!fileName || offset < 0 || length < 0)
+    {
+    vtkErrorMacro("Invalid file name or region.");
+    return 0;
+    }
+
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+    {
+    vtkErrorMacro("Cannot open file " << fileName);
+    return 0;
+    }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 ||
+      offset + length > static_cast<vtkTypeInt64>(fileStat.st_size) ||
+      (length == 0 && offset >= static_cast<vtkTypeInt64>(fileStat.st_size)))
+    {
+    vtkErrorMacro("Region is not within file " << fileName);
+    close(fd);
+    return 0;
+    }
+  if (length == 0)
+    {
+    length = static_cast<vtkTypeInt64>(fileStat.st_size) - offset;
+    }
+
+  vtkTypeInt64 pageSize = sysconf(_SC_PAGESIZE);
+  vtkTypeInt64 base = (offset / pageSize) * pageSize;
+  vtkTypeInt64 mappedLength = offset - base + length;
+  void *mapped = mmap(NULL, static_cast<size_t>(mappedLength),
+    mode == vtkMemoryMappedFile::CopyOnWrite ? PROT_READ | PROT_WRITE :
+                                               PROT_READ,
+    mode == vtkMemoryMappedFile::CopyOnWrite ? MAP_PRIVATE : MAP_SHARED,
+    fd, static_cast<off_t>(base));
+  // The mapping keeps a reference to the file.
+  close(fd);
+  if (mapped == MAP_FAILED)
+    {
+    vtkErrorMacro("Cannot map " << length << " bytes of " << fileName);
+    return 0;
+    }
+
+  this->MappedBase = mapped;
+  this->MappedLength = mappedLength;
+  this->Pointer = static_cast<char*>(mapped) + (offset - base);
+  this->Length = length;
+  this->Mode = mode;
+  this->SetFileName(fileName);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::Unmap()
+{
+  if (this->MappedBase)
+    {
+    munmap(this->MappedBase, static_cast<size_t>(this->MappedLength));
+    }
+  this->MappedBase = NULL;
+  this->MappedLength = 0;
+  this->Pointer = NULL;
+  this->Length = 0;
+}
+
+#endif
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "FileName: "
+     << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "Mode: "
+     << (this->Mode == vtkMemoryMappedFile::CopyOnWrite ?
+         "CopyOnWrite\n" : "ReadOnly\n");
+  os << indent << "Pointer: " << this->Pointer << "\n";
+  os << indent << "Length: " << this->Length << "\n";
+}
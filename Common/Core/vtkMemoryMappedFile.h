@@ -0,0 +1,107 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMemoryMappedFile - map a region of a file into memory
+// .SECTION Description
+// vtkMemoryMappedFile maps a region of a file into the address space of
+// the process, using mmap() on POSIX systems and file mappings on
+// Windows. The pages are loaded by the operating system on first access
+// and are shared with the page cache (and with other processes mapping
+// the same file), so "reading" a large file this way is nearly free.
+//
+// Two modes are available. ReadOnly maps the file read-only: writing
+// to the memory crashes the process. CopyOnWrite maps the file
+// privately: pages are shared until they are written, then copied; the
+// file itself is never modified.
+//
+// Data arrays can use a mapping as storage with
+// vtkDataArray::SetMappedStorage(). The arrays keep a reference to the
+// mapping, which is unmapped when the last reference goes away.
+//
+// .SECTION Caveats
+// The file must not be truncated or modified by another process while
+// it is mapped.
+//
+// .SECTION See Also
+// vtkDataArrayTemplate
+
+#ifndef __vtkMemoryMappedFile_h
+#define __vtkMemoryMappedFile_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class VTKCOMMONCORE_EXPORT vtkMemoryMappedFile : public vtkObject
+{
+public:
+  static vtkMemoryMappedFile *New();
+  vtkTypeMacro(vtkMemoryMappedFile,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+//BTX
+  // Description:
+  // Enumerate the mapping modes.
+  enum { ReadOnly, CopyOnWrite };
+//ETX
+
+  // Description:
+  // Map length bytes of the file starting at the given byte offset. A
+  // length of 0 maps everything up to the end of the file. The offset
+  // does not need to be aligned on a page. Any previous mapping is
+  // released. Returns 1 on success and 0 on failure.
+  int Map(const char *fileName, vtkTypeInt64 offset, vtkTypeInt64 length,
+          int mode);
+
+  // Description:
+  // Release the mapping. Memory obtained from GetPointer() becomes
+  // invalid.
+  void Unmap();
+
+  // Description:
+  // Return the address of the first mapped byte (the one at the offset
+  // given to Map()), or NULL when nothing is mapped.
+  void *GetPointer()
+    {return this->Pointer;}
+
+  // Description:
+  // Return the number of mapped bytes available from GetPointer().
+  vtkGetMacro(Length, vtkTypeInt64);
+
+  // Description:
+  // Return the name of the mapped file and the mapping mode.
+  vtkGetStringMacro(FileName);
+  vtkGetMacro(Mode, int);
+
+protected:
+  vtkMemoryMappedFile();
+  ~vtkMemoryMappedFile();
+
+  vtkSetStringMacro(FileName);
+
+  char *FileName;
+  int Mode;
+  void *Pointer;
+  vtkTypeInt64 Length;
+
+  // The page aligned mapping that contains the requested region.
+  void *MappedBase;
+  vtkTypeInt64 MappedLength;
+  void *MappingHandle; // only used on Windows
+
+private:
+  vtkMemoryMappedFile(const vtkMemoryMappedFile&);  // Not implemented.
+  void operator=(const vtkMemoryMappedFile&);  // Not implemented.
+};
+
+#endif
@@ -21,7 +21,9 @@
 // vtkObjectBase performs reference counting: objects that are
 // reference counted exist as long as another object uses them. Once
 // the last reference to a reference counted object is removed, the
-// object will spontaneously destruct.
+// object will spontaneously destruct. The reference count is an
+// atomic integer, so Register() and UnRegister() may be called
+// concurrently from several threads on the same object.
 //
 // Constructor and destructor of the subclasses of vtkObjectBase
 // should be protected, so that only New() and UnRegister() actually
@@ -41,6 +43,7 @@
 #define __vtkObjectBase_h
 
 #include "vtkCommonCoreModule.h" // For export macro
+#include "vtkAtomicInt.h" // For the reference count
 #include "vtkIndent.h"
 #include "vtkSystemIncludes.h"
 
@@ -159,7 +162,9 @@ protected:
 
   virtual void CollectRevisions(ostream&) {} // Legacy; do not use!
 
-  int ReferenceCount;
+  //BTX
+  vtkAtomicInt<vtkTypeInt32> ReferenceCount;
+  //ETX
   vtkWeakPointerBase **WeakPointers;
 
   // Internal Register/UnRegister implementation that accounts for
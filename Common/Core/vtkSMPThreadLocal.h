@@ -0,0 +1,206 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadLocal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPThreadLocal - A thread local storage implementation for vtkSMPTools.
+// .SECTION Description
+// vtkSMPThreadLocal provides one instance of a value per thread of the
+// vtkSMPTools engine. Local() returns the instance that belongs to the
+// calling thread, creating it on first access either by default
+// construction or by copying the exemplar given to the constructor.
+// The iterator visits every instance that was created, which is
+// typically done after vtkSMPTools::For() returns (for example in the
+// functor's Reduce() method) to combine the per-thread results:
+//
+// \code
+// class SumFunctor
+// {
+// public:
+//   vtkSMPThreadLocal<double> Sum;
+//   double Total;
+//   SumFunctor() : Sum(0.0), Total(0.0) {}
+//   void Initialize() {}
+//   void operator()(vtkIdType begin, vtkIdType end)
+//   {
+//     double& sum = this->Sum.Local();
+//     for (vtkIdType i = begin; i < end; ++i) { sum += ...; }
+//   }
+//   void Reduce()
+//   {
+//     vtkSMPThreadLocal<double>::iterator itr = this->Sum.begin();
+//     for (; itr != this->Sum.end(); ++itr) { this->Total += *itr; }
+//   }
+// };
+// \endcode
+//
+// .SECTION Caveats
+// The number of slots is fixed at construction from
+// vtkSMPTools::GetMaximumNumberOfThreads(). Iteration over the values
+// is not thread safe and should not be done while a For() that uses
+// the object is running.
+//
+// .SECTION See Also
+// vtkSMPTools
+
+#ifndef __vtkSMPThreadLocal_h
+#define __vtkSMPThreadLocal_h
+
+#include "vtkSMPTools.h"
+
+#include <vector> // For the per-thread slots
+
+template <typename T>
+class vtkSMPThreadLocal
+{
+  typedef std::vector<T*> TLS;
+public:
+  // Description:
+  // Default constructor. Values are default constructed on first
+  // access.
+  vtkSMPThreadLocal() : Exemplar(), HasExemplar(false)
+  {
+    this->Initialize();
+  }
+
+  // Description:
+  // Constructor that allows the specification of an exemplar object
+  // which is used when constructing objects when Local() is first called.
+  // Note that a copy of the exemplar is created using its copy constructor.
+  explicit vtkSMPThreadLocal(const T& exemplar)
+    : Exemplar(exemplar), HasExemplar(true)
+  {
+    this->Initialize();
+  }
+
+  ~vtkSMPThreadLocal()
+  {
+    for (typename TLS::iterator itr = this->Internal.begin();
+         itr != this->Internal.end(); ++itr)
+      {
+      delete *itr;
+      }
+  }
+
+  // Description:
+  // Returns an object local to the current thread.
+  // This object is allocated the first time Local() is called in a
+  // given thread.
+  T& Local()
+  {
+    T*& value = this->Internal[vtkSMPTools::GetThreadIndex()];
+    if (!value)
+      {
+      value = this->HasExemplar ? new T(this->Exemplar) : new T();
+      }
+    return *value;
+  }
+
+  // Description:
+  // Return the number of thread local values that have been created.
+  size_t size() const
+  {
+    size_t count = 0;
+    for (typename TLS::const_iterator itr = this->Internal.begin();
+         itr != this->Internal.end(); ++itr)
+      {
+      if (*itr)
+        {
+        ++count;
+        }
+      }
+    return count;
+  }
+
+  // Description:
+  // Subset of the standard iterator API that visits only the values
+  // that were actually created by some thread.
+  class iterator
+  {
+  public:
+    iterator& operator++()
+    {
+      ++this->Iter;
+      this->SkipEmpty();
+      return *this;
+    }
+
+    bool operator!=(const iterator& other) const
+    {
+      return this->Iter != other.Iter;
+    }
+
+    bool operator==(const iterator& other) const
+    {
+      return this->Iter == other.Iter;
+    }
+
+    T& operator*()
+    {
+      return **this->Iter;
+    }
+
+    T* operator->()
+    {
+      return *this->Iter;
+    }
+
+  private:
+    friend class vtkSMPThreadLocal<T>;
+    iterator(typename TLS::iterator iter, typename TLS::iterator end)
+      : Iter(iter), End(end)
+    {
+      this->SkipEmpty();
+    }
+    void SkipEmpty()
+    {
+      while (this->Iter != this->End && !*this->Iter)
+        {
+        ++this->Iter;
+        }
+    }
+    typename TLS::iterator Iter;
+    typename TLS::iterator End;
+  };
+
+  // Description:
+  // Returns a new iterator pointing to the first thread local value
+  // that was created.
+  iterator begin()
+  {
+    return iterator(this->Internal.begin(), this->Internal.end());
+  }
+
+  // Description:
+  // Returns a new iterator pointing past the end of the values.
+  iterator end()
+  {
+    return iterator(this->Internal.end(), this->Internal.end());
+  }
+
+private:
+  void Initialize()
+  {
+    this->Internal.resize(vtkSMPTools::GetMaximumNumberOfThreads(), 0);
+  }
+
+  TLS Internal;
+  T Exemplar;
+  bool HasExemplar;
+
+  // disable copying
+  vtkSMPThreadLocal(const vtkSMPThreadLocal&);
+  void operator=(const vtkSMPThreadLocal&);
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPThreadLocal.h
@@ -0,0 +1,401 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPTools.h"
+
+#include "vtkAtomicInt.h"
+#include "vtkMultiThreader.h"
+#include "vtkSMPConfigure.h"
+
+#if defined(VTK_SMP_PThreads)
+# include <pthread.h>
+#endif
+
+#include <vector>
+
+#if defined(VTK_SMP_PThreads)
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Clamp a requested number of threads to what VTK supports.
+static int vtkSMPToolsClampThreads(int numThreads)
+{
+  if (numThreads <= 0)
+    {
+    numThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+    }
+  if (numThreads > VTK_MAX_THREADS)
+    {
+    numThreads = VTK_MAX_THREADS;
+    }
+  return numThreads < 1 ? 1 : numThreads;
+}
+
+//----------------------------------------------------------------------------
+// Each worker owns a contiguous block of chunk indices. It first
+// consumes its own block and then steals from the blocks of the other
+// workers. The padding keeps the counters on separate cache lines.
+struct vtkSMPWorkRange
+{
+  vtkAtomicInt<vtkIdType> Next;
+  vtkIdType End;
+  char Padding[64];
+};
+
+//----------------------------------------------------------------------------
+// A persistent pool of worker threads. The thread calling For() takes
+// part in the work as thread 0, so a pool of N threads spawns N-1
+// workers once and keeps them sleeping on a condition variable between
+// calls.
+class vtkSMPThreadPool
+{
+public:
+  vtkSMPThreadPool()
+    : MaximumNumberOfThreads(0), NumberOfThreads(0), Generation(0),
+      Remaining(0), Shutdown(false), Function(0), Functor(0),
+      First(0), Last(0), Grain(1), ActiveThreads(0)
+  {
+    pthread_mutex_init(&this->Mutex, 0);
+    pthread_mutex_init(&this->SubmitMutex, 0);
+    pthread_cond_init(&this->WakeUp, 0);
+    pthread_cond_init(&this->Done, 0);
+    pthread_key_create(&this->IndexKey, 0);
+  }
+
+  ~vtkSMPThreadPool()
+  {
+    pthread_mutex_lock(&this->Mutex);
+    this->Shutdown = true;
+    pthread_cond_broadcast(&this->WakeUp);
+    pthread_mutex_unlock(&this->Mutex);
+    for (size_t i = 0; i < this->Threads.size(); ++i)
+      {
+      pthread_join(this->Threads[i], 0);
+      }
+    pthread_key_delete(this->IndexKey);
+    pthread_cond_destroy(&this->Done);
+    pthread_cond_destroy(&this->WakeUp);
+    pthread_mutex_destroy(&this->SubmitMutex);
+    pthread_mutex_destroy(&this->Mutex);
+  }
+
+  void Initialize(int numThreads)
+  {
+    pthread_mutex_lock(&this->Mutex);
+    if (this->MaximumNumberOfThreads == 0)
+      {
+      numThreads = vtkSMPToolsClampThreads(numThreads);
+      this->MaximumNumberOfThreads = numThreads;
+      this->Ranges.resize(numThreads);
+      this->Indices.resize(numThreads);
+      this->Threads.resize(numThreads - 1);
+      for (int i = 0; i < numThreads; ++i)
+        {
+        this->Indices[i] = i;
+        }
+      for (int i = 1; i < numThreads; ++i)
+        {
+        pthread_create(&this->Threads[i - 1], 0,
+                       &vtkSMPThreadPool::WorkerMain, &this->Indices[i]);
+        }
+      }
+    else if (numThreads > 0)
+      {
+      numThreads = vtkSMPToolsClampThreads(numThreads);
+      if (numThreads > this->MaximumNumberOfThreads)
+        {
+        numThreads = this->MaximumNumberOfThreads;
+        }
+      }
+    else
+      {
+      numThreads = this->MaximumNumberOfThreads;
+      }
+    this->NumberOfThreads = numThreads;
+    pthread_mutex_unlock(&this->Mutex);
+  }
+
+  void EnsureInitialized()
+  {
+    pthread_mutex_lock(&this->Mutex);
+    int initialized = this->MaximumNumberOfThreads != 0;
+    pthread_mutex_unlock(&this->Mutex);
+    if (!initialized)
+      {
+      this->Initialize(0);
+      }
+  }
+
+  // The engine is initialized first, so that these never return 0.
+  int GetNumberOfThreads()
+  {
+    this->EnsureInitialized();
+    pthread_mutex_lock(&this->Mutex);
+    int numThreads = this->NumberOfThreads;
+    pthread_mutex_unlock(&this->Mutex);
+    return numThreads;
+  }
+
+  int GetMaximumNumberOfThreads()
+  {
+    this->EnsureInitialized();
+    pthread_mutex_lock(&this->Mutex);
+    int numThreads = this->MaximumNumberOfThreads;
+    pthread_mutex_unlock(&this->Mutex);
+    return numThreads;
+  }
+
+  int GetThreadIndex()
+  {
+    void* index = pthread_getspecific(this->IndexKey);
+    return index ? *static_cast<int*>(index) : 0;
+  }
+
+  void Execute(vtkIdType first, vtkIdType last, vtkIdType grain,
+               vtkSMPTools::ExecuteFunctionType function, void* functor);
+
+private:
+  static void* WorkerMain(void* arg);
+  void RunWorker(int index, int numThreads);
+
+  // Guards the members below, except the job, which SubmitMutex guards.
+  pthread_mutex_t Mutex;
+  // Held by the thread whose job the pool is executing.
+  pthread_mutex_t SubmitMutex;
+  pthread_cond_t WakeUp;
+  pthread_cond_t Done;
+  pthread_key_t IndexKey;
+  int MaximumNumberOfThreads;
+  int NumberOfThreads;
+  std::vector<pthread_t> Threads;
+  std::vector<int> Indices;
+  std::vector<vtkSMPWorkRange> Ranges;
+
+  unsigned long Generation;
+  int Remaining;
+  bool Shutdown;
+
+  // The job being executed.
+  vtkSMPTools::ExecuteFunctionType Function;
+  void* Functor;
+  vtkIdType First;
+  vtkIdType Last;
+  vtkIdType Grain;
+  int ActiveThreads;
+};
+
+vtkSMPThreadPool vtkSMPThreadPoolInstance;
+
+//----------------------------------------------------------------------------
+void* vtkSMPThreadPool::WorkerMain(void* arg)
+{
+  vtkSMPThreadPool* self = &vtkSMPThreadPoolInstance;
+  int index = *static_cast<int*>(arg);
+  pthread_setspecific(self->IndexKey, arg);
+
+  unsigned long seen = 0;
+  for (;;)
+    {
+    pthread_mutex_lock(&self->Mutex);
+    while (!self->Shutdown && self->Generation == seen)
+      {
+      pthread_cond_wait(&self->WakeUp, &self->Mutex);
+      }
+    if (self->Shutdown)
+      {
+      pthread_mutex_unlock(&self->Mutex);
+      return 0;
+      }
+    seen = self->Generation;
+    int numThreads = self->ActiveThreads;
+    pthread_mutex_unlock(&self->Mutex);
+
+    if (index >= numThreads)
+      {
+      continue;
+      }
+    self->RunWorker(index, numThreads);
+
+    pthread_mutex_lock(&self->Mutex);
+    if (--self->Remaining == 0)
+      {
+      pthread_cond_signal(&self->Done);
+      }
+    pthread_mutex_unlock(&self->Mutex);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPThreadPool::RunWorker(int index, int numThreads)
+{
+  for (int k = 0; k < numThreads; ++k)
+    {
+    vtkSMPWorkRange& range = this->Ranges[(index + k) % numThreads];
+    for (;;)
+      {
+      vtkIdType chunk = range.Next++;
+      if (chunk >= range.End)
+        {
+        break;
+        }
+      vtkIdType begin = this->First + chunk * this->Grain;
+      vtkIdType end = begin + this->Grain;
+      (*this->Function)(this->Functor, begin,
+                        end < this->Last ? end : this->Last);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPThreadPool::Execute(vtkIdType first, vtkIdType last,
+                               vtkIdType grain,
+                               vtkSMPTools::ExecuteFunctionType function,
+                               void* functor)
+{
+  vtkIdType n = last - first;
+  int numThreads = this->GetNumberOfThreads();
+  if (grain <= 0)
+    {
+    grain = n / (4 * numThreads);
+    grain = grain > 0 ? grain : 1;
+    }
+  vtkIdType numChunks = (n + grain - 1) / grain;
+
+  // Nested calls (from a worker or from inside a running For() on the
+  // calling thread), calls made while another thread owns the pool and
+  // trivially small ranges run serially.  A thread that is not part of
+  // the pool runs them with index 0, like the thread owning the pool.
+  if (numThreads == 1 || numChunks <= 1 || this->GetThreadIndex() != 0 ||
+      pthread_mutex_trylock(&this->SubmitMutex) != 0)
+    {
+    (*function)(functor, first, last);
+    return;
+    }
+
+  for (int i = 0; i < numThreads; ++i)
+    {
+    this->Ranges[i].Next = numChunks * i / numThreads;
+    this->Ranges[i].End = numChunks * (i + 1) / numThreads;
+    }
+
+  pthread_mutex_lock(&this->Mutex);
+  this->Function = function;
+  this->Functor = functor;
+  this->First = first;
+  this->Last = last;
+  this->Grain = grain;
+  this->ActiveThreads = numThreads;
+  this->Remaining = numThreads - 1;
+  ++this->Generation;
+  pthread_cond_broadcast(&this->WakeUp);
+  pthread_mutex_unlock(&this->Mutex);
+
+  this->RunWorker(0, numThreads);
+
+  pthread_mutex_lock(&this->Mutex);
+  while (this->Remaining > 0)
+    {
+    pthread_cond_wait(&this->Done, &this->Mutex);
+    }
+  pthread_mutex_unlock(&this->Mutex);
+
+  pthread_mutex_unlock(&this->SubmitMutex);
+}
+
+} // end anon namespace
+
+//----------------------------------------------------------------------------
+void vtkSMPTools::Initialize(int numThreads)
+{
+  vtkSMPThreadPoolInstance.Initialize(numThreads);
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  return vtkSMPThreadPoolInstance.GetNumberOfThreads();
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPTools::GetMaximumNumberOfThreads()
+{
+  return vtkSMPThreadPoolInstance.GetMaximumNumberOfThreads();
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPTools::GetThreadIndex()
+{
+  return vtkSMPThreadPoolInstance.GetThreadIndex();
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPTools::ForImpl(vtkIdType first, vtkIdType last, vtkIdType grain,
+                          ExecuteFunctionType execute, void* functor)
+{
+  if (last <= first)
+    {
+    return;
+    }
+  vtkSMPThreadPoolInstance.Execute(first, last, grain, execute, functor);
+}
+
+#else // Sequential
+
+//----------------------------------------------------------------------------
+void vtkSMPTools::Initialize(int)
+{
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPTools::GetMaximumNumberOfThreads()
+{
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPTools::GetThreadIndex()
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPTools::ForImpl(vtkIdType first, vtkIdType last, vtkIdType grain,
+                          ExecuteFunctionType execute, void* functor)
+{
+  vtkIdType n = last - first;
+  if (n <= 0)
+    {
+    return;
+    }
+  if (grain <= 0 || grain >= n)
+    {
+    (*execute)(functor, first, last);
+    return;
+    }
+  for (vtkIdType b = first; b < last; b += grain)
+    {
+    vtkIdType e = b + grain;
+    (*execute)(functor, b, e < last ? e : last);
+    }
+}
+
+#endif
@@ -0,0 +1,216 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPTools - A set of parallel (multi-threaded) utility functions.
+// .SECTION Description
+// vtkSMPTools provides a set of utility functions that can be used
+// to parallelize parts of VTK code using multiple threads. The actual
+// parallel engine is selected at configuration time with the CMake
+// variable VTK_SMP_IMPLEMENTATION_TYPE:
+// \li Sequential - everything runs in the calling thread (the default).
+// \li PThreads - a persistent pool of POSIX threads with a work-stealing
+// scheduler.
+//
+// The main entry point is For(), which executes a functor over a
+// range of ids:
+//
+// \code
+// class MyFunctor
+// {
+// public:
+//   void operator()(vtkIdType begin, vtkIdType end)
+//   {
+//     for (vtkIdType i = begin; i < end; ++i) { ... }
+//   }
+// };
+// MyFunctor f;
+// vtkSMPTools::For(0, numberOfCells, f);
+// \endcode
+//
+// The functor may optionally provide two more methods, Initialize()
+// and Reduce(). If present, Initialize() is called once in each thread
+// before that thread executes its first sub-range, and Reduce() is
+// called once in the calling thread after all sub-ranges are done.
+// Together with vtkSMPThreadLocal these make it easy to accumulate
+// per-thread results and combine them at the end. A functor that
+// provides Initialize() must also provide Reduce().
+//
+// .SECTION Caveats
+// Calling For() from inside a functor (nested parallelism) is allowed;
+// the nested range is then executed serially by the calling thread. So
+// is a call made from another thread, e.g. a background pipeline
+// update, while the thread pool is busy.
+//
+// Threads that are not part of the engine all get thread index 0, the
+// index of the thread that calls For().  Concurrent For() calls from
+// several such threads must therefore not share a functor with an
+// Initialize() method nor a vtkSMPThreadLocal: the calls would use the
+// same instance for index 0 at the same time.
+//
+// .SECTION See Also
+// vtkSMPThreadLocal vtkMultiThreader
+
+#ifndef __vtkSMPTools_h
+#define __vtkSMPTools_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSystemIncludes.h"
+
+#include <vector> // For per-thread Initialize() tracking
+
+//BTX
+template <typename T> class vtkSMPTools_Has_Initialize;
+template <typename Functor, bool Init> class vtkSMPTools_FunctorInternal;
+//ETX
+
+class VTKCOMMONCORE_EXPORT vtkSMPTools
+{
+public:
+  // Description:
+  // Execute a for operation in parallel. First and last define the
+  // range over which to operate (which is defined by the operator).
+  // The operation executed is defined by operator() of the functor
+  // object. The grain gives the parallel engine a hint about the
+  // coarseness over which to parallelize the function (as defined by
+  // last-first of each execution of operator() ). A grain of zero
+  // lets the engine choose one from the range size and thread count.
+  template <typename Functor>
+  static void For(vtkIdType first, vtkIdType last, vtkIdType grain,
+                  Functor& f)
+  {
+    vtkSMPTools_FunctorInternal<Functor,
+      vtkSMPTools_Has_Initialize<Functor>::value> fi(f);
+    vtkSMPTools::ForImpl(first, last, grain,
+      &vtkSMPTools::ExecuteFunctor<vtkSMPTools_FunctorInternal<Functor,
+        vtkSMPTools_Has_Initialize<Functor>::value> >, &fi);
+    fi.Reduce();
+  }
+
+  // Description:
+  // Same as above, letting the engine choose the grain.
+  template <typename Functor>
+  static void For(vtkIdType first, vtkIdType last, Functor& f)
+  {
+    vtkSMPTools::For(first, last, 0, f);
+  }
+
+  // Description:
+  // Initialize the underlying engine with the given number of threads.
+  // When numThreads is zero, the value of
+  // vtkMultiThreader::GetGlobalDefaultNumberOfThreads() is used.
+  // The first call determines the maximum number of threads (and hence
+  // the number of slots in every vtkSMPThreadLocal); later calls can
+  // only lower the number of threads taking part in For(). Calling
+  // this method is optional, the engine initializes itself on first use.
+  static void Initialize(int numThreads = 0);
+
+  // Description:
+  // Return the number of threads the engine will use in For(). This
+  // initializes the engine if needed.
+  static int GetEstimatedNumberOfThreads();
+
+  // Description:
+  // Return the maximum number of threads the engine was initialized
+  // with. vtkSMPThreadLocal uses this to size its storage.
+  static int GetMaximumNumberOfThreads();
+
+  // Description:
+  // Return the index (0 to GetMaximumNumberOfThreads()-1) of the
+  // calling thread inside the engine. Threads that are not part of
+  // the engine, such as the thread that calls For(), get index 0.
+  static int GetThreadIndex();
+
+  //BTX
+  // Description:
+  // Type-erased entry point used internally to hand a functor to the
+  // backend.
+  typedef void (*ExecuteFunctionType)(void* functor,
+                                      vtkIdType first, vtkIdType last);
+  //ETX
+
+protected:
+  //BTX
+
+  static void ForImpl(vtkIdType first, vtkIdType last, vtkIdType grain,
+                      ExecuteFunctionType execute, void* functor);
+
+  template <typename FunctorInternal>
+  static void ExecuteFunctor(void* functor, vtkIdType first, vtkIdType last)
+  {
+    static_cast<FunctorInternal*>(functor)->Execute(first, last);
+  }
+  //ETX
+};
+
+//BTX
+// Description:
+// Compile-time detection of an Initialize() member in a functor.
+template <typename T>
+class vtkSMPTools_Has_Initialize
+{
+  typedef char (&no_type)[1];
+  typedef char (&yes_type)[2];
+  template <typename U, void (U::*)()> struct V {};
+  template <typename U> static yes_type check(V<U, &U::Initialize>*);
+  template <typename U> static no_type check(...);
+public:
+  static const bool value = sizeof(check<T>(0)) == sizeof(yes_type);
+};
+
+// Description:
+// Wraps a user functor so that Initialize() is called once per thread.
+template <typename Functor>
+class vtkSMPTools_FunctorInternal<Functor, false>
+{
+public:
+  vtkSMPTools_FunctorInternal(Functor& f) : F(f) {}
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    this->F(first, last);
+  }
+  void Reduce()
+  {
+  }
+private:
+  Functor& F;
+};
+
+template <typename Functor>
+class vtkSMPTools_FunctorInternal<Functor, true>
+{
+public:
+  vtkSMPTools_FunctorInternal(Functor& f)
+    : F(f), Initialized(vtkSMPTools::GetMaximumNumberOfThreads(), 0) {}
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    unsigned char& inited = this->Initialized[vtkSMPTools::GetThreadIndex()];
+    if (!inited)
+      {
+      this->F.Initialize();
+      inited = 1;
+      }
+    this->F(first, last);
+  }
+  void Reduce()
+  {
+    this->F.Reduce();
+  }
+private:
+  Functor& F;
+  std::vector<unsigned char> Initialized;
+};
+//ETX
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPTools.h
@@ -0,0 +1,241 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSOADataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSOADataArrayTemplate - Struct-of-arrays implementation of
+// vtkDataArray.
+//
+// .SECTION Description
+// vtkSOADataArrayTemplate stores each component of a multi-component
+// array in its own contiguous buffer ("structure of arrays"), rather than
+// interleaving the components of each tuple in a single buffer as
+// vtkDataArrayTemplate does ("array of structures").  This is the layout
+// used by many simulation codes, whose buffers can be handed to VTK
+// without copying through SetArray(comp, ...).
+//
+// The whole vtkDataArray API is supported.  In addition the typed
+// GetTypedComponent()/SetTypedComponent() and GetTupleValue()/
+// SetTupleValue() methods give direct access to the values.  Filters that
+// should run on both layouts without paying for the virtual double
+// GetTuple() should use the accessors in vtkDataArrayAccessor.h.
+//
+// HasStandardMemoryLayout() returns 0 as soon as there is more than one
+// component.  In that case GetVoidPointer() returns a pointer into an
+// interleaved copy of the data.  The copy is built under a lock, so
+// several threads may call GetVoidPointer() at the same time, and it is
+// kept until the array is modified.  Every mutator invalidates it; only
+// writes made through GetComponentArrayPointer() need a call to
+// Modified() or DataChanged().  Pointers returned earlier must not be
+// used after the array was modified.  Writing through the copy does not
+// modify the array, and WriteVoidPointer() and SetVoidArray() are not
+// supported.
+//
+// NewInstance() returns a regular vtkDataArrayTemplate of the same value
+// type, as a vtkDataArray, not a vtkSOADataArrayTemplate.  Filters that
+// create output arrays "of the same type" as their input, e.g. through
+// vtkDataSetAttributes::CopyAllocate(), and write them through
+// WriteVoidPointer() or GetVoidPointer(), like vtkAppendPolyData, then
+// work as usual.
+//
+// .SECTION See Also
+// vtkDataArrayTemplate vtkDataArrayAccessor
+
+#ifndef __vtkSOADataArrayTemplate_h
+#define __vtkSOADataArrayTemplate_h
+
+#include "vtkDataArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkTypeTemplate.h"
+#include "vtkTypeTraits.h"
+#include <vector> // For component buffers
+
+class vtkSimpleCriticalSection;
+
+template <class T>
+class vtkSOADataArrayTemplate :
+  public vtkTypeTemplate<vtkSOADataArrayTemplate<T>, vtkDataArray>
+{
+public:
+  typedef vtkDataArray Superclass;
+  typedef T ValueType;
+  static vtkSOADataArrayTemplate<T>* New();
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get/Set a value by its (tuple, component) pair.  No range checking
+  // is done.
+  inline T GetTypedComponent(vtkIdType tupleIdx, int comp) const
+    { return this->Data[comp].Array[tupleIdx]; }
+  inline void SetTypedComponent(vtkIdType tupleIdx, int comp, T value)
+    {
+    this->Data[comp].Array[tupleIdx] = value;
+    this->AoSCopyValid = 0;
+    }
+
+  // Description:
+  // Get/Set a value by its index in the equivalent interleaved array
+  // (tupleIdx * NumberOfComponents + comp).  No range checking is done.
+  inline T GetValue(vtkIdType valueIdx) const
+    {
+    return this->Data[valueIdx % this->NumberOfComponents]
+      .Array[valueIdx / this->NumberOfComponents];
+    }
+  inline void SetValue(vtkIdType valueIdx, T value)
+    {
+    this->Data[valueIdx % this->NumberOfComponents]
+      .Array[valueIdx / this->NumberOfComponents] = value;
+    this->AoSCopyValid = 0;
+    }
+
+  // Description:
+  // Typed tuple access.
+  void GetTupleValue(vtkIdType i, T* tuple);
+  void SetTupleValue(vtkIdType i, const T* tuple);
+  void InsertTupleValue(vtkIdType i, const T* tuple);
+  vtkIdType InsertNextTupleValue(const T* tuple);
+
+  // Description:
+  // Return a new, empty regular array (vtkDataArrayTemplate) of the same
+  // value type.  See the class description.
+  vtkDataArray* NewInstance() const
+    { return static_cast<vtkDataArray*>(this->NewInstanceInternal()); }
+
+  // Description:
+  // Return the buffer that holds component comp.  It has room for
+  // GetSize() / GetNumberOfComponents() values.
+  T* GetComponentArrayPointer(int comp)
+    {
+    return (comp >= 0 && comp < static_cast<int>(this->Data.size())) ?
+      this->Data[comp].Array : 0;
+    }
+
+  // Description:
+  // Use the given buffer of numTuples values to store component comp.
+  // SetNumberOfComponents() must have been called before, and all the
+  // components must be given buffers of the same length.  The array is
+  // sized to numTuples.  If save is 0 the array takes ownership of the
+  // buffer and releases it with free() or delete[] according to
+  // deleteMethod; otherwise the caller keeps ownership and the buffer is
+  // never reallocated in place.
+  void SetArray(int comp, T* array, vtkIdType numTuples, int save,
+                int deleteMethod);
+  void SetArray(int comp, T* array, vtkIdType numTuples, int save)
+    { this->SetArray(comp, array, numTuples, save, VTK_DATA_ARRAY_FREE); }
+
+  //BTX
+  enum DeleteMethod
+  {
+    VTK_DATA_ARRAY_FREE,
+    VTK_DATA_ARRAY_DELETE
+  };
+  //ETX
+
+  // Description:
+  // Implementation of the vtkAbstractArray / vtkDataArray API.
+  int Allocate(vtkIdType sz, vtkIdType ext=1000);
+  void Initialize();
+  int GetDataType() { return vtkTypeTraits<T>::VTKTypeID(); }
+  int GetDataTypeSize() { return static_cast<int>(sizeof(T)); }
+  void SetNumberOfTuples(vtkIdType number);
+  void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray* source);
+  double* GetTuple(vtkIdType i);
+  void GetTuple(vtkIdType i, double* tuple);
+  void SetTuple(vtkIdType i, const float* tuple);
+  void SetTuple(vtkIdType i, const double* tuple);
+  void InsertTuple(vtkIdType i, const float* tuple);
+  void InsertTuple(vtkIdType i, const double* tuple);
+  vtkIdType InsertNextTuple(const float* tuple);
+  vtkIdType InsertNextTuple(const double* tuple);
+  void RemoveTuple(vtkIdType id);
+  void RemoveFirstTuple() { this->RemoveTuple(0); }
+  void RemoveLastTuple();
+  double GetComponent(vtkIdType i, int j);
+  void SetComponent(vtkIdType i, int j, double c);
+  void InsertComponent(vtkIdType i, int j, double c);
+  void* WriteVoidPointer(vtkIdType id, vtkIdType number);
+  void* GetVoidPointer(vtkIdType id);
+  int HasStandardMemoryLayout() { return this->NumberOfComponents == 1; }
+  void DeepCopy(vtkDataArray* da);
+  void DeepCopy(vtkAbstractArray* aa) { this->Superclass::DeepCopy(aa); }
+  void Squeeze() { this->Resize(this->GetNumberOfTuples()); }
+  int Resize(vtkIdType numTuples);
+  void SetVoidArray(void* array, vtkIdType size, int save);
+  void SetVoidArray(void* array, vtkIdType size, int save, int deleteMethod);
+  void ExportToVoidPointer(void* out_ptr);
+  vtkArrayIterator* NewIterator();
+  vtkIdType LookupValue(vtkVariant value);
+  void LookupValue(vtkVariant value, vtkIdList* ids);
+  vtkIdType LookupValue(T value);
+  void LookupValue(T value, vtkIdList* ids);
+  vtkVariant GetVariantValue(vtkIdType idx);
+  void SetVariantValue(vtkIdType idx, vtkVariant value);
+  void DataChanged() { this->AoSCopyValid = 0; }
+  void ClearLookup() {}
+
+protected:
+  vtkSOADataArrayTemplate();
+  ~vtkSOADataArrayTemplate();
+
+  //BTX
+  struct ComponentBuffer
+  {
+    T* Array;
+    int Save;
+    int DeleteMethod;
+  };
+  //ETX
+
+  // Regular array of the same value type, see the class description.
+  virtual vtkObjectBase* NewInstanceInternal() const
+    {
+    return vtkDataArray::CreateDataArray(vtkTypeTraits<T>::VTKTypeID());
+    }
+
+  // Free the component buffers and forget them.
+  void ReleaseBuffers();
+
+  // Make every component buffer hold numTuples tuples, preserving the
+  // values that fit.  Also creates the buffers when the number of
+  // components changed since they were last allocated.
+  int ReallocateTuples(vtkIdType numTuples);
+
+  // Grow the buffers geometrically so that numTuples tuples fit.
+  int EnsureTuples(vtkIdType numTuples);
+
+  template <class U> void SetTupleInternal(vtkIdType i, const U* tuple);
+
+  std::vector<ComponentBuffer> Data;
+  vtkIdType Capacity; // number of tuples the component buffers can hold
+
+  int TupleSize; // used by GetTuple(i)
+  double* Tuple;
+  T* AoSCopy; // interleaved copy returned by GetVoidPointer
+  vtkIdType AoSCopySize; // number of values AoSCopy can hold
+  int AoSCopyValid; // reset by every mutator and DataChanged()
+  vtkTimeStamp AoSCopyTime; // time AoSCopy was made
+  vtkSimpleCriticalSection* AoSCopyLock; // serializes building AoSCopy
+
+private:
+  vtkSOADataArrayTemplate(const vtkSOADataArrayTemplate&);  // Not implemented.
+  void operator=(const vtkSOADataArrayTemplate&);  // Not implemented.
+
+  typedef vtkSOADataArrayTemplate<T> ThisT;
+};
+
+#include "vtkSOADataArrayTemplate.txx"
+
+#endif
+
+// VTK-HeaderTest-Exclude: vtkSOADataArrayTemplate.h
@@ -0,0 +1,861 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSOADataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#ifndef __vtkSOADataArrayTemplate_txx
+#define __vtkSOADataArrayTemplate_txx
+
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkCriticalSection.h"
+#include "vtkIdList.h"
+#include "vtkLookupTable.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkSOADataArrayTemplate<T>* vtkSOADataArrayTemplate<T>::New()
+{
+  vtkObject* ret =
+    vtkObjectFactory::CreateInstance(typeid(ThisT).name());
+  if(ret)
+    {
+    return static_cast<ThisT*>(ret);
+    }
+  return new ThisT();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkSOADataArrayTemplate<T>::vtkSOADataArrayTemplate()
+{
+  this->Capacity = 0;
+  this->TupleSize = 0;
+  this->Tuple = 0;
+  this->AoSCopy = 0;
+  this->AoSCopySize = 0;
+  this->AoSCopyValid = 0;
+  this->AoSCopyLock = new vtkSimpleCriticalSection;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkSOADataArrayTemplate<T>::~vtkSOADataArrayTemplate()
+{
+  this->ReleaseBuffers();
+  free(this->Tuple);
+  free(this->AoSCopy);
+  delete this->AoSCopyLock;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Capacity: " << this->Capacity << "\n";
+  for (size_t c = 0; c < this->Data.size(); ++c)
+    {
+    os << indent << "Component " << c << ": "
+       << static_cast<void*>(this->Data[c].Array) << "\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::ReleaseBuffers()
+{
+  for (size_t c = 0; c < this->Data.size(); ++c)
+    {
+    ComponentBuffer& buffer = this->Data[c];
+    if (buffer.Array && !buffer.Save)
+      {
+      if (buffer.DeleteMethod == VTK_DATA_ARRAY_DELETE)
+        {
+        delete [] buffer.Array;
+        }
+      else
+        {
+        free(buffer.Array);
+        }
+      }
+    }
+  this->Data.clear();
+  this->Capacity = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::ReallocateTuples(vtkIdType numTuples)
+{
+  // The interleaved copy has the old size.
+  this->AoSCopyValid = 0;
+  int numComps = this->NumberOfComponents;
+  if (static_cast<int>(this->Data.size()) != numComps)
+    {
+    // The number of components changed, the old values are meaningless.
+    this->ReleaseBuffers();
+    ComponentBuffer empty = { 0, 0, VTK_DATA_ARRAY_FREE };
+    this->Data.resize(numComps, empty);
+    this->MaxId = -1;
+    }
+  if (numTuples <= 0)
+    {
+    this->ReleaseBuffers();
+    this->Size = 0;
+    this->MaxId = -1;
+    return 1;
+    }
+
+  size_t keep = static_cast<size_t>(
+    numTuples < this->Capacity ? numTuples : this->Capacity);
+  size_t bytes = static_cast<size_t>(numTuples) * sizeof(T);
+  for (int c = 0; c < numComps; ++c)
+    {
+    ComponentBuffer& buffer = this->Data[c];
+    T* newArray;
+    if (!buffer.Array || buffer.Save ||
+        buffer.DeleteMethod == VTK_DATA_ARRAY_DELETE)
+      {
+      newArray = static_cast<T*>(malloc(bytes));
+      if (newArray && buffer.Array)
+        {
+        memcpy(newArray, buffer.Array, keep * sizeof(T));
+        if (!buffer.Save)
+          {
+          delete [] buffer.Array;
+          }
+        }
+      }
+    else
+      {
+      newArray = static_cast<T*>(realloc(buffer.Array, bytes));
+      }
+    if (!newArray)
+      {
+      vtkErrorMacro("Unable to allocate " << numTuples
+                    << " elements of size " << sizeof(T) << " bytes. ");
+      return 0;
+      }
+    buffer.Array = newArray;
+    buffer.Save = 0;
+    buffer.DeleteMethod = VTK_DATA_ARRAY_FREE;
+    }
+
+  this->Capacity = numTuples;
+  this->Size = numTuples * numComps;
+  if (this->MaxId >= this->Size)
+    {
+    this->MaxId = this->Size - 1;
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::EnsureTuples(vtkIdType numTuples)
+{
+  if (numTuples <= this->Capacity &&
+      static_cast<int>(this->Data.size()) == this->NumberOfComponents)
+    {
+    return 1;
+    }
+  // Same growth policy as vtkDataArrayTemplate::ResizeAndExtend.
+  return this->ReallocateTuples(this->Capacity + numTuples);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetArray(int comp, T* array,
+                                          vtkIdType numTuples, int save,
+                                          int deleteMethod)
+{
+  int numComps = this->NumberOfComponents;
+  if (comp < 0 || comp >= numComps)
+    {
+    vtkErrorMacro("Component " << comp << " is not in [0, "
+                  << numComps << ").");
+    return;
+    }
+  if (static_cast<int>(this->Data.size()) != numComps ||
+      this->Capacity != numTuples)
+    {
+    // Start over with empty buffers sized for the user arrays.
+    this->ReleaseBuffers();
+    ComponentBuffer empty = { 0, 0, VTK_DATA_ARRAY_FREE };
+    this->Data.resize(numComps, empty);
+    }
+
+  ComponentBuffer& buffer = this->Data[comp];
+  if (buffer.Array && buffer.Array != array && !buffer.Save)
+    {
+    if (buffer.DeleteMethod == VTK_DATA_ARRAY_DELETE)
+      {
+      delete [] buffer.Array;
+      }
+    else
+      {
+      free(buffer.Array);
+      }
+    }
+  buffer.Array = array;
+  buffer.Save = save;
+  buffer.DeleteMethod = deleteMethod;
+
+  this->Capacity = numTuples;
+  this->Size = numTuples * numComps;
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType)
+{
+  vtkIdType numTuples = (sz + this->NumberOfComponents - 1) /
+    this->NumberOfComponents;
+  if (numTuples > this->Capacity ||
+      static_cast<int>(this->Data.size()) != this->NumberOfComponents)
+    {
+    this->ReleaseBuffers();
+    if (!this->ReallocateTuples(numTuples > 0 ? numTuples : 1))
+      {
+      return 0;
+      }
+    }
+  this->MaxId = -1;
+  this->DataChanged();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::Initialize()
+{
+  this->ReleaseBuffers();
+  this->Size = 0;
+  this->MaxId = -1;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::Resize(vtkIdType numTuples)
+{
+  this->DataChanged();
+  if (numTuples <= 0)
+    {
+    this->Initialize();
+    return 1;
+    }
+  return this->ReallocateTuples(numTuples);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetNumberOfTuples(vtkIdType number)
+{
+  if (number > this->Capacity ||
+      static_cast<int>(this->Data.size()) != this->NumberOfComponents)
+    {
+    if (!this->ReallocateTuples(number))
+      {
+      return;
+      }
+    }
+  this->MaxId = number * this->NumberOfComponents - 1;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::GetTupleValue(vtkIdType i, T* tuple)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    tuple[c] = this->Data[c].Array[i];
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTupleValue(vtkIdType i, const T* tuple)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    this->Data[c].Array[i] = tuple[c];
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTupleValue(vtkIdType i,
+                                                  const T* tuple)
+{
+  if (!this->EnsureTuples(i + 1))
+    {
+    return;
+    }
+  this->SetTupleValue(i, tuple);
+  vtkIdType maxId = (i + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTupleValue(const T* tuple)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTupleValue(i, tuple);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+template <class U>
+void vtkSOADataArrayTemplate<T>::SetTupleInternal(vtkIdType i,
+                                                  const U* tuple)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    this->Data[c].Array[i] = static_cast<T>(tuple[c]);
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double* vtkSOADataArrayTemplate<T>::GetTuple(vtkIdType i)
+{
+  if (this->TupleSize < this->NumberOfComponents)
+    {
+    this->TupleSize = this->NumberOfComponents;
+    free(this->Tuple);
+    this->Tuple = static_cast<double*>(
+      malloc(static_cast<size_t>(this->TupleSize) * sizeof(double)));
+    }
+  if (!this->Tuple)
+    {
+    vtkErrorMacro("Unable to allocate " << this->TupleSize
+                  << " elements of size " << sizeof(double)
+                  << " bytes. ");
+    return 0;
+    }
+  this->GetTuple(i, this->Tuple);
+  return this->Tuple;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::GetTuple(vtkIdType i, double* tuple)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    tuple[c] = static_cast<double>(this->Data[c].Array[i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, const float* tuple)
+{
+  this->SetTupleInternal(i, tuple);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, const double* tuple)
+{
+  this->SetTupleInternal(i, tuple);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i, const float* tuple)
+{
+  if (!this->EnsureTuples(i + 1))
+    {
+    return;
+    }
+  this->SetTupleInternal(i, tuple);
+  vtkIdType maxId = (i + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i,
+                                             const double* tuple)
+{
+  if (!this->EnsureTuples(i + 1))
+    {
+    return;
+    }
+  this->SetTupleInternal(i, tuple);
+  vtkIdType maxId = (i + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(const float* tuple)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, tuple);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(const double* tuple)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, tuple);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+// Copy the jth tuple of source to the ith tuple of this array, which must
+// have been allocated.  Typed access is used whenever source stores T.
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
+                                          vtkAbstractArray* source)
+{
+  if (source->GetDataType() != this->GetDataType())
+    {
+    vtkWarningMacro("Input and output array data types do not match.");
+    return;
+    }
+  int numComps = this->NumberOfComponents;
+  if (numComps != source->GetNumberOfComponents())
+    {
+    vtkWarningMacro("Input and output component sizes do not match.");
+    return;
+    }
+
+  ThisT* soa = ThisT::SafeDownCast(source);
+  if (soa)
+    {
+    for (int c = 0; c < numComps; ++c)
+      {
+      this->Data[c].Array[i] = soa->Data[c].Array[j];
+      }
+    }
+  else if (source->HasStandardMemoryLayout())
+    {
+    T* data = static_cast<T*>(source->GetVoidPointer(j * numComps));
+    for (int c = 0; c < numComps; ++c)
+      {
+      this->Data[c].Array[i] = data[c];
+      }
+    }
+  else
+    {
+    vtkDataArray* da = vtkDataArray::SafeDownCast(source);
+    for (int c = 0; da && c < numComps; ++c)
+      {
+      this->Data[c].Array[i] = static_cast<T>(da->GetComponent(j, c));
+      }
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i, vtkIdType j,
+                                             vtkAbstractArray* source)
+{
+  if (source->GetDataType() != this->GetDataType() ||
+      source->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkWarningMacro("Input and output arrays do not match.");
+    return;
+    }
+  // If source is this array, growing it first keeps the copy valid.
+  if (!this->EnsureTuples(i + 1))
+    {
+    return;
+    }
+  this->SetTuple(i, j, source);
+  vtkIdType maxId = (i + 1) * this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(
+  vtkIdType j, vtkAbstractArray* source)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, j, source);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::RemoveTuple(vtkIdType id)
+{
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  if (id < 0 || id >= numTuples)
+    {
+    return;
+    }
+  size_t count = static_cast<size_t>(numTuples - id - 1);
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    T* array = this->Data[c].Array;
+    memmove(array + id, array + id + 1, count * sizeof(T));
+    }
+  this->MaxId -= this->NumberOfComponents;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::RemoveLastTuple()
+{
+  if (this->MaxId >= 0)
+    {
+    this->MaxId -= this->NumberOfComponents;
+    this->DataChanged();
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double vtkSOADataArrayTemplate<T>::GetComponent(vtkIdType i, int j)
+{
+  return static_cast<double>(this->Data[j].Array[i]);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetComponent(vtkIdType i, int j, double c)
+{
+  this->Data[j].Array[i] = static_cast<T>(c);
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertComponent(vtkIdType i, int j,
+                                                 double c)
+{
+  if (!this->EnsureTuples(i + 1))
+    {
+    return;
+    }
+  this->Data[j].Array[i] = static_cast<T>(c);
+  vtkIdType maxId = i * this->NumberOfComponents + j;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkSOADataArrayTemplate<T>::WriteVoidPointer(vtkIdType id,
+                                                   vtkIdType number)
+{
+  if (this->NumberOfComponents != 1)
+    {
+    vtkErrorMacro("WriteVoidPointer is not supported by multi-component "
+                  "struct-of-arrays arrays.");
+    return 0;
+    }
+  vtkIdType newSize = id + number;
+  if (!this->EnsureTuples(newSize))
+    {
+    return 0;
+    }
+  if (newSize - 1 > this->MaxId)
+    {
+    this->MaxId = newSize - 1;
+    }
+  this->DataChanged();
+  return this->Data[0].Array + id;
+}
+
+//----------------------------------------------------------------------------
+// For a single component the storage already has the standard layout.
+// Otherwise an interleaved copy is made, and reused until the array is
+// modified; changes made through it are not seen by the array.  The copy
+// is checked and rebuilt under AoSCopyLock so that concurrent readers
+// never see it half written or freed.  The buffer is only reallocated
+// when the array changed size.
+template <class T>
+void* vtkSOADataArrayTemplate<T>::GetVoidPointer(vtkIdType id)
+{
+  if (this->NumberOfComponents == 1)
+    {
+    return this->Data.empty() ? 0 : this->Data[0].Array + id;
+    }
+  if (this->Size <= 0)
+    {
+    return 0;
+    }
+
+  T* copy = 0;
+  this->AoSCopyLock->Lock();
+  if (this->AoSCopy && this->AoSCopyValid &&
+      this->AoSCopyTime > this->GetMTime())
+    {
+    copy = this->AoSCopy;
+    }
+  else
+    {
+    if (this->AoSCopySize != this->Size)
+      {
+      free(this->AoSCopy);
+      this->AoSCopy = static_cast<T*>(
+        malloc(static_cast<size_t>(this->Size) * sizeof(T)));
+      this->AoSCopySize = this->AoSCopy ? this->Size : 0;
+      }
+    if (this->AoSCopy)
+      {
+      this->ExportToVoidPointer(this->AoSCopy);
+      this->AoSCopyValid = 1;
+      this->AoSCopyTime.Modified();
+      copy = this->AoSCopy;
+      }
+    }
+  this->AoSCopyLock->Unlock();
+
+  if (!copy)
+    {
+    vtkErrorMacro("Unable to allocate an interleaved copy of "
+                  << this->Size << " values.");
+    return 0;
+    }
+  return copy + id;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::ExportToVoidPointer(void* out_ptr)
+{
+  if (!out_ptr)
+    {
+    return;
+    }
+  T* out = static_cast<T*>(out_ptr);
+  int numComps = this->NumberOfComponents;
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  for (int c = 0; c < numComps; ++c)
+    {
+    const T* in = this->Data[c].Array;
+    T* o = out + c;
+    for (vtkIdType t = 0; t < numTuples; ++t, o += numComps)
+      {
+      *o = in[t];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetVoidArray(void* array, vtkIdType size,
+                                              int save)
+{
+  this->SetVoidArray(array, size, save, VTK_DATA_ARRAY_FREE);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetVoidArray(void* array, vtkIdType size,
+                                              int save, int deleteMethod)
+{
+  if (this->NumberOfComponents != 1)
+    {
+    vtkErrorMacro("SetVoidArray is not supported by multi-component "
+                  "struct-of-arrays arrays. Use SetArray(comp, ...).");
+    return;
+    }
+  this->SetArray(0, static_cast<T*>(array), size, save, deleteMethod);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::DeepCopy(vtkDataArray* da)
+{
+  if (!da || da == this)
+    {
+    return;
+    }
+  if (da->GetDataType() != this->GetDataType())
+    {
+    this->Superclass::DeepCopy(da);
+    return;
+    }
+
+  int numComps = da->GetNumberOfComponents();
+  vtkIdType numTuples = da->GetNumberOfTuples();
+  this->Initialize();
+  this->vtkAbstractArray::DeepCopy(da);
+  this->NumberOfComponents = numComps;
+  this->SetNumberOfTuples(numTuples);
+
+  ThisT* soa = ThisT::SafeDownCast(da);
+  if (soa)
+    {
+    for (int c = 0; c < numComps; ++c)
+      {
+      memcpy(this->Data[c].Array, soa->Data[c].Array,
+             static_cast<size_t>(numTuples) * sizeof(T));
+      }
+    }
+  else if (da->HasStandardMemoryLayout())
+    {
+    const T* in = static_cast<T*>(da->GetVoidPointer(0));
+    for (int c = 0; c < numComps; ++c)
+      {
+      T* out = this->Data[c].Array;
+      const T* i = in + c;
+      for (vtkIdType t = 0; t < numTuples; ++t, i += numComps)
+        {
+        out[t] = *i;
+        }
+      }
+    }
+  else
+    {
+    for (vtkIdType t = 0; t < numTuples; ++t)
+      {
+      this->SetTuple(t, da->GetTuple(t));
+      }
+    }
+
+  if (da->GetLookupTable())
+    {
+    vtkLookupTable* lut = da->GetLookupTable()->NewInstance();
+    lut->DeepCopy(da->GetLookupTable());
+    this->SetLookupTable(lut);
+    lut->Delete();
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkArrayIterator* vtkSOADataArrayTemplate<T>::NewIterator()
+{
+  // The iterator reads the interleaved copy made by GetVoidPointer().
+  vtkArrayIteratorTemplate<T>* iter = vtkArrayIteratorTemplate<T>::New();
+  iter->Initialize(this);
+  return iter;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::LookupValue(T value)
+{
+  vtkIdType numValues = this->MaxId + 1;
+  for (vtkIdType i = 0; i < numValues; ++i)
+    {
+    if (this->GetValue(i) == value)
+      {
+      return i;
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::LookupValue(T value, vtkIdList* ids)
+{
+  ids->Reset();
+  vtkIdType numValues = this->MaxId + 1;
+  for (vtkIdType i = 0; i < numValues; ++i)
+    {
+    if (this->GetValue(i) == value)
+      {
+      ids->InsertNextId(i);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::LookupValue(vtkVariant value)
+{
+  T* dummyPtr = 0;
+  bool valid = true;
+  T tvalue = value.ToNumeric(&valid, dummyPtr);
+  if (valid)
+    {
+    return this->LookupValue(tvalue);
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::LookupValue(vtkVariant value,
+                                             vtkIdList* ids)
+{
+  T* dummyPtr = 0;
+  bool valid = true;
+  T tvalue = value.ToNumeric(&valid, dummyPtr);
+  ids->Reset();
+  if (valid)
+    {
+    this->LookupValue(tvalue, ids);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkVariant vtkSOADataArrayTemplate<T>::GetVariantValue(vtkIdType idx)
+{
+  return vtkVariant(this->GetValue(idx));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetVariantValue(vtkIdType idx,
+                                                 vtkVariant value)
+{
+  T* dummyPtr = 0;
+  bool valid = true;
+  T tvalue = value.ToNumeric(&valid, dummyPtr);
+  if (valid)
+    {
+    this->SetValue(idx, tvalue);
+    this->DataChanged();
+    }
+  else
+    {
+    vtkErrorMacro("unable to set value of type " << value.GetType());
+    }
+}
+
+#endif
@@ -0,0 +1,525 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellArrayLayouts.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the offsets layout of vtkCellArray.
+// .SECTION Description
+// Converts cell arrays between the legacy and the offsets layouts (with
+// 64 and 32 bit storage) and checks random access, vtkCellArrayIterator,
+// SetData(), concurrent traversal with vtkSMPTools, the legacy locations
+// of cells in the offsets layout and the cell accessors of vtkPolyData and
+// vtkUnstructuredGrid in the offsets layout. The accessors that return
+// pointers convert 32 bit storage to vtkIdType, the others must not.
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkCellType.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkTypeInt32Array.h"
+
+static const vtkIdType NumberOfTestCells = 1000;
+
+// Cell i has (i % 5) + 1 points with ids 3*i+j.
+static void FillCells(vtkCellArray *cells)
+{
+  vtkIdType pts[5];
+  for (vtkIdType i = 0; i < NumberOfTestCells; ++i)
+    {
+    vtkIdType npts = (i % 5) + 1;
+    for (vtkIdType j = 0; j < npts; ++j)
+      {
+      pts[j] = 3 * i + j;
+      }
+    cells->InsertNextCell(npts, pts);
+    }
+}
+
+static bool CheckCell(vtkIdType cellId, vtkIdType npts, const vtkIdType *pts)
+{
+  if (npts != (cellId % 5) + 1)
+    {
+    cerr << "Cell " << cellId << " has " << npts << " points" << endl;
+    return false;
+    }
+  for (vtkIdType j = 0; j < npts; ++j)
+    {
+    if (pts[j] != 3 * cellId + j)
+      {
+      cerr << "Cell " << cellId << " has a wrong point id" << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Check the cells with GetNextCell(), GetCellAtId() and an iterator.
+static bool CheckCells(vtkCellArray *cells, const char *label)
+{
+  bool success = true;
+  if (cells->GetNumberOfCells() != NumberOfTestCells)
+    {
+    cerr << label << ": wrong number of cells" << endl;
+    return false;
+    }
+
+  vtkIdType npts;
+  vtkIdType *pts;
+  vtkIdType cellId = 0;
+  for (cells->InitTraversal(); cells->GetNextCell(npts, pts); ++cellId)
+    {
+    success = CheckCell(cellId, npts, pts) && success;
+    }
+  if (cellId != NumberOfTestCells)
+    {
+    cerr << label << ": GetNextCell() visited " << cellId << " cells" << endl;
+    success = false;
+    }
+
+  vtkNew<vtkIdList> ids;
+  for (cellId = NumberOfTestCells - 1; cellId >= 0; cellId -= 7)
+    {
+    cells->GetCellAtId(cellId, ids.GetPointer());
+    success = CheckCell(cellId, ids->GetNumberOfIds(), ids->GetPointer(0)) &&
+      success;
+    if (cells->GetCellSize(cellId) != ids->GetNumberOfIds())
+      {
+      cerr << label << ": wrong GetCellSize()" << endl;
+      success = false;
+      }
+    }
+
+  vtkCellArrayIterator *iter = cells->NewIterator();
+  const vtkIdType *cpts;
+  for (cellId = 0; !iter->IsDoneWithTraversal(); iter->GoToNextCell(),
+         ++cellId)
+    {
+    iter->GetCurrentCell(npts, cpts);
+    success = CheckCell(iter->GetCurrentCellId(), npts, cpts) && success;
+    }
+  iter->GoToCell(500);
+  iter->GetCurrentCell(npts, cpts);
+  success = CheckCell(500, npts, cpts) && success;
+  iter->Delete();
+  if (cellId != NumberOfTestCells)
+    {
+    cerr << label << ": iterator visited " << cellId << " cells" << endl;
+    success = false;
+    }
+
+  if (cells->GetMaxCellSize() != 5)
+    {
+    cerr << label << ": wrong GetMaxCellSize()" << endl;
+    success = false;
+    }
+  if (!success)
+    {
+    cerr << label << " failed" << endl;
+    }
+  return success;
+}
+
+// Traverses the cells from several threads, each with its own scratch list.
+class TraverseFunctor
+{
+public:
+  vtkCellArray *Cells;
+  vtkSMPThreadLocal<vtkIdList*> Scratch;
+  vtkSMPThreadLocal<int> Errors;
+
+  TraverseFunctor() : Scratch(0), Errors(0)
+  {
+  }
+  ~TraverseFunctor()
+  {
+    vtkSMPThreadLocal<vtkIdList*>::iterator itr = this->Scratch.begin();
+    for (; itr != this->Scratch.end(); ++itr)
+      {
+      if (*itr)
+        {
+        (*itr)->Delete();
+        }
+      }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList*& scratch = this->Scratch.Local();
+    if (!scratch)
+      {
+      scratch = vtkIdList::New();
+      }
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Cells->GetCellAtId(cellId, npts, pts, scratch);
+      if (!CheckCell(cellId, npts, pts))
+        {
+        this->Errors.Local()++;
+        }
+      }
+  }
+
+  int GetNumberOfErrors()
+  {
+    int errors = 0;
+    vtkSMPThreadLocal<int>::iterator itr = this->Errors.begin();
+    for (; itr != this->Errors.end(); ++itr)
+      {
+      errors += *itr;
+      }
+    return errors;
+  }
+};
+
+// Reads the cells at their legacy locations from several threads.
+class LocationFunctor
+{
+public:
+  vtkCellArray *Cells;
+  const vtkIdType *Locations;
+  vtkSMPThreadLocal<int> Errors;
+
+  LocationFunctor() : Errors(0)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType npts;
+    vtkIdType *pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Cells->GetCell(this->Locations[cellId], npts, pts);
+      if (!CheckCell(cellId, npts, pts))
+        {
+        this->Errors.Local()++;
+        }
+      }
+  }
+
+  int GetNumberOfErrors()
+  {
+    int errors = 0;
+    vtkSMPThreadLocal<int>::iterator itr = this->Errors.begin();
+    for (; itr != this->Errors.end(); ++itr)
+      {
+      errors += *itr;
+      }
+    return errors;
+  }
+};
+
+// The location based API must not change the offsets layout.
+static bool CheckLocations(vtkCellArray *cells, const char *label)
+{
+  bool success = true;
+  vtkIdType locations[NumberOfTestCells];
+  vtkIdType loc = 0;
+  for (vtkIdType i = 0; i < NumberOfTestCells; ++i)
+    {
+    locations[i] = loc;
+    loc += (i % 5) + 2;
+    }
+
+  unsigned long memory = cells->GetActualMemorySize();
+  LocationFunctor read;
+  read.Cells = cells;
+  read.Locations = locations;
+  vtkSMPTools::For(0, NumberOfTestCells, read);
+  if (read.GetNumberOfErrors() != 0)
+    {
+    cerr << label << ": concurrent GetCell() failed" << endl;
+    success = false;
+    }
+  if (cells->GetActualMemorySize() > memory)
+    {
+    cerr << label << ": GetCell() copied the cells" << endl;
+    success = false;
+    }
+
+  vtkIdType npts;
+  vtkIdType *pts;
+  cells->InitTraversal();
+  for (vtkIdType i = 0; i < 3; ++i)
+    {
+    cells->GetNextCell(npts, pts);
+    }
+  if (cells->GetTraversalLocation() != locations[3] ||
+      cells->GetTraversalLocation(npts) != locations[2])
+    {
+    cerr << label << ": wrong GetTraversalLocation()" << endl;
+    success = false;
+    }
+  cells->SetTraversalLocation(locations[10]);
+  if (!cells->GetNextCell(npts, pts) || !CheckCell(10, npts, pts))
+    {
+    cerr << label << ": wrong SetTraversalLocation()" << endl;
+    success = false;
+    }
+  cells->GetCell(locations[NumberOfTestCells - 1], npts, pts);
+  if (cells->GetInsertLocation(npts) != locations[NumberOfTestCells - 1])
+    {
+    cerr << label << ": wrong GetInsertLocation()" << endl;
+    success = false;
+    }
+
+  if (!cells->IsOffsetsLayout())
+    {
+    cerr << label << ": the location API converted the layout" << endl;
+    success = false;
+    }
+  return success;
+}
+
+// The dataset accessors must read the cells in place.
+static bool CheckDataSet(vtkDataSet *data, vtkCellArray *cells,
+                         const char *label)
+{
+  bool success = true;
+  unsigned long memory = cells->GetActualMemorySize();
+  vtkNew<vtkIdList> ids;
+  vtkNew<vtkGenericCell> cell;
+  double bounds[6];
+  for (vtkIdType cellId = 0; cellId < NumberOfTestCells; ++cellId)
+    {
+    data->GetCellBounds(cellId, bounds);
+    if (bounds[0] != 3 * cellId || bounds[1] != 3 * cellId + cellId % 5)
+      {
+      cerr << label << ": wrong bounds of cell " << cellId << endl;
+      success = false;
+      }
+    data->GetCellPoints(cellId, ids.GetPointer());
+    success = CheckCell(cellId, ids->GetNumberOfIds(), ids->GetPointer(0)) &&
+      success;
+    data->GetCell(cellId, cell.GetPointer());
+    success = CheckCell(cellId, cell->GetNumberOfPoints(),
+                        cell->GetPointIds()->GetPointer(0)) && success;
+    vtkCell *shared = data->GetCell(cellId);
+    success = CheckCell(cellId, shared->GetNumberOfPoints(),
+                        shared->GetPointIds()->GetPointer(0)) && success;
+    }
+  if (!cells->IsOffsetsLayout() || cells->GetActualMemorySize() > memory)
+    {
+    cerr << label << ": the accessors copied or converted the cells" << endl;
+    success = false;
+    }
+  return success;
+}
+
+static bool CheckDataSets()
+{
+  bool success = true;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(3 * NumberOfTestCells + 5);
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+    points->SetPoint(i, i, 0.0, 0.0);
+    }
+
+  // Cell i has (i % 5) + 1 points: vertices, lines and polygons.
+  vtkNew<vtkCellArray> cells;
+  FillCells(cells.GetPointer());
+  cells->ConvertToOffsetsLayout(true);
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points.GetPointer());
+  int types[NumberOfTestCells];
+  for (vtkIdType i = 0; i < NumberOfTestCells; ++i)
+    {
+    int npts = (i % 5) + 1;
+    types[i] = npts == 1 ? VTK_VERTEX : npts == 2 ? VTK_LINE : VTK_POLYGON;
+    }
+  grid->SetCells(types, cells.GetPointer());
+  success = CheckDataSet(grid.GetPointer(), cells.GetPointer(),
+                         "vtkUnstructuredGrid") && success;
+
+  vtkNew<vtkCellArray> polys;
+  FillCells(polys.GetPointer());
+  polys->ConvertToOffsetsLayout(true);
+  vtkNew<vtkPolyData> poly;
+  poly->SetPoints(points.GetPointer());
+  poly->SetPolys(polys.GetPointer());
+  success = CheckDataSet(poly.GetPointer(), polys.GetPointer(),
+                         "vtkPolyData") && success;
+
+  // The pointers of the legacy accessor stay valid across calls.
+  vtkIdType npts1, npts2;
+  vtkIdType *pts1, *pts2;
+  poly->GetCellPoints(1, npts1, pts1);
+  poly->GetCellPoints(2, npts2, pts2);
+  if (!CheckCell(1, npts1, pts1) || !CheckCell(2, npts2, pts2) ||
+      polys->IsStorage32Bit())
+    {
+    cerr << "vtkPolyData::GetCellPoints() returned shared ids" << endl;
+    success = false;
+    }
+  return success;
+}
+
+int TestCellArrayLayouts(int, char *[])
+{
+  bool success = true;
+
+  vtkNew<vtkCellArray> cells;
+  FillCells(cells.GetPointer());
+  vtkIdType legacySize = cells->GetNumberOfConnectivityEntries();
+  success = CheckCells(cells.GetPointer(), "Legacy") && success;
+
+  // Round trip through the offsets layout.
+  cells->ConvertToOffsetsLayout();
+  if (!cells->IsOffsetsLayout() || cells->IsStorage32Bit() ||
+      cells->GetNumberOfConnectivityEntries() != legacySize)
+    {
+    cerr << "ConvertToOffsetsLayout() failed" << endl;
+    success = false;
+    }
+  success = CheckCells(cells.GetPointer(), "Offsets") && success;
+
+  unsigned long mtime = cells->GetMTime();
+  cells->ConvertToOffsetsLayout(true);
+  if (sizeof(vtkIdType) > 4 &&
+      (!cells->IsStorage32Bit() || cells->GetMTime() <= mtime))
+    {
+    cerr << "32 bit storage was not used" << endl;
+    success = false;
+    }
+
+  TraverseFunctor traverse;
+  traverse.Cells = cells.GetPointer();
+  vtkSMPTools::For(0, NumberOfTestCells, traverse);
+  if (traverse.GetNumberOfErrors() != 0)
+    {
+    cerr << "Concurrent traversal failed" << endl;
+    success = false;
+    }
+  if (sizeof(vtkIdType) > 4 && !cells->IsStorage32Bit())
+    {
+    cerr << "GetCellAtId() with scratch space converted the storage" << endl;
+    success = false;
+    }
+
+  // GetNextCell() hands out pointers, so it converts to vtkIdType.
+  mtime = cells->GetMTime();
+  success = CheckCells(cells.GetPointer(), "Offsets 32 bit") && success;
+  if (cells->IsStorage32Bit() ||
+      (sizeof(vtkIdType) > 4 && cells->GetMTime() <= mtime))
+    {
+    cerr << "GetNextCell() did not convert the storage" << endl;
+    success = false;
+    }
+
+  success = CheckLocations(cells.GetPointer(), "Locations") && success;
+  cells->Modified();
+  success = CheckLocations(cells.GetPointer(), "Locations modified") &&
+    success;
+
+  // The legacy API converts back.
+  mtime = cells->GetMTime();
+  if (cells->GetData()->GetNumberOfTuples() != legacySize ||
+      cells->IsOffsetsLayout() || cells->GetMTime() <= mtime)
+    {
+    cerr << "GetData() did not convert to the legacy layout" << endl;
+    success = false;
+    }
+  success = CheckCells(cells.GetPointer(), "Converted back") && success;
+
+  // Inserting into an empty offsets layout array, and growing a 32 bit
+  // array with ids that need 64 bits.
+  vtkNew<vtkCellArray> inserted;
+  inserted->ConvertToOffsetsLayout(true);
+  FillCells(inserted.GetPointer());
+  success = CheckCells(inserted.GetPointer(), "Inserted") && success;
+  if (sizeof(vtkIdType) > 4)
+    {
+    vtkIdType big = static_cast<vtkIdType>(VTK_INT_MAX) + 10;
+    inserted->InsertNextCell(1, &big);
+    if (inserted->IsStorage32Bit())
+      {
+      cerr << "32 bit storage kept for a 64 bit id" << endl;
+      success = false;
+      }
+    vtkNew<vtkIdList> ids;
+    inserted->GetCellAtId(NumberOfTestCells, ids.GetPointer());
+    if (ids->GetNumberOfIds() != 1 || ids->GetId(0) != big)
+      {
+      cerr << "64 bit id was not stored" << endl;
+      success = false;
+      }
+    }
+
+  // Deep copy keeps the layout.
+  vtkNew<vtkCellArray> copy;
+  cells->ConvertToOffsetsLayout(true);
+  copy->DeepCopy(cells.GetPointer());
+  if (copy->IsOffsetsLayout() != cells->IsOffsetsLayout() ||
+      copy->IsStorage32Bit() != cells->IsStorage32Bit())
+    {
+    cerr << "DeepCopy() changed the layout" << endl;
+    success = false;
+    }
+  success = CheckCells(copy.GetPointer(), "DeepCopy") && success;
+
+  // SetData() with user arrays.
+  vtkNew<vtkTypeInt32Array> offsets;
+  vtkNew<vtkTypeInt32Array> conn;
+  offsets->InsertNextValue(0);
+  vtkIdType pts[5];
+  for (vtkIdType i = 0; i < NumberOfTestCells; ++i)
+    {
+    for (vtkIdType j = 0; j < (i % 5) + 1; ++j)
+      {
+      pts[j] = 3 * i + j;
+      conn->InsertNextValue(static_cast<vtkTypeInt32>(pts[j]));
+      }
+    offsets->InsertNextValue(conn->GetNumberOfTuples());
+    }
+  vtkNew<vtkCellArray> user;
+  if (!user->SetData(offsets.GetPointer(), conn.GetPointer()))
+    {
+    cerr << "SetData() failed" << endl;
+    success = false;
+    }
+  success = CheckCells(user.GetPointer(), "SetData") && success;
+
+  vtkNew<vtkIdTypeArray> badOffsets;
+  badOffsets->InsertNextValue(0);
+  cerr << "Expecting an error about mismatched arrays:" << endl;
+  if (user->SetData(badOffsets.GetPointer(), conn.GetPointer()))
+    {
+    cerr << "SetData() accepted mismatched arrays" << endl;
+    success = false;
+    }
+
+  vtkNew<vtkTypeInt32Array> unsortedOffsets;
+  unsortedOffsets->DeepCopy(offsets.GetPointer());
+  unsortedOffsets->SetValue(10, unsortedOffsets->GetValue(12));
+  cerr << "Expecting an error about invalid offsets:" << endl;
+  if (user->SetData(unsortedOffsets.GetPointer(), conn.GetPointer()))
+    {
+    cerr << "SetData() accepted decreasing offsets" << endl;
+    success = false;
+    }
+  success = CheckCells(user.GetPointer(), "SetData rejected") && success;
+
+  success = CheckDataSets() && success;
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLinks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the static vtkCellLinks.
+// .SECTION Description
+// Builds static links for polygonal data and unstructured grids and
+// compares them with the dynamic links, then edits the static links.
+
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+
+static const vtkIdType Resolution = 60;
+
+// A grid of quads split into triangles, with a line on each row and a
+// vertex on each point of the first row.
+static void CreatePolyData(vtkPolyData *pd)
+{
+  vtkNew<vtkPoints> points;
+  for (vtkIdType j = 0; j < Resolution; j++)
+    {
+    for (vtkIdType i = 0; i < Resolution; i++)
+      {
+      points->InsertNextPoint(i, j, 0.0);
+      }
+    }
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  for (vtkIdType i = 0; i < Resolution; i++)
+    {
+    verts->InsertNextCell(1, &i);
+    }
+  for (vtkIdType j = 0; j < Resolution - 1; j++)
+    {
+    vtkIdType line[2] = { j * Resolution, j * Resolution + Resolution - 1 };
+    lines->InsertNextCell(2, line);
+    for (vtkIdType i = 0; i < Resolution - 1; i++)
+      {
+      vtkIdType p0 = j * Resolution + i;
+      vtkIdType tri0[3] = { p0, p0 + 1, p0 + Resolution + 1 };
+      vtkIdType tri1[3] = { p0, p0 + Resolution + 1, p0 + Resolution };
+      polys->InsertNextCell(3, tri0);
+      polys->InsertNextCell(3, tri1);
+      }
+    }
+  pd->SetPoints(points.GetPointer());
+  pd->SetVerts(verts.GetPointer());
+  pd->SetLines(lines.GetPointer());
+  pd->SetPolys(polys.GetPointer());
+}
+
+static bool CompareLinks(vtkCellLinks *links, vtkCellLinks *expected,
+                         vtkIdType numPts, const char *label)
+{
+  if (!links->IsStatic() || expected->IsStatic())
+    {
+    cerr << label << ": unexpected link layout" << endl;
+    return false;
+    }
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+    if (links->GetNcells(ptId) != expected->GetNcells(ptId))
+      {
+      cerr << label << ": point " << ptId << " has "
+           << links->GetNcells(ptId) << " cells instead of "
+           << expected->GetNcells(ptId) << endl;
+      return false;
+      }
+    for (int i = 0; i < links->GetNcells(ptId); i++)
+      {
+      if (links->GetCells(ptId)[i] != expected->GetCells(ptId)[i])
+        {
+        cerr << label << ": point " << ptId << " has wrong cells" << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+int TestCellLinks(int, char *[])
+{
+  bool success = true;
+
+  // Polygonal data.
+  vtkNew<vtkPolyData> pd;
+  CreatePolyData(pd.GetPointer());
+  pd->BuildCells();
+  vtkIdType numPts = pd->GetNumberOfPoints();
+
+  vtkNew<vtkCellLinks> dynamicLinks;
+  dynamicLinks->Allocate(numPts);
+  dynamicLinks->BuildLinks(pd.GetPointer());
+
+  pd->BuildLinks();
+  success = CompareLinks(pd->GetCellLinks(), dynamicLinks.GetPointer(),
+                         numPts, "vtkPolyData") && success;
+
+  vtkNew<vtkIdList> cellIds;
+  pd->GetPointCells(Resolution + 1, cellIds.GetPointer());
+  if (cellIds->GetNumberOfIds() != 6)
+    {
+    cerr << "Interior point uses " << cellIds->GetNumberOfIds()
+         << " cells instead of 6" << endl;
+    success = false;
+    }
+
+  // DeepCopy keeps the static layout and its own storage.
+  vtkNew<vtkCellLinks> copy;
+  copy->DeepCopy(pd->GetCellLinks());
+  success = CompareLinks(copy.GetPointer(), dynamicLinks.GetPointer(),
+                         numPts, "DeepCopy") && success;
+
+  // Editing converts to dynamic links.
+  vtkIdType cellId = pd->GetNumberOfCells() - 1;
+  pd->ResizeCellList(0, 1);
+  pd->AddReferenceToCell(0, cellId);
+  if (pd->GetCellLinks()->IsStatic() ||
+      pd->GetCellLinks()->GetNcells(0) != dynamicLinks->GetNcells(0) + 1 ||
+      pd->GetCellLinks()->GetCells(0)[dynamicLinks->GetNcells(0)] != cellId)
+    {
+    cerr << "Editing the static links failed" << endl;
+    success = false;
+    }
+
+  // Unstructured grid, in the legacy and in the offsets layouts.
+  vtkNew<vtkUnstructuredGrid> ug;
+  ug->SetPoints(pd->GetPoints());
+  ug->Allocate(pd->GetNumberOfCells());
+  for (vtkIdType i = 0; i < pd->GetNumberOfCells(); i++)
+    {
+    pd->GetCellPoints(i, cellIds.GetPointer());
+    ug->InsertNextCell(pd->GetCellType(i), cellIds.GetPointer());
+    }
+  ug->BuildLinks();
+  success = CompareLinks(ug->GetCellLinks(), dynamicLinks.GetPointer(),
+                         numPts, "vtkUnstructuredGrid") && success;
+
+  ug->GetCells()->ConvertToOffsetsLayout(true);
+  ug->BuildLinks();
+  success = CompareLinks(ug->GetCellLinks(), dynamicLinks.GetPointer(),
+                         numPts, "vtkUnstructuredGrid offsets") && success;
+
+  // Empty dataset.
+  vtkNew<vtkUnstructuredGrid> empty;
+  empty->Allocate(1);
+  empty->BuildLinks();
+  if (!empty->GetCellLinks()->IsStatic())
+    {
+    cerr << "Empty grid has no static links" << endl;
+    success = false;
+    }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,320 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLocatorScratch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the thread-safe locator queries.
+// .SECTION Description
+// Queries cell and point locators built on a grid of tetrahedra from a
+// vtkSMPTools loop, each thread with its own vtkLocatorScratch, and checks
+// that the results are the ones of the serial queries. Also checks that
+// the thread-safe queries find nothing before the locators are built.
+
+#include "vtkCellArray.h"
+#include "vtkCellLocator.h"
+#include "vtkCellType.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkLocatorScratch.h"
+#include "vtkNew.h"
+#include "vtkOctreePointLocator.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+static const int Size = 12;
+static const vtkIdType NumberOfQueries = 3000;
+static const int NumberOfPointLocators = 3;
+static const double Radius = 1.0;
+
+// A Size^3 grid of jittered points divided into six tetrahedra per voxel.
+static void CreateGrid(vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int z = 0; z < Size; z++)
+    {
+    for (int y = 0; y < Size; y++)
+      {
+      for (int x = 0; x < Size; x++)
+        {
+        points->InsertNextPoint(x + 0.1 * sin(1.3 * y + z),
+                                y + 0.1 * cos(0.7 * x - z),
+                                z + 0.1 * sin(0.9 * x * y));
+        }
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+
+  static const int axes[6][2] = { {0,1}, {0,2}, {1,0}, {1,2}, {2,0}, {2,1} };
+  vtkNew<vtkCellArray> cells;
+  vtkIdType steps[3] = { 1, Size, Size * Size };
+  for (int z = 0; z < Size - 1; z++)
+    {
+    for (int y = 0; y < Size - 1; y++)
+      {
+      for (int x = 0; x < Size - 1; x++)
+        {
+        vtkIdType corner = x + Size * (y + Size * z);
+        for (int i = 0; i < 6; i++)
+          {
+          vtkIdType pts[4];
+          pts[0] = corner;
+          pts[1] = pts[0] + steps[axes[i][0]];
+          pts[2] = pts[1] + steps[axes[i][1]];
+          pts[3] = corner + steps[0] + steps[1] + steps[2];
+          cells->InsertNextCell(4, pts);
+          }
+        }
+      }
+    }
+  grid->SetCells(VTK_TETRA, cells.GetPointer());
+}
+
+// Query points spread over the grid and a margin around it.
+static void GetQueryPoint(vtkIdType i, double x[3])
+{
+  static const double steps[3] = { 0.6180339887, 0.7548776662, 0.5698402910 };
+  for (int j = 0; j < 3; j++)
+    {
+    double f = i * steps[j];
+    x[j] = -1.0 + (Size + 1) * (f - floor(f));
+    }
+}
+
+class QueryResults
+{
+public:
+  std::vector<vtkIdType> Cell, CellPoint, ClosestCell, LineCell;
+  std::vector<double> Dist2, T;
+  std::vector<vtkIdType> Point[NumberOfPointLocators];
+  std::vector<std::vector<vtkIdType> > InRadius[NumberOfPointLocators];
+
+  QueryResults()
+    : Cell(NumberOfQueries), CellPoint(NumberOfQueries),
+      ClosestCell(NumberOfQueries), LineCell(NumberOfQueries),
+      Dist2(NumberOfQueries), T(NumberOfQueries)
+  {
+    for (int k = 0; k < NumberOfPointLocators; k++)
+      {
+      this->Point[k].resize(NumberOfQueries);
+      this->InRadius[k].resize(NumberOfQueries);
+      }
+  }
+
+  bool operator==(const QueryResults &other) const
+  {
+    for (int k = 0; k < NumberOfPointLocators; k++)
+      {
+      if (this->Point[k] != other.Point[k] ||
+          this->InRadius[k] != other.InRadius[k])
+        {
+        return false;
+        }
+      }
+    return this->Cell == other.Cell && this->CellPoint == other.CellPoint &&
+      this->ClosestCell == other.ClosestCell &&
+      this->LineCell == other.LineCell && this->Dist2 == other.Dist2 &&
+      this->T == other.T;
+  }
+};
+
+// Runs the queries of [begin, end) with the thread-safe methods if a
+// scratch is given, else with the methods that take a vtkGenericCell.
+static void RunQueries(vtkIdType begin, vtkIdType end,
+                       vtkAbstractCellLocator *cellLocator,
+                       vtkAbstractPointLocator **pointLocators,
+                       vtkGenericCell *cell, vtkLocatorScratch *scratch,
+                       QueryResults *results)
+{
+  vtkNew<vtkIdList> ids;
+  double x[3], y[3], closestPoint[3], pcoords[3], weights[4];
+  int subId;
+  for (vtkIdType i = begin; i < end; i++)
+    {
+    GetQueryPoint(i, x);
+    GetQueryPoint(i + NumberOfQueries, y);
+
+    vtkIdType cellId = -1;
+    double dist2 = -1.0, t = -1.0;
+    if (scratch)
+      {
+      cell = scratch->GetCell();
+      results->Cell[i] = cellLocator->FindCell(x, 0.0, scratch, pcoords,
+                                               weights);
+      }
+    else
+      {
+      results->Cell[i] = cellLocator->FindCell(x, 0.0, cell, pcoords,
+                                               weights);
+      }
+    results->CellPoint[i] = results->Cell[i] >= 0 ? cell->GetPointId(0) : -1;
+
+    if (scratch)
+      {
+      cellLocator->FindClosestPoint(x, closestPoint, scratch, cellId, subId,
+                                    dist2);
+      }
+    else
+      {
+      cellLocator->FindClosestPoint(x, closestPoint, cell, cellId, subId,
+                                    dist2);
+      }
+    results->ClosestCell[i] = cellId;
+    results->Dist2[i] = dist2;
+
+    int hit = scratch ?
+      cellLocator->IntersectWithLine(x, y, 0.0, t, closestPoint, pcoords,
+                                     subId, cellId, scratch) :
+      cellLocator->IntersectWithLine(x, y, 0.0, t, closestPoint, pcoords,
+                                     subId, cellId, cell);
+    results->LineCell[i] = hit ? cellId : -1;
+    results->T[i] = hit ? t : -1.0;
+
+    for (int k = 0; k < NumberOfPointLocators; k++)
+      {
+      vtkAbstractPointLocator *locator = pointLocators[k];
+      if (scratch)
+        {
+        results->Point[k][i] = locator->FindClosestPoint(x, scratch);
+        locator->FindPointsWithinRadius(Radius, x, ids.GetPointer(), scratch);
+        }
+      else
+        {
+        results->Point[k][i] = locator->FindClosestPoint(x);
+        locator->FindPointsWithinRadius(Radius, x, ids.GetPointer());
+        }
+      std::vector<vtkIdType> &inRadius = results->InRadius[k][i];
+      inRadius.assign(ids->GetPointer(0),
+                      ids->GetPointer(0) + ids->GetNumberOfIds());
+      std::sort(inRadius.begin(), inRadius.end());
+      }
+    }
+}
+
+class ConcurrentQueries
+{
+public:
+  vtkAbstractCellLocator *CellLocator;
+  vtkAbstractPointLocator **PointLocators;
+  QueryResults *Results;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkLocatorScratch> > Scratch;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkSmartPointer<vtkLocatorScratch> &scratch = this->Scratch.Local();
+    if (!scratch)
+      {
+      scratch = vtkSmartPointer<vtkLocatorScratch>::New();
+      }
+    RunQueries(begin, end, this->CellLocator, this->PointLocators, NULL,
+               scratch, this->Results);
+  }
+};
+
+int TestLocatorScratch(int, char *[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  CreateGrid(grid.GetPointer());
+
+  vtkNew<vtkCellLocator> cellLocator;
+  cellLocator->SetDataSet(grid.GetPointer());
+  cellLocator->LazyEvaluationOff();
+  vtkNew<vtkPointLocator> pointLocator;
+  vtkNew<vtkKdTreePointLocator> kdTreeLocator;
+  vtkNew<vtkOctreePointLocator> octreeLocator;
+  vtkAbstractPointLocator *pointLocators[NumberOfPointLocators] =
+    { pointLocator.GetPointer(), kdTreeLocator.GetPointer(),
+      octreeLocator.GetPointer() };
+
+  // Nothing is found before the locators are built.
+  vtkNew<vtkLocatorScratch> scratch;
+  double x[3] = { 5.5, 5.5, 5.5 }, pcoords[3], weights[4];
+  if (cellLocator->FindCell(x, 0.0, scratch.GetPointer(), pcoords,
+                            weights) != -1)
+    {
+    cerr << "Found a cell before building the cell locator" << endl;
+    return EXIT_FAILURE;
+    }
+  for (int k = 0; k < 2; k++)
+    {
+    pointLocators[k]->SetDataSet(grid.GetPointer());
+    if (pointLocators[k]->FindClosestPoint(x, scratch.GetPointer()) != -1)
+      {
+      cerr << "Found a point before building the "
+           << pointLocators[k]->GetClassName() << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  cellLocator->BuildLocator();
+  for (int k = 0; k < NumberOfPointLocators; k++)
+    {
+    pointLocators[k]->SetDataSet(grid.GetPointer());
+    pointLocators[k]->BuildLocator();
+    }
+
+  // The subclasses do not hide the thread-safe queries.
+  if (octreeLocator->FindClosestPoint(x, scratch.GetPointer()) !=
+      octreeLocator->FindClosestPoint(x))
+    {
+    cerr << "Wrong thread-safe query through vtkOctreePointLocator" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkGenericCell> cell;
+  QueryResults expected;
+  RunQueries(0, NumberOfQueries, cellLocator.GetPointer(), pointLocators,
+             cell.GetPointer(), NULL, &expected);
+  vtkIdType numFound = NumberOfQueries -
+    std::count(expected.Cell.begin(), expected.Cell.end(), -1);
+  vtkIdType numHits = NumberOfQueries -
+    std::count(expected.LineCell.begin(), expected.LineCell.end(), -1);
+  if (numFound < NumberOfQueries / 3 || numFound == NumberOfQueries ||
+      numHits < NumberOfQueries / 3)
+    {
+    cerr << "Unexpected serial results: " << numFound << " cells found, "
+         << numHits << " lines hit" << endl;
+    return EXIT_FAILURE;
+    }
+
+  QueryResults results;
+  ConcurrentQueries functor;
+  functor.CellLocator = cellLocator.GetPointer();
+  functor.PointLocators = pointLocators;
+  functor.Results = &results;
+  unsigned long buildTime = cellLocator->GetBuildTime();
+  vtkSMPTools::For(0, NumberOfQueries, 16, functor);
+
+  if (!(results == expected))
+    {
+    cerr << "The concurrent queries differ from the serial ones" << endl;
+    return EXIT_FAILURE;
+    }
+  if (cellLocator->GetBuildTime() != buildTime)
+    {
+    cerr << "The concurrent queries rebuilt the cell locator" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,196 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestScratchArena.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkScratchArena.
+// .SECTION Description
+// Computes the centers of the cells of a mixed grid in a vtkSMPTools loop
+// that takes all its temporaries from the arena, and checks that the
+// pools stop growing once they are warm.
+
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkScratchArena.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+static const vtkIdType Resolution = 40;
+
+// Alternating quads and pairs of triangles so that the generic cell
+// switches type all the time.
+static void CreateGrid(vtkUnstructuredGrid *ug)
+{
+  vtkNew<vtkPoints> points;
+  for (vtkIdType j = 0; j < Resolution; j++)
+    {
+    for (vtkIdType i = 0; i < Resolution; i++)
+      {
+      points->InsertNextPoint(i, j, 0.0);
+      }
+    }
+  ug->SetPoints(points.GetPointer());
+  ug->Allocate(2 * Resolution * Resolution);
+  for (vtkIdType j = 0; j < Resolution - 1; j++)
+    {
+    for (vtkIdType i = 0; i < Resolution - 1; i++)
+      {
+      vtkIdType p0 = j * Resolution + i;
+      if ((i + j) % 2)
+        {
+        vtkIdType quad[4] = { p0, p0 + 1, p0 + Resolution + 1,
+                              p0 + Resolution };
+        ug->InsertNextCell(VTK_QUAD, 4, quad);
+        }
+      else
+        {
+        vtkIdType tri0[3] = { p0, p0 + 1, p0 + Resolution + 1 };
+        vtkIdType tri1[3] = { p0, p0 + Resolution + 1, p0 + Resolution };
+        ug->InsertNextCell(VTK_TRIANGLE, 3, tri0);
+        ug->InsertNextCell(VTK_TRIANGLE, 3, tri1);
+        }
+      }
+    }
+}
+
+class CellCenters
+{
+public:
+  vtkUnstructuredGrid *Input;
+  vtkScratchArena *Arena;
+  double *Centers;
+  int MaxCellSize;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    this->Arena->Reset();
+    vtkGenericCell *cell = this->Arena->GetGenericCell();
+    vtkIdList *ids = this->Arena->GetIdList();
+    vtkPoints *pts = this->Arena->GetPoints(VTK_DOUBLE);
+    double *x = this->Arena->Allocate<double>(3 * this->MaxCellSize);
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->Input->GetCell(cellId, cell);
+      this->Input->GetCellPoints(cellId, ids);
+      vtkIdType npts = ids->GetNumberOfIds();
+      pts->SetNumberOfPoints(npts);
+      double *center = this->Centers + 3 * cellId;
+      center[0] = center[1] = center[2] = 0.0;
+      for (vtkIdType i = 0; i < npts; i++)
+        {
+        cell->GetPoints()->GetPoint(i, x + 3 * i);
+        pts->SetPoint(i, x + 3 * i);
+        for (int c = 0; c < 3; c++)
+          {
+          center[c] += pts->GetPoint(i)[c] / npts;
+          }
+        }
+      }
+  }
+};
+
+int TestScratchArena(int, char *[])
+{
+  vtkNew<vtkUnstructuredGrid> ug;
+  CreateGrid(ug.GetPointer());
+  vtkIdType numCells = ug->GetNumberOfCells();
+
+  // Reference values.
+  std::vector<double> expected(3 * numCells);
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    ug->GetCellPoints(cellId, ids.GetPointer());
+    double *center = &expected[3 * cellId];
+    center[0] = center[1] = center[2] = 0.0;
+    for (vtkIdType i = 0; i < ids->GetNumberOfIds(); i++)
+      {
+      double *x = ug->GetPoint(ids->GetId(i));
+      for (int c = 0; c < 3; c++)
+        {
+        center[c] += x[c] / ids->GetNumberOfIds();
+        }
+      }
+    }
+
+  vtkNew<vtkScratchArena> arena;
+  std::vector<double> centers(3 * numCells);
+  CellCenters functor;
+  functor.Input = ug.GetPointer();
+  functor.Arena = arena.GetPointer();
+  functor.Centers = &centers[0];
+  functor.MaxCellSize = ug->GetMaxCellSize();
+
+  int status = EXIT_SUCCESS;
+  vtkIdType pooled = 0;
+  for (int pass = 0; pass < 3; pass++)
+    {
+    vtkSMPTools::For(0, numCells, 16, functor);
+    for (vtkIdType i = 0; i < 3 * numCells; i++)
+      {
+      if (centers[i] != expected[i])
+        {
+        cerr << "Wrong center for cell " << i / 3 << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    // Each thread needs exactly one object of each kind per sub-range.
+    vtkIdType count = arena->GetNumberOfPooledObjects();
+    if (count < 3 || count % 3 != 0 ||
+        count > 3 * vtkSMPTools::GetMaximumNumberOfThreads())
+      {
+      cerr << "Pass " << pass << ": " << count << " pooled objects" << endl;
+      status = EXIT_FAILURE;
+      }
+    if (pass > 0 && count != pooled)
+      {
+      cerr << "The pools grew from " << pooled << " to " << count << endl;
+      status = EXIT_FAILURE;
+      }
+    pooled = count;
+    }
+
+  // Serial use and release.
+  arena->ResetAll();
+  vtkIdList *first = arena->GetIdList();
+  first->InsertNextId(7);
+  vtkIdList *second = arena->GetIdList();
+  if (first == second || second->GetNumberOfIds() != 0)
+    {
+    cerr << "GetIdList() returned a list in use" << endl;
+    status = EXIT_FAILURE;
+    }
+  arena->Reset();
+  if (arena->GetIdList() != first || first->GetNumberOfIds() != 0)
+    {
+    cerr << "Reset() did not recycle the id lists" << endl;
+    status = EXIT_FAILURE;
+    }
+  if (arena->GetPoints(VTK_DOUBLE)->GetDataType() != VTK_DOUBLE ||
+      arena->GetPoints()->GetDataType() != VTK_FLOAT)
+    {
+    cerr << "Wrong point data type" << endl;
+    status = EXIT_FAILURE;
+    }
+  arena->Initialize();
+  if (arena->GetNumberOfPooledObjects() != 0)
+    {
+    cerr << "Initialize() did not release the pools" << endl;
+    status = EXIT_FAILURE;
+    }
+
+  return status;
+}
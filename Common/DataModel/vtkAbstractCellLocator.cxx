@@ -17,8 +17,10 @@
 
 #include "vtkObjectFactory.h"
 #include "vtkCellArray.h"
+#include "vtkCriticalSection.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkLocatorScratch.h"
 #include "vtkPoints.h"
 #include "vtkDataSet.h"
 #include "vtkMath.h"
@@ -35,11 +37,13 @@ vtkAbstractCellLocator::vtkAbstractCellLocator()
   this->UseExistingSearchStructure = 0;
   this->LazyEvaluation             = 0;
   this->GenericCell                = vtkGenericCell::New();
+  this->QueryLock                  = new vtkSimpleCriticalSection;
 }
 //----------------------------------------------------------------------------
 vtkAbstractCellLocator::~vtkAbstractCellLocator()
 {
   this->GenericCell->Delete();
+  delete this->QueryLock;
 }
 //----------------------------------------------------------------------------
 bool vtkAbstractCellLocator::StoreCellBounds()
@@ -205,6 +209,46 @@ vtkIdType vtkAbstractCellLocator::FindCell(
   return returnVal;
 }
 //----------------------------------------------------------------------------
+// The default thread-safe queries call the queries above one at a time.
+// These may update the locator, hence the casts.
+vtkIdType vtkAbstractCellLocator::FindCell(
+  const double x[3], double tol2, vtkLocatorScratch *scratch,
+  double pcoords[3], double *weights) const
+{
+  double point[3] = { x[0], x[1], x[2] };
+  this->QueryLock->Lock();
+  vtkIdType cellId = const_cast<vtkAbstractCellLocator*>(this)->FindCell(
+    point, tol2, scratch->GetCell(), pcoords, weights);
+  this->QueryLock->Unlock();
+  return cellId;
+}
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindClosestPoint(
+  const double x[3], double closestPoint[3],
+  vtkLocatorScratch *scratch, vtkIdType &cellId,
+  int &subId, double& dist2) const
+{
+  double point[3] = { x[0], x[1], x[2] };
+  this->QueryLock->Lock();
+  const_cast<vtkAbstractCellLocator*>(this)->FindClosestPoint(
+    point, closestPoint, scratch->GetCell(), cellId, subId, dist2);
+  this->QueryLock->Unlock();
+}
+//----------------------------------------------------------------------------
+int vtkAbstractCellLocator::IntersectWithLine(
+  const double p1[3], const double p2[3], double tol, double& t,
+  double x[3], double pcoords[3], int &subId, vtkIdType &cellId,
+  vtkLocatorScratch *scratch) const
+{
+  double a0[3] = { p1[0], p1[1], p1[2] };
+  double a1[3] = { p2[0], p2[1], p2[2] };
+  this->QueryLock->Lock();
+  int hit = const_cast<vtkAbstractCellLocator*>(this)->IntersectWithLine(
+    a0, a1, tol, t, x, pcoords, subId, cellId, scratch->GetCell());
+  this->QueryLock->Unlock();
+  return hit;
+}
+//----------------------------------------------------------------------------
 bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
 {
   double cellBounds[6], delta[3] = {0.0, 0.0, 0.0};
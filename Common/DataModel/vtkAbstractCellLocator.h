@@ -28,10 +28,17 @@
 //  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
 // //ETX
 // \endverbatim
+//
+// The query methods above may build the locator and keep per-query state
+// in the locator, so they must not be called from several threads at once.
+// The const FindCell(), FindClosestPoint() and IntersectWithLine() which
+// take a vtkLocatorScratch keep all the state of the query in the scratch
+// instead: once the locator is built, one locator can be queried from
+// several threads at once, each thread with its own scratch.
 
 //
 // .SECTION See Also
-// vtkLocator vtkPointLocator vtkOBBTree vtkCellLocator
+// vtkLocator vtkPointLocator vtkOBBTree vtkCellLocator vtkLocatorScratch
 
 #ifndef __vtkAbstractCellLocator_h
 #define __vtkAbstractCellLocator_h
@@ -42,7 +49,9 @@
 class vtkCellArray;
 class vtkGenericCell;
 class vtkIdList;
+class vtkLocatorScratch;
 class vtkPoints;
+class vtkSimpleCriticalSection;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractCellLocator : public vtkLocator
 {
@@ -240,6 +249,26 @@ public:
   // of fast access to the data.
   virtual bool InsideCellBounds(double x[3], vtkIdType cell_ID);
 
+  // Description:
+  // Thread-safe versions of FindCell(), FindClosestPoint() and
+  // IntersectWithLine(). The cell found is left in the cell of the scratch.
+  // This implementation serializes the calls to the queries above.
+  // vtkCellLocator, vtkCellTreeLocator and vtkModifiedBSPTree run them
+  // concurrently, but never build the locator: build it first with
+  // BuildLocator() or Update(), with LazyEvaluation off. Until then they
+  // find nothing.
+  virtual vtkIdType FindCell(
+    const double x[3], double tol2, vtkLocatorScratch *scratch,
+    double pcoords[3], double *weights) const;
+  virtual void FindClosestPoint(
+    const double x[3], double closestPoint[3],
+    vtkLocatorScratch *scratch, vtkIdType &cellId,
+    int &subId, double& dist2) const;
+  virtual int IntersectWithLine(
+    const double p1[3], const double p2[3], double tol, double& t,
+    double x[3], double pcoords[3], int &subId, vtkIdType &cellId,
+    vtkLocatorScratch *scratch) const;
+
 protected:
    vtkAbstractCellLocator();
   ~vtkAbstractCellLocator();
@@ -259,6 +288,8 @@ protected:
   int LazyEvaluation;
   int UseExistingSearchStructure;
   vtkGenericCell *GenericCell;
+  // Serializes the default thread-safe queries.
+  vtkSimpleCriticalSection *QueryLock;
 //BTX - begin tcl exclude
   double (*CellBounds)[6];
 //ETX - end tcl exclude
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkAbstractPointLocator.h"
 
+#include "vtkCriticalSection.h"
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
 
@@ -24,10 +25,12 @@ vtkAbstractPointLocator::vtkAbstractPointLocator()
     {
     this->Bounds[i] = 0;
     }
+  this->QueryLock = new vtkSimpleCriticalSection;
 }
 
 vtkAbstractPointLocator::~vtkAbstractPointLocator()
 {
+  delete this->QueryLock;
 }
 
 
@@ -62,6 +65,28 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(double R, double x,
   this->FindPointsWithinRadius(R,p,result);
 }
 
+// The default thread-safe queries call the queries above one at a time.
+// These may build the locator, hence the casts.
+vtkIdType vtkAbstractPointLocator::FindClosestPoint(
+  const double x[3], vtkLocatorScratch *vtkNotUsed(scratch)) const
+{
+  this->QueryLock->Lock();
+  vtkIdType ptId =
+    const_cast<vtkAbstractPointLocator*>(this)->FindClosestPoint(x);
+  this->QueryLock->Unlock();
+  return ptId;
+}
+
+void vtkAbstractPointLocator::FindPointsWithinRadius(
+  double R, const double x[3], vtkIdList *result,
+  vtkLocatorScratch *vtkNotUsed(scratch)) const
+{
+  this->QueryLock->Lock();
+  const_cast<vtkAbstractPointLocator*>(this)->FindPointsWithinRadius(
+    R, x, result);
+  this->QueryLock->Unlock();
+}
+
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
   for(int i=0;i<6;i++)
@@ -20,6 +20,23 @@
 // lie in each bucket. Typical operation involves giving a position in 3D
 // and finding the closest point.  The points are provided from the specified
 // dataset input.
+//
+// The const FindClosestPoint() and FindPointsWithinRadius() which take a
+// vtkLocatorScratch can be called from several threads at once, each
+// thread with its own scratch.  vtkPointLocator and vtkKdTreePointLocator
+// run them concurrently and never build nor modify the locator, so build
+// it first.  Other locators serialize them and run the queries above,
+// which may build the locator.  Subclasses which declare other
+// FindClosestPoint() or FindPointsWithinRadius() methods include them with
+// \verbatim
+// //BTX
+//  using vtkAbstractPointLocator::FindClosestPoint;
+//  using vtkAbstractPointLocator::FindPointsWithinRadius;
+// //ETX
+// \endverbatim
+//
+// .SECTION See Also
+// vtkLocatorScratch
 
 #ifndef __vtkAbstractPointLocator_h
 #define __vtkAbstractPointLocator_h
@@ -28,6 +45,8 @@
 #include "vtkLocator.h"
 
 class vtkIdList;
+class vtkLocatorScratch;
+class vtkSimpleCriticalSection;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -72,6 +91,18 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z,
                                       vtkIdList *result);
 
+  // Description:
+  // Thread-safe versions of FindClosestPoint() and FindPointsWithinRadius().
+  // This implementation serializes the calls to the queries above.
+  // vtkPointLocator and vtkKdTreePointLocator run them concurrently, but
+  // never build the locator: build it first with BuildLocator() or
+  // Update(). Until then they find nothing.
+  virtual vtkIdType FindClosestPoint(const double x[3],
+                                     vtkLocatorScratch *scratch) const;
+  virtual void FindPointsWithinRadius(double R, const double x[3],
+                                      vtkIdList *result,
+                                      vtkLocatorScratch *scratch) const;
+
   // Description:
   // Provide an accessor to the bounds.
   virtual double *GetBounds() { return this->Bounds; }
@@ -90,6 +121,9 @@ protected:
 
   double Bounds[6]; // bounds of points
 
+  // Serializes the default thread-safe queries.
+  vtkSimpleCriticalSection *QueryLock;
+
 private:
   vtkAbstractPointLocator(const vtkAbstractPointLocator&);  // Not implemented.
   void operator=(const vtkAbstractPointLocator&);  // Not implemented.
@@ -129,7 +129,7 @@ void vtkCell3D::Contour(double value, vtkDataArray *cellScalars,
       }
 
     this->Points->GetPoint(i, x);
-    if ( locator->InsertUniquePoint(x, id) )
+    if ( locator->InsertUniqueEdgePoint(ptId, ptId, 0.0, x, id) )
       {
       outPd->CopyData(inPd,ptId, id);
       }
@@ -192,10 +192,11 @@ void vtkCell3D::Contour(double value, vtkDataArray *cellScalars,
         }
 
       // Incorporate point into output and interpolate edge data as necessary
-      if ( locator->InsertUniquePoint(x, ptId) )
+      vtkIdType p1 = this->PointIds->GetId(v1);
+      vtkIdType p2 = this->PointIds->GetId(v2);
+      if ( locator->InsertUniqueEdgePoint(p1, p2, t, x, ptId) )
         {
-        outPd->InterpolateEdge(inPd, ptId, this->PointIds->GetId(v1),
-                               this->PointIds->GetId(v2), t);
+        outPd->InterpolateEdge(inPd, ptId, p1, p2, t);
         }
 
       //Insert intersection point into Delaunay triangulation
@@ -276,7 +277,7 @@ void vtkCell3D::Clip(double value, vtkDataArray *cellScalars,
       {
       ptId = this->PointIds->GetId(i);
       this->Points->GetPoint(i, x);
-      if ( locator->InsertUniquePoint(x, id) )
+      if ( locator->InsertUniqueEdgePoint(ptId, ptId, 0.0, x, id) )
         {
         outPD->CopyData(inPD,ptId, id);
         }
@@ -335,7 +336,7 @@ void vtkCell3D::Clip(double value, vtkDataArray *cellScalars,
       }
 
     this->Points->GetPoint(i, x);
-    if ( locator->InsertUniquePoint(x, id) )
+    if ( locator->InsertUniqueEdgePoint(ptId, ptId, 0.0, x, id) )
       {
       outPD->CopyData(inPD,ptId, id);
       }
@@ -398,10 +399,11 @@ void vtkCell3D::Clip(double value, vtkDataArray *cellScalars,
         }
 
       // Incorporate point into output and interpolate edge data as necessary
-      if ( locator->InsertUniquePoint(x, ptId) )
+      vtkIdType p1 = this->PointIds->GetId(v1);
+      vtkIdType p2 = this->PointIds->GetId(v2);
+      if ( locator->InsertUniqueEdgePoint(p1, p2, t, x, ptId) )
         {
-        outPD->InterpolateEdge(inPD, ptId, this->PointIds->GetId(v1),
-                               this->PointIds->GetId(v2), t);
+        outPD->InterpolateEdge(inPD, ptId, p1, p2, t);
         }
 
       //Insert intersection point into Delaunay triangulation
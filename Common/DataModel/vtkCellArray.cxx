@@ -13,10 +13,183 @@
 
 =========================================================================*/
 #include "vtkCellArray.h"
+
+#include "vtkCellArrayIterator.h"
 #include "vtkObjectFactory.h"
+#include "vtkTypeInt32Array.h"
 
 vtkStandardNewMacro(vtkCellArray);
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Raw access to the storage of the offsets layout arrays.
+template <typename T>
+inline T* vtkCellArrayRaw(vtkDataArray *array)
+{
+  return static_cast<T*>(array->GetVoidPointer(0));
+}
+
+//----------------------------------------------------------------------------
+// Create an empty array for the offsets layout.
+vtkDataArray* vtkCellArrayNewStorage(bool use32Bit)
+{
+  if (use32Bit)
+    {
+    return vtkTypeInt32Array::New();
+    }
+  return vtkIdTypeArray::New();
+}
+
+//----------------------------------------------------------------------------
+// Build offsets / connectivity from the legacy layout. Returns the cell id
+// that the legacy traversal location corresponds to.
+template <typename T>
+vtkIdType vtkCellArrayLegacyToOffsets(vtkIdTypeArray *ia, vtkIdType numCells,
+                                      vtkIdType traversalLocation,
+                                      vtkDataArray *offsets,
+                                      vtkDataArray *conn)
+{
+  vtkIdType size = ia->GetMaxId() + 1;
+  const vtkIdType *legacy = ia->GetPointer(0);
+  T *o = static_cast<T*>(offsets->WriteVoidPointer(0, numCells + 1));
+  T *c = static_cast<T*>(conn->WriteVoidPointer(0, size - numCells));
+  vtkIdType traversalCell = numCells;
+  vtkIdType loc = 0;
+  vtkIdType cellId = 0;
+  T offset = 0;
+  for (; cellId < numCells && loc < size; ++cellId)
+    {
+    if (loc == traversalLocation)
+      {
+      traversalCell = cellId;
+      }
+    vtkIdType npts = legacy[loc++];
+    o[cellId] = offset;
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      *c++ = static_cast<T>(legacy[loc++]);
+      }
+    offset += static_cast<T>(npts);
+    }
+  o[cellId] = offset;
+  return traversalCell;
+}
+
+//----------------------------------------------------------------------------
+template <typename T>
+void vtkCellArrayOffsetsToLegacy(vtkDataArray *offsets, vtkDataArray *conn,
+                                 vtkIdType numCells, vtkIdTypeArray *ia)
+{
+  const T *o = vtkCellArrayRaw<T>(offsets);
+  const T *c = vtkCellArrayRaw<T>(conn);
+  vtkIdType *legacy = ia->WritePointer(0, o[numCells] + numCells);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    *legacy++ = static_cast<vtkIdType>(o[cellId + 1] - o[cellId]);
+    for (T i = o[cellId]; i < o[cellId + 1]; ++i)
+      {
+      *legacy++ = static_cast<vtkIdType>(c[i]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Copy offsets / connectivity between two storage types.
+template <typename TIn, typename TOut>
+void vtkCellArrayCopyStorage(vtkDataArray *in, vtkDataArray *out)
+{
+  vtkIdType n = in->GetNumberOfTuples();
+  const TIn *src = vtkCellArrayRaw<TIn>(in);
+  TOut *dst = static_cast<TOut*>(out->WriteVoidPointer(0, n));
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    dst[i] = static_cast<TOut>(src[i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <typename T>
+vtkIdType vtkCellArrayInsertNextCell(vtkDataArray *offsets, vtkDataArray *conn,
+                                     vtkIdType numCells, vtkIdType npts,
+                                     const vtkIdType *pts)
+{
+  T begin = vtkCellArrayRaw<T>(offsets)[numCells];
+  T *c = static_cast<T*>(conn->WriteVoidPointer(begin, npts));
+  for (vtkIdType i = 0; i < npts; ++i)
+    {
+    c[i] = static_cast<T>(pts[i]);
+    }
+  T *o = static_cast<T*>(offsets->WriteVoidPointer(numCells + 1, 1));
+  *o = begin + static_cast<T>(npts);
+  return numCells;
+}
+
+//----------------------------------------------------------------------------
+// Whether the offsets start at 0, never decrease and end at size.
+template <typename T>
+bool vtkCellArrayValidOffsets(vtkDataArray *offsets, vtkIdType size)
+{
+  const T *o = vtkCellArrayRaw<T>(offsets);
+  vtkIdType n = offsets->GetNumberOfTuples();
+  if (o[0] != 0 || static_cast<vtkIdType>(o[n - 1]) != size)
+    {
+    return false;
+    }
+  for (vtkIdType i = 1; i < n; ++i)
+    {
+    if (o[i] < o[i - 1])
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// The first cell whose legacy location, offsets[i] + i, is not before loc.
+template <typename T>
+vtkIdType vtkCellArrayFindLegacyLocation(vtkDataArray *offsets,
+                                         vtkIdType numCells, vtkIdType loc)
+{
+  const T *o = vtkCellArrayRaw<T>(offsets);
+  vtkIdType lo = 0, hi = numCells;
+  while (lo < hi)
+    {
+    vtkIdType mid = lo + (hi - lo) / 2;
+    if (static_cast<vtkIdType>(o[mid]) + mid < loc)
+      {
+      lo = mid + 1;
+      }
+    else
+      {
+      hi = mid;
+      }
+    }
+  return lo;
+}
+
+//----------------------------------------------------------------------------
+// Whether all values of the legacy / offsets layout ids fit 32 bits.
+bool vtkCellArrayIdFits32Bit(vtkIdType id)
+{
+  return id >= VTK_INT_MIN && id <= VTK_INT_MAX;
+}
+
+template <typename T>
+bool vtkCellArrayFits32Bit(const T *values, vtkIdType n)
+{
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    if (!vtkCellArrayIdFits32Bit(static_cast<vtkIdType>(values[i])))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+} // end anon namespace
+
 //----------------------------------------------------------------------------
 vtkCellArray::vtkCellArray()
 {
@@ -24,6 +197,8 @@ vtkCellArray::vtkCellArray()
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->Offsets = 0;
+  this->Connectivity = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -35,7 +210,23 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
     return;
     }
 
-  this->Ia->DeepCopy(ca->Ia);
+  if (ca->Offsets)
+    {
+    if (!this->Offsets || this->IsStorage32Bit() != ca->IsStorage32Bit())
+      {
+      this->ReleaseOffsetsLayout();
+      this->Offsets = vtkCellArrayNewStorage(ca->IsStorage32Bit());
+      this->Connectivity = vtkCellArrayNewStorage(ca->IsStorage32Bit());
+      }
+    this->Offsets->DeepCopy(ca->Offsets);
+    this->Connectivity->DeepCopy(ca->Connectivity);
+    this->Ia->Initialize();
+    }
+  else
+    {
+    this->ReleaseOffsetsLayout();
+    this->Ia->DeepCopy(ca->Ia);
+    }
   this->NumberOfCells = ca->NumberOfCells;
   this->InsertLocation = ca->InsertLocation;
   this->TraversalLocation = ca->TraversalLocation;
@@ -45,17 +236,428 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
 vtkCellArray::~vtkCellArray()
 {
   this->Ia->Delete();
+  this->ReleaseOffsetsLayout();
 }
 
 //----------------------------------------------------------------------------
 void vtkCellArray::Initialize()
 {
   this->Ia->Initialize();
+  if (this->Offsets)
+    {
+    this->Offsets->Initialize();
+    this->Offsets->InsertNextTuple1(0);
+    this->Connectivity->Initialize();
+    }
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
 }
 
+//----------------------------------------------------------------------------
+void vtkCellArray::ReleaseOffsetsLayout()
+{
+  if (this->Offsets)
+    {
+    this->Offsets->Delete();
+    this->Offsets = 0;
+    }
+  if (this->Connectivity)
+    {
+    this->Connectivity->Delete();
+    this->Connectivity = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::Allocate(const vtkIdType sz, const int ext)
+{
+  if (this->Offsets)
+    {
+    // Allocate() discards the cells, keep the offsets consistent.
+    this->NumberOfCells = 0;
+    this->TraversalLocation = 0;
+    this->Offsets->Initialize();
+    this->Offsets->InsertNextTuple1(0);
+    return this->Connectivity->Allocate(sz, ext);
+    }
+  return this->Ia->Allocate(sz,ext);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetSize()
+{
+  if (this->Offsets)
+    {
+    return this->Offsets->GetSize() + this->Connectivity->GetSize();
+    }
+  return this->Ia->GetSize();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetNumberOfConnectivityEntries()
+{
+  if (this->Offsets)
+    {
+    return this->Connectivity->GetNumberOfTuples() + this->NumberOfCells;
+    }
+  return this->Ia->GetMaxId()+1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::Squeeze()
+{
+  this->Ia->Squeeze();
+  if (this->Offsets)
+    {
+    this->Offsets->Squeeze();
+    this->Connectivity->Squeeze();
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkCellArray::IsStorage32Bit()
+{
+  return this->Offsets != 0 && this->Offsets->GetDataType() != VTK_ID_TYPE;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ConvertToOffsetsLayout(bool use32BitStorage)
+{
+  // 32 bit storage is only worth it when vtkIdType is wider.
+  bool want32 = use32BitStorage && sizeof(vtkIdType) > 4;
+
+  if (this->Offsets)
+    {
+    if (want32 == this->IsStorage32Bit())
+      {
+      return;
+      }
+    if (want32 &&
+        !(vtkCellArrayIdFits32Bit(this->Connectivity->GetNumberOfTuples()) &&
+          vtkCellArrayFits32Bit(vtkCellArrayRaw<vtkIdType>(this->Connectivity),
+                                this->Connectivity->GetNumberOfTuples())))
+      {
+      return;
+      }
+    vtkDataArray *offsets = vtkCellArrayNewStorage(want32);
+    vtkDataArray *conn = vtkCellArrayNewStorage(want32);
+    if (want32)
+      {
+      vtkCellArrayCopyStorage<vtkIdType, vtkTypeInt32>(this->Offsets, offsets);
+      vtkCellArrayCopyStorage<vtkIdType, vtkTypeInt32>(this->Connectivity, conn);
+      }
+    else
+      {
+      vtkCellArrayCopyStorage<vtkTypeInt32, vtkIdType>(this->Offsets, offsets);
+      vtkCellArrayCopyStorage<vtkTypeInt32, vtkIdType>(this->Connectivity, conn);
+      }
+    this->ReleaseOffsetsLayout();
+    this->Offsets = offsets;
+    this->Connectivity = conn;
+    this->Modified();
+    return;
+    }
+
+  // Converting from the legacy layout. The legacy array also contains the
+  // cell sizes, so checking it covers both the ids and the sizes.
+  vtkIdType size = this->Ia->GetMaxId() + 1;
+  if (want32 && !(vtkCellArrayIdFits32Bit(size) &&
+                  vtkCellArrayFits32Bit(this->Ia->GetPointer(0), size)))
+    {
+    want32 = false;
+    }
+
+  this->Offsets = vtkCellArrayNewStorage(want32);
+  this->Connectivity = vtkCellArrayNewStorage(want32);
+  if (want32)
+    {
+    this->TraversalLocation = vtkCellArrayLegacyToOffsets<vtkTypeInt32>(
+      this->Ia, this->NumberOfCells, this->TraversalLocation,
+      this->Offsets, this->Connectivity);
+    }
+  else
+    {
+    this->TraversalLocation = vtkCellArrayLegacyToOffsets<vtkIdType>(
+      this->Ia, this->NumberOfCells, this->TraversalLocation,
+      this->Offsets, this->Connectivity);
+    }
+  this->InsertLocation = 0;
+  this->Ia->Initialize();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ConvertToLegacyLayout()
+{
+  if (!this->Offsets)
+    {
+    return;
+    }
+
+  this->TraversalLocation = this->GetCellLocation(this->TraversalLocation);
+  if (this->IsStorage32Bit())
+    {
+    vtkCellArrayOffsetsToLegacy<vtkTypeInt32>(
+      this->Offsets, this->Connectivity, this->NumberOfCells, this->Ia);
+    }
+  else
+    {
+    vtkCellArrayOffsetsToLegacy<vtkIdType>(
+      this->Offsets, this->Connectivity, this->NumberOfCells, this->Ia);
+    }
+  this->InsertLocation = this->Ia->GetMaxId() + 1;
+  this->ReleaseOffsetsLayout();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+// The legacy location of cell i is offsets[i] + i.
+vtkIdType vtkCellArray::GetCellLocation(vtkIdType cellId)
+{
+  if (cellId >= this->NumberOfCells)
+    {
+    return this->GetNumberOfConnectivityEntries();
+    }
+  if (!this->Offsets)
+    {
+    const vtkIdType *legacy = this->Ia->GetPointer(0);
+    vtkIdType loc = 0;
+    for (vtkIdType i = 0; i < cellId; ++i)
+      {
+      loc += legacy[loc] + 1;
+      }
+    return loc;
+    }
+  if (this->IsStorage32Bit())
+    {
+    return vtkCellArrayRaw<vtkTypeInt32>(this->Offsets)[cellId] + cellId;
+    }
+  return vtkCellArrayRaw<vtkIdType>(this->Offsets)[cellId] + cellId;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::SetTraversalLocation(vtkIdType loc)
+{
+  if (!this->Offsets)
+    {
+    this->TraversalLocation = loc;
+    }
+  else if (this->IsStorage32Bit())
+    {
+    this->TraversalLocation = vtkCellArrayFindLegacyLocation<vtkTypeInt32>(
+      this->Offsets, this->NumberOfCells, loc);
+    }
+  else
+    {
+    this->TraversalLocation = vtkCellArrayFindLegacyLocation<vtkIdType>(
+      this->Offsets, this->NumberOfCells, loc);
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkCellArray::SetData(vtkDataArray *offsets, vtkDataArray *connectivity)
+{
+  if (!offsets || !connectivity ||
+      offsets->GetNumberOfComponents() != 1 ||
+      connectivity->GetNumberOfComponents() != 1 ||
+      offsets->GetNumberOfTuples() < 1 ||
+      offsets->GetDataType() != connectivity->GetDataType())
+    {
+    vtkErrorMacro("Offsets and connectivity must be single component arrays "
+                  "of the same type, with at least one offset.");
+    return false;
+    }
+  if (offsets->GetDataType() != VTK_ID_TYPE &&
+      !(offsets->IsA("vtkTypeInt32Array") ||
+        (offsets->GetDataType() == VTK_INT && offsets->GetDataTypeSize() == 4)))
+    {
+    vtkErrorMacro("Offsets and connectivity must be vtkIdTypeArray or "
+                  "vtkTypeInt32Array, not " << offsets->GetClassName());
+    return false;
+    }
+  vtkIdType size = connectivity->GetNumberOfTuples();
+  if (offsets->GetDataType() == VTK_ID_TYPE ?
+      !vtkCellArrayValidOffsets<vtkIdType>(offsets, size) :
+      !vtkCellArrayValidOffsets<vtkTypeInt32>(offsets, size))
+    {
+    vtkErrorMacro("The offsets must start at 0, never decrease and end at "
+                  "the number of connectivity entries (" << size << ").");
+    return false;
+    }
+
+  offsets->Register(this);
+  connectivity->Register(this);
+  this->ReleaseOffsetsLayout();
+  this->Offsets = offsets;
+  this->Connectivity = connectivity;
+  this->Ia->Initialize();
+  this->NumberOfCells = offsets->GetNumberOfTuples() - 1;
+  this->InsertLocation = 0;
+  this->TraversalLocation = 0;
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::InsertNextCellWithOffsets(vtkIdType npts,
+                                                  const vtkIdType* pts)
+{
+  if (this->IsStorage32Bit())
+    {
+    vtkIdType newSize = this->Connectivity->GetNumberOfTuples() + npts;
+    if (!vtkCellArrayIdFits32Bit(newSize) || !vtkCellArrayFits32Bit(pts, npts))
+      {
+      this->ConvertToOffsetsLayout(false);
+      }
+    }
+
+  if (this->IsStorage32Bit())
+    {
+    vtkCellArrayInsertNextCell<vtkTypeInt32>(this->Offsets, this->Connectivity,
+                                             this->NumberOfCells, npts, pts);
+    }
+  else
+    {
+    vtkCellArrayInsertNextCell<vtkIdType>(this->Offsets, this->Connectivity,
+                                          this->NumberOfCells, npts, pts);
+    }
+  return this->NumberOfCells++;
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::GetNextCellWithOffsets(vtkIdType& npts, vtkIdType* &pts)
+{
+  if (this->TraversalLocation >= this->NumberOfCells)
+    {
+    npts = 0;
+    pts = 0;
+    return 0;
+    }
+  // Without scratch space, 32 bit storage is converted to vtkIdType.
+  const vtkIdType *cpts;
+  this->GetCellAtId(this->TraversalLocation++, npts, cpts, NULL);
+  pts = const_cast<vtkIdType*>(cpts);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetCellSize(vtkIdType cellId)
+{
+  if (this->Offsets)
+    {
+    if (this->IsStorage32Bit())
+      {
+      const vtkTypeInt32 *o = vtkCellArrayRaw<vtkTypeInt32>(this->Offsets);
+      return o[cellId + 1] - o[cellId];
+      }
+    const vtkIdType *o = vtkCellArrayRaw<vtkIdType>(this->Offsets);
+    return o[cellId + 1] - o[cellId];
+    }
+
+  vtkIdType npts;
+  const vtkIdType *pts;
+  this->GetCellAtId(cellId, npts, pts, 0);
+  return npts;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType &npts,
+                               const vtkIdType* &pts, vtkIdList *scratch)
+{
+  if (this->Offsets)
+    {
+    if (this->IsStorage32Bit() && !scratch)
+      {
+      // The ids are handed out by pointer, see the caveats.
+      this->ConvertToOffsetsLayout(false);
+      }
+    if (this->IsStorage32Bit())
+      {
+      const vtkTypeInt32 *o = vtkCellArrayRaw<vtkTypeInt32>(this->Offsets);
+      const vtkTypeInt32 *c =
+        vtkCellArrayRaw<vtkTypeInt32>(this->Connectivity) + o[cellId];
+      npts = o[cellId + 1] - o[cellId];
+      scratch->SetNumberOfIds(npts);
+      vtkIdType *ids = scratch->GetPointer(0);
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        ids[i] = c[i];
+        }
+      pts = ids;
+      }
+    else
+      {
+      const vtkIdType *o = vtkCellArrayRaw<vtkIdType>(this->Offsets);
+      npts = o[cellId + 1] - o[cellId];
+      pts = vtkCellArrayRaw<vtkIdType>(this->Connectivity) + o[cellId];
+      }
+    return;
+    }
+
+  // Legacy layout: walk the cells up to the requested one.
+  const vtkIdType *legacy = this->Ia->GetPointer(0);
+  vtkIdType loc = 0;
+  for (vtkIdType i = 0; i < cellId; ++i)
+    {
+    loc += legacy[loc] + 1;
+    }
+  npts = legacy[loc];
+  pts = legacy + loc + 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdList *pts)
+{
+  vtkIdType npts;
+  const vtkIdType *ppts;
+  this->GetCellAtId(cellId, npts, ppts, pts);
+  if (ppts != pts->GetPointer(0))
+    {
+    pts->SetNumberOfIds(npts);
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      pts->SetId(i, ppts[i]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetCellPointIds(vtkIdType cellId, vtkIdType *ids)
+{
+  vtkIdType npts;
+  if (this->IsStorage32Bit())
+    {
+    const vtkTypeInt32 *o = vtkCellArrayRaw<vtkTypeInt32>(this->Offsets);
+    const vtkTypeInt32 *c =
+      vtkCellArrayRaw<vtkTypeInt32>(this->Connectivity) + o[cellId];
+    npts = o[cellId + 1] - o[cellId];
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      ids[i] = c[i];
+      }
+    return npts;
+    }
+
+  // The ids are stored as vtkIdType, no scratch space is needed.
+  const vtkIdType *pts;
+  this->GetCellAtId(cellId, npts, pts, NULL);
+  for (vtkIdType i = 0; i < npts; ++i)
+    {
+    ids[i] = pts[i];
+    }
+  return npts;
+}
+
+//----------------------------------------------------------------------------
+vtkCellArrayIterator *vtkCellArray::NewIterator()
+{
+  vtkCellArrayIterator *iter = vtkCellArrayIterator::New();
+  iter->SetCellArray(this);
+  iter->GoToFirstCell();
+  return iter;
+}
+
 //----------------------------------------------------------------------------
 // Returns the size of the largest cell. The size is the number of points
 // defining the cell.
@@ -63,6 +665,18 @@ int vtkCellArray::GetMaxCellSize()
 {
   int i, npts=0, maxSize=0;
 
+  if (this->Offsets)
+    {
+    for (vtkIdType cellId = 0; cellId < this->NumberOfCells; ++cellId)
+      {
+      if ( (npts=this->GetCellSize(cellId)) > maxSize )
+        {
+        maxSize = npts;
+        }
+      }
+    return maxSize;
+    }
+
   for (i=0; i<this->Ia->GetMaxId(); i+=(npts+1))
     {
     if ( (npts=this->Ia->GetValue(i)) > maxSize )
@@ -80,6 +694,7 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
   if ( cells && cells != this->Ia )
     {
     this->Modified();
+    this->ReleaseOffsetsLayout();
     this->Ia->Delete();
     this->Ia = cells;
     this->Ia->Register(this);
@@ -93,7 +708,13 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
 //----------------------------------------------------------------------------
 unsigned long vtkCellArray::GetActualMemorySize()
 {
-  return this->Ia->GetActualMemorySize();
+  unsigned long size = this->Ia->GetActualMemorySize();
+  if (this->Offsets)
+    {
+    size += this->Offsets->GetActualMemorySize() +
+      this->Connectivity->GetActualMemorySize();
+    }
+  return size;
 }
 
 //----------------------------------------------------------------------------
@@ -115,13 +736,54 @@ int vtkCellArray::GetNextCell(vtkIdList *pts)
 //----------------------------------------------------------------------------
 void vtkCellArray::GetCell(vtkIdType loc, vtkIdList *pts)
 {
-  vtkIdType npts = this->Ia->GetValue(loc++);
-  vtkIdType *ppts = this->Ia->GetPointer(loc);
-  pts->SetNumberOfIds(npts);
-  for (vtkIdType i = 0; i < npts; i++)
+  vtkIdType npts;
+  const vtkIdType *ppts;
+  this->GetCell(loc, npts, ppts, pts);
+  if (ppts != pts->GetPointer(0))
+    {
+    pts->SetNumberOfIds(npts);
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      pts->SetId(i, ppts[i]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
+                           const vtkIdType* &pts, vtkIdList *scratch)
+{
+  if (!this->Offsets)
+    {
+    npts = this->Ia->GetValue(loc);
+    pts = this->Ia->GetPointer(loc + 1);
+    return;
+    }
+
+  this->GetCellAtId(this->GetCellIdAtLocation(loc), npts, pts, scratch);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetCellIdAtLocation(vtkIdType loc)
+{
+  if (this->IsStorage32Bit())
+    {
+    return vtkCellArrayFindLegacyLocation<vtkTypeInt32>(
+      this->Offsets, this->NumberOfCells, loc);
+    }
+  if (this->Offsets)
+    {
+    return vtkCellArrayFindLegacyLocation<vtkIdType>(
+      this->Offsets, this->NumberOfCells, loc);
+    }
+
+  const vtkIdType *legacy = this->Ia->GetPointer(0);
+  vtkIdType cellId = 0;
+  for (vtkIdType i = 0; i < loc; i += legacy[i] + 1)
     {
-    pts->SetId(i, ppts[i]);
+    ++cellId;
     }
+  return cellId;
 }
 
 //----------------------------------------------------------------------------
@@ -132,4 +794,7 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Cells: " << this->NumberOfCells << endl;
   os << indent << "Insert Location: " << this->InsertLocation << endl;
   os << indent << "Traversal Location: " << this->TraversalLocation << endl;
+  os << indent << "Layout: "
+     << (this->Offsets ? (this->IsStorage32Bit() ? "Offsets (32 bit)" :
+                          "Offsets") : "Legacy") << endl;
 }
@@ -26,8 +26,49 @@
 // using the vtkCellTypes and vtkCellLinks objects to extend the definition of
 // the data structure.
 //
+// Alternatively the cells can be stored in the "offsets" layout: a
+// connectivity array holding the point ids of all cells back to back, and
+// an offsets array of NumberOfCells+1 entries where cell i uses the ids
+// connectivity[offsets[i]] to connectivity[offsets[i+1]-1]. This layout
+// gives O(1) access to any cell (see GetCellAtId() and
+// vtkCellArrayIterator), which allows cells to be traversed from several
+// threads at once. When the point ids and the connectivity size fit, both
+// arrays can use 32 bit integers, which roughly halves the memory used for
+// topology. Use ConvertToOffsetsLayout() or SetData() to switch to this
+// layout.
+//
+// All the methods that expose the legacy (n,id1,id2,...) array or
+// locations into it keep working on an array in the offsets layout.
+// GetTraversalLocation(), GetInsertLocation(), SetTraversalLocation() and
+// GetCellLocation() translate the locations, and GetCell(loc,...) finds the
+// cell with a binary search over the offsets and reads it like
+// GetCellAtId(). These keep the offsets layout; only GetCell(loc,npts,pts)
+// may change its storage (see the caveats).
+// The methods that hand out or modify the legacy array (GetData(),
+// GetPointer(), WritePointer(), SetCells(), ReverseCell(), ReplaceCell(),
+// InsertCellPoint(), ...) convert the cells back with
+// ConvertToLegacyLayout(), which modifies the cell array: they must not be
+// called while other threads read it. Code that wants to benefit from the
+// offsets layout should use InsertNextCell(), GetCellAtId() and
+// vtkCellArrayIterator only.
+//
+// .SECTION Caveats
+// With 32 bit storage the point ids of a cell cannot be handed out as a
+// vtkIdType pointer into the cell array. GetCellAtId() and
+// GetCell(loc,...,scratch) then copy them into the scratch list given by
+// the caller, and vtkCellArrayIterator into its own scratch list. The
+// methods that return a pointer without scratch space, GetNextCell(),
+// GetCell(loc,npts,pts), and GetCellAtId() and GetCell(loc,...,scratch)
+// given a NULL scratch list, first convert the storage to vtkIdType with
+// ConvertToOffsetsLayout(false), so that the pointers they return stay
+// valid as long as the cells are not modified, as in the legacy layout.
+// That conversion modifies the cell array: on 32 bit storage they must not
+// be called while other threads read it. GetCellAtId() and
+// vtkCellArrayIterator with scratch space owned by the caller are safe to
+// use from any thread as long as nobody modifies the cell array.
+//
 // .SECTION See Also
-// vtkCellTypes vtkCellLinks
+// vtkCellTypes vtkCellLinks vtkCellArrayIterator
 
 #ifndef __vtkCellArray_h
 #define __vtkCellArray_h
@@ -38,6 +79,9 @@
 #include "vtkIdTypeArray.h" // Needed for inline methods
 #include "vtkCell.h" // Needed for inline methods
 
+class vtkCellArrayIterator;
+class vtkDataArray;
+
 class VTKCOMMONDATAMODEL_EXPORT vtkCellArray : public vtkObject
 {
 public:
@@ -49,9 +93,9 @@ public:
   static vtkCellArray *New();
 
   // Description:
-  // Allocate memory and set the size to extend by.
-  int Allocate(const vtkIdType sz, const int ext=1000)
-    {return this->Ia->Allocate(sz,ext);}
+  // Allocate memory and set the size to extend by. The size is expressed
+  // in legacy layout entries, as returned by EstimateSize().
+  int Allocate(const vtkIdType sz, const int ext=1000);
 
   // Description:
   // Free any memory and reset to an empty state.
@@ -95,19 +139,19 @@ public:
 
   // Description:
   // Get the size of the allocated connectivity array.
-  vtkIdType GetSize()
-    {return this->Ia->GetSize();}
+  vtkIdType GetSize();
 
   // Description:
   // Get the total number of entries (i.e., data values) in the connectivity
   // array. This may be much less than the allocated size (i.e., return value
-  // from GetSize().)
-  vtkIdType GetNumberOfConnectivityEntries()
-    {return this->Ia->GetMaxId()+1;}
+  // from GetSize().) The count is always expressed in legacy layout
+  // entries, i.e. it includes one entry per cell for the number of points.
+  vtkIdType GetNumberOfConnectivityEntries();
 
   // Description:
   // Internal method used to retrieve a cell given an offset into
-  // the internal array.
+  // the internal array. In the offsets layout, pts must not be written to
+  // and 32 bit storage is converted to vtkIdType (see the caveats).
   void GetCell(vtkIdType loc, vtkIdType &npts, vtkIdType* &pts);
 
   // Description:
@@ -115,6 +159,26 @@ public:
   // the internal array.
   void GetCell(vtkIdType loc, vtkIdList* pts);
 
+  // Description:
+  // Retrieve a cell given an offset into the legacy layout, using the
+  // scratch list like GetCellAtId(). In the offsets layout the cell is
+  // found with a binary search over the offsets. Does not modify the cell
+  // array when a scratch list is given.
+  void GetCell(vtkIdType loc, vtkIdType &npts, const vtkIdType* &pts,
+               vtkIdList *scratch);
+
+  // Description:
+  // Return the offset of the given cell into the legacy layout, or the
+  // number of connectivity entries for NumberOfCells. O(1) in the offsets
+  // layout, a linear scan in the legacy layout.
+  vtkIdType GetCellLocation(vtkIdType cellId);
+
+  // Description:
+  // Return the id of the cell at the given offset into the legacy layout,
+  // the inverse of GetCellLocation(). A binary search over the offsets in
+  // the offsets layout, a linear scan in the legacy layout.
+  vtkIdType GetCellIdAtLocation(vtkIdType loc);
+
   // Description:
   // Insert a cell object. Return the cell id of the cell.
   vtkIdType InsertNextCell(vtkCell *cell);
@@ -150,20 +214,21 @@ public:
   // Computes the current insertion location within the internal array.
   // Used in conjunction with GetCell(int loc,...).
   vtkIdType GetInsertLocation(int npts)
-    {return (this->InsertLocation - npts - 1);};
+    {return (this->Offsets ? this->GetNumberOfConnectivityEntries() :
+             this->InsertLocation) - npts - 1;}
 
   // Description:
   // Get/Set the current traversal location.
   vtkIdType GetTraversalLocation()
-    {return this->TraversalLocation;}
-  void SetTraversalLocation(vtkIdType loc)
-    {this->TraversalLocation = loc;}
+    {return this->Offsets ? this->GetCellLocation(this->TraversalLocation) :
+       this->TraversalLocation;}
+  void SetTraversalLocation(vtkIdType loc);
 
   // Description:
   // Computes the current traversal location within the internal array. Used
   // in conjunction with GetCell(int loc,...).
   vtkIdType GetTraversalLocation(vtkIdType npts)
-    {return(this->TraversalLocation-npts-1);}
+    {return this->GetTraversalLocation() - npts - 1;}
 
   // Description:
   // Special method inverts ordering of current cell. Must be called
@@ -180,9 +245,10 @@ public:
   int GetMaxCellSize();
 
   // Description:
-  // Get pointer to array of cell data.
+  // Get pointer to array of cell data. Converts the cells to the legacy
+  // layout.
   vtkIdType *GetPointer()
-    {return this->Ia->GetPointer(0);}
+    {this->ConvertToLegacyLayout(); return this->Ia->GetPointer(0);}
 
   // Description:
   // Get pointer to data array for purpose of direct writes of data. Size is the
@@ -205,9 +271,10 @@ public:
   void DeepCopy(vtkCellArray *ca);
 
   // Description:
-  // Return the underlying data as a data array.
+  // Return the underlying data as a data array. Converts the cells to the
+  // legacy layout.
   vtkIdTypeArray* GetData()
-    {return this->Ia;}
+    {this->ConvertToLegacyLayout(); return this->Ia;}
 
   // Description:
   // Reuse list. Reset to initial condition.
@@ -215,8 +282,7 @@ public:
 
   // Description:
   // Reclaim any extra memory.
-  void Squeeze()
-    {this->Ia->Squeeze();}
+  void Squeeze();
 
   // Description:
   // Return the memory in kilobytes consumed by this cell array. Used to
@@ -227,16 +293,104 @@ public:
   // been updated.
   unsigned long GetActualMemorySize();
 
+  // Description:
+  // Convert the cells to the offsets layout. When use32BitStorage is
+  // true and all point ids and the connectivity size fit into 32 bit
+  // integers, the offsets and connectivity arrays are
+  // vtkTypeInt32Array; otherwise they are vtkIdTypeArray. The traversal
+  // position is preserved. Converting an array already in the offsets
+  // layout changes its storage type if needed. Calls Modified() when the
+  // layout or the storage changes.
+  void ConvertToOffsetsLayout(bool use32BitStorage = false);
+
+  // Description:
+  // Convert the cells back to the legacy (n,id1,id2,...) layout. This is
+  // a no-op for an array already in the legacy layout. The traversal
+  // position is preserved. Calls Modified() when the layout changes.
+  void ConvertToLegacyLayout();
+
+  // Description:
+  // Return true when the cells are stored in the offsets layout.
+  bool IsOffsetsLayout()
+    {return this->Offsets != 0;}
+
+  // Description:
+  // Return true when the offsets layout uses 32 bit integers.
+  bool IsStorage32Bit();
+
+  // Description:
+  // Set the cells from an offsets array with NumberOfCells+1 entries and a
+  // connectivity array (see the class description). Both arrays must have
+  // one component and be of the same type, either vtkIdTypeArray or
+  // vtkTypeInt32Array. The offsets must start at 0, never decrease and end
+  // at the number of connectivity entries. The arrays are used as-is
+  // (reference counted, no copy) and the cell array switches to the offsets
+  // layout. Returns false and leaves the cell array untouched if the arrays
+  // are not suitable.
+  bool SetData(vtkDataArray *offsets, vtkDataArray *connectivity);
+
+  // Description:
+  // Return the offsets and connectivity arrays of the offsets layout, or
+  // NULL when the cells are in the legacy layout. Call Modified() on the
+  // cell array after changing them.
+  vtkDataArray *GetOffsetsArray()
+    {return this->Offsets;}
+  vtkDataArray *GetConnectivityArray()
+    {return this->Connectivity;}
+
+  // Description:
+  // Return the number of points of the given cell. This is O(1) in the
+  // offsets layout and requires a linear scan in the legacy layout.
+  vtkIdType GetCellSize(vtkIdType cellId);
+
+  // Description:
+  // Random access to the point ids of a cell. In the offsets layout this
+  // is O(1) and does not modify the cell array, so it may be called from
+  // several threads at once. pts either points into the cell array or
+  // into the scratch list, which is only used for 32 bit storage and
+  // should be provided by the caller (one per thread). When it is NULL
+  // the storage is converted to vtkIdType instead (see the caveats).
+  // In the legacy layout this requires a linear scan.
+  void GetCellAtId(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts,
+                   vtkIdList *scratch);
+  void GetCellAtId(vtkIdType cellId, vtkIdList *pts);
+
+  // Description:
+  // Copy the point ids of a cell into ids, which must have room for
+  // GetCellSize(cellId) ids, and return their number. This neither uses
+  // scratch space nor modifies the cell array, so it may be called from
+  // several threads at once. O(1) in the offsets layout, a linear scan in
+  // the legacy layout.
+  vtkIdType GetCellPointIds(vtkIdType cellId, vtkIdType *ids);
+
+  // Description:
+  // Return a new iterator over the cells. Each iterator has its own
+  // position and scratch space, so several iterators can traverse the
+  // same cell array concurrently. The caller must Delete() the iterator.
+  vtkCellArrayIterator *NewIterator();
+
 protected:
   vtkCellArray();
   ~vtkCellArray();
 
+  // Implementation of the offsets layout insertion / traversal.
+  void ReleaseOffsetsLayout();
+  vtkIdType InsertNextCellWithOffsets(vtkIdType npts, const vtkIdType* pts);
+  int GetNextCellWithOffsets(vtkIdType& npts, vtkIdType* &pts);
+
   vtkIdType NumberOfCells;
   vtkIdType InsertLocation;     //keep track of current insertion point
   vtkIdType TraversalLocation;   //keep track of traversal position
+                                 //(a cell id in the offsets layout)
   vtkIdTypeArray *Ia;
 
+  // Offsets layout. Both are NULL in the legacy layout.
+  vtkDataArray *Offsets;
+  vtkDataArray *Connectivity;
+
 private:
+  friend class vtkCellArrayIterator;
+
   vtkCellArray(const vtkCellArray&);  // Not implemented.
   void operator=(const vtkCellArray&);  // Not implemented.
 };
@@ -246,6 +400,11 @@ private:
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
                                               const vtkIdType* pts)
 {
+  if (this->Offsets)
+    {
+    return this->InsertNextCellWithOffsets(npts, pts);
+    }
+
   vtkIdType i = this->Ia->GetMaxId() + 1;
   vtkIdType *ptr = this->Ia->WritePointer(i, npts+1);
 
@@ -263,6 +422,7 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 {
+  this->ConvertToLegacyLayout();
   this->InsertLocation = this->Ia->InsertNextValue(npts) + 1;
   this->NumberOfCells++;
 
@@ -272,12 +432,14 @@ inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InsertCellPoint(vtkIdType id)
 {
+  this->ConvertToLegacyLayout();
   this->Ia->InsertValue(this->InsertLocation++, id);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::UpdateCellCount(int npts)
 {
+  this->ConvertToLegacyLayout();
   this->Ia->SetValue(this->InsertLocation-npts-1, npts);
 }
 
@@ -301,11 +463,21 @@ inline void vtkCellArray::Reset()
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
   this->Ia->Reset();
+  if (this->Offsets)
+    {
+    this->Offsets->Reset();
+    this->Offsets->InsertNextTuple1(0);
+    this->Connectivity->Reset();
+    }
 }
 
 //----------------------------------------------------------------------------
 inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 {
+  if (this->Offsets)
+    {
+    return this->GetNextCellWithOffsets(npts, pts);
+    }
   if ( this->Ia->GetMaxId() >= 0 &&
        this->TraversalLocation <= this->Ia->GetMaxId() )
     {
@@ -323,6 +495,14 @@ inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 inline void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
                                   vtkIdType* &pts)
 {
+  if (this->Offsets)
+    {
+    const vtkIdType *cpts;
+    // Without scratch space, 32 bit storage is converted to vtkIdType.
+    this->GetCell(loc, npts, cpts, NULL);
+    pts = const_cast<vtkIdType*>(cpts);
+    return;
+    }
   npts = this->Ia->GetValue(loc++);
   pts  = this->Ia->GetPointer(loc);
 }
@@ -332,6 +512,7 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
 {
   int i;
   vtkIdType tmp;
+  this->ConvertToLegacyLayout();
   vtkIdType npts=this->Ia->GetValue(loc);
   vtkIdType *pts=this->Ia->GetPointer(loc+1);
   for (i=0; i < (npts/2); i++)
@@ -346,6 +527,7 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
 inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
                                       const vtkIdType *pts)
 {
+  this->ConvertToLegacyLayout();
   vtkIdType *oldPts=this->Ia->GetPointer(loc+1);
   for (int i=0; i < npts; i++)
     {
@@ -357,6 +539,7 @@ inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
 inline vtkIdType *vtkCellArray::WritePointer(const vtkIdType ncells,
                                              const vtkIdType size)
 {
+  this->ConvertToLegacyLayout();
   this->NumberOfCells = ncells;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCellArrayIterator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArrayIterator.h"
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+
+vtkStandardNewMacro(vtkCellArrayIterator);
+
+vtkCxxSetObjectMacro(vtkCellArrayIterator, CellArray, vtkCellArray);
+
+//----------------------------------------------------------------------------
+vtkCellArrayIterator::vtkCellArrayIterator()
+{
+  this->CellArray = 0;
+  this->CurrentCellId = 0;
+  this->LegacyLocation = 0;
+  this->Scratch = vtkIdList::New();
+}
+
+//----------------------------------------------------------------------------
+vtkCellArrayIterator::~vtkCellArrayIterator()
+{
+  this->SetCellArray(0);
+  this->Scratch->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArrayIterator::GoToFirstCell()
+{
+  this->CurrentCellId = 0;
+  this->LegacyLocation = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArrayIterator::GoToNextCell()
+{
+  if (this->CellArray && !this->CellArray->Offsets &&
+      this->CurrentCellId < this->CellArray->NumberOfCells)
+    {
+    this->LegacyLocation +=
+      this->CellArray->Ia->GetValue(this->LegacyLocation) + 1;
+    }
+  ++this->CurrentCellId;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArrayIterator::GoToCell(vtkIdType cellId)
+{
+  if (this->CellArray && !this->CellArray->Offsets)
+    {
+    // Scan forward from the current cell when possible.
+    if (cellId < this->CurrentCellId)
+      {
+      this->GoToFirstCell();
+      }
+    while (this->CurrentCellId < cellId &&
+           this->CurrentCellId < this->CellArray->NumberOfCells)
+      {
+      this->GoToNextCell();
+      }
+    }
+  this->CurrentCellId = cellId;
+}
+
+//----------------------------------------------------------------------------
+bool vtkCellArrayIterator::IsDoneWithTraversal()
+{
+  return !this->CellArray ||
+    this->CurrentCellId >= this->CellArray->NumberOfCells;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArrayIterator::GetCurrentCell(vtkIdType &npts,
+                                          const vtkIdType* &pts)
+{
+  if (this->IsDoneWithTraversal())
+    {
+    npts = 0;
+    pts = 0;
+    return;
+    }
+  if (this->CellArray->Offsets)
+    {
+    this->CellArray->GetCellAtId(this->CurrentCellId, npts, pts,
+                                 this->Scratch);
+    }
+  else
+    {
+    const vtkIdType *legacy =
+      this->CellArray->Ia->GetPointer(this->LegacyLocation);
+    npts = legacy[0];
+    pts = legacy + 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArrayIterator::GetCurrentCell(vtkIdList *ids)
+{
+  vtkIdType npts;
+  const vtkIdType *pts;
+  this->GetCurrentCell(npts, pts);
+  ids->SetNumberOfIds(npts);
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    ids->SetId(i, pts[i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArrayIterator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Cell Array: " << this->CellArray << endl;
+  os << indent << "Current Cell Id: " << this->CurrentCellId << endl;
+}
@@ -0,0 +1,97 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCellArrayIterator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkCellArrayIterator - traverse the cells of a vtkCellArray
+// .SECTION Description
+// vtkCellArrayIterator walks over the cells of a vtkCellArray without
+// using the traversal location stored in the cell array. Each iterator
+// owns its position and scratch space, so several iterators (e.g. one
+// per thread) may traverse the same cell array at once, as long as the
+// cell array is not modified meanwhile. The iterator never converts the
+// layout of the cell array.
+//
+// In the offsets layout GoToCell() is O(1); in the legacy layout it has
+// to scan the cells preceding the requested one.
+//
+// \code
+// vtkCellArrayIterator *iter = cells->NewIterator();
+// for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal();
+//      iter->GoToNextCell())
+//   {
+//   iter->GetCurrentCell(npts, pts);
+//   }
+// iter->Delete();
+// \endcode
+//
+// .SECTION See Also
+// vtkCellArray
+
+#ifndef __vtkCellArrayIterator_h
+#define __vtkCellArrayIterator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkCellArray;
+class vtkIdList;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkCellArrayIterator : public vtkObject
+{
+public:
+  static vtkCellArrayIterator *New();
+  vtkTypeMacro(vtkCellArrayIterator,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set / get the cell array to iterate over. Call GoToFirstCell() or
+  // GoToCell() after changing it.
+  virtual void SetCellArray(vtkCellArray*);
+  vtkGetObjectMacro(CellArray, vtkCellArray);
+
+  // Description:
+  // Move the iterator to the first / next / given cell.
+  void GoToFirstCell();
+  void GoToNextCell();
+  void GoToCell(vtkIdType cellId);
+
+  // Description:
+  // Return true once the iterator moved past the last cell.
+  bool IsDoneWithTraversal();
+
+  // Description:
+  // Return the id of the current cell.
+  vtkIdType GetCurrentCellId()
+    {return this->CurrentCellId;}
+
+  // Description:
+  // Get the point ids of the current cell. pts stays valid until the
+  // iterator moves or the cell array is modified.
+  void GetCurrentCell(vtkIdType &npts, const vtkIdType* &pts);
+  void GetCurrentCell(vtkIdList *pts);
+
+protected:
+  vtkCellArrayIterator();
+  ~vtkCellArrayIterator();
+
+  vtkCellArray *CellArray;
+  vtkIdType CurrentCellId;
+  vtkIdType LegacyLocation; // position in the legacy (n,id1,...) array
+  vtkIdList *Scratch;
+
+private:
+  vtkCellArrayIterator(const vtkCellArrayIterator&);  // Not implemented.
+  void operator=(const vtkCellArrayIterator&);  // Not implemented.
+};
+
+#endif
@@ -14,19 +14,248 @@
 =========================================================================*/
 #include "vtkCellLinks.h"
 
+#include "vtkAtomicInt.h"
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellLinks);
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Cell sources used to build the static links. GetCell() must be safe to
+// call from several threads once Prepare() has been called.
+
+// Cells of a vtkPolyData, located through its cell types.
+class vtkCellLinksPolyDataSource
+{
+public:
+  vtkPolyData *Data;
+
+  void Prepare()
+  {
+    // Make sure the cell types exist, GetCellPoints() then only reads. The
+    // ids are copied to the scratch list of the thread, so 32 bit storage
+    // is never converted here.
+    if (this->Data->GetNumberOfCells() > 0)
+      {
+      this->Data->GetCellType(0);
+      }
+  }
+
+  void GetCell(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts,
+               vtkIdList *scratch)
+  {
+    this->Data->GetCellPoints(cellId, scratch);
+    npts = scratch->GetNumberOfIds();
+    pts = scratch->GetPointer(0);
+  }
+};
+
+// Cells of an explicit cell array (e.g. vtkUnstructuredGrid).
+class vtkCellLinksCellArraySource
+{
+public:
+  vtkCellArray *Cells;
+  const vtkIdType *Legacy;
+  std::vector<vtkIdType> Locations;
+
+  void Prepare()
+  {
+    this->Legacy = NULL;
+    if (this->Cells == NULL || this->Cells->IsOffsetsLayout())
+      {
+      return;
+      }
+    // The legacy layout has no random access, record the cell locations.
+    vtkIdType numCells = this->Cells->GetNumberOfCells();
+    this->Legacy = this->Cells->GetPointer();
+    this->Locations.resize(numCells);
+    vtkIdType loc = 0;
+    for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+      {
+      this->Locations[cellId] = loc;
+      loc += this->Legacy[loc] + 1;
+      }
+  }
+
+  void GetCell(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts,
+               vtkIdList *scratch)
+  {
+    if (this->Legacy)
+      {
+      const vtkIdType *cell = this->Legacy + this->Locations[cellId];
+      npts = cell[0];
+      pts = cell + 1;
+      }
+    else
+      {
+      this->Cells->GetCellAtId(cellId, npts, pts, scratch);
+      }
+  }
+};
+
+// Cells of any dataset. Only used serially.
+class vtkCellLinksDataSetSource
+{
+public:
+  vtkDataSet *Data;
+
+  void Prepare()
+  {
+  }
+
+  void GetCell(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts,
+               vtkIdList *scratch)
+  {
+    this->Data->GetCellPoints(cellId, scratch);
+    npts = scratch->GetNumberOfIds();
+    pts = scratch->GetPointer(0);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Counts the uses of each point (Cells == NULL) or scatters the cell ids
+// into the lists of the points.
+template <class TSource>
+class vtkCellLinksTraverseCells
+{
+public:
+  TSource *Source;
+  vtkAtomicInt<vtkIdType> *Cursor;
+  vtkIdType *Cells;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList> > Scratch;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkSmartPointer<vtkIdList> &scratch = this->Scratch.Local();
+    if (!scratch)
+      {
+      scratch = vtkSmartPointer<vtkIdList>::New();
+      }
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->Source->GetCell(cellId, npts, pts, scratch);
+      if (this->Cells)
+        {
+        for (vtkIdType j = 0; j < npts; j++)
+          {
+          this->Cells[this->Cursor[pts[j]]++] = cellId;
+          }
+        }
+      else
+        {
+        for (vtkIdType j = 0; j < npts; j++)
+          {
+          ++this->Cursor[pts[j]];
+          }
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Restores the increasing cell id order that concurrent scattering breaks.
+class vtkCellLinksSortLists
+{
+public:
+  vtkIdType *Cells;
+  const vtkIdType *Offsets;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      std::sort(this->Cells + this->Offsets[ptId],
+                this->Cells + this->Offsets[ptId + 1]);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Build the static links in two counting passes. Returns the storage of
+// all the lists and points the links into it.
+template <class TSource>
+vtkIdType *vtkCellLinksBuildStatic(TSource *source, vtkIdType numPts,
+                                   vtkIdType numCells, bool parallel,
+                                   vtkCellLinks::Link *links)
+{
+  source->Prepare();
+
+  vtkAtomicInt<vtkIdType> *cursor = new vtkAtomicInt<vtkIdType>[numPts];
+  vtkCellLinksTraverseCells<TSource> traverse;
+  traverse.Source = source;
+  traverse.Cursor = cursor;
+  traverse.Cells = NULL;
+  if (parallel)
+    {
+    vtkSMPTools::For(0, numCells, traverse);
+    }
+  else
+    {
+    traverse(0, numCells);
+    }
+
+  std::vector<vtkIdType> offsets(numPts + 1);
+  offsets[0] = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+    vtkIdType ncells = cursor[ptId].Load();
+    offsets[ptId + 1] = offsets[ptId] + ncells;
+    cursor[ptId].Store(offsets[ptId]);
+    links[ptId].ncells = static_cast<unsigned short>(ncells);
+    }
+
+  vtkIdType *cells = new vtkIdType[offsets[numPts]];
+  traverse.Cells = cells;
+  if (parallel)
+    {
+    vtkSMPTools::For(0, numCells, traverse);
+    if (vtkSMPTools::GetEstimatedNumberOfThreads() > 1)
+      {
+      vtkCellLinksSortLists sort;
+      sort.Cells = cells;
+      sort.Offsets = &offsets[0];
+      vtkSMPTools::For(0, numPts, sort);
+      }
+    }
+  else
+    {
+    traverse(0, numCells);
+    }
+  delete [] cursor;
+
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+    links[ptId].cells = cells + offsets[ptId];
+    }
+  return cells;
+}
+} // end anon namespace
+
 //----------------------------------------------------------------------------
 void vtkCellLinks::Allocate(vtkIdType sz, vtkIdType ext)
 {
   static vtkCellLinks::Link linkInit = {0,NULL};
 
+  if ( this->StaticCells != NULL )
+    {
+    delete [] this->StaticCells;
+    this->StaticCells = NULL;
+    }
+
   this->Size = sz;
   if ( this->Array != NULL )
     {
@@ -50,6 +279,13 @@ vtkCellLinks::~vtkCellLinks()
     return;
     }
 
+  if ( this->StaticCells != NULL )
+    {
+    delete [] this->StaticCells;
+    delete [] this->Array;
+    return;
+    }
+
   for (vtkIdType i=0; i<=this->MaxId; i++)
     {
     if ( this->Array[i].cells != NULL )
@@ -246,11 +482,89 @@ void vtkCellLinks::BuildLinks(vtkDataSet *data, vtkCellArray *Connectivity)
   Connectivity->SetTraversalLocation(loc);
 }
 
+//----------------------------------------------------------------------------
+// Build the link list array as one contiguous static structure.
+void vtkCellLinks::BuildStaticLinks(vtkDataSet *data)
+{
+  vtkIdType numPts = data->GetNumberOfPoints();
+  vtkIdType numCells = data->GetNumberOfCells();
+
+  if ( this->StaticCells != NULL )
+    {
+    delete [] this->StaticCells;
+    }
+
+  // Use fast path if polydata
+  if ( data->GetDataObjectType() == VTK_POLY_DATA )
+    {
+    vtkCellLinksPolyDataSource source;
+    source.Data = static_cast<vtkPolyData *>(data);
+    this->StaticCells = vtkCellLinksBuildStatic(&source, numPts, numCells,
+                                                true, this->Array);
+    }
+  else //any other type of dataset
+    {
+    vtkCellLinksDataSetSource source;
+    source.Data = data;
+    this->StaticCells = vtkCellLinksBuildStatic(&source, numPts, numCells,
+                                                false, this->Array);
+    }
+  this->MaxId = numPts - 1;
+}
+
+//----------------------------------------------------------------------------
+// Build the link list array as one contiguous static structure.
+void vtkCellLinks::BuildStaticLinks(vtkDataSet *data,
+                                    vtkCellArray *Connectivity)
+{
+  vtkIdType numPts = data->GetNumberOfPoints();
+
+  if ( this->StaticCells != NULL )
+    {
+    delete [] this->StaticCells;
+    }
+
+  vtkIdType numCells = Connectivity ? Connectivity->GetNumberOfCells() : 0;
+
+  vtkCellLinksCellArraySource source;
+  source.Cells = Connectivity;
+  this->StaticCells = vtkCellLinksBuildStatic(&source, numPts, numCells,
+                                              true, this->Array);
+  this->MaxId = numPts - 1;
+}
+
+//----------------------------------------------------------------------------
+// Give every point its own list so that the lists can be resized.
+void vtkCellLinks::ConvertToDynamicLinks()
+{
+  if ( this->StaticCells == NULL )
+    {
+    return;
+    }
+
+  for (vtkIdType i=0; i<=this->MaxId; i++)
+    {
+    if ( this->Array[i].cells != NULL )
+      {
+      vtkIdType *cells = new vtkIdType[this->Array[i].ncells];
+      memcpy(cells, this->Array[i].cells,
+             this->Array[i].ncells*sizeof(vtkIdType));
+      this->Array[i].cells = cells;
+      }
+    }
+  delete [] this->StaticCells;
+  this->StaticCells = NULL;
+}
+
 //----------------------------------------------------------------------------
 // Insert a new point into the cell-links data structure. The size parameter
 // is the initial size of the list.
 vtkIdType vtkCellLinks::InsertNextPoint(int numLinks)
 {
+  if ( this->StaticCells != NULL )
+    {
+    this->ConvertToDynamicLinks();
+    }
   if ( ++this->MaxId >= this->Size )
     {
     this->Resize(this->MaxId + 1);
@@ -282,6 +596,30 @@ void vtkCellLinks::DeepCopy(vtkCellLinks *src)
   this->Allocate(src->Size, src->Extend);
   memcpy(this->Array, src->Array, this->Size * sizeof(vtkCellLinks::Link));
   this->MaxId = src->MaxId;
+
+  if ( src->StaticCells != NULL )
+    {
+    // Copy the storage of the lists and point the links into the copy.
+    vtkIdType size = 0;
+    for (vtkIdType i=0; i<=this->MaxId; i++)
+      {
+      if ( src->Array[i].cells != NULL )
+        {
+        size = std::max(size, static_cast<vtkIdType>(
+          src->Array[i].cells - src->StaticCells) + src->Array[i].ncells);
+        }
+      }
+    this->StaticCells = new vtkIdType[size];
+    memcpy(this->StaticCells, src->StaticCells, size * sizeof(vtkIdType));
+    for (vtkIdType i=0; i<=this->MaxId; i++)
+      {
+      if ( src->Array[i].cells != NULL )
+        {
+        this->Array[i].cells = this->StaticCells +
+          (src->Array[i].cells - src->StaticCells);
+        }
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -292,4 +630,5 @@ void vtkCellLinks::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Size: " << this->Size << "\n";
   os << indent << "MaxId: " << this->MaxId << "\n";
   os << indent << "Extend: " << this->Extend << "\n";
+  os << indent << "Static: " << (this->StaticCells ? "On\n" : "Off\n");
 }
@@ -19,6 +19,15 @@
 // a list of Links, each link represents a dynamic list of cell id's using the
 // point. The information provided by this object can be used to determine
 // neighbors and construct other local topological information.
+//
+// The links can also be built as a static structure with
+// BuildStaticLinks(): the cell ids of all points are then stored back to
+// back in one array (compressed sparse row layout) instead of one array
+// per point. The static links are built in two counting passes that run
+// in parallel with vtkSMPTools, and they avoid the many small
+// allocations of the dynamic links. The Link API is unchanged. Methods
+// that need to grow the list of a point (ResizeCellList(),
+// InsertNextPoint()) first convert the static links to dynamic ones.
 // .SECTION See Also
 // vtkCellArray vtkCellTypes
 
@@ -67,6 +76,20 @@ public:
   // Build the link list array.
   void BuildLinks(vtkDataSet *data, vtkCellArray *Connectivity);
 
+  // Description:
+  // Build the link list array as a static structure (see the class
+  // description). Polygonal data and explicit cell arrays are traversed
+  // in parallel; other datasets are traversed serially. Within the list
+  // of a point, the cell ids are sorted in increasing order, as with
+  // BuildLinks().
+  void BuildStaticLinks(vtkDataSet *data);
+  void BuildStaticLinks(vtkDataSet *data, vtkCellArray *Connectivity);
+
+  // Description:
+  // Return true if the links are currently stored in the static layout.
+  bool IsStatic()
+    {return this->StaticCells != NULL;}
+
   // Description:
   // Return a list of cell ids using the point.
   vtkIdType *GetCells(vtkIdType ptId) {return this->Array[ptId].cells;};
@@ -126,7 +149,8 @@ public:
   void DeepCopy(vtkCellLinks *src);
 
 protected:
-  vtkCellLinks():Array(NULL),Size(0),MaxId(-1),Extend(1000) {};
+  vtkCellLinks():Array(NULL),Size(0),MaxId(-1),Extend(1000),
+                 StaticCells(NULL) {};
   ~vtkCellLinks();
 
   // Description:
@@ -145,6 +169,13 @@ protected:
   vtkIdType MaxId;     // maximum index inserted thus far
   vtkIdType Extend;     // grow array by this point
   Link *Resize(vtkIdType sz);  // function to resize data
+
+  // Description:
+  // Convert static links to one cell list per point so that the lists
+  // can be resized.
+  void ConvertToDynamicLinks();
+
+  vtkIdType *StaticCells; // storage of all the lists of static links
 private:
   vtkCellLinks(const vtkCellLinks&);  // Not implemented.
   void operator=(const vtkCellLinks&);  // Not implemented.
@@ -162,7 +193,10 @@ inline void vtkCellLinks::InsertCellReference(vtkIdType ptId,
 inline void vtkCellLinks::DeletePoint(vtkIdType ptId)
 {
   this->Array[ptId].ncells = 0;
-  delete [] this->Array[ptId].cells;
+  if ( this->StaticCells == NULL )
+    {
+    delete [] this->Array[ptId].cells;
+    }
   this->Array[ptId].cells = NULL;
 }
 
@@ -205,6 +239,11 @@ inline void vtkCellLinks::ResizeCellList(vtkIdType ptId, int size)
   int newSize;
   vtkIdType *cells;
 
+  if ( this->StaticCells != NULL )
+    {
+    this->ConvertToDynamicLinks();
+    }
+
   newSize = this->Array[ptId].ncells + size;
   cells = new vtkIdType[newSize];
   memcpy(cells, this->Array[ptId].cells,
@@ -16,6 +16,7 @@
 
 #include "vtkCellArray.h"
 #include "vtkGenericCell.h"
+#include "vtkLocatorScratch.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
@@ -36,6 +37,9 @@ class vtkNeighborCells
   public:
     vtkNeighborCells(const int sz, const int ext=1000)
       {this->P = vtkIntArray::New(); this->P->Allocate(3*sz,3*ext);};
+    // Use the given array as storage, e.g. the one of a vtkLocatorScratch.
+    vtkNeighborCells(vtkIntArray *p)
+      {this->P = p; this->P->Register(0); this->P->SetNumberOfComponents(1);};
     ~vtkNeighborCells(){this->P->Delete();};
     int GetNumberOfNeighbors() {return (this->P->GetMaxId()+1)/3;};
     void Reset() {this->P->Reset();};
@@ -56,6 +60,14 @@ inline int vtkNeighborCells::InsertNextPoint(int *x)
   return id/3;
 }
 
+//----------------------------------------------------------------------------
+bool vtkCellLocator_Inside(double bounds[6], double point[3]) {
+  if (point[0]<bounds[0] || point[0]>bounds[1] ||
+      point[1]<bounds[2] || point[1]>bounds[3] ||
+      point[2]<bounds[4] || point[2]>bounds[5]) return 0;
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // Construct with automatic computation of divisions, averaging
 // 25 cells per bucket.
@@ -71,6 +83,7 @@ vtkCellLocator::vtkCellLocator()
   this->H[0] = this->H[1] = this->H[2] = 1.0;
 
   this->Buckets = new vtkNeighborCells(10, 10);
+  this->Scratch = vtkLocatorScratch::New();
   this->NumberOfOctants = 0;
   this->Bounds[0] = this->Bounds[2] = this->Bounds[4] = VTK_DOUBLE_MAX;
   this->Bounds[1] = this->Bounds[3] = this->Bounds[5] = VTK_DOUBLE_MIN;
@@ -88,6 +101,7 @@ vtkCellLocator::~vtkCellLocator()
     delete this->Buckets;
     this->Buckets = NULL;
     }
+  this->Scratch->Delete();
 
   this->FreeSearchStructure();
   this->FreeCellBounds();
@@ -161,6 +175,33 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
                                       double& t, double x[3], double pcoords[3],
                                       int &subId, vtkIdType &cellId,
                                       vtkGenericCell *cell)
+{
+  this->BuildLocatorIfNeeded();
+
+  return this->IntersectWithLineInternal(a0, a1, tol, t, x, pcoords, subId,
+                                         cellId, cell, this->Scratch);
+}
+
+//----------------------------------------------------------------------------
+int vtkCellLocator::IntersectWithLine(
+  const double p1[3], const double p2[3], double tol, double& t,
+  double x[3], double pcoords[3], int &subId, vtkIdType &cellId,
+  vtkLocatorScratch *scratch) const
+{
+  double a0[3] = { p1[0], p1[1], p1[2] };
+  double a1[3] = { p2[0], p2[1], p2[2] };
+
+  return this->IntersectWithLineInternal(a0, a1, tol, t, x, pcoords, subId,
+                                         cellId, scratch->GetCell(), scratch);
+}
+
+//----------------------------------------------------------------------------
+// The visited cells are marked in the scratch, and the bounds of the
+// current octant are local, so that concurrent queries do not interfere.
+int vtkCellLocator::IntersectWithLineInternal(
+  double a0[3], double a1[3], double tol, double& t, double x[3],
+  double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell,
+  vtkLocatorScratch *scratch) const
 {
   double origin[3];
   double direction1[3];
@@ -180,8 +221,12 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
   double stopDist, currDist;
   double deltaT, pDistance, minPDistance=1.0e38;
   double length, maxLength=0.0;
+  double octantBounds[6];
 
-  this->BuildLocatorIfNeeded();
+  if (!this->Tree)
+    {
+    return 0;
+    }
 
   // convert the line into i,j,k coordinates
   tMax = 0.0;
@@ -219,15 +264,8 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
     leafStart = this->NumberOfOctants - this->NumberOfDivisions*prod;
     bestCellId = -1;
 
-    // Clear the array that indicates whether we have visited this cell.
-    // The array is only cleared when the query number rolls over.  This
-    // saves a number of calls to memset.
-    this->QueryNumber++;
-    if (this->QueryNumber == 0)
-      {
-      this->ClearCellHasBeenVisited();
-      this->QueryNumber++;    // can't use 0 as a marker
-      }
+    // No cell has been visited yet.
+    scratch->BeginQuery(this->DataSet->GetNumberOfCells());
 
     // set up curr and stop dist
     currDist = 0;
@@ -261,14 +299,18 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
       {
       if (this->Tree[idx])
         {
-        this->ComputeOctantBounds(pos[0]-1,pos[1]-1,pos[2]-1);
+        octantBounds[0] = this->Bounds[0] + (pos[0]-1)*this->H[0];
+        octantBounds[1] = octantBounds[0] + this->H[0];
+        octantBounds[2] = this->Bounds[2] + (pos[1]-1)*this->H[1];
+        octantBounds[3] = octantBounds[2] + this->H[1];
+        octantBounds[4] = this->Bounds[4] + (pos[2]-1)*this->H[2];
+        octantBounds[5] = octantBounds[4] + this->H[2];
         for (tMax = VTK_DOUBLE_MAX, cellId=0;
         cellId < this->Tree[idx]->GetNumberOfIds(); cellId++)
           {
           cId = this->Tree[idx]->GetId(cellId);
-          if (this->CellHasBeenVisited[cId] != this->QueryNumber)
+          if (scratch->Visit(cId))
             {
-            this->CellHasBeenVisited[cId] = this->QueryNumber;
             int hitCellBounds = 0;
 
             // check whether we intersect the cell bounds
@@ -293,9 +335,9 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
               this->DataSet->GetCell(cId, cell);
               if (cell->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId) )
                 {
-                if ( ! this->IsInOctantBounds(x) )
+                if ( ! vtkCellLocator_Inside(octantBounds, x) )
                   {
-                  this->CellHasBeenVisited[cId] = 0; //mark the cell non-visited
+                  scratch->Unvisit(cId); //mark the cell non-visited
                   }
                 else
                   {
@@ -313,7 +355,7 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
                   } //if within current parametric range
                 } // if intersection
               } // if (hitCellBounds)
-            } // if (!this->CellHasBeenVisited[cId])
+            } // if (scratch->Visit(cId))
           }
         }
 
@@ -392,6 +434,31 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
 void vtkCellLocator::FindClosestPoint(double x[3], double closestPoint[3],
                                       vtkGenericCell *cell, vtkIdType &cellId,
                                       int &subId, double& dist2)
+{
+  this->BuildLocatorIfNeeded();
+
+  this->FindClosestPointInternal(x, closestPoint, cell, this->Scratch,
+                                 cellId, subId, dist2);
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLocator::FindClosestPoint(
+  const double x[3], double closestPoint[3], vtkLocatorScratch *scratch,
+  vtkIdType &cellId, int &subId, double& dist2) const
+{
+  double point[3] = { x[0], x[1], x[2] };
+
+  this->FindClosestPointInternal(point, closestPoint, scratch->GetCell(),
+                                 scratch, cellId, subId, dist2);
+}
+
+//----------------------------------------------------------------------------
+// The visited cells and the buckets to search are kept in the scratch, so
+// that concurrent queries do not interfere.
+void vtkCellLocator::FindClosestPointInternal(
+  double x[3], double closestPoint[3], vtkGenericCell *cell,
+  vtkLocatorScratch *scratch, vtkIdType &cellId, int &subId,
+  double& dist2) const
 {
   int i;
   vtkIdType j;
@@ -410,7 +477,15 @@ void vtkCellLocator::FindClosestPoint(double x[3], double closestPoint[3],
   int stat;
   //int minStat=0; //save this variable it is used for debugging
 
-  this->BuildLocatorIfNeeded();
+  // init
+  dist2 = -1.0;
+
+  if (!this->Tree)
+    {
+    return;
+    }
+
+  vtkNeighborCells buckets(scratch->GetIndices());
 
   cachedPoint[0] = 0.0;
   cachedPoint[1] = 0.0;
@@ -419,18 +494,9 @@ void vtkCellLocator::FindClosestPoint(double x[3], double closestPoint[3],
   leafStart = this->NumberOfOctants
     - this->NumberOfDivisions*this->NumberOfDivisions*this->NumberOfDivisions;
 
-  // Clear the array that indicates whether we have visited this cell.
-  // The array is only cleared when the query number rolls over.  This
-  // saves a number of calls to memset.
-  this->QueryNumber++;
-  if (this->QueryNumber == 0)
-    {
-    this->ClearCellHasBeenVisited();
-    this->QueryNumber++;    // can't use 0 as a marker
-    }
+  // No cell has been visited yet.
+  scratch->BeginQuery(this->DataSet->GetNumberOfCells());
 
-  // init
-  dist2 = -1.0;
   refinedRadius2 = VTK_DOUBLE_MAX;
 
   //
@@ -457,11 +523,11 @@ void vtkCellLocator::FindClosestPoint(double x[3], double closestPoint[3],
   for (closestCell=(-1),minDist2=VTK_DOUBLE_MAX,level=0;
   (closestCell == -1) && (level < this->NumberOfDivisions); level++)
     {
-    this->GetBucketNeighbors(ijk, this->NumberOfDivisions, level);
+    this->GetBucketNeighbors(&buckets, ijk, this->NumberOfDivisions, level);
 
-    for (i=0; i<this->Buckets->GetNumberOfNeighbors(); i++)
+    for (i=0; i<buckets.GetNumberOfNeighbors(); i++)
       {
-      nei = this->Buckets->GetPoint(i);
+      nei = buckets.GetPoint(i);
 
       // if a neighboring bucket has cells,
       if ( (cellIds =
@@ -478,9 +544,8 @@ void vtkCellLocator::FindClosestPoint(double x[3], double closestPoint[3],
             {
             // get the cell
             cellId = cellIds->GetId(j);
-            if (this->CellHasBeenVisited[cellId] != this->QueryNumber)
+            if (scratch->Visit(cellId))
               {
-              this->CellHasBeenVisited[cellId] = this->QueryNumber;
 
               // check whether we could be close enough to the cell by
               // testing the cell bounds
@@ -534,7 +599,7 @@ void vtkCellLocator::FindClosestPoint(double x[3], double closestPoint[3],
 //                  minStat = stat;
                   }
                 }
-              } // if (!this->CellHasBeenVisited[cellId])
+              } // if (scratch->Visit(cellId))
             }
           }
         }
@@ -567,12 +632,12 @@ void vtkCellLocator::FindClosestPoint(double x[3], double closestPoint[3],
         prevMaxLevel[i] = this->NumberOfDivisions - 1;
         }
       }
-    this->GetOverlappingBuckets(x, ijk, sqrt(minDist2), prevMinLevel,
-                                prevMaxLevel);
+    this->GetOverlappingBuckets(&buckets, x, ijk, sqrt(minDist2),
+                                prevMinLevel, prevMaxLevel);
 
-    for (i=0; i<this->Buckets->GetNumberOfNeighbors(); i++)
+    for (i=0; i<buckets.GetNumberOfNeighbors(); i++)
       {
-      nei = this->Buckets->GetPoint(i);
+      nei = buckets.GetPoint(i);
 
       if ( (cellIds =
           this->Tree[leafStart + nei[0] + nei[1]*this->NumberOfDivisions +
@@ -588,9 +653,8 @@ void vtkCellLocator::FindClosestPoint(double x[3], double closestPoint[3],
             {
             // get the cell
             cellId = cellIds->GetId(j);
-            if (this->CellHasBeenVisited[cellId] != this->QueryNumber)
+            if (scratch->Visit(cellId))
               {
-              this->CellHasBeenVisited[cellId] = this->QueryNumber;
 
               // check whether we could be close enough to the cell by
               // testing the cell bounds
@@ -853,7 +917,7 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
     currentRadius = refinedRadius; // used in if at bottom of this for loop
 
     // Build up a list of buckets that are arranged in rings
-    this->GetOverlappingBuckets(x, ijk, refinedRadius/ii, prevMinLevel,
+    this->GetOverlappingBuckets(this->Buckets, x, ijk, refinedRadius/ii, prevMinLevel,
                                 prevMaxLevel);
 
     for (i=0; i<this->Buckets->GetNumberOfNeighbors(); i++)
@@ -969,22 +1033,21 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
 //  These indices must be offset by number of octants before the leaf node
 //  layer before they can be used. Only those buckets with cells are returned.
 //
-void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
+void vtkCellLocator::GetBucketNeighbors(vtkNeighborCells *buckets,
+                                        int ijk[3], int ndivs, int level) const
 {
   int i, j, k, min, max, minLevel[3], maxLevel[3];
   int nei[3];
   int leafStart;
   int numberOfBucketsPerPlane;
 
-  this->BuildLocatorIfNeeded();
-
   numberOfBucketsPerPlane = this->NumberOfDivisions*this->NumberOfDivisions;
   leafStart = this->NumberOfOctants
     - numberOfBucketsPerPlane*this->NumberOfDivisions;
 
   //  Initialize
   //
-  this->Buckets->Reset();
+  buckets->Reset();
 
   //  If at this bucket, just place into list
   //
@@ -993,7 +1056,7 @@ void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
     if (this->Tree[leafStart + ijk[0] + ijk[1]*this->NumberOfDivisions
       + ijk[2]*numberOfBucketsPerPlane])
       {
-      this->Buckets->InsertNextPoint(ijk);
+      buckets->InsertNextPoint(ijk);
       }
     return;
     }
@@ -1023,7 +1086,7 @@ void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
             + k*numberOfBucketsPerPlane])
             {
             nei[0]=i; nei[1]=j; nei[2]=k;
-            this->Buckets->InsertNextPoint(nei);
+            buckets->InsertNextPoint(nei);
             }
           }
         }
@@ -1041,23 +1104,22 @@ void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
 // layer before they can be used. Only buckets that have cells are placed
 // in the bucket list.
 //
-void vtkCellLocator::GetOverlappingBuckets(double x[3], int vtkNotUsed(ijk)[3],
+void vtkCellLocator::GetOverlappingBuckets(vtkNeighborCells *buckets,
+                                           double x[3], int vtkNotUsed(ijk)[3],
                                            double dist,
                                            int prevMinLevel[3],
-                                           int prevMaxLevel[3])
+                                           int prevMaxLevel[3]) const
 {
   int i, j, k, nei[3], minLevel[3], maxLevel[3];
   int leafStart, kFactor, jFactor;
   int numberOfBucketsPerPlane, jkSkipFlag, kSkipFlag;
 
-  this->BuildLocatorIfNeeded();
-
   numberOfBucketsPerPlane = this->NumberOfDivisions*this->NumberOfDivisions;
   leafStart = this->NumberOfOctants
     - numberOfBucketsPerPlane*this->NumberOfDivisions;
 
   // Initialize
-  this->Buckets->Reset();
+  buckets->Reset();
 
   // Determine the range of indices in each direction
   for (i=0; i < 3; i++)
@@ -1127,7 +1189,7 @@ void vtkCellLocator::GetOverlappingBuckets(double x[3], int vtkNotUsed(ijk)[3],
         if (this->Tree[leafStart + i + jFactor + kFactor])
           {
           nei[0]=i; nei[1]=j; nei[2]=k;
-          this->Buckets->InsertNextPoint(nei);
+          buckets->InsertNextPoint(nei);
           }
         }
       }
@@ -1595,7 +1657,7 @@ void vtkCellLocator::ClearCellHasBeenVisited(int id)
 // WARNING!!!!! Be very careful altering this routine.  Simple changes to this
 // routine can make is 25% slower!!!!
 //
-double vtkCellLocator::Distance2ToBucket(double x[3], int nei[3])
+double vtkCellLocator::Distance2ToBucket(double x[3], int nei[3]) const
 {
   double bounds[6];
 
@@ -1614,7 +1676,7 @@ double vtkCellLocator::Distance2ToBucket(double x[3], int nei[3])
 //
 // WARNING!!!!! Be very careful altering this routine.  Simple changes to this
 // routine can make it 25% slower!!!!
-double vtkCellLocator::Distance2ToBounds(double x[3], double bounds[6])
+double vtkCellLocator::Distance2ToBounds(double x[3], double bounds[6]) const
 {
   double distance;
   double deltas[3];
@@ -1666,16 +1728,28 @@ double vtkCellLocator::Distance2ToBounds(double x[3], double bounds[6])
   return distance;
 }
 //----------------------------------------------------------------------------
-bool vtkCellLocator_Inside(double bounds[6], double point[3]) {
-  if (point[0]<bounds[0] || point[0]>bounds[1] ||
-      point[1]<bounds[2] || point[1]>bounds[3] ||
-      point[2]<bounds[4] || point[2]>bounds[5]) return 0;
-  return 1;
-}
-//----------------------------------------------------------------------------
 vtkIdType vtkCellLocator::FindCell(
   double x[3], double vtkNotUsed(tol2), vtkGenericCell *cell,
   double pcoords[3], double *weights)
+{
+  this->BuildLocatorIfNeeded();
+
+  return this->FindCellInternal(x, cell, pcoords, weights);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellLocator::FindCell(
+  const double x[3], double vtkNotUsed(tol2), vtkLocatorScratch *scratch,
+  double pcoords[3], double *weights) const
+{
+  double point[3] = { x[0], x[1], x[2] };
+
+  return this->FindCellInternal(point, scratch->GetCell(), pcoords, weights);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellLocator::FindCellInternal(
+  double x[3], vtkGenericCell *cell, double pcoords[3], double *weights) const
 {
   vtkIdList *cellIds;
   int ijk[3];
@@ -1683,7 +1757,10 @@ vtkIdType vtkCellLocator::FindCell(
   double closestPoint[3], dist2;
   double cellBounds[6];
 
-  this->BuildLocatorIfNeeded();
+  if (!this->Tree)
+    {
+    return -1;
+    }
 
   int leafStart = this->NumberOfOctants
     - this->NumberOfDivisions*this->NumberOfDivisions*this->NumberOfDivisions;
@@ -1719,7 +1796,7 @@ vtkIdType vtkCellLocator::FindCell(
       // testing the cell bounds
       if (this->CacheCellBounds)
         {
-        if (this->InsideCellBounds(x, cellId))
+        if (vtkCellLocator_Inside(this->CellBounds[cellId], x))
           {
           this->DataSet->GetCell(cellId, cell);
           if (cell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights)==1)
@@ -29,8 +29,12 @@
 // for the operations described here. vtkCellLocator has been designed
 // for subclassing; so these locators can be derived if necessary.
 
+// The const FindCell(), FindClosestPoint() and IntersectWithLine() which
+// take a vtkLocatorScratch may be called from several threads at once,
+// after the locator is built.
+
 // .SECTION See Also
-// vtkLocator vtkPointLocator vtkOBBTree
+// vtkLocator vtkPointLocator vtkOBBTree vtkLocatorScratch
 
 #ifndef __vtkCellLocator_h
 #define __vtkCellLocator_h
@@ -109,6 +113,14 @@ public:
                                 int &subId, vtkIdType &cellId,
                                 vtkGenericCell *cell);
 
+  // Description:
+  // Thread-safe version of IntersectWithLine(). It does not build the
+  // locator, and finds nothing until it is built.
+  virtual int IntersectWithLine(
+    const double p1[3], const double p2[3], double tol, double& t,
+    double x[3], double pcoords[3], int &subId, vtkIdType &cellId,
+    vtkLocatorScratch *scratch) const;
+
   // Description:
   // reimplemented from vtkAbstractCellLocator to support bad compilers
   virtual void FindClosestPoint(
@@ -134,6 +146,14 @@ public:
     vtkGenericCell *cell, vtkIdType &cellId,
     int &subId, double& dist2);
 
+  // Description:
+  // Thread-safe version of FindClosestPoint(). It does not build the
+  // locator, and finds nothing until it is built.
+  virtual void FindClosestPoint(
+    const double x[3], double closestPoint[3],
+    vtkLocatorScratch *scratch, vtkIdType &cellId,
+    int &subId, double& dist2) const;
+
   // Description:
   // reimplemented from vtkAbstractCellLocator to support bad compilers
   virtual vtkIdType FindClosestPointWithinRadius(
@@ -201,6 +221,13 @@ public:
     double x[3], double tol2, vtkGenericCell *GenCell,
     double pcoords[3], double *weights);
 
+  // Description:
+  // Thread-safe version of FindCell(). It does not build the locator, and
+  // finds nothing until it is built.
+  virtual vtkIdType FindCell(
+    const double x[3], double tol2, vtkLocatorScratch *scratch,
+    double pcoords[3], double *weights) const;
+
   // Description:
   // Return a list of unique cell ids inside of a given bounding box. The
   // user must provide the vtkIdList to populate. This method returns data
@@ -229,15 +256,33 @@ protected:
   vtkCellLocator();
   ~vtkCellLocator();
 
-  void GetBucketNeighbors(int ijk[3], int ndivs, int level);
-  void GetOverlappingBuckets(double x[3], int ijk[3], double dist,
-                             int prevMinLevel[3], int prevMaxLevel[3]);
+  // Description:
+  // The queries, which neither build the locator nor keep state in it:
+  // the visited cells and the buckets to search are kept in the scratch.
+  vtkIdType FindCellInternal(double x[3], vtkGenericCell *cell,
+                             double pcoords[3], double *weights) const;
+  void FindClosestPointInternal(double x[3], double closestPoint[3],
+                                vtkGenericCell *cell,
+                                vtkLocatorScratch *scratch,
+                                vtkIdType &cellId, int &subId,
+                                double& dist2) const;
+  int IntersectWithLineInternal(double a0[3], double a1[3], double tol,
+                                double& t, double x[3], double pcoords[3],
+                                int &subId, vtkIdType &cellId,
+                                vtkGenericCell *cell,
+                                vtkLocatorScratch *scratch) const;
+
+  void GetBucketNeighbors(vtkNeighborCells *buckets,
+                          int ijk[3], int ndivs, int level) const;
+  void GetOverlappingBuckets(vtkNeighborCells *buckets,
+                             double x[3], int ijk[3], double dist,
+                             int prevMinLevel[3], int prevMaxLevel[3]) const;
 
   void ClearCellHasBeenVisited();
   void ClearCellHasBeenVisited(int id);
 
-  double Distance2ToBucket(double x[3], int nei[3]);
-  double Distance2ToBounds(double x[3], double bounds[6]);
+  double Distance2ToBucket(double x[3], int nei[3]) const;
+  double Distance2ToBounds(double x[3], double bounds[6]) const;
 
   int NumberOfOctants; // number of octants in tree
   double Bounds[6]; // bounding box root octant
@@ -257,6 +302,9 @@ protected:
   unsigned char *CellHasBeenVisited;
   unsigned char QueryNumber;
 
+  // Scratch of the queries which are not thread safe.
+  vtkLocatorScratch *Scratch;
+
   void ComputeOctantBounds(int i, int j, int k);
   double OctantBounds[6]; //the bounds of the current octant
   int IsInOctantBounds(double x[3])
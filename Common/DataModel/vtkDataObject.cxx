@@ -27,6 +27,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkInformationIntegerVectorKey.h"
 #include "vtkInformationInformationVectorKey.h"
 #include "vtkInformationStringKey.h"
+#include "vtkInformationUnsignedLongKey.h"
 #include "vtkInformationVector.h"
 #include "vtkDataSetAttributes.h"
 
@@ -36,8 +37,8 @@ vtkCxxSetObjectMacro(vtkDataObject,Information,vtkInformation);
 vtkCxxSetObjectMacro(vtkDataObject,FieldData,vtkFieldData);
 
 vtkInformationKeyMacro(vtkDataObject, DATA_TYPE_NAME, String);
-vtkInformationKeyMacro(vtkDataObject, DATA_OBJECT, DataObject);
-vtkInformationKeyMacro(vtkDataObject, DATA_EXTENT_TYPE, Integer);
+vtkInformationKeySlotMacro(vtkDataObject, DATA_OBJECT, DataObject);
+vtkInformationKeySlotMacro(vtkDataObject, DATA_EXTENT_TYPE, Integer);
 vtkInformationKeyMacro(vtkDataObject, DATA_PIECE_NUMBER, Integer);
 vtkInformationKeyMacro(vtkDataObject, DATA_NUMBER_OF_PIECES, Integer);
 vtkInformationKeyMacro(vtkDataObject, DATA_NUMBER_OF_GHOST_LEVELS, Integer);
@@ -65,6 +66,9 @@ vtkInformationKeyRestrictedMacro(vtkDataObject, SPACING, DoubleVector, 3);
 vtkInformationKeyMacro(vtkDataObject, DATA_GEOMETRY_UNMODIFIED, Integer);
 vtkInformationKeyMacro(vtkDataObject, SIL, DataObject);
 vtkInformationKeyRestrictedMacro(vtkDataObject, BOUNDING_BOX, DoubleVector, 6);
+vtkInformationKeyRestrictedMacro(vtkDataObject, DATA_MODIFIED_EXTENT, IntegerVector, 6);
+vtkInformationKeyMacro(vtkDataObject, DATA_MODIFIED_EXTENT_SINCE, UnsignedLong);
+vtkInformationKeyMacro(vtkDataObject, DATA_MODIFIED_EXTENT_MTIME, UnsignedLong);
 
 // Initialize static member that controls global data release
 // after use by filter
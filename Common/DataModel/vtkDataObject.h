@@ -46,6 +46,7 @@ class vtkInformationIntegerKey;
 class vtkInformationIntegerPointerKey;
 class vtkInformationIntegerVectorKey;
 class vtkInformationStringKey;
+class vtkInformationUnsignedLongKey;
 class vtkInformationVector;
 class vtkInformationInformationVectorKey;
 
@@ -323,6 +324,17 @@ public:
   static vtkInformationIntegerKey* DATA_GEOMETRY_UNMODIFIED();
   static vtkInformationDoubleVectorKey* BOUNDING_BOX();
 
+  // Description:
+  // Record, in the information of a data object, that the data only
+  // changed within DATA_MODIFIED_EXTENT since its modification time was
+  // DATA_MODIFIED_EXTENT_SINCE.  DATA_MODIFIED_EXTENT_MTIME is the
+  // modification time of the data when the record was made: the record
+  // is obsolete once the data is modified again.
+  // See vtkImageData::SetModifiedExtent().
+  static vtkInformationIntegerVectorKey* DATA_MODIFIED_EXTENT();
+  static vtkInformationUnsignedLongKey* DATA_MODIFIED_EXTENT_SINCE();
+  static vtkInformationUnsignedLongKey* DATA_MODIFIED_EXTENT_MTIME();
+
   // Key used to put SIL information in the output information by readers.
   static vtkInformationDataObjectKey* SIL();
 
@@ -0,0 +1,772 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkEdgePointLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkEdgePointLocator.h"
+
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkEdgePointLocator);
+
+// Points of the same edge whose parameters and coordinates differ by less
+// than this (relative) tolerance are the same point: only round-off makes
+// them differ.
+static const double vtkEdgePointLocatorTolerance = 1.0e-10;
+
+//----------------------------------------------------------------------------
+class vtkEdgePointLocatorInternals
+{
+public:
+  // A point inserted on the edge from the point P1 to P2 > P1 (or on the
+  // point P1 itself if P2 == P1).
+  struct EdgePoint
+  {
+    vtkIdType P2;
+    double T;
+    double X[3];
+    vtkIdType PointId;
+    vtkIdType Next;
+  };
+
+  // Chained hash table of the points by coordinates. The chains are linked
+  // through PointNext, indexed by point id (-2 for the ids not hashed).
+  std::vector<vtkIdType> PointHeads;
+  std::vector<vtkIdType> PointNext;
+  vtkIdType NumberOfPoints;
+
+  // The points of the edges, chained by first point id as in vtkEdgeTable,
+  // which keeps the edges of neighbouring cells close in memory.
+  std::vector<vtkIdType> EdgeHeads;
+  std::vector<EdgePoint> EdgePoints;
+
+  // When bounds are given, the points are hashed by bin of a regular grid
+  // over the bounds, so that points close in space, usually inserted one
+  // after the other, are close in the table.
+  bool Binned;
+  double Origin[3];
+  double Lengths[3];
+  double Scale[3];
+  vtkIdType Divisions[3];
+
+  vtkEdgePointLocatorInternals() : NumberOfPoints(0), Binned(false) {}
+
+  void Clear()
+    {
+    std::vector<vtkIdType>().swap(this->PointHeads);
+    std::vector<vtkIdType>().swap(this->PointNext);
+    std::vector<vtkIdType>().swap(this->EdgeHeads);
+    std::vector<EdgePoint>().swap(this->EdgePoints);
+    this->NumberOfPoints = 0;
+    this->Binned = false;
+    }
+
+  void SetBounds(const double bounds[6])
+    {
+    this->Binned = false;
+    for (int i = 0; i < 3; ++i)
+      {
+      this->Origin[i] = bounds[2*i];
+      this->Lengths[i] = bounds[2*i+1] - bounds[2*i];
+      if ( !(this->Lengths[i] >= 0.0 && this->Lengths[i] < VTK_DOUBLE_MAX) )
+        {
+        this->Binned = false;
+        return; // uninitialized or infinite bounds
+        }
+      this->Binned |= this->Lengths[i] > 0.0;
+      }
+    }
+
+  // Size the table, and the bins to about one per entry of the table.
+  void Resize(size_t size)
+    {
+    this->PointHeads.assign(size, -1);
+    if ( !this->Binned )
+      {
+      return;
+      }
+    double volume = 1.0;
+    int dimension = 0;
+    for (int i = 0; i < 3; ++i)
+      {
+      if ( this->Lengths[i] > 0.0 )
+        {
+        volume *= this->Lengths[i];
+        ++dimension;
+        }
+      }
+    double binsPerLength = pow(static_cast<double>(size) / volume,
+                               1.0 / dimension);
+    for (int i = 0; i < 3; ++i)
+      {
+      this->Divisions[i] = std::max(static_cast<vtkIdType>(1),
+        static_cast<vtkIdType>(this->Lengths[i] * binsPerLength));
+      this->Scale[i] = this->Lengths[i] > 0.0 ?
+        this->Divisions[i] / this->Lengths[i] : 0.0;
+      }
+    }
+
+  size_t Bucket(const double key[3])
+    {
+    if ( !this->Binned )
+      {
+      return HashPoint(key) & (this->PointHeads.size() - 1);
+      }
+    vtkIdType index = 0;
+    for (int i = 2; i >= 0; --i)
+      {
+      index = index * this->Divisions[i] + this->Bin(i, key[i]);
+      }
+    return static_cast<size_t>(index) % this->PointHeads.size();
+    }
+
+  // The bin index along axis i of the coordinate x, clamped to the grid.
+  vtkIdType Bin(int i, double x)
+    {
+    double bin = (x - this->Origin[i]) * this->Scale[i];
+    return !(bin > 0.0) ? 0 : bin >= this->Divisions[i] ?
+      this->Divisions[i] - 1 : static_cast<vtkIdType>(bin);
+    }
+
+  // The length of the smallest bin side.
+  double GetBinSize()
+    {
+    double size = VTK_DOUBLE_MAX;
+    for (int i = 0; i < 3; ++i)
+      {
+      if ( this->Scale[i] > 0.0 )
+        {
+        size = std::min(size, 1.0 / this->Scale[i]);
+        }
+      }
+    return size;
+    }
+
+  // The buckets of the bins that overlap the box of half size r around x,
+  // each once. Return true if these are all the buckets.
+  bool GetBuckets(const double x[3], double r, std::vector<size_t>& buckets)
+    {
+    vtkIdType lo[3], hi[3];
+    double count = 1.0;
+    bool whole = true;
+    for (int i = 0; i < 3; ++i)
+      {
+      lo[i] = this->Bin(i, x[i] - r);
+      hi[i] = this->Bin(i, x[i] + r);
+      count *= static_cast<double>(hi[i] - lo[i] + 1);
+      whole = whole && lo[i] == 0 && hi[i] == this->Divisions[i] - 1;
+      }
+    buckets.clear();
+    size_t size = this->PointHeads.size();
+    if ( whole || count >= static_cast<double>(size) )
+      {
+      for (size_t bucket = 0; bucket < size; ++bucket)
+        {
+        buckets.push_back(bucket);
+        }
+      return true;
+      }
+    for (vtkIdType k = lo[2]; k <= hi[2]; ++k)
+      {
+      for (vtkIdType j = lo[1]; j <= hi[1]; ++j)
+        {
+        for (vtkIdType i = lo[0]; i <= hi[0]; ++i)
+          {
+          vtkIdType index = i + this->Divisions[0] *
+            (j + this->Divisions[1] * k);
+          buckets.push_back(static_cast<size_t>(index) % size);
+          }
+        }
+      }
+    std::sort(buckets.begin(), buckets.end());
+    buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+    return false;
+    }
+
+  // The points hashed in the bins that overlap the box of half size r
+  // around x. Return true if these are all the points.
+  bool GetPoints(const double x[3], double r, std::vector<vtkIdType>& ptIds)
+    {
+    std::vector<size_t> buckets;
+    bool all = this->GetBuckets(x, r, buckets);
+    ptIds.clear();
+    for (size_t i = 0; i < buckets.size(); ++i)
+      {
+      for (vtkIdType ptId = this->PointHeads[buckets[i]]; ptId >= 0;
+           ptId = this->PointNext[ptId])
+        {
+        ptIds.push_back(ptId);
+        }
+      }
+    return all;
+    }
+
+  // Hash the coordinates as stored in the points, which may be floats (and
+  // then have the low bits of their mantissa null).
+  static size_t HashPoint(const double key[3])
+    {
+    vtkTypeUInt32 words[6];
+    memcpy(words, key, sizeof(words));
+    size_t h = 2166136261u;
+    for (int i = 0; i < 6; ++i)
+      {
+      h = (h ^ words[i]) * 16777619u;
+      h ^= h >> 15;
+      }
+    return h;
+    }
+};
+
+namespace
+{
+// The coordinates x in the precision of the points, with -0 turned into 0
+// so that equal coordinates hash alike. The key is hashed bitwise and -0
+// compares equal to 0, hence the explicit test: adding 0.0 would also turn
+// -0 into 0, but compilers drop it under -ffast-math (-fno-signed-zeros).
+void vtkEdgePointLocatorKey(bool isFloat, const double x[3], double key[3])
+{
+  for (int i = 0; i < 3; ++i)
+    {
+    key[i] = (isFloat ? static_cast<double>(static_cast<float>(x[i])) :
+              x[i]);
+    if (key[i] == 0.0)
+      {
+      key[i] = 0.0;
+      }
+    }
+}
+
+// Whether two points interpolated on the same edge are the same point.
+bool vtkEdgePointLocatorSamePoint(const double x[3], const double y[3])
+{
+  double scale = 0.0;
+  for (int i = 0; i < 3; ++i)
+    {
+    scale = std::max(scale, std::max(fabs(x[i]), fabs(y[i])));
+    }
+  double tol = vtkEdgePointLocatorTolerance * scale;
+  return fabs(x[0] - y[0]) <= tol && fabs(x[1] - y[1]) <= tol &&
+    fabs(x[2] - y[2]) <= tol;
+}
+
+// The closest point of ptIds to x within the squared radius r2, or -1.
+vtkIdType vtkEdgePointLocatorClosest(vtkPoints *points,
+                                     const std::vector<vtkIdType>& ptIds,
+                                     const double x[3], double r2,
+                                     double& dist2)
+{
+  vtkIdType closest = -1;
+  double y[3];
+  dist2 = VTK_DOUBLE_MAX;
+  for (size_t i = 0; i < ptIds.size(); ++i)
+    {
+    points->GetPoint(ptIds[i], y);
+    double d2 = vtkMath::Distance2BetweenPoints(x, y);
+    if ( d2 <= r2 && (d2 < dist2 || (d2 == dist2 && ptIds[i] < closest)) )
+      {
+      closest = ptIds[i];
+      dist2 = d2;
+      }
+    }
+  return closest;
+}
+
+size_t vtkEdgePointLocatorTableSize(vtkIdType estSize)
+{
+  size_t size = 1024;
+  while (static_cast<vtkIdType>(size) < estSize)
+    {
+    size *= 2;
+    }
+  return size;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkEdgePointLocator::vtkEdgePointLocator()
+{
+  this->Points = NULL;
+  this->Internals = new vtkEdgePointLocatorInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkEdgePointLocator::~vtkEdgePointLocator()
+{
+  this->Initialize();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgePointLocator::Initialize()
+{
+  if ( this->Points )
+    {
+    this->Points->UnRegister(this);
+    this->Points = NULL;
+    }
+  this->FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgePointLocator::FreeSearchStructure()
+{
+  this->Internals->Clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgePointLocator::BuildLocator()
+{
+  if ( this->DataSet )
+    {
+    this->DataSet->GetBounds(this->Bounds);
+    }
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgePointLocator::GenerateRepresentation(int, vtkPolyData *)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkEdgePointLocator::GetNumberOfSearchPoints()
+{
+  if ( this->Points )
+    {
+    return this->Points->GetNumberOfPoints();
+    }
+  return this->DataSet ? this->DataSet->GetNumberOfPoints() : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgePointLocator::GetSearchPoint(vtkIdType ptId, double x[3])
+{
+  if ( this->Points )
+    {
+    this->Points->GetPoint(ptId, x);
+    }
+  else
+    {
+    this->DataSet->GetPoint(ptId, x);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkEdgePointLocator::FindClosestPoint(const double x[3])
+{
+  double dist2;
+  return this->FindClosestPointWithinRadius(VTK_DOUBLE_MAX, x, dist2);
+}
+
+//----------------------------------------------------------------------------
+bool vtkEdgePointLocator::IsBinned()
+{
+  return this->Points && this->Internals->Binned &&
+    !this->Internals->PointHeads.empty();
+}
+
+//----------------------------------------------------------------------------
+// With bins, search boxes of bins of growing size around x until one holds
+// a point, then the box that holds the sphere through the closest of them.
+vtkIdType vtkEdgePointLocator::FindClosestPointWithinRadius(
+  double radius, const double x[3], double& dist2)
+{
+  double r2 = radius < VTK_DOUBLE_MAX ? radius * radius : VTK_DOUBLE_MAX;
+  vtkIdType closest = -1;
+  dist2 = VTK_DOUBLE_MAX;
+  if ( !this->IsBinned() )
+    {
+    double y[3];
+    vtkIdType numPts = this->GetNumberOfSearchPoints();
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+      {
+      this->GetSearchPoint(ptId, y);
+      double d2 = vtkMath::Distance2BetweenPoints(x, y);
+      if ( d2 <= r2 && d2 < dist2 )
+        {
+        closest = ptId;
+        dist2 = d2;
+        }
+      }
+    return closest;
+    }
+
+  vtkEdgePointLocatorInternals *internals = this->Internals;
+  std::vector<vtkIdType> ptIds;
+  double r = std::min(radius, internals->GetBinSize());
+  for (;;)
+    {
+    bool all = internals->GetPoints(x, r, ptIds);
+    closest = vtkEdgePointLocatorClosest(this->Points, ptIds, x, r2, dist2);
+    if ( closest >= 0 || all || r >= radius )
+      {
+      break;
+      }
+    r = std::min(radius, 2.0 * r);
+    }
+  if ( closest >= 0 && dist2 > r * r )
+    {
+    internals->GetPoints(x, sqrt(dist2), ptIds);
+    closest = vtkEdgePointLocatorClosest(this->Points, ptIds, x, r2, dist2);
+    }
+  return closest;
+}
+
+//----------------------------------------------------------------------------
+// With bins, search boxes of bins of growing size around x until they hold
+// N points, then the box that holds the sphere through the Nth closest.
+void vtkEdgePointLocator::FindClosestNPoints(int N, const double x[3],
+                                             vtkIdList *result)
+{
+  vtkEdgePointLocatorInternals *internals = this->Internals;
+  std::vector<vtkIdType> ptIds;
+  std::vector<std::pair<double, vtkIdType> > points;
+  size_t n = static_cast<size_t>(N > 0 ? N : 0);
+  bool binned = this->IsBinned();
+  if ( binned )
+    {
+    double r = internals->GetBinSize();
+    while ( !internals->GetPoints(x, r, ptIds) && ptIds.size() < n )
+      {
+      r *= 2.0;
+      }
+    }
+  else
+    {
+    vtkIdType numPts = this->GetNumberOfSearchPoints();
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+      {
+      ptIds.push_back(ptId);
+      }
+    }
+
+  double y[3];
+  for (int pass = 0; pass < 2; ++pass)
+    {
+    points.clear();
+    points.reserve(ptIds.size());
+    for (size_t i = 0; i < ptIds.size(); ++i)
+      {
+      this->GetSearchPoint(ptIds[i], y);
+      points.push_back(
+        std::make_pair(vtkMath::Distance2BetweenPoints(x, y), ptIds[i]));
+      }
+    n = std::min(n, points.size());
+    std::partial_sort(points.begin(), points.begin() + n, points.end());
+    if ( !binned || n == 0 || pass == 1 )
+      {
+      break;
+      }
+    internals->GetPoints(x, sqrt(points[n-1].first), ptIds);
+    }
+
+  result->Reset();
+  for (size_t i = 0; i < n; ++i)
+    {
+    result->InsertNextId(points[i].second);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgePointLocator::FindPointsWithinRadius(double R, const double x[3],
+                                                 vtkIdList *result)
+{
+  double y[3];
+  double R2 = R * R;
+  result->Reset();
+  if ( this->IsBinned() )
+    {
+    std::vector<vtkIdType> ptIds;
+    this->Internals->GetPoints(x, R, ptIds);
+    std::sort(ptIds.begin(), ptIds.end());
+    for (size_t i = 0; i < ptIds.size(); ++i)
+      {
+      this->Points->GetPoint(ptIds[i], y);
+      if ( vtkMath::Distance2BetweenPoints(x, y) <= R2 )
+        {
+        result->InsertNextId(ptIds[i]);
+        }
+      }
+    return;
+    }
+
+  vtkIdType numPts = this->GetNumberOfSearchPoints();
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+    this->GetSearchPoint(ptId, y);
+    if ( vtkMath::Distance2BetweenPoints(x, y) <= R2 )
+      {
+      result->InsertNextId(ptId);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkEdgePointLocator::FindClosestInsertedPoint(const double x[3])
+{
+  return this->Points ? this->FindClosestPoint(x) : -1;
+}
+
+//----------------------------------------------------------------------------
+int vtkEdgePointLocator::InitPointInsertion(vtkPoints *newPts,
+                                            const double bounds[6])
+{
+  return this->InitPointInsertion(newPts, bounds, 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkEdgePointLocator::InitPointInsertion(vtkPoints *newPts,
+                                            const double bounds[6],
+                                            vtkIdType estSize)
+{
+  if ( newPts == NULL )
+    {
+    vtkErrorMacro(<<"Must define points for point insertion");
+    return 0;
+    }
+
+  this->Initialize();
+  this->Points = newPts;
+  this->Points->Register(this);
+  if ( bounds )
+    {
+    for (int i = 0; i < 6; ++i)
+      {
+      this->Bounds[i] = bounds[i];
+      }
+    }
+
+  // Hash the points already there.
+  vtkIdType numPts = newPts->GetNumberOfPoints();
+  size_t size = vtkEdgePointLocatorTableSize(std::max(estSize, numPts));
+  if ( bounds )
+    {
+    this->Internals->SetBounds(bounds);
+    }
+  this->Internals->Resize(size);
+  double x[3];
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+    newPts->GetPoint(ptId, x);
+    this->AddPoint(ptId, x);
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgePointLocator::AddPoint(vtkIdType ptId, const double x[3])
+{
+  vtkEdgePointLocatorInternals *internals = this->Internals;
+  vtkDataArray *data = this->Points->GetData();
+  bool isFloat = data->GetDataType() == VTK_FLOAT;
+
+  // Grow the table, rehashing the points, to keep the chains short.
+  if ( internals->NumberOfPoints >=
+       static_cast<vtkIdType>(internals->PointHeads.size()) )
+    {
+    size_t size = std::max(static_cast<size_t>(1024),
+                           4 * internals->PointHeads.size());
+    internals->Resize(size);
+    double key[3];
+    for (vtkIdType i = 0;
+         i < static_cast<vtkIdType>(internals->PointNext.size()); ++i)
+      {
+      if ( internals->PointNext[i] != -2 )
+        {
+        data->GetTuple(i, key);
+        vtkEdgePointLocatorKey(isFloat, key, key);
+        size_t bucket = internals->Bucket(key);
+        internals->PointNext[i] = internals->PointHeads[bucket];
+        internals->PointHeads[bucket] = i;
+        }
+      }
+    }
+
+  if ( ptId >= static_cast<vtkIdType>(internals->PointNext.size()) )
+    {
+    internals->PointNext.resize(
+      std::max(static_cast<size_t>(ptId + 1), 2 * internals->PointNext.size()),
+      -2);
+    }
+  else if ( internals->PointNext[ptId] != -2 )
+    {
+    return; // already hashed, a point overwritten by InsertPoint()
+    }
+
+  double key[3];
+  vtkEdgePointLocatorKey(isFloat, x, key);
+  size_t bucket = internals->Bucket(key);
+  internals->PointNext[ptId] = internals->PointHeads[bucket];
+  internals->PointHeads[bucket] = ptId;
+  ++internals->NumberOfPoints;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkEdgePointLocator::IsInsertedPoint(const double x[3])
+{
+  vtkEdgePointLocatorInternals *internals = this->Internals;
+  if ( !this->Points || internals->PointHeads.empty() )
+    {
+    return -1;
+    }
+
+  vtkDataArray *data = this->Points->GetData();
+  bool isFloat = data->GetDataType() == VTK_FLOAT;
+  double key[3];
+  vtkEdgePointLocatorKey(isFloat, x, key);
+  size_t bucket = internals->Bucket(key);
+  vtkIdType ptId = internals->PointHeads[bucket];
+
+  // For efficiency, compare float points in place, as vtkMergePoints does.
+  if ( isFloat )
+    {
+    float *pts = static_cast<vtkFloatArray *>(data)->GetPointer(0);
+    for ( ; ptId >= 0; ptId = internals->PointNext[ptId] )
+      {
+      float *pt = pts + 3 * ptId;
+      if ( key[0] == pt[0] && key[1] == pt[1] && key[2] == pt[2] )
+        {
+        return ptId;
+        }
+      }
+    }
+  else
+    {
+    double pt[3];
+    for ( ; ptId >= 0; ptId = internals->PointNext[ptId] )
+      {
+      data->GetTuple(ptId, pt);
+      if ( key[0] == pt[0] && key[1] == pt[1] && key[2] == pt[2] )
+        {
+        return ptId;
+        }
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+int vtkEdgePointLocator::InsertUniquePoint(const double x[3],
+                                           vtkIdType &ptId)
+{
+  if ( (ptId = this->IsInsertedPoint(x)) >= 0 )
+    {
+    return 0;
+    }
+  ptId = this->InsertNextPoint(x);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkEdgePointLocator::InsertUniqueEdgePoint(vtkIdType p1, vtkIdType p2,
+                                               double t, const double x[3],
+                                               vtkIdType &ptId)
+{
+  vtkEdgePointLocatorInternals *internals = this->Internals;
+  if ( !this->Points || p1 < 0 || p2 < 0 )
+    {
+    return this->InsertUniquePoint(x, ptId);
+    }
+
+  // The end points of the edge are keyed as points, and the other points
+  // by edge ordered by increasing point ids.
+  if ( t <= 0.0 || p1 == p2 )
+    {
+    p2 = p1;
+    t = 0.0;
+    }
+  else if ( t >= 1.0 )
+    {
+    p1 = p2;
+    t = 0.0;
+    }
+  else if ( p1 > p2 )
+    {
+    std::swap(p1, p2);
+    t = 1.0 - t;
+    }
+
+  if ( p1 >= static_cast<vtkIdType>(internals->EdgeHeads.size()) )
+    {
+    internals->EdgeHeads.resize(
+      std::max(static_cast<size_t>(p1 + 1), 2 * internals->EdgeHeads.size()),
+      -1);
+    }
+  for (vtkIdType i = internals->EdgeHeads[p1]; i >= 0;
+       i = internals->EdgePoints[i].Next)
+    {
+    const vtkEdgePointLocatorInternals::EdgePoint& e =
+      internals->EdgePoints[i];
+    if ( e.P2 == p2 && fabs(e.T - t) <= vtkEdgePointLocatorTolerance &&
+         vtkEdgePointLocatorSamePoint(e.X, x) )
+      {
+      ptId = e.PointId;
+      return 0;
+      }
+    }
+
+  // Not on the edge yet: merge it with a point of the same coordinates, or
+  // insert it.
+  int inserted = this->InsertUniquePoint(x, ptId);
+
+  vtkEdgePointLocatorInternals::EdgePoint e;
+  e.P2 = p2;
+  e.T = t;
+  e.X[0] = x[0];
+  e.X[1] = x[1];
+  e.X[2] = x[2];
+  e.PointId = ptId;
+  e.Next = internals->EdgeHeads[p1];
+  internals->EdgeHeads[p1] =
+    static_cast<vtkIdType>(internals->EdgePoints.size());
+  internals->EdgePoints.push_back(e);
+
+  return inserted;
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgePointLocator::InsertPoint(vtkIdType ptId, const double x[3])
+{
+  this->Points->InsertPoint(ptId, x);
+  this->AddPoint(ptId, x);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkEdgePointLocator::InsertNextPoint(const double x[3])
+{
+  vtkIdType ptId = this->Points->InsertNextPoint(x);
+  this->AddPoint(ptId, x);
+  return ptId;
+}
+
+//----------------------------------------------------------------------------
+void vtkEdgePointLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Points: " << this->Points << "\n";
+  os << indent << "Number Of Edge Points: "
+     << this->Internals->EdgePoints.size() << "\n";
+}
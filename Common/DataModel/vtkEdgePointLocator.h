@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkEdgePointLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkEdgePointLocator - merge the points generated on the edges of cells
+// .SECTION Description
+// vtkEdgePointLocator is an incremental point locator meant for filters
+// that contour or clip cells, such as vtkCutter, vtkClipDataSet and
+// vtkClipPolyData. The cells insert the points they interpolate along
+// their edges with InsertUniqueEdgePoint(), and the locator first looks
+// the point up by edge, that is by pair of point ids and interpolation
+// parameter, in a table indexed by point id. Points at the ends of an edge
+// are looked up by the id of that end point. Unlike vtkMergePoints it
+// needs no bounds (they only make its hash table of coordinates more cache
+// friendly).
+//
+// A point is merged with a point inserted before on the same edge when
+// their parameters differ by at most 1e-10 and their coordinates by at
+// most 1e-10 times the largest coordinate, so that the points generated on
+// an edge by neighbouring cells are merged despite round-off. Otherwise,
+// as for the points inserted with InsertUniquePoint() and the points of an
+// edge given invalid ids, the point is merged with any point inserted
+// before, on whatever edge, of exactly the same coordinates, as
+// vtkMergePoints does. Points of different edges that are close but not
+// equal are never merged. As sub-cells of some cells are not numbered with
+// the point ids of the dataset, points of the same edge are only merged if
+// they lie at the same place.
+//
+// .SECTION Caveats
+// The locator is meant for point insertion. The location methods search
+// the bins of the hash table of the inserted points when bounds were given
+// to InitPointInsertion(). Otherwise, and before the point insertion, they
+// are linear searches, in O(N) of the number of points.
+//
+// .SECTION See Also
+// vtkMergePoints vtkIncrementalPointLocator vtkEdgeTable
+
+#ifndef __vtkEdgePointLocator_h
+#define __vtkEdgePointLocator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkIncrementalPointLocator.h"
+
+class vtkPoints;
+class vtkIdList;
+class vtkEdgePointLocatorInternals;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkEdgePointLocator : public vtkIncrementalPointLocator
+{
+public:
+  static vtkEdgePointLocator *New();
+  vtkTypeMacro(vtkEdgePointLocator,vtkIncrementalPointLocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Delete the hash tables and release the points.
+  virtual void Initialize();
+  virtual void FreeSearchStructure();
+
+  // Description:
+  // There is no search structure to build: location methods search the
+  // inserted points, or the points of the dataset if no point insertion was
+  // initialized.
+  virtual void BuildLocator();
+
+  // Description:
+  // Not implemented, the representation is empty.
+  virtual void GenerateRepresentation(int level, vtkPolyData *pd);
+
+  // Description:
+  // Location methods. They search the bins of the inserted points if the
+  // point insertion was given bounds, else all the points.
+  virtual vtkIdType FindClosestPoint(const double x[3]);
+  virtual vtkIdType FindClosestPointWithinRadius(double radius,
+                                                 const double x[3],
+                                                 double& dist2);
+  virtual void FindClosestNPoints(int N, const double x[3],
+                                  vtkIdList *result);
+  virtual void FindPointsWithinRadius(double R, const double x[3],
+                                      vtkIdList *result);
+  virtual vtkIdType FindClosestInsertedPoint(const double x[3]);
+
+//BTX
+  // Description:
+  // Include the thread-safe queries of vtkAbstractPointLocator, which the
+  // queries above hide.
+  using vtkAbstractPointLocator::FindClosestPoint;
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
+//ETX
+
+  // Description:
+  // Initialize the point insertion into newPts. The bounds may be empty or
+  // not contain all the points: they are only used to hash the coordinates.
+  // The estimated size is used to size the hash table.
+  virtual int InitPointInsertion(vtkPoints *newPts, const double bounds[6]);
+  virtual int InitPointInsertion(vtkPoints *newPts, const double bounds[6],
+                                 vtkIdType estSize);
+
+  // Description:
+  // Return the id of the inserted point with exactly the coordinates x,
+  // or -1.
+  virtual vtkIdType IsInsertedPoint(double x, double y, double z)
+    {
+    double xyz[3];
+    xyz[0] = x; xyz[1] = y; xyz[2] = z;
+    return this->IsInsertedPoint(xyz);
+    }
+  virtual vtkIdType IsInsertedPoint(const double x[3]);
+
+  // Description:
+  // Insert the point x unless a point with exactly the same coordinates was
+  // inserted before. Return 1 if the point was inserted, else 0, and the id
+  // of the point in ptId.
+  virtual int InsertUniquePoint(const double x[3], vtkIdType &ptId);
+
+  // Description:
+  // Insert the point x interpolated at parameter t along the edge from p1
+  // to p2, unless the same point of the edge, or a point with exactly the
+  // same coordinates, was inserted before. Return 1 if the point was
+  // inserted, else 0, and the id of the point in ptId.
+  virtual int InsertUniqueEdgePoint(vtkIdType p1, vtkIdType p2, double t,
+                                    const double x[3], vtkIdType &ptId);
+
+  // Description:
+  // Insert the point x with the id ptId, or at the end of the points,
+  // without checking for duplicates.
+  virtual void InsertPoint(vtkIdType ptId, const double x[3]);
+  virtual vtkIdType InsertNextPoint(const double x[3]);
+
+protected:
+  vtkEdgePointLocator();
+  ~vtkEdgePointLocator();
+
+  vtkPoints *Points;
+  vtkEdgePointLocatorInternals *Internals;
+
+  // Add the point ptId, of coordinates x, to the hash table of coordinates.
+  void AddPoint(vtkIdType ptId, const double x[3]);
+
+  // Whether the inserted points are hashed by bins that the location
+  // methods can search.
+  bool IsBinned();
+
+  // The points searched by the location methods: the inserted points, or
+  // else the points of the dataset.
+  vtkIdType GetNumberOfSearchPoints();
+  void GetSearchPoint(vtkIdType ptId, double x[3]);
+
+private:
+  vtkEdgePointLocator(const vtkEdgePointLocator&);  // Not implemented.
+  void operator=(const vtkEdgePointLocator&);  // Not implemented.
+};
+
+#endif
@@ -335,6 +335,115 @@ int vtkExtentTranslator::SplitExtentByPoints(int piece, int numPieces,
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkExtentTranslator::ComputeBricks(const int extent[6],
+                                       vtkIdType maxPoints,
+                                       const int minSize[3], int splitMode,
+                                       int bricks[3])
+{
+  int size[3], maxBricks[3];
+  vtkIdType numPoints = 1;
+  int axis;
+  bricks[0] = bricks[1] = bricks[2] = 1;
+  for (axis = 0; axis < 3; ++axis)
+    {
+    size[axis] = extent[2*axis+1] - extent[2*axis] + 1;
+    if (size[axis] <= 0)
+      {
+      return 0;
+      }
+    numPoints *= size[axis];
+    maxBricks[axis] = minSize[axis] > 1 ? size[axis] / minSize[axis] :
+      size[axis];
+    if (maxBricks[axis] < 1)
+      {
+      maxBricks[axis] = 1;
+      }
+    }
+
+  if (maxPoints < 1)
+    {
+    maxPoints = 1;
+    }
+  vtkIdType numBricks = (numPoints + maxPoints - 1) / maxPoints;
+  if (numBricks > VTK_INT_MAX)
+    {
+    numBricks = VTK_INT_MAX;
+    }
+
+  if (splitMode >= vtkExtentTranslator::X_SLAB_MODE &&
+      splitMode <= vtkExtentTranslator::Z_SLAB_MODE)
+    {
+    // divide each axis in turn, as much as needed or possible
+    int order[3] = { splitMode, 2, 1 };
+    if (splitMode == 2)
+      {
+      order[1] = 1;
+      order[2] = 0;
+      }
+    else if (splitMode == 1)
+      {
+      order[2] = 0;
+      }
+    vtkIdType others = 1;
+    for (int i = 0; i < 3; ++i)
+      {
+      axis = order[i];
+      vtkIdType n = (numBricks + others - 1) / others;
+      bricks[axis] = n < maxBricks[axis] ? static_cast<int>(n) :
+        maxBricks[axis];
+      others *= bricks[axis];
+      }
+    }
+  else
+    {
+    // divide the axis along which the bricks are longest, one more
+    // brick at a time
+    vtkIdType total = 1;
+    while (total < numBricks)
+      {
+      int splitAxis = -1;
+      double longest = 0.0;
+      for (axis = 2; axis >= 0; --axis)
+        {
+        double length = static_cast<double>(size[axis]) / bricks[axis];
+        if (bricks[axis] < maxBricks[axis] && length > longest)
+          {
+          splitAxis = axis;
+          longest = length;
+          }
+        }
+      if (splitAxis < 0)
+        {
+        break;
+        }
+      total = total / bricks[splitAxis] * (bricks[splitAxis] + 1);
+      ++bricks[splitAxis];
+      }
+    }
+
+  return bricks[0] * bricks[1] * bricks[2];
+}
+
+//----------------------------------------------------------------------------
+void vtkExtentTranslator::BrickToExtent(int brick, const int extent[6],
+                                        const int bricks[3],
+                                        int resultExtent[6])
+{
+  int index[3];
+  index[0] = brick % bricks[0];
+  index[1] = (brick / bricks[0]) % bricks[1];
+  index[2] = brick / (bricks[0] * bricks[1]);
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    vtkIdType size = extent[2*axis+1] - extent[2*axis] + 1;
+    resultExtent[2*axis] = extent[2*axis] +
+      static_cast<int>(size * index[axis] / bricks[axis]);
+    resultExtent[2*axis+1] = extent[2*axis] +
+      static_cast<int>(size * (index[axis] + 1) / bricks[axis]) - 1;
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkExtentTranslator::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -90,6 +90,34 @@ public:
   // use this to tell the translator which dimensions to split.
   void SetSplitPath(int len, int *splitpath);
 
+  // Description:
+  // Divide an extent into a regular grid of bricks, e.g. to process it
+  // in many small pieces that fit in cache.  ComputeBricks() computes
+  // the number of bricks along each axis so that each brick has at most
+  // maxPoints points (when possible) and no fewer than minSize points
+  // along each axis.  The slab modes divide the given axis first, then
+  // the others from z to x; block mode divides the axis along which the
+  // bricks are longest, keeping the x axis, which is contiguous in
+  // memory, for last.  It returns the number of bricks.
+  // BrickToExtent() gets the point extent of a brick, numbered with x
+  // varying fastest; the bricks do not overlap.  Both are thread safe.
+  static int ComputeBricks(const int extent[6], vtkIdType maxPoints,
+                           const int minSize[3], int splitMode,
+                           int bricks[3]);
+  static void BrickToExtent(int brick, const int extent[6],
+                            const int bricks[3], int resultExtent[6]);
+
+//BTX
+  // Don't change the numbers here - they are used in the code
+  // to indicate array indices.
+  enum Modes {
+    X_SLAB_MODE=0,
+    Y_SLAB_MODE=1,
+    Z_SLAB_MODE=2,
+    BLOCK_MODE= 3
+  };
+//ETX
+
 protected:
   vtkExtentTranslator();
   ~vtkExtentTranslator();
@@ -112,17 +140,6 @@ protected:
   int* SplitPath;
   int SplitLen;
 
-//BTX
-  // Don't change the numbers here - they are used in the code
-  // to indicate array indices.
-  enum Modes {
-    X_SLAB_MODE=0,
-    Y_SLAB_MODE=1,
-    Z_SLAB_MODE=2,
-    BLOCK_MODE= 3
-  };
-//ETX
-
 private:
   vtkExtentTranslator(const vtkExtentTranslator&);  // Not implemented.
   void operator=(const vtkExtentTranslator&);  // Not implemented.
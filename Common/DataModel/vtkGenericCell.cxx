@@ -58,13 +58,24 @@ vtkStandardNewMacro(vtkGenericCell);
 // Construct cell.
 vtkGenericCell::vtkGenericCell()
 {
+  for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; i++)
+    {
+    this->CellStore[i] = NULL;
+    }
   this->Cell = vtkEmptyCell::New();
+  this->CellStore[VTK_EMPTY_CELL] = this->Cell;
 }
 
 //----------------------------------------------------------------------------
 vtkGenericCell::~vtkGenericCell()
 {
-  this->Cell->Delete();
+  for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; i++)
+    {
+    if (this->CellStore[i])
+      {
+      this->CellStore[i]->Delete();
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -359,14 +370,22 @@ void vtkGenericCell::SetCellType(int cellType)
     this->Points->UnRegister(this);
     this->PointIds->UnRegister(this);
     this->PointIds = NULL;
-    this->Cell->Delete();
 
-    vtkCell *cell = vtkGenericCell::InstantiateCell(cellType);
+    vtkCell *cell = NULL;
+    if ( cellType >= 0 && cellType < VTK_NUMBER_OF_CELL_TYPES )
+      {
+      cell = this->CellStore[cellType];
+      if ( !cell )
+        {
+        cell = vtkGenericCell::InstantiateCell(cellType);
+        this->CellStore[cellType] = cell;
+        }
+      }
 
     if( !cell )
       {
       vtkErrorMacro( << "Unsupported cell type! Setting to vtkEmptyCell" );
-      cell = vtkEmptyCell::New();
+      cell = this->CellStore[VTK_EMPTY_CELL];
       }
 
     this->Cell = cell;
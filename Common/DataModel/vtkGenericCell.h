@@ -92,7 +92,8 @@ public:
   // method. It allows vtkGenericCell to act like any cell type by
   // dereferencing an internal instance of a concrete cell type. When
   // you set the cell type, you are resetting a pointer to an internal
-  // cell which is then used for computation.
+  // cell which is then used for computation. The internal cells are
+  // kept for reuse until the generic cell is deleted.
   void SetCellType(int cellType);
   void SetCellTypeToEmptyCell() {this->SetCellType(VTK_EMPTY_CELL);}
   void SetCellTypeToVertex() {this->SetCellType(VTK_VERTEX);}
@@ -142,6 +143,10 @@ protected:
 
   vtkCell *Cell;
 
+  // The cells instantiated so far, indexed by cell type, so that going
+  // back and forth between cell types does not create and delete cells.
+  vtkCell *CellStore[VTK_NUMBER_OF_CELL_TYPES];
+
 private:
   vtkGenericCell(const vtkGenericCell&);  // Not implemented.
   void operator=(const vtkGenericCell&);  // Not implemented.
@@ -19,6 +19,8 @@
 #include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationUnsignedLongKey.h"
 #include "vtkInformationVector.h"
 #include "vtkLargeInteger.h"
 #include "vtkLine.h"
@@ -58,6 +60,8 @@ vtkImageData::vtkImageData()
 
   this->Information->Set(vtkDataObject::DATA_EXTENT_TYPE(), VTK_3D_EXTENT);
   this->Information->Set(vtkDataObject::DATA_EXTENT(), this->Extent, 6);
+
+  this->ModifiedExtentQueried = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -1888,6 +1892,85 @@ void vtkImageData::SetExtent(int *extent)
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkImageData::MarkModifiedExtent(int extent[6])
+{
+  int modifiedExtent[6];
+  memcpy(modifiedExtent, extent, 6*sizeof(int));
+  unsigned long since = this->GetMTime();
+
+  // Merge with the extent marked since the data was last modified,
+  // unless the pipeline already got it.
+  vtkInformation* info = this->GetInformation();
+  int previousExtent[6];
+  if (!this->ModifiedExtentQueried &&
+      info->Has(vtkDataObject::DATA_MODIFIED_EXTENT_SINCE()) &&
+      this->GetModifiedExtent(
+        info->Get(vtkDataObject::DATA_MODIFIED_EXTENT_SINCE()),
+        previousExtent))
+    {
+    since = info->Get(vtkDataObject::DATA_MODIFIED_EXTENT_SINCE());
+    if (previousExtent[0] <= previousExtent[1] &&
+        previousExtent[2] <= previousExtent[3] &&
+        previousExtent[4] <= previousExtent[5])
+      {
+      if (modifiedExtent[0] > modifiedExtent[1] ||
+          modifiedExtent[2] > modifiedExtent[3] ||
+          modifiedExtent[4] > modifiedExtent[5])
+        {
+        memcpy(modifiedExtent, previousExtent, 6*sizeof(int));
+        }
+      else
+        {
+        for (int i = 0; i < 3; ++i)
+          {
+          if (previousExtent[2*i] < modifiedExtent[2*i])
+            {
+            modifiedExtent[2*i] = previousExtent[2*i];
+            }
+          if (previousExtent[2*i+1] > modifiedExtent[2*i+1])
+            {
+            modifiedExtent[2*i+1] = previousExtent[2*i+1];
+            }
+          }
+        }
+      }
+    }
+
+  this->Modified();
+  this->SetModifiedExtent(modifiedExtent, since);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageData::SetModifiedExtent(int extent[6], unsigned long since)
+{
+  vtkInformation* info = this->GetInformation();
+  info->Set(vtkDataObject::DATA_MODIFIED_EXTENT(), extent, 6);
+  info->Set(vtkDataObject::DATA_MODIFIED_EXTENT_SINCE(), since);
+  info->Set(vtkDataObject::DATA_MODIFIED_EXTENT_MTIME(), this->GetMTime());
+  this->ModifiedExtentQueried = 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageData::GetModifiedExtent(unsigned long since, int extent[6])
+{
+  // The record is obsolete if the data was modified since it was made,
+  // and does not cover the changes made before it started.
+  vtkInformation* info = this->GetInformation();
+  if (!info->Has(vtkDataObject::DATA_MODIFIED_EXTENT()) ||
+      !info->Has(vtkDataObject::DATA_MODIFIED_EXTENT_SINCE()) ||
+      !info->Has(vtkDataObject::DATA_MODIFIED_EXTENT_MTIME()) ||
+      info->Get(vtkDataObject::DATA_MODIFIED_EXTENT_SINCE()) > since ||
+      info->Get(vtkDataObject::DATA_MODIFIED_EXTENT_MTIME()) !=
+      this->GetMTime())
+    {
+    return 0;
+    }
+  info->Get(vtkDataObject::DATA_MODIFIED_EXTENT(), extent);
+  this->ModifiedExtentQueried = 1;
+  return 1;
+}
+
 
 
 //----------------------------------------------------------------------------
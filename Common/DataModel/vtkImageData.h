@@ -171,6 +171,27 @@ public:
   virtual void SetExtent(int x1, int x2, int y1, int y2, int z1, int z2);
   vtkGetVector6Macro(Extent, int);
 
+  // Description:
+  // Mark the data as modified, recording that only the given extent
+  // changed, e.g. after editing some voxels in place.  Call it instead
+  // of Modified(), once the voxels are edited.  The extents marked
+  // before the pipeline gets them are merged.  The algorithms
+  // downstream that support it then only recompute the part of their
+  // outputs that depends on this extent (see vtkThreadedImageAlgorithm).
+  void MarkModifiedExtent(int extent[6]);
+
+  // Description:
+  // Record that the data only changed within the given extent since its
+  // modification time was since, without modifying it.  Algorithms
+  // call it on their outputs once they recomputed part of them.
+  void SetModifiedExtent(int extent[6], unsigned long since);
+
+  // Description:
+  // Get an extent that contains all the changes made to the data since
+  // its modification time was since and return 1, or return 0 if that
+  // is not known.  The extent may be empty.
+  int GetModifiedExtent(unsigned long since, int extent[6]);
+
   // Description:
   // These returns the minimum and maximum values the ScalarType can hold
   // without overflowing.
@@ -366,6 +387,9 @@ protected:
 
   int Extent[6];
 
+  // Whether the modified extent was got since it was last set.
+  int ModifiedExtentQueried;
+
   // The first method assumes Active Scalars
   void ComputeIncrements();
   // This one is given the number of components of the
@@ -184,6 +184,14 @@ public:
   virtual void FindPointsWithinRadius
     ( double R, const double x[3], vtkIdList * result );
 
+//BTX
+  // Description:
+  // Include the thread-safe queries of vtkAbstractPointLocator, which the
+  // queries above hide.
+  using vtkAbstractPointLocator::FindClosestPoint;
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
+//ETX
+
   // Description:
   // Find all points within a squared radius R2 relative to a given point x. The
   // returned point ids (stored in result) are not sorted in any way. BuildLocator()
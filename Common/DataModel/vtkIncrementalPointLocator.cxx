@@ -25,6 +25,12 @@ vtkIncrementalPointLocator::~vtkIncrementalPointLocator()
 {
 }
 
+int vtkIncrementalPointLocator::InsertUniqueEdgePoint( vtkIdType,
+  vtkIdType, double, const double x[3], vtkIdType & ptId )
+{
+  return this->InsertUniquePoint( x, ptId );
+}
+
 void vtkIncrementalPointLocator::PrintSelf( ostream & os, vtkIndent indent )
 {
   this->Superclass::PrintSelf( os, indent );
@@ -107,6 +107,17 @@ public:
   // This method is not thread safe.
   virtual int InsertUniquePoint( const double x[3], vtkIdType & ptId ) = 0;
 
+  // Description:
+  // Insert the point x interpolated at parameter t along the edge from point
+  // p1 to point p2 (p1 == p2 and t == 0 for the point p1 itself), unless it
+  // has been inserted before. Return 1 if the point was inserted, else 0, and
+  // the id of the point in ptId. Cells call this method when they contour or
+  // clip, so that locators such as vtkEdgePointLocator can merge the points
+  // by edge instead of by coordinates. By default the edge is ignored and
+  // InsertUniquePoint() is called. This method is not thread safe.
+  virtual int InsertUniqueEdgePoint( vtkIdType p1, vtkIdType p2, double t,
+                                     const double x[3], vtkIdType & ptId );
+
   // Description:
   // Insert a given point with a specified point index ptId. InitPointInsertion()
   // should have been called prior to this function. Also, IsInsertedPoint()
@@ -2197,12 +2197,41 @@ vtkIdType vtkKdTree::FindClosestPoint(double x, double y, double z, double &dist
     return -1;
     }
 
+  int *regionIds = new int [this->NumberOfRegions];
+
+  vtkIdType closePointId = this->FindClosestPoint(x, y, z, dist2, regionIds);
+
+  delete [] regionIds;
+
+  return closePointId;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkKdTree::FindClosestPoint(const double x[3], double &dist2,
+                                      vtkIntArray *regionIds) const
+{
+  if (!this->LocatorPoints)
+    {
+    return -1;
+    }
+
+  regionIds->SetNumberOfComponents(1);
+  regionIds->SetNumberOfTuples(this->NumberOfRegions);
+
+  return this->FindClosestPoint(x[0], x[1], x[2], dist2,
+                                regionIds->GetPointer(0));
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkKdTree::FindClosestPoint(double x, double y, double z,
+                                      double &dist2, int *regionIds) const
+{
   double minDistance2 = 0.0;
 
   int closeId=-1, newCloseId=-1;
   double newDistance2 = 4 * this->MaxWidth * this->MaxWidth;
 
-  int regionId = this->GetRegionContainingPoint(x, y, z);
+  int regionId = vtkKdTree::findRegion(this->Top, x, y, z);
 
   if (regionId < 0)
     {
@@ -2244,7 +2273,7 @@ vtkIdType vtkKdTree::FindClosestPoint(double x, double y, double z, double &dist
       pt[2] = max[2] - this->FudgeFactor;
       }
 
-    regionId = this->GetRegionContainingPoint(pt[0], pt[1], pt[2]);
+    regionId = vtkKdTree::findRegion(this->Top, pt[0], pt[1], pt[2]);
 
     closeId = this->_FindClosestPointInRegion(regionId,
                                               x, y, z,
@@ -2256,7 +2285,8 @@ vtkIdType vtkKdTree::FindClosestPoint(double x, double y, double z, double &dist
       this->FindClosestPointInSphere(x, y, z,
                                      sqrt(minDistance2),    // radius
                                      regionId,        // skip this region
-                                     newDistance2);   // distance to closest point
+                                     newDistance2,    // distance to closest point
+                                     regionIds);
 
     }
   else     // Point is inside a k-d tree region
@@ -2276,7 +2306,8 @@ vtkIdType vtkKdTree::FindClosestPoint(double x, double y, double z, double &dist
         newCloseId = this->FindClosestPointInSphere(x, y, z,
                                                     sqrt(minDistance2),   // radius
                                                     regionId,       // skip this region
-                                                    newDistance2);
+                                                    newDistance2,
+                                                    regionIds);
         }
       }
     }
@@ -2338,7 +2369,7 @@ vtkIdType vtkKdTree::FindClosestPointInRegion(int regionId,
 
 //----------------------------------------------------------------------------
 int vtkKdTree::_FindClosestPointInRegion(int regionId,
-                                     double x, double y, double z, double &dist2)
+                                     double x, double y, double z, double &dist2) const
 {
   int minId=0;
 
@@ -2394,12 +2425,48 @@ int vtkKdTree::FindClosestPointInSphere(double x, double y, double z,
     }
   int *regionIds = new int [this->NumberOfRegions];
 
-  this->BSPCalculator->ComputeIntersectionsUsingDataBoundsOn();
+  int localCloseId = this->FindClosestPointInSphere(x, y, z, radius,
+                                                    skipRegion, dist2,
+                                                    regionIds);
 
-  int nRegions =
-    this->BSPCalculator->IntersectsSphere2(regionIds, this->NumberOfRegions, x, y, z, radius*radius);
+  delete [] regionIds;
 
-  this->BSPCalculator->ComputeIntersectionsUsingDataBoundsOff();
+  return localCloseId;
+}
+
+//----------------------------------------------------------------------------
+// Find the regions whose data bounds intersect the sphere, as
+// vtkBSPIntersections::IntersectsSphere2() does with
+// ComputeIntersectionsUsingDataBounds on, but without modifying the tree.
+static int vtkKdTreeRegionsInSphere(vtkKdNode *node, int *ids,
+                                    double x, double y, double z,
+                                    double rSquared)
+{
+  if (!node->IntersectsSphere2(x, y, z, rSquared, 1))
+    {
+    return 0;
+    }
+
+  if (node->GetLeft() == NULL)
+    {
+    ids[0] = node->GetID();
+    return 1;
+    }
+
+  int nnodes = vtkKdTreeRegionsInSphere(node->GetLeft(), ids,
+                                        x, y, z, rSquared);
+
+  return nnodes + vtkKdTreeRegionsInSphere(node->GetRight(), ids + nnodes,
+                                           x, y, z, rSquared);
+}
+
+//----------------------------------------------------------------------------
+int vtkKdTree::FindClosestPointInSphere(double x, double y, double z,
+                                        double radius, int skipRegion,
+                                        double &dist2, int *regionIds) const
+{
+  int nRegions =
+    vtkKdTreeRegionsInSphere(this->Top, regionIds, x, y, z, radius*radius);
 
   double minDistance2 = 4 * this->MaxWidth * this->MaxWidth;
   int localCloseId = -1;
@@ -2430,8 +2497,6 @@ int vtkKdTree::FindClosestPointInSphere(double x, double y, double z,
       }
     }
 
-  delete [] regionIds;
-
   dist2 = minDistance2;
   return localCloseId;
 }
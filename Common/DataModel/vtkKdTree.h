@@ -444,6 +444,14 @@ public:
   vtkIdType FindClosestPoint(double *x, double &dist2);
   vtkIdType FindClosestPoint(double x, double y, double z, double &dist2);
 
+  // Description:
+  // Thread-safe version of FindClosestPoint(). It does not modify the tree,
+  // so that several threads can call it at once after
+  // BuildLocatorFromPoints(), each with its own regionIds array, which is
+  // used as work space. Returns -1 if the locator was not built.
+  vtkIdType FindClosestPoint(const double x[3], double &dist2,
+                             vtkIntArray *regionIds) const;
+
   // Description:
   // Given a position x and a radius r, return the id of the point
   // closest to the point in that radius.
@@ -721,11 +729,20 @@ protected:
                                int len, float tolerance2);
 
   int _FindClosestPointInRegion(int regionId,
-                          double x, double y, double z, double &dist2);
+                          double x, double y, double z, double &dist2) const;
 
   int FindClosestPointInSphere(double x, double y, double z, double radius,
                                int skipRegion, double &dist2);
 
+  // Description:
+  // Versions of FindClosestPoint() and FindClosestPointInSphere() which do
+  // not modify the tree. regionIds must have room for NumberOfRegions ids.
+  vtkIdType FindClosestPoint(double x, double y, double z, double &dist2,
+                             int *regionIds) const;
+  int FindClosestPointInSphere(double x, double y, double z, double radius,
+                               int skipRegion, double &dist2,
+                               int *regionIds) const;
+
   int _ViewOrderRegionsInDirection(vtkIntArray *IdsOfInterest,
                                    const double dop[3],
                                    vtkIntArray *orderedList);
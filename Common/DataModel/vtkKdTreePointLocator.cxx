@@ -14,7 +14,9 @@
 =========================================================================*/
 #include "vtkKdTreePointLocator.h"
 
+#include "vtkIdList.h"
 #include "vtkKdTree.h"
+#include "vtkLocatorScratch.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 
@@ -41,6 +43,18 @@ vtkIdType vtkKdTreePointLocator::FindClosestPoint(const double x[3])
   return this->KdTree->FindClosestPoint(x[0], x[1], x[2], dist2);
 }
 
+vtkIdType vtkKdTreePointLocator::FindClosestPoint(
+  const double x[3], vtkLocatorScratch *scratch) const
+{
+  if (!this->KdTree)
+    {
+    return -1;
+    }
+  double dist2;
+
+  return this->KdTree->FindClosestPoint(x, dist2, scratch->GetIndices());
+}
+
 vtkIdType vtkKdTreePointLocator::FindClosestPointWithinRadius(
   double radius, const double x[3], double& dist2)
 {
@@ -62,6 +76,18 @@ void vtkKdTreePointLocator::FindPointsWithinRadius(double R, const double x[3],
   this->KdTree->FindPointsWithinRadius(R, x, result);
 }
 
+void vtkKdTreePointLocator::FindPointsWithinRadius(
+  double R, const double x[3], vtkIdList *result,
+  vtkLocatorScratch *vtkNotUsed(scratch)) const
+{
+  result->Reset();
+  if (!this->KdTree)
+    {
+    return;
+    }
+  this->KdTree->FindPointsWithinRadius(R, x, result);
+}
+
 void vtkKdTreePointLocator::FreeSearchStructure()
 {
   if(this->KdTree)
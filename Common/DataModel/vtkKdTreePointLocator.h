@@ -28,6 +28,7 @@
 
 class vtkIdList;
 class vtkKdTree;
+class vtkLocatorScratch;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkKdTreePointLocator : public vtkAbstractPointLocator
 {
@@ -43,6 +44,12 @@ public:
   // indirectly called from a single thread first.
   virtual vtkIdType FindClosestPoint(const double x[3]);
 
+  // Description:
+  // Thread-safe version of FindClosestPoint(). It does not build the
+  // locator, and finds nothing until it is built.
+  virtual vtkIdType FindClosestPoint(const double x[3],
+                                     vtkLocatorScratch *scratch) const;
+
   // Description:
   // Given a position x and a radius r, return the id of the point
   // closest to the point in that radius.
@@ -68,6 +75,13 @@ public:
   virtual void FindPointsWithinRadius(double R, const double x[3],
                                       vtkIdList *result);
 
+  // Description:
+  // Thread-safe version of FindPointsWithinRadius(). It does not build the
+  // locator, and finds nothing until it is built. The scratch is not used.
+  virtual void FindPointsWithinRadius(double R, const double x[3],
+                                      vtkIdList *result,
+                                      vtkLocatorScratch *scratch) const;
+
   // Description:
   // See vtkLocator interface documentation.
   // These methods are not thread safe.
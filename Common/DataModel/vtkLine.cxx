@@ -237,12 +237,12 @@ void vtkLine::Contour(double value, vtkDataArray *cellScalars,
       x[i] = x1[i] + t * (x2[i] - x1[i]);
       }
 
-    if ( locator->InsertUniquePoint(x, pts[0]) )
+    vtkIdType p1 = this->PointIds->GetId(vert[0]);
+    vtkIdType p2 = this->PointIds->GetId(vert[1]);
+    if ( locator->InsertUniqueEdgePoint(p1, p2, t, x, pts[0]) )
       {
       if ( outPd )
         {
-        vtkIdType p1 = this->PointIds->GetId(vert[0]);
-        vtkIdType p2 = this->PointIds->GetId(vert[1]);
         outPd->InterpolateEdge(inPd,pts[0],p1,p2,t);
         }
       }
@@ -810,10 +810,11 @@ void vtkLine::Clip(double value, vtkDataArray *cellScalars,
       if (vert[i] >= 100)
         {
         vertexId = vert[i] - 100;
+        vtkIdType p = this->PointIds->GetId(vertexId);
         this->Points->GetPoint(vertexId, x);
-        if ( locator->InsertUniquePoint(x, pts[i]) )
+        if ( locator->InsertUniqueEdgePoint(p, p, 0.0, x, pts[i]) )
           {
-          outPd->CopyData(inPd,this->PointIds->GetId(vertexId),pts[i]);
+          outPd->CopyData(inPd,p,pts[i]);
           }
         }
 
@@ -829,10 +830,10 @@ void vtkLine::Clip(double value, vtkDataArray *cellScalars,
           x[j] = x1[j] + t * (x2[j] - x1[j]);
           }
 
-        if ( locator->InsertUniquePoint(x, pts[i]) )
+        vtkIdType p1 = this->PointIds->GetId(0);
+        vtkIdType p2 = this->PointIds->GetId(1);
+        if ( locator->InsertUniqueEdgePoint(p1, p2, t, x, pts[i]) )
           {
-          vtkIdType p1 = this->PointIds->GetId(0);
-          vtkIdType p2 = this->PointIds->GetId(1);
           outPd->InterpolateEdge(inPd,pts[i],p1,p2,t);
           }
         }
@@ -0,0 +1,80 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLocatorScratch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLocatorScratch.h"
+
+#include "vtkGenericCell.h"
+#include "vtkIntArray.h"
+#include "vtkObjectFactory.h"
+
+#include <string.h>
+
+vtkStandardNewMacro(vtkLocatorScratch);
+
+//----------------------------------------------------------------------------
+vtkLocatorScratch::vtkLocatorScratch()
+{
+  this->Cell = vtkGenericCell::New();
+  this->Indices = vtkIntArray::New();
+  this->Marks = NULL;
+  this->MarksSize = 0;
+  this->Mark = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkLocatorScratch::~vtkLocatorScratch()
+{
+  this->Cell->Delete();
+  this->Indices->Delete();
+  this->Initialize();
+}
+
+//----------------------------------------------------------------------------
+void vtkLocatorScratch::Initialize()
+{
+  delete [] this->Marks;
+  this->Marks = NULL;
+  this->MarksSize = 0;
+  this->Mark = 0;
+}
+
+//----------------------------------------------------------------------------
+// The marks are only cleared when they are reallocated or when the query
+// number rolls over, so that starting a query is usually free.
+void vtkLocatorScratch::BeginQuery(vtkIdType numberOfIds)
+{
+  if (numberOfIds > this->MarksSize)
+    {
+    delete [] this->Marks;
+    this->Marks = new unsigned int[numberOfIds];
+    memset(this->Marks, 0, numberOfIds * sizeof(unsigned int));
+    this->MarksSize = numberOfIds;
+    }
+  this->Mark++;
+  if (this->Mark == 0)
+    {
+    memset(this->Marks, 0, this->MarksSize * sizeof(unsigned int));
+    this->Mark++;    // can't use 0 as a marker
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkLocatorScratch::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Cell: " << this->Cell << "\n";
+  os << indent << "Indices: " << this->Indices << "\n";
+  os << indent << "Marks Size: " << this->MarksSize << "\n";
+}
@@ -0,0 +1,113 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLocatorScratch.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkLocatorScratch - per-thread state of the thread-safe locator queries
+// .SECTION Description
+// vtkLocatorScratch holds the state that a locator query needs besides the
+// locator itself: the cell in which the cell locators evaluate the candidate
+// cells and return the cell found, the marks of the cells already visited
+// by the query, and the list of buckets or regions to search. The const
+// query methods of vtkAbstractCellLocator and vtkAbstractPointLocator take
+// a scratch and do not modify the locator, so that one built locator can
+// be queried from several threads at once, each thread with its own scratch.
+//
+// \code
+// vtkSMPThreadLocal<vtkSmartPointer<vtkLocatorScratch> > scratches;
+// ...
+// vtkSmartPointer<vtkLocatorScratch> &scratch = scratches.Local();
+// if (!scratch)
+//   {
+//   scratch = vtkSmartPointer<vtkLocatorScratch>::New();
+//   }
+// cellId = locator->FindCell(x, tol2, scratch, pcoords, weights);
+// \endcode
+//
+// .SECTION Caveats
+// A scratch must not be used by two threads at once. It may be used with
+// several locators: the visited marks are sized by each query.
+//
+// .SECTION See Also
+// vtkAbstractCellLocator vtkAbstractPointLocator vtkSMPThreadLocal
+
+#ifndef __vtkLocatorScratch_h
+#define __vtkLocatorScratch_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkGenericCell;
+class vtkIntArray;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkLocatorScratch : public vtkObject
+{
+public:
+  static vtkLocatorScratch *New();
+  vtkTypeMacro(vtkLocatorScratch,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // The cell in which the cell locators evaluate the candidate cells. After
+  // a query of a cell locator that found a cell, it is the cell found.
+  vtkGenericCell *GetCell() { return this->Cell; }
+
+  // Description:
+  // Work list of the locators: the i,j,k indices of the buckets to search,
+  // or the ids of the regions of a tree.
+  vtkIntArray *GetIndices() { return this->Indices; }
+
+  // Description:
+  // Start a query visiting ids between 0 and numberOfIds - 1: no id is
+  // marked visited afterwards.
+  void BeginQuery(vtkIdType numberOfIds);
+
+  // Description:
+  // Mark id visited by the current query. Return 1 if it was not visited
+  // yet, else 0.
+  int Visit(vtkIdType id)
+    {
+    if (this->Marks[id] == this->Mark)
+      {
+      return 0;
+      }
+    this->Marks[id] = this->Mark;
+    return 1;
+    }
+
+  // Description:
+  // Mark id not visited by the current query.
+  void Unvisit(vtkIdType id) { this->Marks[id] = 0; }
+
+  // Description:
+  // Release the visited marks.
+  void Initialize();
+
+protected:
+  vtkLocatorScratch();
+  ~vtkLocatorScratch();
+
+  vtkGenericCell *Cell;
+  vtkIntArray *Indices;
+
+  // The mark of each id, equal to Mark if the id was visited by the
+  // current query.
+  unsigned int *Marks;
+  vtkIdType MarksSize;
+  unsigned int Mark;
+
+private:
+  vtkLocatorScratch(const vtkLocatorScratch&);  // Not implemented.
+  void operator=(const vtkLocatorScratch&);  // Not implemented.
+};
+
+#endif
@@ -124,6 +124,14 @@ public:
   virtual void FindPointsWithinRadius(
     double radius, const double x[3], vtkIdList *result);
 
+//BTX
+  // Description:
+  // Include the thread-safe queries of vtkAbstractPointLocator, which the
+  // queries above hide.
+  using vtkAbstractPointLocator::FindClosestPoint;
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
+//ETX
+
   // Description:
   // Find the closest N points to a position. This returns the closest
   // N points to a position. A faster method could be created that returned
@@ -147,6 +147,20 @@ void vtkPointLocator::FreeSearchStructure()
 
 // Given a position x, return the id of the point closest to it.
 vtkIdType vtkPointLocator::FindClosestPoint(const double x[3])
+{
+  if ( !this->DataSet || this->DataSet->GetNumberOfPoints() < 1 )
+    {
+    return -1;
+    }
+
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  return this->FindClosestPoint(x, NULL);
+}
+
+// Thread-safe version: the state of the query lives on the stack.
+vtkIdType vtkPointLocator::FindClosestPoint(
+  const double x[3], vtkLocatorScratch *vtkNotUsed(scratch)) const
 {
   int i, j;
   double minDist2;
@@ -158,13 +172,12 @@ vtkIdType vtkPointLocator::FindClosestPoint(const double x[3])
   int ijk[3], *nei;
   vtkNeighborPoints buckets;
 
-  if ( !this->DataSet || this->DataSet->GetNumberOfPoints() < 1 )
+  if ( !this->DataSet || !this->HashTable ||
+       this->DataSet->GetNumberOfPoints() < 1 )
     {
     return -1;
     }
 
-  this->BuildLocator(); // will subdivide if modified; otherwise returns
-
   //
   //  Find bucket point is in.
   //
@@ -780,6 +793,16 @@ void vtkPointLocator::FindClosestNPoints(int N, const double x[3],
 
 void vtkPointLocator::FindPointsWithinRadius(double R, const double x[3],
                                              vtkIdList *result)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  this->FindPointsWithinRadius(R, x, result, NULL);
+}
+
+// Thread-safe version: the state of the query lives on the stack.
+void vtkPointLocator::FindPointsWithinRadius(
+  double R, const double x[3], vtkIdList *result,
+  vtkLocatorScratch *vtkNotUsed(scratch)) const
 {
   int i, j;
   double dist2;
@@ -790,7 +813,13 @@ void vtkPointLocator::FindPointsWithinRadius(double R, const double x[3],
   double R2 = R*R;
   vtkNeighborPoints buckets;
 
-  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  // clear out the result
+  result->Reset();
+
+  if ( !this->DataSet || !this->HashTable )
+    {
+    return;
+    }
   //
   //  Find bucket point is in.
   //
@@ -801,9 +830,6 @@ void vtkPointLocator::FindPointsWithinRadius(double R, const double x[3],
   // add the original bucket
   buckets.InsertNextPoint(ijk);
 
-  // clear out the result
-  result->Reset();
-
   for (i=0; i<buckets.GetNumberOfNeighbors(); i++)
     {
     nei = buckets.GetPoint(i);
@@ -943,7 +969,7 @@ void vtkPointLocator::BuildLocator()
 //
 void vtkPointLocator::GetBucketNeighbors(vtkNeighborPoints* buckets,
                                          const int ijk[3], const int ndivs[3],
-                                         int level)
+                                         int level) const
 {
   int i, j, k, min, max, minLevel[3], maxLevel[3];
   int nei[3];
@@ -998,7 +1024,7 @@ void vtkPointLocator::GetBucketNeighbors(vtkNeighborPoints* buckets,
 void vtkPointLocator::GetOverlappingBuckets(vtkNeighborPoints* buckets,
                                             const double x[3],
                                             const int ijk[3],
-                                            double dist, int level)
+                                            double dist, int level) const
 {
   int i, j, k, nei[3], minLevel[3], maxLevel[3];
 
@@ -1052,7 +1078,7 @@ void vtkPointLocator::GetOverlappingBuckets(vtkNeighborPoints* buckets,
 void vtkPointLocator::GetOverlappingBuckets(vtkNeighborPoints* buckets,
                                             const double x[3], double dist,
                                             int prevMinLevel[3],
-                                            int prevMaxLevel[3])
+                                            int prevMaxLevel[3]) const
 {
   int i, j, k, nei[3], minLevel[3], maxLevel[3];
   int kFactor, jFactor;
@@ -1682,7 +1708,7 @@ void vtkPointLocator::GenerateFace(int face, int i, int j, int k,
 // routine can make is 25% slower!!!!
 //
 double vtkPointLocator::Distance2ToBucket(const double x[3],
-                                         const int nei[3])
+                                         const int nei[3]) const
 {
   double bounds[6];
 
@@ -1701,7 +1727,7 @@ double vtkPointLocator::Distance2ToBucket(const double x[3],
 // WARNING!!!!! Be very careful altering this routine.  Simple changes to this
 // routine can make is 25% slower!!!!
 double vtkPointLocator::Distance2ToBounds(const double x[3],
-                                         const double bounds[6])
+                                         const double bounds[6]) const
 {
   double distance;
   double deltas[3];
@@ -1753,7 +1779,7 @@ double vtkPointLocator::Distance2ToBounds(const double x[3],
   return distance;
 }
 
-vtkIdType vtkPointLocator::GetBucketIndex(const double x[3])
+vtkIdType vtkPointLocator::GetBucketIndex(const double x[3]) const
 {
   int ijk[3];
   this->GetBucketIndices(x, ijk);
@@ -1761,7 +1787,7 @@ vtkIdType vtkPointLocator::GetBucketIndex(const double x[3])
            ijk[2]*this->Divisions[0]*this->Divisions[1] );
 }
 
-void vtkPointLocator::GetBucketIndices(const double x[3], int ijk[3])
+void vtkPointLocator::GetBucketIndices(const double x[3], int ijk[3]) const
 {
   for (int j=0; j<3; j++)
     {
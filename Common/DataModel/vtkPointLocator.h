@@ -41,6 +41,7 @@
 
 class vtkCellArray;
 class vtkIdList;
+class vtkLocatorScratch;
 class vtkNeighborPoints;
 class vtkPoints;
 
@@ -72,6 +73,12 @@ public:
   // indirectly called from a single thread first.
   virtual vtkIdType FindClosestPoint(const double x[3]);
 
+  // Description:
+  // Thread-safe version of FindClosestPoint(). It does not build the
+  // locator, and finds nothing until it is built. The scratch is not used.
+  virtual vtkIdType FindClosestPoint(const double x[3],
+                                     vtkLocatorScratch *scratch) const;
+
   // Description:
   // Given a position x and a radius r, return the id of the point
   // closest to the point in that radius.
@@ -177,6 +184,13 @@ public:
   virtual void FindPointsWithinRadius(double R, const double x[3],
                                       vtkIdList *result);
 
+  // Description:
+  // Thread-safe version of FindPointsWithinRadius(). It does not build the
+  // locator, and finds nothing until it is built. The scratch is not used.
+  virtual void FindPointsWithinRadius(double R, const double x[3],
+                                      vtkIdList *result,
+                                      vtkLocatorScratch *scratch) const;
+
   // Description:
   // Given a position x, return the list of points in the bucket that
   // contains the point. It is possible that NULL is returned. The user
@@ -202,23 +216,24 @@ protected:
 
   // place points in appropriate buckets
   void GetBucketNeighbors(vtkNeighborPoints* buckets,
-                          const int ijk[3], const int ndivs[3], int level);
+                          const int ijk[3], const int ndivs[3],
+                          int level) const;
   void GetOverlappingBuckets(vtkNeighborPoints* buckets,
                              const double x[3], const int ijk[3], double dist,
-                             int level);
+                             int level) const;
   void GetOverlappingBuckets(vtkNeighborPoints* buckets,
                              const double x[3], double dist,
                              int prevMinLevel[3],
-                             int prevMaxLevel[3]);
+                             int prevMaxLevel[3]) const;
   void GenerateFace(int face, int i, int j, int k,
                     vtkPoints *pts, vtkCellArray *polys);
-  double Distance2ToBucket(const double x[3], const int nei[3]);
-  double Distance2ToBounds(const double x[3], const double bounds[6]);
+  double Distance2ToBucket(const double x[3], const int nei[3]) const;
+  double Distance2ToBounds(const double x[3], const double bounds[6]) const;
 
   // Description:
   // Give the bucket index that point is located in.
-  vtkIdType GetBucketIndex(const double x[3]);
-  void GetBucketIndices(const double x[3], int ijk[3]);
+  vtkIdType GetBucketIndex(const double x[3]) const;
+  void GetBucketIndices(const double x[3], int ijk[3]) const;
 
   vtkPoints *Points; // Used for merging points
   int Divisions[3]; // Number of sub-divisions in x-y-z directions
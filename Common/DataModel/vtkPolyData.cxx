@@ -15,6 +15,7 @@
 #include "vtkPolyData.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCriticalSection.h"
 #include "vtkEmptyCell.h"
@@ -33,6 +34,8 @@
 #include "vtkTriangleStrip.h"
 #include "vtkVertex.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkPolyData);
 
 //----------------------------------------------------------------------------
@@ -255,7 +258,8 @@ int vtkPolyData::GetCellType(vtkIdType cellId)
 vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
 {
   int i, loc;
-  vtkIdType *pts, numPts;
+  const vtkIdType *pts;
+  vtkIdType numPts;
   vtkCell *cell = NULL;
   unsigned char type;
 
@@ -275,7 +279,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->Vertex = vtkVertex::New();
         }
       cell = this->Vertex;
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_VERTEX:
@@ -284,7 +288,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->PolyVertex = vtkPolyVertex::New();
         }
       cell = this->PolyVertex;
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -295,7 +299,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->Line = vtkLine::New();
         }
       cell = this->Line;
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_LINE:
@@ -304,7 +308,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->PolyLine = vtkPolyLine::New();
         }
       cell = this->PolyLine;
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -315,7 +319,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->Triangle = vtkTriangle::New();
         }
       cell = this->Triangle;
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_QUAD:
@@ -324,7 +328,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->Quad = vtkQuad::New();
         }
       cell = this->Quad;
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLYGON:
@@ -333,7 +337,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->Polygon = vtkPolygon::New();
         }
       cell = this->Polygon;
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -344,7 +348,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->TriangleStrip = vtkTriangleStrip::New();
         }
       cell = this->TriangleStrip;
-      this->Strips->GetCell(loc,numPts,pts);
+      this->Strips->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -372,7 +376,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
 void vtkPolyData::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 {
   int             i, loc;
-  vtkIdType       *pts=0;
+  const vtkIdType *pts=0;
   vtkIdType       numPts;
   unsigned char   type;
   double           x[3];
@@ -389,48 +393,48 @@ void vtkPolyData::GetCell(vtkIdType cellId, vtkGenericCell *cell)
     {
     case VTK_VERTEX:
       cell->SetCellTypeToVertex();
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_VERTEX:
       cell->SetCellTypeToPolyVertex();
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_LINE:
       cell->SetCellTypeToLine();
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_LINE:
       cell->SetCellTypeToPolyLine();
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_TRIANGLE:
       cell->SetCellTypeToTriangle();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_QUAD:
       cell->SetCellTypeToQuad();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLYGON:
       cell->SetCellTypeToPolygon();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_TRIANGLE_STRIP:
       cell->SetCellTypeToTriangleStrip();
-      this->Strips->GetCell(loc,numPts,pts);
+      this->Strips->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -530,6 +534,9 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
   vtkIdType *pts, numPts;
   unsigned char type;
   double x[3];
+  vtkCellArray *cells;
+  vtkIdType ptsBuffer[VTK_CELL_SIZE];
+  std::vector<vtkIdType> largePts;
 
   if ( !this->Cells )
     {
@@ -543,22 +550,22 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
     {
     case VTK_VERTEX:
     case VTK_POLY_VERTEX:
-      this->Verts->GetCell(loc,numPts,pts);
+      cells = this->Verts;
       break;
 
     case VTK_LINE:
     case VTK_POLY_LINE:
-      this->Lines->GetCell(loc,numPts,pts);
+      cells = this->Lines;
       break;
 
     case VTK_TRIANGLE:
     case VTK_QUAD:
     case VTK_POLYGON:
-      this->Polys->GetCell(loc,numPts,pts);
+      cells = this->Polys;
       break;
 
     case VTK_TRIANGLE_STRIP:
-      this->Strips->GetCell(loc,numPts,pts);
+      cells = this->Strips;
       break;
 
     default:
@@ -567,6 +574,24 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
       return;
     }
 
+  // Locators call this from several threads, so 32 bit storage is copied
+  // instead of converted.
+  if (cells->IsStorage32Bit())
+    {
+    vtkIdType cellArrayId = cells->GetCellIdAtLocation(loc);
+    pts = ptsBuffer;
+    if (cells->GetCellSize(cellArrayId) > VTK_CELL_SIZE)
+      {
+      largePts.resize(cells->GetCellSize(cellArrayId));
+      pts = &largePts[0];
+      }
+    numPts = cells->GetCellPointIds(cellArrayId, pts);
+    }
+  else
+    {
+    cells->GetCell(loc,numPts,pts);
+    }
+
   // carefully compute the bounds
   if (numPts)
     {
@@ -960,7 +985,7 @@ void vtkPolyData::BuildCells()
   vtkCellArray *inPolys=this->GetPolys();
   vtkCellArray *inStrips=this->GetStrips();
   vtkIdType npts=0;
-  vtkIdType *pts=0;
+  const vtkIdType *pts=0;
   vtkCellTypes *cells;
 
   vtkDebugMacro (<< "Building PolyData cells.");
@@ -980,54 +1005,73 @@ void vtkPolyData::BuildCells()
   this->Cells->Register(this);
   cells->Delete();
   //
-  // Traverse various lists to create cell array
+  // Traverse various lists to create cell array. The iterators do not
+  // convert 32 bit storage like GetNextCell() would. loc is the legacy
+  // location of the current cell.
   //
-  for (inVerts->InitTraversal(); inVerts->GetNextCell(npts,pts); )
+  vtkCellArrayIterator *iter;
+  vtkIdType loc;
+
+  iter = inVerts->NewIterator();
+  for (loc = 0; !iter->IsDoneWithTraversal(); iter->GoToNextCell())
     {
+    iter->GetCurrentCell(npts,pts);
     if ( npts > 1 )
       {
-      cells->InsertNextCell(VTK_POLY_VERTEX,
-                            inVerts->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_POLY_VERTEX,loc);
       }
     else
       {
-      cells->InsertNextCell(VTK_VERTEX,inVerts->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_VERTEX,loc);
       }
+    loc += npts + 1;
     }
+  iter->Delete();
 
-  for (inLines->InitTraversal(); inLines->GetNextCell(npts,pts); )
+  iter = inLines->NewIterator();
+  for (loc = 0; !iter->IsDoneWithTraversal(); iter->GoToNextCell())
     {
+    iter->GetCurrentCell(npts,pts);
     if ( npts > 2 )
       {
-      cells->InsertNextCell(VTK_POLY_LINE,inLines->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_POLY_LINE,loc);
       }
     else
       {
-      cells->InsertNextCell(VTK_LINE,inLines->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_LINE,loc);
       }
+    loc += npts + 1;
     }
+  iter->Delete();
 
-  for (inPolys->InitTraversal(); inPolys->GetNextCell(npts,pts); )
+  iter = inPolys->NewIterator();
+  for (loc = 0; !iter->IsDoneWithTraversal(); iter->GoToNextCell())
     {
+    iter->GetCurrentCell(npts,pts);
     if ( npts == 3 )
       {
-      cells->InsertNextCell(VTK_TRIANGLE,inPolys->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_TRIANGLE,loc);
       }
     else if ( npts == 4 )
       {
-      cells->InsertNextCell(VTK_QUAD,inPolys->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_QUAD,loc);
       }
     else
       {
-      cells->InsertNextCell(VTK_POLYGON,inPolys->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_POLYGON,loc);
       }
+    loc += npts + 1;
     }
+  iter->Delete();
 
-  for (inStrips->InitTraversal(); inStrips->GetNextCell(npts,pts); )
+  iter = inStrips->NewIterator();
+  for (loc = 0; !iter->IsDoneWithTraversal(); iter->GoToNextCell())
     {
-    cells->InsertNextCell(VTK_TRIANGLE_STRIP,
-                          inStrips->GetTraversalLocation(npts));
+    iter->GetCurrentCell(npts,pts);
+    cells->InsertNextCell(VTK_TRIANGLE_STRIP,loc);
+    loc += npts + 1;
     }
+  iter->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -1067,7 +1111,15 @@ void vtkPolyData::BuildLinks(int initialSize)
   this->Links->Register(this);
   this->Links->Delete();
 
-  this->Links->BuildLinks(this);
+  // Extra room means the links are going to be edited.
+  if ( initialSize > 0 )
+    {
+    this->Links->BuildLinks(this);
+    }
+  else
+    {
+    this->Links->BuildStaticLinks(this);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -1075,7 +1127,9 @@ void vtkPolyData::BuildLinks(int initialSize)
 void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 {
   vtkIdType i;
-  vtkIdType *pts, npts;
+  const vtkIdType *pts;
+  vtkIdType npts;
+  vtkCellArray *cells;
 
   ptIds->Reset();
   if ( this->Cells == NULL )
@@ -1083,11 +1137,37 @@ void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
     this->BuildCells();
     }
 
-  this->vtkPolyData::GetCellPoints(cellId, npts, pts);
-  ptIds->InsertId (npts-1,pts[npts-1]);
-  for (i=0; i<npts-1; i++)
+  switch (this->Cells->GetCellType(cellId))
+    {
+    case VTK_VERTEX: case VTK_POLY_VERTEX:
+      cells = this->Verts;
+      break;
+
+    case VTK_LINE: case VTK_POLY_LINE:
+      cells = this->Lines;
+      break;
+
+    case VTK_TRIANGLE: case VTK_QUAD: case VTK_POLYGON:
+      cells = this->Polys;
+      break;
+
+    case VTK_TRIANGLE_STRIP:
+      cells = this->Strips;
+      break;
+
+    default:
+      return;
+    }
+
+  // ptIds is the scratch space of the offsets layout with 32 bit storage.
+  cells->GetCell(this->Cells->GetCellLocation(cellId), npts, pts, ptIds);
+  if (pts != ptIds->GetPointer(0))
     {
-    ptIds->SetId(i,pts[i]);
+    ptIds->SetNumberOfIds(npts);
+    for (i=0; i<npts; i++)
+      {
+      ptIds->SetId(i,pts[i]);
+      }
     }
 }
 
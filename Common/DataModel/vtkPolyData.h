@@ -221,8 +221,15 @@ public:
   // topologically complex queries. Normally the links array is allocated
   // based on the number of points in the vtkPolyData. The optional
   // initialSize parameter can be used to allocate a larger size initially.
+  // Without initialSize, the links are built in parallel as static links
+  // (see vtkCellLinks::BuildStaticLinks()); they are converted on the fly
+  // if the mesh is later edited through the links.
   void BuildLinks(int initialSize=0);
 
+  // Description:
+  // Return the upward links built by BuildLinks(), or NULL.
+  vtkCellLinks *GetCellLinks() {return this->Links;};
+
   // Description:
   // Release data structure that allows random access of the cells. This must
   // be done before a 2nd call to BuildLinks(). DeleteCells implicitly deletes
@@ -211,10 +211,11 @@ void vtkPolyVertex::Clip(double value, vtkDataArray *cellScalars,
 
     if ( (!insideOut && s > value) || (insideOut && s <= value) )
       {
+      vtkIdType p = this->PointIds->GetId(i);
       this->Points->GetPoint(i,x);
-      if ( locator->InsertUniquePoint(x, pts[0]) )
+      if ( locator->InsertUniqueEdgePoint(p, p, 0.0, x, pts[0]) )
         {
-        outPd->CopyData(inPd,this->PointIds->GetId(i),pts[0]);
+        outPd->CopyData(inPd,p,pts[0]);
         }
       newCellId = verts->InsertNextCell(1,pts);
       outCd->CopyData(inCd,cellId,newCellId);
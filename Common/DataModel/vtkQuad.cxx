@@ -471,12 +471,12 @@ void vtkQuad::Contour(double value, vtkDataArray *cellScalars,
         {
         x[j] = x1[j] + t * (x2[j] - x1[j]);
         }
-      if ( locator->InsertUniquePoint(x, pts[i]) )
+      vtkIdType p1 = this->PointIds->GetId(e1);
+      vtkIdType p2 = this->PointIds->GetId(e2);
+      if ( locator->InsertUniqueEdgePoint(p1, p2, t, x, pts[i]) )
         {
         if ( outPd )
           {
-          vtkIdType p1 = this->PointIds->GetId(e1);
-          vtkIdType p2 = this->PointIds->GetId(e2);
           outPd->InterpolateEdge(inPd,pts[i],p1,p2,t);
           }
         }
@@ -853,10 +853,11 @@ void vtkQuad::Clip(double value, vtkDataArray *cellScalars,
       if (edge[i+1] >= 100)
         {
         vertexId = edge[i+1] - 100;
+        vtkIdType p = this->PointIds->GetId(vertexId);
         this->Points->GetPoint(vertexId, x);
-        if ( locator->InsertUniquePoint(x, pts[i]) )
+        if ( locator->InsertUniqueEdgePoint(p, p, 0.0, x, pts[i]) )
           {
-          outPd->CopyData(inPd,this->PointIds->GetId(vertexId),pts[i]);
+          outPd->CopyData(inPd,p,pts[i]);
           }
         }
 
@@ -899,10 +900,10 @@ void vtkQuad::Clip(double value, vtkDataArray *cellScalars,
           x[j] = x1[j] + t * (x2[j] - x1[j]);
           }
 
-        if ( locator->InsertUniquePoint(x, pts[i]) )
+        vtkIdType p1 = this->PointIds->GetId(e1);
+        vtkIdType p2 = this->PointIds->GetId(e2);
+        if ( locator->InsertUniqueEdgePoint(p1, p2, t, x, pts[i]) )
           {
-          vtkIdType p1 = this->PointIds->GetId(e1);
-          vtkIdType p2 = this->PointIds->GetId(e2);
           outPd->InterpolateEdge(inPd,pts[i],p1,p2,t);
           }
         }
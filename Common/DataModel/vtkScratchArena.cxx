@@ -0,0 +1,196 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkScratchArena.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkScratchArena.h"
+
+#include "vtkGenericCell.h"
+#include "vtkHeap.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+
+#include <vector>
+
+vtkStandardNewMacro(vtkScratchArena);
+
+//----------------------------------------------------------------------------
+// A pool of objects of one type. The first InUse objects have been handed
+// out since the last Reset().
+template <class T>
+class vtkScratchArenaPool
+{
+public:
+  vtkScratchArenaPool() : InUse(0) {}
+  ~vtkScratchArenaPool()
+  {
+    for (size_t i = 0; i < this->Objects.size(); i++)
+      {
+      this->Objects[i]->Delete();
+      }
+  }
+
+  T *Get()
+  {
+    if (this->InUse == this->Objects.size())
+      {
+      this->Objects.push_back(T::New());
+      }
+    return this->Objects[this->InUse++];
+  }
+
+  std::vector<T*> Objects;
+  size_t InUse;
+};
+
+//----------------------------------------------------------------------------
+// Everything that belongs to one thread. The heap is only created on the
+// first request for raw memory.
+class vtkScratchArenaSlot
+{
+public:
+  vtkScratchArenaSlot() : Heap(NULL) {}
+  // vtkSMPThreadLocal requires a copy constructor, but the slots are
+  // always default constructed; a copy starts empty.
+  vtkScratchArenaSlot(const vtkScratchArenaSlot&) : Heap(NULL) {}
+  ~vtkScratchArenaSlot()
+  {
+    if (this->Heap)
+      {
+      this->Heap->Delete();
+      }
+  }
+
+  void Reset()
+  {
+    this->IdLists.InUse = 0;
+    this->Points.InUse = 0;
+    this->Cells.InUse = 0;
+    if (this->Heap)
+      {
+      this->Heap->Reset();
+      }
+  }
+
+  vtkHeap *Heap;
+  vtkScratchArenaPool<vtkIdList> IdLists;
+  vtkScratchArenaPool<vtkPoints> Points;
+  vtkScratchArenaPool<vtkGenericCell> Cells;
+
+private:
+  void operator=(const vtkScratchArenaSlot&);  // Not implemented.
+};
+
+class vtkScratchArenaInternals
+{
+public:
+  vtkSMPThreadLocal<vtkScratchArenaSlot> Slots;
+};
+
+//----------------------------------------------------------------------------
+vtkScratchArena::vtkScratchArena()
+{
+  this->BlockSize = 65536;
+  this->Internals = new vtkScratchArenaInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkScratchArena::~vtkScratchArena()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+vtkIdList *vtkScratchArena::GetIdList()
+{
+  vtkIdList *ids = this->Internals->Slots.Local().IdLists.Get();
+  ids->Reset();
+  return ids;
+}
+
+//----------------------------------------------------------------------------
+vtkPoints *vtkScratchArena::GetPoints(int dataType)
+{
+  vtkPoints *points = this->Internals->Slots.Local().Points.Get();
+  points->SetDataType(dataType);
+  points->Reset();
+  return points;
+}
+
+//----------------------------------------------------------------------------
+vtkGenericCell *vtkScratchArena::GetGenericCell()
+{
+  return this->Internals->Slots.Local().Cells.Get();
+}
+
+//----------------------------------------------------------------------------
+void *vtkScratchArena::AllocateMemory(size_t n)
+{
+  vtkScratchArenaSlot &slot = this->Internals->Slots.Local();
+  if (!slot.Heap)
+    {
+    slot.Heap = vtkHeap::New();
+    slot.Heap->SetBlockSize(this->BlockSize);
+    }
+  return slot.Heap->AllocateMemory(n);
+}
+
+//----------------------------------------------------------------------------
+void vtkScratchArena::Reset()
+{
+  this->Internals->Slots.Local().Reset();
+}
+
+//----------------------------------------------------------------------------
+void vtkScratchArena::ResetAll()
+{
+  vtkSMPThreadLocal<vtkScratchArenaSlot>::iterator itr =
+    this->Internals->Slots.begin();
+  for (; itr != this->Internals->Slots.end(); ++itr)
+    {
+    itr->Reset();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkScratchArena::Initialize()
+{
+  delete this->Internals;
+  this->Internals = new vtkScratchArenaInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkScratchArena::GetNumberOfPooledObjects()
+{
+  vtkIdType count = 0;
+  vtkSMPThreadLocal<vtkScratchArenaSlot>::iterator itr =
+    this->Internals->Slots.begin();
+  for (; itr != this->Internals->Slots.end(); ++itr)
+    {
+    count += static_cast<vtkIdType>(itr->IdLists.Objects.size() +
+                                    itr->Points.Objects.size() +
+                                    itr->Cells.Objects.size());
+    }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkScratchArena::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Block Size: " << this->BlockSize << "\n";
+  os << indent << "Number Of Pooled Objects: "
+     << this->GetNumberOfPooledObjects() << "\n";
+}
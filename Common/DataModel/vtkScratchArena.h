@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkScratchArena.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkScratchArena - per-thread pool of temporary objects and memory
+// .SECTION Description
+// vtkScratchArena hands out the small temporary objects that per-cell
+// loops need (vtkIdList, vtkPoints, vtkGenericCell) together with raw
+// scratch memory taken from a vtkHeap. Each thread of vtkSMPTools has its
+// own slot, so the methods below may be called concurrently from the
+// functor of a vtkSMPTools::For().
+//
+// Nothing is released one item at a time. Instead, a thread calls Reset()
+// when it is done with its temporaries (typically at the beginning of
+// each sub-range it processes): all the objects it obtained return to
+// its pool and its heap is rewound. The objects keep their allocated
+// capacity, so once the pools are warm, a loop no longer constructs
+// vtkObjects or calls malloc()/free().
+//
+// \code
+// class MyFunctor
+// {
+// public:
+//   vtkScratchArena *Arena;
+//   void operator()(vtkIdType begin, vtkIdType end)
+//   {
+//     this->Arena->Reset();
+//     vtkGenericCell *cell = this->Arena->GetGenericCell();
+//     double *weights = this->Arena->Allocate<double>(this->MaxCellSize);
+//     for (vtkIdType cellId = begin; cellId < end; ++cellId)
+//       {
+//       this->Input->GetCell(cellId, cell);
+//       ...
+//       }
+//   }
+// };
+// \endcode
+//
+// .SECTION Caveats
+// The objects and memory returned belong to the arena: do not Delete()
+// or free() them, and do not use them after the thread that obtained
+// them called Reset(). They must not be handed to other threads either.
+// ResetAll() and Initialize() affect every slot and must not be called
+// while a For() uses the arena. The heap only rewinds on Reset(), so
+// memory allocated for each item of a sub-range adds up over the whole
+// sub-range, which may be the whole loop with the Sequential backend:
+// allocate buffers once per sub-range, sized for the largest item.
+//
+// .SECTION See Also
+// vtkHeap vtkSMPThreadLocal vtkSMPTools
+
+#ifndef __vtkScratchArena_h
+#define __vtkScratchArena_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkGenericCell;
+class vtkIdList;
+class vtkPoints;
+//BTX
+class vtkScratchArenaInternals;
+//ETX
+
+class VTKCOMMONDATAMODEL_EXPORT vtkScratchArena : public vtkObject
+{
+public:
+  static vtkScratchArena *New();
+  vtkTypeMacro(vtkScratchArena,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Return an empty id list, an empty point array of the given data type
+  // or a generic cell from the pool of the calling thread. The object
+  // stays valid until the calling thread invokes Reset().
+  vtkIdList *GetIdList();
+  vtkPoints *GetPoints(int dataType);
+  vtkPoints *GetPoints() { return this->GetPoints(VTK_FLOAT); }
+  vtkGenericCell *GetGenericCell();
+
+  // Description:
+  // Return n bytes of scratch memory from the heap of the calling thread.
+  // The memory stays valid until the calling thread invokes Reset().
+  void *AllocateMemory(size_t n);
+
+  //BTX
+  // Description:
+  // Typed version of AllocateMemory(): room for n values of type T.
+  template <class T>
+  T *Allocate(vtkIdType n)
+    {
+    return static_cast<T*>(this->AllocateMemory(
+      static_cast<size_t>(n) * sizeof(T)));
+    }
+  //ETX
+
+  // Description:
+  // Return all the objects and memory obtained by the calling thread to
+  // its pool. Call this at the beginning of each sub-range of work.
+  void Reset();
+
+  // Description:
+  // Reset() the slots of all the threads. Not thread safe.
+  void ResetAll();
+
+  // Description:
+  // Release all the pooled objects and memory. Not thread safe.
+  void Initialize();
+
+  // Description:
+  // Set/Get the size of the blocks allocated by the heaps. Only affects
+  // the heaps created afterwards.
+  vtkSetMacro(BlockSize,size_t);
+  vtkGetMacro(BlockSize,size_t);
+
+  // Description:
+  // Total number of objects (id lists, points and cells) pooled by all
+  // the threads. Not thread safe; mainly useful for debugging.
+  vtkIdType GetNumberOfPooledObjects();
+
+protected:
+  vtkScratchArena();
+  ~vtkScratchArena();
+
+  size_t BlockSize;
+
+  vtkScratchArenaInternals *Internals;
+
+private:
+  vtkScratchArena(const vtkScratchArena&);  // Not implemented.
+  void operator=(const vtkScratchArena&);  // Not implemented.
+};
+
+#endif
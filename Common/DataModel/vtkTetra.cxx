@@ -305,12 +305,12 @@ void vtkTetra::Contour(double value, vtkDataArray *cellScalars,
         {
         x[j] = x1[j] + t * (x2[j] - x1[j]);
         }
-      if ( locator->InsertUniquePoint(x, pts[i]) )
+      vtkIdType p1 = this->PointIds->GetId(v1);
+      vtkIdType p2 = this->PointIds->GetId(v2);
+      if ( locator->InsertUniqueEdgePoint(p1, p2, t, x, pts[i]) )
         {
         if ( outPd )
           {
-          vtkIdType p1 = this->PointIds->GetId(v1);
-          vtkIdType p2 = this->PointIds->GetId(v2);
           outPd->InterpolateEdge(inPd,pts[i],p1,p2,t);
           }
         }
@@ -331,6 +331,12 @@ int *vtkTetra::GetEdgeArray(int edgeId)
   return edges[edgeId];
 }
 
+//----------------------------------------------------------------------------
+int *vtkTetra::GetTriangleCases(int caseId)
+{
+  return triCases[caseId].edges;
+}
+
 //----------------------------------------------------------------------------
 vtkCell *vtkTetra::GetEdge(int edgeId)
 {
@@ -866,10 +872,11 @@ void vtkTetra::Clip(double value, vtkDataArray *cellScalars,
     if (edge[i] >= 100)
       {
       vertexId = edge[i] - 100;
+      vtkIdType p = this->PointIds->GetId(vertexId);
       this->Points->GetPoint(vertexId, x);
-      if ( locator->InsertUniquePoint(x, pts[i-1]) )
+      if ( locator->InsertUniqueEdgePoint(p, p, 0.0, x, pts[i-1]) )
         {
-        outPD->CopyData(inPD,this->PointIds->GetId(vertexId),pts[i-1]);
+        outPD->CopyData(inPD,p,pts[i-1]);
         }
       }
 
@@ -902,10 +909,10 @@ void vtkTetra::Clip(double value, vtkDataArray *cellScalars,
         x[j] = x1[j] + t * (x2[j] - x1[j]);
         }
 
-      if ( locator->InsertUniquePoint(x, pts[i-1]) )
+      vtkIdType p1 = this->PointIds->GetId(v1);
+      vtkIdType p2 = this->PointIds->GetId(v2);
+      if ( locator->InsertUniqueEdgePoint(p1, p2, t, x, pts[i-1]) )
         {
-        vtkIdType p1 = this->PointIds->GetId(v1);
-        vtkIdType p2 = this->PointIds->GetId(v2);
         outPD->InterpolateEdge(inPD,pts[i-1],p1,p2,t);
         }
       }
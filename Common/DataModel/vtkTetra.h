@@ -160,6 +160,13 @@ public:
   static int *GetEdgeArray(int edgeId);
   static int *GetFaceArray(int faceId);
 
+  // Description:
+  // Return the marching tetrahedra case (0 to 15) of the given index, in
+  // which bit i is set when the scalar of vertex i is at or above the
+  // contour value.  The case is a list of edge ids (see GetEdgeArray()),
+  // three per triangle, ended by -1.
+  static int *GetTriangleCases(int caseId);
+
 protected:
   vtkTetra();
   ~vtkTetra();
@@ -443,12 +443,12 @@ void vtkTriangle::Contour(double value, vtkDataArray *cellScalars,
         {
         x[j] = x1[j] + t * (x2[j] - x1[j]);
         }
-      if ( locator->InsertUniquePoint(x, pts[i]) )
+      vtkIdType p1 = this->PointIds->GetId(e1);
+      vtkIdType p2 = this->PointIds->GetId(e2);
+      if ( locator->InsertUniqueEdgePoint(p1, p2, t, x, pts[i]) )
         {
         if ( outPd )
           {
-          vtkIdType p1 = this->PointIds->GetId(e1);
-          vtkIdType p2 = this->PointIds->GetId(e2);
           outPd->InterpolateEdge(inPd,pts[i],p1,p2,t);
           }
         }
@@ -899,10 +899,11 @@ void vtkTriangle::Clip(double value, vtkDataArray *cellScalars,
       if (edge[i] >= 100)
         {
         vertexId = edge[i] - 100;
+        vtkIdType p = this->PointIds->GetId(vertexId);
         this->Points->GetPoint(vertexId, x);
-        if ( locator->InsertUniquePoint(x, pts[i]) )
+        if ( locator->InsertUniqueEdgePoint(p, p, 0.0, x, pts[i]) )
           {
-          outPd->CopyData(inPd,this->PointIds->GetId(vertexId),pts[i]);
+          outPd->CopyData(inPd,p,pts[i]);
           }
         }
 
@@ -940,10 +941,10 @@ void vtkTriangle::Clip(double value, vtkDataArray *cellScalars,
           {
           x[j] = x1[j] + t * (x2[j] - x1[j]);
           }
-        if ( locator->InsertUniquePoint(x, pts[i]) )
+        vtkIdType p1 = this->PointIds->GetId(e1);
+        vtkIdType p2 = this->PointIds->GetId(e2);
+        if ( locator->InsertUniqueEdgePoint(p1, p2, t, x, pts[i]) )
           {
-          vtkIdType p1 = this->PointIds->GetId(e1);
-          vtkIdType p2 = this->PointIds->GetId(e2);
           outPd->InterpolateEdge(inPd,pts[i],p1,p2,t);
           }
         }
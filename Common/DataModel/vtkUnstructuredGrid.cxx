@@ -60,9 +60,32 @@
 #include "vtkBiQuadraticTriangle.h"
 
 #include <set>
+#include <vector>
 
 vtkStandardNewMacro(vtkUnstructuredGrid);
 
+//----------------------------------------------------------------------------
+// In the offsets layout the cells are read by id, which is O(1), as long as
+// the cell locations follow the cell ids. pts points into the cells or into
+// the scratch list. Without a scratch list 32 bit storage is converted to
+// vtkIdType, see vtkCellArray.
+static inline void vtkUnstructuredGridGetCell(vtkCellArray *cells,
+                                              vtkIdType cellId, vtkIdType loc,
+                                              vtkIdType &npts,
+                                              const vtkIdType* &pts,
+                                              vtkIdList *scratch)
+{
+  if (cells->IsOffsetsLayout() && cellId < cells->GetNumberOfCells() &&
+      cells->GetCellLocation(cellId) == loc)
+    {
+    cells->GetCellAtId(cellId, npts, pts, scratch);
+    }
+  else
+    {
+    cells->GetCell(loc, npts, pts, scratch);
+    }
+}
+
 vtkUnstructuredGrid::vtkUnstructuredGrid ()
 {
   this->Vertex = NULL;
@@ -476,11 +499,8 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
   vtkIdType i;
   vtkIdType loc;
   vtkCell *cell = NULL;
-  vtkIdType *pts, numPts;
-
-  loc = this->Locations->GetValue(cellId);
-  vtkDebugMacro(<< "location = " <<  loc);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  const vtkIdType *pts;
+  vtkIdType numPts;
 
   int cellType = static_cast<int>(this->Types->GetValue(cellId));
   switch (cellType)
@@ -762,6 +782,11 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
     return NULL;
     }
 
+  loc = this->Locations->GetValue(cellId);
+  vtkDebugMacro(<< "location = " <<  loc);
+  vtkUnstructuredGridGetCell(this->Connectivity, cellId, loc, numPts, pts,
+                             cell->PointIds);
+
   // Copy the points over to the cell.
   cell->PointIds->SetNumberOfIds(numPts);
   cell->Points->SetNumberOfPoints(numPts);
@@ -787,13 +812,15 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
   vtkIdType i;
   vtkIdType    loc;
   double  x[3];
-  vtkIdType *pts, numPts;
+  const vtkIdType *pts;
+  vtkIdType numPts;
 
   int cellType = static_cast<int>(this->Types->GetValue(cellId));
   cell->SetCellType(cellType);
 
   loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  vtkUnstructuredGridGetCell(this->Connectivity, cellId, loc, numPts, pts,
+                             cell->PointIds);
 
   cell->PointIds->SetNumberOfIds(numPts);
   cell->Points->SetNumberOfPoints(numPts);
@@ -827,10 +854,31 @@ void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
   vtkIdType i;
   vtkIdType loc;
   double x[3];
-  vtkIdType *pts, numPts;
-
+  const vtkIdType *pts;
+  vtkIdType numPts;
+  vtkIdType ptsBuffer[VTK_CELL_SIZE];
+  std::vector<vtkIdType> largePts;
+
+  // Locators call this from several threads, so the ids are copied instead
+  // of converting 32 bit storage.
+  vtkCellArray *cells = this->Connectivity;
   loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  if (cells->IsOffsetsLayout() && cellId < cells->GetNumberOfCells() &&
+      cells->GetCellLocation(cellId) == loc)
+    {
+    vtkIdType *ids = ptsBuffer;
+    if (cells->GetCellSize(cellId) > VTK_CELL_SIZE)
+      {
+      largePts.resize(cells->GetCellSize(cellId));
+      ids = &largePts[0];
+      }
+    numPts = cells->GetCellPointIds(cellId, ids);
+    pts = ids;
+    }
+  else
+    {
+    vtkUnstructuredGridGetCell(cells, cellId, loc, numPts, pts, NULL);
+    }
 
   // carefully compute the bounds
   if (numPts)
@@ -960,7 +1008,8 @@ vtkIdType vtkUnstructuredGrid::InsertNextCell(int type, vtkIdType npts,
       }
 
     // insert cell location
-    this->Locations->InsertNextValue(this->Connectivity->GetData()->GetMaxId()+1);
+    this->Locations->InsertNextValue(
+      this->Connectivity->GetNumberOfConnectivityEntries());
     // insert face location
     this->FaceLocations->InsertNextValue(this->Faces->GetMaxId()+1);
     // insert cell connectivity and faces stream
@@ -1284,7 +1333,7 @@ void vtkUnstructuredGrid::BuildLinks()
   this->Links = vtkCellLinks::New();
   this->Links->Allocate(this->GetNumberOfPoints());
   this->Links->Register(this);
-  this->Links->BuildLinks(this, this->Connectivity);
+  this->Links->BuildStaticLinks(this, this->Connectivity);
   this->Links->Delete();
 }
 
@@ -1292,16 +1341,20 @@ void vtkUnstructuredGrid::BuildLinks()
 void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 {
   vtkIdType i, loc;
-  vtkIdType *pts, numPts;
+  const vtkIdType *pts;
+  vtkIdType numPts;
 
   loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
-  ptIds->SetNumberOfIds(numPts);
-  for (i=0; i<numPts; i++)
+  vtkUnstructuredGridGetCell(this->Connectivity, cellId, loc, numPts, pts,
+                             ptIds);
+  if (pts != ptIds->GetPointer(0))
     {
-    ptIds->SetId(i,pts[i]);
+    ptIds->SetNumberOfIds(numPts);
+    for (i=0; i<numPts; i++)
+      {
+      ptIds->SetId(i,pts[i]);
+      }
     }
-
 }
 
 //----------------------------------------------------------------------------
@@ -1311,10 +1364,13 @@ void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
                                         vtkIdType* &pts)
 {
   vtkIdType loc;
+  const vtkIdType *cpts;
 
   loc = this->Locations->GetValue(cellId);
 
-  this->Connectivity->GetCell(loc,npts,pts);
+  vtkUnstructuredGridGetCell(this->Connectivity, cellId, loc, npts, cpts,
+                             NULL);
+  pts = const_cast<vtkIdType*>(cpts);
 }
 
 //----------------------------------------------------------------------------
@@ -126,6 +126,11 @@ public:
   void Squeeze();
   void Initialize();
   int GetMaxCellSize();
+
+  // Description:
+  // Create upward links from points to cells that use each point. The
+  // links are built in parallel as static links (see
+  // vtkCellLinks::BuildStaticLinks()).
   void BuildLinks();
   vtkCellLinks *GetCellLinks() {return this->Links;};
   virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
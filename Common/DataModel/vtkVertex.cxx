@@ -229,10 +229,11 @@ void vtkVertex::Clip(double value, vtkDataArray *cellScalars,
 
   if ( ( !insideOut && s > value) || (insideOut && s <= value) )
     {
+    vtkIdType p = this->PointIds->GetId(0);
     this->Points->GetPoint(0, x);
-    if ( locator->InsertUniquePoint(x, pts[0]) )
+    if ( locator->InsertUniqueEdgePoint(p, p, 0.0, x, pts[0]) )
       {
-      outPd->CopyData(inPd,this->PointIds->GetId(0),pts[0]);
+      outPd->CopyData(inPd,p,pts[0]);
       }
     newCellId = verts->InsertNextCell(1,pts);
     outCd->CopyData(inCd,cellId,newCellId);
@@ -0,0 +1,290 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCachedCompositeDataPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkCachedCompositeDataPipeline
+// .SECTION Description
+// Scrubs the time steps of a time-aware source through a filter whose
+// outputs are cached, and checks the hits, the evictions and the
+// invalidation of the cache.
+
+#include "vtkCachedCompositeDataPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+//------------------------------------------------------------------------------
+// Produces 1000 * (t + 1) points at time step t.
+class vtkTimeStepSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTimeStepSource* New();
+  vtkTypeMacro(vtkTimeStepSource, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  vtkTimeStepSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfExecutions = 0;
+    }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+    {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double steps[10];
+    for (int i = 0; i < 10; ++i)
+      {
+      steps[i] = i;
+      }
+    double range[2] = { 0.0, 9.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+    {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    double time =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkNew<vtkPoints> points;
+    vtkIdType numPoints = 1000 * (static_cast<vtkIdType>(time) + 1);
+    points->SetNumberOfPoints(numPoints);
+    for (vtkIdType i = 0; i < numPoints; ++i)
+      {
+      points->SetPoint(i, i, time, 0.0);
+      }
+    output->SetPoints(points.GetPointer());
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    this->NumberOfExecutions++;
+    return 1;
+    }
+
+private:
+  vtkTimeStepSource(const vtkTimeStepSource&);  // Not implemented.
+  void operator=(const vtkTimeStepSource&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkTimeStepSource);
+
+//------------------------------------------------------------------------------
+class vtkCountingFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkCountingFilter* New();
+  vtkTypeMacro(vtkCountingFilter, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  vtkCountingFilter() { this->NumberOfExecutions = 0; }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+    {
+    vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    output->ShallowCopy(input);
+    this->NumberOfExecutions++;
+    return 1;
+    }
+
+private:
+  vtkCountingFilter(const vtkCountingFilter&);  // Not implemented.
+  void operator=(const vtkCountingFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkCountingFilter);
+
+//------------------------------------------------------------------------------
+// Update the filter at the given time and check its output.
+static bool UpdateTime(vtkCountingFilter* filter, double time)
+{
+  vtkStreamingDemandDrivenPipeline* exec =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(filter->GetExecutive());
+  exec->UpdateInformation();
+  exec->SetUpdateTimeStep(0, time);
+  filter->Update();
+  vtkPolyData* output = filter->GetOutput();
+  vtkIdType expected = 1000 * (static_cast<vtkIdType>(time) + 1);
+  if (output->GetNumberOfPoints() != expected ||
+      output->GetPoint(expected - 1)[1] != time ||
+      output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != time)
+    {
+    cerr << "Wrong output at time " << time << endl;
+    return false;
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int TestCachedCompositeDataPipeline(int, char*[])
+{
+  vtkNew<vtkTimeStepSource> source;
+  vtkNew<vtkCachedCompositeDataPipeline> exec;
+  vtkNew<vtkCountingFilter> filter;
+  filter->SetExecutive(exec.GetPointer());
+  filter->SetInputConnection(source->GetOutputPort());
+
+  // Scrub forward, then backward: the second pass comes from the cache.
+  for (int t = 0; t < 5; ++t)
+    {
+    if (!UpdateTime(filter.GetPointer(), t))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  if (exec->GetNumberOfMisses() != 5 || exec->GetNumberOfHits() != 0)
+    {
+    cerr << "Wrong statistics after the first pass" << endl;
+    return EXIT_FAILURE;
+    }
+  if (exec->GetNumberOfCachedOutputs() != 5 ||
+      exec->GetCacheMemorySize() == 0)
+    {
+    cerr << "Outputs not cached" << endl;
+    return EXIT_FAILURE;
+    }
+  for (int t = 4; t >= 0; --t)
+    {
+    if (!UpdateTime(filter.GetPointer(), t))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  if (exec->GetNumberOfHits() != 4 || exec->GetNumberOfMisses() != 5)
+    {
+    cerr << "Wrong statistics after the second pass: "
+         << exec->GetNumberOfHits() << " hits" << endl;
+    return EXIT_FAILURE;
+    }
+  if (source->NumberOfExecutions != 5 || filter->NumberOfExecutions != 5)
+    {
+    cerr << "Cached outputs were computed again" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // An up-to-date output is neither a hit nor a miss.
+  filter->Update();
+  if (exec->GetNumberOfHits() != 4 || exec->GetNumberOfMisses() != 5)
+    {
+    cerr << "Up-to-date output counted" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The memory estimate pass neither restores nor counts cached outputs.
+  exec->UpdateInformation();
+  exec->SetUpdateTimeStep(0, 3);
+  filter->EstimatePeakMemorySize();
+  if (exec->GetNumberOfHits() != 4 || exec->GetNumberOfMisses() != 5 ||
+      filter->GetOutput()->GetInformation()->Get(
+        vtkDataObject::DATA_TIME_STEP()) != 0)
+    {
+    cerr << "The memory estimate restored a cached output" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Modifying the pipeline discards the cached outputs.
+  source->Modified();
+  if (!UpdateTime(filter.GetPointer(), 3))
+    {
+    return EXIT_FAILURE;
+    }
+  if (!UpdateTime(filter.GetPointer(), 0))
+    {
+    return EXIT_FAILURE;
+    }
+  if (source->NumberOfExecutions != 7 || exec->GetNumberOfCachedOutputs() != 2)
+    {
+    cerr << "Stale outputs were used" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // With a budget that holds the two largest time steps only, the least
+  // recently used outputs are evicted.
+  exec->ClearCache();
+  exec->ResetStatistics();
+  unsigned long size = filter->GetOutput()->GetActualMemorySize();
+  if (!UpdateTime(filter.GetPointer(), 9))
+    {
+    return EXIT_FAILURE;
+    }
+  unsigned long largest = filter->GetOutput()->GetActualMemorySize();
+  if (largest <= 2 * size)
+    {
+    cerr << "Time steps too small for the test" << endl;
+    return EXIT_FAILURE;
+    }
+  exec->SetMemoryBudget(2 * largest);
+  for (int t = 6; t < 9; ++t)
+    {
+    if (!UpdateTime(filter.GetPointer(), t))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  if (exec->GetCacheMemorySize() > exec->GetMemoryBudget() ||
+      exec->GetNumberOfEvictions() == 0)
+    {
+    cerr << "Budget not respected" << endl;
+    return EXIT_FAILURE;
+    }
+  int executions = filter->NumberOfExecutions;
+  if (!UpdateTime(filter.GetPointer(), 8))
+    {
+    return EXIT_FAILURE;
+    }
+  if (filter->NumberOfExecutions != executions)
+    {
+    cerr << "Most recent output evicted" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!UpdateTime(filter.GetPointer(), 9))
+    {
+    return EXIT_FAILURE;
+    }
+  if (filter->NumberOfExecutions != executions + 1)
+    {
+    cerr << "Least recently used output not evicted" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Outputs larger than the budget are not cached.
+  exec->SetMemoryBudget(size / 2);
+  if (exec->GetNumberOfCachedOutputs() != 0)
+    {
+    cerr << "Budget not applied" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!UpdateTime(filter.GetPointer(), 2))
+    {
+    return EXIT_FAILURE;
+    }
+  if (exec->GetNumberOfCachedOutputs() != 0 || exec->GetCacheMemorySize() != 0)
+    {
+    cerr << "Output over budget cached" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
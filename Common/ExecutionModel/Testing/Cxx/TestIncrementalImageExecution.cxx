@@ -0,0 +1,363 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestIncrementalImageExecution.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the incremental execution of vtkThreadedImageAlgorithm
+// .SECTION Description
+// Edits a few voxels of an image in place and checks that a kernel
+// filter and a voxel by voxel filter downstream only recompute the
+// voxels that depend on them, and that their outputs stay correct.
+
+#include "vtkAtomicInt.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkThreadedImageAlgorithm.h"
+
+const int SIZE = 32;
+
+//------------------------------------------------------------------------------
+// Sums the input voxels of a 3x3x3 neighborhood, multiplied by Factor.
+class vtkBoxSumFilter : public vtkThreadedImageAlgorithm
+{
+public:
+  static vtkBoxSumFilter* New();
+  vtkTypeMacro(vtkBoxSumFilter, vtkThreadedImageAlgorithm);
+
+  vtkSetMacro(Factor, float);
+
+  virtual int ComputeModifiedOutputExtent(int, int, int inExt[6],
+                                          int outExt[6])
+    {
+    for (int i = 0; i < 6; ++i)
+      {
+      outExt[i] = inExt[i] + (i % 2 ? 1 : -1);
+      }
+    return 1;
+    }
+
+  vtkAtomicInt<int> NumberOfVoxels;
+
+protected:
+  vtkBoxSumFilter()
+    {
+    this->Factor = 1.0;
+    this->NumberOfVoxels = 0;
+    }
+
+  virtual int RequestUpdateExtent(vtkInformation*,
+                                  vtkInformationVector** inputVector,
+                                  vtkInformationVector* outputVector)
+    {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    int wholeExt[6], ext[6];
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+    outputVector->GetInformationObject(0)->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), ext);
+    for (int i = 0; i < 3; ++i)
+      {
+      ext[2*i] = ext[2*i] > wholeExt[2*i] ? ext[2*i] - 1 : wholeExt[2*i];
+      ext[2*i+1] =
+        ext[2*i+1] < wholeExt[2*i+1] ? ext[2*i+1] + 1 : wholeExt[2*i+1];
+      }
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), ext, 6);
+    return 1;
+    }
+
+  virtual void ThreadedExecute(vtkImageData* inData, vtkImageData* outData,
+                               int ext[6], int)
+    {
+    int* inExt = inData->GetExtent();
+    for (int z = ext[4]; z <= ext[5]; ++z)
+      {
+      for (int y = ext[2]; y <= ext[3]; ++y)
+        {
+        for (int x = ext[0]; x <= ext[1]; ++x)
+          {
+          float sum = 0.0;
+          for (int k = z - 1; k <= z + 1; ++k)
+            {
+            for (int j = y - 1; j <= y + 1; ++j)
+              {
+              for (int i = x - 1; i <= x + 1; ++i)
+                {
+                if (i >= inExt[0] && i <= inExt[1] &&
+                    j >= inExt[2] && j <= inExt[3] &&
+                    k >= inExt[4] && k <= inExt[5])
+                  {
+                  sum += *static_cast<float*>(
+                    inData->GetScalarPointer(i, j, k));
+                  }
+                }
+              }
+            }
+          *static_cast<float*>(outData->GetScalarPointer(x, y, z)) =
+            this->Factor * sum;
+          }
+        }
+      }
+    this->NumberOfVoxels +=
+      (ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+    }
+
+  float Factor;
+
+private:
+  vtkBoxSumFilter(const vtkBoxSumFilter&);  // Not implemented.
+  void operator=(const vtkBoxSumFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkBoxSumFilter);
+
+//------------------------------------------------------------------------------
+// Doubles its input voxel by voxel.
+class vtkDoubleFilter : public vtkThreadedImageAlgorithm
+{
+public:
+  static vtkDoubleFilter* New();
+  vtkTypeMacro(vtkDoubleFilter, vtkThreadedImageAlgorithm);
+
+  virtual int ComputeModifiedOutputExtent(int, int, int inExt[6],
+                                          int outExt[6])
+    {
+    for (int i = 0; i < 6; ++i)
+      {
+      outExt[i] = inExt[i];
+      }
+    return 1;
+    }
+
+  vtkAtomicInt<int> NumberOfVoxels;
+
+protected:
+  vtkDoubleFilter() { this->NumberOfVoxels = 0; }
+
+  virtual void ThreadedExecute(vtkImageData* inData, vtkImageData* outData,
+                               int ext[6], int)
+    {
+    for (int z = ext[4]; z <= ext[5]; ++z)
+      {
+      for (int y = ext[2]; y <= ext[3]; ++y)
+        {
+        for (int x = ext[0]; x <= ext[1]; ++x)
+          {
+          *static_cast<float*>(outData->GetScalarPointer(x, y, z)) = 2 *
+            *static_cast<float*>(inData->GetScalarPointer(x, y, z));
+          }
+        }
+      }
+    this->NumberOfVoxels +=
+      (ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+    }
+
+private:
+  vtkDoubleFilter(const vtkDoubleFilter&);  // Not implemented.
+  void operator=(const vtkDoubleFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkDoubleFilter);
+
+//------------------------------------------------------------------------------
+// Check the output of the pipeline against a direct computation.
+static bool CheckOutput(vtkImageData* image, vtkImageData* output,
+                        float factor)
+{
+  for (int z = 0; z < SIZE; ++z)
+    {
+    for (int y = 0; y < SIZE; ++y)
+      {
+      for (int x = 0; x < SIZE; ++x)
+        {
+        float sum = 0.0;
+        for (int k = z - 1; k <= z + 1; ++k)
+          {
+          for (int j = y - 1; j <= y + 1; ++j)
+            {
+            for (int i = x - 1; i <= x + 1; ++i)
+              {
+              if (i >= 0 && i < SIZE && j >= 0 && j < SIZE &&
+                  k >= 0 && k < SIZE)
+                {
+                sum += image->GetScalarComponentAsFloat(i, j, k, 0);
+                }
+              }
+            }
+          }
+        if (output->GetScalarComponentAsFloat(x, y, z, 0) !=
+            2 * factor * sum)
+          {
+          cerr << "Wrong value at " << x << " " << y << " " << z << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static void SetVoxel(vtkImageData* image, int x, int y, int z, float value)
+{
+  *static_cast<float*>(image->GetScalarPointer(x, y, z)) = value;
+}
+
+//------------------------------------------------------------------------------
+int TestIncrementalImageExecution(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, SIZE - 1, 0, SIZE - 1, 0, SIZE - 1);
+  image->AllocateScalars(VTK_FLOAT, 1);
+  float* values = static_cast<float*>(image->GetScalarPointer());
+  for (int i = 0; i < SIZE * SIZE * SIZE; ++i)
+    {
+    values[i] = i % 7;
+    }
+
+  vtkNew<vtkBoxSumFilter> box;
+  box->SetInputData(image.GetPointer());
+  vtkNew<vtkDoubleFilter> twice;
+  twice->SetInputConnection(box->GetOutputPort());
+  const int wholeSize = SIZE * SIZE * SIZE;
+
+  twice->Update();
+  vtkImageData* output = twice->GetOutput();
+  if (box->NumberOfVoxels.Load() != wholeSize ||
+      twice->NumberOfVoxels.Load() != wholeSize)
+    {
+    cerr << "Partial execution" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!CheckOutput(image.GetPointer(), output, 1.0))
+    {
+    cerr << "Wrong output" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Editing one voxel recomputes its neighborhood only, in place.
+  float* outputValues = static_cast<float*>(output->GetScalarPointer());
+  box->NumberOfVoxels = 0;
+  twice->NumberOfVoxels = 0;
+  SetVoxel(image.GetPointer(), 10, 10, 10, 100.0);
+  int voxel[6] = { 10, 10, 10, 10, 10, 10 };
+  image->MarkModifiedExtent(voxel);
+  twice->Update();
+  if (box->NumberOfVoxels.Load() != 27 || twice->NumberOfVoxels.Load() != 27)
+    {
+    cerr << "Not incremental: " << box->NumberOfVoxels.Load() << " and "
+         << twice->NumberOfVoxels.Load() << " voxels recomputed" << endl;
+    return EXIT_FAILURE;
+    }
+  if (output->GetScalarPointer() != outputValues ||
+      !CheckOutput(image.GetPointer(), output, 1.0))
+    {
+    cerr << "Wrong incremental output" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The output records the extent that changed.
+  int modifiedExtent[6];
+  if (!output->GetModifiedExtent(output->GetMTime(), modifiedExtent))
+    {
+    cerr << "Modified extent not recorded" << endl;
+    return EXIT_FAILURE;
+    }
+  if (modifiedExtent[0] != 9 || modifiedExtent[1] != 11 ||
+      modifiedExtent[4] != 9 || modifiedExtent[5] != 11)
+    {
+    cerr << "Wrong modified extent" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Extents marked between two updates are merged, and clipped to the
+  // update extent.
+  box->NumberOfVoxels = 0;
+  SetVoxel(image.GetPointer(), 0, 0, 0, 50.0);
+  int corner[6] = { 0, 0, 0, 0, 0, 0 };
+  image->MarkModifiedExtent(corner);
+  SetVoxel(image.GetPointer(), 1, 1, 1, 60.0);
+  int next[6] = { 1, 1, 1, 1, 1, 1 };
+  image->MarkModifiedExtent(next);
+  twice->Update();
+  if (box->NumberOfVoxels.Load() != 27 ||
+      !CheckOutput(image.GetPointer(), output, 1.0))
+    {
+    cerr << "Marked extents not merged: " << box->NumberOfVoxels.Load()
+         << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Nothing is recomputed when nothing changed.
+  box->NumberOfVoxels = 0;
+  int empty[6] = { 0, -1, 0, -1, 0, -1 };
+  image->MarkModifiedExtent(empty);
+  twice->Update();
+  if (box->NumberOfVoxels.Load() != 0 ||
+      !CheckOutput(image.GetPointer(), output, 1.0))
+    {
+    cerr << "Unchanged extent recomputed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Modifying an algorithm or its input otherwise recomputes everything.
+  box->NumberOfVoxels = 0;
+  twice->NumberOfVoxels = 0;
+  box->SetFactor(0.5);
+  twice->Update();
+  if (box->NumberOfVoxels.Load() != wholeSize ||
+      twice->NumberOfVoxels.Load() != wholeSize ||
+      !CheckOutput(image.GetPointer(), output, 0.5))
+    {
+    cerr << "Modified algorithm not executed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  box->NumberOfVoxels = 0;
+  SetVoxel(image.GetPointer(), 20, 20, 20, 70.0);
+  image->Modified();
+  twice->Update();
+  if (box->NumberOfVoxels.Load() != wholeSize ||
+      !CheckOutput(image.GetPointer(), output, 0.5))
+    {
+    cerr << "Modified input not executed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // So does a change of the update extent.
+  int half[6] = { 0, SIZE - 1, 0, SIZE - 1, 0, SIZE / 2 };
+  image->Modified();
+  twice->UpdateInformation();
+  twice->SetUpdateExtent(half);
+  twice->Update();
+  if (output->GetExtent()[5] != SIZE / 2)
+    {
+    cerr << "Wrong update extent" << endl;
+    return EXIT_FAILURE;
+    }
+  box->NumberOfVoxels = 0;
+  image->MarkModifiedExtent(voxel);
+  twice->SetUpdateExtentToWholeExtent();
+  twice->Update();
+  if (box->NumberOfVoxels.Load() != wholeSize ||
+      !CheckOutput(image.GetPointer(), output, 0.5))
+    {
+    cerr << "Wrong output after a change of the update extent" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,288 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestParallelBlockExecution.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkCompositeDataPipeline::ParallelBlockExecution
+// .SECTION Description
+// Runs a simple filter over a multiblock dataset with and without
+// parallel block execution and compares the outputs.  Checks that the
+// leaves are executed through CallAlgorithm(), that the progress is
+// reported from the calling thread only, and that filters with several
+// output ports still execute.
+
+#include "vtkAtomicInt.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkDataSetAlgorithm.h"
+#include "vtkExtractBlock.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLineSource.h"
+#include "vtkMultiBlockDataGroupFilter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Adds a point array holding Scale times the point ids.  RequestData() only
+// uses the information vectors, so the leaves can be processed in parallel.
+class vtkScaledIdsFilter : public vtkDataSetAlgorithm
+{
+public:
+  static vtkScaledIdsFilter* New();
+  vtkTypeMacro(vtkScaledIdsFilter, vtkDataSetAlgorithm);
+
+  double Scale;
+  vtkAtomicInt<int> NumberOfExecutions;
+
+  // The second output is a copy of the input.
+  void UseTwoOutputPorts() { this->SetNumberOfOutputPorts(2); }
+
+protected:
+  vtkScaledIdsFilter() { this->Scale = 2.0; }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+    {
+    vtkDataSet* input = vtkDataSet::GetData(inputVector[0]);
+    vtkDataSet* output = vtkDataSet::GetData(outputVector);
+    output->ShallowCopy(input);
+    // Give the other threads time to take leaves, even on one processor.
+    vtksys::SystemTools::Delay(1);
+    this->UpdateProgress(0.5);
+    if (this->GetNumberOfOutputPorts() > 1)
+      {
+      vtkDataSet::GetData(outputVector, 1)->ShallowCopy(input);
+      }
+    vtkNew<vtkFloatArray> ids;
+    ids->SetName("ScaledIds");
+    ids->SetNumberOfTuples(input->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+      {
+      ids->SetValue(i, static_cast<float>(this->Scale * i));
+      }
+    output->GetPointData()->AddArray(ids.GetPointer());
+    ++this->NumberOfExecutions;
+    return 1;
+    }
+
+private:
+  vtkScaledIdsFilter(const vtkScaledIdsFilter&);  // Not implemented.
+  void operator=(const vtkScaledIdsFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkScaledIdsFilter);
+
+//------------------------------------------------------------------------------
+// Records the progress and the thread that reported it.
+struct ProgressRecord
+{
+  std::vector<double> Values;
+  std::vector<int> Threads;
+};
+
+static void RecordProgress(vtkObject*, unsigned long, void* clientData,
+                           void* callData)
+{
+  ProgressRecord* record = static_cast<ProgressRecord*>(clientData);
+  record->Values.push_back(*static_cast<double*>(callData));
+  record->Threads.push_back(vtkSMPTools::GetThreadIndex());
+}
+
+//------------------------------------------------------------------------------
+int TestParallelBlockExecution(int, char*[])
+{
+  // Use several threads even on a single processor.
+  vtkSMPTools::Initialize(4);
+
+  // A multiblock of 40 lines of 10 to 49 points and a missing leaf, next
+  // to an image.
+  vtkNew<vtkMultiBlockDataGroupFilter> lines;
+  for (int b = 0; b < 41; ++b)
+    {
+    vtkNew<vtkLineSource> line;
+    line->SetResolution(9 + b);
+    lines->AddInputConnection(line->GetOutputPort());
+    }
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(1, 4, 0, 2, 0, 0);
+  vtkNew<vtkMultiBlockDataGroupFilter> group;
+  group->AddInputConnection(lines->GetOutputPort());
+  group->AddInputConnection(wavelet->GetOutputPort());
+  // The flat indices of the lines are 2 to 42, and 43 for the image.
+  // Leaving the last line out makes it a missing leaf.
+  vtkNew<vtkExtractBlock> input;
+  input->SetInputConnection(group->GetOutputPort());
+  for (unsigned int index = 2; index < 42; ++index)
+    {
+    input->AddIndex(index);
+    }
+  input->AddIndex(43);
+  input->PruneOutputOff();
+
+  // Both pipelines send the REQUEST_DATA pass of each leaf through
+  // CallAlgorithm().
+  vtkNew<vtkPipelineProfiler> profiler;
+  profiler->Start();
+
+  vtkNew<vtkCompositeDataPipeline> serialExec;
+  vtkNew<vtkScaledIdsFilter> serial;
+  serial->SetExecutive(serialExec.GetPointer());
+  serial->SetInputConnection(input->GetOutputPort());
+  serial->Update();
+
+  vtkNew<vtkCompositeDataPipeline> parallelExec;
+  parallelExec->ParallelBlockExecutionOn();
+  vtkNew<vtkScaledIdsFilter> parallel;
+  parallel->SetExecutive(parallelExec.GetPointer());
+  parallel->SetInputConnection(input->GetOutputPort());
+  ProgressRecord record;
+  vtkNew<vtkCallbackCommand> progress;
+  progress->SetCallback(RecordProgress);
+  progress->SetClientData(&record);
+  parallel->AddObserver(vtkCommand::ProgressEvent, progress.GetPointer());
+  parallel->Update();
+  parallel->RemoveObserver(progress.GetPointer());
+  profiler->Stop();
+
+  int caller = vtkSMPTools::GetThreadIndex();
+  if (record.Values.empty() || record.Values.back() != 1.0)
+    {
+    cerr << "Progress not reported" << endl;
+    return EXIT_FAILURE;
+    }
+  for (size_t i = 0; i < record.Values.size(); ++i)
+    {
+    if (record.Threads[i] != caller)
+      {
+      cerr << "Progress reported from another thread" << endl;
+      return EXIT_FAILURE;
+      }
+    if (i > 0 && record.Values[i] < record.Values[i - 1])
+      {
+      cerr << "Progress decreased" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  if (serial->NumberOfExecutions.Load() != 41 ||
+      parallel->NumberOfExecutions.Load() != 41)
+    {
+    cerr << "Wrong number of executions" << endl;
+    return EXIT_FAILURE;
+    }
+  if (profiler->GetNumberOfExecutions(serial.GetPointer()) != 41 ||
+      profiler->GetNumberOfExecutions(parallel.GetPointer()) != 41)
+    {
+    cerr << "Leaves not executed through CallAlgorithm()" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkMultiBlockDataSet* serialOut =
+    vtkMultiBlockDataSet::SafeDownCast(serial->GetOutputDataObject(0));
+  vtkMultiBlockDataSet* parallelOut =
+    vtkMultiBlockDataSet::SafeDownCast(parallel->GetOutputDataObject(0));
+  if (!serialOut || !parallelOut || parallelOut->GetNumberOfBlocks() != 2)
+    {
+    cerr << "Wrong output structure" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkMultiBlockDataSet* serialChild =
+    vtkMultiBlockDataSet::SafeDownCast(serialOut->GetBlock(0));
+  vtkMultiBlockDataSet* parallelChild =
+    vtkMultiBlockDataSet::SafeDownCast(parallelOut->GetBlock(0));
+  if (!parallelChild || parallelChild->GetNumberOfBlocks() != 41 ||
+      parallelChild->GetBlock(40) != NULL)
+    {
+    cerr << "Wrong output structure" << endl;
+    return EXIT_FAILURE;
+    }
+  for (unsigned int b = 0; b < 40; ++b)
+    {
+    vtkPolyData* s = vtkPolyData::SafeDownCast(serialChild->GetBlock(b));
+    vtkPolyData* p = vtkPolyData::SafeDownCast(parallelChild->GetBlock(b));
+    if (!s || !p || s == p ||
+        p->GetNumberOfPoints() != static_cast<vtkIdType>(10 + b))
+      {
+      cerr << "Wrong block " << b << endl;
+      return EXIT_FAILURE;
+      }
+    vtkDataArray* ids = p->GetPointData()->GetArray("ScaledIds");
+    if (!ids || ids->GetNumberOfTuples() != p->GetNumberOfPoints() ||
+        ids->GetComponent(9, 0) != 18.0 ||
+        ids->GetComponent(9, 0) !=
+        s->GetPointData()->GetArray("ScaledIds")->GetComponent(9, 0))
+      {
+      cerr << "Wrong array in block " << b << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  vtkImageData* image = vtkImageData::SafeDownCast(parallelOut->GetBlock(1));
+  if (!image || image->GetNumberOfPoints() != 12 ||
+      image->GetExtent()[0] != 1 ||
+      !image->GetPointData()->GetArray("ScaledIds"))
+    {
+    cerr << "Wrong image block" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The output is regenerated when the parameters change.
+  parallel->Scale = 3.0;
+  parallel->Modified();
+  parallel->Update();
+  parallelOut =
+    vtkMultiBlockDataSet::SafeDownCast(parallel->GetOutputDataObject(0));
+  parallelChild = vtkMultiBlockDataSet::SafeDownCast(parallelOut->GetBlock(0));
+  vtkPolyData* p = vtkPolyData::SafeDownCast(parallelChild->GetBlock(3));
+  if (p->GetPointData()->GetArray("ScaledIds")->GetComponent(2, 0) != 6.0)
+    {
+    cerr << "Output not regenerated" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Filters with several outputs are executed serially.
+  vtkNew<vtkCompositeDataPipeline> twoPortsExec;
+  twoPortsExec->ParallelBlockExecutionOn();
+  vtkNew<vtkScaledIdsFilter> twoPorts;
+  twoPorts->UseTwoOutputPorts();
+  twoPorts->SetExecutive(twoPortsExec.GetPointer());
+  twoPorts->SetInputConnection(input->GetOutputPort());
+  twoPorts->Update();
+  vtkMultiBlockDataSet* out =
+    vtkMultiBlockDataSet::SafeDownCast(twoPorts->GetOutputDataObject(0));
+  vtkMultiBlockDataSet* child =
+    out ? vtkMultiBlockDataSet::SafeDownCast(out->GetBlock(0)) : NULL;
+  p = child ? vtkPolyData::SafeDownCast(child->GetBlock(3)) : NULL;
+  if (twoPorts->NumberOfExecutions.Load() != 41 || !p ||
+      p->GetNumberOfPoints() != 13 ||
+      !p->GetPointData()->GetArray("ScaledIds"))
+    {
+    cerr << "Wrong output with two output ports" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
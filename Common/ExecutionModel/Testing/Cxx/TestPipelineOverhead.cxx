@@ -0,0 +1,243 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineOverhead.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test speed of the pipeline bookkeeping.
+// .SECTION Description
+// Time Update() on a long pipeline of filters that do no work, so that
+// only the cost of the requests and of the vtkInformation lookups is
+// measured.  Also checks that keys stored in the dense slots of
+// vtkInformation behave as the other keys.
+
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIterator.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPassInputTypeAlgorithm.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimerLog.h"
+#include "vtkTrivialProducer.h"
+
+#include <vector>
+
+// Number of filters of the pipeline.
+const int NUMBER_OF_FILTERS = 500;
+
+// How many times the updates are run to average the elapsed time.
+const int STRESS_COUNT = 20;
+
+//------------------------------------------------------------------------------
+class vtkNoOpFilter : public vtkPassInputTypeAlgorithm
+{
+public:
+  static vtkNoOpFilter* New();
+  vtkTypeMacro(vtkNoOpFilter, vtkPassInputTypeAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  vtkNoOpFilter() { this->NumberOfExecutions = 0; }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+    {
+    vtkDataObject* input = vtkDataObject::GetData(inputVector[0]);
+    vtkDataObject* output = vtkDataObject::GetData(outputVector);
+    output->ShallowCopy(input);
+    this->NumberOfExecutions++;
+    return 1;
+    }
+
+private:
+  vtkNoOpFilter(const vtkNoOpFilter&);  // Not implemented.
+  void operator=(const vtkNoOpFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkNoOpFilter);
+
+//------------------------------------------------------------------------------
+static void ReportTime(const char* name, double time)
+{
+  std::cout << "<DartMeasurement name=\"" << name
+            << "\" type=\"numeric/double\">"
+            << time << "</DartMeasurement>" << std::endl;
+}
+
+//------------------------------------------------------------------------------
+static int TestSlots()
+{
+  vtkInformationIntegerKey* slotKey =
+    vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER();
+  vtkInformationIntegerKey* mapKey =
+    vtkStreamingDemandDrivenPipeline::UPDATE_AMR_LEVEL();
+  if (slotKey->GetSlot() < 0 ||
+      vtkInformationKey::GetKeyInSlot(slotKey->GetSlot()) != slotKey)
+    {
+    cerr << "UPDATE_PIECE_NUMBER does not use a slot" << endl;
+    return EXIT_FAILURE;
+    }
+  if (mapKey->GetSlot() >= 0)
+    {
+    cerr << "UPDATE_AMR_LEVEL uses a slot" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkInformation> info;
+  info->Set(slotKey, 3);
+  info->Set(mapKey, 4);
+  info->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(),
+            0, 1, 2, 3, 4, 5);
+  if (!info->Has(slotKey) || info->Get(slotKey) != 3 || info->Get(mapKey) != 4)
+    {
+    cerr << "Wrong values" << endl;
+    return EXIT_FAILURE;
+    }
+  if (info->GetNumberOfKeys() != 3)
+    {
+    cerr << "Wrong number of keys" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkInformation> copy;
+  copy->Copy(info.GetPointer());
+  if (copy->Get(slotKey) != 3 || copy->Get(mapKey) != 4 ||
+      copy->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT())[5] != 5)
+    {
+    cerr << "Copy failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  info->Remove(slotKey);
+  if (info->Has(slotKey) || !info->Has(mapKey))
+    {
+    cerr << "Remove failed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  int count = 0;
+  vtkNew<vtkInformationIterator> iter;
+  iter->SetInformationWeak(copy.GetPointer());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+       iter->GoToNextItem())
+    {
+    if (!iter->GetCurrentKey()->Has(copy.GetPointer()))
+      {
+      cerr << "Iterator returned a key that is not set" << endl;
+      return EXIT_FAILURE;
+      }
+    count++;
+    }
+  if (count != 3)
+    {
+    cerr << "Iterator visited " << count << " keys" << endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+int TestPipelineOverhead(int, char*[])
+{
+  if (TestSlots() != EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(2, 2, 2);
+  vtkNew<vtkTrivialProducer> source;
+  source->SetOutput(image.GetPointer());
+
+  std::vector<vtkSmartPointer<vtkNoOpFilter> > filters;
+  vtkAlgorithm* last = source.GetPointer();
+  for (int i = 0; i < NUMBER_OF_FILTERS; ++i)
+    {
+    vtkSmartPointer<vtkNoOpFilter> filter =
+      vtkSmartPointer<vtkNoOpFilter>::New();
+    filter->SetInputConnection(last->GetOutputPort());
+    filters.push_back(filter);
+    last = filter;
+    }
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  last->Update();
+  timer->StopTimer();
+  ReportTime("FirstUpdate", timer->GetElapsedTime());
+
+  // Nothing is modified: only the requests travel up and down.
+  timer->StartTimer();
+  for (int i = 0; i < STRESS_COUNT; ++i)
+    {
+    last->Update();
+    }
+  timer->StopTimer();
+  ReportTime("UpToDateUpdate", timer->GetElapsedTime() / STRESS_COUNT);
+
+  // The source is modified: every filter executes again.
+  timer->StartTimer();
+  for (int i = 0; i < STRESS_COUNT; ++i)
+    {
+    image->Modified();
+    last->Update();
+    }
+  timer->StopTimer();
+  ReportTime("ModifiedUpdate", timer->GetElapsedTime() / STRESS_COUNT);
+
+  for (int i = 0; i < NUMBER_OF_FILTERS; ++i)
+    {
+    if (filters[i]->NumberOfExecutions != STRESS_COUNT + 1)
+      {
+      cerr << "Filter " << i << " executed "
+           << filters[i]->NumberOfExecutions << " times" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+  if (!vtkImageData::SafeDownCast(last->GetOutputDataObject(0)) ||
+      last->GetOutputDataObject(0)->GetNumberOfElements(
+        vtkDataObject::POINT) != 8)
+    {
+    cerr << "Wrong output" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Raw cost of the lookups, for keys with and without a slot.
+  vtkNew<vtkInformation> info;
+  vtkInformationIntegerKey* keys[2] =
+    { vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+      vtkStreamingDemandDrivenPipeline::UPDATE_AMR_LEVEL() };
+  const char* names[2] = { "SlotKeyLookup", "MapKeyLookup" };
+  for (int k = 0; k < 2; ++k)
+    {
+    info->Set(keys[k], 1);
+    int sum = 0;
+    timer->StartTimer();
+    for (int i = 0; i < 1000000; ++i)
+      {
+      sum += info->Get(keys[k]);
+      }
+    timer->StopTimer();
+    ReportTime(names[k], timer->GetElapsedTime());
+    if (sum != 1000000)
+      {
+      cerr << "Wrong lookup" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
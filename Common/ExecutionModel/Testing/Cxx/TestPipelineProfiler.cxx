@@ -0,0 +1,296 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkPipelineProfiler
+// .SECTION Description
+// Profiles the updates of a small pipeline and checks the number of
+// executions, their reasons and the exported trace, and that deleted
+// algorithms and cleared records are forgotten.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vtksys/ios/sstream>
+
+#include <string>
+
+//------------------------------------------------------------------------------
+// Produces NumberOfPoints points.
+class vtkPointsSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkPointsSource* New();
+  vtkTypeMacro(vtkPointsSource, vtkPolyDataAlgorithm);
+
+  vtkSetMacro(NumberOfPoints, int);
+
+protected:
+  vtkPointsSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfPoints = 10000;
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+    {
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(this->NumberOfPoints);
+    for (int i = 0; i < this->NumberOfPoints; ++i)
+      {
+      points->SetPoint(i, i, 0.0, 0.0);
+      }
+    vtkPolyData::GetData(outputVector)->SetPoints(points.GetPointer());
+    return 1;
+    }
+
+  int NumberOfPoints;
+
+private:
+  vtkPointsSource(const vtkPointsSource&);  // Not implemented.
+  void operator=(const vtkPointsSource&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkPointsSource);
+
+//------------------------------------------------------------------------------
+// Copies its input.
+class vtkProfiledCopyFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkProfiledCopyFilter* New();
+  vtkTypeMacro(vtkProfiledCopyFilter, vtkPolyDataAlgorithm);
+
+  vtkSetMacro(Value, int);
+
+protected:
+  vtkProfiledCopyFilter() { this->Value = 0; }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+    {
+    vtkPolyData::GetData(outputVector)->ShallowCopy(
+      vtkPolyData::GetData(inputVector[0]));
+    return 1;
+    }
+
+  int Value;
+
+private:
+  vtkProfiledCopyFilter(const vtkProfiledCopyFilter&);  // Not implemented.
+  void operator=(const vtkProfiledCopyFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkProfiledCopyFilter);
+
+//------------------------------------------------------------------------------
+int TestPipelineProfiler(int, char*[])
+{
+  vtkNew<vtkPointsSource> source;
+  vtkNew<vtkProfiledCopyFilter> filter;
+  filter->SetInputConnection(source->GetOutputPort());
+
+  vtkNew<vtkPipelineProfiler> profiler;
+  profiler->Start();
+  if (vtkPipelineProfiler::GetStartedProfiler() != profiler.GetPointer())
+    {
+    cerr << "Profiler not started" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Every pass of every algorithm is recorded.
+  filter->Update();
+  if (profiler->GetNumberOfExecutions(source.GetPointer()) != 1 ||
+      profiler->GetNumberOfExecutions(filter.GetPointer()) != 1)
+    {
+    cerr << "Wrong number of executions" << endl;
+    return EXIT_FAILURE;
+    }
+  if (profiler->GetNumberOfRequests(filter.GetPointer()) <= 1 ||
+      profiler->GetNumberOfRecords() <
+      profiler->GetNumberOfRequests(source.GetPointer()) +
+      profiler->GetNumberOfRequests(filter.GetPointer()))
+    {
+    cerr << "Passes not recorded" << endl;
+    return EXIT_FAILURE;
+    }
+  if (profiler->GetLastExecutionReason(source.GetPointer()) !=
+      "first execution")
+    {
+    cerr << "Wrong reason of the first execution" << endl;
+    return EXIT_FAILURE;
+    }
+  if (profiler->GetOutputMemorySize(source.GetPointer()) <= 0 ||
+      profiler->GetWallTime(source.GetPointer()) < 0.0)
+    {
+    cerr << "Output size not recorded" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Nothing executes when everything is up to date.
+  filter->Update();
+  if (profiler->GetNumberOfReExecutions(source.GetPointer()) != 0 ||
+      profiler->GetNumberOfReExecutions(filter.GetPointer()) != 0)
+    {
+    cerr << "Up-to-date algorithms executed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Each re-execution is explained.
+  filter->SetValue(1);
+  filter->Update();
+  if (profiler->GetNumberOfReExecutions(source.GetPointer()) != 0 ||
+      profiler->GetNumberOfReExecutions(filter.GetPointer()) != 1 ||
+      profiler->GetLastExecutionReason(filter.GetPointer()) !=
+      "algorithm modified")
+    {
+    cerr << "Modified algorithm not reported" << endl;
+    return EXIT_FAILURE;
+    }
+
+  source->SetNumberOfPoints(20000);
+  filter->Update();
+  if (profiler->GetLastExecutionReason(source.GetPointer()) !=
+      "algorithm modified" ||
+      profiler->GetLastExecutionReason(filter.GetPointer()) !=
+      "input 0:0 modified by vtkPointsSource")
+    {
+    cerr << "Modified input not reported: "
+         << profiler->GetLastExecutionReason(filter.GetPointer()) << endl;
+    return EXIT_FAILURE;
+    }
+
+  filter->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SetUpdateNumberOfPieces(
+    filter->GetOutputInformation(0), 2);
+  filter->Update();
+  if (profiler->GetNumberOfReExecutions(source.GetPointer()) != 2 ||
+      profiler->GetLastExecutionReason(source.GetPointer()) !=
+      "update request changed")
+    {
+    cerr << "Changed request not reported: "
+         << profiler->GetLastExecutionReason(source.GetPointer()) << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The summary and the trace name the algorithms and passes.
+  vtksys_ios::ostringstream summary;
+  profiler->PrintSummary(summary);
+  if (summary.str().find("vtkPointsSource") == std::string::npos ||
+      summary.str().find("vtkProfiledCopyFilter") == std::string::npos)
+    {
+    cerr << "Wrong summary:\n" << summary.str() << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtksys_ios::ostringstream trace;
+  profiler->WriteChromeTrace(trace);
+  std::string json = trace.str();
+  if (json.find("{\"traceEvents\":[") != 0 ||
+      json.find("\"cat\":\"REQUEST_DATA\"") == std::string::npos ||
+      json.find("\"cat\":\"REQUEST_INFORMATION\"") == std::string::npos ||
+      json.find("\"reason\":\"update request changed\"") ==
+      std::string::npos ||
+      json.find(",\n]") != std::string::npos)
+    {
+    cerr << "Wrong trace:\n" << json << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Nothing is recorded once stopped.
+  profiler->Stop();
+  vtkIdType numberOfRecords = profiler->GetNumberOfRecords();
+  source->Modified();
+  filter->Update();
+  if (vtkPipelineProfiler::GetStartedProfiler() ||
+      profiler->GetNumberOfRecords() != numberOfRecords)
+    {
+    cerr << "Stopped profiler recorded requests" << endl;
+    return EXIT_FAILURE;
+    }
+
+  profiler->Clear();
+  if (profiler->GetNumberOfRecords() != 0 ||
+      profiler->GetNumberOfExecutions(source.GetPointer()) != 0)
+    {
+    cerr << "Records not cleared" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // A request that began before Clear() does not end a later one.
+  vtkNew<vtkInformation> request;
+  request->Set(vtkDemandDrivenPipeline::REQUEST_DATA());
+  vtkInformationVector** inInfo =
+    source->GetExecutive()->GetInputInformation();
+  vtkInformationVector* outInfo =
+    source->GetExecutive()->GetOutputInformation();
+  vtkIdType before =
+    profiler->BeginRequest(source.GetPointer(), request.GetPointer(), inInfo);
+  profiler->Clear();
+  vtkIdType after =
+    profiler->BeginRequest(source.GetPointer(), request.GetPointer(), inInfo);
+  profiler->EndRequest(before, outInfo, 1);
+  vtksys_ios::ostringstream clearedTrace;
+  profiler->WriteChromeTrace(clearedTrace);
+  if (before == after || profiler->GetNumberOfRecords() != 1 ||
+      clearedTrace.str().find("REQUEST_DATA") != std::string::npos)
+    {
+    cerr << "Request ended after Clear()" << endl;
+    return EXIT_FAILURE;
+    }
+  profiler->EndRequest(after, outInfo, 1);
+  vtksys_ios::ostringstream endedTrace;
+  profiler->WriteChromeTrace(endedTrace);
+  if (endedTrace.str().find("REQUEST_DATA") == std::string::npos)
+    {
+    cerr << "Request not ended" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The statistics of a deleted algorithm are not those of a new one.
+  profiler->Start();
+  vtkPointsSource* deleted = vtkPointsSource::New();
+  deleted->Update();
+  deleted->Delete();
+  vtkPointsSource* created = vtkPointsSource::New();
+  if (profiler->GetNumberOfExecutions(created) != 0)
+    {
+    cerr << "Deleted algorithm not forgotten" << endl;
+    return EXIT_FAILURE;
+    }
+  created->Update();
+  if (profiler->GetNumberOfExecutions(created) != 1)
+    {
+    cerr << "New algorithm not profiled" << endl;
+    return EXIT_FAILURE;
+    }
+  created->Delete();
+  profiler->Stop();
+  vtksys_ios::ostringstream deletedSummary;
+  profiler->PrintSummary(deletedSummary);
+  if (deletedSummary.str().find("deleted)") == std::string::npos)
+    {
+    cerr << "Wrong summary:\n" << deletedSummary.str() << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,241 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedImageAlgorithmSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the execution of vtkThreadedImageAlgorithm in bricks
+// .SECTION Description
+// Checks the division of extents into bricks by vtkExtentTranslator, and
+// that a threaded image algorithm with EnableSMP on computes each voxel
+// once, in bricks of the requested size, on the vtkSMPTools threads.
+
+#include "vtkExtentTranslator.h"
+#include "vtkImageData.h"
+#include "vtkMutexLock.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkThreadedImageAlgorithm.h"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Adds 1 to its input voxel by voxel, and counts how many times each
+// voxel is computed.  The largest brick size and thread id are kept.
+class vtkAddOneFilter : public vtkThreadedImageAlgorithm
+{
+public:
+  static vtkAddOneFilter* New();
+  vtkTypeMacro(vtkAddOneFilter, vtkThreadedImageAlgorithm);
+
+  std::vector<int> Counts;
+  vtkIdType LargestPiece;
+  int LargestThreadId;
+  vtkSimpleMutexLock Mutex;
+
+protected:
+  vtkAddOneFilter()
+    {
+    this->LargestPiece = 0;
+    this->LargestThreadId = 0;
+    }
+
+  virtual void ThreadedExecute(vtkImageData* inData, vtkImageData* outData,
+                               int ext[6], int threadId)
+    {
+    int* wholeExt = outData->GetExtent();
+    int dimX = wholeExt[1] - wholeExt[0] + 1;
+    int dimY = wholeExt[3] - wholeExt[2] + 1;
+    for (int z = ext[4]; z <= ext[5]; ++z)
+      {
+      for (int y = ext[2]; y <= ext[3]; ++y)
+        {
+        float* in = static_cast<float*>(inData->GetScalarPointer(ext[0], y, z));
+        float* out =
+          static_cast<float*>(outData->GetScalarPointer(ext[0], y, z));
+        for (int x = ext[0]; x <= ext[1]; ++x)
+          {
+          *out++ = *in++ + 1;
+          if (!this->Counts.empty())
+            {
+            ++this->Counts[x - wholeExt[0] +
+                           dimX * (y - wholeExt[2] + dimY * (z - wholeExt[4]))];
+            }
+          }
+        }
+      }
+    if (!this->Counts.empty())
+      {
+      vtkIdType size = static_cast<vtkIdType>(ext[1] - ext[0] + 1) *
+        (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+      this->Mutex.Lock();
+      if (size > this->LargestPiece)
+        {
+        this->LargestPiece = size;
+        }
+      if (threadId > this->LargestThreadId)
+        {
+        this->LargestThreadId = threadId;
+        }
+      this->Mutex.Unlock();
+      }
+    }
+
+private:
+  vtkAddOneFilter(const vtkAddOneFilter&);  // Not implemented.
+  void operator=(const vtkAddOneFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkAddOneFilter);
+
+//------------------------------------------------------------------------------
+// Check that the bricks of a division of extent cover it exactly once.
+static bool CheckBricks(const int extent[6], const int bricks[3])
+{
+  int dim[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    dim[i] = extent[2*i+1] - extent[2*i] + 1;
+    }
+  std::vector<int> counts(dim[0] * dim[1] * dim[2], 0);
+  int numBricks = bricks[0] * bricks[1] * bricks[2];
+  for (int brick = 0; brick < numBricks; ++brick)
+    {
+    int ext[6];
+    vtkExtentTranslator::BrickToExtent(brick, extent, bricks, ext);
+    for (int z = ext[4]; z <= ext[5]; ++z)
+      {
+      for (int y = ext[2]; y <= ext[3]; ++y)
+        {
+        for (int x = ext[0]; x <= ext[1]; ++x)
+          {
+          ++counts[x - extent[0] +
+                   dim[0] * (y - extent[2] + dim[1] * (z - extent[4]))];
+          }
+        }
+      }
+    }
+  for (size_t i = 0; i < counts.size(); ++i)
+    {
+    if (counts[i] != 1)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int TestThreadedImageAlgorithmSMP(int, char*[])
+{
+  // Division of extents into bricks.
+  int extent[6] = { 10, 109, -5, 94, 0, 9 };
+  int minSize[3] = { 16, 1, 1 };
+  int bricks[3];
+  int numBricks = vtkExtentTranslator::ComputeBricks(
+    extent, 1000, minSize, vtkExtentTranslator::BLOCK_MODE, bricks);
+  if (numBricks < 100 || numBricks >= 200 ||
+      numBricks != bricks[0] * bricks[1] * bricks[2] || bricks[0] > 100 / 16)
+    {
+    cerr << "Wrong blocks: " << bricks[0] << " " << bricks[1] << " "
+         << bricks[2] << endl;
+    return EXIT_FAILURE;
+    }
+  if (!CheckBricks(extent, bricks))
+    {
+    cerr << "Blocks do not cover the extent" << endl;
+    return EXIT_FAILURE;
+    }
+
+  numBricks = vtkExtentTranslator::ComputeBricks(
+    extent, 1000, minSize, vtkExtentTranslator::Z_SLAB_MODE, bricks);
+  if (numBricks != 100 || bricks[0] != 1 || bricks[1] != 10 ||
+      bricks[2] != 10)
+    {
+    cerr << "Wrong slabs" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!CheckBricks(extent, bricks))
+    {
+    cerr << "Slabs do not cover the extent" << endl;
+    return EXIT_FAILURE;
+    }
+
+  numBricks = vtkExtentTranslator::ComputeBricks(
+    extent, 1, minSize, vtkExtentTranslator::X_SLAB_MODE, bricks);
+  if (numBricks != 6 * 100 * 10 || bricks[0] != 6)
+    {
+    cerr << "Minimum brick size not respected" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!CheckBricks(extent, bricks))
+    {
+    cerr << "Bricks do not cover the extent" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Execution in bricks.
+  const int size = 64;
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, size - 1, 0, size - 1, 0, size - 1);
+  image->AllocateScalars(VTK_FLOAT, 1);
+  float* values = static_cast<float*>(image->GetScalarPointer());
+  for (int i = 0; i < size * size * size; ++i)
+    {
+    values[i] = i % 11;
+    }
+
+  vtkNew<vtkAddOneFilter> filter;
+  filter->SetInputData(image.GetPointer());
+  filter->EnableSMPOn();
+  filter->SetDesiredBytesPerPiece(4096);
+  filter->Counts.resize(size * size * size, 0);
+  filter->Update();
+  if (filter->GetNumberOfPieces() < size * size * size / 1024 ||
+      filter->LargestPiece > 1024)
+    {
+    cerr << "Wrong pieces: " << filter->GetNumberOfPieces() << ", largest "
+         << filter->LargestPiece << " voxels" << endl;
+    return EXIT_FAILURE;
+    }
+  if (filter->LargestThreadId >= vtkSMPTools::GetMaximumNumberOfThreads())
+    {
+    cerr << "Wrong thread id " << filter->LargestThreadId << endl;
+    return EXIT_FAILURE;
+    }
+  float* output = static_cast<float*>(filter->GetOutput()->GetScalarPointer());
+  for (int i = 0; i < size * size * size; ++i)
+    {
+    if (filter->Counts[i] != 1 || output[i] != values[i] + 1)
+      {
+      cerr << "Voxel " << i << " computed " << filter->Counts[i] << " times"
+           << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // A small image is one piece.
+  vtkNew<vtkImageData> slice;
+  slice->SetExtent(0, 31, 0, 31, 0, 0);
+  slice->AllocateScalars(VTK_FLOAT, 1);
+  vtkNew<vtkAddOneFilter> sliceFilter;
+  sliceFilter->SetInputData(slice.GetPointer());
+  sliceFilter->EnableSMPOn();
+  sliceFilter->Update();
+  if (sliceFilter->GetNumberOfPieces() != 1)
+    {
+    cerr << "Small image divided" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,289 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedStreamingPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the task graph execution of vtkThreadedStreamingPipeline
+// .SECTION Description
+// Updates a fan-out/fan-in pipeline of slow readers and filters with and
+// without vtkExecutionScheduler, checks that every algorithm executed once
+// after its inputs and reports the speedup.
+
+#include "vtkAtomicInt.h"
+#include "vtkExecutionScheduler.h"
+#include "vtkExecutiveCollection.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedStreamingPipeline.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <vector>
+
+// Number of branches between the fan-out and the fan-in.
+const int NUMBER_OF_BRANCHES = 4;
+
+// Time spent by each reader and each filter, in milliseconds.
+const unsigned int DELAY = 50;
+
+// Number of algorithms executing at the same time.
+static vtkAtomicInt<int> Running;
+static vtkAtomicInt<int> MaximumRunning;
+
+static void StartExecution()
+{
+  int running = ++Running;
+  int maximum = MaximumRunning.Load();
+  while (running > maximum)
+    {
+    // Losing the race to another thread only lowers the reported value.
+    MaximumRunning = running;
+    maximum = MaximumRunning.Load();
+    }
+}
+
+//------------------------------------------------------------------------------
+static void ReportTime(const char* name, double time)
+{
+  std::cout << "<DartMeasurement name=\"" << name
+            << "\" type=\"numeric/double\">"
+            << time << "</DartMeasurement>" << std::endl;
+}
+
+//------------------------------------------------------------------------------
+// Waits, as when reading a file, and produces NumberOfPoints points.
+class vtkSlowReader : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkSlowReader* New();
+  vtkTypeMacro(vtkSlowReader, vtkPolyDataAlgorithm);
+
+  int NumberOfPoints;
+  int NumberOfExecutions;
+
+protected:
+  vtkSlowReader()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfPoints = 1;
+    this->NumberOfExecutions = 0;
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+    {
+    StartExecution();
+    vtksys::SystemTools::Delay(DELAY);
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(this->NumberOfPoints);
+    for (int i = 0; i < this->NumberOfPoints; ++i)
+      {
+      points->SetPoint(i, i, 0.0, 0.0);
+      }
+    output->SetPoints(points.GetPointer());
+    this->NumberOfExecutions++;
+    --Running;
+    return 1;
+    }
+
+private:
+  vtkSlowReader(const vtkSlowReader&);  // Not implemented.
+  void operator=(const vtkSlowReader&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkSlowReader);
+
+//------------------------------------------------------------------------------
+// Waits and merges the points of all its inputs.
+class vtkSlowMerge : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkSlowMerge* New();
+  vtkTypeMacro(vtkSlowMerge, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  vtkSlowMerge() { this->NumberOfExecutions = 0; }
+
+  virtual int FillInputPortInformation(int port, vtkInformation* info)
+    {
+    info->Set(vtkAlgorithm::INPUT_IS_REPEATABLE(), 1);
+    return this->Superclass::FillInputPortInformation(port, info);
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+    {
+    StartExecution();
+    vtksys::SystemTools::Delay(DELAY);
+    vtkNew<vtkPoints> points;
+    for (int i = 0; i < inputVector[0]->GetNumberOfInformationObjects(); ++i)
+      {
+      vtkPolyData* input = vtkPolyData::GetData(inputVector[0], i);
+      for (vtkIdType p = 0; p < input->GetNumberOfPoints(); ++p)
+        {
+        points->InsertNextPoint(input->GetPoint(p));
+        }
+      }
+    vtkPolyData::GetData(outputVector)->SetPoints(points.GetPointer());
+    this->NumberOfExecutions++;
+    --Running;
+    return 1;
+    }
+
+private:
+  vtkSlowMerge(const vtkSlowMerge&);  // Not implemented.
+  void operator=(const vtkSlowMerge&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkSlowMerge);
+
+//------------------------------------------------------------------------------
+int TestThreadedStreamingPipeline(int, char*[])
+{
+  // Readers mostly wait, so they overlap even on a single core.
+  vtkSMPTools::Initialize(NUMBER_OF_BRANCHES);
+
+  vtkNew<vtkThreadedStreamingPipeline> prototype;
+  vtkAlgorithm::SetDefaultExecutivePrototype(prototype.GetPointer());
+
+  // Each reader feeds its own filter, and the shared reader feeds all of
+  // them: shared -> filter i <- reader i, then filter i -> sink.
+  vtkNew<vtkSlowReader> shared;
+  shared->NumberOfPoints = 1000;
+  std::vector<vtkSmartPointer<vtkSlowReader> > readers;
+  std::vector<vtkSmartPointer<vtkSlowMerge> > filters;
+  vtkNew<vtkSlowMerge> sink;
+  for (int i = 0; i < NUMBER_OF_BRANCHES; ++i)
+    {
+    vtkSmartPointer<vtkSlowReader> reader =
+      vtkSmartPointer<vtkSlowReader>::New();
+    reader->NumberOfPoints = 10 * (i + 1);
+    vtkSmartPointer<vtkSlowMerge> filter = vtkSmartPointer<vtkSlowMerge>::New();
+    filter->AddInputConnection(reader->GetOutputPort());
+    filter->AddInputConnection(shared->GetOutputPort());
+    sink->AddInputConnection(filter->GetOutputPort());
+    readers.push_back(reader);
+    filters.push_back(filter);
+    }
+  vtkAlgorithm::SetDefaultExecutivePrototype(0);
+
+  int expected = 0;
+  for (int i = 0; i < NUMBER_OF_BRANCHES; ++i)
+    {
+    expected += 10 * (i + 1) + 1000;
+    }
+
+  const char* names[2] = { "SerialUpdate", "TaskGraphUpdate" };
+  double times[2];
+  vtkNew<vtkTimerLog> timer;
+  for (int run = 0; run < 2; ++run)
+    {
+    vtkThreadedStreamingPipeline::SetMultiThreadedEnabled(run == 1);
+    shared->Modified();
+    for (int i = 0; i < NUMBER_OF_BRANCHES; ++i)
+      {
+      readers[i]->Modified();
+      }
+    MaximumRunning = 0;
+    timer->StartTimer();
+    sink->Update();
+    timer->StopTimer();
+    times[run] = timer->GetElapsedTime();
+    ReportTime(names[run], times[run]);
+
+    // Every algorithm executed once, after its inputs.
+    if (sink->GetOutput()->GetNumberOfPoints() != expected)
+      {
+      cerr << "Wrong output: " << sink->GetOutput()->GetNumberOfPoints()
+           << endl;
+      return EXIT_FAILURE;
+      }
+    if (shared->NumberOfExecutions != run + 1 ||
+        sink->NumberOfExecutions != run + 1)
+      {
+      cerr << "Wrong number of executions" << endl;
+      return EXIT_FAILURE;
+      }
+    for (int i = 0; i < NUMBER_OF_BRANCHES; ++i)
+      {
+      if (readers[i]->NumberOfExecutions != run + 1 ||
+          filters[i]->NumberOfExecutions != run + 1)
+        {
+        cerr << "Wrong number of executions in branch " << i << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+  ReportTime("Speedup", times[0] / times[1]);
+
+  vtkExecutionScheduler* scheduler =
+    vtkExecutionScheduler::GetGlobalScheduler();
+  if (vtkSMPTools::GetEstimatedNumberOfThreads() > 1)
+    {
+    if (scheduler->GetMaximumNumberOfConcurrentTasks() <= 1 ||
+        MaximumRunning.Load() <= 1)
+      {
+      cerr << "Independent branches did not execute concurrently" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Nothing executes when everything is up to date.
+  sink->Update();
+  if (shared->NumberOfExecutions != 2 || sink->NumberOfExecutions != 2)
+    {
+    cerr << "Up-to-date algorithms executed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Pull() updates the given executives and everything upstream.
+  readers[0]->Modified();
+  vtkThreadedStreamingPipeline::Pull(filters[0]->GetExecutive());
+  if (readers[0]->NumberOfExecutions != 3 ||
+      filters[0]->NumberOfExecutions != 3 ||
+      filters[1]->NumberOfExecutions != 2 || sink->NumberOfExecutions != 2)
+    {
+    cerr << "Pull() updated too much" << endl;
+    return EXIT_FAILURE;
+    }
+  if (filters[0]->GetOutput()->GetNumberOfPoints() != 1010)
+    {
+    cerr << "Wrong output after Pull()" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Push() with propagation updates everything downstream.
+  vtkThreadedStreamingPipeline::SetAutoPropagatePush(true);
+  shared->Modified();
+  vtkThreadedStreamingPipeline::Push(shared->GetExecutive());
+  vtkThreadedStreamingPipeline::SetAutoPropagatePush(false);
+  if (shared->NumberOfExecutions != 3 || sink->NumberOfExecutions != 3 ||
+      sink->GetOutput()->GetNumberOfPoints() != expected)
+    {
+    cerr << "Push() did not update downstream" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkThreadedStreamingPipeline::SetMultiThreadedEnabled(false);
+  return EXIT_SUCCESS;
+}
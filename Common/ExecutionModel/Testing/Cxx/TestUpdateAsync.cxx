@@ -0,0 +1,293 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestUpdateAsync.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkAlgorithm::UpdateAsync()
+// .SECTION Description
+// Updates a slow filter in the background, supersedes and cancels its
+// updates, and checks that the asynchronous output keeps the result of
+// the last completed update meanwhile.
+
+#include "vtkAsyncUpdate.h"
+#include "vtkAtomicInt.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSmartPointer.h"
+
+#include <vtksys/SystemTools.hxx>
+
+// Number of steps of the slow filter, and time spent in each, in
+// milliseconds.
+const int NUMBER_OF_STEPS = 20;
+const unsigned int DELAY = 10;
+
+//------------------------------------------------------------------------------
+// Produces NumberOfPoints points in NUMBER_OF_STEPS steps, reporting
+// progress and checking AbortExecute between them.
+class vtkSlowSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkSlowSource* New();
+  vtkTypeMacro(vtkSlowSource, vtkPolyDataAlgorithm);
+
+  vtkSetMacro(NumberOfPoints, int);
+
+  vtkAtomicInt<int> Started;
+  vtkAtomicInt<int> NumberOfExecutions;
+  vtkAtomicInt<int> NumberOfAborts;
+
+protected:
+  vtkSlowSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfPoints = 1;
+    this->Started = 0;
+    this->NumberOfExecutions = 0;
+    this->NumberOfAborts = 0;
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+    {
+    int numPoints = this->NumberOfPoints;
+    this->Started = 1;
+    for (int step = 0; step < NUMBER_OF_STEPS; ++step)
+      {
+      this->UpdateProgress(static_cast<double>(step) / NUMBER_OF_STEPS);
+      if (this->GetAbortExecute())
+        {
+        ++this->NumberOfAborts;
+        return 1;
+        }
+      vtksys::SystemTools::Delay(DELAY);
+      }
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(numPoints);
+    for (int i = 0; i < numPoints; ++i)
+      {
+      points->SetPoint(i, i, 0.0, 0.0);
+      }
+    vtkPolyData::GetData(outputVector)->SetPoints(points.GetPointer());
+    ++this->NumberOfExecutions;
+    return 1;
+    }
+
+  int NumberOfPoints;
+
+private:
+  vtkSlowSource(const vtkSlowSource&);  // Not implemented.
+  void operator=(const vtkSlowSource&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkSlowSource);
+
+//------------------------------------------------------------------------------
+// Copies its input.
+class vtkCopyFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkCopyFilter* New();
+  vtkTypeMacro(vtkCopyFilter, vtkPolyDataAlgorithm);
+
+protected:
+  vtkCopyFilter() {}
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+    {
+    vtkPolyData::GetData(outputVector)->ShallowCopy(
+      vtkPolyData::GetData(inputVector[0]));
+    return 1;
+    }
+
+private:
+  vtkCopyFilter(const vtkCopyFilter&);  // Not implemented.
+  void operator=(const vtkCopyFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkCopyFilter);
+
+//------------------------------------------------------------------------------
+// Wait until the source started executing.
+static bool WaitForStart(vtkSlowSource* source)
+{
+  for (int i = 0; i < 1000 && !source->Started.Load(); ++i)
+    {
+    vtksys::SystemTools::Delay(1);
+    }
+  return source->Started.Load() != 0;
+}
+
+//------------------------------------------------------------------------------
+static vtkIdType GetNumberOfAsyncPoints(vtkAlgorithm* algorithm)
+{
+  vtkPolyData* output =
+    vtkPolyData::SafeDownCast(algorithm->GetAsyncOutputDataObject(0));
+  return output ? output->GetNumberOfPoints() : -1;
+}
+
+//------------------------------------------------------------------------------
+int TestUpdateAsync(int, char*[])
+{
+  vtkNew<vtkSlowSource> source;
+  vtkNew<vtkCopyFilter> filter;
+  filter->SetInputConnection(source->GetOutputPort());
+
+  // The update does not block and its output is published once done.
+  source->SetNumberOfPoints(10);
+  vtkSmartPointer<vtkAsyncUpdate> update = filter->UpdateAsync();
+  if (!update || update->GetStatus() > vtkAsyncUpdate::RUNNING)
+    {
+    cerr << "UpdateAsync() blocked" << endl;
+    return EXIT_FAILURE;
+    }
+  if (GetNumberOfAsyncPoints(filter.GetPointer()) != -1)
+    {
+    cerr << "Output published before the update completed" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!update->Wait() || update->GetStatus() != vtkAsyncUpdate::COMPLETED)
+    {
+    cerr << "Update did not complete" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkDataObject* front = filter->GetAsyncOutputDataObject(0);
+  if (GetNumberOfAsyncPoints(filter.GetPointer()) != 10 ||
+      !update->GetOutputData() || source->NumberOfExecutions.Load() != 1)
+    {
+    cerr << "Wrong output" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // A new update cancels the executing one, and the published output
+  // does not change until the new one completes.
+  source->Started = 0;
+  source->SetNumberOfPoints(20);
+  vtkSmartPointer<vtkAsyncUpdate> superseded = filter->UpdateAsync();
+  if (!WaitForStart(source.GetPointer()))
+    {
+    cerr << "Update did not start" << endl;
+    return EXIT_FAILURE;
+    }
+  update = filter->UpdateAsync();
+  if (update->IsDone() || filter->GetAsyncOutputDataObject(0) != front ||
+      GetNumberOfAsyncPoints(filter.GetPointer()) != 10)
+    {
+    cerr << "Published output modified by an executing update" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!update->Wait())
+    {
+    cerr << "Update did not complete" << endl;
+    return EXIT_FAILURE;
+    }
+  if (superseded->GetStatus() != vtkAsyncUpdate::CANCELLED ||
+      source->NumberOfAborts.Load() != 1)
+    {
+    cerr << "Update not superseded" << endl;
+    return EXIT_FAILURE;
+    }
+  if (filter->GetAsyncOutputDataObject(0) != front ||
+      GetNumberOfAsyncPoints(filter.GetPointer()) != 20)
+    {
+    cerr << "Output not published" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Parameters only change once the executing update is cancelled and
+  // done.
+  source->Started = 0;
+  source->SetNumberOfPoints(25);
+  update = filter->UpdateAsync();
+  if (!WaitForStart(source.GetPointer()))
+    {
+    cerr << "Update did not start" << endl;
+    return EXIT_FAILURE;
+    }
+  update->Cancel();
+  if (update->Wait() || source->NumberOfAborts.Load() != 2)
+    {
+    cerr << "Update not cancelled" << endl;
+    return EXIT_FAILURE;
+    }
+  source->SetNumberOfPoints(30);
+  update = filter->UpdateAsync();
+  if (!update->Wait() || GetNumberOfAsyncPoints(filter.GetPointer()) != 30)
+    {
+    cerr << "Output not published after a parameter change" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Publishing an older update has no effect.
+  if (!superseded->IsDone() || superseded->Wait() ||
+      GetNumberOfAsyncPoints(filter.GetPointer()) != 30)
+    {
+    cerr << "Cancelled update published" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // An aborted algorithm executes again on the next update, even a
+  // synchronous one.
+  source->Started = 0;
+  source->Modified();
+  update = filter->UpdateAsync();
+  if (!WaitForStart(source.GetPointer()))
+    {
+    cerr << "Update did not start" << endl;
+    return EXIT_FAILURE;
+    }
+  update->Cancel();
+  if (update->Wait() || update->GetStatus() != vtkAsyncUpdate::CANCELLED ||
+      update->GetOutputData() || source->NumberOfAborts.Load() != 3)
+    {
+    cerr << "Update not cancelled" << endl;
+    return EXIT_FAILURE;
+    }
+  if (GetNumberOfAsyncPoints(filter.GetPointer()) != 30)
+    {
+    cerr << "Published output modified by a cancelled update" << endl;
+    return EXIT_FAILURE;
+    }
+  int executions = source->NumberOfExecutions.Load();
+  filter->Update();
+  if (source->NumberOfExecutions.Load() != executions + 1 ||
+      filter->GetOutput()->GetNumberOfPoints() != 30)
+    {
+    cerr << "Partial output reused" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Queued updates of other executives can be cancelled too; they never
+  // execute.
+  vtkNew<vtkSlowSource> other;
+  source->Modified();
+  update = source->UpdateAsync();
+  vtkSmartPointer<vtkAsyncUpdate> queued = other->UpdateAsync();
+  queued->Cancel();
+  vtkAsyncUpdate::WaitForAll();
+  if (!update->IsDone() || update->GetStatus() != vtkAsyncUpdate::COMPLETED ||
+      queued->GetStatus() != vtkAsyncUpdate::CANCELLED ||
+      other->NumberOfExecutions.Load() != 0 ||
+      other->GetAsyncOutputDataObject(0))
+    {
+    cerr << "Queued update executed" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
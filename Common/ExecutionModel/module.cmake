@@ -10,4 +10,6 @@ vtk_module(vtkCommonExecutionModel
     vtkIOCore
     vtkIOLegacy
     vtkFiltersExtraction
+    vtkFiltersSources
+    vtkImagingCore
   )
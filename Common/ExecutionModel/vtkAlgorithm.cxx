@@ -92,6 +92,7 @@ vtkAlgorithm::vtkAlgorithm()
   this->ErrorCode = 0;
   this->Progress = 0.0;
   this->ProgressText = NULL;
+  this->ProgressSuppressed = 0;
   this->Executive = 0;
   this->InputPortInformation = vtkInformationVector::New();
   this->OutputPortInformation = vtkInformationVector::New();
@@ -122,6 +123,15 @@ vtkAlgorithm::~vtkAlgorithm()
 // executes it. Then set the Progress ivar to amount. The parameter amount
 // should range between (0,1).
 void vtkAlgorithm::UpdateProgress(double amount)
+{
+  if (!this->ProgressSuppressed)
+    {
+    this->ReportProgress(amount);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAlgorithm::ReportProgress(double amount)
 {
   this->Progress = amount;
   this->InvokeEvent(vtkCommand::ProgressEvent,static_cast<void *>(&amount));
@@ -1420,6 +1430,34 @@ void vtkAlgorithm::Update(int port)
   this->GetExecutive()->Update(port);
 }
 
+//----------------------------------------------------------------------------
+vtkAsyncUpdate* vtkAlgorithm::UpdateAsync()
+{
+  return this->UpdateAsync(0);
+}
+
+//----------------------------------------------------------------------------
+vtkAsyncUpdate* vtkAlgorithm::UpdateAsync(int port)
+{
+  vtkStreamingDemandDrivenPipeline* sddp =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(this->GetExecutive());
+  if (!sddp)
+    {
+    vtkErrorMacro("UpdateAsync requires a vtkStreamingDemandDrivenPipeline "
+                  "executive.");
+    return 0;
+    }
+  return sddp->UpdateAsync(port);
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkAlgorithm::GetAsyncOutputDataObject(int port)
+{
+  vtkStreamingDemandDrivenPipeline* sddp =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(this->GetExecutive());
+  return sddp ? sddp->GetAsyncOutputData(port) : 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkAlgorithm::PropagateUpdateExtent()
 {
@@ -1624,6 +1662,19 @@ double vtkAlgorithm::ComputePriority()
   return sddp->ComputePriority(0);
 }
 
+//-------------------------------------------------------------
+unsigned long vtkAlgorithm::EstimatePeakMemorySize()
+{
+  vtkStreamingDemandDrivenPipeline *sddp =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast
+      (this->GetExecutive());
+  if (!sddp)
+    {
+    return 0;
+    }
+  return sddp->EstimatePeakMemorySize(0);
+}
+
 //-------------------------------------------------------------
 int vtkAlgorithm::SetUpdateExtentToWholeExtent(int port)
 {
@@ -35,6 +35,7 @@
 class vtkAbstractArray;
 class vtkAlgorithmInternals;
 class vtkAlgorithmOutput;
+class vtkAsyncUpdate;
 class vtkCollection;
 class vtkDataArray;
 class vtkDataObject;
@@ -186,6 +187,16 @@ public:
   // should range between (0,1).
   void UpdateProgress(double amount);
 
+  // Description:
+  // While ProgressSuppressed is on, UpdateProgress() does nothing.  An
+  // executive turns it on while the algorithm executes on several threads
+  // at once, and reports the overall progress with ReportProgress() from
+  // one thread.  Like SetProgressText(), these do not modify the algorithm.
+  void SetProgressSuppressed(int suppressed)
+    {this->ProgressSuppressed = suppressed;}
+  int GetProgressSuppressed() {return this->ProgressSuppressed;}
+  void ReportProgress(double amount);
+
   // Description:
   // Set the current text message associated with the progress state.
   // This may be used by a calling process/GUI.
@@ -419,6 +430,19 @@ public:
   virtual void Update(int port);
   virtual void Update();
 
+  // Description:
+  // Bring this algorithm's output up-to-date in a background thread and
+  // return at once, superseding the previous asynchronous update.  The
+  // executive must be a vtkStreamingDemandDrivenPipeline.  See
+  // vtkAsyncUpdate.
+  virtual vtkAsyncUpdate* UpdateAsync(int port);
+  virtual vtkAsyncUpdate* UpdateAsync();
+
+  // Description:
+  // The output of the given port as of the last completed asynchronous
+  // update.  It is not modified by the updates that follow until they
+  // complete.
+  vtkDataObject* GetAsyncOutputDataObject(int port);
 
   // Description:
   // Bring the algorithm's information up-to-date.
@@ -471,6 +495,13 @@ public:
   // skippable (REQUEST_DATA not needed) and 1.0 meaning important.
   virtual double ComputePriority();
 
+  // Description:
+  // Estimate, without executing the pipeline, the largest amount of
+  // memory in kibibytes that the outputs of this algorithm and of the
+  // algorithms upstream would use at once when updating the first output.
+  // See vtkStreamingDemandDrivenPipeline::REQUEST_MEMORY_ESTIMATE().
+  virtual unsigned long EstimatePeakMemorySize();
+
   // Description:
   // These are flags that can be set that let the pipeline keep accurate
   // meta-information for ComputePriority.
@@ -697,6 +728,7 @@ protected:
   // Progress/Update handling
   double Progress;
   char  *ProgressText;
+  int ProgressSuppressed;
 
   // Garbage collection support.
   virtual void ReportReferences(vtkGarbageCollector*);
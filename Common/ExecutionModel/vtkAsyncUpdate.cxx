@@ -0,0 +1,418 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsyncUpdate.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAsyncUpdate.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCallbackCommand.h"
+#include "vtkConditionVariable.h"
+#include "vtkDataObject.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkObjectFactory.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+vtkStandardNewMacro(vtkAsyncUpdate);
+
+//----------------------------------------------------------------------------
+// The queue of updates and the background thread executing them.  The
+// thread is spawned by the first update and joined at exit.
+class vtkAsyncUpdateQueue
+{
+public:
+  vtkAsyncUpdateQueue()
+    : Threader(0), ThreadId(-1), Stop(false), Running(0),
+      SequenceNumber(0)
+  {
+  }
+
+  ~vtkAsyncUpdateQueue()
+  {
+    this->Shutdown();
+  }
+
+  void Submit(vtkAsyncUpdate* update);
+  void Cancel(vtkAsyncUpdate* update);
+  void WaitFor(vtkAsyncUpdate* update);
+  void WaitForAll();
+  void Work();
+  void Shutdown();
+
+  // Cancel an update that is not done.  The updates removed from the
+  // queue are released by Release() once the lock is released, since
+  // deleting them may delete a pipeline.
+  void CancelLocked(vtkAsyncUpdate* update);
+  void Release();
+
+  vtkSimpleMutexLock Lock;
+  vtkSimpleConditionVariable Changed;
+
+  vtkMultiThreader* Threader;
+  int ThreadId;
+  bool Stop;
+
+  std::deque<vtkAsyncUpdate*> Pending;
+  vtkAsyncUpdate* Running;
+  unsigned long SequenceNumber;
+
+  std::vector<vtkAsyncUpdate*> Removed;
+};
+
+static vtkAsyncUpdateQueue vtkAsyncUpdateQueueInstance;
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkAsyncUpdateThread(void* arg)
+{
+  vtkAsyncUpdateQueue* queue = static_cast<vtkAsyncUpdateQueue*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+  queue->Work();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdateQueue::CancelLocked(vtkAsyncUpdate* update)
+{
+  if (update->Status == vtkAsyncUpdate::QUEUED)
+    {
+    std::deque<vtkAsyncUpdate*>::iterator it =
+      std::find(this->Pending.begin(), this->Pending.end(), update);
+    if (it != this->Pending.end())
+      {
+      this->Pending.erase(it);
+      this->Removed.push_back(update);
+      }
+    update->Status = vtkAsyncUpdate::CANCELLED;
+    update->Cancelled = 1;
+    }
+  else if (update->Status == vtkAsyncUpdate::RUNNING)
+    {
+    // The background thread aborts the executing algorithm itself, see
+    // vtkAsyncUpdate::ProgressCallback().
+    update->Cancelled = 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdateQueue::Release()
+{
+  std::vector<vtkAsyncUpdate*> removed;
+  this->Lock.Lock();
+  removed.swap(this->Removed);
+  this->Lock.Unlock();
+
+  for (size_t i = 0; i < removed.size(); ++i)
+    {
+    removed[i]->Algorithm = 0;
+    removed[i]->UnRegister(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdateQueue::Submit(vtkAsyncUpdate* update)
+{
+  this->Lock.Lock();
+  // The new update supersedes those of the same executive.
+  std::deque<vtkAsyncUpdate*> pending = this->Pending;
+  for (size_t i = 0; i < pending.size(); ++i)
+    {
+    if (pending[i]->Executive == update->Executive)
+      {
+      this->CancelLocked(pending[i]);
+      }
+    }
+  if (this->Running && this->Running->Executive == update->Executive)
+    {
+    this->CancelLocked(this->Running);
+    }
+
+  update->Register(0);
+  update->Status = vtkAsyncUpdate::QUEUED;
+  update->SequenceNumber = ++this->SequenceNumber;
+  this->Pending.push_back(update);
+
+  if (this->ThreadId < 0)
+    {
+    this->Threader = vtkMultiThreader::New();
+    this->ThreadId = this->Threader->SpawnThread(vtkAsyncUpdateThread, this);
+    }
+  this->Changed.Broadcast();
+  this->Lock.Unlock();
+
+  this->Release();
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdateQueue::Cancel(vtkAsyncUpdate* update)
+{
+  this->Lock.Lock();
+  this->CancelLocked(update);
+  this->Changed.Broadcast();
+  this->Lock.Unlock();
+
+  this->Release();
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdateQueue::WaitFor(vtkAsyncUpdate* update)
+{
+  this->Lock.Lock();
+  while (update->Status == vtkAsyncUpdate::QUEUED ||
+         update->Status == vtkAsyncUpdate::RUNNING)
+    {
+    this->Changed.Wait(this->Lock);
+    }
+  this->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdateQueue::WaitForAll()
+{
+  this->Lock.Lock();
+  while (!this->Pending.empty() || this->Running)
+    {
+    this->Changed.Wait(this->Lock);
+    }
+  this->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdateQueue::Work()
+{
+  this->Lock.Lock();
+  for (;;)
+    {
+    while (!this->Stop && this->Pending.empty())
+      {
+      this->Changed.Wait(this->Lock);
+      }
+    if (this->Stop)
+      {
+      break;
+      }
+    vtkAsyncUpdate* update = this->Pending.front();
+    this->Pending.pop_front();
+    update->Status = vtkAsyncUpdate::RUNNING;
+    this->Running = update;
+    this->Lock.Unlock();
+
+    int result = update->Execute();
+
+    // Keep the pipeline alive until the lock is released.
+    vtkSmartPointer<vtkAlgorithm> algorithm = update->Algorithm;
+    this->Lock.Lock();
+    update->Algorithm = 0;
+    if (update->Cancelled)
+      {
+      update->Status = vtkAsyncUpdate::CANCELLED;
+      }
+    else
+      {
+      update->Status =
+        result ? vtkAsyncUpdate::COMPLETED : vtkAsyncUpdate::FAILED;
+      }
+    if (update->Status != vtkAsyncUpdate::COMPLETED)
+      {
+      update->OutputData = 0;
+      }
+    this->Running = 0;
+    this->Changed.Broadcast();
+    this->Lock.Unlock();
+
+    update->UnRegister(0);
+    algorithm = 0;
+    this->Release();
+    this->Lock.Lock();
+    }
+  this->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdateQueue::Shutdown()
+{
+  if (this->ThreadId < 0)
+    {
+    return;
+    }
+
+  this->Lock.Lock();
+  this->Stop = true;
+  std::deque<vtkAsyncUpdate*> pending = this->Pending;
+  for (size_t i = 0; i < pending.size(); ++i)
+    {
+    this->CancelLocked(pending[i]);
+    }
+  if (this->Running)
+    {
+    this->CancelLocked(this->Running);
+    }
+  this->Changed.Broadcast();
+  this->Lock.Unlock();
+  this->Release();
+
+  this->Threader->TerminateThread(this->ThreadId);
+  this->Threader->Delete();
+  this->Threader = 0;
+  this->ThreadId = -1;
+  this->Release();
+}
+
+//----------------------------------------------------------------------------
+vtkAsyncUpdate::vtkAsyncUpdate()
+{
+  this->Executive = 0;
+  this->OutputPort = 0;
+  this->Status = QUEUED;
+  this->Cancelled = 0;
+  this->Published = 0;
+  this->ProgressObserver = 0;
+  this->SequenceNumber = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkAsyncUpdate::~vtkAsyncUpdate()
+{
+}
+
+//----------------------------------------------------------------------------
+int vtkAsyncUpdate::GetStatus()
+{
+  vtkAsyncUpdateQueueInstance.Lock.Lock();
+  int status = this->Status;
+  vtkAsyncUpdateQueueInstance.Lock.Unlock();
+  return status;
+}
+
+//----------------------------------------------------------------------------
+int vtkAsyncUpdate::IsDone()
+{
+  int status = this->GetStatus();
+  if (status == COMPLETED && !this->Published)
+    {
+    this->Published = 1;
+    vtkStreamingDemandDrivenPipeline* exec = this->ExecutivePointer;
+    if (exec)
+      {
+      exec->PublishAsyncUpdate(this);
+      }
+    }
+  return status != QUEUED && status != RUNNING;
+}
+
+//----------------------------------------------------------------------------
+int vtkAsyncUpdate::Wait()
+{
+  vtkAsyncUpdateQueueInstance.WaitFor(this);
+  this->IsDone();
+  return this->Status == COMPLETED;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdate::Cancel()
+{
+  vtkAsyncUpdateQueueInstance.Cancel(this);
+}
+
+//----------------------------------------------------------------------------
+vtkStreamingDemandDrivenPipeline* vtkAsyncUpdate::GetExecutive()
+{
+  return this->ExecutivePointer;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkAsyncUpdate::GetOutputData()
+{
+  return this->GetStatus() == COMPLETED ? this->OutputData : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdate::WaitForAll()
+{
+  vtkAsyncUpdateQueueInstance.WaitForAll();
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdate::Submit(vtkAsyncUpdate* update)
+{
+  vtkAsyncUpdateQueueInstance.Submit(update);
+}
+
+//----------------------------------------------------------------------------
+int vtkAsyncUpdate::Execute()
+{
+  return this->Executive->ExecuteAsyncUpdate(this);
+}
+
+//----------------------------------------------------------------------------
+int vtkAsyncUpdate::BeginAlgorithm(vtkAlgorithm* algorithm)
+{
+  if (this->Cancelled)
+    {
+    return 0;
+    }
+
+  // Poll the cancellation at each progress update of the algorithm.
+  vtkCallbackCommand* callback = vtkCallbackCommand::New();
+  callback->SetCallback(&vtkAsyncUpdate::ProgressCallback);
+  callback->SetClientData(this);
+  this->ProgressObserver =
+    algorithm->AddObserver(vtkCommand::ProgressEvent, callback);
+  callback->Delete();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdate::ProgressCallback(vtkObject* caller, unsigned long,
+                                      void* clientData, void*)
+{
+  // Only the background thread, which executes the algorithm, sets its
+  // AbortExecute flag: the algorithm reads it without synchronization.
+  vtkAsyncUpdate* self = static_cast<vtkAsyncUpdate*>(clientData);
+  vtkAlgorithm* algorithm = static_cast<vtkAlgorithm*>(caller);
+  if (self->Cancelled && !algorithm->GetAbortExecute())
+    {
+    algorithm->SetAbortExecute(1);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdate::EndAlgorithm(vtkAlgorithm* algorithm)
+{
+  algorithm->RemoveObserver(this->ProgressObserver);
+  this->ProgressObserver = 0;
+
+  // The output of an aborted algorithm is marked as generated although
+  // it may be partial.  Make the algorithm execute again next time.
+  if (algorithm->GetAbortExecute())
+    {
+    algorithm->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAsyncUpdate::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  static const char* names[] =
+    { "QUEUED", "RUNNING", "COMPLETED", "CANCELLED", "FAILED" };
+  os << indent << "Status: " << names[this->GetStatus()] << "\n";
+  os << indent << "Executive: "
+     << static_cast<void*>(this->GetExecutive()) << "\n";
+  os << indent << "OutputPort: " << this->OutputPort << "\n";
+  os << indent << "SequenceNumber: " << this->SequenceNumber << "\n";
+}
@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsyncUpdate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkAsyncUpdate - Handle on an update running in the background
+// .SECTION Description
+// vtkAsyncUpdate is returned by
+// vtkStreamingDemandDrivenPipeline::UpdateAsync() and
+// vtkAlgorithm::UpdateAsync().  The update it stands for is queued and
+// executed by a background thread, so that an interactive application
+// does not block while a slow pipeline executes.  The application polls
+// the handle with IsDone(), e.g. from a timer, or blocks with Wait().
+//
+// The updates are executed one after the other, in the order they were
+// requested.  A new update of an executive cancels the updates of the
+// same executive that are queued or executing.  An update can also be
+// cancelled explicitly with Cancel().  Cancellation is cooperative: it
+// is checked before each algorithm executes, and the algorithm
+// executing at the time sets its AbortExecute flag at its next progress
+// update, in the background thread.  An algorithm that was aborted
+// executes again on the next update.  To follow a slider, the
+// application cancels the pending update, waits for it, sets the new
+// value and requests a new update; since the executing algorithm stops
+// at its next progress update, Wait() does not block for long.
+//
+// The output of the algorithm is modified while the update executes.
+// The application should therefore render the output of the executive
+// as of the last completed update, which
+// vtkStreamingDemandDrivenPipeline::GetAsyncOutputData() returns.  That
+// data object is a shallow copy of the output made when IsDone() or
+// Wait() finds that the update completed, so it only changes in the
+// thread that calls them.
+//
+// .SECTION Caveats
+// While updates are queued or executing, the pipeline must not be
+// updated synchronously, its connections must not change and the
+// parameters of its algorithms must not change either: the background
+// thread keeps reading them until the executing algorithm notices the
+// cancellation.  Call Cancel() and Wait(), or WaitForAll(), first.
+// Events of the algorithms, such as ProgressEvent, are invoked in the
+// background thread.
+//
+// The background thread is not part of the vtkSMPTools thread pool, so
+// it uses thread index 0, like the application thread.  While updates
+// are queued or executing, the application thread must not call
+// vtkSMPTools::For() nor use other per thread state of vtkSMPTools
+// (such as the scratch lists of vtkCellArray) on objects that the
+// pipeline also uses.
+//
+// .SECTION See Also
+// vtkStreamingDemandDrivenPipeline vtkAlgorithm
+
+#ifndef __vtkAsyncUpdate_h
+#define __vtkAsyncUpdate_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+#include "vtkAtomicInt.h" // For Cancelled
+#include "vtkSmartPointer.h" // For the algorithm and the output
+#include "vtkWeakPointer.h" // For the executive
+
+class vtkAlgorithm;
+class vtkAsyncUpdateQueue;
+class vtkDataObject;
+class vtkStreamingDemandDrivenPipeline;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkAsyncUpdate : public vtkObject
+{
+public:
+  static vtkAsyncUpdate* New();
+  vtkTypeMacro(vtkAsyncUpdate, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+//BTX
+  enum StatusValues
+  {
+    QUEUED,
+    RUNNING,
+    COMPLETED,
+    CANCELLED,
+    FAILED
+  };
+//ETX
+
+  // Description:
+  // Status of the update: QUEUED, RUNNING, COMPLETED, CANCELLED or
+  // FAILED.
+  int GetStatus();
+
+  // Description:
+  // Return 1 when the update completed, was cancelled or failed.  When
+  // it completed, make its output the asynchronous output of the
+  // executive, unless a more recent update already did.
+  int IsDone();
+
+  // Description:
+  // Block until the update is done, as IsDone() reports it.  Return 1
+  // if it completed.
+  int Wait();
+
+  // Description:
+  // Cancel the update if it is not done.
+  void Cancel();
+
+  // Description:
+  // The executive and output port that the update brings up to date.
+  // The executive is NULL once it is deleted.
+  vtkStreamingDemandDrivenPipeline* GetExecutive();
+  vtkGetMacro(OutputPort, int);
+
+  // Description:
+  // Shallow copy of the output, NULL unless the update completed.
+  vtkDataObject* GetOutputData();
+
+  // Description:
+  // Block until all queued updates are done.
+  static void WaitForAll();
+
+protected:
+  vtkAsyncUpdate();
+  ~vtkAsyncUpdate();
+
+  // Queue the update and cancel the updates of the same executive.
+  static void Submit(vtkAsyncUpdate* update);
+
+  // Called by the background thread to execute the update.
+  int Execute();
+
+  // Called by the background thread before and after each algorithm
+  // executes.  BeginAlgorithm() returns 0 if the update was cancelled.
+  int BeginAlgorithm(vtkAlgorithm* algorithm);
+  void EndAlgorithm(vtkAlgorithm* algorithm);
+
+  // Observes the ProgressEvent of the executing algorithm and aborts it
+  // once the update is cancelled.
+  static void ProgressCallback(vtkObject* caller, unsigned long eid,
+                               void* clientData, void* callData);
+  unsigned long ProgressObserver;
+
+  // The executive is used by the background thread through Executive
+  // while Algorithm keeps it alive, and by the application thread
+  // through ExecutivePointer.
+  vtkWeakPointer<vtkStreamingDemandDrivenPipeline> ExecutivePointer;
+  vtkStreamingDemandDrivenPipeline* Executive;
+  vtkSmartPointer<vtkAlgorithm> Algorithm;
+  int OutputPort;
+
+  vtkSmartPointer<vtkDataObject> OutputData;
+  int Status;
+  // Set by any thread, read by the background thread without the lock.
+  vtkAtomicInt<int> Cancelled;
+  int Published;
+  unsigned long SequenceNumber;
+
+  friend class vtkAsyncUpdateQueue;
+  friend class vtkStreamingDemandDrivenPipeline;
+
+private:
+  vtkAsyncUpdate(const vtkAsyncUpdate&);  // Not implemented.
+  void operator=(const vtkAsyncUpdate&);  // Not implemented.
+};
+
+#endif
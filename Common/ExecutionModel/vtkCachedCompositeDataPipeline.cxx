@@ -0,0 +1,386 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCachedCompositeDataPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCachedCompositeDataPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <vtksys/ios/sstream>
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkCachedCompositeDataPipeline);
+
+//----------------------------------------------------------------------------
+// One cached output.
+class vtkCachedCompositeDataPipelineEntry
+{
+public:
+  std::string Key;
+  vtkSmartPointer<vtkDataObject> Data;
+  unsigned long Size; // in kibibytes
+  unsigned long Time; // update time of the output
+};
+
+class vtkCachedCompositeDataPipelineInternals
+{
+public:
+  typedef std::list<vtkCachedCompositeDataPipelineEntry> EntryList;
+
+  // Most recently used first.
+  EntryList Entries;
+  std::map<std::string, EntryList::iterator> Index;
+
+  // Keys of the output information that identify a request.
+  std::vector<vtkInformationKey*> RequestKeys;
+  std::vector<vtkInformationKey*> ExtraRequestKeys;
+
+  // Request that missed the cache and will be stored by ExecuteData().
+  std::string PendingKey;
+  bool HasPendingKey;
+
+  void ComputeKey(vtkInformation* outInfo, std::string& key)
+    {
+    vtksys_ios::ostringstream os;
+    os.precision(17);
+    this->AppendKeys(this->RequestKeys, outInfo, os);
+    this->AppendKeys(this->ExtraRequestKeys, outInfo, os);
+    key = os.str();
+    }
+
+  void AppendKeys(const std::vector<vtkInformationKey*>& keys,
+                  vtkInformation* outInfo, ostream& os)
+    {
+    for (size_t i = 0; i < keys.size(); ++i)
+      {
+      if (keys[i]->Has(outInfo))
+        {
+        os << keys[i]->GetLocation() << "::" << keys[i]->GetName() << "=";
+        keys[i]->Print(os, outInfo);
+        os << ";";
+        }
+      }
+    }
+
+  void Remove(EntryList::iterator entry)
+    {
+    this->Index.erase(entry->Key);
+    this->Entries.erase(entry);
+    }
+};
+
+//----------------------------------------------------------------------------
+// The pipeline information of a data object that is not copied by
+// ShallowCopy() but that NeedToExecuteData() compares with the request.
+static void vtkCachedCompositeDataPipelineCopyDataInformation(
+  vtkDataObject* from, vtkDataObject* to)
+{
+  vtkInformation* fromInfo = from->GetInformation();
+  vtkInformation* toInfo = to->GetInformation();
+  toInfo->CopyEntry(fromInfo, vtkDataObject::DATA_PIECE_NUMBER());
+  toInfo->CopyEntry(fromInfo, vtkDataObject::DATA_NUMBER_OF_PIECES());
+  toInfo->CopyEntry(fromInfo, vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS());
+  toInfo->CopyEntry(fromInfo, vtkDataObject::DATA_TIME_STEP());
+  toInfo->CopyEntry(fromInfo, vtkDataObject::DATA_RESOLUTION());
+}
+
+//----------------------------------------------------------------------------
+vtkCachedCompositeDataPipeline::vtkCachedCompositeDataPipeline()
+{
+  this->MemoryBudget = 262144;
+  this->CacheMemorySize = 0;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+
+  this->Internals = new vtkCachedCompositeDataPipelineInternals;
+  this->Internals->HasPendingKey = false;
+  std::vector<vtkInformationKey*>& keys = this->Internals->RequestKeys;
+  keys.push_back(UPDATE_EXTENT());
+  keys.push_back(UPDATE_PIECE_NUMBER());
+  keys.push_back(UPDATE_NUMBER_OF_PIECES());
+  keys.push_back(UPDATE_NUMBER_OF_GHOST_LEVELS());
+  keys.push_back(UPDATE_RESOLUTION());
+  keys.push_back(UPDATE_TIME_STEP());
+  keys.push_back(UPDATE_COMPOSITE_INDICES());
+}
+
+//----------------------------------------------------------------------------
+vtkCachedCompositeDataPipeline::~vtkCachedCompositeDataPipeline()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::SetMemoryBudget(unsigned long budget)
+{
+  if (budget == this->MemoryBudget)
+    {
+    return;
+    }
+  this->MemoryBudget = budget;
+  this->EvictOutputs();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::GetNumberOfCachedOutputs()
+{
+  return static_cast<int>(this->Internals->Entries.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::ClearCache()
+{
+  this->Internals->Entries.clear();
+  this->Internals->Index.clear();
+  this->CacheMemorySize = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::AddRequestKey(vtkInformationKey* key)
+{
+  if (key)
+    {
+    this->Internals->ExtraRequestKeys.push_back(key);
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::RemoveAllRequestKeys()
+{
+  if (!this->Internals->ExtraRequestKeys.empty())
+    {
+    this->Internals->ExtraRequestKeys.clear();
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::EvictOutputs()
+{
+  while (this->CacheMemorySize > this->MemoryBudget &&
+         !this->Internals->Entries.empty())
+    {
+    vtkCachedCompositeDataPipelineInternals::EntryList::iterator last =
+      --this->Internals->Entries.end();
+    this->CacheMemorySize -= last->Size;
+    this->Internals->Remove(last);
+    this->NumberOfEvictions++;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::NeedToExecuteData(
+  int outputPort,
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec)
+{
+  if (!this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+    {
+    return 0;
+    }
+
+  // Only algorithms with one output are cached, and algorithms that
+  // asked to execute again must do so.
+  if (outputPort < 0 || this->Algorithm->GetNumberOfOutputPorts() != 1 ||
+      this->ContinueExecuting)
+    {
+    return 1;
+    }
+
+  // Discard the outputs produced before the pipeline was modified.
+  typedef vtkCachedCompositeDataPipelineInternals::EntryList EntryList;
+  unsigned long pmt = this->GetPipelineMTime();
+  EntryList::iterator entry = this->Internals->Entries.begin();
+  while (entry != this->Internals->Entries.end())
+    {
+    EntryList::iterator next = entry;
+    ++next;
+    if (entry->Time < pmt)
+      {
+      this->CacheMemorySize -= entry->Size;
+      this->Internals->Remove(entry);
+      }
+    entry = next;
+    }
+
+  vtkInformation* outInfo = outInfoVec->GetInformationObject(outputPort);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!output)
+    {
+    return 1;
+    }
+
+  std::string key;
+  this->Internals->ComputeKey(outInfo, key);
+  std::map<std::string, EntryList::iterator>::iterator found =
+    this->Internals->Index.find(key);
+  if (found != this->Internals->Index.end() &&
+      strcmp(found->second->Data->GetClassName(),
+             output->GetClassName()) == 0)
+    {
+    // Restore the output and make it the most recently used.
+    vtkDataObject* data = found->second->Data;
+    this->Internals->Entries.splice(this->Internals->Entries.begin(),
+                                    this->Internals->Entries, found->second);
+    output->ShallowCopy(data);
+    vtkCachedCompositeDataPipelineCopyDataInformation(data, output);
+
+    vtkSmartPointer<vtkInformation> request =
+      vtkSmartPointer<vtkInformation>::New();
+    request->Set(FROM_OUTPUT_PORT(), outputPort);
+    this->MarkOutputsGenerated(request, inInfoVec, outInfoVec);
+
+    this->NumberOfHits++;
+    this->Internals->HasPendingKey = false;
+    return 0;
+    }
+
+  // This is asked more than once for each request.
+  if (!this->Internals->HasPendingKey || this->Internals->PendingKey != key)
+    {
+    this->NumberOfMisses++;
+    this->Internals->PendingKey = key;
+    this->Internals->HasPendingKey = true;
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Same decision as NeedToExecuteData(), but neither restores the output
+// nor touches the cache and its statistics.
+int vtkCachedCompositeDataPipeline::WouldExecuteData(
+  int outputPort,
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec)
+{
+  if (!this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+    {
+    return 0;
+    }
+  if (outputPort < 0 || this->Algorithm->GetNumberOfOutputPorts() != 1 ||
+      this->ContinueExecuting)
+    {
+    return 1;
+    }
+
+  vtkInformation* outInfo = outInfoVec->GetInformationObject(outputPort);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!output)
+    {
+    return 1;
+    }
+
+  typedef vtkCachedCompositeDataPipelineInternals::EntryList EntryList;
+  std::string key;
+  this->Internals->ComputeKey(outInfo, key);
+  std::map<std::string, EntryList::iterator>::iterator found =
+    this->Internals->Index.find(key);
+  return found == this->Internals->Index.end() ||
+    found->second->Time < this->GetPipelineMTime() ||
+    strcmp(found->second->Data->GetClassName(), output->GetClassName()) != 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::ExecuteData(
+  vtkInformation* request,
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec)
+{
+  int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+
+  if (!this->Internals->HasPendingKey)
+    {
+    return result;
+    }
+  this->Internals->HasPendingKey = false;
+  if (!result || this->Algorithm->GetNumberOfOutputPorts() != 1 ||
+      this->ContinueExecuting)
+    {
+    return result;
+    }
+
+  vtkInformation* outInfo = outInfoVec->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!output || outInfo->Get(DATA_NOT_GENERATED()))
+    {
+    return result;
+    }
+
+  // Replace an older output of the same request.
+  const std::string& key = this->Internals->PendingKey;
+  std::map<std::string,
+    vtkCachedCompositeDataPipelineInternals::EntryList::iterator>::iterator
+    found = this->Internals->Index.find(key);
+  if (found != this->Internals->Index.end())
+    {
+    this->CacheMemorySize -= found->second->Size;
+    this->Internals->Remove(found->second);
+    }
+
+  vtkCachedCompositeDataPipelineEntry entry;
+  entry.Key = key;
+  entry.Data.TakeReference(output->NewInstance());
+  entry.Data->ShallowCopy(output);
+  vtkCachedCompositeDataPipelineCopyDataInformation(output, entry.Data);
+  entry.Size = output->GetActualMemorySize();
+  entry.Time = output->GetUpdateTime();
+  if (entry.Size > this->MemoryBudget)
+    {
+    // It would evict everything else and itself.
+    return result;
+    }
+
+  this->Internals->Entries.push_front(entry);
+  this->Internals->Index[key] = this->Internals->Entries.begin();
+  this->CacheMemorySize += entry.Size;
+  this->EvictOutputs();
+
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "MemoryBudget: " << this->MemoryBudget << "\n";
+  os << indent << "CacheMemorySize: " << this->CacheMemorySize << "\n";
+  os << indent << "NumberOfCachedOutputs: "
+     << this->GetNumberOfCachedOutputs() << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
+  os << indent << "NumberOfEvictions: " << this->NumberOfEvictions << "\n";
+}
@@ -0,0 +1,121 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCachedCompositeDataPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkCachedCompositeDataPipeline - Executive that keeps the outputs
+// of past requests within a memory budget.
+// .SECTION Description
+// vtkCachedCompositeDataPipeline is a vtkCompositeDataPipeline that
+// remembers the outputs its algorithm produced for past requests.  When
+// the same request comes again, e.g. when going back to a time step while
+// scrubbing an animation, the output is restored from the cache and
+// neither the algorithm nor the pipeline upstream of it executes.
+//
+// A request is identified by the values of the update keys of the output
+// information: UPDATE_EXTENT, UPDATE_PIECE_NUMBER, UPDATE_NUMBER_OF_PIECES,
+// UPDATE_NUMBER_OF_GHOST_LEVELS, UPDATE_RESOLUTION, UPDATE_TIME_STEP and
+// UPDATE_COMPOSITE_INDICES.  Other keys of the output information, such
+// as keys carrying an array selection, can be added with AddRequestKey().
+// Cached outputs are discarded when the pipeline is modified.
+//
+// The outputs are shallow copies, so they share their arrays with the
+// output of the algorithm.  Their size, as reported by
+// vtkDataObject::GetActualMemorySize(), is counted against MemoryBudget.
+// When the budget is exceeded, the least recently used outputs are
+// evicted.  Only algorithms with a single output port are cached.
+//
+// .SECTION See Also
+// vtkCachedStreamingDemandDrivenPipeline vtkCompositeDataPipeline
+
+#ifndef __vtkCachedCompositeDataPipeline_h
+#define __vtkCachedCompositeDataPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkCachedCompositeDataPipelineInternals;
+class vtkInformationKey;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkCachedCompositeDataPipeline :
+  public vtkCompositeDataPipeline
+{
+public:
+  static vtkCachedCompositeDataPipeline* New();
+  vtkTypeMacro(vtkCachedCompositeDataPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Maximum size of the cached outputs, in kibibytes.  It defaults to
+  // 262144 (256 MiB).  Reducing it evicts outputs right away.
+  void SetMemoryBudget(unsigned long budget);
+  vtkGetMacro(MemoryBudget, unsigned long);
+
+  // Description:
+  // Size of the cached outputs, in kibibytes.
+  vtkGetMacro(CacheMemorySize, unsigned long);
+
+  // Description:
+  // Number of cached outputs.
+  int GetNumberOfCachedOutputs();
+
+  // Description:
+  // Discard all cached outputs.
+  void ClearCache();
+
+  // Description:
+  // Make a key of the output information part of the identity of a
+  // request, in addition to the update keys.
+  void AddRequestKey(vtkInformationKey* key);
+  void RemoveAllRequestKeys();
+
+  // Description:
+  // Statistics of the cache: the number of requests served from the
+  // cache, the number of requests that made the algorithm execute and the
+  // number of outputs evicted to stay within the memory budget.
+  vtkGetMacro(NumberOfHits, vtkIdType);
+  vtkGetMacro(NumberOfMisses, vtkIdType);
+  vtkGetMacro(NumberOfEvictions, vtkIdType);
+  void ResetStatistics();
+
+protected:
+  vtkCachedCompositeDataPipeline();
+  ~vtkCachedCompositeDataPipeline();
+
+  virtual int NeedToExecuteData(int outputPort,
+                                vtkInformationVector** inInfoVec,
+                                vtkInformationVector* outInfoVec);
+  virtual int WouldExecuteData(int outputPort,
+                               vtkInformationVector** inInfoVec,
+                               vtkInformationVector* outInfoVec);
+  virtual int ExecuteData(vtkInformation* request,
+                          vtkInformationVector** inInfoVec,
+                          vtkInformationVector* outInfoVec);
+
+  // Evict the least recently used outputs until the cache fits in the
+  // memory budget.
+  void EvictOutputs();
+
+  unsigned long MemoryBudget;
+  unsigned long CacheMemorySize;
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
+  vtkIdType NumberOfEvictions;
+
+private:
+  vtkCachedCompositeDataPipelineInternals* Internals;
+
+  vtkCachedCompositeDataPipeline(const vtkCachedCompositeDataPipeline&);  // Not implemented.
+  void operator=(const vtkCachedCompositeDataPipeline&);  // Not implemented.
+};
+
+#endif
@@ -263,6 +263,19 @@ int vtkCachedStreamingDemandDrivenPipeline
 }
 
 
+//----------------------------------------------------------------------------
+// NeedToExecuteData() discards stale data and restores cached data, so the
+// cache is not looked at: the estimate assumes that the algorithm executes
+// whenever the superclass would.
+int vtkCachedStreamingDemandDrivenPipeline
+::WouldExecuteData(int outputPort,
+                   vtkInformationVector** inInfoVec,
+                   vtkInformationVector* outInfoVec)
+{
+  return this->Superclass::NeedToExecuteData(outputPort,
+                                             inInfoVec, outInfoVec);
+}
+
 //----------------------------------------------------------------------------
 int vtkCachedStreamingDemandDrivenPipeline
 ::ExecuteData(vtkInformation* request,
@@ -53,6 +53,9 @@ protected:
   virtual int NeedToExecuteData(int outputPort,
                                 vtkInformationVector** inInfoVec,
                                 vtkInformationVector* outInfoVec);
+  virtual int WouldExecuteData(int outputPort,
+                               vtkInformationVector** inInfoVec,
+                               vtkInformationVector* outInfoVec);
   virtual int ExecuteData(vtkInformation* request,
                           vtkInformationVector** inInfoVec,
                           vtkInformationVector* outInfoVec);
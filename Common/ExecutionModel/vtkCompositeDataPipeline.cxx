@@ -16,6 +16,7 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkAtomicInt.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkImageData.h"
 #include "vtkInformationDoubleKey.h"
@@ -33,10 +34,13 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUniformGrid.h"
 
+#include <vector>
+
 //----------------------------------------------------------------------------
 #if defined (JB_DEBUG1)
   #ifndef WIN32
@@ -80,6 +84,7 @@ vtkCompositeDataPipeline::vtkCompositeDataPipeline()
 {
   this->InLocalLoop = 0;
   this->SuppressResetPipelineInformation = 0;
+  this->ParallelBlockExecution = 0;
   this->InformationCache = vtkInformation::New();
 
   this->GenericRequest = vtkInformation::New();
@@ -460,8 +465,11 @@ void vtkCompositeDataPipeline::ExecuteSimpleAlgorithm(
   // TODO: Loop over all inputs
   vtkInformation* inInfo = 0;
   inInfo = this->GetInputInformation(compositePort, 0);
-  vtkCompositeDataSet* input = vtkCompositeDataSet::SafeDownCast(
-    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  // The loop below replaces the input in the information of the producer,
+  // which may hold the only reference to it.
+  vtkSmartPointer<vtkCompositeDataSet> input =
+    vtkCompositeDataSet::SafeDownCast(
+      inInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkSmartPointer<vtkCompositeDataSet> compositeOutput =
     vtkCompositeDataSet::SafeDownCast(
@@ -504,33 +512,43 @@ void vtkCompositeDataPipeline::ExecuteSimpleAlgorithm(
     // ExecuteDataStart() should NOT Initialize() the composite output.
     this->InLocalLoop = 1;
 
-    vtkSmartPointer<vtkCompositeDataIterator> iter;
-    iter.TakeReference(input->NewIterator());
-    for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
-      iter->GoToNextItem())
+    // Only the output of the first port is assembled from the leaves.
+    if (this->ParallelBlockExecution &&
+        this->Algorithm->GetNumberOfOutputPorts() == 1)
       {
-      // if it is a temporal input, set the time for each piece
-      if (outInfo->Has(UPDATE_TIME_STEP()))
-        {
-        outInfo->Set(UPDATE_TIME_STEP(), time);
-        }
-      vtkDataObject* dobj = iter->GetCurrentDataObject();
-      if (dobj)
+      this->ExecuteSimpleAlgorithmInParallel(input, compositeOutput,
+                                             compositePort);
+      }
+    else
+      {
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(input->NewIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+        iter->GoToNextItem())
         {
-        // Note that since VisitOnlyLeaves is ON on the iterator,
-        // this method is called only for leaves, hence, we are assured that
-        // neither dobj nor outObj are vtkCompositeDataSet subclasses.
-        vtkDataObject* outObj =
-          this->ExecuteSimpleAlgorithmForBlock(inInfoVec,
-                                               outInfoVec,
-                                               inInfo,
-                                               outInfo,
-                                               r,
-                                               dobj);
-        if (outObj)
+        // if it is a temporal input, set the time for each piece
+        if (outInfo->Has(UPDATE_TIME_STEP()))
           {
-          compositeOutput->SetDataSet(iter, outObj);
-          outObj->FastDelete();
+          outInfo->Set(UPDATE_TIME_STEP(), time);
+          }
+        vtkDataObject* dobj = iter->GetCurrentDataObject();
+        if (dobj)
+          {
+          // Note that since VisitOnlyLeaves is ON on the iterator,
+          // this method is called only for leaves, hence, we are assured
+          // that neither dobj nor outObj are vtkCompositeDataSet subclasses.
+          vtkDataObject* outObj =
+            this->ExecuteSimpleAlgorithmForBlock(inInfoVec,
+                                                 outInfoVec,
+                                                 inInfo,
+                                                 outInfo,
+                                                 r,
+                                                 dobj);
+          if (outObj)
+            {
+            compositeOutput->SetDataSet(iter, outObj);
+            outObj->FastDelete();
+            }
           }
         }
       }
@@ -556,10 +574,10 @@ void vtkCompositeDataPipeline::ExecuteSimpleAlgorithm(
                                  this->GetOutputInformation());
 
     vtkDataObject* curInput = inInfo->Get(vtkDataObject::DATA_OBJECT());
-    if (curInput != input)
+    if (curInput != input.GetPointer())
       {
       inInfo->Remove(vtkDataObject::DATA_OBJECT());
-      inInfo->Set(vtkDataObject::DATA_OBJECT(), input);
+      inInfo->Set(vtkDataObject::DATA_OBJECT(), input.GetPointer());
       }
     vtkDataObject* curOutput = outInfo->Get(vtkDataObject::DATA_OBJECT());
     if (curOutput != compositeOutput.GetPointer())
@@ -570,6 +588,191 @@ void vtkCompositeDataPipeline::ExecuteSimpleAlgorithm(
   this->ExecuteDataEnd(request,inInfoVec,outInfoVec);
 }
 
+//----------------------------------------------------------------------------
+// The pipeline information of one leaf executed by
+// ExecuteSimpleAlgorithmInParallel().
+class vtkCompositeDataPipelineBlock
+{
+public:
+  vtkSmartPointer<vtkInformation> Request;
+  std::vector<vtkSmartPointer<vtkInformationVector> > Inputs;
+  std::vector<vtkInformationVector*> InputPointers;
+  vtkSmartPointer<vtkInformationVector> Outputs;
+};
+
+//----------------------------------------------------------------------------
+// Run the REQUEST_DATA pass of a range of leaves through CallAlgorithm(),
+// as the serial loop does.  The progress of the algorithm is the fraction
+// of the leaves done, reported by the thread that started the execution.
+class vtkCompositeDataPipelineExecuteBlocks
+{
+public:
+  vtkExecutive* Executive;
+  vtkAlgorithm* Algorithm;
+  std::vector<vtkCompositeDataPipelineBlock>* Blocks;
+  vtkAtomicInt<vtkIdType> NumberOfBlocksDone;
+  int CallerThreadIndex;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdType numBlocks = static_cast<vtkIdType>(this->Blocks->size());
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkCompositeDataPipelineBlock& block = (*this->Blocks)[i];
+      this->Executive->CallAlgorithm(block.Request,
+                                     vtkExecutive::RequestDownstream,
+                                     &block.InputPointers[0], block.Outputs);
+      vtkIdType numDone = ++this->NumberOfBlocksDone;
+      if (vtkSMPTools::GetThreadIndex() == this->CallerThreadIndex)
+        {
+        this->Algorithm->ReportProgress(
+          static_cast<double>(numDone) / numBlocks);
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+void vtkCompositeDataPipeline::ExecuteSimpleAlgorithmInParallel(
+  vtkCompositeDataSet* input,
+  vtkCompositeDataSet* compositeOutput,
+  int compositePort)
+{
+  vtkDebugMacro(<< "ExecuteSimpleAlgorithmInParallel");
+
+  int numInPorts = this->Algorithm->GetNumberOfInputPorts();
+  int numOutPorts = this->Algorithm->GetNumberOfOutputPorts();
+  std::vector<vtkCompositeDataPipelineBlock> blocks;
+
+  // Give each leaf a copy of the pipeline information of the algorithm
+  // and run the passes that precede REQUEST_DATA.  These use the
+  // executive, so they are done one leaf after the other.
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(input->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+    iter->GoToNextItem())
+    {
+    vtkDataObject* dobj = iter->GetCurrentDataObject();
+    if (!dobj)
+      {
+      continue;
+      }
+    blocks.push_back(vtkCompositeDataPipelineBlock());
+    vtkCompositeDataPipelineBlock& block = blocks.back();
+
+    for (int i = 0; i < numInPorts; ++i)
+      {
+      vtkInformationVector* inVec = this->GetInputInformation(i);
+      vtkSmartPointer<vtkInformationVector> vec =
+        vtkSmartPointer<vtkInformationVector>::New();
+      for (int j = 0; j < inVec->GetNumberOfInformationObjects(); ++j)
+        {
+        vtkSmartPointer<vtkInformation> info =
+          vtkSmartPointer<vtkInformation>::New();
+        info->Copy(inVec->GetInformationObject(j));
+        if (i == compositePort && j == 0)
+          {
+          // Process the whole leaf.
+          info->Set(vtkDataObject::DATA_OBJECT(), dobj);
+          this->CopyFromDataToInformation(dobj, info);
+          if (info->Has(WHOLE_EXTENT()))
+            {
+            info->Set(UPDATE_EXTENT(), info->Get(WHOLE_EXTENT()), 6);
+            }
+          info->Set(UPDATE_PIECE_NUMBER(), 0);
+          info->Set(UPDATE_NUMBER_OF_PIECES(), 1);
+          }
+        vec->Append(info);
+        }
+      block.Inputs.push_back(vec);
+      block.InputPointers.push_back(vec);
+      }
+
+    block.Outputs = vtkSmartPointer<vtkInformationVector>::New();
+    for (int i = 0; i < numOutPorts; ++i)
+      {
+      vtkSmartPointer<vtkInformation> info =
+        vtkSmartPointer<vtkInformation>::New();
+      info->Copy(this->GetOutputInformation(i));
+      info->Remove(vtkDataObject::DATA_OBJECT());
+      block.Outputs->Append(info);
+      }
+
+    vtkInformationVector** inVecs = &block.InputPointers[0];
+    block.Request = vtkSmartPointer<vtkInformation>::New();
+    block.Request->Set(FROM_OUTPUT_PORT(), 0);
+
+    // New output data objects, of the type chosen for this leaf.
+    block.Request->Set(REQUEST_DATA_OBJECT());
+    this->Algorithm->ProcessRequest(block.Request, inVecs, block.Outputs);
+    this->SuppressResetPipelineInformation = 1;
+    for (int i = 0; i < numOutPorts; ++i)
+      {
+      this->CheckDataObject(i, block.Outputs);
+      }
+    this->SuppressResetPipelineInformation = 0;
+    block.Request->Remove(REQUEST_DATA_OBJECT());
+
+    block.Request->Set(REQUEST_INFORMATION());
+    this->CopyDefaultInformation(block.Request, vtkExecutive::RequestDownstream,
+                                 inVecs, block.Outputs);
+    this->Algorithm->ProcessRequest(block.Request, inVecs, block.Outputs);
+    block.Request->Remove(REQUEST_INFORMATION());
+
+    // Update the whole leaf.
+    for (int i = 0; i < numOutPorts; ++i)
+      {
+      vtkInformation* info = block.Outputs->GetInformationObject(i);
+      if (info->Has(WHOLE_EXTENT()))
+        {
+        info->Set(UPDATE_EXTENT(), info->Get(WHOLE_EXTENT()), 6);
+        info->Set(UPDATE_EXTENT_INITIALIZED(), 1);
+        }
+      info->Set(UPDATE_PIECE_NUMBER(), 0);
+      info->Set(UPDATE_NUMBER_OF_PIECES(), 1);
+      }
+    block.Request->Set(REQUEST_UPDATE_EXTENT());
+    this->Algorithm->ProcessRequest(block.Request, inVecs, block.Outputs);
+    block.Request->Remove(REQUEST_UPDATE_EXTENT());
+
+    block.Request->Set(REQUEST_DATA());
+    }
+
+  // The algorithm reports the progress of its leaves from several
+  // threads, which its observers do not expect.
+  vtkCompositeDataPipelineExecuteBlocks functor;
+  functor.Executive = this;
+  functor.Algorithm = this->Algorithm;
+  functor.Blocks = &blocks;
+  functor.NumberOfBlocksDone = 0;
+  functor.CallerThreadIndex = vtkSMPTools::GetThreadIndex();
+  int suppressed = this->Algorithm->GetProgressSuppressed();
+  this->Algorithm->SetProgressSuppressed(1);
+  // CallAlgorithm() restores InAlgorithm when it returns, so the threads
+  // only ever set it to the value it has for the whole loop.
+  this->InAlgorithm = 1;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), 1, functor);
+  this->InAlgorithm = 0;
+  this->Algorithm->SetProgressSuppressed(suppressed);
+
+  // The leaves are visited in the same order as above.
+  size_t b = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+    iter->GoToNextItem())
+    {
+    if (!iter->GetCurrentDataObject())
+      {
+      continue;
+      }
+    vtkDataObject* outObj = blocks[b++].Outputs->GetInformationObject(0)->Get(
+      vtkDataObject::DATA_OBJECT());
+    if (outObj)
+      {
+      compositeOutput->SetDataSet(iter, outObj);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkDataObject* vtkCompositeDataPipeline::ExecuteSimpleAlgorithmForBlock(
   vtkInformationVector** inInfoVec,
@@ -1251,5 +1454,8 @@ void vtkCompositeDataPipeline::MarkOutputsGenerated(
 void vtkCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ParallelBlockExecution: "
+     << this->ParallelBlockExecution << endl;
 }
 
@@ -111,6 +111,26 @@ public:
   // *** THIS IS AN EXPERIMENTAL FEATURE. IT MAY CHANGE WITHOUT NOTICE ***
   static vtkInformationIntegerVectorKey* COMPOSITE_INDICES();
 
+  // Description:
+  // When on, a simple (non composite-aware) algorithm is executed on the
+  // leaves of its composite input concurrently, using vtkSMPTools.  The
+  // data object, information and update extent passes are done for every
+  // leaf first, one after the other, each leaf with its own pipeline
+  // information.  Then the REQUEST_DATA pass of all the leaves runs in
+  // parallel on the same algorithm instance.  Only turn this on for
+  // algorithms whose RequestData() only uses the information vectors it
+  // is given and does not modify the algorithm, as for most filters that
+  // have no state besides their parameters.  Only algorithms with a single
+  // output port are executed in parallel.  Their progress is the fraction
+  // of the leaves executed, reported from the thread that updates the
+  // pipeline.  The REQUEST_DATA pass of each leaf goes through
+  // CallAlgorithm(), but StartEvent and EndEvent are only invoked once for
+  // the whole composite dataset, from the thread that updates the
+  // pipeline, instead of once more for every leaf.  Off by default.
+  vtkSetMacro(ParallelBlockExecution, int);
+  vtkGetMacro(ParallelBlockExecution, int);
+  vtkBooleanMacro(ParallelBlockExecution, int);
+
 
 protected:
   vtkCompositeDataPipeline();
@@ -174,6 +194,14 @@ protected:
     vtkInformation* request,
     vtkDataObject* dobj);
 
+  // Execute the algorithm on all the leaves of the input at once, see
+  // ParallelBlockExecution.  The outputs are set in compositeOutput.
+  void ExecuteSimpleAlgorithmInParallel(vtkCompositeDataSet* input,
+                                        vtkCompositeDataSet* compositeOutput,
+                                        int compositePort);
+
+  int ParallelBlockExecution;
+
   bool ShouldIterateOverInput(int& compositePort);
 
   virtual int InputTypeIsValid(int port, int index,
@@ -39,12 +39,12 @@
 
 vtkStandardNewMacro(vtkDemandDrivenPipeline);
 
-vtkInformationKeyMacro(vtkDemandDrivenPipeline, DATA_NOT_GENERATED, Integer);
-vtkInformationKeyMacro(vtkDemandDrivenPipeline, RELEASE_DATA, Integer);
-vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_DATA, Request);
+vtkInformationKeySlotMacro(vtkDemandDrivenPipeline, DATA_NOT_GENERATED, Integer);
+vtkInformationKeySlotMacro(vtkDemandDrivenPipeline, RELEASE_DATA, Integer);
+vtkInformationKeySlotMacro(vtkDemandDrivenPipeline, REQUEST_DATA, Request);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_DATA_NOT_GENERATED, Request);
-vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_DATA_OBJECT, Request);
-vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_INFORMATION, Request);
+vtkInformationKeySlotMacro(vtkDemandDrivenPipeline, REQUEST_DATA_OBJECT, Request);
+vtkInformationKeySlotMacro(vtkDemandDrivenPipeline, REQUEST_INFORMATION, Request);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_REGENERATE_INFORMATION, Integer);
 
 //----------------------------------------------------------------------------
@@ -30,22 +30,26 @@
 #include "vtkExecutionScheduler.h"
 
 #include "vtkAlgorithm.h"
+#include "vtkAlgorithmOutput.h"
 #include "vtkCommand.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkComputingResources.h"
+#include "vtkConditionVariable.h"
+#include "vtkDataObject.h"
 #include "vtkExecutiveCollection.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationExecutivePortVectorKey.h"
 #include "vtkInformationIntegerKey.h"
-#include "vtkMultiThreader.h"
 #include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkThreadedStreamingPipeline.h"
-#include "vtkThreadMessager.h"
 
+#include <algorithm>
+#include <map>
 #include <set>
-#include <vtksys/hash_map.hxx>
 #include <vector>
 #include <vtksys/hash_set.hxx>
 
@@ -54,33 +58,6 @@ vtkStandardNewMacro(vtkExecutionScheduler);
 
 vtkInformationKeyMacro(vtkExecutionScheduler, TASK_PRIORITY, Integer);
 
-//----------------------------------------------------------------------------
-class Task
-{
-public:
-  Task(int _priority = -1, vtkExecutive *_exec = NULL, vtkInformation *_info = NULL)
-  {
-    this->priority = _priority;
-    this->exec = _exec;
-    this->info = _info;
-  }
-
-  int             priority;
-  vtkExecutive   *exec;
-  vtkInformation *info;
-};
-
-//----------------------------------------------------------------------------
-class TaskWeakOrdering
-{
-public:
-  bool operator()(const Task& t1,
-                  const Task& t2) const
-  {
-    return t1.priority < t2.priority;
-  }
-};
-
 //----------------------------------------------------------------------------
 // Convinient definitions of vector/set of vtkExecutive
 class vtkExecutiveHasher
@@ -95,595 +72,442 @@ typedef vtksys::hash_set<vtkExecutive*, vtkExecutiveHasher> vtkExecutiveSet;
 typedef std::vector<vtkExecutive*>                       vtkExecutiveVector;
 
 //----------------------------------------------------------------------------
-class vtkExecutionScheduler::implementation
+// One executive of the graph.
+class vtkExecutionSchedulerTask
 {
 public:
-  // The containing object
-  vtkExecutionScheduler*  Scheduler;
-
-  // Some convenient type definitions for STL containers
-  typedef vtksys::hash_map<vtkExecutive*, int,
-    vtkExecutiveHasher>                                 ExecutiveIntHashMap;
-  typedef std::pair<int, int>                        Edge;
-  class                                                 EdgeHasher;
-  typedef vtksys::hash_set<Edge, EdgeHasher>            EdgeSet;
-  typedef std::multiset<Task, TaskWeakOrdering>      TaskPriorityQueue;
-  typedef std::vector<vtkMutexLock*>                 MutexLockVector;
-  typedef std::vector<vtkThreadMessager*>            MessagerVector;
-  class EdgeHasher
-  {
-  public:
-    size_t operator()(const Edge &e) const
-    {
-      return (size_t)((e.first << 16) +  e.second);
-    }
-  };
-
-  vtkExecutiveSet           ExecutingTasks;
-  TaskPriorityQueue         PrioritizedTasks;
-  ExecutiveIntHashMap       DependencyNodes;
-  EdgeSet                   DependencyEdges;
-  MessagerVector            TaskDoneMessagers;
-  MutexLockVector           InputsReleasedLocks;
-  MessagerVector            InputsReleasedMessagers;
-  int                       CurrentPriority;
-
-  // Description:
-  // Start from the exec and go all the way up to the sources (modules
-  // without any inputs), then call TraverseDownToSink to update edges
-  void FindAndTraverseFromSources(vtkExecutive *exec, vtkExecutiveSet &visited);
-
-  // Description:
-  // Actual traverse down the network, for each nodes, construct and
-  // add edges connecting all of its upstream modules to itself to the
-  // dependency graph
-  void TraverseDownToSink(vtkExecutive *exec, vtkExecutiveSet &upstream,
-                          vtkExecutiveSet &visited);
-
-  // Description:
-  // Actual traverse down the network, for each nodes, construct and
-  // add edges connecting all of its upstream modules to itself to the
-  // dependency graph
-  void CollectDownToSink(vtkExecutive *exec, vtkExecutiveSet &visited,
-                         vtkExecutiveVector &graph);
-
-  // Description:
-  // A task can be executed if none of its predecessor tasks are still
-  // on the queue. This only makes sense for tasks that are currently
-  // on the queue, thus, an iterator is provided instead of the task
-  // itself.
-  bool CanExecuteTask(TaskPriorityQueue::const_iterator ti);
-  // Description:
-  // Spawn a thread to execute a module
-  void Execute(const Task &task);
-
-  // Description:
-  // Check if the given exec is a new module or not. If it is then
-  // traverse the network to update dependency edges for its connected
-  // subgraph
-  void UpdateDependencyGraph(vtkExecutive *exec);
-
-  // Description:
-  // Add the module exec to the set of dependency nodes if it is not
-  // already there and return its node id number
-  int AddToDependencyGraph(vtkExecutive *exec);
-
-  // Description:
-  // Add the given executive to the execution queue for later
-  // execution
-  void AddToQueue(vtkExecutive *exec, vtkInformation *info);
-
-  // Description:
-  // Obtain the priority from the information object if it is given,
-  // otherwise, use a priority assigned from the scheduler
-  int AcquirePriority(vtkInformation *info);
+  vtkExecutionSchedulerTask()
+    {
+    this->Executive = 0;
+    this->Priority = 0;
+    this->NumberOfDependencies = 0;
+    this->Exclusive = false;
+    this->Failed = false;
+    this->Skipped = false;
+    }
+
+  vtkExecutive*    Executive;
+  int              Priority;
+  // Output ports read by the consumers of the graph.
+  std::set<int>    Ports;
+  // Indices of the tasks consuming the outputs of this one.
+  std::vector<int> Consumers;
+  // Number of producers of this task that are not done yet.
+  int              NumberOfDependencies;
+  // The task reads a composite dataset block by block.
+  bool             Exclusive;
+  // A producer of this task failed.
+  bool             Failed;
+  // The task only waits for its producers.
+  bool             Skipped;
 };
 
 //----------------------------------------------------------------------------
-static vtkExecutionScheduler *globalScheduler = NULL;
+// The tasks in dependency order and the state shared by the workers.
+class vtkExecutionSchedulerGraph
+{
+public:
+  std::vector<vtkExecutionSchedulerTask> Tasks;
+  std::map<vtkExecutive*, int>           Index;
 
-//----------------------------------------------------------------------------
-void * vtkExecutionScheduler_ScheduleThread(void *data);
-void * vtkExecutionScheduler_ExecuteThread(void *data);
+  // Tasks whose producers are all done, by priority then index.
+  std::set<std::pair<int, int> > Ready;
+  int NumberOfPendingTasks;
+  int NumberOfRunningTasks;
+  int MaximumNumberOfRunningTasks;
+  int Result;
 
-//----------------------------------------------------------------------------
-vtkExecutionScheduler* vtkExecutionScheduler::GetGlobalScheduler()
-{
-  if (!globalScheduler)
-    {
-    globalScheduler = vtkExecutionScheduler::New();
-    }
-  return globalScheduler;
-}
+  vtkSimpleMutexLock          Lock;
+  vtkSimpleConditionVariable  Condition;
+  vtkSimpleMutexLock          ExclusiveLock;
 
-//----------------------------------------------------------------------------
-vtkExecutionScheduler::vtkExecutionScheduler()
-  : Implementation(new implementation)
-{
-  this->Resources = vtkComputingResources::New();
-  this->Resources->ObtainMaximumResources();
-  this->ResourceMessager = vtkThreadMessager::New();
-  this->ScheduleLock = vtkMutexLock::New();
-  this->ScheduleMessager = vtkThreadMessager::New();
-  this->ScheduleThreader = vtkMultiThreader::New();
-  this->ScheduleThreader->SetNumberOfThreads(1);
-  this->ScheduleThreadId = -1;
-  this->Implementation->Scheduler = this;
-  this->Implementation->CurrentPriority = 0;
-}
+  // Add exec and the executives upstream of it, producers first.
+  void Add(vtkExecutive* exec);
 
-//----------------------------------------------------------------------------
-vtkExecutionScheduler::~vtkExecutionScheduler()
-{
-  this->Resources->Delete();
-  this->ResourceMessager->Delete();
-  this->ScheduleLock->Delete();
-  this->ScheduleMessager->Delete();
-  this->ScheduleThreader->Delete();
-  delete this->Implementation;
-}
+  // Return true if the tasks can execute without forwarding their
+  // requests upstream.
+  bool CanExecuteConcurrently();
 
-//----------------------------------------------------------------------------
-void vtkExecutionScheduler::PrintSelf(ostream &os, vtkIndent indent)
-{
-  this->Superclass::PrintSelf(os, indent);
-}
+  // Bring the outputs of a task up to date.
+  int Execute(vtkExecutionSchedulerTask& task, bool concurrent);
+
+  // Execute tasks until all of them are done.
+  void Work();
+};
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::SchedulePropagate(vtkExecutiveCollection *execs, vtkInformation* vtkNotUsed(info))
+void vtkExecutionSchedulerGraph::Add(vtkExecutive* exec)
 {
-  execs->InitTraversal();
-  vtkExecutiveSet    visited;
-  vtkExecutiveVector graph;
-  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
+  if (this->Index.find(exec) != this->Index.end())
     {
-    this->Implementation->CollectDownToSink(e, visited, graph);
+    return;
     }
+  // Mark it as visited. Pipelines are acyclic, so it is never reached
+  // again before its index is set below.
+  this->Index[exec] = -1;
 
-  for (vtkExecutiveVector::iterator vi=graph.begin();
-       vi!=graph.end(); vi++)
+  std::vector<std::pair<vtkExecutive*, int> > producers;
+  for(int i = 0; i < exec->GetNumberOfInputPorts(); ++i)
     {
-    (*vi)->Update();
-    vtkAlgorithm *rep =(*vi)->GetAlgorithm();
-    if (rep->IsA("vtkDataRepresentation"))
+    int nic = exec->GetAlgorithm()->GetNumberOfInputConnections(i);
+    vtkInformationVector* inVector = exec->GetInputInformation()[i];
+    for(int j = 0; j < nic; ++j)
       {
-      rep->InvokeEvent(vtkCommand::UpdateEvent, NULL);
+      vtkInformation* inInfo = inVector->GetInformationObject(j);
+      vtkExecutive* e;
+      int producerPort;
+      vtkExecutive::PRODUCER()->Get(inInfo, e, producerPort);
+      if (e)
+        {
+        this->Add(e);
+        producers.push_back(std::make_pair(e, producerPort));
+        }
       }
     }
-}
 
-//----------------------------------------------------------------------------
-void vtkExecutionScheduler::Schedule(vtkExecutiveCollection *execs, vtkInformation *info)
-{
-  if (this->ScheduleThreadId == -1)
-    {
-    this->ScheduleThreadId = this->ScheduleThreader->
-      SpawnThread((vtkThreadFunctionType)(vtkExecutionScheduler_ScheduleThread), this);
-    }
-  this->ScheduleLock->Lock();
-  vtkExecutiveVector G;
-  execs->InitTraversal();
-  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
+  int index = static_cast<int>(this->Tasks.size());
+  this->Index[exec] = index;
+  this->Tasks.push_back(vtkExecutionSchedulerTask());
+  vtkExecutionSchedulerTask& task = this->Tasks.back();
+  task.Executive = exec;
+  vtkInformation* algInfo = exec->GetAlgorithm()->GetInformation();
+  task.Priority = algInfo->Has(vtkExecutionScheduler::TASK_PRIORITY()) ?
+    algInfo->Get(vtkExecutionScheduler::TASK_PRIORITY()) : 0;
+
+  for (size_t p = 0; p < producers.size(); ++p)
     {
-    if (this->Implementation->ExecutingTasks.find(e) != this->Implementation->ExecutingTasks.end())
+    vtkExecutionSchedulerTask& producer =
+      this->Tasks[this->Index[producers[p].first]];
+    producer.Ports.insert(producers[p].second);
+    if (std::find(producer.Consumers.begin(), producer.Consumers.end(),
+                  index) == producer.Consumers.end())
       {
-      return;
+      producer.Consumers.push_back(index);
+      this->Tasks[index].NumberOfDependencies++;
       }
-    if (this->Implementation->DependencyNodes.find(e) == this->Implementation->DependencyNodes.end())
+    vtkDataObject* input = producer.Executive->GetOutputInformation(
+      producers[p].second)->Get(vtkDataObject::DATA_OBJECT());
+    if (vtkCompositeDataSet::SafeDownCast(input))
       {
-      this->Implementation->UpdateDependencyGraph(e);
+      this->Tasks[index].Exclusive = true;
       }
-    G.push_back(e);
     }
+}
 
-  // Create an adjacency matrix
-  unsigned i, j, k, p;
-  unsigned N = (unsigned)G.size();
-  int *A = (int*)malloc(N*N*sizeof(int));
-  int *degree = (int*)malloc(N*sizeof(int));
-  memset(A, 0, N*N*sizeof(int));
-  memset(degree, 0, N*sizeof(int));
-  for (i = 0; i < N; i++)
+//----------------------------------------------------------------------------
+bool vtkExecutionSchedulerGraph::CanExecuteConcurrently()
+{
+  for (size_t t = 0; t < this->Tasks.size(); ++t)
     {
-    int src = (*(this->Implementation->DependencyNodes.find(G[i]))).second;
-    for (j = 0; j < N; j++)
+    vtkExecutive* exec = this->Tasks[t].Executive;
+    if (this->Tasks[t].Skipped)
       {
-      int dst = (*(this->Implementation->DependencyNodes.find(G[j]))).second;
-      if (this->Implementation->DependencyEdges.find(implementation::Edge(src, dst)) !=
-          this->Implementation->DependencyEdges.end())
-        {
-        A[i*N+j] = 1;
-        degree[j]++;
-        }
+      continue;
       }
-    }
-
-  unsigned *S = (unsigned*)malloc(N*sizeof(unsigned));
-  k = 0;
-  for (j = 0; j < N; j++)
-    {
-    if (degree[j] == 0)
+    if (!vtkDemandDrivenPipeline::SafeDownCast(exec))
       {
-      S[k++] = j;
+      return false;
       }
-    }
-  p = 0;
-  while (p < k)
-    {
-    i = S[p++];
-    this->Implementation->AddToQueue(G[i], info);
-    for (j = 0; j < N; j++)
-      if (A[i*N+j])
+    // Only vtkThreadedStreamingPipeline can skip forwarding.
+    if (this->Tasks[t].NumberOfDependencies > 0 &&
+        !vtkThreadedStreamingPipeline::SafeDownCast(exec))
+      {
+      return false;
+      }
+    // The first consumer done would release the data of the others.
+    if (this->Tasks[t].Consumers.size() > 1)
+      {
+      std::set<int>::const_iterator port = this->Tasks[t].Ports.begin();
+      for (; port != this->Tasks[t].Ports.end(); ++port)
         {
-        degree[j]--;
-        A[i*N+j] = 0;
-        if (degree[j] == 0)
+        vtkInformation* outInfo = exec->GetOutputInformation(*port);
+        if (outInfo->Has(vtkDemandDrivenPipeline::RELEASE_DATA()) &&
+            outInfo->Get(vtkDemandDrivenPipeline::RELEASE_DATA()))
           {
-          S[k++] = j;
+          return false;
           }
         }
+      }
     }
-  free(S);
-  free(degree);
-  free(A);
-
-  // Wake the scheduling thread up if it is currently waiting for tasks
-  this->ScheduleMessager->SendWakeMessage();
-  this->ScheduleLock->Unlock();
-
-}
-
-//----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::UpdateDependencyGraph(vtkExecutive *exec)
-{
-  vtkExecutiveSet visited;
-  this->FindAndTraverseFromSources(exec, visited);
+  return true;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::FindAndTraverseFromSources
-(vtkExecutive *exec, vtkExecutiveSet &visited)
+int vtkExecutionSchedulerGraph::Execute(vtkExecutionSchedulerTask& task,
+                                        bool concurrent)
 {
-  if (visited.find(exec) != visited.end())
-    {
-    return;
-    }
-  visited.insert(exec);
-  bool isSource = true;
-  for(int i = 0; i < exec->GetNumberOfInputPorts(); ++i)
-    {
-    int nic = exec->GetAlgorithm()->GetNumberOfInputConnections(i);
-    vtkInformationVector* inVector = exec->GetInputInformation()[i];
-    for(int j = 0; j < nic; ++j)
-      {
-      vtkInformation* inInfo = inVector->GetInformationObject(j);
-      vtkExecutive* e;
-      int producerPort;
-      vtkExecutive::PRODUCER()->Get(inInfo, e, producerPort);
-      if (e)
-        {
-        isSource = false;
-        this->FindAndTraverseFromSources(e, visited);
-        }
-      }
-    }
-  if (isSource)
+  vtkDemandDrivenPipeline* ddp =
+    vtkDemandDrivenPipeline::SafeDownCast(task.Executive);
+  if (task.Skipped)
     {
-    vtkExecutiveSet upstream;
-    vtkExecutiveSet downVisited;
-    this->TraverseDownToSink(exec, upstream, downVisited);
+    return 1;
     }
-}
-
-//----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::TraverseDownToSink
-(vtkExecutive *exec, vtkExecutiveSet &upstream, vtkExecutiveSet &visited)
-{
-  if (visited.find(exec)!=visited.end())
+  if (!ddp)
     {
-    return;
+    // Brought up to date when its consumers forward their requests.
+    return 1;
     }
+  vtkThreadedStreamingPipeline* tsp =
+    vtkThreadedStreamingPipeline::SafeDownCast(ddp);
 
-  // Now mark all edges from upstream modules to exec as dependency edges
-  int vId = this->AddToDependencyGraph(exec);
-  for (vtkExecutiveSet::const_iterator it = upstream.begin(); it != upstream.end(); it++)
+  std::vector<int> ports(task.Ports.begin(), task.Ports.end());
+  if (ports.empty())
     {
-    implementation::ExecutiveIntHashMap::iterator hit = this->DependencyNodes.find(*it);
-    this->DependencyEdges.insert(Edge((*hit).second, vId));
+    // A sink of the graph: update what was requested from it.
+    for (int i = 0; i < ddp->GetNumberOfOutputPorts(); ++i)
+      {
+      ports.push_back(i);
+      }
+    if (ports.empty())
+      {
+      ports.push_back(-1);
+      }
     }
 
-  // Mark as visited
-  visited.insert(exec);
-
-  // Then insert it to the upstream list for going down
-  upstream.insert(exec);
-  for(int i = 0; i < exec->GetNumberOfOutputPorts(); ++i)
+  int result = 1;
+  for (size_t i = 0; i < ports.size(); ++i)
     {
-    vtkInformation* info = exec->GetOutputInformation(i);
-    int consumerCount = vtkExecutive::CONSUMERS()->Length(info);
-    vtkExecutive** e = vtkExecutive::CONSUMERS()->GetExecutives(info);
-    for (int j = 0; j < consumerCount; j++)
-      if (e[j])
-        {
-        this->TraverseDownToSink(e[j], upstream, visited);
-        }
+    if (concurrent && tsp)
+      {
+      result = tsp->UpdateDataFromInputs(ports[i]) && result;
+      }
+    else
+      {
+      result = ddp->UpdateData(ports[i]) && result;
+      }
     }
-
-  // Take it out of the upstream and prepare for back-tracking
-  upstream.erase(exec);
+  return result;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::CollectDownToSink
-(vtkExecutive *exec, vtkExecutiveSet &visited, vtkExecutiveVector &graph)
+void vtkExecutionSchedulerGraph::Work()
 {
-  if (visited.find(exec)!=visited.end())
+  this->Lock.Lock();
+  for (;;)
     {
-    return;
-    }
-
-  // Mark as visited
-  visited.insert(exec);
-
-  // Add it to the ordered graph
-  graph.push_back(exec);
-
-  // Then traverse down
-  for(int i = 0; i < exec->GetNumberOfOutputPorts(); ++i)
-    {
-    vtkInformation* info = exec->GetOutputInformation(i);
-    int consumerCount = vtkExecutive::CONSUMERS()->Length(info);
-    vtkExecutive** e = vtkExecutive::CONSUMERS()->GetExecutives(info);
-    for (int j = 0; j < consumerCount; j++)
+    if (this->Ready.empty())
       {
-      if (e[j])
+      if (this->NumberOfPendingTasks == 0 || this->NumberOfRunningTasks == 0)
         {
-        this->CollectDownToSink(e[j], visited, graph);
+        break;
         }
+      this->Condition.Wait(this->Lock);
+      continue;
       }
-    }
-}
 
-//----------------------------------------------------------------------------
-int vtkExecutionScheduler::implementation::AddToDependencyGraph(vtkExecutive *exec)
-{
-  // We never remove vertices, it's ok to just return the size of
-  // DependencyGraph as a node id
-  implementation::ExecutiveIntHashMap::iterator hit = this->DependencyNodes.find(exec);
-  // Check if this is a new module or an untouched sub-network
-  int vId = -1;
-  if (hit == this->DependencyNodes.end())
-    {
-    vId = (int)this->DependencyNodes.size();
-    this->DependencyNodes[exec] = vId;
+    int index = this->Ready.begin()->second;
+    this->Ready.erase(this->Ready.begin());
+    vtkExecutionSchedulerTask& task = this->Tasks[index];
+    this->NumberOfRunningTasks++;
+    this->MaximumNumberOfRunningTasks =
+      std::max(this->MaximumNumberOfRunningTasks, this->NumberOfRunningTasks);
+    this->Lock.Unlock();
 
-    // Make sure that we have enough thread messagers for this vId
-    while (this->TaskDoneMessagers.size()<=(size_t)vId)
+    int result = 0;
+    if (!task.Failed)
       {
-      this->TaskDoneMessagers.push_back(vtkThreadMessager::New());
+      if (task.Exclusive)
+        {
+        this->ExclusiveLock.Lock();
+        }
+      result = this->Execute(task, true);
+      if (task.Exclusive)
+        {
+        this->ExclusiveLock.Unlock();
+        }
       }
 
-    while (this->InputsReleasedMessagers.size()<=(size_t)vId)
+    this->Lock.Lock();
+    this->NumberOfRunningTasks--;
+    this->NumberOfPendingTasks--;
+    if (!result)
       {
-      this->InputsReleasedMessagers.push_back(vtkThreadMessager::New());
-      this->InputsReleasedLocks.push_back(vtkMutexLock::New());
+      this->Result = 0;
       }
+    for (size_t c = 0; c < task.Consumers.size(); ++c)
+      {
+      vtkExecutionSchedulerTask& consumer = this->Tasks[task.Consumers[c]];
+      if (!result)
+        {
+        consumer.Failed = true;
+        }
+      if (--consumer.NumberOfDependencies == 0)
+        {
+        this->Ready.insert(
+          std::make_pair(consumer.Priority, task.Consumers[c]));
+        }
+      }
+    this->Condition.Broadcast();
     }
-  // We have this module in our cache before
-  else
-    {
-    vId = (*hit).second;
-    }
-  return vId;
+  this->Lock.Unlock();
 }
 
 //----------------------------------------------------------------------------
-int vtkExecutionScheduler::implementation::AcquirePriority(vtkInformation * info)
+// Each worker executes ready tasks until the graph is done.
+class vtkExecutionSchedulerWorker
 {
-  int priority;
-  if (info && info->Has(TASK_PRIORITY()))
-    {
-    priority = info->Get(TASK_PRIORITY());
-    }
-  else
+public:
+  vtkExecutionSchedulerGraph* Graph;
+
+  void operator()(vtkIdType begin, vtkIdType end)
     {
-    priority = this->CurrentPriority++;
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Graph->Work();
+      }
     }
-  return priority;
-}
+};
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::AddToQueue(vtkExecutive *exec, vtkInformation * info)
-{
-  int priority = this->AcquirePriority(info);
-  this->PrioritizedTasks.insert(Task(priority, exec, info));
-  vtkMutexLock *lock = this->Scheduler->GetInputsReleasedLock(exec);
-  if (lock)
-    {
-//     fprintf(stderr, "A %s\n", exec->GetAlgorithm()->GetClassName());
-    lock->Lock();
-    }
-}
+static vtkExecutionScheduler *globalScheduler = NULL;
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::WaitUntilDone(vtkExecutiveCollection *execs)
+vtkExecutionScheduler* vtkExecutionScheduler::GetGlobalScheduler()
 {
-  vtkExecutiveSet::const_iterator it;
-  execs->InitTraversal();
-  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
+  if (!globalScheduler)
     {
-    this->WaitForTaskDone(e);
+    globalScheduler = vtkExecutionScheduler::New();
     }
+  return globalScheduler;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::WaitUntilAllDone()
+vtkExecutionScheduler::vtkExecutionScheduler()
 {
-  while (true)
-    {
-    vtkExecutive *exec = NULL;
-    this->ScheduleLock->Lock();
-    if (this->Implementation->PrioritizedTasks.size() > 0)
-      exec = (*(this->Implementation->PrioritizedTasks.begin())).exec;
-    this->ScheduleLock->Unlock();
-    if (exec)
-      this->WaitForTaskDone(exec);
-    else
-      break;
-    }
+  this->Resources = vtkComputingResources::New();
+  this->Resources->ObtainMaximumResources();
+  this->MaximumNumberOfConcurrentTasks = 0;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::WaitUntilReleased(vtkExecutiveCollection *execs)
+vtkExecutionScheduler::~vtkExecutionScheduler()
 {
-  vtkExecutiveSet::const_iterator it;
-  execs->InitTraversal();
-  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
-    {
-    this->WaitForInputsReleased(e);
-    }
+  this->Resources->Delete();
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::WaitForTaskDone(vtkExecutive *exec)
+void vtkExecutionScheduler::PrintSelf(ostream &os, vtkIndent indent)
 {
-  vtkThreadMessager *messager = this->GetTaskDoneMessager(exec);
-  if (messager)
-    messager->WaitForMessage();
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumNumberOfConcurrentTasks: "
+     << this->MaximumNumberOfConcurrentTasks << "\n";
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::WaitForInputsReleased(vtkExecutive *exec)
+static void CollectDownToSink(vtkExecutive *exec, vtkExecutiveSet &visited,
+                              vtkExecutiveVector &graph)
 {
-  vtkMutexLock *lock = this->GetInputsReleasedLock(exec);
-  if (lock)
+  if (visited.find(exec)!=visited.end())
     {
-    lock->Lock();
-    lock->Unlock();
+    return;
     }
-//   vtkThreadMessager *messager = this->GetInputsReleasedMessager(exec);
-//   if (messager)
-//     messager->WaitForMessage();
-}
 
-//----------------------------------------------------------------------------
-vtkThreadMessager* vtkExecutionScheduler::GetTaskDoneMessager(vtkExecutive *exec)
-{
-  implementation::ExecutiveIntHashMap::iterator hit =
-    this->Implementation->DependencyNodes.find(exec);
-  if (hit != this->Implementation->DependencyNodes.end())
+  // Mark as visited
+  visited.insert(exec);
+
+  // Add it to the ordered graph
+  graph.push_back(exec);
+
+  // Then traverse down
+  for(int i = 0; i < exec->GetNumberOfOutputPorts(); ++i)
     {
-    implementation::TaskPriorityQueue::const_iterator ti;
-    for (ti = this->Implementation->PrioritizedTasks.begin();
-         ti != this->Implementation->PrioritizedTasks.end(); ti++)
+    vtkInformation* info = exec->GetOutputInformation(i);
+    int consumerCount = vtkExecutive::CONSUMERS()->Length(info);
+    vtkExecutive** e = vtkExecutive::CONSUMERS()->GetExecutives(info);
+    for (int j = 0; j < consumerCount; j++)
       {
-      if ((*ti).exec==exec)
+      if (e[j])
         {
-        return this->Implementation->TaskDoneMessagers[(*hit).second];
+        CollectDownToSink(e[j], visited, graph);
         }
       }
     }
-  return NULL;
 }
 
 //----------------------------------------------------------------------------
-vtkMutexLock* vtkExecutionScheduler::GetInputsReleasedLock(vtkExecutive *exec)
+void vtkExecutionScheduler::SchedulePropagate(vtkExecutiveCollection *execs, vtkInformation* vtkNotUsed(info))
 {
-  implementation::ExecutiveIntHashMap::iterator hit =
-    this->Implementation->DependencyNodes.find(exec);
-  if (hit != this->Implementation->DependencyNodes.end())
+  execs->InitTraversal();
+  vtkExecutiveSet    visited;
+  vtkExecutiveVector graph;
+  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
     {
-    implementation::TaskPriorityQueue::const_iterator ti;
-    for (ti = this->Implementation->PrioritizedTasks.begin();
-         ti != this->Implementation->PrioritizedTasks.end(); ti++)
-      {
-      if ((*ti).exec == exec)
-        {
-        return this->Implementation->InputsReleasedLocks[(*hit).second];
-        }
-      }
+    CollectDownToSink(e, visited, graph);
     }
-  return NULL;
-}
 
-//----------------------------------------------------------------------------
-vtkThreadMessager* vtkExecutionScheduler::GetInputsReleasedMessager(vtkExecutive *exec)
-{
-  implementation::ExecutiveIntHashMap::iterator hit =
-    this->Implementation->DependencyNodes.find(exec);
-  if (hit != this->Implementation->DependencyNodes.end())
+  for (vtkExecutiveVector::iterator vi=graph.begin();
+       vi!=graph.end(); vi++)
     {
-    implementation::TaskPriorityQueue::const_iterator ti;
-    for (ti = this->Implementation->PrioritizedTasks.begin();
-         ti != this->Implementation->PrioritizedTasks.end(); ti++)
+    (*vi)->Update();
+    vtkAlgorithm *rep =(*vi)->GetAlgorithm();
+    if (rep->IsA("vtkDataRepresentation"))
       {
-      if ((*ti).exec==exec)
-        {
-        return this->Implementation->InputsReleasedMessagers[(*hit).second];
-        }
+      rep->InvokeEvent(vtkCommand::UpdateEvent, NULL);
       }
     }
-  return NULL;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::ReleaseResources(vtkExecutive *exec)
+int vtkExecutionScheduler::Schedule(vtkExecutiveCollection *execs)
 {
-  vtkThreadedStreamingPipeline *threadedExec = vtkThreadedStreamingPipeline::
-    SafeDownCast(exec);
-  if (threadedExec)
+  vtkExecutionSchedulerGraph graph;
+  execs->InitTraversal();
+  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
     {
-    this->ScheduleLock->Lock();
-    this->Resources->Collect(threadedExec->GetResources());
-    this->ResourceMessager->SendWakeMessage();
-    this->ScheduleLock->Unlock();
+    graph.Add(e);
     }
+  return this->Execute(&graph);
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::ReacquireResources(vtkExecutive *exec)
+int vtkExecutionScheduler::ScheduleUpstream(vtkExecutive *exec)
 {
-  vtkThreadedStreamingPipeline *threadedExec = vtkThreadedStreamingPipeline::
-    SafeDownCast(exec);
-  if (threadedExec)
-    {
-    while (!this->Resources->Reserve(threadedExec->GetResources()))
-      {
-      this->ResourceMessager->WaitForMessage();
-      }
-    }
+  vtkExecutionSchedulerGraph graph;
+  graph.Add(exec);
+  graph.Tasks[graph.Index[exec]].Skipped = true;
+  return this->Execute(&graph);
 }
 
 //----------------------------------------------------------------------------
-bool vtkExecutionScheduler::implementation::CanExecuteTask
-(TaskPriorityQueue::const_iterator taskIter)
+int vtkExecutionScheduler::Execute(vtkExecutionSchedulerGraph *graph)
 {
-  if (this->ExecutingTasks.find((*taskIter).exec) != this->ExecutingTasks.end())
-    {
-    return false;
-    }
-  ExecutiveIntHashMap::iterator hit = this->DependencyNodes.find((*taskIter).exec);
-  if (hit == this->DependencyNodes.end())
-    {
-    return true;
-    }
-  int dst = (*hit).second;
-  TaskPriorityQueue::const_iterator ti;
-  for (ti = this->PrioritizedTasks.begin();
-       ti != taskIter; ti++)
+  int numberOfTasks = static_cast<int>(graph->Tasks.size());
+  graph->NumberOfPendingTasks = numberOfTasks;
+  graph->NumberOfRunningTasks = 0;
+  graph->MaximumNumberOfRunningTasks = 0;
+  graph->Result = 1;
+
+  if (!graph->CanExecuteConcurrently())
     {
-    if ((*ti).priority > (*taskIter).priority)
+    // The tasks are in dependency order.
+    for (int t = 0; t < numberOfTasks; ++t)
       {
-      break;
+      if (!graph->Execute(graph->Tasks[t], false))
+        {
+        graph->Result = 0;
+        break;
+        }
       }
-    hit = this->DependencyNodes.find((*ti).exec);
-    int src = (*hit).second;
-    if (this->DependencyEdges.find(Edge(src, dst)) != this->DependencyEdges.end())
+    this->MaximumNumberOfConcurrentTasks = numberOfTasks > 0 ? 1 : 0;
+    return graph->Result;
+    }
+
+  for (int t = 0; t < numberOfTasks; ++t)
+    {
+    if (graph->Tasks[t].NumberOfDependencies == 0)
       {
-      return false;
+      graph->Ready.insert(std::make_pair(graph->Tasks[t].Priority, t));
       }
     }
-  return true;
+
+  int numberOfWorkers = std::min(
+    numberOfTasks, vtkSMPTools::GetEstimatedNumberOfThreads());
+  vtkExecutionSchedulerWorker worker;
+  worker.Graph = graph;
+  vtkSMPTools::For(0, numberOfWorkers, 1, worker);
+
+  this->MaximumNumberOfConcurrentTasks = graph->MaximumNumberOfRunningTasks;
+  return graph->Result;
 }
 
 //----------------------------------------------------------------------------
@@ -764,89 +588,3 @@ void vtkExecutionScheduler::ClassFinalize()
     globalScheduler->FastDelete();
     }
 }
-
-//----------------------------------------------------------------------------
-typedef struct
-{
-  vtkExecutionScheduler *scheduler;
-  Task task;
-} ExecutionData;
-//----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::Execute(const Task &task)
-{
-  ExecutionData *eData = new ExecutionData();
-  eData->scheduler = this->Scheduler;
-  eData->task = task;
-  this->Scheduler->ScheduleThreader->SpawnThread((vtkThreadFunctionType)(vtkExecutionScheduler_ExecuteThread), eData);
-}
-
-//----------------------------------------------------------------------------
-void * vtkExecutionScheduler_ScheduleThread(void *data)
-{
-  vtkExecutionScheduler *self = static_cast<vtkExecutionScheduler*>
-    (static_cast<vtkMultiThreader::ThreadInfo*>(data)->UserData);
-  while (true)
-    {
-    self->ScheduleLock->Lock();
-    bool needToWait = true;
-    vtkExecutionScheduler::implementation::TaskPriorityQueue::iterator ti;
-    for (ti = self->Implementation->PrioritizedTasks.begin();
-         ti != self->Implementation->PrioritizedTasks.end(); ti++)
-      {
-      if (self->Implementation->CanExecuteTask(ti))
-        {
-        vtkThreadedStreamingPipeline *exec = vtkThreadedStreamingPipeline::
-          SafeDownCast((*ti).exec);
-        if (self->Resources->Reserve(exec->GetResources()))
-          {
-          needToWait = false;
-          self->Implementation->ExecutingTasks.insert(exec);
-          self->ScheduleLock->Unlock();
-          self->Implementation->Execute(*ti);
-          break;
-          }
-        }
-      }
-    if (needToWait)
-      {
-      self->ScheduleLock->Unlock();
-      self->ScheduleMessager->WaitForMessage();
-      }
-    }
-  return NULL;
-}
-
-//----------------------------------------------------------------------------
-void * vtkExecutionScheduler_ExecuteThread(void *data)
-{
-  ExecutionData *eData = static_cast<ExecutionData*>
-    (static_cast<vtkMultiThreader::ThreadInfo*>(data)->UserData);
-  vtkExecutionScheduler *self = eData->scheduler;
-  Task task = eData->task;
-  vtkThreadedStreamingPipeline *exec = vtkThreadedStreamingPipeline::
-    SafeDownCast(task.exec);
-  vtkThreadMessager *messager = self->GetTaskDoneMessager(task.exec);
-  vtkMutexLock *lock = self->GetInputsReleasedLock(task.exec);
-  exec->GetResources()->Deploy(exec, task.info);
-  self->ScheduleLock->Lock();
-  self->Implementation->PrioritizedTasks.erase(task);
-  self->Implementation->ExecutingTasks.erase(exec);
-  self->Resources->Collect(exec->GetResources());
-  self->ResourceMessager->SendWakeMessage();
-  self->ScheduleLock->Unlock();
-  exec->ReleaseInputs();
-  self->ScheduleMessager->SendWakeMessage();
-  if (task.info && task.info->Has(vtkThreadedStreamingPipeline::AUTO_PROPAGATE()))
-    {
-      fprintf(stderr, "Push DOWN from %s\n", exec->GetAlgorithm()->GetClassName());
-    exec->Push(task.info);
-    }
-  if (messager)
-    {
-    messager->SendWakeMessage();
-    }
-  delete eData;
-  fprintf(stderr, "Release now\n");
-  lock->Unlock();
-  return NULL;
-}
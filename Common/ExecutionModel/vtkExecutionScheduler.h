@@ -27,14 +27,36 @@
   T. Silva, SCI Institute, University of Utah, Technical Report
   #UUSCI-2009-005, 2009.
 -------------------------------------------------------------------------*/
-// .NAME vtkExecutionScheduler - Scheduling execution with
-// thread/computing resources distributing
+// .NAME vtkExecutionScheduler - Execute a network of executives as a
+// graph of tasks
 // .SECTION Description
-// This is a class for balancing the computing resources throughout
-// the network
+// vtkExecutionScheduler executes a set of executives, and all the
+// executives upstream of them, as a graph of tasks: an executive is
+// executed once all the executives producing its inputs are done, and
+// executives that do not depend on each other, such as the two inputs of
+// an append filter or several consumers of one reader, execute
+// concurrently on the vtkSMPTools thread pool.  This lets the I/O of a
+// reader overlap with the computation of other filters.
+//
+// Each task sends REQUEST_DATA to its executive without forwarding it
+// upstream, since the producers are already up to date.  This requires
+// the executives with inputs to be vtkThreadedStreamingPipeline; when
+// this is not the case, or when an output marked for release is shared
+// by several consumers, the tasks are executed one after the other in
+// dependency order.  Tasks reading a composite dataset block by block
+// temporarily modify the pipeline information of their producer and are
+// never executed at the same time as each other.
+//
+// Among the tasks ready to execute, the ones whose algorithm information
+// holds the smallest TASK_PRIORITY go first.
+
+// .SECTION Caveats
+// Algorithms executing concurrently must not modify their inputs, as in
+// any use of vtkSMPTools.  vtkSMPTools::For() called by an algorithm
+// executing in a task runs serially in that task.
 
 // .SECTION See Also
-// vtkComputingResources vtkThreadedStreamingPipeline
+// vtkComputingResources vtkThreadedStreamingPipeline vtkSMPTools
 
 #ifndef __vtkExecutionScheduler_h
 #define __vtkExecutionScheduler_h
@@ -44,10 +66,8 @@
 #include "vtkExecutionSchedulerManager.h" // For singleton instantiation/cleanup
 
 class vtkExecutive;
+class vtkExecutionSchedulerGraph;
 class vtkComputingResources;
-class vtkMultiThreader;
-class vtkMutexLock;
-class vtkThreadMessager;
 class vtkInformation;
 class vtkInformationIntegerKey;
 class vtkExecutiveCollection;
@@ -63,68 +83,35 @@ public:
   // Return the global instance of the scheduler
   static vtkExecutionScheduler *GetGlobalScheduler();
 
- // Description:
-  // Key to store the priority of a task
-  static vtkInformationIntegerKey* TASK_PRIORITY();
-
-  // Description:
-  // Put the current set of executives (modules) to the be scheduled given its
-  // dependency graph which will be used to compute the set
-  // topological orders
-  void Schedule(vtkExecutiveCollection *execs, vtkInformation *info);
-
-  // Description:
-  // Put the current set of executives (modules) to the be scheduled
-  // given its dependency graph which will be used to compute the set
-  // topological orders. Then wait for their execution to be complete
-  void SchedulePropagate(vtkExecutiveCollection *execs, vtkInformation *info);
-
-  // Description:
-  // Wait until the current set of executives (modules) have finished executing
-  void WaitUntilDone(vtkExecutiveCollection *execs);
-
-  // Description:
-  // Wait until the current set of executives (modules) have their inputs released
-  void WaitUntilReleased(vtkExecutiveCollection *execs);
-
-  // Description:
-  // Wait for all tasks to be done
-  void WaitUntilAllDone();
-
   // Description:
-  // Wait for a task that is on the scheduling queue to be done. If
-  // the task is not there, this will return immediately. If the exec
-  // is NULL, any task that is done will trigger this the return
-  void WaitForTaskDone(vtkExecutive *exec);
-
-  // Description:
-  // Similar to WaitForTaskDone but return whenever input connections
-  // of a task are released instead of done computing. But exec cannot
-  // be NULL.
-  void WaitForInputsReleased(vtkExecutive *exec);
-
-  // Description:
-  // Return the thread messager reserved for the given exec to notify
-  // when it is done
-  vtkThreadMessager* GetTaskDoneMessager(vtkExecutive *exec);
+  // Key to store the priority of a task in the information of an
+  // algorithm.  Smaller values execute first.
+  static vtkInformationIntegerKey* TASK_PRIORITY();
 
   // Description:
-  // Return the thread messager reserved for the given exec to notify
-  // when it releases its inputs
-  vtkThreadMessager* GetInputsReleasedMessager(vtkExecutive *exec);
+  // Bring the outputs of the given executives, and of all the executives
+  // upstream of them, up to date and return when they are.  The update
+  // requests must already have been propagated, e.g. with
+  // vtkStreamingDemandDrivenPipeline::PropagateUpdateExtent().  Return 0
+  // if an executive failed; the executives downstream of it are then not
+  // executed.
+  int Schedule(vtkExecutiveCollection *execs);
 
   // Description:
-  // Return the mutex lock reserved for the given exec to notify
-  // when it releases its inputs
-  vtkMutexLock* GetInputsReleasedLock(vtkExecutive *exec);
+  // Same as Schedule() for the executives upstream of exec, but not for
+  // exec itself.  Only the output ports connected to exec, directly or
+  // not, are updated.
+  int ScheduleUpstream(vtkExecutive *exec);
 
   // Description:
-  // Release the resources that are being used by the given exec
-  void ReleaseResources(vtkExecutive *exec);
+  // Update the given executives and all the executives downstream of
+  // them, one after the other.
+  void SchedulePropagate(vtkExecutiveCollection *execs, vtkInformation *info);
 
   // Description:
-  // Re-acquire the resource released earlier by ReleaseResource
-  void ReacquireResources(vtkExecutive *exec);
+  // Largest number of tasks that executed at the same time during the
+  // last call to Schedule().
+  vtkGetMacro(MaximumNumberOfConcurrentTasks, int);
 
   // Description:
   // Redistribute the thread resources over the network from a sink
@@ -140,29 +127,11 @@ protected:
   vtkExecutionScheduler();
   ~vtkExecutionScheduler();
 
-  vtkComputingResources       *Resources;
-  vtkThreadMessager           *ScheduleMessager;
-  vtkThreadMessager           *ResourceMessager;
-  vtkMutexLock                *ScheduleLock;
-  vtkMultiThreader            *ScheduleThreader;
-  int                          ScheduleThreadId;
+  // Execute the tasks of the graph.
+  int Execute(vtkExecutionSchedulerGraph *graph);
 
-//BTX
-  class implementation;
-  implementation* const Implementation;
-  friend class implementation;
-
-  // Description:
-  // The scheduling thread that is responsible for queueing up module
-  // execution in the right order
-  friend void * vtkExecutionScheduler_ScheduleThread(void *data);
-
-  // Description:
-  // Execute thread function that is responsible for forking process
-  // for each module
-  friend void * vtkExecutionScheduler_ExecuteThread(void *data);
-
-//ETX
+  vtkComputingResources       *Resources;
+  int                          MaximumNumberOfConcurrentTasks;
 
   // Description: Functions and friend class to take care of initialization
   // and clean up of the vtkExecutionScheduler singleton.
@@ -25,6 +25,7 @@
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 
 #include <vector>
@@ -33,14 +34,14 @@
 
 #include "vtkCompositeDataPipeline.h"
 
-vtkInformationKeyMacro(vtkExecutive, ALGORITHM_AFTER_FORWARD, Integer);
-vtkInformationKeyMacro(vtkExecutive, ALGORITHM_BEFORE_FORWARD, Integer);
-vtkInformationKeyMacro(vtkExecutive, ALGORITHM_DIRECTION, Integer);
-vtkInformationKeyMacro(vtkExecutive, CONSUMERS, ExecutivePortVector);
-vtkInformationKeyMacro(vtkExecutive, FORWARD_DIRECTION, Integer);
-vtkInformationKeyMacro(vtkExecutive, FROM_OUTPUT_PORT, Integer);
+vtkInformationKeySlotMacro(vtkExecutive, ALGORITHM_AFTER_FORWARD, Integer);
+vtkInformationKeySlotMacro(vtkExecutive, ALGORITHM_BEFORE_FORWARD, Integer);
+vtkInformationKeySlotMacro(vtkExecutive, ALGORITHM_DIRECTION, Integer);
+vtkInformationKeySlotMacro(vtkExecutive, CONSUMERS, ExecutivePortVector);
+vtkInformationKeySlotMacro(vtkExecutive, FORWARD_DIRECTION, Integer);
+vtkInformationKeySlotMacro(vtkExecutive, FROM_OUTPUT_PORT, Integer);
 vtkInformationKeyMacro(vtkExecutive, KEYS_TO_COPY, KeyVector);
-vtkInformationKeyMacro(vtkExecutive, PRODUCER, ExecutivePort);
+vtkInformationKeySlotMacro(vtkExecutive, PRODUCER, ExecutivePort);
 
 //----------------------------------------------------------------------------
 class vtkExecutiveInternals
@@ -740,9 +741,17 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
+  vtkPipelineProfiler* profiler = vtkPipelineProfiler::GetStartedProfiler();
+  vtkIdType record = profiler ?
+    profiler->BeginRequest(this->Algorithm, request, inInfo) : -1;
+  int inAlgorithm = this->InAlgorithm;
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
-  this->InAlgorithm = 0;
+  this->InAlgorithm = inAlgorithm;
+  if(profiler)
+    {
+    profiler->EndRequest(record, outInfo, result);
+    }
 
   // If the algorithm failed report it now.
   if(!result)
@@ -0,0 +1,590 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCallbackCommand.h"
+#include "vtkDataObject.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkObjectFactory.h"
+#include "vtkTimeStamp.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/ios/fstream>
+#include <vtksys/ios/sstream>
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkPipelineProfiler);
+
+vtkPipelineProfiler* vtkPipelineProfiler::StartedProfiler = 0;
+
+//----------------------------------------------------------------------------
+// One request sent to an algorithm.
+struct vtkPipelineProfilerRecord
+{
+  // Index of the statistics of the algorithm.
+  size_t Algorithm;
+  std::string Pass;
+  std::string Reason;
+  int Thread;
+  double WallStart;
+  double WallEnd;
+  double CPUStart;
+  double CPUEnd;
+  unsigned long OutputSize;
+  int Result;
+  bool Done;
+};
+
+// Statistics of an algorithm.
+struct vtkPipelineProfilerAlgorithm
+{
+  vtkPipelineProfilerAlgorithm()
+    : Algorithm(0), Address(0), DeleteObserver(0), Requests(0),
+      Executions(0), WallTime(0.0), CPUTime(0.0), OutputSize(0),
+      LastExecution(0)
+  {
+  }
+
+  // NULL once the algorithm is deleted.
+  vtkAlgorithm* Algorithm;
+  const void* Address;
+  unsigned long DeleteObserver;
+  std::string ClassName;
+  vtkIdType Requests;
+  vtkIdType Executions;
+  double WallTime;
+  double CPUTime;
+  unsigned long OutputSize;
+  std::string Reason;
+  // Modification time when the last execution ended.
+  unsigned long LastExecution;
+};
+
+class vtkPipelineProfilerInternals
+{
+public:
+  typedef std::map<vtkAlgorithm*, size_t> AlgorithmMap;
+
+  vtkSimpleMutexLock Lock;
+  std::vector<vtkPipelineProfilerRecord> Records;
+  // Id of the first record.  The ids keep increasing when the records are
+  // cleared, so that EndRequest() ignores the requests begun before.
+  vtkIdType FirstRecord;
+  // Statistics of the algorithms, and the index of those of the algorithms
+  // that still exist.  An algorithm is forgotten by the map when it is
+  // deleted, so that another one created at its address gets its own.
+  std::vector<vtkPipelineProfilerAlgorithm> Algorithms;
+  AlgorithmMap Live;
+  vtkCallbackCommand* DeleteCallback;
+  std::vector<vtkMultiThreaderIDType> Threads;
+  double Origin;
+
+  // Small index of the calling thread.  Called with the lock held.
+  int GetThreadIndex()
+    {
+    vtkMultiThreaderIDType id = vtkMultiThreader::GetCurrentThreadID();
+    for (size_t i = 0; i < this->Threads.size(); ++i)
+      {
+      if (vtkMultiThreader::ThreadsEqual(this->Threads[i], id))
+        {
+        return static_cast<int>(i);
+        }
+      }
+    this->Threads.push_back(id);
+    return static_cast<int>(this->Threads.size()) - 1;
+    }
+
+  // Statistics of an algorithm or NULL.  Called with the lock held.
+  vtkPipelineProfilerAlgorithm* Find(vtkAlgorithm* algorithm)
+    {
+    AlgorithmMap::iterator it = this->Live.find(algorithm);
+    return it == this->Live.end() ? 0 : &this->Algorithms[it->second];
+    }
+
+  // Index of the statistics of an algorithm, added if needed.  Called with
+  // the lock held.
+  size_t Get(vtkAlgorithm* algorithm)
+    {
+    AlgorithmMap::iterator it = this->Live.find(algorithm);
+    if (it != this->Live.end())
+      {
+      return it->second;
+      }
+    size_t index = this->Algorithms.size();
+    this->Algorithms.push_back(vtkPipelineProfilerAlgorithm());
+    vtkPipelineProfilerAlgorithm& stats = this->Algorithms.back();
+    stats.Algorithm = algorithm;
+    stats.Address = algorithm;
+    stats.ClassName = algorithm->GetClassName();
+    stats.DeleteObserver =
+      algorithm->AddObserver(vtkCommand::DeleteEvent, this->DeleteCallback);
+    this->Live[algorithm] = index;
+    return index;
+    }
+
+  // Stop observing the algorithms.  Called with the lock held.
+  void Forget()
+    {
+    for (AlgorithmMap::iterator it = this->Live.begin();
+         it != this->Live.end(); ++it)
+      {
+      it->first->RemoveObserver(this->Algorithms[it->second].DeleteObserver);
+      }
+    this->Live.clear();
+    }
+
+  static void AlgorithmDeleted(vtkObject* caller, unsigned long,
+                               void* clientData, void*)
+    {
+    vtkPipelineProfilerInternals* self =
+      static_cast<vtkPipelineProfilerInternals*>(clientData);
+    self->Lock.Lock();
+    AlgorithmMap::iterator it =
+      self->Live.find(static_cast<vtkAlgorithm*>(caller));
+    if (it != self->Live.end())
+      {
+      self->Algorithms[it->second].Algorithm = 0;
+      self->Live.erase(it);
+      }
+    self->Lock.Unlock();
+    }
+};
+
+//----------------------------------------------------------------------------
+// Why an algorithm that last executed at the given time executes again.
+static std::string vtkPipelineProfilerGetReason(
+  vtkAlgorithm* algorithm, vtkInformationVector** inInfo,
+  unsigned long lastExecution)
+{
+  if (algorithm->GetMTime() > lastExecution)
+    {
+    return "algorithm modified";
+    }
+  for (int i = 0; i < algorithm->GetNumberOfInputPorts(); ++i)
+    {
+    for (int j = 0; j < inInfo[i]->GetNumberOfInformationObjects(); ++j)
+      {
+      vtkInformation* info = inInfo[i]->GetInformationObject(j);
+      vtkDataObject* data = info->Get(vtkDataObject::DATA_OBJECT());
+      if (data && (data->GetMTime() > lastExecution ||
+                   data->GetUpdateTime() > lastExecution))
+        {
+        vtksys_ios::ostringstream os;
+        os << "input " << i << ":" << j << " modified";
+        vtkExecutive* producer;
+        int port;
+        vtkExecutive::PRODUCER()->Get(info, producer, port);
+        if (producer && producer->GetAlgorithm())
+          {
+          os << " by " << producer->GetAlgorithm()->GetClassName();
+          }
+        return os.str();
+        }
+      }
+    }
+  return "update request changed";
+}
+
+//----------------------------------------------------------------------------
+// Write a string as a JSON string.
+static void vtkPipelineProfilerWriteString(ostream& os, const std::string& s)
+{
+  os << '"';
+  for (size_t i = 0; i < s.size(); ++i)
+    {
+    char c = s[i];
+    if (c == '"' || c == '\\')
+      {
+      os << '\\' << c;
+      }
+    else if (static_cast<unsigned char>(c) < 0x20)
+      {
+      os << ' ';
+      }
+    else
+      {
+      os << c;
+      }
+    }
+  os << '"';
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler()
+{
+  this->Internals = new vtkPipelineProfilerInternals;
+  this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+  this->Internals->FirstRecord = 0;
+  this->Internals->DeleteCallback = vtkCallbackCommand::New();
+  this->Internals->DeleteCallback->SetCallback(
+    &vtkPipelineProfilerInternals::AlgorithmDeleted);
+  this->Internals->DeleteCallback->SetClientData(this->Internals);
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler()
+{
+  this->Stop();
+  this->Internals->Lock.Lock();
+  this->Internals->Forget();
+  this->Internals->Lock.Unlock();
+  this->Internals->DeleteCallback->Delete();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::Start()
+{
+  vtkPipelineProfiler::StartedProfiler = this;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::Stop()
+{
+  if (vtkPipelineProfiler::StartedProfiler == this)
+    {
+    vtkPipelineProfiler::StartedProfiler = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::IsStarted()
+{
+  return vtkPipelineProfiler::StartedProfiler == this;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::Clear()
+{
+  this->Internals->Lock.Lock();
+  this->Internals->FirstRecord +=
+    static_cast<vtkIdType>(this->Internals->Records.size());
+  this->Internals->Records.clear();
+  this->Internals->Forget();
+  this->Internals->Algorithms.clear();
+  this->Internals->Threads.clear();
+  this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::GetNumberOfRecords()
+{
+  this->Internals->Lock.Lock();
+  vtkIdType n = static_cast<vtkIdType>(this->Internals->Records.size());
+  this->Internals->Lock.Unlock();
+  return n;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::BeginRequest(vtkAlgorithm* algorithm,
+                                            vtkInformation* request,
+                                            vtkInformationVector** inInfo)
+{
+  vtkPipelineProfilerRecord record;
+  vtkInformationRequestKey* pass = request->GetRequest();
+  record.Pass = pass ? pass->GetName() : "UNKNOWN_REQUEST";
+  record.WallEnd = 0.0;
+  record.CPUEnd = 0.0;
+  record.OutputSize = 0;
+  record.Result = 0;
+  record.Done = false;
+
+  bool execution =
+    request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()) != 0;
+  unsigned long lastExecution = 0;
+  if (execution)
+    {
+    this->Internals->Lock.Lock();
+    vtkPipelineProfilerAlgorithm* stats = this->Internals->Find(algorithm);
+    lastExecution = stats && stats->Executions > 0 ? stats->LastExecution : 0;
+    this->Internals->Lock.Unlock();
+    record.Reason = lastExecution == 0 ? "first execution" :
+      vtkPipelineProfilerGetReason(algorithm, inInfo, lastExecution);
+    }
+
+  this->Internals->Lock.Lock();
+  record.Algorithm = this->Internals->Get(algorithm);
+  vtkPipelineProfilerAlgorithm& stats =
+    this->Internals->Algorithms[record.Algorithm];
+  stats.Requests++;
+  if (execution)
+    {
+    stats.Executions++;
+    stats.Reason = record.Reason;
+    }
+  record.Thread = this->Internals->GetThreadIndex();
+  vtkIdType id = this->Internals->FirstRecord +
+    static_cast<vtkIdType>(this->Internals->Records.size());
+  this->Internals->Records.push_back(record);
+  this->Internals->Lock.Unlock();
+
+  // Start the clocks last so that the profiler is not measured.
+  double wall = vtkTimerLog::GetUniversalTime();
+  double cpu = vtkTimerLog::GetCPUTime();
+  this->Internals->Lock.Lock();
+  vtkIdType index = id - this->Internals->FirstRecord;
+  if (index >= 0)
+    {
+    this->Internals->Records[index].WallStart = wall;
+    this->Internals->Records[index].CPUStart = cpu;
+    }
+  this->Internals->Lock.Unlock();
+  return id;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::EndRequest(vtkIdType id,
+                                     vtkInformationVector* outInfo,
+                                     int result)
+{
+  double wall = vtkTimerLog::GetUniversalTime();
+  double cpu = vtkTimerLog::GetCPUTime();
+
+  this->Internals->Lock.Lock();
+  vtkIdType index = id - this->Internals->FirstRecord;
+  if (index < 0 ||
+      index >= static_cast<vtkIdType>(this->Internals->Records.size()))
+    {
+    // The records were cleared since the request began.
+    this->Internals->Lock.Unlock();
+    return;
+    }
+  vtkPipelineProfilerRecord& record = this->Internals->Records[index];
+  record.WallEnd = wall;
+  record.CPUEnd = cpu;
+  record.Result = result;
+  record.Done = true;
+  vtkPipelineProfilerAlgorithm& stats =
+    this->Internals->Algorithms[record.Algorithm];
+  stats.WallTime += wall - record.WallStart;
+  stats.CPUTime += cpu - record.CPUStart;
+
+  if (!record.Reason.empty())
+    {
+    unsigned long size = 0;
+    for (int i = 0; i < outInfo->GetNumberOfInformationObjects(); ++i)
+      {
+      vtkDataObject* data =
+        outInfo->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+      if (data)
+        {
+        size += data->GetActualMemorySize();
+        }
+      }
+    record.OutputSize = size;
+    stats.OutputSize = size;
+    vtkTimeStamp now;
+    now.Modified();
+    stats.LastExecution = now.GetMTime();
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::GetNumberOfRequests(vtkAlgorithm* algorithm)
+{
+  this->Internals->Lock.Lock();
+  vtkPipelineProfilerAlgorithm* stats = this->Internals->Find(algorithm);
+  vtkIdType n = stats ? stats->Requests : 0;
+  this->Internals->Lock.Unlock();
+  return n;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::GetNumberOfExecutions(vtkAlgorithm* algorithm)
+{
+  this->Internals->Lock.Lock();
+  vtkPipelineProfilerAlgorithm* stats = this->Internals->Find(algorithm);
+  vtkIdType n = stats ? stats->Executions : 0;
+  this->Internals->Lock.Unlock();
+  return n;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::GetNumberOfReExecutions(vtkAlgorithm* algorithm)
+{
+  vtkIdType n = this->GetNumberOfExecutions(algorithm);
+  return n > 1 ? n - 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+double vtkPipelineProfiler::GetWallTime(vtkAlgorithm* algorithm)
+{
+  this->Internals->Lock.Lock();
+  vtkPipelineProfilerAlgorithm* stats = this->Internals->Find(algorithm);
+  double t = stats ? stats->WallTime : 0.0;
+  this->Internals->Lock.Unlock();
+  return t;
+}
+
+//----------------------------------------------------------------------------
+double vtkPipelineProfiler::GetCPUTime(vtkAlgorithm* algorithm)
+{
+  this->Internals->Lock.Lock();
+  vtkPipelineProfilerAlgorithm* stats = this->Internals->Find(algorithm);
+  double t = stats ? stats->CPUTime : 0.0;
+  this->Internals->Lock.Unlock();
+  return t;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPipelineProfiler::GetOutputMemorySize(vtkAlgorithm* algorithm)
+{
+  this->Internals->Lock.Lock();
+  vtkPipelineProfilerAlgorithm* stats = this->Internals->Find(algorithm);
+  unsigned long size = stats ? stats->OutputSize : 0;
+  this->Internals->Lock.Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+vtkStdString vtkPipelineProfiler::GetLastExecutionReason(
+  vtkAlgorithm* algorithm)
+{
+  this->Internals->Lock.Lock();
+  vtkPipelineProfilerAlgorithm* stats = this->Internals->Find(algorithm);
+  vtkStdString reason;
+  if (stats && stats->Executions > 0)
+    {
+    reason = stats->Reason;
+    }
+  this->Internals->Lock.Unlock();
+  return reason;
+}
+
+//----------------------------------------------------------------------------
+static bool vtkPipelineProfilerSlower(
+  const vtkPipelineProfilerAlgorithm& a,
+  const vtkPipelineProfilerAlgorithm& b)
+{
+  return a.WallTime > b.WallTime;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSummary(ostream& os)
+{
+  this->Internals->Lock.Lock();
+  std::vector<vtkPipelineProfilerAlgorithm> algorithms =
+    this->Internals->Algorithms;
+  this->Internals->Lock.Unlock();
+  std::sort(algorithms.begin(), algorithms.end(), vtkPipelineProfilerSlower);
+
+  os << std::left << std::setw(40) << "Algorithm" << std::right
+     << std::setw(10) << "Requests" << std::setw(12) << "Executions"
+     << std::setw(12) << "Wall (s)" << std::setw(18) << "Process CPU (s)"
+     << std::setw(14) << "Output (KiB)" << "  Last reason\n";
+  for (size_t i = 0; i < algorithms.size(); ++i)
+    {
+    const vtkPipelineProfilerAlgorithm& stats = algorithms[i];
+    vtksys_ios::ostringstream name;
+    name << stats.ClassName << "(" << stats.Address
+         << (stats.Algorithm ? ")" : ", deleted)");
+    os << std::left << std::setw(40) << name.str() << std::right
+       << std::setw(10) << stats.Requests
+       << std::setw(12) << stats.Executions
+       << std::setw(12) << stats.WallTime
+       << std::setw(18) << stats.CPUTime
+       << std::setw(14) << stats.OutputSize
+       << "  " << stats.Reason << "\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::WriteChromeTrace(const char* fileName)
+{
+  if (!fileName)
+    {
+    vtkErrorMacro("No file name specified.");
+    return 0;
+    }
+  ofstream os(fileName);
+  if (!os)
+    {
+    vtkErrorMacro("Cannot open file " << fileName << ".");
+    return 0;
+    }
+  this->WriteChromeTrace(os);
+  os.close();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::WriteChromeTrace(ostream& os)
+{
+  std::streamsize precision = os.precision();
+  this->Internals->Lock.Lock();
+  os << "{\"traceEvents\":[";
+  const char* separator = "\n";
+  for (size_t i = 0; i < this->Internals->Records.size(); ++i)
+    {
+    const vtkPipelineProfilerRecord& record = this->Internals->Records[i];
+    if (!record.Done)
+      {
+      continue;
+      }
+    const vtkPipelineProfilerAlgorithm& stats =
+      this->Internals->Algorithms[record.Algorithm];
+    vtksys_ios::ostringstream address;
+    address << stats.Address;
+
+    // Times are in microseconds.
+    os << separator << "{\"name\":";
+    vtkPipelineProfilerWriteString(os, stats.ClassName);
+    os << ",\"cat\":";
+    vtkPipelineProfilerWriteString(os, record.Pass);
+    os << std::fixed << std::setprecision(3)
+       << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << record.Thread
+       << ",\"ts\":" << (record.WallStart - this->Internals->Origin) * 1e6
+       << ",\"dur\":" << (record.WallEnd - record.WallStart) * 1e6
+       << ",\"args\":{\"algorithm\":";
+    vtkPipelineProfilerWriteString(os, address.str());
+    os << ",\"process_cpu_us\":" << (record.CPUEnd - record.CPUStart) * 1e6
+       << ",\"result\":" << record.Result;
+    if (!record.Reason.empty())
+      {
+      os << ",\"output_kib\":" << record.OutputSize << ",\"reason\":";
+      vtkPipelineProfilerWriteString(os, record.Reason);
+      }
+    os << "}}";
+    separator = ",\n";
+    }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  this->Internals->Lock.Unlock();
+  os.unsetf(ios::floatfield);
+  os.precision(precision);
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Started: " << this->IsStarted() << "\n";
+  os << indent << "NumberOfRecords: " << this->GetNumberOfRecords() << "\n";
+}
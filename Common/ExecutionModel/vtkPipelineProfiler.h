@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPipelineProfiler - Record the requests that executives send to
+// their algorithms
+// .SECTION Description
+// While a vtkPipelineProfiler is started, every request that an
+// executive sends to its algorithm, i.e. every pass of every algorithm
+// of every pipeline, is recorded with its wall clock time and CPU time.
+// For REQUEST_DATA, the profiler also records the size of the outputs,
+// as reported by vtkDataObject::GetActualMemorySize(), and the reason
+// why the algorithm executed: its first execution since the profiler
+// started, a modification of the algorithm, a modification of one of
+// its inputs, or a change of the update request only (extent, piece,
+// time step...).  This tells which algorithms execute more often than
+// they should and why.
+//
+// The records can be summarized per algorithm with PrintSummary(), or
+// written in the Trace Event Format of Chrome (chrome://tracing) with
+// WriteChromeTrace(), one row per thread.
+//
+// .SECTION Caveats
+// Only one profiler is started at a time.  The time of a pass does not
+// include the passes of the algorithms upstream, which are executed
+// before.  The CPU time is that of the process, so it also counts the
+// other threads when algorithms execute concurrently.  The statistics of
+// an algorithm deleted while profiling are kept, but can no longer be
+// queried with the Get methods below.
+//
+// .SECTION See Also
+// vtkExecutive vtkTimerLog vtkExecutionTimer
+
+#ifndef __vtkPipelineProfiler_h
+#define __vtkPipelineProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+#include "vtkStdString.h" // For GetLastExecutionReason()
+
+class vtkAlgorithm;
+class vtkInformation;
+class vtkInformationVector;
+class vtkPipelineProfilerInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineProfiler : public vtkObject
+{
+public:
+  static vtkPipelineProfiler* New();
+  vtkTypeMacro(vtkPipelineProfiler, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Start recording, replacing the profiler that was started if any, or
+  // stop recording.  Stopping keeps the records.
+  void Start();
+  void Stop();
+  int IsStarted();
+
+  // Description:
+  // The started profiler, or NULL.
+  static vtkPipelineProfiler* GetStartedProfiler()
+    { return vtkPipelineProfiler::StartedProfiler; }
+
+  // Description:
+  // Discard the records.  The requests that began before are not
+  // recorded when they end.
+  void Clear();
+
+  // Description:
+  // Number of recorded requests, for all algorithms.
+  vtkIdType GetNumberOfRecords();
+
+  // Description:
+  // Statistics of an algorithm: the number of requests it received, the
+  // number of times it executed (REQUEST_DATA), the number of those that
+  // were not its first execution, and the wall clock time and the CPU
+  // time of the whole process, in seconds, spent in all its requests.
+  vtkIdType GetNumberOfRequests(vtkAlgorithm* algorithm);
+  vtkIdType GetNumberOfExecutions(vtkAlgorithm* algorithm);
+  vtkIdType GetNumberOfReExecutions(vtkAlgorithm* algorithm);
+  double GetWallTime(vtkAlgorithm* algorithm);
+  double GetCPUTime(vtkAlgorithm* algorithm);
+
+  // Description:
+  // Size of the outputs of the last execution of an algorithm, in
+  // kibibytes, and the reason of that execution.  The reason is a copy,
+  // empty if the algorithm did not execute, since the algorithms may
+  // record new executions from other threads meanwhile.
+  unsigned long GetOutputMemorySize(vtkAlgorithm* algorithm);
+  vtkStdString GetLastExecutionReason(vtkAlgorithm* algorithm);
+
+  // Description:
+  // Print a table of the statistics of each algorithm, the slowest
+  // first.
+  void PrintSummary(ostream& os);
+
+  // Description:
+  // Write the records in the Trace Event Format of Chrome.  Return 0 if
+  // the file cannot be written.
+  int WriteChromeTrace(const char* fileName);
+  void WriteChromeTrace(ostream& os);
+
+  // Description:
+  // Called by vtkExecutive::CallAlgorithm() around each request sent to
+  // an algorithm.  BeginRequest() returns the record to pass to
+  // EndRequest().
+  vtkIdType BeginRequest(vtkAlgorithm* algorithm, vtkInformation* request,
+                         vtkInformationVector** inInfo);
+  void EndRequest(vtkIdType record, vtkInformationVector* outInfo,
+                  int result);
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler();
+
+  static vtkPipelineProfiler* StartedProfiler;
+
+private:
+  vtkPipelineProfilerInternals* Internals;
+
+  vtkPipelineProfiler(const vtkPipelineProfiler&);  // Not implemented.
+  void operator=(const vtkPipelineProfiler&);  // Not implemented.
+};
+
+#endif
@@ -14,23 +14,108 @@
 =========================================================================*/
 #include "vtkScalarTree.h"
 
+#include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkGarbageCollector.h"
+#include "vtkIdList.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <vector>
 
 vtkCxxSetObjectMacro(vtkScalarTree,DataSet,vtkDataSet);
+vtkCxxSetObjectMacro(vtkScalarTree,Scalars,vtkDataArray);
 
 // Instantiate scalar tree with maximum level of 20 and branching
 // factor of 5.
 vtkScalarTree::vtkScalarTree()
 {
   this->DataSet = NULL;
+  this->Scalars = NULL;
   this->ScalarValue = 0.0;
 }
 
 vtkScalarTree::~vtkScalarTree()
 {
   this->SetDataSet(NULL);
+  this->SetScalars(NULL);
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray *vtkScalarTree::GetTreeScalars()
+{
+  if ( this->Scalars )
+    {
+    return this->Scalars;
+    }
+  return this->DataSet ? this->DataSet->GetPointData()->GetScalars() : NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkScalarTree::FindCells(int numValues, const double *values,
+                              vtkIdList *cellIds)
+{
+  cellIds->Reset();
+  if ( !this->DataSet || numValues < 1 )
+    {
+    return;
+    }
+
+  std::vector<vtkIdType> cells;
+  vtkDoubleArray *cellScalars = vtkDoubleArray::New();
+  vtkIdList *cellPts;
+  vtkIdType cellId;
+  for (int i=0; i < numValues; i++)
+    {
+    for ( this->InitTraversal(values[i]);
+          this->GetNextCell(cellId,cellPts,cellScalars) != NULL; )
+      {
+      cells.push_back(cellId);
+      }
+    }
+  cellScalars->Delete();
+
+  std::sort(cells.begin(), cells.end());
+  cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+  cellIds->SetNumberOfIds(static_cast<vtkIdType>(cells.size()));
+  if ( !cells.empty() )
+    {
+    std::copy(cells.begin(), cells.end(), cellIds->GetPointer(0));
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkScalarTree::FindCellsInRange(double minValue, double maxValue,
+                                     vtkIdList *cellIds)
+{
+  cellIds->Reset();
+  vtkDataArray *scalars = this->GetTreeScalars();
+  if ( !this->DataSet || !scalars )
+    {
+    return;
+    }
+
+  vtkIdList *cellPts = vtkIdList::New();
+  vtkIdType numCells = this->DataSet->GetNumberOfCells();
+  for (vtkIdType cellId=0; cellId < numCells; cellId++)
+    {
+    this->DataSet->GetCellPoints(cellId, cellPts);
+    vtkIdType numPts = cellPts->GetNumberOfIds();
+    double min = VTK_DOUBLE_MAX, max = -VTK_DOUBLE_MAX;
+    for (vtkIdType i=0; i < numPts; i++)
+      {
+      double s = scalars->GetComponent(cellPts->GetId(i), 0);
+      min = (s < min ? s : min);
+      max = (s > max ? s : max);
+      }
+    if ( min <= maxValue && max >= minValue )
+      {
+      cellIds->InsertNextId(cellId);
+      }
+    }
+  cellPts->Delete();
 }
 
 void vtkScalarTree::PrintSelf(ostream& os, vtkIndent indent)
@@ -46,6 +131,15 @@ void vtkScalarTree::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "DataSet: (none)\n";
     }
 
+  if ( this->Scalars )
+    {
+    os << indent << "Scalars: " << this->Scalars << "\n";
+    }
+  else
+    {
+    os << indent << "Scalars: (none)\n";
+    }
+
   os << indent << "Build Time: " << this->BuildTime.GetMTime() << "\n";
 }
 
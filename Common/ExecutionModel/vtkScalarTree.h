@@ -24,10 +24,16 @@
 // To use subclasses of this class, you must specify a dataset to operate on,
 // and then specify a scalar value in the InitTraversal() method. Then
 // calls to GetNextCell() return cells whose scalar data contains the
-// scalar value specified.
+// scalar value specified. Alternatively, FindCells() returns at once the
+// cells that may contain any of several scalar values, and
+// FindCellsInRange() the cells whose scalars may intersect a range.
+//
+// The tree is built from the active point scalars of the dataset, unless
+// other point scalars are specified with SetScalars() (e.g. the values of
+// an implicit function at the points).
 
 // .SECTION See Also
-// vtkSimpleScalarTree
+// vtkSimpleScalarTree vtkSpanSpace
 
 #ifndef __vtkScalarTree_h
 #define __vtkScalarTree_h
@@ -52,6 +58,13 @@ public:
   virtual void SetDataSet(vtkDataSet*);
   vtkGetObjectMacro(DataSet,vtkDataSet);
 
+  // Description:
+  // Specify the point scalars to build the tree with. If not set, the
+  // active point scalars of the dataset are used. Only the first component
+  // is considered.
+  virtual void SetScalars(vtkDataArray*);
+  vtkGetObjectMacro(Scalars,vtkDataArray);
+
   // Description:
   // Construct the scalar tree from the dataset provided. Checks build times
   // and modified time from input and reconstructs the tree if necessary.
@@ -74,18 +87,40 @@ public:
   virtual vtkCell *GetNextCell(vtkIdType &cellId, vtkIdList* &ptIds,
                                vtkDataArray *cellScalars) = 0;
 
+  // Description:
+  // Return in cellIds, in increasing order, the ids of the cells whose
+  // scalar range may contain any of the values given. Cells that are not
+  // returned contain none of them. This answers a whole series of contour
+  // values with a single traversal of the cells. The default
+  // implementation merges the traversals of the values.
+  virtual void FindCells(int numValues, const double *values,
+                         vtkIdList *cellIds);
+
+  // Description:
+  // Return in cellIds, in increasing order, the ids of the cells whose
+  // scalar range may intersect the range [minValue,maxValue]. Cells that
+  // are not returned have no scalar in the range. The default
+  // implementation checks the range of every cell.
+  virtual void FindCellsInRange(double minValue, double maxValue,
+                                vtkIdList *cellIds);
+
 protected:
   vtkScalarTree();
   ~vtkScalarTree();
 
   vtkDataSet   *DataSet;    //the dataset over which the scalar tree is built
-  vtkDataArray *Scalars;    //the scalars of the DataSet
+  vtkDataArray *Scalars;    //the scalars to build the tree with, if set
 
   vtkTimeStamp BuildTime; //time at which tree was built
   double       ScalarValue; //current scalar value for traversal
 
   virtual void ReportReferences(vtkGarbageCollector*);
 
+  // Description:
+  // The point scalars the tree is built with: the Scalars if set,
+  // otherwise the active point scalars of the DataSet.
+  vtkDataArray *GetTreeScalars();
+
 private:
   vtkScalarTree(const vtkScalarTree&);  // Not implemented.
   void operator=(const vtkScalarTree&);  // Not implemented.
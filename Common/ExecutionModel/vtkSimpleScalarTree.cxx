@@ -37,7 +37,7 @@ public:
 // factor of 5.
 vtkSimpleScalarTree::vtkSimpleScalarTree()
 {
-  this->DataSet = NULL;
+  this->TreeScalars = NULL;
   this->Level = 0;
   this->MaxLevel = 20;
   this->BranchingFactor = 3;
@@ -84,21 +84,24 @@ void vtkSimpleScalarTree::BuildTree()
     return;
     }
 
-  if ( this->Tree != NULL && this->BuildTime > this->MTime
-    && this->BuildTime > this->DataSet->GetMTime() )
+  vtkDataArray *scalars = this->GetTreeScalars();
+  if ( ! scalars )
     {
+    vtkErrorMacro( << "No scalar data to build trees with");
     return;
     }
 
-  vtkDebugMacro( << "Building scalar tree..." );
-
-  this->Scalars = this->DataSet->GetPointData()->GetScalars();
-  if ( ! this->Scalars )
+  if ( this->Tree != NULL && this->BuildTime > this->MTime
+    && this->BuildTime > this->DataSet->GetMTime()
+    && this->BuildTime > scalars->GetMTime() && this->TreeScalars == scalars )
     {
-    vtkErrorMacro( << "No scalar data to build trees with");
     return;
     }
 
+  vtkDebugMacro( << "Building scalar tree..." );
+
+  this->TreeScalars = scalars;
+
   this->Initialize();
   cellScalars = vtkDoubleArray::New();
   cellScalars->Allocate(100);
@@ -135,7 +138,7 @@ void vtkSimpleScalarTree::BuildTree()
       cellPts = cell->GetPointIds();
       numScalars = cellPts->GetNumberOfIds();
       cellScalars->SetNumberOfTuples(numScalars);
-      this->Scalars->GetTuples(cellPts, cellScalars);
+      this->TreeScalars->GetTuples(cellPts, cellScalars);
       s = cellScalars->GetPointer(0);
 
       for ( j=0; j < numScalars; j++ )
@@ -313,7 +316,7 @@ vtkCell *vtkSimpleScalarTree::GetNextCell(vtkIdType& cellId,
       cellPts = cell->GetPointIds();
       numScalars = cellPts->GetNumberOfIds();
       cellScalars->SetNumberOfTuples(numScalars);
-      this->Scalars->GetTuples(cellPts, cellScalars);
+      this->TreeScalars->GetTuples(cellPts, cellScalars);
       for (i=0; i < numScalars; i++)
         {
         s = cellScalars->GetTuple1(i);
@@ -96,7 +96,7 @@ protected:
   vtkSimpleScalarTree();
   ~vtkSimpleScalarTree();
 
-  vtkDataArray *Scalars;
+  vtkDataArray *TreeScalars; //the scalars the tree was built with
   int MaxLevel;
   int Level;
   int BranchingFactor; //number of children per node
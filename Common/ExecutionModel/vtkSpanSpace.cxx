@@ -0,0 +1,580 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpanSpace.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSpanSpace.h"
+
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <vector>
+
+vtkStandardNewMacro(vtkSpanSpace);
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Bucket row or column of a scalar value, given the minimum of the scalar
+// range and the number of buckets per unit of scalar.
+inline int vtkSpanSpaceGetIndex(double s, double min, double scale,
+                                int resolution)
+{
+  double x = (s - min) * scale;
+  if ( !(x > 0.0) )
+    {
+    return 0;
+    }
+  return x < resolution ? static_cast<int>(x) : resolution - 1;
+}
+
+//----------------------------------------------------------------------------
+// Point ids of the cells of the dataset. GetCell() is safe to call from
+// several threads if Initialize() returned true.
+class vtkSpanSpaceCells
+{
+public:
+  vtkDataSet *DataSet;
+  vtkPolyData *PolyData;
+  vtkCellArray *Cells;
+  const vtkIdType *Legacy;
+  const vtkIdType *Locations;
+
+  bool Initialize(vtkDataSet *ds)
+  {
+    this->DataSet = ds;
+    this->PolyData = vtkPolyData::SafeDownCast(ds);
+    this->Cells = NULL;
+    this->Legacy = NULL;
+    this->Locations = NULL;
+    vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(ds);
+    if ( grid && grid->GetCells() )
+      {
+      this->Cells = grid->GetCells();
+      if ( !this->Cells->IsOffsetsLayout() )
+        {
+        this->Legacy = this->Cells->GetPointer();
+        this->Locations = grid->GetCellLocationsArray()->GetPointer(0);
+        }
+      return true;
+      }
+    if ( this->PolyData )
+      {
+      // When a single cell array in the offsets layout holds all the cells,
+      // the cell ids are its cell ids. Otherwise make sure the cell types
+      // exist, GetCellPoints() then only reads.
+      vtkCellArray *arrays[4] = { this->PolyData->GetVerts(),
+                                  this->PolyData->GetLines(),
+                                  this->PolyData->GetPolys(),
+                                  this->PolyData->GetStrips() };
+      vtkIdType numCells = this->PolyData->GetNumberOfCells();
+      for ( int i = 0; i < 4; i++ )
+        {
+        if ( arrays[i]->IsOffsetsLayout() &&
+             arrays[i]->GetNumberOfCells() == numCells )
+          {
+          this->Cells = arrays[i];
+          return true;
+          }
+        }
+      if ( numCells > 0 )
+        {
+        this->PolyData->GetCellType(0);
+        }
+      return true;
+      }
+    return false;
+  }
+
+  void GetCell(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts,
+               vtkIdList *scratch)
+  {
+    if ( this->Legacy )
+      {
+      const vtkIdType *cell = this->Legacy + this->Locations[cellId];
+      npts = cell[0];
+      pts = cell + 1;
+      }
+    else if ( this->Cells )
+      {
+      this->Cells->GetCellAtId(cellId, npts, pts, scratch);
+      }
+    else
+      {
+      this->DataSet->GetCellPoints(cellId, scratch);
+      npts = scratch->GetNumberOfIds();
+      pts = scratch->GetPointer(0);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Computes the bucket of each cell of a chunk of cells and counts the cells
+// of each bucket per chunk. Empty cells have no bucket.
+template <class T>
+class vtkSpanSpaceClassifyCells
+{
+public:
+  vtkSpanSpaceCells *Cells;
+  const T *Scalars;
+  int NumberOfComponents;
+  double Min;
+  double Scale;
+  int Resolution;
+  vtkIdType NumberOfCells;
+  vtkIdType ChunkSize;
+  int *Buckets;
+  vtkIdType *Counts;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList> > Scratch;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkSmartPointer<vtkIdList> &scratch = this->Scratch.Local();
+    if ( !scratch )
+      {
+      scratch = vtkSmartPointer<vtkIdList>::New();
+      }
+    vtkIdType numBuckets =
+      static_cast<vtkIdType>(this->Resolution) * this->Resolution;
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+      {
+      vtkIdType *counts = this->Counts + chunk * numBuckets;
+      vtkIdType first = chunk * this->ChunkSize;
+      vtkIdType last = std::min(first + this->ChunkSize, this->NumberOfCells);
+      for (vtkIdType cellId = first; cellId < last; cellId++)
+        {
+        this->Cells->GetCell(cellId, npts, pts, scratch);
+        if ( npts < 1 )
+          {
+          this->Buckets[cellId] = -1;
+          continue;
+          }
+        T min = this->Scalars[pts[0] * this->NumberOfComponents];
+        T max = min;
+        for (vtkIdType i = 1; i < npts; i++)
+          {
+          T s = this->Scalars[pts[i] * this->NumberOfComponents];
+          min = (s < min ? s : min);
+          max = (s > max ? s : max);
+          }
+        int bucket = vtkSpanSpaceGetIndex(min, this->Min, this->Scale,
+                                          this->Resolution) *
+          this->Resolution + vtkSpanSpaceGetIndex(max, this->Min, this->Scale,
+                                                  this->Resolution);
+        this->Buckets[cellId] = bucket;
+        ++counts[bucket];
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Scatters the cell ids of each chunk of cells into their buckets, from
+// the first place of the chunk in each bucket. The cells of a bucket are
+// thus in increasing id order.
+class vtkSpanSpaceScatterCells
+{
+public:
+  const int *Buckets;
+  vtkIdType *Cursors;
+  vtkIdType NumberOfBuckets;
+  vtkIdType NumberOfCells;
+  vtkIdType ChunkSize;
+  vtkIdType *CellIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+      {
+      vtkIdType *cursors = this->Cursors + chunk * this->NumberOfBuckets;
+      vtkIdType first = chunk * this->ChunkSize;
+      vtkIdType last = std::min(first + this->ChunkSize, this->NumberOfCells);
+      for (vtkIdType cellId = first; cellId < last; cellId++)
+        {
+        if ( this->Buckets[cellId] >= 0 )
+          {
+          this->CellIds[cursors[this->Buckets[cellId]]++] = cellId;
+          }
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Copies runs of cell ids, one per row of buckets.
+class vtkSpanSpaceCopyRuns
+{
+public:
+  const vtkIdType *CellIds;
+  const vtkIdType *Begins;
+  const vtkIdType *Ends;
+  const vtkIdType *Destinations;
+  vtkIdType *Output;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType row = begin; row < end; row++)
+      {
+      std::copy(this->CellIds + this->Begins[row],
+                this->CellIds + this->Ends[row],
+                this->Output + this->Destinations[row]);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSpanSpaceClassify(vtkSpanSpaceCells *cells, const T *scalars,
+                          int numComps, const double range[2],
+                          int resolution, vtkIdType numCells,
+                          vtkIdType numChunks, vtkIdType chunkSize,
+                          bool parallel, int *buckets, vtkIdType *counts)
+{
+  vtkSpanSpaceClassifyCells<T> classify;
+  classify.Cells = cells;
+  classify.Scalars = scalars;
+  classify.NumberOfComponents = numComps;
+  classify.Min = range[0];
+  classify.Scale = (range[1] > range[0] ?
+                    resolution / (range[1] - range[0]) : 0.0);
+  classify.Resolution = resolution;
+  classify.NumberOfCells = numCells;
+  classify.ChunkSize = chunkSize;
+  classify.Buckets = buckets;
+  classify.Counts = counts;
+  if ( parallel )
+    {
+    vtkSMPTools::For(0, numChunks, 1, classify);
+    }
+  else
+    {
+    classify(0, numChunks);
+    }
+}
+} // end anon namespace
+
+//----------------------------------------------------------------------------
+// Instantiate a span space with a resolution of 100.
+vtkSpanSpace::vtkSpanSpace()
+{
+  this->Resolution = 100;
+  this->Range[0] = 0.0;
+  this->Range[1] = 1.0;
+  this->TreeResolution = 0;
+  this->CellIds = NULL;
+  this->Offsets = NULL;
+  this->TreeScalars = NULL;
+  this->TraversalCells = vtkIdList::New();
+  this->TraversalIndex = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkSpanSpace::~vtkSpanSpace()
+{
+  this->Initialize();
+  this->TraversalCells->Delete();
+}
+
+//----------------------------------------------------------------------------
+// Initialize locator. Frees memory and resets object as appropriate.
+void vtkSpanSpace::Initialize()
+{
+  delete [] this->CellIds;
+  this->CellIds = NULL;
+  delete [] this->Offsets;
+  this->Offsets = NULL;
+  this->TraversalCells->Reset();
+  this->TraversalIndex = 0;
+}
+
+//----------------------------------------------------------------------------
+// Construct the span space from the dataset provided. The cells are
+// classified in chunks in parallel, then sorted by bucket with a counting
+// sort whose counts are kept per chunk, so that each chunk scatters its
+// cells without synchronization and in the order of their ids.
+void vtkSpanSpace::BuildTree()
+{
+  vtkIdType numCells;
+
+  // Check input...see whether we have to rebuild
+  //
+  if ( !this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1 )
+    {
+    vtkErrorMacro( << "No data to build tree with");
+    return;
+    }
+
+  vtkDataArray *scalars = this->GetTreeScalars();
+  if ( ! scalars )
+    {
+    vtkErrorMacro( << "No scalar data to build trees with");
+    return;
+    }
+
+  if ( this->CellIds != NULL && this->BuildTime > this->MTime
+    && this->BuildTime > this->DataSet->GetMTime()
+    && this->BuildTime > scalars->GetMTime() && this->TreeScalars == scalars )
+    {
+    return;
+    }
+
+  vtkDebugMacro( << "Building span space..." );
+
+  this->Initialize();
+  this->TreeScalars = scalars;
+  this->TreeResolution = this->Resolution;
+  scalars->GetRange(this->Range, 0);
+
+  int resolution = this->TreeResolution;
+  vtkIdType numBuckets = static_cast<vtkIdType>(resolution) * resolution;
+  vtkSpanSpaceCells cells;
+  bool parallel = cells.Initialize(this->DataSet);
+
+  // A few chunks per thread balance the load, the counts of each chunk
+  // take the memory of a bucket table.
+  vtkIdType numChunks = 1;
+  if ( parallel )
+    {
+    numChunks = std::min(static_cast<vtkIdType>(
+                           4 * vtkSMPTools::GetEstimatedNumberOfThreads()),
+                         (numCells + 1023) / 1024);
+    }
+  vtkIdType chunkSize = (numCells + numChunks - 1) / numChunks;
+  std::vector<int> buckets(numCells);
+  std::vector<vtkIdType> counts(numChunks * numBuckets, 0);
+
+  switch (scalars->GetDataType())
+    {
+    vtkTemplateMacro(
+      vtkSpanSpaceClassify(&cells,
+                           static_cast<VTK_TT *>(scalars->GetVoidPointer(0)),
+                           scalars->GetNumberOfComponents(), this->Range,
+                           resolution, numCells, numChunks, chunkSize,
+                           parallel, &buckets[0], &counts[0]));
+    default:
+      vtkErrorMacro( << "Unsupported scalar type");
+      return;
+    }
+
+  // The cells of a bucket start with those of the first chunk.
+  this->Offsets = new vtkIdType[numBuckets + 1];
+  vtkIdType numIds = 0;
+  for (vtkIdType bucket = 0; bucket < numBuckets; bucket++)
+    {
+    this->Offsets[bucket] = numIds;
+    for (vtkIdType chunk = 0; chunk < numChunks; chunk++)
+      {
+      vtkIdType count = counts[chunk * numBuckets + bucket];
+      counts[chunk * numBuckets + bucket] = numIds;
+      numIds += count;
+      }
+    }
+  this->Offsets[numBuckets] = numIds;
+
+  this->CellIds = new vtkIdType[numIds > 0 ? numIds : 1];
+  vtkSpanSpaceScatterCells scatter;
+  scatter.Buckets = &buckets[0];
+  scatter.Cursors = &counts[0];
+  scatter.NumberOfBuckets = numBuckets;
+  scatter.NumberOfCells = numCells;
+  scatter.ChunkSize = chunkSize;
+  scatter.CellIds = this->CellIds;
+  if ( parallel )
+    {
+    vtkSMPTools::For(0, numChunks, 1, scatter);
+    }
+  else
+    {
+    scatter(0, numChunks);
+    }
+
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkSpanSpace::GatherCells(const int *startColumns, vtkIdList *cellIds)
+{
+  int resolution = this->TreeResolution;
+  std::vector<vtkIdType> begins(resolution), ends(resolution);
+  std::vector<vtkIdType> destinations(resolution);
+  vtkIdType numIds = 0;
+  for (int row = 0; row < resolution; row++)
+    {
+    vtkIdType rowStart = static_cast<vtkIdType>(row) * resolution;
+    if ( startColumns[row] < 0 )
+      {
+      begins[row] = ends[row] = 0;
+      }
+    else
+      {
+      begins[row] = this->Offsets[rowStart + startColumns[row]];
+      ends[row] = this->Offsets[rowStart + resolution];
+      }
+    destinations[row] = numIds;
+    numIds += ends[row] - begins[row];
+    }
+
+  cellIds->SetNumberOfIds(numIds);
+  if ( numIds == 0 )
+    {
+    return;
+    }
+  vtkSpanSpaceCopyRuns copy;
+  copy.CellIds = this->CellIds;
+  copy.Begins = &begins[0];
+  copy.Ends = &ends[0];
+  copy.Destinations = &destinations[0];
+  copy.Output = cellIds->GetPointer(0);
+  vtkSMPTools::For(0, resolution, 1, copy);
+  std::sort(copy.Output, copy.Output + numIds);
+}
+
+//----------------------------------------------------------------------------
+// The cells containing a value v are in the buckets of the rows up to the
+// row of v, from the column of v on. For several values, each row starts
+// at the column of the first value whose column is not before the row.
+void vtkSpanSpace::FindCells(int numValues, const double *values,
+                             vtkIdList *cellIds)
+{
+  cellIds->Reset();
+  this->BuildTree();
+  if ( this->CellIds == NULL )
+    {
+    return;
+    }
+
+  int resolution = this->TreeResolution;
+  double scale = (this->Range[1] > this->Range[0] ?
+                  resolution / (this->Range[1] - this->Range[0]) : 0.0);
+  std::vector<int> columns;
+  for (int i = 0; i < numValues; i++)
+    {
+    if ( values[i] >= this->Range[0] && values[i] <= this->Range[1] )
+      {
+      columns.push_back(vtkSpanSpaceGetIndex(values[i], this->Range[0],
+                                             scale, resolution));
+      }
+    }
+  if ( columns.empty() )
+    {
+    return;
+    }
+  std::sort(columns.begin(), columns.end());
+
+  std::vector<int> startColumns(resolution, -1);
+  size_t next = 0;
+  for (int row = 0; row < resolution; row++)
+    {
+    while ( next < columns.size() && columns[next] < row )
+      {
+      ++next;
+      }
+    if ( next == columns.size() )
+      {
+      break;
+      }
+    startColumns[row] = columns[next];
+    }
+  this->GatherCells(&startColumns[0], cellIds);
+}
+
+//----------------------------------------------------------------------------
+// The cells intersecting [minValue,maxValue] are in the buckets of the rows
+// up to the row of maxValue, from the column of minValue on.
+void vtkSpanSpace::FindCellsInRange(double minValue, double maxValue,
+                                    vtkIdList *cellIds)
+{
+  cellIds->Reset();
+  this->BuildTree();
+  if ( this->CellIds == NULL || minValue > maxValue ||
+       maxValue < this->Range[0] || minValue > this->Range[1] )
+    {
+    return;
+    }
+
+  int resolution = this->TreeResolution;
+  double scale = (this->Range[1] > this->Range[0] ?
+                  resolution / (this->Range[1] - this->Range[0]) : 0.0);
+  int minColumn = vtkSpanSpaceGetIndex(minValue, this->Range[0], scale,
+                                       resolution);
+  int maxRow = vtkSpanSpaceGetIndex(maxValue, this->Range[0], scale,
+                                    resolution);
+  std::vector<int> startColumns(resolution, -1);
+  for (int row = 0; row <= maxRow; row++)
+    {
+    startColumns[row] = (row > minColumn ? row : minColumn);
+    }
+  this->GatherCells(&startColumns[0], cellIds);
+}
+
+//----------------------------------------------------------------------------
+// Begin to traverse the cells based on a scalar value. Returned cells
+// will have scalar values that span the scalar value specified.
+void vtkSpanSpace::InitTraversal(double scalarValue)
+{
+  this->ScalarValue = scalarValue;
+  this->FindCells(1, &scalarValue, this->TraversalCells);
+  this->TraversalIndex = 0;
+}
+
+//----------------------------------------------------------------------------
+// Return the next cell that may contain scalar value specified to
+// initialize traversal. The value NULL is returned if the list is
+// exhausted. Make sure that InitTraversal() has been invoked first or
+// you'll get erratic behavior.
+vtkCell *vtkSpanSpace::GetNextCell(vtkIdType& cellId, vtkIdList* &cellPts,
+                                   vtkDataArray *cellScalars)
+{
+  vtkIdType numCells = this->TraversalCells->GetNumberOfIds();
+  while ( this->TraversalIndex < numCells )
+    {
+    cellId = this->TraversalCells->GetId(this->TraversalIndex++);
+    vtkCell *cell = this->DataSet->GetCell(cellId);
+    cellPts = cell->GetPointIds();
+    vtkIdType numScalars = cellPts->GetNumberOfIds();
+    cellScalars->SetNumberOfTuples(numScalars);
+    this->TreeScalars->GetTuples(cellPts, cellScalars);
+    double min = VTK_DOUBLE_MAX, max = -VTK_DOUBLE_MAX;
+    for (vtkIdType i = 0; i < numScalars; i++)
+      {
+      double s = cellScalars->GetComponent(i, 0);
+      min = (s < min ? s : min);
+      max = (s > max ? s : max);
+      }
+    if ( this->ScalarValue >= min && this->ScalarValue <= max )
+      {
+      return cell;
+      }
+    }
+  return NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkSpanSpace::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Resolution: " << this->Resolution << "\n";
+}
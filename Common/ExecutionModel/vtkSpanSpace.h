@@ -0,0 +1,119 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpanSpace.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSpanSpace - organize cells in the span space of their scalar range (used to accelerate contouring operations)
+// .SECTION Description
+// vtkSpanSpace is a scalar tree that represents each cell by the point
+// (min,max) of its scalar range, in the so called span space. The span
+// space is divided into Resolution x Resolution buckets, and the cell ids
+// are sorted by bucket. The cells that may contain a scalar value v are
+// then those of the buckets whose min is below v and whose max is above
+// v: a staircase of contiguous runs of cell ids, one per row of buckets.
+// The cost of a query is thus proportional to the number of cells it
+// returns (plus the cells of the buckets containing v), not to the number
+// of cells of the dataset, which makes repeated contouring of a dataset
+// with changing values cheap once the tree is built.
+//
+// The tree is built in parallel with vtkSMPTools for unstructured grids
+// and polygonal data. FindCells() and FindCellsInRange() return the cells
+// in increasing id order, so that filters using the tree produce the same
+// output as without it.
+
+// .SECTION See Also
+// vtkScalarTree vtkSimpleScalarTree
+
+#ifndef __vtkSpanSpace_h
+#define __vtkSpanSpace_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkScalarTree.h"
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkSpanSpace : public vtkScalarTree
+{
+public:
+  // Description:
+  // Instantiate a span space with a resolution of 100.
+  static vtkSpanSpace *New();
+
+  // Description:
+  // Standard type related macros and PrintSelf() method.
+  vtkTypeMacro(vtkSpanSpace,vtkScalarTree);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the number of divisions of the scalar range along each axis of the
+  // span space. Larger values mean fewer cells to check per query but more
+  // runs of cell ids to visit.
+  vtkSetClampMacro(Resolution,int,1,10000);
+  vtkGetMacro(Resolution,int);
+
+  // Description:
+  // Construct the span space from the dataset provided. Checks build times
+  // and modified time from input and reconstructs the tree if necessary.
+  virtual void BuildTree();
+
+  // Description:
+  // Initialize locator. Frees memory and resets object as appropriate.
+  virtual void Initialize();
+
+  // Description:
+  // Begin to traverse the cells based on a scalar value. Returned cells
+  // will have scalar values that span the scalar value specified.
+  virtual void InitTraversal(double scalarValue);
+
+  // Description:
+  // Return the next cell that contains the scalar value specified to
+  // initialize traversal, in increasing id order. The value NULL is
+  // returned if the list is exhausted. Make sure that InitTraversal() has
+  // been invoked first or you'll get erratic behavior.
+  virtual vtkCell *GetNextCell(vtkIdType &cellId, vtkIdList* &ptIds,
+                               vtkDataArray *cellScalars);
+
+  // Description:
+  // Return in cellIds, in increasing order, the ids of the cells whose
+  // scalar range may contain any of the values given.
+  virtual void FindCells(int numValues, const double *values,
+                         vtkIdList *cellIds);
+
+  // Description:
+  // Return in cellIds, in increasing order, the ids of the cells whose
+  // scalar range may intersect the range [minValue,maxValue].
+  virtual void FindCellsInRange(double minValue, double maxValue,
+                                vtkIdList *cellIds);
+
+protected:
+  vtkSpanSpace();
+  ~vtkSpanSpace();
+
+  int Resolution;
+  double Range[2]; //scalar range covered by the buckets
+  int TreeResolution; //resolution the buckets were built with
+  vtkIdType *CellIds; //cell ids sorted by bucket
+  vtkIdType *Offsets; //start of each bucket in CellIds
+  vtkDataArray *TreeScalars; //the scalars the tree was built with
+
+  // Gather into cellIds the runs of cell ids of the buckets of each row i
+  // from column startColumns[i] on (none if negative), in increasing order.
+  void GatherCells(const int *startColumns, vtkIdList *cellIds);
+
+private:
+  vtkIdList *TraversalCells; //cells of the current traversal
+  vtkIdType TraversalIndex; //next cell of the current traversal
+
+private:
+  vtkSpanSpace(const vtkSpanSpace&);  // Not implemented.
+  void operator=(const vtkSpanSpace&);  // Not implemented.
+};
+
+#endif
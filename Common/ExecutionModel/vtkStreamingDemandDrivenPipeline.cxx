@@ -14,8 +14,10 @@
 =========================================================================*/
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include "vtkAbstractArray.h"
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkAsyncUpdate.h"
 #include "vtkDataObject.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
@@ -23,6 +25,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationDoubleVectorKey.h"
+#include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationIdTypeKey.h"
 #include "vtkInformationInformationVectorKey.h"
 #include "vtkInformationIntegerKey.h"
@@ -34,37 +37,49 @@
 #include "vtkInformationUnsignedLongKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointSet.h"
 #include "vtkSmartPointer.h"
 
+#include <map>
+#include <utility>
+#include <vector>
+
 vtkStandardNewMacro(vtkStreamingDemandDrivenPipeline);
 
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, CONTINUE_EXECUTING, Integer);
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, EXACT_EXTENT, Integer);
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REQUEST_UPDATE_EXTENT, Request);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, CONTINUE_EXECUTING, Integer);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, EXACT_EXTENT, Integer);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, REQUEST_UPDATE_EXTENT, Request);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REQUEST_UPDATE_TIME, Request);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REQUEST_TIME_DEPENDENT_INFORMATION, Request);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REQUEST_UPDATE_EXTENT_INFORMATION, Request);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REQUEST_MANAGE_INFORMATION, Request);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REQUEST_RESOLUTION_PROPAGATE, Request);
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, MAXIMUM_NUMBER_OF_PIECES, Integer);
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_EXTENT_INITIALIZED, Integer);
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_PIECE_NUMBER, Integer);
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_NUMBER_OF_PIECES, Integer);
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_NUMBER_OF_GHOST_LEVELS, Integer);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REQUEST_MEMORY_ESTIMATE, Request);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, FOR_MEMORY_ESTIMATE, Integer);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, ESTIMATED_MEMORY_SIZE, UnsignedLong);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, ESTIMATED_NUMBER_OF_POINTS, IdType);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, ESTIMATED_NUMBER_OF_CELLS, IdType);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, ESTIMATED_PIPELINE_MEMORY_SIZE, UnsignedLong);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, ESTIMATED_PEAK_MEMORY_SIZE, UnsignedLong);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, MAXIMUM_NUMBER_OF_PIECES, Integer);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, UPDATE_EXTENT_INITIALIZED, Integer);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, UPDATE_PIECE_NUMBER, Integer);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, UPDATE_NUMBER_OF_PIECES, Integer);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, UPDATE_NUMBER_OF_GHOST_LEVELS, Integer);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_EXTENT_TRANSLATED, Integer);
-vtkInformationKeyRestrictedMacro(vtkStreamingDemandDrivenPipeline, WHOLE_EXTENT, IntegerVector, 6);
-vtkInformationKeyRestrictedMacro(vtkStreamingDemandDrivenPipeline, UPDATE_EXTENT, IntegerVector, 6);
-vtkInformationKeyRestrictedMacro(vtkStreamingDemandDrivenPipeline, COMBINED_UPDATE_EXTENT, IntegerVector, 6);
+vtkInformationKeyRestrictedSlotMacro(vtkStreamingDemandDrivenPipeline, WHOLE_EXTENT, IntegerVector, 6);
+vtkInformationKeyRestrictedSlotMacro(vtkStreamingDemandDrivenPipeline, UPDATE_EXTENT, IntegerVector, 6);
+vtkInformationKeyRestrictedSlotMacro(vtkStreamingDemandDrivenPipeline, COMBINED_UPDATE_EXTENT, IntegerVector, 6);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UNRESTRICTED_UPDATE_EXTENT, Integer);
 vtkInformationKeyRestrictedMacro(vtkStreamingDemandDrivenPipeline,
                                  EXTENT_TRANSLATOR, ObjectBase,
                                  "vtkExtentTranslator");
 vtkInformationKeyRestrictedMacro(vtkStreamingDemandDrivenPipeline, WHOLE_BOUNDING_BOX, DoubleVector, 6);
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, TIME_STEPS, DoubleVector);
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_TIME_STEP, Double);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, TIME_STEPS, DoubleVector);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, UPDATE_TIME_STEP, Double);
 
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, PREVIOUS_UPDATE_TIME_STEP, Double);
-vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, TIME_RANGE, DoubleVector);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, PREVIOUS_UPDATE_TIME_STEP, Double);
+vtkInformationKeySlotMacro(vtkStreamingDemandDrivenPipeline, TIME_RANGE, DoubleVector);
 
 vtkInformationKeyRestrictedMacro(vtkStreamingDemandDrivenPipeline, PIECE_BOUNDING_BOX, DoubleVector, 6);
 vtkInformationKeyRestrictedMacro(vtkStreamingDemandDrivenPipeline, PIECE_NORMAL, DoubleVector, 3);
@@ -96,12 +111,28 @@ public:
     }
 };
 
+//----------------------------------------------------------------------------
+// State of the asynchronous updates of an executive.
+class vtkStreamingDemandDrivenPipelineAsyncOutputs
+{
+public:
+  vtkStreamingDemandDrivenPipelineAsyncOutputs() : SequenceNumber(0) {}
+
+  // The most recent update.
+  vtkSmartPointer<vtkAsyncUpdate> Update;
+
+  // Outputs of the most recent completed update, by port.
+  std::vector<vtkSmartPointer<vtkDataObject> > Outputs;
+  unsigned long SequenceNumber;
+};
+
 //----------------------------------------------------------------------------
 vtkStreamingDemandDrivenPipeline::vtkStreamingDemandDrivenPipeline()
 {
   this->ContinueExecuting = 0;
   this->UpdateExtentRequest = 0;
   this->LastPropogateUpdateExtentShortCircuited = 0;
+  this->AsyncOutputs = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -111,6 +142,7 @@ vtkStreamingDemandDrivenPipeline::~vtkStreamingDemandDrivenPipeline()
     {
     this->UpdateExtentRequest->Delete();
     }
+  delete this->AsyncOutputs;
 }
 
 //----------------------------------------------------------------------------
@@ -269,7 +301,10 @@ int vtkStreamingDemandDrivenPipeline
 
     // If we need to execute, propagate the update extent.
     int result = 1;
-    int N2E = this->NeedToExecuteData(outputPort,inInfoVec,outInfoVec);
+    int forEstimate = request->Has(FOR_MEMORY_ESTIMATE());
+    int N2E = forEstimate ?
+      this->WouldExecuteData(outputPort,inInfoVec,outInfoVec) :
+      this->NeedToExecuteData(outputPort,inInfoVec,outInfoVec);
     if (!N2E &&
         outInfo &&
         this->GetNumberOfInputPorts() &&
@@ -329,7 +364,9 @@ int vtkStreamingDemandDrivenPipeline
         result = 1;
         }
       }
-    if (!this->NeedToExecuteData(outputPort,inInfoVec,outInfoVec))
+    if (forEstimate ?
+        !this->WouldExecuteData(outputPort,inInfoVec,outInfoVec) :
+        !this->NeedToExecuteData(outputPort,inInfoVec,outInfoVec))
       {
       if(outInfo && outInfo->Has(COMBINED_UPDATE_EXTENT()))
         {
@@ -340,6 +377,38 @@ int vtkStreamingDemandDrivenPipeline
     return result;
     }
 
+  if(request->Has(REQUEST_MEMORY_ESTIMATE()))
+    {
+    // Estimate the inputs first.  Only an algorithm that would execute
+    // estimates its outputs: the default estimates of outputs that are
+    // up to date are their actual sizes.  Then add the estimates of the
+    // pipeline upstream.
+    int outputPort = -1;
+    if(request->Has(FROM_OUTPUT_PORT()))
+      {
+      outputPort = request->Get(FROM_OUTPUT_PORT());
+      }
+    if(!this->ForwardUpstream(request))
+      {
+      return 0;
+      }
+    if(this->WouldExecuteData(outputPort, inInfoVec, outInfoVec))
+      {
+      if(!this->CallAlgorithm(request, vtkExecutive::RequestDownstream,
+                              inInfoVec, outInfoVec))
+        {
+        return 0;
+        }
+      }
+    else
+      {
+      this->CopyDefaultInformation(request, vtkExecutive::RequestDownstream,
+                                   inInfoVec, outInfoVec);
+      }
+    this->AggregateMemoryEstimates(inInfoVec, outInfoVec);
+    return 1;
+    }
+
   if(request->Has(REQUEST_DATA()))
     {
     // Let the superclass handle the request first.
@@ -408,6 +477,172 @@ int vtkStreamingDemandDrivenPipeline::Update(int port)
     }
 }
 
+//----------------------------------------------------------------------------
+vtkAsyncUpdate* vtkStreamingDemandDrivenPipeline::UpdateAsync(int port)
+{
+  if(!this->OutputPortIndexInRange(port, "update asynchronously") ||
+     !this->CheckAlgorithm("UpdateAsync", 0))
+    {
+    return 0;
+    }
+  if(!this->AsyncOutputs)
+    {
+    this->AsyncOutputs = new vtkStreamingDemandDrivenPipelineAsyncOutputs;
+    }
+
+  vtkSmartPointer<vtkAsyncUpdate> update =
+    vtkSmartPointer<vtkAsyncUpdate>::New();
+  update->ExecutivePointer = this;
+  update->Executive = this;
+  update->Algorithm = this->Algorithm;
+  update->OutputPort = port;
+  this->AsyncOutputs->Update = update;
+  vtkAsyncUpdate::Submit(update);
+  return update;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkStreamingDemandDrivenPipeline::GetAsyncOutputData(int port)
+{
+  if(!this->AsyncOutputs || port < 0 ||
+     port >= static_cast<int>(this->AsyncOutputs->Outputs.size()))
+    {
+    return 0;
+    }
+  return this->AsyncOutputs->Outputs[port];
+}
+
+//----------------------------------------------------------------------------
+// Append the executives upstream of exec, producers first, with the
+// output port of each that is used downstream.
+static void vtkStreamingDemandDrivenPipelineCollectProducers(
+  vtkExecutive* exec, int port, std::map<vtkExecutive*, int>& visited,
+  std::vector<std::pair<vtkExecutive*, int> >& producers)
+{
+  if(visited.find(exec) != visited.end())
+    {
+    return;
+    }
+  visited[exec] = port;
+  for(int i=0; i < exec->GetNumberOfInputPorts(); ++i)
+    {
+    int nic = exec->GetAlgorithm()->GetNumberOfInputConnections(i);
+    vtkInformationVector* inVector = exec->GetInputInformation()[i];
+    for(int j=0; j < nic; ++j)
+      {
+      vtkInformation* inInfo = inVector->GetInformationObject(j);
+      vtkExecutive* e;
+      int producerPort;
+      vtkExecutive::PRODUCER()->Get(inInfo, e, producerPort);
+      if(e)
+        {
+        vtkStreamingDemandDrivenPipelineCollectProducers(
+          e, producerPort, visited, producers);
+        }
+      }
+    }
+  producers.push_back(std::make_pair(exec, port));
+}
+
+//----------------------------------------------------------------------------
+int vtkStreamingDemandDrivenPipeline::ExecuteAsyncUpdate(
+  vtkAsyncUpdate* update)
+{
+  int port = update->OutputPort;
+  if(!this->UpdateInformation())
+    {
+    return 0;
+    }
+
+  std::map<vtkExecutive*, int> visited;
+  std::vector<std::pair<vtkExecutive*, int> > steps;
+  vtkStreamingDemandDrivenPipelineCollectProducers(this, port, visited, steps);
+
+  int retval = 1;
+  int cancelled = 0;
+  do
+    {
+    this->PropagateTime(port);
+    this->UpdateTimeDependentInformation(port);
+    retval = this->PropagateUpdateExtent(port);
+    if(retval && !this->LastPropogateUpdateExtentShortCircuited)
+      {
+      // Producers are up to date when their consumers execute, so each
+      // step executes a single algorithm.
+      for(size_t i=0; retval && i < steps.size(); ++i)
+        {
+        vtkDemandDrivenPipeline* ddp =
+          vtkDemandDrivenPipeline::SafeDownCast(steps[i].first);
+        if(!ddp)
+          {
+          continue;
+          }
+        vtkAlgorithm* algorithm = ddp->GetAlgorithm();
+        if(!update->BeginAlgorithm(algorithm))
+          {
+          cancelled = 1;
+          break;
+          }
+        retval = ddp->UpdateData(steps[i].second);
+        update->EndAlgorithm(algorithm);
+        }
+      }
+    }
+  while(retval && !cancelled && this->ContinueExecuting);
+
+  if(cancelled || !retval)
+    {
+    if(this->ContinueExecuting)
+      {
+      // Streaming stopped in the middle: start over next time.
+      this->ContinueExecuting = 0;
+      this->Algorithm->Modified();
+      }
+    return 0;
+    }
+
+  vtkDataObject* output =
+    this->GetOutputInformation(port)->Get(vtkDataObject::DATA_OBJECT());
+  if(output)
+    {
+    update->OutputData.TakeReference(output->NewInstance());
+    update->OutputData->ShallowCopy(output);
+    update->OutputData->GetInformation()->CopyEntry(
+      output->GetInformation(), vtkDataObject::DATA_TIME_STEP());
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkStreamingDemandDrivenPipeline::PublishAsyncUpdate(
+  vtkAsyncUpdate* update)
+{
+  vtkDataObject* data = update->OutputData;
+  if(!this->AsyncOutputs || !data ||
+     update->SequenceNumber <= this->AsyncOutputs->SequenceNumber)
+    {
+    return;
+    }
+  this->AsyncOutputs->SequenceNumber = update->SequenceNumber;
+
+  int port = update->OutputPort;
+  std::vector<vtkSmartPointer<vtkDataObject> >& outputs =
+    this->AsyncOutputs->Outputs;
+  if(port >= static_cast<int>(outputs.size()))
+    {
+    outputs.resize(port + 1);
+    }
+  // Keep the same data object so that consumers stay connected to it.
+  if(!outputs[port] ||
+     strcmp(outputs[port]->GetClassName(), data->GetClassName()) != 0)
+    {
+    outputs[port].TakeReference(data->NewInstance());
+    }
+  outputs[port]->ShallowCopy(data);
+  outputs[port]->GetInformation()->CopyEntry(
+    data->GetInformation(), vtkDataObject::DATA_TIME_STEP());
+}
+
 //----------------------------------------------------------------------------
 int vtkStreamingDemandDrivenPipeline::UpdateWholeExtent()
 {
@@ -895,6 +1130,75 @@ vtkStreamingDemandDrivenPipeline
       }
     }
 
+  if(request->Has(REQUEST_MEMORY_ESTIMATE()) &&
+     direction == vtkExecutive::RequestDownstream)
+    {
+    vtkInformation* inInfo = 0;
+    if(this->GetNumberOfInputPorts() > 0)
+      {
+      inInfo = inInfoVec[0]->GetInformationObject(0);
+      }
+    for(int i=0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+      {
+      vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+      outInfo->Remove(ESTIMATED_MEMORY_SIZE());
+      outInfo->Remove(ESTIMATED_NUMBER_OF_POINTS());
+      outInfo->Remove(ESTIMATED_NUMBER_OF_CELLS());
+      outInfo->Remove(ESTIMATED_PIPELINE_MEMORY_SIZE());
+      outInfo->Remove(ESTIMATED_PEAK_MEMORY_SIZE());
+
+      vtkDataObject* outData = outInfo->Get(vtkDataObject::DATA_OBJECT());
+      vtkDataSet* outDataSet = vtkDataSet::SafeDownCast(outData);
+      int* updateExtent = outInfo->Get(UPDATE_EXTENT());
+      if(outDataSet && !this->WouldExecuteData(i, inInfoVec, outInfoVec))
+        {
+        // The output will not be regenerated: use its actual size.
+        outInfo->Set(ESTIMATED_MEMORY_SIZE(),
+                     outDataSet->GetActualMemorySize());
+        outInfo->Set(ESTIMATED_NUMBER_OF_POINTS(),
+                     outDataSet->GetNumberOfPoints());
+        outInfo->Set(ESTIMATED_NUMBER_OF_CELLS(),
+                     outDataSet->GetNumberOfCells());
+        }
+      else if(outData && outData->GetExtentType() == VTK_3D_EXTENT &&
+              updateExtent)
+        {
+        // A structured output is as large as its update extent.
+        vtkIdType numPoints = 1;
+        vtkIdType numCells = 1;
+        for(int j=0; j < 3; ++j)
+          {
+          vtkIdType n = updateExtent[2*j+1] - updateExtent[2*j] + 1;
+          if(n <= 0)
+            {
+            numPoints = numCells = 0;
+            break;
+            }
+          numPoints *= n;
+          numCells *= n > 1 ? n - 1 : 1;
+          }
+        double bytesPerPoint = this->GetEstimatedPointDataSize(outInfo);
+        if(bytesPerPoint == 0.0 && inInfo)
+          {
+          bytesPerPoint = this->GetEstimatedPointDataSize(inInfo);
+          }
+        if(vtkPointSet::SafeDownCast(outData))
+          {
+          bytesPerPoint += 3 * sizeof(float);
+          }
+        this->SetEstimatedOutputSize(outInfo, numPoints, numCells,
+                                     bytesPerPoint, 0.0);
+        }
+      else if(inInfo)
+        {
+        // Otherwise assume the output is like the first input.
+        outInfo->CopyEntry(inInfo, ESTIMATED_MEMORY_SIZE());
+        outInfo->CopyEntry(inInfo, ESTIMATED_NUMBER_OF_POINTS());
+        outInfo->CopyEntry(inInfo, ESTIMATED_NUMBER_OF_CELLS());
+        }
+      }
+    }
+
   if(request->Has(REQUEST_RESOLUTION_PROPAGATE()))
     {
     // Get the output port from which to copy the extent.
@@ -1530,6 +1834,15 @@ int vtkStreamingDemandDrivenPipeline
   return 0;
 }
 
+//----------------------------------------------------------------------------
+int vtkStreamingDemandDrivenPipeline
+::WouldExecuteData(int outputPort,
+                   vtkInformationVector** inInfoVec,
+                   vtkInformationVector* outInfoVec)
+{
+  return this->NeedToExecuteData(outputPort, inInfoVec, outInfoVec);
+}
+
 //----------------------------------------------------------------------------
 int vtkStreamingDemandDrivenPipeline::NeedToExecuteBasedOnTime(
   vtkInformation* outInfo, vtkDataObject* dataObject)
@@ -2342,6 +2655,147 @@ double vtkStreamingDemandDrivenPipeline::ComputePriority(int port)
   return priority;
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkStreamingDemandDrivenPipeline::EstimatePeakMemorySize(int port)
+{
+  // Bring the meta information and the update request up to date, as
+  // Update() does before executing.
+  if(!this->UpdateInformation())
+    {
+    return 0;
+    }
+  if(port < 0 || port >= this->Algorithm->GetNumberOfOutputPorts())
+    {
+    return 0;
+    }
+  // The update extent is propagated like PropagateUpdateExtent() does, but
+  // the executives decide with WouldExecuteData().
+  vtkInformation* rqst = vtkInformation::New();
+  rqst->Set(REQUEST_UPDATE_EXTENT());
+  rqst->Set(FOR_MEMORY_ESTIMATE(), 1);
+  rqst->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+  rqst->Set(vtkExecutive::ALGORITHM_BEFORE_FORWARD(), 1);
+  rqst->Set(FROM_OUTPUT_PORT(), port);
+  this->ProcessRequest(rqst, this->GetInputInformation(),
+                       this->GetOutputInformation());
+  rqst->Delete();
+
+  rqst = vtkInformation::New();
+  rqst->Set(REQUEST_MEMORY_ESTIMATE());
+  rqst->Set(vtkExecutive::FORWARD_DIRECTION(),
+            vtkExecutive::RequestUpstream);
+  rqst->Set(vtkExecutive::FROM_OUTPUT_PORT(), port);
+  int result = this->ProcessRequest(rqst, this->GetInputInformation(),
+                                    this->GetOutputInformation());
+  rqst->Delete();
+
+  vtkInformation* info = this->GetOutputInformation(port);
+  if(!result || !info->Has(ESTIMATED_PEAK_MEMORY_SIZE()))
+    {
+    return 0;
+    }
+  return info->Get(ESTIMATED_PEAK_MEMORY_SIZE());
+}
+
+//----------------------------------------------------------------------------
+void vtkStreamingDemandDrivenPipeline::SetEstimatedOutputSize(
+  vtkInformation* outInfo, vtkIdType numberOfPoints, vtkIdType numberOfCells,
+  double bytesPerPoint, double bytesPerCell)
+{
+  double bytes = numberOfPoints * bytesPerPoint +
+    numberOfCells * bytesPerCell;
+  outInfo->Set(ESTIMATED_MEMORY_SIZE(),
+               static_cast<unsigned long>((bytes + 1023.0) / 1024.0));
+  outInfo->Set(ESTIMATED_NUMBER_OF_POINTS(), numberOfPoints);
+  outInfo->Set(ESTIMATED_NUMBER_OF_CELLS(), numberOfCells);
+}
+
+//----------------------------------------------------------------------------
+double vtkStreamingDemandDrivenPipeline::GetEstimatedPointDataSize(
+  vtkInformation* info)
+{
+  double bytes = 0.0;
+  vtkInformationVector* fields = info->Get(vtkDataObject::POINT_DATA_VECTOR());
+  if(fields)
+    {
+    for(int i=0; i < fields->GetNumberOfInformationObjects(); ++i)
+      {
+      vtkInformation* field = fields->GetInformationObject(i);
+      if(!field->Has(vtkDataObject::FIELD_ARRAY_TYPE()))
+        {
+        continue;
+        }
+      int numComponents = 1;
+      if(field->Has(vtkDataObject::FIELD_NUMBER_OF_COMPONENTS()))
+        {
+        numComponents = field->Get(vtkDataObject::FIELD_NUMBER_OF_COMPONENTS());
+        }
+      bytes += numComponents * vtkAbstractArray::GetDataTypeSize(
+        field->Get(vtkDataObject::FIELD_ARRAY_TYPE()));
+      }
+    }
+  return bytes;
+}
+
+//----------------------------------------------------------------------------
+void vtkStreamingDemandDrivenPipeline::AggregateMemoryEstimates(
+  vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  // The inputs are generated one after the other.  While an input is
+  // generated, the pipelines of the inputs generated before still hold
+  // their outputs.  The algorithm then executes while all of them are
+  // held, and the inputs marked for release are freed afterwards.  A
+  // pipeline shared by several inputs is counted once for each.
+  unsigned long held = 0;
+  unsigned long peak = 0;
+  unsigned long released = 0;
+  for(int i=0; i < this->GetNumberOfInputPorts(); ++i)
+    {
+    for(int j=0; j < inInfoVec[i]->GetNumberOfInformationObjects(); ++j)
+      {
+      vtkInformation* inInfo = inInfoVec[i]->GetInformationObject(j);
+      unsigned long inputPeak = inInfo->Has(ESTIMATED_PEAK_MEMORY_SIZE()) ?
+        inInfo->Get(ESTIMATED_PEAK_MEMORY_SIZE()) : 0;
+      if(held + inputPeak > peak)
+        {
+        peak = held + inputPeak;
+        }
+      if(inInfo->Has(ESTIMATED_PIPELINE_MEMORY_SIZE()))
+        {
+        held += inInfo->Get(ESTIMATED_PIPELINE_MEMORY_SIZE());
+        }
+      if(inInfo->Get(RELEASE_DATA()) &&
+         inInfo->Has(ESTIMATED_MEMORY_SIZE()))
+        {
+        released += inInfo->Get(ESTIMATED_MEMORY_SIZE());
+        }
+      }
+    }
+
+  unsigned long outputs = 0;
+  int numOutputs = outInfoVec->GetNumberOfInformationObjects();
+  for(int i=0; i < numOutputs; ++i)
+    {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    if(outInfo->Has(ESTIMATED_MEMORY_SIZE()))
+      {
+      outputs += outInfo->Get(ESTIMATED_MEMORY_SIZE());
+      }
+    }
+  if(held + outputs > peak)
+    {
+    peak = held + outputs;
+    }
+  held = (released < held ? held - released : 0) + outputs;
+
+  for(int i=0; i < numOutputs; ++i)
+    {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    outInfo->Set(ESTIMATED_PIPELINE_MEMORY_SIZE(), held);
+    outInfo->Set(ESTIMATED_PEAK_MEMORY_SIZE(), peak);
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkStreamingDemandDrivenPipeline::ResetUpdateInformation(
   vtkInformation* vtkNotUsed(request),
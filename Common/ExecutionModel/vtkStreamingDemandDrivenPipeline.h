@@ -29,6 +29,7 @@
 #define VTK_UPDATE_EXTENT_COMBINE 1
 #define VTK_UPDATE_EXTENT_REPLACE 2
 
+class vtkAsyncUpdate;
 class vtkExtentTranslator;
 class vtkInformationDoubleKey;
 class vtkInformationDoubleVectorKey;
@@ -39,6 +40,7 @@ class vtkInformationObjectBaseKey;
 class vtkInformationStringKey;
 class vtkInformationStringKey;
 class vtkInformationUnsignedLongKey;
+class vtkStreamingDemandDrivenPipelineAsyncOutputs;
 
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkStreamingDemandDrivenPipeline : public vtkDemandDrivenPipeline
 {
@@ -60,6 +62,20 @@ public:
   virtual int Update(int port);
   virtual int UpdateWholeExtent();
 
+  // Description:
+  // Bring the output of the given port up to date in a background thread
+  // and return at once.  Queued or executing updates of this executive
+  // are cancelled.  The returned handle belongs to the executive until
+  // the next call; register it to keep it longer.  See vtkAsyncUpdate.
+  vtkAsyncUpdate* UpdateAsync(int port);
+
+  // Description:
+  // Output of the given port as of the most recent asynchronous update
+  // found to be complete by vtkAsyncUpdate::IsDone() or Wait(), or NULL
+  // before that.  Unlike the output of the algorithm, it remains valid
+  // while the next update executes.
+  vtkDataObject* GetAsyncOutputData(int port);
+
   // Description:
   // Propagate the update request from the given output port back
   // through the pipeline.  Should be called only when information is
@@ -188,6 +204,41 @@ public:
   // Key defining to propagate resolution changes up the pipeline.
   static vtkInformationRequestKey* REQUEST_RESOLUTION_PROPAGATE();
 
+  // Description:
+  // Key defining a request to estimate the memory that executing the
+  // pipeline would use, without executing it.  The request travels
+  // upstream and is answered downstream.  For each algorithm, the
+  // executive first sets default estimates of its outputs: the actual
+  // size of an output that is up to date, the size of the update extent
+  // of a structured output, or else the estimate of the first input.  If
+  // it would execute, the algorithm may then replace them from its
+  // parameters, in ProcessRequest().  Finally the
+  // executive aggregates them with the estimates of the inputs.
+  static vtkInformationRequestKey* REQUEST_MEMORY_ESTIMATE();
+
+  // Description:
+  // Set on the REQUEST_UPDATE_EXTENT that EstimatePeakMemorySize() sends
+  // before REQUEST_MEMORY_ESTIMATE.  The executives then decide whether to
+  // propagate the update extent with WouldExecuteData(), so that the
+  // estimate leaves the pipeline as it was.
+  static vtkInformationIntegerKey* FOR_MEMORY_ESTIMATE();
+
+  // Description:
+  // Keys to store, in output information, the estimated size of the
+  // output for its update request in kibibytes, and its estimated numbers
+  // of points and cells.
+  static vtkInformationUnsignedLongKey* ESTIMATED_MEMORY_SIZE();
+  static vtkInformationIdTypeKey* ESTIMATED_NUMBER_OF_POINTS();
+  static vtkInformationIdTypeKey* ESTIMATED_NUMBER_OF_CELLS();
+
+  // Description:
+  // Keys to store, in output information, the estimated size in
+  // kibibytes of the outputs that the pipeline upstream, including this
+  // algorithm, still holds once this output is generated, and the largest
+  // size that they reach while generating it.
+  static vtkInformationUnsignedLongKey* ESTIMATED_PIPELINE_MEMORY_SIZE();
+  static vtkInformationUnsignedLongKey* ESTIMATED_PEAK_MEMORY_SIZE();
+
   // Description:
   // Key for an algorithm to store in a request to tell this executive
   // to keep executing it.
@@ -330,6 +381,27 @@ public:
     }
   virtual double ComputePriority(int port);
 
+  // Description:
+  // Estimate the memory, in kibibytes, that updating the given output port
+  // with its current update request would use: the largest size of the
+  // outputs held at once by the algorithms upstream, including this one.
+  // No algorithm executes its data pass.  Returns 0 if nothing is known.
+  // See REQUEST_MEMORY_ESTIMATE().
+  unsigned long EstimatePeakMemorySize(int port);
+
+  // Description:
+  // Helpers for algorithms answering REQUEST_MEMORY_ESTIMATE().  The first
+  // sets the estimate of an output from its numbers of points and cells
+  // and their average sizes in bytes.  The second returns the size in
+  // bytes of the point data of one point described in the given pipeline
+  // information, or 0 if it is not described.
+  static void SetEstimatedOutputSize(vtkInformation* outInfo,
+                                     vtkIdType numberOfPoints,
+                                     vtkIdType numberOfCells,
+                                     double bytesPerPoint,
+                                     double bytesPerCell);
+  static double GetEstimatedPointDataSize(vtkInformation* info);
+
 protected:
   vtkStreamingDemandDrivenPipeline();
   ~vtkStreamingDemandDrivenPipeline();
@@ -388,6 +460,15 @@ protected:
                                 vtkInformationVector** inInfoVec,
                                 vtkInformationVector* outInfoVec);
 
+  // Whether the algorithm would execute for the current request, asked by
+  // the memory estimate pass.  Unlike NeedToExecuteData(), this must not
+  // change the state of the executive or of the outputs.  Executives whose
+  // NeedToExecuteData() has side effects, such as restoring cached
+  // outputs, override it.
+  virtual int WouldExecuteData(int outputPort,
+                               vtkInformationVector** inInfoVec,
+                               vtkInformationVector* outInfoVec);
+
   // Override these to handle the continue-executing option.
   virtual void ExecuteDataStart(vtkInformation* request,
                                 vtkInformationVector** inInfoVec,
@@ -402,6 +483,11 @@ protected:
                                     vtkInformationVector* outInfoVec);
 
 
+  // Combine the memory estimates of the inputs and outputs of the
+  // algorithm into the pipeline estimates of its outputs.
+  virtual void AggregateMemoryEstimates(vtkInformationVector** inInfoVec,
+                                        vtkInformationVector* outInfoVec);
+
   // Remove update/whole extent when resetting pipeline information.
   virtual void ResetPipelineInformation(int port, vtkInformation*);
 
@@ -414,6 +500,19 @@ protected:
   // did the most recent PUE do anything ?
   int LastPropogateUpdateExtentShortCircuited;
 
+  // Same as Update(), called by the background thread of an asynchronous
+  // update.  The algorithms upstream are executed one at a time so that
+  // cancellation is checked in between.  On success, a shallow copy of
+  // the output is stored in the update.
+  int ExecuteAsyncUpdate(vtkAsyncUpdate* update);
+
+  // Make the output of a completed asynchronous update the output
+  // returned by GetAsyncOutputData(), unless it is older than that one.
+  void PublishAsyncUpdate(vtkAsyncUpdate* update);
+
+  vtkStreamingDemandDrivenPipelineAsyncOutputs* AsyncOutputs;
+  friend class vtkAsyncUpdate;
+
 private:
   vtkStreamingDemandDrivenPipeline(const vtkStreamingDemandDrivenPipeline&);  // Not implemented.
   void operator=(const vtkStreamingDemandDrivenPipeline&);  // Not implemented.
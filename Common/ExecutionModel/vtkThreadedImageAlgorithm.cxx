@@ -23,20 +23,89 @@
 #include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <utility>
+#include <vector>
+
+//----------------------------------------------------------------------------
+// What an incremental execution needs to know about the last execution:
+// the inputs it used, with their modification time, and the outputs it
+// produced.
+struct vtkThreadedImageAlgorithmOutputState
+{
+  vtkDataArray *Scalars;
+  unsigned long ScalarsMTime;
+  unsigned long MTime;
+  int Extent[6];
+};
+
+class vtkThreadedImageAlgorithmIncrementalState
+{
+public:
+  vtkTimeStamp ExecuteTime;
+  std::vector<std::vector<std::pair<vtkDataObject*, unsigned long> > > Inputs;
+  std::vector<vtkThreadedImageAlgorithmOutputState> Outputs;
+};
+
+//----------------------------------------------------------------------------
+static bool vtkThreadedImageAlgorithmIsEmpty(const int ext[6])
+{
+  return ext[0] > ext[1] || ext[2] > ext[3] || ext[4] > ext[5];
+}
+
+//----------------------------------------------------------------------------
+// Grow ext to contain other.
+static void vtkThreadedImageAlgorithmMergeExtent(int ext[6],
+                                                 const int other[6])
+{
+  if (vtkThreadedImageAlgorithmIsEmpty(other))
+    {
+    return;
+    }
+  if (vtkThreadedImageAlgorithmIsEmpty(ext))
+    {
+    memcpy(ext, other, 6 * sizeof(int));
+    return;
+    }
+  for (int i = 0; i < 3; ++i)
+    {
+    if (other[2*i] < ext[2*i])
+      {
+      ext[2*i] = other[2*i];
+      }
+    if (other[2*i+1] > ext[2*i+1])
+      {
+      ext[2*i+1] = other[2*i+1];
+      }
+    }
+}
+
+
+int vtkThreadedImageAlgorithm::GlobalDefaultEnableSMP = 0;
 
 //----------------------------------------------------------------------------
 vtkThreadedImageAlgorithm::vtkThreadedImageAlgorithm()
 {
   this->Threader = vtkMultiThreader::New();
   this->NumberOfThreads = this->Threader->GetNumberOfThreads();
+  this->IncrementalState = new vtkThreadedImageAlgorithmIncrementalState;
+
+  this->EnableSMP = vtkThreadedImageAlgorithm::GlobalDefaultEnableSMP;
+  this->MinimumPieceSize[0] = 16;
+  this->MinimumPieceSize[1] = 1;
+  this->MinimumPieceSize[2] = 1;
+  this->DesiredBytesPerPiece = 65536;
+  this->SplitMode = vtkExtentTranslator::BLOCK_MODE;
+  this->NumberOfPieces = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkThreadedImageAlgorithm::~vtkThreadedImageAlgorithm()
 {
   this->Threader->Delete();
+  delete this->IncrementalState;
 }
 
 //----------------------------------------------------------------------------
@@ -45,6 +114,25 @@ void vtkThreadedImageAlgorithm::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "EnableSMP: " << this->EnableSMP << "\n";
+  os << indent << "MinimumPieceSize: " << this->MinimumPieceSize[0] << " "
+     << this->MinimumPieceSize[1] << " " << this->MinimumPieceSize[2] << "\n";
+  os << indent << "DesiredBytesPerPiece: " << this->DesiredBytesPerPiece
+     << "\n";
+  os << indent << "SplitMode: " << this->SplitMode << "\n";
+  os << indent << "NumberOfPieces: " << this->NumberOfPieces << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(int enable)
+{
+  vtkThreadedImageAlgorithm::GlobalDefaultEnableSMP = enable;
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadedImageAlgorithm::GetGlobalDefaultEnableSMP()
+{
+  return vtkThreadedImageAlgorithm::GlobalDefaultEnableSMP;
 }
 
 struct vtkImageThreadStruct
@@ -55,8 +143,71 @@ struct vtkImageThreadStruct
   vtkInformationVector *OutputsInfo;
   vtkImageData   ***Inputs;
   vtkImageData   **Outputs;
+  int *Extent;
 };
 
+//----------------------------------------------------------------------------
+// Get the extent to compute: the update extent of the output, or that of
+// the first input when there is no output, or the extent to recompute
+// in an incremental execution.
+static bool vtkThreadedImageAlgorithmGetExtent(vtkImageThreadStruct *str,
+                                               int ext[6])
+{
+  // an incremental execution only recomputes part of the extent
+  if (str->Extent)
+    {
+    memcpy(ext, str->Extent, sizeof(int)*6);
+    return true;
+    }
+
+  // if we have an output
+  if (str->Filter->GetNumberOfOutputPorts())
+    {
+    // which output port did the request come from
+    int outputPort =
+      str->Request->Get(vtkDemandDrivenPipeline::FROM_OUTPUT_PORT());
+
+    // if output port is negative then that means this filter is calling the
+    // update directly, for now an error
+    if (outputPort == -1)
+      {
+      return false;
+      }
+
+    // get the update extent from the output port
+    vtkInformation *outInfo =
+      str->OutputsInfo->GetInformationObject(outputPort);
+    int updateExtent[6];
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
+                 updateExtent);
+    memcpy(ext,updateExtent, sizeof(int)*6);
+    }
+  else
+    {
+    // if there is no output, then use UE from input, use the first input
+    int inPort;
+    for (inPort = 0; inPort < str->Filter->GetNumberOfInputPorts(); ++inPort)
+      {
+      if (str->Filter->GetNumberOfInputConnections(inPort))
+        {
+        int updateExtent[6];
+        str->InputsInfo[inPort]
+          ->GetInformationObject(0)
+          ->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
+                updateExtent);
+        memcpy(ext,updateExtent, sizeof(int)*6);
+        break;
+        }
+      }
+    if (inPort >= str->Filter->GetNumberOfInputPorts())
+      {
+      return false;
+      }
+    }
+
+  return true;
+}
+
 //----------------------------------------------------------------------------
 // For streaming and threads.  Splits output update extent into num pieces.
 // This method needs to be called num times.  Results must not overlap for
@@ -137,49 +288,9 @@ VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
   str = static_cast<vtkImageThreadStruct *>
     (static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
 
-  // if we have an output
-  if (str->Filter->GetNumberOfOutputPorts())
+  if (!vtkThreadedImageAlgorithmGetExtent(str, ext))
     {
-    // which output port did the request come from
-    int outputPort =
-      str->Request->Get(vtkDemandDrivenPipeline::FROM_OUTPUT_PORT());
-
-    // if output port is negative then that means this filter is calling the
-    // update directly, for now an error
-    if (outputPort == -1)
-      {
-      return VTK_THREAD_RETURN_VALUE;
-      }
-
-    // get the update extent from the output port
-    vtkInformation *outInfo =
-      str->OutputsInfo->GetInformationObject(outputPort);
-    int updateExtent[6];
-    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
-                 updateExtent);
-    memcpy(ext,updateExtent, sizeof(int)*6);
-    }
-  else
-    {
-    // if there is no output, then use UE from input, use the first input
-    int inPort;
-    for (inPort = 0; inPort < str->Filter->GetNumberOfInputPorts(); ++inPort)
-      {
-      if (str->Filter->GetNumberOfInputConnections(inPort))
-        {
-        int updateExtent[6];
-        str->InputsInfo[inPort]
-          ->GetInformationObject(0)
-          ->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
-                updateExtent);
-        memcpy(ext,updateExtent, sizeof(int)*6);
-        break;
-        }
-      }
-    if (inPort >= str->Filter->GetNumberOfInputPorts())
-      {
-      return VTK_THREAD_RETURN_VALUE;
-      }
+    return VTK_THREAD_RETURN_VALUE;
     }
 
   // execute the actual method with appropriate extent
@@ -210,6 +321,36 @@ VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
   return VTK_THREAD_RETURN_VALUE;
 }
 
+//----------------------------------------------------------------------------
+// Executes bricks of an extent, on the vtkSMPTools thread pool.
+class vtkThreadedImageAlgorithmFunctor
+{
+public:
+  vtkImageThreadStruct *Str;
+  int Extent[6];
+  int Bricks[3];
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkImageThreadStruct *str = this->Str;
+    int splitExt[6];
+    for (vtkIdType brick = begin; brick < end; ++brick)
+      {
+      if (str->Filter->GetAbortExecute())
+        {
+        return;
+        }
+      vtkExtentTranslator::BrickToExtent(static_cast<int>(brick),
+                                         this->Extent, this->Bricks,
+                                         splitExt);
+      str->Filter->ThreadedRequestData(str->Request,
+                                       str->InputsInfo, str->OutputsInfo,
+                                       str->Inputs, str->Outputs,
+                                       splitExt,
+                                       vtkSMPTools::GetThreadIndex());
+      }
+  }
+};
 
 //----------------------------------------------------------------------------
 // This is the superclasses style of Execute method.  Convert it into
@@ -227,8 +368,12 @@ int vtkThreadedImageAlgorithm::RequestData(
   str.Request = request;
   str.InputsInfo = inputVector;
   str.OutputsInfo = outputVector;
+  str.Extent = 0;
 
   // now we must create the output array
+  vtkThreadedImageAlgorithmIncrementalState *state = this->IncrementalState;
+  std::vector<vtkDataArray*> previousScalars(
+    this->GetNumberOfOutputPorts(), static_cast<vtkDataArray*>(0));
   str.Outputs = 0;
   if (this->GetNumberOfOutputPorts())
     {
@@ -241,6 +386,16 @@ int vtkThreadedImageAlgorithm::RequestData(
       str.Outputs[i] = outData;
       if (outData)
         {
+        // keep the scalars of the last execution, unless they were
+        // modified since, before the allocation modifies them
+        vtkDataArray *scalars = outData->GetPointData()->GetScalars();
+        if (scalars && i < static_cast<int>(state->Outputs.size()) &&
+            scalars == state->Outputs[i].Scalars &&
+            scalars->GetMTime() == state->Outputs[i].ScalarsMTime)
+          {
+          previousScalars[i] = scalars;
+          }
+
         int updateExtent[6];
         info->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
                   updateExtent);
@@ -283,14 +438,110 @@ int vtkThreadedImageAlgorithm::RequestData(
     this->CopyAttributeData(str.Inputs[0][0],str.Outputs[0],inputVector);
     }
 
-  this->Threader->SetNumberOfThreads(this->NumberOfThreads);
-  this->Threader->SetSingleMethod(vtkThreadedImageAlgorithmThreadedExecute, &str);
+  // recompute only what depends on the parts of the inputs that changed
+  int modifiedExtent[6];
+  int incremental = this->ComputeIncrementalExtent(
+    request, inputVector, outputVector,
+    previousScalars.empty() ? 0 : &previousScalars[0], modifiedExtent);
+  if (incremental)
+    {
+    str.Extent = modifiedExtent;
+    }
 
-  // always shut off debugging to avoid threading problems with GetMacros
-  int debug = this->Debug;
-  this->Debug = 0;
-  this->Threader->SingleMethodExecute();
-  this->Debug = debug;
+  if (this->EnableSMP)
+    {
+    this->NumberOfPieces = 0;
+    }
+  if (!incremental || !vtkThreadedImageAlgorithmIsEmpty(modifiedExtent))
+    {
+    // always shut off debugging to avoid threading problems with GetMacros
+    int debug = this->Debug;
+    this->Debug = 0;
+
+    if (!this->EnableSMP)
+      {
+      this->Threader->SetNumberOfThreads(this->NumberOfThreads);
+      this->Threader->SetSingleMethod(
+        vtkThreadedImageAlgorithmThreadedExecute, &str);
+      this->Threader->SingleMethodExecute();
+      }
+    else
+      {
+      vtkThreadedImageAlgorithmFunctor functor;
+      functor.Str = &str;
+      if (vtkThreadedImageAlgorithmGetExtent(&str, functor.Extent))
+        {
+        // size the bricks from the size of a voxel of the outputs
+        vtkIdType bytesPerVoxel = 0;
+        for (i = 0; i < this->GetNumberOfOutputPorts(); ++i)
+          {
+          vtkDataArray *scalars = str.Outputs[i] ?
+            str.Outputs[i]->GetPointData()->GetScalars() : 0;
+          if (scalars)
+            {
+            bytesPerVoxel += scalars->GetDataTypeSize() *
+              scalars->GetNumberOfComponents();
+            }
+          }
+        if (bytesPerVoxel == 0)
+          {
+          bytesPerVoxel = 1;
+          }
+        this->NumberOfPieces = vtkExtentTranslator::ComputeBricks(
+          functor.Extent, this->DesiredBytesPerPiece / bytesPerVoxel,
+          this->MinimumPieceSize, this->SplitMode, functor.Bricks);
+        vtkSMPTools::For(0, this->NumberOfPieces, 1, functor);
+        }
+      }
+
+    this->Debug = debug;
+    }
+
+  // record what the next execution needs to know, and which extent of
+  // the outputs changed for the algorithms downstream
+  std::vector<vtkThreadedImageAlgorithmOutputState> previousOutputs;
+  previousOutputs.swap(state->Outputs);
+  if (!this->AbortExecute)
+    {
+    state->Outputs.resize(this->GetNumberOfOutputPorts());
+    for (i = 0; i < this->GetNumberOfOutputPorts(); ++i)
+      {
+      vtkThreadedImageAlgorithmOutputState &output = state->Outputs[i];
+      vtkImageData *outData = str.Outputs[i];
+      if (!outData)
+        {
+        output.Scalars = 0;
+        continue;
+        }
+      if (incremental)
+        {
+        outData->SetModifiedExtent(modifiedExtent, previousOutputs[i].MTime);
+        }
+      else
+        {
+        outData->GetInformation()->Remove(
+          vtkDataObject::DATA_MODIFIED_EXTENT());
+        }
+      output.Scalars = outData->GetPointData()->GetScalars();
+      output.ScalarsMTime = output.Scalars ? output.Scalars->GetMTime() : 0;
+      output.MTime = outData->GetMTime();
+      outData->GetExtent(output.Extent);
+      }
+    }
+  state->Inputs.resize(this->GetNumberOfInputPorts());
+  for (i = 0; i < this->GetNumberOfInputPorts(); ++i)
+    {
+    int numConnections = inputVector[i]->GetNumberOfInformationObjects();
+    state->Inputs[i].resize(numConnections);
+    for (int j = 0; j < numConnections; ++j)
+      {
+      vtkDataObject *input = inputVector[i]->GetInformationObject(j)->Get(
+        vtkDataObject::DATA_OBJECT());
+      state->Inputs[i][j].first = input;
+      state->Inputs[i][j].second = input ? input->GetMTime() : 0;
+      }
+    }
+  state->ExecuteTime.Modified();
 
   // free up the arrays
   for (i = 0; i < this->GetNumberOfInputPorts(); ++i)
@@ -313,6 +564,120 @@ int vtkThreadedImageAlgorithm::RequestData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkThreadedImageAlgorithm::ComputeIncrementalExtent(
+  vtkInformation* request,
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector,
+  vtkDataArray** previousScalars,
+  int extent[6])
+{
+  vtkThreadedImageAlgorithmIncrementalState *state = this->IncrementalState;
+  int i, j;
+
+  // the algorithm must not have changed since its last execution
+  int numOutputs = this->GetNumberOfOutputPorts();
+  int numInputs = this->GetNumberOfInputPorts();
+  if (numOutputs == 0 ||
+      static_cast<int>(state->Outputs.size()) != numOutputs ||
+      static_cast<int>(state->Inputs.size()) != numInputs ||
+      this->GetMTime() > state->ExecuteTime.GetMTime())
+    {
+    return 0;
+    }
+
+  // the outputs must still hold the results of the last execution
+  for (i = 0; i < numOutputs; ++i)
+    {
+    vtkImageData *outData = vtkImageData::SafeDownCast(
+      outputVector->GetInformationObject(i)->Get(
+        vtkDataObject::DATA_OBJECT()));
+    if (!outData)
+      {
+      continue;
+      }
+    int *outExt = outData->GetExtent();
+    int *lastExt = state->Outputs[i].Extent;
+    if (!previousScalars[i] ||
+        previousScalars[i] != outData->GetPointData()->GetScalars() ||
+        outExt[0] != lastExt[0] || outExt[1] != lastExt[1] ||
+        outExt[2] != lastExt[2] || outExt[3] != lastExt[3] ||
+        outExt[4] != lastExt[4] || outExt[5] != lastExt[5])
+      {
+      return 0;
+      }
+    }
+
+  // the inputs must be the same, and only changed within known extents
+  int modifiedExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  for (i = 0; i < numInputs; ++i)
+    {
+    int numConnections = inputVector[i]->GetNumberOfInformationObjects();
+    if (static_cast<int>(state->Inputs[i].size()) != numConnections)
+      {
+      return 0;
+      }
+    for (j = 0; j < numConnections; ++j)
+      {
+      vtkDataObject *input = inputVector[i]->GetInformationObject(j)->Get(
+        vtkDataObject::DATA_OBJECT());
+      if (!input || input != state->Inputs[i][j].first)
+        {
+        return 0;
+        }
+      unsigned long lastMTime = state->Inputs[i][j].second;
+      if (input->GetMTime() == lastMTime)
+        {
+        continue;
+        }
+      vtkImageData *image = vtkImageData::SafeDownCast(input);
+      int inExt[6], outExt[6];
+      if (!image || !image->GetModifiedExtent(lastMTime, inExt))
+        {
+        return 0;
+        }
+      if (vtkThreadedImageAlgorithmIsEmpty(inExt))
+        {
+        continue;
+        }
+      if (!this->ComputeModifiedOutputExtent(i, j, inExt, outExt))
+        {
+        return 0;
+        }
+      vtkThreadedImageAlgorithmMergeExtent(modifiedExtent, outExt);
+      }
+    }
+
+  // only the update extent of the requesting output is computed
+  int outputPort = request->Get(vtkDemandDrivenPipeline::FROM_OUTPUT_PORT());
+  if (outputPort < 0 || outputPort >= numOutputs)
+    {
+    return 0;
+    }
+  int updateExtent[6];
+  outputVector->GetInformationObject(outputPort)->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), updateExtent);
+  for (i = 0; i < 3; ++i)
+    {
+    extent[2*i] = modifiedExtent[2*i] > updateExtent[2*i] ?
+      modifiedExtent[2*i] : updateExtent[2*i];
+    extent[2*i+1] = modifiedExtent[2*i+1] < updateExtent[2*i+1] ?
+      modifiedExtent[2*i+1] : updateExtent[2*i+1];
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadedImageAlgorithm::ComputeModifiedOutputExtent(
+  int vtkNotUsed(inputPort),
+  int vtkNotUsed(connection),
+  int vtkNotUsed(inExt)[6],
+  int vtkNotUsed(outExt)[6])
+{
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 // The execute method created by the subclass.
 void vtkThreadedImageAlgorithm::ThreadedRequestData(
@@ -19,17 +19,39 @@
 // into smaller extents so that the vtkImageData limits are observed. It
 // also provides support for multithreading. If you don't need any of this
 // functionality, consider using vtkSimpleImageToImageAlgorithm instead.
+//
+// Subclasses that implement ComputeModifiedOutputExtent() execute
+// incrementally: when their inputs only changed within some extent
+// since the last execution (see vtkImageData::MarkModifiedExtent()) and
+// their outputs are still allocated, only the part of the outputs that
+// depends on that extent is recomputed, in place.  The outputs then
+// record the extent that changed, so that the algorithms downstream can
+// execute incrementally too.
+//
+// When EnableSMP is on, the extent to compute is divided into many small
+// bricks (see vtkExtentTranslator::ComputeBricks()) that the persistent
+// thread pool of vtkSMPTools executes with dynamic load balancing,
+// instead of one slab per thread on threads created for each execution.
+// The threadId given to ThreadedRequestData() is then the index of the
+// pool thread, which executes several bricks, and NumberOfThreads is
+// ignored, and so is SplitExtent().  Subclasses that reset per-thread
+// results at each call or that index them up to NumberOfThreads, like
+// vtkImageDifference, and subclasses that override SplitExtent(), like
+// vtkImageFFT, turn EnableSMP off in their constructor.
 // .SECTION See also
-// vtkSimpleImageToImageAlgorithm
+// vtkSimpleImageToImageAlgorithm vtkSMPTools
 
 #ifndef __vtkThreadedImageAlgorithm_h
 #define __vtkThreadedImageAlgorithm_h
 
 #include "vtkCommonExecutionModelModule.h" // For export macro
 #include "vtkImageAlgorithm.h"
+#include "vtkExtentTranslator.h" // For the split modes
 
+class vtkDataArray;
 class vtkImageData;
 class vtkMultiThreader;
+class vtkThreadedImageAlgorithmIncrementalState;
 
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkThreadedImageAlgorithm : public vtkImageAlgorithm
 {
@@ -55,10 +77,73 @@ public:
                                int extent[6], int threadId);
 
   // Description:
-  // Get/Set the number of threads to create when rendering
+  // Get/Set the number of threads to create when rendering, when EnableSMP
+  // is off.
   vtkSetClampMacro( NumberOfThreads, int, 1, VTK_MAX_THREADS );
   vtkGetMacro( NumberOfThreads, int );
 
+  // Description:
+  // Enable/Disable execution on the vtkSMPTools thread pool, in bricks.
+  // It is initialized from the global default, which is off, except in
+  // the subclasses that do not support it.  The pool uses all its
+  // threads (see vtkSMPTools::Initialize()): NumberOfThreads only applies
+  // when EnableSMP is off.  The bricks cut the extent along every axis and
+  // SplitExtent() is not called, so subclasses that process whole rows
+  // along one axis per pass, and override SplitExtent() to keep that axis
+  // whole, must turn EnableSMP off.
+  vtkSetMacro(EnableSMP, int);
+  vtkGetMacro(EnableSMP, int);
+  vtkBooleanMacro(EnableSMP, int);
+
+  // Description:
+  // Set/Get the default value of EnableSMP for new algorithms.  Subclasses
+  // that do not support EnableSMP keep it off regardless.
+  static void SetGlobalDefaultEnableSMP(int enable);
+  static int GetGlobalDefaultEnableSMP();
+
+  // Description:
+  // Set/Get the smallest size of a brick along each axis, in voxels,
+  // when EnableSMP is on.  The default is 16 voxels along x and 1 along
+  // the other axes, so that the rows of the bricks stay long enough
+  // to be processed efficiently.
+  vtkSetVector3Macro(MinimumPieceSize, int);
+  vtkGetVector3Macro(MinimumPieceSize, int);
+
+  // Description:
+  // Set/Get the size of the output scalars of a brick, in bytes, when
+  // EnableSMP is on.  The default, 65536, lets the input and output of
+  // a brick stay in cache.  Bricks of at least 1 voxel are made.
+  vtkSetClampMacro(DesiredBytesPerPiece, vtkIdType, 1, VTK_LARGE_ID);
+  vtkGetMacro(DesiredBytesPerPiece, vtkIdType);
+
+  // Description:
+  // Set/Get how the extent is divided into bricks when EnableSMP is on:
+  // into cubic blocks (the default) or into slabs normal to an axis.
+  // See vtkExtentTranslator::ComputeBricks().
+  vtkSetClampMacro(SplitMode, int, vtkExtentTranslator::X_SLAB_MODE,
+                   vtkExtentTranslator::BLOCK_MODE);
+  vtkGetMacro(SplitMode, int);
+  void SetSplitModeToBlock()
+    {this->SetSplitMode(vtkExtentTranslator::BLOCK_MODE);}
+  void SetSplitModeToXSlab()
+    {this->SetSplitMode(vtkExtentTranslator::X_SLAB_MODE);}
+  void SetSplitModeToYSlab()
+    {this->SetSplitMode(vtkExtentTranslator::Y_SLAB_MODE);}
+  void SetSplitModeToZSlab()
+    {this->SetSplitMode(vtkExtentTranslator::Z_SLAB_MODE);}
+
+  // Description:
+  // Get the number of bricks of the last execution with EnableSMP on.
+  vtkGetMacro(NumberOfPieces, int);
+
+  // Description:
+  // Compute the extent of the output that depends on the given extent of
+  // an input connection, for incremental execution, and return 1.
+  // Return 0, the default, when the algorithm cannot tell: it then
+  // recomputes its whole update extent whenever an input changes.
+  virtual int ComputeModifiedOutputExtent(int inputPort, int connection,
+                                          int inExt[6], int outExt[6]);
+
   // Description:
   // Putting this here until I merge graphics and imaging streaming.
   virtual int SplitExtent(int splitExt[6], int startExt[6],
@@ -71,6 +156,14 @@ protected:
   vtkMultiThreader *Threader;
   int NumberOfThreads;
 
+  int EnableSMP;
+  int MinimumPieceSize[3];
+  vtkIdType DesiredBytesPerPiece;
+  int SplitMode;
+  int NumberOfPieces;
+
+  static int GlobalDefaultEnableSMP;
+
   // Description:
   // This is called by the superclass.
   // This is the method you should override.
@@ -78,7 +171,20 @@ protected:
                           vtkInformationVector** inputVector,
                           vtkInformationVector* outputVector);
 
+  // Description:
+  // Compute the extent of the outputs to recompute when the inputs only
+  // changed within some extent since the last execution, and return 1.
+  // Return 0 if the whole update extent must be recomputed.  The
+  // scalars of the outputs before their allocation are given.
+  int ComputeIncrementalExtent(vtkInformation* request,
+                               vtkInformationVector** inputVector,
+                               vtkInformationVector* outputVector,
+                               vtkDataArray** previousScalars,
+                               int extent[6]);
+
 private:
+  vtkThreadedImageAlgorithmIncrementalState* IncrementalState;
+
   vtkThreadedImageAlgorithm(const vtkThreadedImageAlgorithm&);  // Not implemented.
   void operator=(const vtkThreadedImageAlgorithm&);  // Not implemented.
 };
@@ -41,11 +41,7 @@
 #include "vtkInformationExecutivePortVectorKey.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationObjectBaseKey.h"
-#include "vtkInformationVector.h"
-#include "vtkMultiThreader.h"
-#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
-#include "vtkThreadMessager.h"
 #include "vtkTimerLog.h"
 #include <vtksys/hash_set.hxx>
 
@@ -77,6 +73,7 @@ vtkThreadedStreamingPipeline::vtkThreadedStreamingPipeline()
   this->ForceDataRequest = NULL;
   this->Resources = NULL;
   this->Scheduler = NULL;
+  this->InputsUpToDate = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -112,36 +109,79 @@ void vtkThreadedStreamingPipeline::SetMultiThreadedEnabled(bool enabled)
   MultiThreadedEnabled = enabled;
 }
 
+//----------------------------------------------------------------------------
+bool vtkThreadedStreamingPipeline::GetMultiThreadedEnabled()
+{
+  return MultiThreadedEnabled;
+}
+
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::SetAutoPropagatePush(bool enabled)
 {
   AutoPropagatePush = enabled;
 }
 
+//----------------------------------------------------------------------------
+// Send the requests that precede REQUEST_DATA, as Update() does.
+static void vtkThreadedStreamingPipelinePrepareUpdate(vtkExecutive *exec)
+{
+  if (!exec->UpdateInformation())
+    {
+    return;
+    }
+  vtkStreamingDemandDrivenPipeline *sddp =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(exec);
+  if (!sddp)
+    {
+    return;
+    }
+  int numberOfPorts = exec->GetNumberOfOutputPorts();
+  for (int port = (numberOfPorts > 0 ? 0 : -1); port < numberOfPorts; ++port)
+    {
+    sddp->PropagateTime(port);
+    sddp->UpdateTimeDependentInformation(port);
+    sddp->PropagateUpdateExtent(port);
+    if (port < 0)
+      {
+      break;
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 static void
-CollectUpstreamModules(vtkExecutive *exec, vtkExecutiveSet &eSet)
+vtkThreadedStreamingPipelineCollectDownstreamModules(vtkExecutive *exec,
+                                                     vtkExecutiveSet &eSet)
 {
-  for(int i = 0; i < exec->GetNumberOfInputPorts(); ++i)
+  for(int i = 0; i < exec->GetNumberOfOutputPorts(); ++i)
     {
-    int nic = exec->GetAlgorithm()->GetNumberOfInputConnections(i);
-    vtkInformationVector* inVector = exec->GetInputInformation()[i];
-    for(int j = 0; j < nic; ++j)
+    vtkInformation* outInfo = exec->GetOutputInformation(i);
+    int consumerCount = vtkExecutive::CONSUMERS()->Length(outInfo);
+    vtkExecutive** e = vtkExecutive::CONSUMERS()->GetExecutives(outInfo);
+    for (int j = 0; j < consumerCount; j++)
       {
-      vtkInformation* inInfo = inVector->GetInformationObject(j);
-      vtkExecutive* e;
-      int producerPort;
-      vtkExecutive::PRODUCER()->Get(inInfo, e, producerPort);
-      if (eSet.find(e)!=eSet.end())
+      if (e[j] && eSet.find(e[j]) == eSet.end())
         {
-        continue;
+        eSet.insert(e[j]);
+        vtkThreadedStreamingPipelineCollectDownstreamModules(e[j], eSet);
         }
-      eSet.insert(e);
-      CollectUpstreamModules(e, eSet);
       }
     }
 }
 
+//----------------------------------------------------------------------------
+static bool vtkThreadedStreamingPipelineHasConsumers(vtkExecutive *exec)
+{
+  for(int i = 0; i < exec->GetNumberOfOutputPorts(); ++i)
+    {
+    if (vtkExecutive::CONSUMERS()->Length(exec->GetOutputInformation(i)) > 0)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::Pull(vtkExecutive *exec)
 {
@@ -166,21 +206,13 @@ void vtkThreadedStreamingPipeline::Pull(vtkExecutiveCollection *execs)
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::Pull(vtkExecutiveCollection *execs, vtkInformation *info)
 {
-  vtkExecutiveSet eSet;
   execs->InitTraversal();
   for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
     {
-    eSet.insert(e);
-    CollectUpstreamModules(e, eSet);
-    }
-  vtkExecutiveCollection *collectedExecs = vtkExecutiveCollection::New();
-  for (vtkExecutiveSet::iterator ti = eSet.begin(); ti != eSet.end(); ti++)
-    {
-    collectedExecs->AddItem(*ti);
+    e->GetAlgorithm()->GetInformation()->Set(EXTRA_INFORMATION(), info);
+    vtkThreadedStreamingPipelinePrepareUpdate(e);
     }
-  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(collectedExecs, info);
-  vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilDone(collectedExecs);
-  collectedExecs->Delete();
+  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs);
 }
 
 //----------------------------------------------------------------------------
@@ -214,18 +246,33 @@ void vtkThreadedStreamingPipeline::Push(vtkExecutiveCollection *execs, vtkInform
     eSet.insert(e);
     e->GetAlgorithm()->GetInformation()->Set(EXTRA_INFORMATION(), info);
     }
-  if (AutoPropagatePush)
+  if (!AutoPropagatePush)
+    {
+    for (vtkExecutiveSet::iterator ti = eSet.begin(); ti != eSet.end(); ti++)
+      {
+      vtkThreadedStreamingPipelinePrepareUpdate(*ti);
+      }
+    vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs);
+    return;
+    }
+
+  // Update everything downstream. The sinks request their inputs.
+  execs->InitTraversal();
+  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
     {
-    if (info==NULL)
+    vtkThreadedStreamingPipelineCollectDownstreamModules(e, eSet);
+    }
+  vtkExecutiveCollection *sinks = vtkExecutiveCollection::New();
+  for (vtkExecutiveSet::iterator ti = eSet.begin(); ti != eSet.end(); ti++)
+    {
+    if (!vtkThreadedStreamingPipelineHasConsumers(*ti))
       {
-      info = vtkInformation::New();
+      vtkThreadedStreamingPipelinePrepareUpdate(*ti);
+      sinks->AddItem(*ti);
       }
-    info->Set(vtkThreadedStreamingPipeline::AUTO_PROPAGATE(), 1);
     }
-  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
-  fprintf(stderr, "OK 2 %d\n", execs->GetNumberOfItems());
-  vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilReleased(execs);
-  fprintf(stderr, "OK 3\n");
+  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(sinks);
+  sinks->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -237,18 +284,9 @@ void vtkThreadedStreamingPipeline::Pull()
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::Pull(vtkInformation *info)
 {
-  vtkExecutiveSet eSet;
-  CollectUpstreamModules(this, eSet);
-  vtkExecutiveCollection *execs = vtkExecutiveCollection::New();
-  for (vtkExecutiveSet::iterator ti = eSet.begin(); ti != eSet.end(); ti++)
-    {
-    execs->AddItem(*ti);
-    }
-  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
-  vtkExecutionScheduler::GetGlobalScheduler()->ReleaseResources(this);
-  vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilDone(execs);
-  vtkExecutionScheduler::GetGlobalScheduler()->ReacquireResources(this);
-  execs->Delete();
+  this->GetAlgorithm()->GetInformation()->Set(EXTRA_INFORMATION(), info);
+  vtkThreadedStreamingPipelinePrepareUpdate(this);
+  vtkExecutionScheduler::GetGlobalScheduler()->ScheduleUpstream(this);
 }
 
 //----------------------------------------------------------------------------
@@ -268,7 +306,6 @@ void vtkThreadedStreamingPipeline::Push(vtkInformation *info)
     for (int j=0; j<consumerCount; j++)
       {
       eSet.insert(e[j]);
-      e[j]->GetAlgorithm()->GetInformation()->Set(EXTRA_INFORMATION(), info);
       }
   }
   vtkExecutiveCollection *execs = vtkExecutiveCollection::New();
@@ -278,29 +315,20 @@ void vtkThreadedStreamingPipeline::Push(vtkInformation *info)
     }
   if (AutoPropagatePush)
     {
+    execs->InitTraversal();
+    for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
+      {
+      e->GetAlgorithm()->GetInformation()->Set(EXTRA_INFORMATION(), info);
+      }
     vtkExecutionScheduler::GetGlobalScheduler()->SchedulePropagate(execs, info);
     }
   else
     {
-    vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
-    vtkExecutionScheduler::GetGlobalScheduler()->ReleaseResources(this);
-    vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilReleased(execs);
-    vtkExecutionScheduler::GetGlobalScheduler()->ReacquireResources(this);
+    vtkThreadedStreamingPipeline::Push(execs, info);
     }
   execs->Delete();
 }
 
-//----------------------------------------------------------------------------
-void vtkThreadedStreamingPipeline::ReleaseInputs()
-{
-  vtkThreadMessager *messager = vtkExecutionScheduler::
-    GetGlobalScheduler()->GetInputsReleasedMessager(this);
-  if (messager)
-    {
-    messager->SendWakeMessage();
-    }
-}
-
 //----------------------------------------------------------------------------
 int vtkThreadedStreamingPipeline
 ::ProcessRequest(vtkInformation* request,
@@ -350,6 +378,15 @@ int vtkThreadedStreamingPipeline::ForceUpdateData(int vtkNotUsed(processingUnit)
   return result;
 }
 
+//----------------------------------------------------------------------------
+int vtkThreadedStreamingPipeline::UpdateDataFromInputs(int outputPort)
+{
+  this->InputsUpToDate = 1;
+  int result = this->UpdateData(outputPort);
+  this->InputsUpToDate = 0;
+  return result;
+}
+
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::UpdateRequestDataTimeFromSource()
 {
@@ -388,11 +425,14 @@ vtkComputingResources *vtkThreadedStreamingPipeline::GetResources() {
 //----------------------------------------------------------------------------
 int vtkThreadedStreamingPipeline::ForwardUpstream(vtkInformation* request)
 {
-  if (MultiThreadedEnabled && request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  if (this->InputsUpToDate && request->Has(REQUEST_DATA()))
     {
-    this->Pull();
     return 1;
     }
+  if (MultiThreadedEnabled && request->Has(REQUEST_DATA()))
+    {
+    return vtkExecutionScheduler::GetGlobalScheduler()->ScheduleUpstream(this);
+    }
   else
     {
     return this->Superclass::ForwardUpstream(request);
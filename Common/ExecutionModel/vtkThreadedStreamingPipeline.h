@@ -29,8 +29,14 @@
   -------------------------------------------------------------------------*/
 // .NAME vtkThreadedStreamingPipeline - Executive supporting multi-threads
 // .SECTION Description
-// vtkThreadeStreamingDemandDrivenPipeline is an executive that supports
-// updating input ports based on the number of threads available.
+// vtkThreadedStreamingPipeline is an executive that can update its
+// inputs concurrently.  When multi-threading is enabled with
+// SetMultiThreadedEnabled(), REQUEST_DATA is not forwarded upstream
+// input by input: vtkExecutionScheduler executes the whole network
+// upstream as a graph of tasks, and independent branches execute at the
+// same time on the vtkSMPTools thread pool.  For this to happen, the
+// algorithms with inputs upstream must use this executive too, e.g. by
+// setting it as the default executive prototype of vtkAlgorithm.
 
 // .SECTION See Also
 // vtkExecutionScheduler
@@ -76,6 +82,7 @@ public:
   // Description:
   // Enable/Disable Multi-Threaded updating mechanism
   static void SetMultiThreadedEnabled(bool enabled);
+  static bool GetMultiThreadedEnabled();
 
   // Description:
   // Enable/Disable automatic propagation of Push events
@@ -133,10 +140,6 @@ public:
   // Triggers downstream modules to update but not including itself
   void Push(vtkInformation *info);
 
-  // Description:
-  // Release all the locks for input ports living upstream
-  void ReleaseInputs();
-
   // Description:
   // Generalized interface for asking the executive to fulfill update
   // requests.
@@ -148,6 +151,12 @@ public:
   // Send a direct REQUEST_DATA (on all ports) to this executive
   int ForceUpdateData(int processingUnit, vtkInformation *info);
 
+  // Description:
+  // Bring the output on the given port up to date, assuming that the
+  // inputs already are: REQUEST_DATA is not forwarded upstream.  This is
+  // what vtkExecutionScheduler executes for each task.
+  int UpdateDataFromInputs(int outputPort);
+
   // Description:
   // Update the LastDataRequestTimeFromSource using its upstream time
   void UpdateRequestDataTimeFromSource();
@@ -169,6 +178,9 @@ protected:
   virtual int ForwardUpstream(vtkInformation* request);
   virtual int ForwardUpstream(int i, int j, vtkInformation* request);
 
+  // Set while the inputs are known to be up to date.
+  int InputsUpToDate;
+
 private:
   vtkThreadedStreamingPipeline(const vtkThreadedStreamingPipeline&);  // Not implemented.
   void operator=(const vtkThreadedStreamingPipeline&);  // Not implemented.
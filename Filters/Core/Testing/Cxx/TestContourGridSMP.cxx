@@ -0,0 +1,188 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestContourGridSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the parallel contouring of tetrahedra by vtkContourGrid
+// .SECTION Description
+// Contours the tetrahedra of the wavelet serially and with EnableSMP, with
+// the cells in the legacy and in the offsets layout, and checks that the
+// outputs are identical.  Then checks values that cross the same edges,
+// that are equal, or that pass through the points.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkContourFilter.h"
+#include "vtkContourGrid.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkIdFilter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkUnstructuredGrid.h"
+
+//------------------------------------------------------------------------------
+static bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    for (int j = 0; j < a->GetNumberOfComponents(); ++j)
+      {
+      if (a->GetComponent(i, j) != b->GetComponent(i, j))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static bool SameOutputs(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfPolys() != b->GetNumberOfPolys() ||
+      !SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()) ||
+      !SameArrays(a->GetPolys()->GetData(), b->GetPolys()->GetData()) ||
+      a->GetPointData()->GetNumberOfArrays() !=
+      b->GetPointData()->GetNumberOfArrays())
+    {
+    return false;
+    }
+  for (int i = 0; i < a->GetPointData()->GetNumberOfArrays(); ++i)
+    {
+    if (!SameArrays(a->GetPointData()->GetArray(i),
+                    b->GetPointData()->GetArray(i)))
+      {
+      return false;
+      }
+    }
+  return SameArrays(a->GetCellData()->GetArray("Ids"),
+                    b->GetCellData()->GetArray("Ids"));
+}
+
+//------------------------------------------------------------------------------
+int TestContourGridSMP(int, char*[])
+{
+  // Tetrahedra with the wavelet scalars, and point and cell ids.
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(0, 39, 0, 39, 0, 39);
+  vtkNew<vtkDataSetTriangleFilter> tetras;
+  tetras->SetInputConnection(wavelet->GetOutputPort());
+  vtkNew<vtkIdFilter> ids;
+  ids->SetInputConnection(tetras->GetOutputPort());
+  ids->FieldDataOn();
+  ids->SetIdsArrayName("Ids");
+  ids->Update();
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->DeepCopy(ids->GetOutput());
+
+  vtkNew<vtkContourGrid> serial;
+  serial->SetInputData(grid.GetPointer());
+  serial->SetValue(0, 80.0);
+  serial->SetValue(1, 150.0);
+  serial->SetValue(2, 220.0);
+  serial->Update();
+
+  vtkNew<vtkContourGrid> smp;
+  smp->SetInputData(grid.GetPointer());
+  smp->SetValue(0, 80.0);
+  smp->SetValue(1, 150.0);
+  smp->SetValue(2, 220.0);
+  smp->EnableSMPOn();
+  smp->Update();
+
+  vtkPolyData* expected = serial->GetOutput();
+  if (expected->GetNumberOfPolys() <= 1000)
+    {
+    cerr << "Empty contour" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!SameOutputs(expected, smp->GetOutput()))
+    {
+    cerr << "Parallel output differs from serial output" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Cells in the offsets layout, with 32 bit storage.
+  grid->GetCells()->ConvertToOffsetsLayout(true);
+  grid->Modified();
+  smp->Update();
+  if (!SameOutputs(expected, smp->GetOutput()))
+    {
+    cerr << "Wrong output with the offsets layout" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Through vtkContourFilter, without scalars.
+  vtkNew<vtkContourFilter> contour;
+  contour->SetInputData(grid.GetPointer());
+  contour->SetValue(0, 150.0);
+  contour->ComputeScalarsOff();
+  contour->ComputeNormalsOff();
+  contour->Update();
+  vtkNew<vtkPolyData> serialContour;
+  serialContour->DeepCopy(contour->GetOutput());
+  contour->EnableSMPOn();
+  contour->Update();
+  if (serialContour->GetNumberOfPolys() <= 0 ||
+      contour->GetOutput()->GetPointData()->GetScalars() ||
+      !SameOutputs(serialContour.GetPointer(), contour->GetOutput()))
+    {
+    cerr << "Wrong vtkContourFilter output" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Several values on each edge along x, a duplicate value and a value on
+  // the points of the grid.
+  wavelet->SetWholeExtent(0, 9, 0, 9, 0, 9);
+  ids->Update();
+  vtkNew<vtkUnstructuredGrid> ramp;
+  ramp->DeepCopy(ids->GetOutput());
+  vtkDataArray* rampScalars = ramp->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < ramp->GetNumberOfPoints(); ++i)
+    {
+    rampScalars->SetTuple1(i, ramp->GetPoint(i)[0]);
+    }
+  double values[6] = { 2.25, 2.5, 2.75, 2.5, 6.0, 7.5 };
+  for (int i = 0; i < 6; ++i)
+    {
+    serial->SetValue(i, values[i]);
+    smp->SetValue(i, values[i]);
+    }
+  serial->SetInputData(ramp.GetPointer());
+  smp->SetInputData(ramp.GetPointer());
+  serial->Update();
+  smp->Update();
+  expected = serial->GetOutput();
+  if (expected->GetNumberOfPolys() <= 1000 ||
+      smp->GetOutput()->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+      smp->GetOutput()->GetNumberOfPolys() != expected->GetNumberOfPolys())
+    {
+    cerr << "Wrong number of points or triangles on shared edges" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!SameOutputs(expected, smp->GetOutput()))
+    {
+    cerr << "Wrong output with values on shared edges" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,379 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEdgePointLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the merging of points by edge with vtkEdgePointLocator
+// .SECTION Description
+// Checks the merging rules and the location methods of vtkEdgePointLocator,
+// then cuts the tetrahedra of the wavelet, clips the hexahedra of a
+// structured grid and a triangle mesh with vtkCutter, vtkClipDataSet and
+// vtkClipPolyData, and checks that the outputs are the same with
+// vtkMergePoints and with vtkEdgePointLocator.
+
+#include "vtkCellArray.h"
+#include "vtkClipDataSet.h"
+#include "vtkClipPolyData.h"
+#include "vtkCutter.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkEdgePointLocator.h"
+#include "vtkIdList.h"
+#include "vtkImageDataToPointSet.h"
+#include "vtkMath.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSphere.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <math.h>
+
+//------------------------------------------------------------------------------
+// Whether two outputs have the same points, up to round-off, and the same
+// cells.
+static bool SameOutputs(vtkPointSet* a, vtkPointSet* b,
+                        vtkCellArray* ca, vtkCellArray* cb)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      ca->GetNumberOfCells() != cb->GetNumberOfCells() ||
+      ca->GetNumberOfConnectivityEntries() !=
+      cb->GetNumberOfConnectivityEntries())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+    {
+    double x[3], y[3];
+    a->GetPoint(i, x);
+    b->GetPoint(i, y);
+    for (int j = 0; j < 3; ++j)
+      {
+      if (fabs(x[j] - y[j]) > 1.0e-9)
+        {
+        return false;
+        }
+      }
+    }
+  vtkIdType npts, *pts, npts2, *pts2;
+  ca->InitTraversal();
+  cb->InitTraversal();
+  while (ca->GetNextCell(npts, pts) && cb->GetNextCell(npts2, pts2))
+    {
+    if (npts != npts2)
+      {
+      return false;
+      }
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      if (pts[i] != pts2[i])
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static int TestMergingRules()
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkEdgePointLocator> locator;
+  double bounds[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  if (!locator->InitPointInsertion(points.GetPointer(), bounds, 10))
+    {
+    cerr << "Point insertion not initialized" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The same point of an edge, seen from both of its ends with round-off.
+  vtkIdType id, id2;
+  double x[3] = { 1.0, 2.0, 3.0 };
+  double x2[3] = { 1.0 + 1.0e-14, 2.0, 3.0 - 1.0e-14 };
+  if (locator->InsertUniqueEdgePoint(3, 7, 0.25, x, id) != 1 || id != 0)
+    {
+    cerr << "Edge point not inserted" << endl;
+    return EXIT_FAILURE;
+    }
+  if (locator->InsertUniqueEdgePoint(7, 3, 0.75 + 1.0e-15, x2, id2) != 0 ||
+      id2 != id)
+    {
+    cerr << "Edge point not merged" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Another point of the edge, and a point of another edge next to it.
+  double y[3] = { 1.0, 2.0, 3.5 };
+  if (locator->InsertUniqueEdgePoint(3, 7, 0.5, y, id2) != 1 || id2 != 1)
+    {
+    cerr << "Points of an edge merged" << endl;
+    return EXIT_FAILURE;
+    }
+  if (locator->InsertUniqueEdgePoint(3, 8, 0.25, x2, id2) != 1 || id2 != 2)
+    {
+    cerr << "Close points of different edges merged" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Ids of sub-cells numbered apart from the dataset.
+  double z[3] = { 5.0, 2.0, 3.0 };
+  if (locator->InsertUniqueEdgePoint(3, 7, 0.25, z, id2) != 1 || id2 != 3)
+    {
+    cerr << "Distant points of an edge merged" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // End points are merged with the points of the same coordinates.
+  double p[3] = { 4.0, 4.0, 4.0 };
+  if (locator->InsertUniquePoint(p, id) != 1 || id != 4)
+    {
+    cerr << "Point not inserted" << endl;
+    return EXIT_FAILURE;
+    }
+  if (locator->InsertUniqueEdgePoint(9, 10, 0.0, p, id2) != 0 || id2 != id)
+    {
+    cerr << "End point not merged" << endl;
+    return EXIT_FAILURE;
+    }
+  if (locator->InsertUniqueEdgePoint(10, 9, 1.0, p, id2) != 0 || id2 != id ||
+      locator->IsInsertedPoint(p) != id)
+    {
+    cerr << "End point not merged" << endl;
+    return EXIT_FAILURE;
+    }
+  if (points->GetNumberOfPoints() != 5)
+    {
+    cerr << "Wrong number of points" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Many points, to grow the hash tables.
+  for (int i = 0; i < 10000; ++i)
+    {
+    double q[3] = { static_cast<double>(i), 0.5, -1.0 };
+    locator->InsertUniqueEdgePoint(i, i + 1, 0.5, q, id);
+    }
+  for (int i = 0; i < 10000; ++i)
+    {
+    double q[3] = { static_cast<double>(i), 0.5, -1.0 };
+    if (locator->InsertUniqueEdgePoint(i + 1, i, 0.5, q, id) != 0 ||
+        id != 5 + i || locator->IsInsertedPoint(q) != id)
+      {
+      cerr << "Point lost after growing the tables" << endl;
+      return EXIT_FAILURE;
+      }
+    }
+  if (locator->FindClosestPoint(p) != 4)
+    {
+    cerr << "Wrong closest point" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // -0 and 0 are the same coordinate.
+  double zero[3] = { 0.0, -0.0, 0.0 };
+  double negativeZero[3] = { -0.0, 0.0, -0.0 };
+  if (locator->InsertUniquePoint(zero, id) != 1 ||
+      locator->IsInsertedPoint(negativeZero) != id)
+    {
+    cerr << "-0 not merged with 0" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+// Checks that the location methods give the same results when they search
+// the bins of the inserted points and when they search all the points.
+static int TestLocationMethods()
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkPoints> binnedPoints;
+  vtkNew<vtkEdgePointLocator> locator;
+  vtkNew<vtkEdgePointLocator> binnedLocator;
+  double bounds[6] = { 0.0, 10.0, 0.0, 10.0, 0.0, 1.0 };
+  locator->InitPointInsertion(points.GetPointer(), NULL);
+  binnedLocator->InitPointInsertion(binnedPoints.GetPointer(), bounds, 500);
+
+  // Some of the points lie out of the bounds.
+  for (int i = 0; i < 2000; ++i)
+    {
+    double x[3] = { 12.0 * fmod(0.618034 * i, 1.0) - 1.0,
+                    12.0 * fmod(0.754878 * i, 1.0) - 1.0,
+                    fmod(0.569840 * i, 1.0) };
+    locator->InsertNextPoint(x);
+    binnedLocator->InsertNextPoint(x);
+    }
+
+  vtkNew<vtkIdList> ids;
+  vtkNew<vtkIdList> binnedIds;
+  for (int i = 0; i < 200; ++i)
+    {
+    double x[3] = { 30.0 * fmod(0.3183 * i, 1.0) - 10.0,
+                    30.0 * fmod(0.4142 * i, 1.0) - 10.0,
+                    3.0 * fmod(0.7071 * i, 1.0) - 1.0 };
+    if (locator->FindClosestPoint(x) != binnedLocator->FindClosestPoint(x))
+      {
+      cerr << "Wrong closest point" << endl;
+      return EXIT_FAILURE;
+      }
+
+    double dist2, binnedDist2;
+    if (locator->FindClosestPointWithinRadius(0.5, x, dist2) !=
+        binnedLocator->FindClosestPointWithinRadius(0.5, x, binnedDist2))
+      {
+      cerr << "Wrong closest point within radius" << endl;
+      return EXIT_FAILURE;
+      }
+
+    locator->FindClosestNPoints(7, x, ids.GetPointer());
+    binnedLocator->FindClosestNPoints(7, x, binnedIds.GetPointer());
+    if (ids->GetNumberOfIds() != 7 || binnedIds->GetNumberOfIds() != 7)
+      {
+      cerr << "Wrong number of points" << endl;
+      return EXIT_FAILURE;
+      }
+    double y[3], binnedY[3];
+    for (vtkIdType j = 0; j < 7; ++j)
+      {
+      points->GetPoint(ids->GetId(j), y);
+      points->GetPoint(binnedIds->GetId(j), binnedY);
+      if (vtkMath::Distance2BetweenPoints(x, y) !=
+          vtkMath::Distance2BetweenPoints(x, binnedY))
+        {
+        cerr << "Wrong closest N points" << endl;
+        return EXIT_FAILURE;
+        }
+      }
+
+    locator->FindPointsWithinRadius(1.5, x, ids.GetPointer());
+    binnedLocator->FindPointsWithinRadius(1.5, x, binnedIds.GetPointer());
+    if (ids->GetNumberOfIds() != binnedIds->GetNumberOfIds())
+      {
+      cerr << "Wrong number of points within radius" << endl;
+      return EXIT_FAILURE;
+      }
+    for (vtkIdType j = 0; j < ids->GetNumberOfIds(); ++j)
+      {
+      if (ids->GetId(j) != binnedIds->GetId(j))
+        {
+        cerr << "Wrong points within radius" << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+int TestEdgePointLocator(int, char*[])
+{
+  if (TestMergingRules() != EXIT_SUCCESS ||
+      TestLocationMethods() != EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Tetrahedra of the wavelet, and hexahedra of a structured grid.
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(0, 49, 0, 49, 0, 49);
+  vtkNew<vtkDataSetTriangleFilter> tetras;
+  tetras->SetInputConnection(wavelet->GetOutputPort());
+  tetras->Update();
+  vtkNew<vtkRTAnalyticSource> image;
+  image->SetWholeExtent(0, 29, 0, 29, 0, 29);
+  vtkNew<vtkImageDataToPointSet> hexas;
+  hexas->SetInputConnection(image->GetOutputPort());
+  hexas->Update();
+
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(24.5, 24.5, 24.5);
+  plane->SetNormal(1.0, 2.0, 3.0);
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(14.5, 14.5, 14.5);
+  sphere->SetRadius(10.0);
+
+  // Cutting tetrahedra with several values.
+  vtkNew<vtkCutter> cutter;
+  cutter->SetInputConnection(tetras->GetOutputPort());
+  cutter->SetCutFunction(plane.GetPointer());
+  cutter->GenerateValues(5, -20.0, 20.0);
+  cutter->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(cutter->GetOutput());
+
+  cutter->SetLocator(vtkNew<vtkEdgePointLocator>().GetPointer());
+  cutter->Update();
+  if (expected->GetNumberOfPolys() <= 1000)
+    {
+    cerr << "Empty cut" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!SameOutputs(expected.GetPointer(), cutter->GetOutput(),
+                   expected->GetPolys(), cutter->GetOutput()->GetPolys()))
+    {
+    cerr << "Wrong cut with vtkEdgePointLocator" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Clipping hexahedra, clipped through tetrahedra of output points.
+  vtkNew<vtkClipDataSet> clip;
+  clip->SetInputConnection(hexas->GetOutputPort());
+  clip->SetClipFunction(sphere.GetPointer());
+  clip->SetLocator(vtkNew<vtkMergePoints>().GetPointer());
+  clip->Update();
+  vtkNew<vtkUnstructuredGrid> clipped;
+  clipped->DeepCopy(clip->GetOutput());
+
+  clip->SetLocator(vtkNew<vtkEdgePointLocator>().GetPointer());
+  clip->Update();
+  if (clipped->GetNumberOfCells() <= 1000)
+    {
+    cerr << "Empty clip" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!SameOutputs(clipped.GetPointer(), clip->GetOutput(),
+                   clipped->GetCells(), clip->GetOutput()->GetCells()))
+    {
+    cerr << "Wrong clip with vtkEdgePointLocator" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Clipping the triangles of the cut.
+  vtkNew<vtkClipPolyData> clipPolyData;
+  clipPolyData->SetInputData(expected.GetPointer());
+  clipPolyData->SetClipFunction(sphere.GetPointer());
+  clipPolyData->Update();
+  vtkNew<vtkPolyData> clippedPolyData;
+  clippedPolyData->DeepCopy(clipPolyData->GetOutput());
+  clipPolyData->SetLocator(vtkNew<vtkEdgePointLocator>().GetPointer());
+  clipPolyData->Update();
+  if (clippedPolyData->GetNumberOfPolys() <= 100)
+    {
+    cerr << "Empty clipped triangles" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!SameOutputs(clippedPolyData.GetPointer(), clipPolyData->GetOutput(),
+                   clippedPolyData->GetPolys(),
+                   clipPolyData->GetOutput()->GetPolys()))
+    {
+    cerr << "Wrong clipped triangles with vtkEdgePointLocator" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
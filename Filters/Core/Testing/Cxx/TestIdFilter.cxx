@@ -0,0 +1,78 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestIdFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that vtkIdFilter generates the same ids whether they are
+// stored or implicit.
+
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <vtkIdFilter.h>
+#include <vtkIdTypeArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+
+#include <iostream>
+
+static int CheckIds(vtkDataArray *ids, vtkIdType num, int implicitIds)
+{
+  if (!ids || ids->GetNumberOfTuples() != num ||
+      ids->GetDataTypeSize() != static_cast<int>(sizeof(vtkIdType)))
+    {
+    std::cerr << "Bad ids array." << std::endl;
+    return 0;
+    }
+  if ((vtkIdTypeArray::SafeDownCast(ids) != NULL) == (implicitIds != 0))
+    {
+    std::cerr << "Wrong ids array class: " << ids->GetClassName()
+              << std::endl;
+    return 0;
+    }
+  vtkIdType *values = static_cast<vtkIdType *>(ids->GetVoidPointer(0));
+  for (vtkIdType id = 0; id < num; id++)
+    {
+    if (ids->GetTuple1(id) != id || values[id] != id)
+      {
+      std::cerr << "Wrong id at " << id << std::endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+int TestIdFilter(int, char *[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(4, 3, 2);
+
+  for (int implicitIds = 0; implicitIds < 2; implicitIds++)
+    {
+    vtkNew<vtkIdFilter> filter;
+    filter->SetInputData(image.GetPointer());
+    filter->SetImplicitIds(implicitIds);
+    filter->Update();
+
+    vtkDataSet *output = filter->GetOutput();
+    if (!CheckIds(output->GetPointData()->GetScalars(),
+                  image->GetNumberOfPoints(), implicitIds) ||
+        !CheckIds(output->GetCellData()->GetScalars(),
+                  image->GetNumberOfCells(), implicitIds))
+      {
+      std::cerr << "Failed with ImplicitIds " << implicitIds << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
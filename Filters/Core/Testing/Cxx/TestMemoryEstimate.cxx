@@ -0,0 +1,217 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMemoryEstimate.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the memory estimate pass of the streaming pipeline
+// .SECTION Description
+// Estimates the memory used by an image source followed by a threshold
+// and a contour filter, without executing them, and compares the
+// estimates with the actual sizes of the outputs.  Also checks the
+// estimates of the two outputs of a clip filter.
+
+#include "vtkClipDataSet.h"
+#include "vtkContourFilter.h"
+#include "vtkDataArray.h"
+#include "vtkImageAlgorithm.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkThreshold.h"
+
+#include <math.h>
+
+const int SIZE = 64;
+
+//------------------------------------------------------------------------------
+// Produces a SIZE^3 image of float scalars whose value is the distance
+// to the center, and counts its executions.
+class vtkSphereImageSource : public vtkImageAlgorithm
+{
+public:
+  static vtkSphereImageSource* New();
+  vtkTypeMacro(vtkSphereImageSource, vtkImageAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  vtkSphereImageSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfExecutions = 0;
+    }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+    {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    int extent[6] = { 0, SIZE - 1, 0, SIZE - 1, 0, SIZE - 1 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_FLOAT, 1);
+    return 1;
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+    {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkImageData* output =
+      this->AllocateOutputData(vtkImageData::GetData(outInfo), outInfo);
+    output->GetPointData()->GetScalars()->SetName("Distance");
+    int* ext = output->GetExtent();
+    float* values = static_cast<float*>(output->GetScalarPointer());
+    for (int z = ext[4]; z <= ext[5]; ++z)
+      {
+      for (int y = ext[2]; y <= ext[3]; ++y)
+        {
+        for (int x = ext[0]; x <= ext[1]; ++x)
+          {
+          double c = 0.5 * (SIZE - 1);
+          *values++ = static_cast<float>(
+            sqrt((x - c) * (x - c) + (y - c) * (y - c) + (z - c) * (z - c)));
+          }
+        }
+      }
+    ++this->NumberOfExecutions;
+    return 1;
+    }
+
+private:
+  vtkSphereImageSource(const vtkSphereImageSource&);  // Not implemented.
+  void operator=(const vtkSphereImageSource&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkSphereImageSource);
+
+//------------------------------------------------------------------------------
+static unsigned long GetEstimate(vtkAlgorithm* algorithm)
+{
+  vtkInformation* outInfo = algorithm->GetOutputInformation(0);
+  return outInfo->Get(vtkStreamingDemandDrivenPipeline::ESTIMATED_MEMORY_SIZE());
+}
+
+//------------------------------------------------------------------------------
+// Whether an estimate is within a factor of the actual size.
+static bool IsClose(double estimate, double actual, double factor)
+{
+  return estimate <= factor * actual && actual <= factor * estimate;
+}
+
+//------------------------------------------------------------------------------
+int TestMemoryEstimate(int, char*[])
+{
+  vtkNew<vtkSphereImageSource> source;
+  vtkNew<vtkThreshold> threshold;
+  threshold->SetInputConnection(source->GetOutputPort());
+  threshold->ThresholdByLower(SIZE / 2);
+  vtkNew<vtkContourFilter> contour;
+  contour->SetInputConnection(threshold->GetOutputPort());
+  contour->SetValue(0, 3 * SIZE / 8);
+
+  // The size of an image is known from its meta-data.
+  unsigned long sourcePeak = source->EstimatePeakMemorySize();
+  if (sourcePeak != SIZE * SIZE * SIZE * sizeof(float) / 1024)
+    {
+    cerr << "Wrong image estimate: " << sourcePeak << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Downstream filters add their outputs, without executing.
+  unsigned long peak = contour->EstimatePeakMemorySize();
+  unsigned long thresholdEstimate = GetEstimate(threshold.GetPointer());
+  unsigned long contourEstimate = GetEstimate(contour.GetPointer());
+  if (source->NumberOfExecutions != 0)
+    {
+    cerr << "Pipeline executed" << endl;
+    return EXIT_FAILURE;
+    }
+  if (thresholdEstimate == 0 || contourEstimate == 0 ||
+      peak != sourcePeak + thresholdEstimate + contourEstimate)
+    {
+    cerr << "Wrong pipeline estimate: " << thresholdEstimate << " + "
+         << contourEstimate << ", peak " << peak << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Released inputs are not held while downstream filters execute.
+  source->GetOutputInformation(0)->Set(
+    vtkStreamingDemandDrivenPipeline::RELEASE_DATA(), 1);
+  unsigned long releasedPeak = contour->EstimatePeakMemorySize();
+  if (releasedPeak != (sourcePeak > contourEstimate ?
+                       sourcePeak : contourEstimate) + thresholdEstimate)
+    {
+    cerr << "Wrong estimate with released data: " << releasedPeak << endl;
+    return EXIT_FAILURE;
+    }
+  source->GetOutputInformation(0)->Set(
+    vtkStreamingDemandDrivenPipeline::RELEASE_DATA(), 0);
+
+  // The estimates are of the order of the actual sizes.
+  contour->Update();
+  unsigned long thresholdSize =
+    threshold->GetOutputDataObject(0)->GetActualMemorySize();
+  unsigned long contourSize =
+    contour->GetOutputDataObject(0)->GetActualMemorySize();
+  if (!IsClose(thresholdEstimate, thresholdSize, 4.0))
+    {
+    cerr << "Threshold estimate " << thresholdEstimate
+         << " far from its size " << thresholdSize << endl;
+    return EXIT_FAILURE;
+    }
+  if (!IsClose(contourEstimate, contourSize, 4.0))
+    {
+    cerr << "Contour estimate " << contourEstimate
+         << " far from its size " << contourSize << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Up to date outputs are estimated by their actual size.
+  unsigned long updatedPeak = contour->EstimatePeakMemorySize();
+  if (GetEstimate(threshold.GetPointer()) != thresholdSize ||
+      GetEstimate(contour.GetPointer()) != contourSize ||
+      updatedPeak < thresholdSize + contourSize ||
+      source->NumberOfExecutions != 1)
+    {
+    cerr << "Wrong up to date estimate" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The clipped output is estimated only when generated.
+  vtkNew<vtkClipDataSet> clip;
+  clip->SetInputConnection(threshold->GetOutputPort());
+  clip->SetValue(SIZE / 4);
+  clip->EstimatePeakMemorySize();
+  vtkInformation* clippedInfo = clip->GetOutputInformation(1);
+  if (GetEstimate(clip.GetPointer()) == 0 ||
+      clippedInfo->Get(
+        vtkStreamingDemandDrivenPipeline::ESTIMATED_MEMORY_SIZE()) != 0)
+    {
+    cerr << "Wrong clip estimate" << endl;
+    return EXIT_FAILURE;
+    }
+  clip->GenerateClippedOutputOn();
+  unsigned long clipPeak = clip->EstimatePeakMemorySize();
+  if (clippedInfo->Get(
+        vtkStreamingDemandDrivenPipeline::ESTIMATED_MEMORY_SIZE()) !=
+      GetEstimate(clip.GetPointer()) ||
+      clipPeak < thresholdSize + 2 * GetEstimate(clip.GetPointer()))
+    {
+    cerr << "Wrong clipped output estimate" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
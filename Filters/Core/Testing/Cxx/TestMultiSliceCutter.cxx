@@ -0,0 +1,218 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMultiSliceCutter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkMultiSliceCutter
+// .SECTION Description
+// Slices the tetrahedra of the wavelet with vtkMultiSliceCutter, and checks
+// that each slice, as a block or selected by its slice id, has the cells of
+// the cut by vtkCutter with its value alone.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCutter.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkIdFilter.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiSliceCutter.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+
+#include <math.h>
+
+//------------------------------------------------------------------------------
+// Whether the cells of polys, from first on, have the points and the cell
+// data of the cells of the expected cut.
+static bool SameCells(vtkPolyData* expected, vtkPolyData* polys,
+                      vtkIdType first)
+{
+  vtkDataArray* expectedIds = expected->GetCellData()->GetArray("Ids");
+  vtkDataArray* ids = polys->GetCellData()->GetArray("Ids");
+  vtkDataArray* expectedScalars = expected->GetPointData()->GetScalars();
+  vtkDataArray* scalars = polys->GetPointData()->GetArray("RTData");
+  if (!expectedIds || !ids || !expectedScalars || !scalars)
+    {
+    return false;
+    }
+  vtkIdType npts, *pts, npts2, *pts2;
+  vtkIdType cellId = 0;
+  vtkCellArray* ca = expected->GetPolys();
+  vtkCellArray* cb = polys->GetPolys();
+  ca->InitTraversal();
+  cb->InitTraversal();
+  for (vtkIdType i = 0; i < first; ++i)
+    {
+    cb->GetNextCell(npts2, pts2);
+    }
+  while (ca->GetNextCell(npts, pts))
+    {
+    if (!cb->GetNextCell(npts2, pts2) || npts != npts2 ||
+        expectedIds->GetTuple1(cellId) != ids->GetTuple1(first + cellId))
+      {
+      return false;
+      }
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      double x[3], y[3];
+      expected->GetPoint(pts[i], x);
+      polys->GetPoint(pts2[i], y);
+      for (int j = 0; j < 3; ++j)
+        {
+        if (fabs(x[j] - y[j]) > 1.0e-9)
+          {
+          return false;
+          }
+        }
+      if (fabs(expectedScalars->GetTuple1(pts[i]) -
+               scalars->GetTuple1(pts2[i])) > 1.0e-4)
+        {
+        return false;
+        }
+      }
+    ++cellId;
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int TestMultiSliceCutter(int, char*[])
+{
+  // Tetrahedra with the wavelet scalars, and cell ids.
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(0, 39, 0, 39, 0, 39);
+  vtkNew<vtkDataSetTriangleFilter> tetras;
+  tetras->SetInputConnection(wavelet->GetOutputPort());
+  vtkNew<vtkIdFilter> grid;
+  grid->SetInputConnection(tetras->GetOutputPort());
+  grid->PointIdsOff();
+  grid->FieldDataOn();
+  grid->SetIdsArrayName("Ids");
+  grid->Update();
+
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(19.5, 19.5, 19.5);
+  plane->SetNormal(1.0, 2.0, 3.0);
+
+  // Unsorted values, one of them repeated, and one outside of the grid.
+  const int numSlices = 50;
+  vtkNew<vtkMultiSliceCutter> slicer;
+  slicer->SetInputConnection(grid->GetOutputPort());
+  slicer->SetPlane(plane.GetPointer());
+  for (int i = 0; i < numSlices; ++i)
+    {
+    slicer->SetValue(i, 100.0 - 4.0 * ((7 * i) % numSlices));
+    }
+  slicer->SetValue(numSlices - 2, slicer->GetValue(3));
+  slicer->SetValue(numSlices - 1, 1000.0);
+  slicer->Update();
+
+  vtkPolyData* output =
+    vtkPolyData::SafeDownCast(slicer->GetOutputDataObject(0));
+  if (!output)
+    {
+    cerr << "No vtkPolyData output" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkNew<vtkPolyData> allSlices;
+  allSlices->DeepCopy(output);
+  vtkPolyData* all = allSlices.GetPointer();
+  vtkIntArray* sliceIds = vtkIntArray::SafeDownCast(
+    all->GetCellData()->GetArray("SliceId"));
+  if (!sliceIds || sliceIds->GetNumberOfTuples() != all->GetNumberOfCells())
+    {
+    cerr << "No slice ids" << endl;
+    return EXIT_FAILURE;
+    }
+
+  slicer->GenerateMultiBlockOn();
+  slicer->Update();
+  vtkMultiBlockDataSet* blocks =
+    vtkMultiBlockDataSet::SafeDownCast(slicer->GetOutputDataObject(0));
+  if (!blocks || static_cast<int>(blocks->GetNumberOfBlocks()) != numSlices)
+    {
+    cerr << "No vtkMultiBlockDataSet output" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Each slice against the cut with its value alone.
+  vtkNew<vtkCutter> cutter;
+  cutter->SetInputConnection(grid->GetOutputPort());
+  cutter->SetCutFunction(plane.GetPointer());
+  vtkIdType first = 0;
+  for (int i = 0; i < numSlices; ++i)
+    {
+    cutter->SetValue(0, slicer->GetValue(i));
+    cutter->Update();
+    vtkPolyData* expected = cutter->GetOutput();
+    vtkPolyData* block = vtkPolyData::SafeDownCast(blocks->GetBlock(i));
+    if (!block)
+      {
+      cerr << "Missing block " << i << endl;
+      return EXIT_FAILURE;
+      }
+    if (i != numSlices - 1 && expected->GetNumberOfPolys() <= 100)
+      {
+      cerr << "Empty cut " << i << endl;
+      return EXIT_FAILURE;
+      }
+    if (block->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+        block->GetNumberOfPolys() != expected->GetNumberOfPolys())
+      {
+      cerr << "Wrong size of block " << i << endl;
+      return EXIT_FAILURE;
+      }
+    if (!SameCells(expected, block, 0))
+      {
+      cerr << "Wrong block " << i << endl;
+      return EXIT_FAILURE;
+      }
+    if (!SameCells(expected, all, first))
+      {
+      cerr << "Wrong slice " << i << endl;
+      return EXIT_FAILURE;
+      }
+    for (vtkIdType j = 0; j < expected->GetNumberOfPolys(); ++j)
+      {
+      if (sliceIds->GetValue(first + j) != i)
+        {
+        cerr << "Wrong slice id of slice " << i << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    first += expected->GetNumberOfPolys();
+    }
+  if (first != all->GetNumberOfCells())
+    {
+    cerr << "Extra cells" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // All the slices with vtkCutter.
+  cutter->SetNumberOfContours(numSlices);
+  for (int i = 0; i < numSlices; ++i)
+    {
+    cutter->SetValue(i, slicer->GetValue(i));
+    }
+  cutter->Update();
+  if (cutter->GetOutput()->GetNumberOfPolys() != all->GetNumberOfCells())
+    {
+    cerr << "Wrong number of cells" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,178 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestProbeFilterLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkProbeFilter with a cell locator
+// .SECTION Description
+// Probes the tetrahedra of the wavelet with an image, with and without a
+// cell locator, serially and in parallel, and checks that the probed points
+// and values agree, and that modifying the locator executes the probe
+// again.
+
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkIdFilter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkProbeFilter.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+
+#include <math.h>
+
+//------------------------------------------------------------------------------
+// Probe and return a copy of the output, and its valid points.
+static vtkSmartPointer<vtkImageData> Probe(vtkProbeFilter* probe,
+                                           vtkIdTypeArray* validPoints)
+{
+  probe->Update();
+  vtkSmartPointer<vtkImageData> output = vtkSmartPointer<vtkImageData>::New();
+  output->DeepCopy(probe->GetOutput());
+  validPoints->DeepCopy(probe->GetValidPoints());
+  return output;
+}
+
+//------------------------------------------------------------------------------
+// Whether two probes have the same valid points, and the same values at
+// these points: exactly if exact, else for the scalars only, up to the
+// round-off of the interpolation in different cells.
+static bool SameProbes(vtkImageData* a, vtkIdTypeArray* validA,
+                       vtkImageData* b, vtkIdTypeArray* validB, bool exact)
+{
+  if (validA->GetNumberOfTuples() != validB->GetNumberOfTuples())
+    {
+    return false;
+    }
+  const char* names[3] = { "RTData", "Ids", "vtkValidPointMask" };
+  for (int k = 0; k < (exact ? 3 : 1); ++k)
+    {
+    vtkDataArray* arrayA = a->GetPointData()->GetArray(names[k]);
+    vtkDataArray* arrayB = b->GetPointData()->GetArray(names[k]);
+    if (!arrayA || !arrayB ||
+        arrayA->GetNumberOfTuples() != arrayB->GetNumberOfTuples())
+      {
+      return false;
+      }
+    for (vtkIdType i = 0; i < validA->GetNumberOfTuples(); ++i)
+      {
+      vtkIdType ptId = validA->GetValue(i);
+      if (ptId != validB->GetValue(i) ||
+          fabs(arrayA->GetTuple1(ptId) - arrayB->GetTuple1(ptId)) >
+          (exact ? 0.0 : 1.0e-3))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int TestProbeFilterLocator(int, char*[])
+{
+  // Tetrahedra with the wavelet scalars, and cell ids.
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(0, 29, 0, 29, 0, 29);
+  vtkNew<vtkDataSetTriangleFilter> tetras;
+  tetras->SetInputConnection(wavelet->GetOutputPort());
+  vtkNew<vtkIdFilter> grid;
+  grid->SetInputConnection(tetras->GetOutputPort());
+  grid->PointIdsOff();
+  grid->FieldDataOn();
+  grid->SetIdsArrayName("Ids");
+
+  // Sample points inside and outside of the grid.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(80, 80, 80);
+  image->SetOrigin(-1.03, -1.07, -1.01);
+  image->SetSpacing(0.4, 0.4, 0.4);
+
+  vtkNew<vtkProbeFilter> probe;
+  probe->SetInputData(image.GetPointer());
+  probe->SetSourceConnection(grid->GetOutputPort());
+
+  vtkNew<vtkIdTypeArray> valid;
+  vtkSmartPointer<vtkImageData> expected =
+    Probe(probe.GetPointer(), valid.GetPointer());
+  if (valid->GetNumberOfTuples() <= 100000 ||
+      valid->GetNumberOfTuples() >= image->GetNumberOfPoints() - 100000)
+    {
+    cerr << "Wrong number of points" << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkCellLocator> cellLocator;
+  vtkNew<vtkCellTreeLocator> cellTreeLocator;
+  vtkAbstractCellLocator* locators[2] =
+    { cellLocator.GetPointer(), cellTreeLocator.GetPointer() };
+  const char* names[2] = { "vtkCellLocator", "vtkCellTreeLocator" };
+  for (int i = 0; i < 2; ++i)
+    {
+    probe->SetCellLocator(locators[i]);
+    probe->EnableSMPOff();
+    vtkNew<vtkIdTypeArray> serialValid;
+    vtkSmartPointer<vtkImageData> serial =
+      Probe(probe.GetPointer(), serialValid.GetPointer());
+    if (!SameProbes(expected, valid.GetPointer(),
+                    serial, serialValid.GetPointer(), false))
+      {
+      cerr << "Wrong serial probe with " << names[i] << endl;
+      return EXIT_FAILURE;
+      }
+
+    // The locator is not rebuilt, and the output does not depend on the
+    // number of threads.
+    unsigned long buildTime = locators[i]->GetBuildTime();
+    probe->EnableSMPOn();
+    vtkNew<vtkIdTypeArray> parallelValid;
+    vtkSmartPointer<vtkImageData> parallel =
+      Probe(probe.GetPointer(), parallelValid.GetPointer());
+    if (locators[i]->GetBuildTime() != buildTime)
+      {
+      cerr << "Rebuilt " << names[i] << endl;
+      return EXIT_FAILURE;
+      }
+    if (!SameProbes(serial, serialValid.GetPointer(),
+                    parallel, parallelValid.GetPointer(), true))
+      {
+      cerr << "Wrong parallel probe with " << names[i] << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Modifying the locator executes the probe again, and rebuilds it.
+  probe->Update();
+  unsigned long updateTime = probe->GetOutput()->GetUpdateTime();
+  unsigned long buildTime = cellTreeLocator->GetBuildTime();
+  probe->Update();
+  if (probe->GetOutput()->GetUpdateTime() != updateTime)
+    {
+    cerr << "Executed with an unmodified locator" << endl;
+    return EXIT_FAILURE;
+    }
+  cellTreeLocator->SetNumberOfCellsPerNode(
+    2 * cellTreeLocator->GetNumberOfCellsPerNode());
+  probe->Update();
+  if (probe->GetOutput()->GetUpdateTime() == updateTime ||
+      cellTreeLocator->GetBuildTime() == buildTime)
+    {
+    cerr << "Not executed with a modified locator" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,485 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSpanSpace.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the span space scalar tree
+// .SECTION Description
+// Checks the cells found by vtkSpanSpace in the tetrahedra of the wavelet
+// against the ranges of all the cells, then checks that vtkContourGrid,
+// vtkContourFilter, vtkCutter and vtkThreshold produce the same output
+// with and without a scalar tree, that the tree is not rebuilt when only
+// the values change, and that cutting an input without cells skips the
+// tree.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCommand.h"
+#include "vtkContourFilter.h"
+#include "vtkContourGrid.h"
+#include "vtkCutter.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdFilter.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSpanSpace.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+//------------------------------------------------------------------------------
+// Counts the builds of the tree.
+class vtkCountingSpanSpace : public vtkSpanSpace
+{
+public:
+  static vtkCountingSpanSpace* New();
+  vtkTypeMacro(vtkCountingSpanSpace, vtkSpanSpace);
+
+  int NumberOfBuilds;
+
+  virtual void BuildTree()
+    {
+    unsigned long buildTime = this->BuildTime.GetMTime();
+    this->Superclass::BuildTree();
+    if (this->BuildTime.GetMTime() != buildTime)
+      {
+      ++this->NumberOfBuilds;
+      }
+    }
+
+protected:
+  vtkCountingSpanSpace()
+    {
+    this->NumberOfBuilds = 0;
+    }
+
+private:
+  vtkCountingSpanSpace(const vtkCountingSpanSpace&);  // Not implemented.
+  void operator=(const vtkCountingSpanSpace&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkCountingSpanSpace);
+
+//------------------------------------------------------------------------------
+static void GetCellRange(vtkDataSet* data, vtkDataArray* scalars,
+                         vtkIdType cellId, vtkIdList* pts, double range[2])
+{
+  data->GetCellPoints(cellId, pts);
+  range[0] = VTK_DOUBLE_MAX;
+  range[1] = -VTK_DOUBLE_MAX;
+  for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+    {
+    double s = scalars->GetComponent(pts->GetId(i), 0);
+    range[0] = s < range[0] ? s : range[0];
+    range[1] = s > range[1] ? s : range[1];
+    }
+}
+
+//------------------------------------------------------------------------------
+// Whether the cells found are in increasing order, include all the cells
+// whose range intersects [min,max], and not many more.
+static bool CheckCells(vtkDataSet* data, vtkIdList* found,
+                       double min, double max)
+{
+  vtkDataArray* scalars = data->GetPointData()->GetScalars();
+  vtkNew<vtkIdList> pts;
+  vtkIdType numFound = found->GetNumberOfIds(), next = 0, numActive = 0;
+  for (vtkIdType i = 1; i < numFound; ++i)
+    {
+    if (found->GetId(i - 1) >= found->GetId(i))
+      {
+      cerr << "Cells not in increasing order" << endl;
+      return false;
+      }
+    }
+  for (vtkIdType cellId = 0; cellId < data->GetNumberOfCells(); ++cellId)
+    {
+    double range[2];
+    GetCellRange(data, scalars, cellId, pts.GetPointer(), range);
+    while (next < numFound && found->GetId(next) < cellId)
+      {
+      ++next;
+      }
+    if (range[0] <= max && range[1] >= min)
+      {
+      ++numActive;
+      if (next == numFound || found->GetId(next) != cellId)
+        {
+        cerr << "Missing cell " << cellId << endl;
+        return false;
+        }
+      }
+    }
+  if (numFound > 2 * numActive + data->GetNumberOfCells() / 20)
+    {
+    cerr << numFound << " cells found for " << numActive << endl;
+    return false;
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    return a == b;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    for (int j = 0; j < a->GetNumberOfComponents(); ++j)
+      {
+      if (a->GetComponent(i, j) != b->GetComponent(i, j))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static bool SameOutputs(vtkPointSet* a, vtkPointSet* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfCells() != b->GetNumberOfCells() ||
+      (a->GetNumberOfPoints() &&
+       !SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData())))
+    {
+    return false;
+    }
+  vtkNew<vtkIdList> aPts, bPts;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+    {
+    a->GetCellPoints(cellId, aPts.GetPointer());
+    b->GetCellPoints(cellId, bPts.GetPointer());
+    if (aPts->GetNumberOfIds() != bPts->GetNumberOfIds())
+      {
+      return false;
+      }
+    for (vtkIdType i = 0; i < aPts->GetNumberOfIds(); ++i)
+      {
+      if (aPts->GetId(i) != bPts->GetId(i))
+        {
+        return false;
+        }
+      }
+    }
+  return SameArrays(a->GetPointData()->GetScalars(),
+                    b->GetPointData()->GetScalars()) &&
+    SameArrays(a->GetCellData()->GetArray("CellIds"),
+               b->GetCellData()->GetArray("CellIds"));
+}
+
+//------------------------------------------------------------------------------
+int TestSpanSpace(int, char*[])
+{
+  // Tetrahedra with the wavelet scalars and cell ids.
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(0, 39, 0, 39, 0, 39);
+  vtkNew<vtkDataSetTriangleFilter> tetras;
+  tetras->SetInputConnection(wavelet->GetOutputPort());
+  vtkNew<vtkIdFilter> ids;
+  ids->SetInputConnection(tetras->GetOutputPort());
+  ids->PointIdsOff();
+  ids->FieldDataOn();
+  ids->SetIdsArrayName("CellIds");
+  ids->Update();
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(
+    ids->GetOutput());
+  double range[2];
+  grid->GetPointData()->GetScalars()->GetRange(range);
+
+  // Queries against the ranges of all the cells.
+  vtkNew<vtkCountingSpanSpace> tree;
+  tree->SetDataSet(grid);
+  vtkNew<vtkIdList> found;
+  const double values[3] = { 80.0, 220.0, 150.0 };
+  for (int i = 0; i < 3; ++i)
+    {
+    tree->FindCells(1, values + i, found.GetPointer());
+    if (found->GetNumberOfIds() <= 0 ||
+        !CheckCells(grid, found.GetPointer(), values[i], values[i]))
+      {
+      cerr << "Wrong cells for " << values[i] << endl;
+      return EXIT_FAILURE;
+      }
+    }
+  tree->FindCellsInRange(120.0, 130.0, found.GetPointer());
+  if (!CheckCells(grid, found.GetPointer(), 120.0, 130.0))
+    {
+    cerr << "Wrong cells in range" << endl;
+    return EXIT_FAILURE;
+    }
+  tree->FindCellsInRange(range[1] + 1.0, VTK_DOUBLE_MAX, found.GetPointer());
+  if (found->GetNumberOfIds() != 0)
+    {
+    cerr << "Cells found out of range" << endl;
+    return EXIT_FAILURE;
+    }
+  tree->FindCellsInRange(-VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, found.GetPointer());
+  if (found->GetNumberOfIds() != grid->GetNumberOfCells())
+    {
+    cerr << "Not all cells in the whole range" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Several values at once: the union of the cells of each value.
+  vtkNew<vtkIdList> single;
+  tree->FindCells(3, values, found.GetPointer());
+  for (int i = 0; i < 3; ++i)
+    {
+    tree->FindCells(1, values + i, single.GetPointer());
+    if (found->GetNumberOfIds() < single->GetNumberOfIds())
+      {
+      cerr << "Cells of a value missing" << endl;
+      return EXIT_FAILURE;
+      }
+    for (vtkIdType j = 0; j < single->GetNumberOfIds(); ++j)
+      {
+      if (found->IsId(single->GetId(j)) < 0)
+        {
+        cerr << "Cell " << single->GetId(j) << " missing" << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // Traversal returns exactly the cells containing the value.
+  vtkNew<vtkDoubleArray> cellScalars;
+  vtkIdList* cellPts;
+  vtkIdType cellId, numTraversed = 0;
+  for (tree->InitTraversal(150.0);
+       tree->GetNextCell(cellId, cellPts, cellScalars.GetPointer()); )
+    {
+    double cellRange[2];
+    cellScalars->GetRange(cellRange);
+    if (cellRange[0] > 150.0 || cellRange[1] < 150.0)
+      {
+      cerr << "Wrong cell " << cellId << endl;
+      return EXIT_FAILURE;
+      }
+    ++numTraversed;
+    }
+  tree->FindCells(1, values + 2, found.GetPointer());
+  if (numTraversed <= 0 || numTraversed > found->GetNumberOfIds())
+    {
+    cerr << "Wrong traversal" << endl;
+    return EXIT_FAILURE;
+    }
+  if (tree->NumberOfBuilds != 1)
+    {
+    cerr << "Tree rebuilt" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Contouring with a tree gives the same output, and sweeping the values
+  // does not rebuild the tree.
+  vtkNew<vtkContourGrid> contour;
+  contour->SetInputData(grid);
+  contour->SetValue(0, 80.0);
+  contour->SetValue(1, 150.0);
+  contour->Update();
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(contour->GetOutput());
+  vtkNew<vtkCountingSpanSpace> contourTree;
+  contour->SetScalarTree(contourTree.GetPointer());
+  contour->UseScalarTreeOn();
+  contour->Update();
+  if (expected->GetNumberOfPolys() <= 1000 ||
+      !SameOutputs(expected.GetPointer(), contour->GetOutput()))
+    {
+    cerr << "Wrong vtkContourGrid output with a scalar tree" << endl;
+    return EXIT_FAILURE;
+    }
+
+  contour->SetNumberOfContours(1);
+  for (int i = 0; i < 10; ++i)
+    {
+    contour->SetValue(0, range[0] + (i + 0.5) * (range[1] - range[0]) / 10);
+    contour->Update();
+    }
+  if (contourTree->NumberOfBuilds != 1)
+    {
+    cerr << "Contour tree rebuilt" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Generic contouring of polygonal data: the triangles of a slice of the
+  // wavelet.
+  vtkNew<vtkRTAnalyticSource> slice;
+  slice->SetWholeExtent(0, 99, 0, 99, 0, 0);
+  vtkNew<vtkDataSetTriangleFilter> triangles;
+  triangles->SetInputConnection(slice->GetOutputPort());
+  triangles->Update();
+  vtkUnstructuredGrid* sliceGrid = triangles->GetOutput();
+  vtkNew<vtkPolyData> mesh;
+  mesh->SetPoints(sliceGrid->GetPoints());
+  mesh->SetPolys(sliceGrid->GetCells());
+  mesh->GetPointData()->ShallowCopy(sliceGrid->GetPointData());
+  vtkNew<vtkContourFilter> lines;
+  lines->SetInputData(mesh.GetPointer());
+  lines->SetValue(0, 80.0);
+  lines->SetValue(1, 150.0);
+  lines->SetValue(2, 220.0);
+  lines->Update();
+  vtkNew<vtkPolyData> expectedLines;
+  expectedLines->DeepCopy(lines->GetOutput());
+  lines->UseScalarTreeOn();
+  lines->Update();
+  if (expectedLines->GetNumberOfLines() <= 100 ||
+      !SameOutputs(expectedLines.GetPointer(), lines->GetOutput()))
+    {
+    cerr << "Wrong vtkContourFilter output with a scalar tree" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The tree reads polygonal data in the offsets layout in place.
+  vtkNew<vtkPolyData> offsetsMesh;
+  offsetsMesh->DeepCopy(mesh.GetPointer());
+  offsetsMesh->GetPolys()->ConvertToOffsetsLayout(true);
+  vtkNew<vtkSpanSpace> meshTree;
+  meshTree->SetDataSet(offsetsMesh.GetPointer());
+  const double meshValue = 150.0;
+  meshTree->FindCells(1, &meshValue, found.GetPointer());
+  if (!offsetsMesh->GetPolys()->IsOffsetsLayout())
+    {
+    cerr << "The tree converted the cells of its input" << endl;
+    return EXIT_FAILURE;
+    }
+  if (found->GetNumberOfIds() <= 0 ||
+      !CheckCells(offsetsMesh.GetPointer(), found.GetPointer(), meshValue,
+                  meshValue))
+    {
+    cerr << "Wrong cells of polygonal data in the offsets layout" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Cutting reuses the values of the cut function.
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.0, 0.0, 0.0);
+  plane->SetNormal(1.0, 2.0, 3.0);
+  vtkNew<vtkCutter> cutter;
+  cutter->SetInputData(grid);
+  cutter->SetCutFunction(plane.GetPointer());
+  cutter->SetValue(0, 40.0);
+  cutter->SetValue(1, 100.0);
+  cutter->Update();
+  expected->DeepCopy(cutter->GetOutput());
+  vtkNew<vtkCountingSpanSpace> cutterTree;
+  cutter->SetScalarTree(cutterTree.GetPointer());
+  cutter->UseScalarTreeOn();
+  cutter->Update();
+  if (expected->GetNumberOfPolys() <= 1000 ||
+      !SameOutputs(expected.GetPointer(), cutter->GetOutput()))
+    {
+    cerr << "Wrong vtkCutter output with a scalar tree" << endl;
+    return EXIT_FAILURE;
+    }
+  vtkNew<vtkCutter> meshCutter;
+  meshCutter->SetInputData(mesh.GetPointer());
+  meshCutter->SetCutFunction(plane.GetPointer());
+  meshCutter->SetValue(0, 50.0);
+  meshCutter->SetValue(1, 150.0);
+  meshCutter->SetSortByToSortByCell();
+  meshCutter->Update();
+  expectedLines->DeepCopy(meshCutter->GetOutput());
+  meshCutter->UseScalarTreeOn();
+  meshCutter->Update();
+  if (expectedLines->GetNumberOfLines() <= 100 ||
+      !SameOutputs(expectedLines.GetPointer(), meshCutter->GetOutput()))
+    {
+    cerr << "Wrong vtkCutter output sorted by cell" << endl;
+    return EXIT_FAILURE;
+    }
+  cutter->SetValue(0, 70.0);
+  cutter->Update();
+  if (cutterTree->NumberOfBuilds != 1)
+    {
+    cerr << "Cutter tree rebuilt" << endl;
+    return EXIT_FAILURE;
+    }
+  plane->SetNormal(3.0, 2.0, 1.0);
+  cutter->Update();
+  if (cutterTree->NumberOfBuilds != 2)
+    {
+    cerr << "Cutter tree not rebuilt for a new cut function" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // An input with points but no cells has no tree to build.
+  vtkNew<vtkPolyData> noCells;
+  noCells->SetPoints(mesh->GetPoints());
+  vtkNew<vtkSpanSpace> noCellsTree;
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  noCellsTree->AddObserver(vtkCommand::ErrorEvent,
+                           errorObserver.GetPointer());
+  vtkNew<vtkCutter> noCellsCutter;
+  noCellsCutter->SetInputData(noCells.GetPointer());
+  noCellsCutter->SetCutFunction(plane.GetPointer());
+  noCellsCutter->SetValue(0, 50.0);
+  noCellsCutter->SetScalarTree(noCellsTree.GetPointer());
+  noCellsCutter->UseScalarTreeOn();
+  noCellsCutter->Update();
+  if (errorObserver->GetError() ||
+      noCellsCutter->GetOutput()->GetNumberOfPoints() != 0)
+    {
+    cerr << "Wrong vtkCutter output for an input without cells" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Thresholding.
+  vtkNew<vtkThreshold> threshold;
+  threshold->SetInputData(grid);
+  vtkNew<vtkUnstructuredGrid> expectedCells;
+  for (int allScalars = 0; allScalars < 2; ++allScalars)
+    {
+    for (int criterion = 0; criterion < 3; ++criterion)
+      {
+      threshold->SetAllScalars(allScalars);
+      if (criterion == 0)
+        {
+        threshold->ThresholdByLower(90.0);
+        }
+      else if (criterion == 1)
+        {
+        threshold->ThresholdByUpper(200.0);
+        }
+      else
+        {
+        threshold->ThresholdBetween(110.0, 130.0);
+        }
+      threshold->UseScalarTreeOff();
+      threshold->Update();
+      expectedCells->DeepCopy(threshold->GetOutput());
+      threshold->UseScalarTreeOn();
+      threshold->Update();
+      if (expectedCells->GetNumberOfCells() <= 0 ||
+          !SameOutputs(expectedCells.GetPointer(), threshold->GetOutput()))
+        {
+        cerr << "Wrong vtkThreshold output with a scalar tree, criterion "
+             << criterion << ", all scalars " << allScalars << endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
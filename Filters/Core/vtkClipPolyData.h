@@ -51,7 +51,7 @@
 // output may consist of different cell types than the input data.
 
 // .SECTION See Also
-// vtkImplicitFunction vtkCutter vtkClipVolume
+// vtkImplicitFunction vtkCutter vtkClipVolume vtkEdgePointLocator
 
 #ifndef __vtkClipPolyData_h
 #define __vtkClipPolyData_h
@@ -128,6 +128,9 @@ public:
   // Description:
   // Specify a spatial locator for merging points. By default, an
   // instance of vtkMergePoints is used.
+  // A vtkEdgePointLocator merges the points by the cell edge they are
+  // interpolated on instead of by coordinates: it is faster, needs no
+  // bounds, and never merges distinct points of thin cells.
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
 
@@ -23,6 +23,7 @@
 #include "vtkGarbageCollector.h"
 #include "vtkGenericCell.h"
 #include "vtkGridSynchronizedTemplates3D.h"
+#include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -32,7 +33,7 @@
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
-#include "vtkSimpleScalarTree.h"
+#include "vtkSpanSpace.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkSynchronizedTemplates2D.h"
@@ -60,6 +61,7 @@ vtkContourFilter::vtkContourFilter()
   this->Locator = NULL;
 
   this->UseScalarTree = 0;
+  this->EnableSMP = 0;
   this->ScalarTree = NULL;
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
@@ -380,6 +382,17 @@ int vtkContourFilter::RequestData(
     cgrid->SetComputeNormals(this->ComputeNormals);
     cgrid->SetComputeScalars(this->ComputeScalars);
     cgrid->SetOutputPointsPrecision(this->OutputPointsPrecision);
+    cgrid->SetEnableSMP(this->EnableSMP);
+    cgrid->SetUseScalarTree(this->UseScalarTree);
+    if ( this->UseScalarTree )
+      {
+      // Keep the tree of the grid from one execution to the next.
+      if ( this->ScalarTree == NULL )
+        {
+        this->ScalarTree = vtkSpanSpace::New();
+        }
+      cgrid->SetScalarTree(this->ScalarTree);
+      }
     if ( this->Locator )
       {
       cgrid->SetLocator( this->Locator );
@@ -467,103 +480,93 @@ int vtkContourFilter::RequestData(
     outPd->InterpolateAllocate(inPd,estimatedSize,estimatedSize);
     outCd->CopyAllocate(inCd,estimatedSize,estimatedSize);
 
-    // If enabled, build a scalar tree to accelerate search
+    // If enabled, build a scalar tree to accelerate search: only the cells
+    // it finds for the contour values are visited, in the same order.
     //
-    if ( !this->UseScalarTree )
-      {
-      vtkGenericCell *cell = vtkGenericCell::New();
-      // Three passes over the cells to process lower dimensional cells first.
-      // For poly data output cells need to be added in the order:
-      // verts, lines and then polys, or cell data gets mixed up.
-      // A better solution is to have an unstructured grid output.
-      // I create a table that maps cell type to cell dimensionality,
-      // because I need a fast way to get cell dimensionality.
-      // This assumes GetCell is slow and GetCellType is fast.
-      // I do not like hard coding a list of cell types here,
-      // but I do not want to add GetCellDimension(vtkIdType cellId)
-      // to the vtkDataSet API.  Since I anticipate that the output
-      // will change to vtkUnstructuredGrid.  This temporary solution
-      // is acceptable.
-      //
-      int cellType;
-      unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
-      vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
-      int dimensionality;
-      // We skip 0d cells (points), because they cannot be cut (generate no data).
-      for (dimensionality = 1; dimensionality <= 3; ++dimensionality)
-        {
-        // Loop over all cells; get scalar values for all cell points
-        // and process each cell.
-        //
-        for (cellId=0; cellId < numCells && !abortExecute; cellId++)
-          {
-          // I assume that "GetCellType" is fast.
-          cellType = input->GetCellType(cellId);
-          if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
-            { // Protect against new cell types added.
-            vtkErrorMacro("Unknown cell type " << cellType);
-            continue;
-            }
-          if (cellTypeDimensions[cellType] != dimensionality)
-            {
-            continue;
-            }
-          input->GetCell(cellId,cell);
-          cellPts = cell->GetPointIds();
-          if (cellScalars->GetSize()/cellScalars->GetNumberOfComponents() <
-            cellPts->GetNumberOfIds())
-            {
-            cellScalars->Allocate(
-              cellScalars->GetNumberOfComponents()*cellPts->GetNumberOfIds());
-            }
-          inScalars->GetTuples(cellPts,cellScalars);
-
-          if (dimensionality == 3 &&  ! (cellId % 5000) )
-            {
-            vtkDebugMacro(<<"Contouring #" << cellId);
-            this->UpdateProgress (static_cast<double>(cellId)/numCells);
-            abortExecute = this->GetAbortExecute();
-            }
-
-          for (i=0; i < numContours; i++)
-            {
-            cell->Contour(values[i], cellScalars, this->Locator,
-                          newVerts, newLines, newPolys, inPd, outPd,
-                          inCd, cellId, outCd);
-
-            } // for all contour values
-          } // for all cells
-        } // for all dimensions
-      cell->Delete();
-      } //if using scalar tree
-    else
+    vtkIdList *cellIds = NULL;
+    vtkIdType numCellIds = numCells;
+    if ( this->UseScalarTree )
       {
-      vtkCell *cell;
       if ( this->ScalarTree == NULL )
         {
-        this->ScalarTree = vtkSimpleScalarTree::New();
+        this->ScalarTree = vtkSpanSpace::New();
         }
       this->ScalarTree->SetDataSet(input);
-      // Note: This will have problems when input contains 2D and 3D cells.
-      // CellData will get scrabled because of the implicit ordering of
-      // verts, lines and polys in vtkPolyData.  The solution
-      // is to convert this filter to create unstructured grid.
-      //
-      // Loop over all contour values.  Then for each contour value,
-      // loop over all cells.
+      this->ScalarTree->SetScalars(inScalars);
+      cellIds = vtkIdList::New();
+      this->ScalarTree->FindCells(numContours, values, cellIds);
+      numCellIds = cellIds->GetNumberOfIds();
+      }
+
+    vtkGenericCell *cell = vtkGenericCell::New();
+    // Three passes over the cells to process lower dimensional cells first.
+    // For poly data output cells need to be added in the order:
+    // verts, lines and then polys, or cell data gets mixed up.
+    // A better solution is to have an unstructured grid output.
+    // I create a table that maps cell type to cell dimensionality,
+    // because I need a fast way to get cell dimensionality.
+    // This assumes GetCell is slow and GetCellType is fast.
+    // I do not like hard coding a list of cell types here,
+    // but I do not want to add GetCellDimension(vtkIdType cellId)
+    // to the vtkDataSet API.  Since I anticipate that the output
+    // will change to vtkUnstructuredGrid.  This temporary solution
+    // is acceptable.
+    //
+    int cellType;
+    unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+    vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
+    int dimensionality;
+    // We skip 0d cells (points), because they cannot be cut (generate no data).
+    for (dimensionality = 1; dimensionality <= 3; ++dimensionality)
+      {
+      // Loop over all cells; get scalar values for all cell points
+      // and process each cell.
       //
-      for (i=0; i < numContours; i++)
+      for (vtkIdType idx=0; idx < numCellIds && !abortExecute; idx++)
         {
-        for ( this->ScalarTree->InitTraversal(values[i]);
-              (cell=this->ScalarTree->GetNextCell(cellId,cellPts,cellScalars)) != NULL; )
+        cellId = (cellIds ? cellIds->GetId(idx) : idx);
+        // I assume that "GetCellType" is fast.
+        cellType = input->GetCellType(cellId);
+        if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
+          { // Protect against new cell types added.
+          vtkErrorMacro("Unknown cell type " << cellType);
+          continue;
+          }
+        if (cellTypeDimensions[cellType] != dimensionality)
+          {
+          continue;
+          }
+        input->GetCell(cellId,cell);
+        cellPts = cell->GetPointIds();
+        if (cellScalars->GetSize()/cellScalars->GetNumberOfComponents() <
+          cellPts->GetNumberOfIds())
+          {
+          cellScalars->Allocate(
+            cellScalars->GetNumberOfComponents()*cellPts->GetNumberOfIds());
+          }
+        inScalars->GetTuples(cellPts,cellScalars);
+
+        if (dimensionality == 3 &&  ! (idx % 5000) )
+          {
+          vtkDebugMacro(<<"Contouring #" << cellId);
+          this->UpdateProgress (static_cast<double>(idx)/numCellIds);
+          abortExecute = this->GetAbortExecute();
+          }
+
+        for (i=0; i < numContours; i++)
           {
           cell->Contour(values[i], cellScalars, this->Locator,
                         newVerts, newLines, newPolys, inPd, outPd,
                         inCd, cellId, outCd);
 
-          } //for all cells
-        } //for all contour values
-      } //using scalar tree
+          } // for all contour values
+        } // for all cells
+      } // for all dimensions
+    cell->Delete();
+    if ( cellIds )
+      {
+      cellIds->Delete();
+      }
 
     vtkDebugMacro(<<"Created: "
                   << newPts->GetNumberOfPoints() << " points, "
@@ -662,6 +665,11 @@ int vtkContourFilter::ProcessRequest(vtkInformation* request,
                                      vtkInformationVector** inputVector,
                                      vtkInformationVector* outputVector)
 {
+  if(request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_MEMORY_ESTIMATE()))
+    {
+    return this->RequestMemoryEstimate(request, inputVector, outputVector);
+    }
+
   // generate the data
   if(request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT_INFORMATION()))
     {
@@ -748,6 +756,67 @@ int vtkContourFilter::ProcessRequest(vtkInformation* request,
   return this->Superclass::ProcessRequest(request, inputVector, outputVector);
 }
 
+//----------------------------------------------------------------------------
+int vtkContourFilter::RequestMemoryEstimate(vtkInformation*,
+                                            vtkInformationVector** inputVector,
+                                            vtkInformationVector* outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  if (!inInfo ||
+      !inInfo->Has(vtkStreamingDemandDrivenPipeline::ESTIMATED_NUMBER_OF_CELLS()))
+    {
+    return 1;
+    }
+  double numCells = static_cast<double>(
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::ESTIMATED_NUMBER_OF_CELLS()));
+
+  // An isosurface crosses about n^(2/3) of n volumetric cells, with two
+  // triangles in each, and an isoline about n^(1/2) of n planar cells.
+  // Structured inputs with a flat axis are planar; other inputs are
+  // assumed volumetric.
+  int planar = 0;
+  int *wholeExt =
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
+  if (wholeExt && (wholeExt[0] == wholeExt[1] || wholeExt[2] == wholeExt[3] ||
+                   wholeExt[4] == wholeExt[5]))
+    {
+    planar = 1;
+    }
+  double crossed = planar ? 2.0 * sqrt(numCells) :
+    4.0 * pow(numCells, 2.0 / 3.0);
+  if (crossed > numCells)
+    {
+    crossed = numCells;
+    }
+  double outCells = this->ContourValues->GetNumberOfContours() * crossed *
+    (planar ? 1.0 : 2.0);
+  // A closed triangle mesh has about half as many points as triangles,
+  // a polyline as many points as lines.
+  double outPoints = planar ? outCells : 0.5 * outCells;
+
+  double bytesPerPoint =
+    3 * (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION ?
+         sizeof(double) : sizeof(float));
+  bytesPerPoint +=
+    vtkStreamingDemandDrivenPipeline::GetEstimatedPointDataSize(inInfo);
+  if (!planar && this->ComputeNormals)
+    {
+    bytesPerPoint += 3 * sizeof(float);
+    }
+  if (!planar && this->ComputeGradients)
+    {
+    bytesPerPoint += 3 * sizeof(float);
+    }
+  double bytesPerCell = (planar ? 3 : 4) * sizeof(vtkIdType);
+
+  vtkStreamingDemandDrivenPipeline::SetEstimatedOutputSize(
+    outInfo, static_cast<vtkIdType>(outPoints),
+    static_cast<vtkIdType>(outCells), bytesPerPoint, bytesPerCell);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
 int vtkContourFilter::FillInputPortInformation(int, vtkInformation *info)
 {
   info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
@@ -769,6 +838,8 @@ void vtkContourFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Use Scalar Tree: "
      << (this->UseScalarTree ? "On\n" : "Off\n");
+  os << indent << "Enable SMP: "
+     << (this->EnableSMP ? "On\n" : "Off\n");
   if ( this->ScalarTree )
     {
     os << indent << "Scalar Tree: " << this->ScalarTree << "\n";
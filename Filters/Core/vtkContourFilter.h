@@ -115,7 +115,17 @@ public:
   vtkBooleanMacro(UseScalarTree,int);
 
   // Description:
-  // Enable the use of a scalar tree to accelerate contour extraction.
+  // Contour unstructured grids of tetrahedra in parallel.  See
+  // vtkContourGrid::SetEnableSMP().  Off by default.
+  vtkSetMacro(EnableSMP,int);
+  vtkGetMacro(EnableSMP,int);
+  vtkBooleanMacro(EnableSMP,int);
+
+  // Description:
+  // Specify the scalar tree used when UseScalarTree is on. By default, a
+  // vtkSpanSpace is created. The tree is kept between executions, so that
+  // contouring the same dataset with new values only visits the cells the
+  // tree finds for them.
   virtual void SetScalarTree(vtkScalarTree*);
   vtkGetObjectMacro(ScalarTree,vtkScalarTree);
 
@@ -163,12 +173,21 @@ protected:
                                   vtkInformationVector*);
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  // Description:
+  // Estimate the size of the output from the estimated number of input
+  // cells and the number of contour values.  Called for
+  // vtkStreamingDemandDrivenPipeline::REQUEST_MEMORY_ESTIMATE().
+  virtual int RequestMemoryEstimate(vtkInformation*,
+                                    vtkInformationVector**,
+                                    vtkInformationVector*);
+
   vtkContourValues *ContourValues;
   int ComputeNormals;
   int ComputeGradients;
   int ComputeScalars;
   vtkIncrementalPointLocator *Locator;
   int UseScalarTree;
+  int EnableSMP;
   vtkScalarTree *ScalarTree;
   int OutputPointsPrecision;
 
@@ -18,7 +18,11 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkContourValues.h"
+#include "vtkEdgeTable.h"
 #include "vtkFloatArray.h"
+#include "vtkGarbageCollector.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkNew.h"
@@ -26,8 +30,12 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolyDataNormals.h"
-#include "vtkSimpleScalarTree.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSpanSpace.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTetra.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkCutter.h"
 #include "vtkMergePoints.h"
@@ -35,8 +43,10 @@
 #include "vtkIncrementalPointLocator.h"
 
 #include <math.h>
+#include <vector>
 
 vtkStandardNewMacro(vtkContourGrid);
+vtkCxxSetObjectMacro(vtkContourGrid,ScalarTree,vtkScalarTree);
 
 // Construct object with initial range (0,1) and single contour value
 // of 0.0.
@@ -53,6 +63,9 @@ vtkContourGrid::vtkContourGrid()
   this->UseScalarTree = 0;
   this->ScalarTree = NULL;
 
+  this->EnableSMP = 0;
+  this->EdgeTable = NULL;
+
   this->OutputPointsPrecision = DEFAULT_PRECISION;
 
   // by default process active point scalars
@@ -72,6 +85,10 @@ vtkContourGrid::~vtkContourGrid()
     {
     this->ScalarTree->Delete();
     }
+  if ( this->EdgeTable )
+    {
+    this->EdgeTable->Delete();
+    }
 }
 
 // Overload standard modified time function. If contour values are modified,
@@ -95,6 +112,25 @@ unsigned long vtkContourGrid::GetMTime()
   return mTime;
 }
 
+// Set the precision of the points in the output.
+static void vtkContourGridSetPointsType(vtkContourGrid *self,
+                                        vtkUnstructuredGrid *input,
+                                        vtkPoints *newPts)
+{
+  if(self->GetOutputPointsPrecision() == vtkAlgorithm::DEFAULT_PRECISION)
+    {
+    newPts->SetDataType(input->GetPoints()->GetDataType());
+    }
+  else if(self->GetOutputPointsPrecision() == vtkAlgorithm::SINGLE_PRECISION)
+    {
+    newPts->SetDataType(VTK_FLOAT);
+    }
+  else if(self->GetOutputPointsPrecision() == vtkAlgorithm::DOUBLE_PRECISION)
+    {
+    newPts->SetDataType(VTK_DOUBLE);
+    }
+}
+
 template <class T>
 void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
                            vtkPolyData *output,
@@ -137,20 +173,7 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
     }
 
   newPts = vtkPoints::New();
-
-  // set precision for the points in the output
-  if(self->GetOutputPointsPrecision() == vtkAlgorithm::DEFAULT_PRECISION)
-    {
-    newPts->SetDataType(grid->GetPoints()->GetDataType());
-    }
-  else if(self->GetOutputPointsPrecision() == vtkAlgorithm::SINGLE_PRECISION)
-    {
-    newPts->SetDataType(VTK_FLOAT);
-    }
-  else if(self->GetOutputPointsPrecision() == vtkAlgorithm::DOUBLE_PRECISION)
-    {
-    newPts->SetDataType(VTK_DOUBLE);
-    }
+  vtkContourGridSetPointsType(self, grid, newPts);
 
   newPts->Allocate(estimatedSize,estimatedSize);
   newVerts = vtkCellArray::New();
@@ -281,31 +304,79 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
     } //if using scalar tree
   else
     {
-    // Note: This will have problems when input contains 2D and 3D cells.
-    // CellData will get scrabled because of the implicit ordering of
-    // verts, lines and polys in vtkPolyData.  The solution
-    // is to convert this filter to create unstructured grid.
+    // Only the cells the scalar tree finds for the contour values are
+    // visited, in the same order as without the tree.
     //
     if ( scalarTree == NULL )
       {
-      scalarTree = vtkSimpleScalarTree::New();
+      scalarTree = vtkSpanSpace::New();
       }
     scalarTree->SetDataSet(input);
-    //
-    // Loop over all contour values.  Then for each contour value,
-    // loop over all cells.
-    //
-    for (i=0; i < numContours; i++)
+    scalarTree->SetScalars(inScalars);
+    vtkIdList *cellIds = vtkIdList::New();
+    scalarTree->FindCells(numContours, values, cellIds);
+    vtkIdType numCellIds = cellIds->GetNumberOfIds();
+
+    int cellType;
+    unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+    vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
+    int dimensionality;
+    // We skip 0d cells (points), because they cannot be cut (generate no data).
+    for (dimensionality = 1; dimensionality <= 3 && !abortExecute;
+         ++dimensionality)
       {
-      for ( scalarTree->InitTraversal(values[i]);
-          (cell=scalarTree->GetNextCell(cellId,cellPts,cellScalars)) != NULL; )
+      for (vtkIdType idx = 0; idx < numCellIds; idx++)
         {
-        cell->Contour(values[i], cellScalars, locator,
-                      newVerts, newLines, newPolys, inPd, outPd,
-                      inCd, cellId, outCd);
-           //don't want to call Contour any more than necessary
-        } //for all cells
-      } //for all contour values
+        cellId = cellIds->GetId(idx);
+        cellType = input->GetCellType(cellId);
+        if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
+          { // Protect against new cell types added.
+          vtkGenericWarningMacro("Unknown cell type " << cellType);
+          continue;
+          }
+        if (cellTypeDimensions[cellType] != dimensionality)
+          {
+          continue;
+          }
+
+        if (dimensionality == 3 &&  ! (idx % 5000) )
+          {
+          self->UpdateProgress (static_cast<double>(idx)/numCellIds);
+          if (self->GetAbortExecute())
+            {
+            abortExecute = 1;
+            break;
+            }
+          }
+
+        cell = input->GetCell(cellId);
+        cellPts = cell->GetPointIds();
+        numPoints = cellPts->GetNumberOfIds();
+        if (numPoints < 1)
+          {
+          continue;
+          }
+        range[0] = range[1] = scalarArrayPtr[cellPts->GetId(0)];
+        for (i = 1; i < numPoints; i++)
+          {
+          tempScalar = scalarArrayPtr[cellPts->GetId(i)];
+          range[0] = (tempScalar < range[0] ? tempScalar : range[0]);
+          range[1] = (tempScalar > range[1] ? tempScalar : range[1]);
+          }
+        inScalars->GetTuples(cellPts,cellScalars);
+
+        for (i=0; i < numContours; i++)
+          {
+          if ((values[i] >= range[0]) && (values[i] <= range[1]))
+            {
+            cell->Contour(values[i], cellScalars, locator,
+                          newVerts, newLines, newPolys, inPd, outPd,
+                          inCd, cellId, outCd);
+            } // if contour value in range of values for this cell
+          } // for all contour values
+        } // for all cells
+      } // For all dimensions.
+    cellIds->Delete();
     } //using scalar tree
 
   //
@@ -338,6 +409,285 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
   output->Squeeze();
 }
 
+//----------------------------------------------------------------------------
+// Parallel contouring of tetrahedra.  The cells are divided into batches
+// of VTK_CONTOUR_GRID_BATCH_SIZE cells, which the threads contour
+// independently, recording the edges that their triangles cross.  The
+// batches are then merged in cell order: a point is created for each
+// edge the first time it is crossed.  Since the batches do not depend on
+// the number of threads, neither does the output.
+static const vtkIdType VTK_CONTOUR_GRID_BATCH_SIZE = 4096;
+
+// Point ids of the cells of a grid, safe to read from several threads.
+class vtkContourGridCells
+{
+public:
+  vtkCellArray *Cells;
+  const vtkIdType *Legacy;
+  const vtkIdType *Locations;
+
+  void Initialize(vtkUnstructuredGrid *grid)
+  {
+    this->Cells = grid->GetCells();
+    this->Legacy = NULL;
+    this->Locations = NULL;
+    if (!this->Cells->IsOffsetsLayout())
+      {
+      this->Legacy = this->Cells->GetPointer();
+      this->Locations = grid->GetCellLocationsArray()->GetPointer(0);
+      }
+  }
+
+  void GetCell(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts,
+               vtkIdList *scratch)
+  {
+    if (this->Legacy)
+      {
+      const vtkIdType *cell = this->Legacy + this->Locations[cellId];
+      npts = cell[0];
+      pts = cell + 1;
+      }
+    else
+      {
+      this->Cells->GetCellAtId(cellId, npts, pts, scratch);
+      }
+  }
+};
+
+// Triangles generated by a batch, in the order of the serial algorithm.
+// Each vertex is the point at parameter t of an edge (p1,p2), p1 being
+// the end with the lower scalar; a vertex on a point p of the grid is
+// recorded as the edge (p,p). Each triangle also records the index of
+// its contour value, since an edge can be crossed by several values.
+class vtkContourGridBatch
+{
+public:
+  std::vector<vtkIdType> Edges;
+  std::vector<double> Parameters;
+  std::vector<vtkIdType> CellIds;
+  std::vector<int> ContourIds;
+};
+
+template <class T>
+class vtkContourGridTetraFunctor
+{
+public:
+  vtkContourGrid *Filter;
+  vtkContourGridCells *Cells;
+  T *Scalars;
+  double *Values;
+  int NumberOfContours;
+  vtkIdType NumberOfCells;
+  vtkIdType NumberOfBatches;
+  vtkContourGridBatch *Batches;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList> > Scratch;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkSmartPointer<vtkIdList> &scratch = this->Scratch.Local();
+    if (!scratch)
+      {
+      scratch = vtkSmartPointer<vtkIdList>::New();
+      }
+    vtkIdType npts;
+    const vtkIdType *pts;
+    double s[4];
+
+    for (vtkIdType batch = begin; batch < end; batch++)
+      {
+      if ( vtkSMPTools::GetThreadIndex() == 0 )
+        {
+        this->Filter->UpdateProgress(
+          static_cast<double>(batch)/this->NumberOfBatches);
+        }
+      if (this->Filter->GetAbortExecute())
+        {
+        return;
+        }
+
+      vtkContourGridBatch &out = this->Batches[batch];
+      vtkIdType cellId = batch*VTK_CONTOUR_GRID_BATCH_SIZE;
+      vtkIdType last = cellId + VTK_CONTOUR_GRID_BATCH_SIZE;
+      if (last > this->NumberOfCells)
+        {
+        last = this->NumberOfCells;
+        }
+      for (; cellId < last; cellId++)
+        {
+        this->Cells->GetCell(cellId, npts, pts, scratch);
+        for (int i = 0; i < 4; i++)
+          {
+          s[i] = static_cast<double>(this->Scalars[pts[i]]);
+          }
+        for (int c = 0; c < this->NumberOfContours; c++)
+          {
+          double value = this->Values[c];
+          int index = 0;
+          for (int i = 0; i < 4; i++)
+            {
+            if (s[i] >= value)
+              {
+              index |= (1 << i);
+              }
+            }
+          for (int *edge = vtkTetra::GetTriangleCases(index); edge[0] > -1;
+               edge += 3)
+            {
+            for (int i = 0; i < 3; i++)
+              {
+              // Same interpolation as vtkTetra::Contour().
+              int *vert = vtkTetra::GetEdgeArray(edge[i]);
+              int v1 = vert[0], v2 = vert[1];
+              double deltaScalar = s[v2] - s[v1];
+              if (deltaScalar <= 0)
+                {
+                v1 = vert[1];
+                v2 = vert[0];
+                deltaScalar = -deltaScalar;
+                }
+              double t = ( deltaScalar == 0.0 ? 0.0 :
+                           (value - s[v1]) / deltaScalar );
+              if (t == 0.0 || t == 1.0)
+                {
+                vtkIdType p = pts[t == 0.0 ? v1 : v2];
+                out.Edges.push_back(p);
+                out.Edges.push_back(p);
+                out.Parameters.push_back(0.0);
+                }
+              else
+                {
+                out.Edges.push_back(pts[v1]);
+                out.Edges.push_back(pts[v2]);
+                out.Parameters.push_back(t);
+                }
+              }
+            out.CellIds.push_back(cellId);
+            out.ContourIds.push_back(c);
+            }
+          }
+        }
+      }
+  }
+};
+
+template <class T>
+void vtkContourGridExecuteSMP(vtkContourGrid *self, vtkUnstructuredGrid *input,
+                              vtkPolyData *output, T *scalarArrayPtr,
+                              int numContours, double *values,
+                              int computeScalars, vtkEdgeTable *edgeTable)
+{
+  vtkPointData *inPd=input->GetPointData(), *outPd=output->GetPointData();
+  vtkCellData *inCd=input->GetCellData(), *outCd=output->GetCellData();
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType numBatches =
+    (numCells + VTK_CONTOUR_GRID_BATCH_SIZE - 1) / VTK_CONTOUR_GRID_BATCH_SIZE;
+
+  // Contour the batches in parallel.
+  vtkContourGridCells cells;
+  cells.Initialize(input);
+  std::vector<vtkContourGridBatch> batches(numBatches);
+  vtkContourGridTetraFunctor<T> functor;
+  functor.Filter = self;
+  functor.Cells = &cells;
+  functor.Scalars = scalarArrayPtr;
+  functor.Values = values;
+  functor.NumberOfContours = numContours;
+  functor.NumberOfCells = numCells;
+  functor.NumberOfBatches = numBatches;
+  functor.Batches = &batches[0];
+  vtkSMPTools::For(0, numBatches, 1, functor);
+
+  vtkIdType numTris = 0;
+  for (vtkIdType batch = 0; batch < numBatches; batch++)
+    {
+    numTris += static_cast<vtkIdType>(batches[batch].CellIds.size());
+    }
+
+  // Merge the batches in order, creating a point the first time an edge
+  // is crossed by a value. The edges of the c-th distinct value are keyed
+  // as (p1, p2 + c*numPts) in the edge table. Points on the points of the
+  // grid are keyed as (p,p) for all the values, and like equal values,
+  // share their point as in the serial output.
+  vtkIdType numPts = input->GetNumberOfPoints();
+  std::vector<vtkIdType> offsets(numContours);
+  vtkIdType distinct = 0;
+  for (int c = 0; c < numContours; c++)
+    {
+    int first = 0;
+    while (values[first] != values[c])
+      {
+      first++;
+      }
+    offsets[c] = (first == c ? numPts * distinct++ : offsets[first]);
+    }
+  vtkPoints *newPts = vtkPoints::New();
+  vtkContourGridSetPointsType(self, input, newPts);
+  newPts->Allocate(numTris, numTris);
+  if (!computeScalars)
+    {
+    outPd->CopyScalarsOff();
+    }
+  outPd->InterpolateAllocate(inPd, numTris, numTris);
+  outCd->CopyAllocate(inCd, numTris, numTris);
+  vtkCellArray *newPolys = vtkCellArray::New();
+  newPolys->Allocate(newPolys->EstimateSize(numTris, 3));
+
+  edgeTable->InitEdgeInsertion(numPts, 1);
+  double x1[3], x2[3], x[3];
+  vtkIdType ids[3];
+  for (vtkIdType batch = 0; batch < numBatches; batch++)
+    {
+    vtkContourGridBatch &in = batches[batch];
+    vtkIdType batchTris = static_cast<vtkIdType>(in.CellIds.size());
+    for (vtkIdType tri = 0; tri < batchTris; tri++)
+      {
+      vtkIdType offset = offsets[in.ContourIds[tri]];
+      for (int i = 0; i < 3; i++)
+        {
+        vtkIdType vertex = 3*tri + i;
+        vtkIdType p1 = in.Edges[2*vertex];
+        vtkIdType p2 = in.Edges[2*vertex + 1];
+        vtkIdType key = (p1 == p2 ? p2 : p2 + offset);
+        ids[i] = edgeTable->IsEdge(p1, key);
+        if (ids[i] < 0)
+          {
+          double t = in.Parameters[vertex];
+          input->GetPoint(p1, x1);
+          input->GetPoint(p2, x2);
+          for (int j = 0; j < 3; j++)
+            {
+            x[j] = x1[j] + t * (x2[j] - x1[j]);
+            }
+          ids[i] = newPts->InsertNextPoint(x);
+          edgeTable->InsertEdge(p1, key, ids[i]);
+          outPd->InterpolateEdge(inPd, ids[i], p1, p2, t);
+          }
+        }
+      // check for degenerate triangle
+      if ( ids[0] != ids[1] && ids[0] != ids[2] && ids[1] != ids[2] )
+        {
+        vtkIdType newCellId = newPolys->InsertNextCell(3, ids);
+        outCd->CopyData(inCd, in.CellIds[tri], newCellId);
+        }
+      }
+    // Release the batch as soon as it is merged.
+    std::vector<vtkIdType>().swap(in.Edges);
+    std::vector<double>().swap(in.Parameters);
+    std::vector<vtkIdType>().swap(in.CellIds);
+    std::vector<int>().swap(in.ContourIds);
+    }
+  edgeTable->Initialize();
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+  if (newPolys->GetNumberOfCells())
+    {
+    output->SetPolys(newPolys);
+    }
+  newPolys->Delete();
+  output->Squeeze();
+}
+
 //
 // Contouring filter for unstructured grids.
 //
@@ -382,16 +732,43 @@ int vtkContourGrid::RequestData(
 
   scalarArrayPtr = inScalars->GetVoidPointer(0);
 
-  switch (inScalars->GetDataType())
+  // The parallel path keys the edges of each value apart, which needs
+  // numContours*numPts ids.
+  if (this->EnableSMP && !useScalarTree &&
+      static_cast<double>(numContours) * input->GetNumberOfPoints() <
+      static_cast<double>(VTK_LARGE_ID) &&
+      inScalars->GetNumberOfComponents() == 1 &&
+      input->IsHomogeneous() && input->GetCellType(0) == VTK_TETRA)
+    {
+    if ( this->EdgeTable == NULL )
+      {
+      this->EdgeTable = vtkEdgeTable::New();
+      }
+    switch (inScalars->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkContourGridExecuteSMP(this, input, output,
+                                 static_cast<VTK_TT *>(scalarArrayPtr),
+                                 numContours, values, computeScalars,
+                                 this->EdgeTable));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+        return 1;
+      }
+    }
+  else
     {
-    vtkTemplateMacro(
-      vtkContourGridExecute(this, input, output, inScalars,
-                            static_cast<VTK_TT *>(scalarArrayPtr),
-                            numContours, values,computeScalars, useScalarTree,
-                            scalarTree));
-    default:
-      vtkErrorMacro(<< "Execute: Unknown ScalarType");
-      return 1;
+    switch (inScalars->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkContourGridExecute(this, input, output, inScalars,
+                              static_cast<VTK_TT *>(scalarArrayPtr),
+                              numContours, values,computeScalars,
+                              useScalarTree, scalarTree));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+        return 1;
+      }
     }
 
   if(this->ComputeNormals)
@@ -462,6 +839,14 @@ int vtkContourGrid::FillInputPortInformation(int, vtkInformation *info)
   return 1;
 }
 
+void vtkContourGrid::ReportReferences(vtkGarbageCollector* collector)
+{
+  this->Superclass::ReportReferences(collector);
+  // The scalar tree shares our input and is therefore involved in a
+  // reference loop.
+  vtkGarbageCollectorReport(collector, this->ScalarTree, "ScalarTree");
+}
+
 void vtkContourGrid::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
@@ -474,6 +859,16 @@ void vtkContourGrid::PrintSelf(ostream& os, vtkIndent indent)
      << (this->ComputeScalars ? "On\n" : "Off\n");
   os << indent << "Use Scalar Tree: "
      << (this->UseScalarTree ? "On\n" : "Off\n");
+  os << indent << "Enable SMP: "
+     << (this->EnableSMP ? "On\n" : "Off\n");
+  if ( this->ScalarTree )
+    {
+    os << indent << "Scalar Tree: " << this->ScalarTree << "\n";
+    }
+  else
+    {
+    os << indent << "Scalar Tree: (none)\n";
+    }
 
   this->ContourValues->PrintSelf(os,indent.GetNextIndent());
 
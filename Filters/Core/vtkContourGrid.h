@@ -114,6 +114,26 @@ public:
   vtkGetMacro(UseScalarTree,int);
   vtkBooleanMacro(UseScalarTree,int);
 
+  // Description:
+  // Specify the scalar tree used when UseScalarTree is on. By default, a
+  // vtkSpanSpace is created. The tree is kept between executions, so that
+  // contouring the same grid with new values only visits the cells the
+  // tree finds for them.
+  virtual void SetScalarTree(vtkScalarTree*);
+  vtkGetObjectMacro(ScalarTree,vtkScalarTree);
+
+  // Description:
+  // Contour grids of tetrahedra in parallel with vtkSMPTools.  The cells
+  // are processed in batches of a fixed size, and the points generated
+  // on the same edge are merged by edge rather than with the Locator.
+  // The batches are then merged in cell order, so the output is the same
+  // for any number of threads, and has its points and triangles in the
+  // same order as the serial output.  Other grids, and grids contoured
+  // with a scalar tree, are processed serially.  Off by default.
+  vtkSetMacro(EnableSMP,int);
+  vtkGetMacro(EnableSMP,int);
+  vtkBooleanMacro(EnableSMP,int);
+
   // Description:
   // Set / get a spatial locator for merging points. By default,
   // an instance of vtkMergePoints is used.
@@ -136,6 +156,8 @@ protected:
   vtkContourGrid();
   ~vtkContourGrid();
 
+  virtual void ReportReferences(vtkGarbageCollector*);
+
   virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
@@ -145,6 +167,7 @@ protected:
   int ComputeScalars;
   vtkIncrementalPointLocator *Locator;
   int UseScalarTree;
+  int EnableSMP;
   int OutputPointsPrecision;
   vtkScalarTree *ScalarTree;
   vtkEdgeTable *EdgeTable;
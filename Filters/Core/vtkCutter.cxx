@@ -20,8 +20,10 @@
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
+#include "vtkGarbageCollector.h"
 #include "vtkGenericCell.h"
 #include "vtkGridSynchronizedTemplates3D.h"
+#include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkImplicitFunction.h"
 #include "vtkInformation.h"
@@ -33,6 +35,8 @@
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
+#include "vtkScalarTree.h"
+#include "vtkSpanSpace.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkSynchronizedTemplates3D.h"
@@ -46,6 +50,7 @@
 vtkStandardNewMacro(vtkCutter);
 vtkCxxSetObjectMacro(vtkCutter,CutFunction,vtkImplicitFunction);
 vtkCxxSetObjectMacro(vtkCutter,Locator,vtkIncrementalPointLocator)
+vtkCxxSetObjectMacro(vtkCutter,ScalarTree,vtkScalarTree);
 
 //----------------------------------------------------------------------------
 // Construct with user-specified implicit function; initial value of 0.0; and
@@ -57,6 +62,9 @@ vtkCutter::vtkCutter(vtkImplicitFunction *cf)
   this->CutFunction = cf;
   this->GenerateCutScalars = 0;
   this->Locator = NULL;
+  this->UseScalarTree = 0;
+  this->ScalarTree = NULL;
+  this->CutScalars = NULL;
 
   this->SynchronizedTemplates3D = vtkSynchronizedTemplates3D::New();
   this->SynchronizedTemplatesCutter3D = vtkSynchronizedTemplatesCutter3D::New();
@@ -73,6 +81,11 @@ vtkCutter::~vtkCutter()
   this->ContourValues->Delete();
   this->SetCutFunction(NULL);
   this->SetLocator(NULL);
+  this->SetScalarTree(NULL);
+  if ( this->CutScalars )
+    {
+    this->CutScalars->Delete();
+    }
 
   this->SynchronizedTemplates3D->Delete();
   this->SynchronizedTemplatesCutter3D->Delete();
@@ -370,7 +383,8 @@ int vtkCutter::RequestData(
       }
     }
 
-  if (input->GetDataObjectType() == VTK_UNSTRUCTURED_GRID)
+  if (input->GetDataObjectType() == VTK_UNSTRUCTURED_GRID &&
+      !this->UseScalarTree)
     {
     vtkDebugMacro(<< "Executing Unstructured Grid Cutter");
     this->UnstructuredGridCutter(input, output);
@@ -417,6 +431,52 @@ void vtkCutter::GetCellTypeDimensions(unsigned char* cellTypeDimensions)
 }
 
 
+//----------------------------------------------------------------------------
+vtkDoubleArray *vtkCutter::ComputeCutScalars(vtkDataSet *input)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  if ( !this->UseScalarTree )
+    {
+    if ( this->CutScalars )
+      {
+      this->CutScalars->Delete();
+      this->CutScalars = NULL;
+      }
+    }
+  else if ( this->CutScalars && this->ScalarTree &&
+            this->ScalarTree->GetDataSet() == input &&
+            this->CutScalars->GetNumberOfTuples() == numPts &&
+            this->CutScalarsTime > input->GetMTime() &&
+            this->CutScalarsTime > this->CutFunction->GetMTime() )
+    {
+    this->CutScalars->Register(this);
+    return this->CutScalars;
+    }
+
+  vtkDoubleArray *cutScalars = vtkDoubleArray::New();
+  cutScalars->SetNumberOfTuples(numPts);
+
+  // Loop over all points evaluating scalar function at each point
+  //
+  for ( vtkIdType i=0; i < numPts; i++ )
+    {
+    cutScalars->SetValue(i,
+                         this->CutFunction->FunctionValue(input->GetPoint(i)));
+    }
+
+  if ( this->UseScalarTree )
+    {
+    if ( this->CutScalars )
+      {
+      this->CutScalars->Delete();
+      }
+    this->CutScalars = cutScalars;
+    this->CutScalars->Register(this);
+    this->CutScalarsTime.Modified();
+    }
+  return cutScalars;
+}
+
 //----------------------------------------------------------------------------
 void vtkCutter::DataSetCutter(vtkDataSet *input, vtkPolyData *output)
 {
@@ -430,7 +490,6 @@ void vtkCutter::DataSetCutter(vtkDataSet *input, vtkPolyData *output)
   vtkDoubleArray *cutScalars;
   double value, s;
   vtkIdType estimatedSize, numCells=input->GetNumberOfCells();
-  vtkIdType numPts=input->GetNumberOfPoints();
   int numCellPts;
   vtkPointData *inPD, *outPD;
   vtkCellData *inCD=input->GetCellData(), *outCD=output->GetCellData();
@@ -458,8 +517,7 @@ void vtkCutter::DataSetCutter(vtkDataSet *input, vtkPolyData *output)
   newLines->Allocate(estimatedSize,estimatedSize/2);
   newPolys = vtkCellArray::New();
   newPolys->Allocate(estimatedSize,estimatedSize/2);
-  cutScalars = vtkDoubleArray::New();
-  cutScalars->SetNumberOfTuples(numPts);
+  cutScalars = this->ComputeCutScalars(input);
 
   // Interpolate data along edge. If generating cut scalars, do necessary setup
   if ( this->GenerateCutScalars )
@@ -483,12 +541,20 @@ void vtkCutter::DataSetCutter(vtkDataSet *input, vtkPolyData *output)
     }
   this->Locator->InitPointInsertion (newPoints, input->GetBounds());
 
-  // Loop over all points evaluating scalar function at each point
+  // If enabled, use a scalar tree to only visit the cells it finds for the
+  // contour values, in the same order. An empty input has no tree to build.
   //
-  for ( i=0; i < numPts; i++ )
+  vtkIdList *cutCells = NULL;
+  vtkIdType numCutCells = numCells;
+  if ( this->UseScalarTree && numCells > 0 )
     {
-    s = this->CutFunction->FunctionValue(input->GetPoint(i));
-    cutScalars->SetComponent(i,0,s);
+    if ( this->ScalarTree == NULL )
+      {
+      this->ScalarTree = vtkSpanSpace::New();
+      }
+    this->ScalarTree->SetDataSet(input);
+    this->ScalarTree->SetScalars(cutScalars);
+    cutCells = vtkIdList::New();
     }
 
   // Compute some information for progress methods
@@ -508,11 +574,19 @@ void vtkCutter::DataSetCutter(vtkDataSet *input, vtkPolyData *output)
     // vtkPolyData output, verts and lines have lower cell ids than triangles.
     for (iter=0; iter < numContours && !abortExecute; iter++)
       {
+      value = this->ContourValues->GetValue(iter);
+      if ( cutCells )
+        {
+        this->ScalarTree->FindCells(1, &value, cutCells);
+        numCutCells = cutCells->GetNumberOfIds();
+        }
+
       // Loop over all cells; get scalar values for all cell points
       // and process each cell.
       //
-      for (cellId=0; cellId < numCells && !abortExecute; cellId++)
+      for (vtkIdType idx=0; idx < numCutCells && !abortExecute; idx++)
         {
+        cellId = (cutCells ? cutCells->GetId(idx) : idx);
         if ( !(++cut % progressInterval) )
           {
           vtkDebugMacro(<<"Cutting #" << cut);
@@ -532,7 +606,6 @@ void vtkCutter::DataSetCutter(vtkDataSet *input, vtkPolyData *output)
           cellScalars->SetTuple(i,&s);
           }
 
-        value = this->ContourValues->GetValue(iter);
         cell->Contour(value, cellScalars, this->Locator,
                       newVerts, newLines, newPolys, inPD, outPD,
                       inCD, cellId, outCD);
@@ -560,14 +633,21 @@ void vtkCutter::DataSetCutter(vtkDataSet *input, vtkPolyData *output)
     unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
     vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
     int dimensionality;
+    if ( cutCells )
+      {
+      this->ScalarTree->FindCells(numContours,
+                                  this->ContourValues->GetValues(), cutCells);
+      numCutCells = cutCells->GetNumberOfIds();
+      }
     // We skip 0d cells (points), because they cannot be cut (generate no data).
     for (dimensionality = 1; dimensionality <= 3; ++dimensionality)
       {
       // Loop over all cells; get scalar values for all cell points
       // and process each cell.
       //
-      for (cellId=0; cellId < numCells && !abortExecute; cellId++)
+      for (vtkIdType idx=0; idx < numCutCells && !abortExecute; idx++)
         {
+        cellId = (cutCells ? cutCells->GetId(idx) : idx);
         // I assume that "GetCellType" is fast.
         cellType = input->GetCellType(cellId);
         if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
@@ -616,6 +696,10 @@ void vtkCutter::DataSetCutter(vtkDataSet *input, vtkPolyData *output)
   cell->Delete();
   cellScalars->Delete();
   cutScalars->Delete();
+  if ( cutCells )
+    {
+    cutCells->Delete();
+    }
 
   if ( this->GenerateCutScalars )
     {
@@ -996,6 +1080,25 @@ void vtkCutter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Generate Cut Scalars: "
      << (this->GenerateCutScalars ? "On\n" : "Off\n");
+  os << indent << "Use Scalar Tree: "
+     << (this->UseScalarTree ? "On\n" : "Off\n");
+  if ( this->ScalarTree )
+    {
+    os << indent << "Scalar Tree: " << this->ScalarTree << "\n";
+    }
+  else
+    {
+    os << indent << "Scalar Tree: (none)\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCutter::ReportReferences(vtkGarbageCollector* collector)
+{
+  this->Superclass::ReportReferences(collector);
+  // The scalar tree shares our input and is therefore involved in a
+  // reference loop.
+  vtkGarbageCollectorReport(collector, this->ScalarTree, "ScalarTree");
 }
 
 //-----------------------------------------------------------------------
@@ -35,9 +35,13 @@
 // with the dataset or 2) an implicit function associated with this class.
 // By default, if an implicit function is set it is used to clip the data
 // set, otherwise the dataset scalars are used to perform the clipping.
+//
+// Cutting unstructured data repeatedly with new values can be accelerated
+// with a vtkScalarTree built on the values of the implicit function (see
+// UseScalarTree).
 
 // .SECTION See Also
-// vtkImplicitFunction vtkClipPolyData
+// vtkImplicitFunction vtkClipPolyData vtkEdgePointLocator
 
 #ifndef __vtkCutter_h
 #define __vtkCutter_h
@@ -50,8 +54,10 @@
 #define VTK_SORT_BY_VALUE 0
 #define VTK_SORT_BY_CELL 1
 
+class vtkDoubleArray;
 class vtkImplicitFunction;
 class vtkIncrementalPointLocator;
+class vtkScalarTree;
 class vtkSynchronizedTemplates3D;
 class vtkSynchronizedTemplatesCutter3D;
 class vtkGridSynchronizedTemplates3D;
@@ -134,9 +140,29 @@ public:
   vtkGetMacro(GenerateCutScalars,int);
   vtkBooleanMacro(GenerateCutScalars,int);
 
+  // Description:
+  // Enable the use of a scalar tree to find the cells crossed by the cut
+  // surfaces. The tree is built on the values of the implicit function at
+  // the points, which are kept while the input and the implicit function
+  // are unchanged: cutting again with new values then only visits the
+  // cells the tree finds for them. Structured data cut with synchronized
+  // templates do not use it. Off by default.
+  vtkSetMacro(UseScalarTree,int);
+  vtkGetMacro(UseScalarTree,int);
+  vtkBooleanMacro(UseScalarTree,int);
+
+  // Description:
+  // Specify the scalar tree used when UseScalarTree is on. By default, a
+  // vtkSpanSpace is created.
+  virtual void SetScalarTree(vtkScalarTree*);
+  vtkGetObjectMacro(ScalarTree,vtkScalarTree);
+
   // Description:
   // Specify a spatial locator for merging points. By default,
   // an instance of vtkMergePoints is used.
+  // A vtkEdgePointLocator merges the points by the cell edge they are
+  // interpolated on instead of by coordinates: it is faster, needs no
+  // bounds, and never merges distinct points of thin cells.
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
 
@@ -177,6 +203,8 @@ protected:
   vtkCutter(vtkImplicitFunction *cf=NULL);
   ~vtkCutter();
 
+  virtual void ReportReferences(vtkGarbageCollector*);
+
   // Description:
   // Overridden to process REQUEST_UPDATE_EXTENT_INFORMATION.
   virtual int ProcessRequest(vtkInformation*,
@@ -193,6 +221,13 @@ protected:
                               vtkInformationVector *);
   void StructuredGridCutter(vtkDataSet *, vtkPolyData *);
   void RectilinearGridCutter(vtkDataSet *, vtkPolyData *);
+
+  // Description:
+  // Return the values of the cut function at the points of the input, as a
+  // new reference. With a scalar tree, the values are kept and returned
+  // again while the input and the cut function are unchanged.
+  vtkDoubleArray *ComputeCutScalars(vtkDataSet *input);
+
   vtkImplicitFunction *CutFunction;
 
   vtkSynchronizedTemplates3D *SynchronizedTemplates3D;
@@ -204,6 +239,10 @@ protected:
   int SortBy;
   vtkContourValues *ContourValues;
   int GenerateCutScalars;
+  int UseScalarTree;
+  vtkScalarTree *ScalarTree;
+  vtkDoubleArray *CutScalars; //values of the cut function kept for the tree
+  vtkTimeStamp CutScalarsTime;
 private:
   vtkCutter(const vtkCutter&);  // Not implemented.
   void operator=(const vtkCutter&);  // Not implemented.
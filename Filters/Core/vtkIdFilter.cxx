@@ -18,13 +18,36 @@
 #include "vtkDataSet.h"
 #include "vtkDataSet.h"
 #include "vtkIdTypeArray.h"
+#include "vtkImplicitArray.h"
+#include "vtkImplicitArrayFunctions.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 
+typedef vtkImplicitArray<vtkIdType, vtkIndexFunction> vtkIdFilterIds;
+
 vtkStandardNewMacro(vtkIdFilter);
 
+// Return a new array holding the ids 0 to num-1.
+static vtkDataArray *vtkIdFilterNewIds(vtkIdType num, int implicitIds)
+{
+  if (implicitIds)
+    {
+    vtkIdFilterIds *ids = vtkIdFilterIds::New();
+    ids->SetNumberOfTuples(num);
+    return ids;
+    }
+
+  vtkIdTypeArray *ids = vtkIdTypeArray::New();
+  ids->SetNumberOfValues(num);
+  for (vtkIdType id=0; id < num; id++)
+    {
+    ids->SetValue(id, id);
+    }
+  return ids;
+}
+
 // Construct object with PointIds and CellIds on; and ids being generated
 // as scalars.
 vtkIdFilter::vtkIdFilter()
@@ -34,6 +57,7 @@ vtkIdFilter::vtkIdFilter()
   this->FieldData = 0;
   this->IdsArrayName = NULL;
   this->SetIdsArrayName("vtkIdFilter_Ids");
+  this->ImplicitIds = 0;
 }
 
 vtkIdFilter::~vtkIdFilter()
@@ -62,9 +86,9 @@ int vtkIdFilter::RequestData(
   vtkDataSet *output = vtkDataSet::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts, numCells, id;
-  vtkIdTypeArray *ptIds;
-  vtkIdTypeArray *cellIds;
+  vtkIdType numPts, numCells;
+  vtkDataArray *ptIds;
+  vtkDataArray *cellIds;
   vtkPointData *inPD=input->GetPointData(), *outPD=output->GetPointData();
   vtkCellData *inCD=input->GetCellData(), *outCD=output->GetCellData();
 
@@ -82,14 +106,7 @@ int vtkIdFilter::RequestData(
   //
   if ( this->PointIds && numPts > 0 )
     {
-    ptIds = vtkIdTypeArray::New();
-    ptIds->SetNumberOfValues(numPts);
-
-    for (id=0; id < numPts; id++)
-      {
-      ptIds->SetValue(id, id);
-      }
-
+    ptIds = vtkIdFilterNewIds(numPts, this->ImplicitIds);
     ptIds->SetName(this->IdsArrayName);
     if ( ! this->FieldData )
       {
@@ -109,14 +126,7 @@ int vtkIdFilter::RequestData(
   //
   if ( this->CellIds && numCells > 0 )
     {
-    cellIds = vtkIdTypeArray::New();
-    cellIds->SetNumberOfValues(numCells);
-
-    for (id=0; id < numCells; id++)
-      {
-      cellIds->SetValue(id, id);
-      }
-
+    cellIds = vtkIdFilterNewIds(numCells, this->ImplicitIds);
     cellIds->SetName(this->IdsArrayName);
     if ( ! this->FieldData )
       {
@@ -147,4 +157,5 @@ void vtkIdFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Field Data: "   << (this->FieldData ? "On\n" : "Off\n");
   os << indent << "IdsArrayName: " << (this->IdsArrayName ? this->IdsArrayName
        : "(none)") << "\n";
+  os << indent << "Implicit Ids: " << (this->ImplicitIds ? "On\n" : "Off\n");
 }
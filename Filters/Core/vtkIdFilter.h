@@ -67,6 +67,15 @@ public:
   vtkSetStringMacro(IdsArrayName);
   vtkGetStringMacro(IdsArrayName);
 
+  // Description:
+  // When on, the generated ids are a vtkImplicitArray that returns the
+  // tuple index on demand, instead of a vtkIdTypeArray that stores them.
+  // Its data type is the integer type vtkIdType is defined as, rather than
+  // VTK_ID_TYPE. Off by default.
+  vtkSetMacro(ImplicitIds,int);
+  vtkGetMacro(ImplicitIds,int);
+  vtkBooleanMacro(ImplicitIds,int);
+
 protected:
   vtkIdFilter();
   ~vtkIdFilter();
@@ -77,6 +86,7 @@ protected:
   int CellIds;
   int FieldData;
   char *IdsArrayName;
+  int ImplicitIds;
 
 private:
   vtkIdFilter(const vtkIdFilter&);  // Not implemented.
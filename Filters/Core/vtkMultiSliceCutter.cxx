@@ -0,0 +1,512 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMultiSliceCutter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMultiSliceCutter.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCutter.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkEdgePointLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkObjectFactory.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkMultiSliceCutter);
+vtkCxxSetObjectMacro(vtkMultiSliceCutter,Plane,vtkPlane);
+
+//----------------------------------------------------------------------------
+// A cell cut by the slices of sorted indices First to Last - 1.
+struct vtkMultiSliceCutterCell
+{
+  vtkIdType CellId;
+  int First;
+  int Last;
+};
+
+//----------------------------------------------------------------------------
+vtkMultiSliceCutter::vtkMultiSliceCutter()
+{
+  this->Plane = NULL;
+  this->SliceValues = vtkContourValues::New();
+  this->GenerateMultiBlock = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkMultiSliceCutter::~vtkMultiSliceCutter()
+{
+  this->SetPlane(NULL);
+  this->SliceValues->Delete();
+}
+
+//----------------------------------------------------------------------------
+// Overload standard modified time function. If the plane or the slice
+// values are modified, then this object is modified as well.
+unsigned long vtkMultiSliceCutter::GetMTime()
+{
+  unsigned long mTime=this->Superclass::GetMTime();
+  unsigned long time=this->SliceValues->GetMTime();
+
+  mTime = ( time > mTime ? time : mTime );
+
+  if ( this->Plane != NULL )
+    {
+    time = this->Plane->GetMTime();
+    mTime = ( time > mTime ? time : mTime );
+    }
+
+  return mTime;
+}
+
+//----------------------------------------------------------------------------
+int vtkMultiSliceCutter::FillInputPortInformation(int, vtkInformation *info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMultiSliceCutter::FillOutputPortInformation(int, vtkInformation *info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataObject");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMultiSliceCutter::RequestDataObject(
+  vtkInformation *,
+  vtkInformationVector **,
+  vtkInformationVector *outputVector)
+{
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject *output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  const char *outputType =
+    (this->GenerateMultiBlock ? "vtkMultiBlockDataSet" : "vtkPolyData");
+
+  if ( !output || !output->IsA(outputType) )
+    {
+    if ( this->GenerateMultiBlock )
+      {
+      output = vtkMultiBlockDataSet::New();
+      }
+    else
+      {
+      output = vtkPolyData::New();
+      }
+    outInfo->Set(vtkDataObject::DATA_OBJECT(), output);
+    output->Delete();
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Copy the cells of a slice into outCells, renumbering their points from
+// the points of all the slices to the points of the slice. The points of
+// the slice are the points whose stamp is slice.
+static void vtkMultiSliceCutterCopyCells(vtkCellArray *cells,
+                                         vtkCellArray *outCells,
+                                         int slice,
+                                         std::vector<int> &stamps,
+                                         std::vector<vtkIdType> &pointMap,
+                                         vtkPoints *inPts, vtkPointData *inPD,
+                                         vtkPoints *outPts,
+                                         vtkPointData *outPD)
+{
+  vtkIdType npts, *pts;
+  std::vector<vtkIdType> newPts;
+
+  outCells->Allocate(cells->GetNumberOfConnectivityEntries());
+  for ( cells->InitTraversal(); cells->GetNextCell(npts,pts); )
+    {
+    newPts.resize(npts);
+    for ( vtkIdType i=0; i < npts; i++ )
+      {
+      vtkIdType ptId = pts[i];
+      if ( stamps[ptId] != slice )
+        {
+        stamps[ptId] = slice;
+        pointMap[ptId] = outPts->InsertNextPoint(inPts->GetPoint(ptId));
+        outPD->CopyData(inPD,ptId,pointMap[ptId]);
+        }
+      newPts[i] = pointMap[ptId];
+      }
+    outCells->InsertNextCell(npts,&newPts[0]);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Initial size of the arrays of a slice that gets its share of numCuts.
+static vtkIdType vtkMultiSliceCutterSliceSize(vtkIdType numCuts,
+                                              int numSlices)
+{
+  vtkIdType size = ( numSlices > 0 ? numCuts / numSlices : 0 );
+  return ( size < 256 ? 256 : size );
+}
+
+//----------------------------------------------------------------------------
+int vtkMultiSliceCutter::RequestData(
+  vtkInformation *,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkDataSet *input = vtkDataSet::GetData(inputVector[0]);
+  vtkDataObject *output = vtkDataObject::GetData(outputVector);
+  vtkPolyData *polyOutput = vtkPolyData::SafeDownCast(output);
+  vtkMultiBlockDataSet *mbOutput = vtkMultiBlockDataSet::SafeDownCast(output);
+
+  vtkDebugMacro(<< "Executing multi-slice cutter");
+
+  if ( !input || (!polyOutput && !mbOutput) )
+    {
+    vtkErrorMacro(<<"Bad input or output");
+    return 0;
+    }
+  if ( this->Plane == NULL )
+    {
+    vtkErrorMacro(<<"No plane specified");
+    return 0;
+    }
+
+  int numSlices = this->SliceValues->GetNumberOfContours();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType cellId, i;
+  int slice, s;
+  double x[3];
+
+  // Compute the signed distance of the points to the plane once for all
+  // the slices.
+  //
+  vtkDoubleArray *distances = vtkDoubleArray::New();
+  distances->SetNumberOfTuples(numPts);
+  double *distance = distances->GetPointer(0);
+  for ( i=0; i < numPts; i++ )
+    {
+    input->GetPoint(i,x);
+    distance[i] = this->Plane->FunctionValue(x);
+    }
+  this->UpdateProgress(0.1);
+
+  // Sort the slice values, remembering their index.
+  //
+  std::vector<std::pair<double,int> > sorted(numSlices);
+  std::vector<double> values(numSlices);
+  for ( slice=0; slice < numSlices; slice++ )
+    {
+    sorted[slice].first = this->SliceValues->GetValue(slice);
+    sorted[slice].second = slice;
+    }
+  std::sort(sorted.begin(), sorted.end());
+  for ( s=0; s < numSlices; s++ )
+    {
+    values[s] = sorted[s].first;
+    }
+
+  // Bucket the cells by dimension and by the range of sorted slices their
+  // points span. 0D cells are skipped since they cannot be cut. Cells of
+  // lower dimension are processed first since vtkPolyData numbers its verts,
+  // lines and polys in that order, and the cell data has to follow it.
+  //
+  unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+  vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
+  std::vector<vtkMultiSliceCutterCell> buckets[3];
+  vtkIdList *cellPts = vtkIdList::New();
+  vtkIdType numCuts = 0;
+  vtkIdType numDimensionCuts[3] = { 0, 0, 0 };
+  for ( cellId=0; cellId < numCells && numSlices > 0; cellId++ )
+    {
+    int cellType = input->GetCellType(cellId);
+    if ( cellType >= VTK_NUMBER_OF_CELL_TYPES )
+      { // Protect against new cell types added.
+      vtkErrorMacro("Unknown cell type " << cellType);
+      continue;
+      }
+    int dimension = cellTypeDimensions[cellType];
+    if ( dimension < 1 || dimension > 3 )
+      {
+      continue;
+      }
+    input->GetCellPoints(cellId,cellPts);
+    vtkIdType numCellPts = cellPts->GetNumberOfIds();
+    if ( numCellPts < 1 )
+      {
+      continue;
+      }
+    double range[2];
+    range[0] = range[1] = distance[cellPts->GetId(0)];
+    for ( i=1; i < numCellPts; i++ )
+      {
+      double d = distance[cellPts->GetId(i)];
+      range[0] = ( d < range[0] ? d : range[0] );
+      range[1] = ( d > range[1] ? d : range[1] );
+      }
+    vtkMultiSliceCutterCell cutCell;
+    cutCell.CellId = cellId;
+    cutCell.First = static_cast<int>(
+      std::lower_bound(values.begin(), values.end(), range[0]) -
+      values.begin());
+    cutCell.Last = static_cast<int>(
+      std::upper_bound(values.begin() + cutCell.First, values.end(),
+                       range[1]) - values.begin());
+    if ( cutCell.First < cutCell.Last )
+      {
+      buckets[dimension - 1].push_back(cutCell);
+      numDimensionCuts[dimension - 1] += cutCell.Last - cutCell.First;
+      numCuts += cutCell.Last - cutCell.First;
+      }
+    }
+  cellPts->Delete();
+  this->UpdateProgress(0.2);
+
+  // Create the objects holding each slice. The points and the point data
+  // are shared by all the slices, and merged by edge. They are sized from
+  // the number of cuts, and each slice from its share of the cuts: 2D cells
+  // give lines and 3D cells give polygons. The arrays grow as needed.
+  //
+  vtkIdType estimatedSize = ( numCuts < 1024 ? 1024 : numCuts );
+  vtkIdType sliceCells = vtkMultiSliceCutterSliceSize(numCuts, numSlices);
+  vtkIdType sliceLines =
+    vtkMultiSliceCutterSliceSize(numDimensionCuts[1], numSlices);
+  vtkIdType slicePolys =
+    vtkMultiSliceCutterSliceSize(numDimensionCuts[2], numSlices);
+
+  vtkPointData *inPD = input->GetPointData();
+  vtkCellData *inCD = input->GetCellData();
+  vtkPoints *newPoints = vtkPoints::New();
+  newPoints->Allocate(estimatedSize,estimatedSize);
+  vtkPointData *newPD = vtkPointData::New();
+  newPD->InterpolateAllocate(inPD,estimatedSize,estimatedSize);
+  vtkEdgePointLocator *locator = vtkEdgePointLocator::New();
+  locator->InitPointInsertion(newPoints, input->GetBounds(), estimatedSize);
+
+  std::vector<vtkCellArray*> newVerts(numSlices), newLines(numSlices);
+  std::vector<vtkCellArray*> newPolys(numSlices);
+  std::vector<vtkCellData*> newCD(numSlices);
+  for ( slice=0; slice < numSlices; slice++ )
+    {
+    newVerts[slice] = vtkCellArray::New();
+    newLines[slice] = vtkCellArray::New();
+    newLines[slice]->Allocate(newLines[slice]->EstimateSize(sliceLines,2));
+    newPolys[slice] = vtkCellArray::New();
+    newPolys[slice]->Allocate(newPolys[slice]->EstimateSize(slicePolys,3));
+    newCD[slice] = vtkCellData::New();
+    newCD[slice]->CopyAllocate(inCD,sliceCells,sliceCells);
+    }
+
+  // Traverse the cut cells once, contouring each of them with the slices
+  // it spans.
+  //
+  vtkGenericCell *cell = vtkGenericCell::New();
+  vtkDoubleArray *cellScalars = vtkDoubleArray::New();
+  vtkIdType progressInterval = numCuts/20 + 1;
+  vtkIdType cut = 0;
+  int abortExecute = 0;
+  for ( int dimension=0; dimension < 3 && !abortExecute; dimension++ )
+    {
+    std::vector<vtkMultiSliceCutterCell> &bucket = buckets[dimension];
+    for ( size_t idx=0; idx < bucket.size() && !abortExecute; idx++ )
+      {
+      const vtkMultiSliceCutterCell &cutCell = bucket[idx];
+      input->GetCell(cutCell.CellId,cell);
+      vtkIdList *cellIds = cell->GetPointIds();
+      vtkIdType numCellPts = cellIds->GetNumberOfIds();
+      cellScalars->SetNumberOfTuples(numCellPts);
+      for ( i=0; i < numCellPts; i++ )
+        {
+        cellScalars->SetValue(i,distance[cellIds->GetId(i)]);
+        }
+
+      for ( s=cutCell.First; s < cutCell.Last; s++ )
+        {
+        if ( !(++cut % progressInterval) )
+          {
+          vtkDebugMacro(<<"Cutting #" << cut);
+          this->UpdateProgress(0.2 + 0.7*cut/numCuts);
+          abortExecute = this->GetAbortExecute();
+          }
+        slice = sorted[s].second;
+        cell->Contour(values[s], cellScalars, locator,
+                      newVerts[slice], newLines[slice], newPolys[slice],
+                      inPD, newPD, inCD, cutCell.CellId, newCD[slice]);
+        }
+      }
+    std::vector<vtkMultiSliceCutterCell>().swap(bucket);
+    }
+  cell->Delete();
+  cellScalars->Delete();
+  distances->Delete();
+  locator->Delete();
+
+  // Assemble the slices.
+  //
+  if ( mbOutput )
+    {
+    std::vector<int> stamps(newPoints->GetNumberOfPoints(), -1);
+    std::vector<vtkIdType> pointMap(newPoints->GetNumberOfPoints());
+    mbOutput->SetNumberOfBlocks(numSlices);
+    for ( slice=0; slice < numSlices; slice++ )
+      {
+      vtkPolyData *sliceOutput = vtkPolyData::New();
+      vtkPoints *outPts = vtkPoints::New(newPoints->GetDataType());
+      vtkPointData *outPD = sliceOutput->GetPointData();
+      outPD->CopyAllocate(newPD);
+      vtkCellArray *cellArrays[3];
+      cellArrays[0] = newVerts[slice];
+      cellArrays[1] = newLines[slice];
+      cellArrays[2] = newPolys[slice];
+      for ( int j=0; j < 3; j++ )
+        {
+        if ( cellArrays[j]->GetNumberOfCells() < 1 )
+          {
+          continue;
+          }
+        vtkCellArray *outCells = vtkCellArray::New();
+        vtkMultiSliceCutterCopyCells(cellArrays[j], outCells, slice,
+                                     stamps, pointMap, newPoints, newPD,
+                                     outPts, outPD);
+        if ( j == 0 )
+          {
+          sliceOutput->SetVerts(outCells);
+          }
+        else if ( j == 1 )
+          {
+          sliceOutput->SetLines(outCells);
+          }
+        else
+          {
+          sliceOutput->SetPolys(outCells);
+          }
+        outCells->Delete();
+        }
+      sliceOutput->SetPoints(outPts);
+      outPts->Delete();
+      sliceOutput->GetCellData()->ShallowCopy(newCD[slice]);
+      sliceOutput->Squeeze();
+      mbOutput->SetBlock(slice, sliceOutput);
+      sliceOutput->Delete();
+      }
+    }
+  else
+    {
+    // Gather the verts of all the slices, then the lines, then the polys,
+    // copying the cell data of the slices in the same order.
+    //
+    vtkIdType numOutCells = 0;
+    for ( slice=0; slice < numSlices; slice++ )
+      {
+      numOutCells += newVerts[slice]->GetNumberOfCells() +
+        newLines[slice]->GetNumberOfCells() +
+        newPolys[slice]->GetNumberOfCells();
+      }
+    vtkCellData *outCD = polyOutput->GetCellData();
+    if ( numSlices > 0 )
+      {
+      outCD->CopyAllocate(newCD[0],numOutCells);
+      }
+    vtkIntArray *sliceIds = vtkIntArray::New();
+    sliceIds->SetName("SliceId");
+    sliceIds->SetNumberOfTuples(numOutCells);
+    vtkIdType outCellId = 0;
+
+    for ( int j=0; j < 3; j++ )
+      {
+      vtkCellArray *outCells = vtkCellArray::New();
+      for ( slice=0; slice < numSlices; slice++ )
+        {
+        vtkCellArray *cells = ( j == 0 ? newVerts[slice] :
+                                ( j == 1 ? newLines[slice] :
+                                  newPolys[slice] ) );
+        vtkIdType cellOffset = ( j < 1 ? 0 :
+                                 newVerts[slice]->GetNumberOfCells() ) +
+          ( j < 2 ? 0 : newLines[slice]->GetNumberOfCells() );
+        vtkIdType npts, *pts;
+        for ( cells->InitTraversal(), cellId=cellOffset;
+              cells->GetNextCell(npts,pts); cellId++ )
+          {
+          outCells->InsertNextCell(npts,pts);
+          outCD->CopyData(newCD[slice],cellId,outCellId);
+          sliceIds->SetValue(outCellId++,slice);
+          }
+        }
+      if ( outCells->GetNumberOfCells() > 0 )
+        {
+        if ( j == 0 )
+          {
+          polyOutput->SetVerts(outCells);
+          }
+        else if ( j == 1 )
+          {
+          polyOutput->SetLines(outCells);
+          }
+        else
+          {
+          polyOutput->SetPolys(outCells);
+          }
+        }
+      outCells->Delete();
+      }
+    outCD->AddArray(sliceIds);
+    sliceIds->Delete();
+
+    polyOutput->SetPoints(newPoints);
+    polyOutput->GetPointData()->ShallowCopy(newPD);
+    polyOutput->Squeeze();
+    }
+
+  for ( slice=0; slice < numSlices; slice++ )
+    {
+    newVerts[slice]->Delete();
+    newLines[slice]->Delete();
+    newPolys[slice]->Delete();
+    newCD[slice]->Delete();
+    }
+  newPoints->Delete();
+  newPD->Delete();
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMultiSliceCutter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  if ( this->Plane )
+    {
+    os << indent << "Plane: " << this->Plane << "\n";
+    }
+  else
+    {
+    os << indent << "Plane: (none)\n";
+    }
+
+  this->SliceValues->PrintSelf(os,indent.GetNextIndent());
+
+  os << indent << "Generate Multi Block: "
+     << (this->GenerateMultiBlock ? "On\n" : "Off\n");
+}
@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMultiSliceCutter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMultiSliceCutter - cut a dataset with many parallel planes at once
+// .SECTION Description
+// vtkMultiSliceCutter cuts a vtkDataSet with a stack of parallel planes,
+// the planes at the signed distances given by the slice values from a
+// vtkPlane. It produces the same slices as vtkCutter with the plane as cut
+// function and the same contour values, but the distance of the points to
+// the plane is computed once, each cell is bucketed by the range of slices
+// its points span, and all the slices are generated in a single traversal
+// of the cells, each cell being contoured only with the values it spans.
+// Cutting a dataset with hundreds of slices is then roughly as fast as
+// cutting it with a few.
+//
+// The output is a vtkPolyData holding all the slices, with a "SliceId"
+// cell array giving the index of the slice value of each cell, or, if
+// GenerateMultiBlock is on, a vtkMultiBlockDataSet with one vtkPolyData
+// block per slice value. The point data of the input is interpolated, and
+// the cell data copied, as vtkCutter does.
+//
+// .SECTION Caveats
+// The points of the slices are merged by edge with a vtkEdgePointLocator
+// shared by all the slices. Slices with the same value are generated
+// separately but share their points in the vtkPolyData output.
+//
+// .SECTION See Also
+// vtkCutter vtkPlane vtkContourValues vtkEdgePointLocator
+
+#ifndef __vtkMultiSliceCutter_h
+#define __vtkMultiSliceCutter_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkDataObjectAlgorithm.h"
+
+#include "vtkContourValues.h" // Needed for inline methods
+
+class vtkDataSet;
+class vtkPlane;
+class vtkPolyData;
+class vtkMultiBlockDataSet;
+
+class VTKFILTERSCORE_EXPORT vtkMultiSliceCutter : public vtkDataObjectAlgorithm
+{
+public:
+  vtkTypeMacro(vtkMultiSliceCutter,vtkDataObjectAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Construct with no plane, no slice value, and vtkPolyData output.
+  static vtkMultiSliceCutter *New();
+
+  // Description:
+  // Set a particular slice value at slice number i. The index i ranges
+  // between 0<=i<NumberOfSlices. The value is the signed distance of the
+  // slice to the plane, in units of the length of the plane normal.
+  void SetValue(int i, double value)
+    {this->SliceValues->SetValue(i,value);}
+
+  // Description:
+  // Get the ith slice value.
+  double GetValue(int i)
+    {return this->SliceValues->GetValue(i);}
+
+  // Description:
+  // Get a pointer to an array of slice values. There will be
+  // GetNumberOfSlices() values in the list.
+  double *GetValues()
+    {return this->SliceValues->GetValues();}
+
+  // Description:
+  // Fill a supplied list with slice values. There will be
+  // GetNumberOfSlices() values in the list. Make sure you allocate
+  // enough memory to hold the list.
+  void GetValues(double *sliceValues)
+    {this->SliceValues->GetValues(sliceValues);}
+
+  // Description:
+  // Set the number of slices to place into the list. You only really
+  // need to use this method to reduce list size. The method SetValue()
+  // will automatically increase list size as needed.
+  void SetNumberOfSlices(int number)
+    {this->SliceValues->SetNumberOfContours(number);}
+
+  // Description:
+  // Get the number of slices in the list of slice values.
+  int GetNumberOfSlices()
+    {return this->SliceValues->GetNumberOfContours();}
+
+  // Description:
+  // Generate numSlices equally spaced slice values between specified
+  // range. Slice values will include min/max range values.
+  void GenerateValues(int numSlices, double range[2])
+    {this->SliceValues->GenerateValues(numSlices, range);}
+  void GenerateValues(int numSlices, double rangeStart, double rangeEnd)
+    {this->SliceValues->GenerateValues(numSlices, rangeStart, rangeEnd);}
+
+  // Description:
+  // Override GetMTime because we delegate to vtkContourValues and refer to
+  // the plane.
+  unsigned long GetMTime();
+
+  // Description:
+  // Specify the plane the slices are parallel to.
+  virtual void SetPlane(vtkPlane*);
+  vtkGetObjectMacro(Plane,vtkPlane);
+
+  // Description:
+  // If on, the output is a vtkMultiBlockDataSet with one block per slice
+  // value, else a single vtkPolyData with a "SliceId" cell array. Off by
+  // default.
+  vtkSetMacro(GenerateMultiBlock,int);
+  vtkGetMacro(GenerateMultiBlock,int);
+  vtkBooleanMacro(GenerateMultiBlock,int);
+
+protected:
+  vtkMultiSliceCutter();
+  ~vtkMultiSliceCutter();
+
+  virtual int FillInputPortInformation(int port, vtkInformation *info);
+  virtual int FillOutputPortInformation(int port, vtkInformation *info);
+  virtual int RequestDataObject(vtkInformation *,
+                                vtkInformationVector **,
+                                vtkInformationVector *);
+  virtual int RequestData(vtkInformation *,
+                          vtkInformationVector **,
+                          vtkInformationVector *);
+
+  vtkPlane *Plane;
+  vtkContourValues *SliceValues;
+  int GenerateMultiBlock;
+
+private:
+  vtkMultiSliceCutter(const vtkMultiSliceCutter&);  // Not implemented.
+  void operator=(const vtkMultiSliceCutter&);  // Not implemented.
+};
+
+#endif
@@ -14,21 +14,29 @@
 =========================================================================*/
 #include "vtkProbeFilter.h"
 
+#include "vtkAbstractCellLocator.h"
 #include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkGenericCell.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLocatorScratch.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <vector>
 
 vtkStandardNewMacro(vtkProbeFilter);
+vtkCxxSetObjectMacro(vtkProbeFilter,CellLocator,vtkAbstractCellLocator);
 
 class vtkProbeFilter::vtkVectorOfArrays :
   public std::vector<vtkDataArray*>
@@ -52,11 +60,15 @@ vtkProbeFilter::vtkProbeFilter()
   this->CellList = 0;
 
   this->UseNullPoint = true;
+
+  this->CellLocator = NULL;
+  this->EnableSMP = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkProbeFilter::~vtkProbeFilter()
 {
+  this->SetCellLocator(NULL);
   this->MaskPoints->Delete();
   this->MaskPoints = 0;
   this->ValidPoints->Delete();
@@ -68,6 +80,21 @@ vtkProbeFilter::~vtkProbeFilter()
   delete this->CellList;
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkProbeFilter::GetMTime()
+{
+  unsigned long mTime=this->Superclass::GetMTime();
+  unsigned long time;
+
+  if ( this->CellLocator != NULL )
+    {
+    time = this->CellLocator->GetMTime();
+    mTime = ( time > mTime ? time : mTime );
+    }
+
+  return mTime;
+}
+
 //----------------------------------------------------------------------------
 void vtkProbeFilter::SetSourceConnection(vtkAlgorithmOutput* algOutput)
 {
@@ -216,17 +243,6 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
   pd = source->GetPointData();
   cd = source->GetCellData();
 
-  // lets use a stack allocated array if possible for performance reasons
-  int mcs = source->GetMaxCellSize();
-  if (mcs<=256)
-    {
-    weights = fastweights;
-    }
-  else
-    {
-    weights = new double[mcs];
-    }
-
   numPts = input->GetNumberOfPoints();
   outPD = output->GetPointData();
 
@@ -257,6 +273,23 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
   // Don't go below epsilon for a double
   tol2 = (tol2 < VTK_DBL_EPSILON) ? VTK_DBL_EPSILON : tol2;
 
+  if (this->CellLocator)
+    {
+    this->ProbePointsWithLocator(input, srcIdx, source, output, tol2);
+    return;
+    }
+
+  // lets use a stack allocated array if possible for performance reasons
+  int mcs = source->GetMaxCellSize();
+  if (mcs<=256)
+    {
+    weights = fastweights;
+    }
+  else
+    {
+    weights = new double[mcs];
+    }
+
   // Loop over all input points, interpolating source data
   //
   int abort=0;
@@ -323,6 +356,288 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
     }
 }
 
+//----------------------------------------------------------------------------
+// Probing with a cell locator. The points are divided into batches of
+// VTK_PROBE_FILTER_BATCH_SIZE points, and the points of each batch are
+// probed in the order of a Morton (Z-order) curve through the bounds of
+// the batch, so that consecutive queries visit the same cells and nodes of
+// the locator. Each point is written only by the batch that contains it,
+// in output arrays allocated to their full size beforehand, so that the
+// batches can be probed in parallel.
+static const vtkIdType VTK_PROBE_FILTER_BATCH_SIZE = 8192;
+
+// Spread the 10 low bits of v to every third bit.
+static vtkTypeUInt32 vtkProbeFilterSpreadBits(vtkTypeUInt32 v)
+{
+  v &= 0x3ff;
+  v = (v | (v << 16)) & 0x030000ff;
+  v = (v | (v << 8)) & 0x0300f00f;
+  v = (v | (v << 4)) & 0x030c30c3;
+  v = (v | (v << 2)) & 0x09249249;
+  return v;
+}
+
+// A point to probe, with its position along the Morton curve of its batch.
+class vtkProbeFilterQuery
+{
+public:
+  vtkTypeUInt32 Code;
+  vtkIdType PointId;
+  double X[3];
+
+  bool operator<(const vtkProbeFilterQuery& other) const
+  {
+    return this->Code < other.Code ||
+      (this->Code == other.Code && this->PointId < other.PointId);
+  }
+};
+
+// Per-thread scratch space.
+class vtkProbeFilterScratch
+{
+public:
+  vtkSmartPointer<vtkLocatorScratch> Locator;
+  std::vector<double> Weights;
+  std::vector<vtkProbeFilterQuery> Queries;
+};
+
+class vtkProbeFilterFunctor
+{
+public:
+  vtkProbeFilter *Filter;
+  vtkDataSet *Input;
+  vtkAbstractCellLocator *Locator;
+  double Tol2;
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfBatches;
+  int MaxCellSize;
+  char *Mask;
+  bool UseNullPoint;
+  // Whether the batches are probed in parallel, with the thread-safe
+  // FindCell() of the locator.
+  bool Threaded;
+
+  // Output and source arrays interpolated from the points, copied from the
+  // cells, and the output arrays nulled on a miss.
+  std::vector<vtkAbstractArray*> OutPointArrays, InPointArrays;
+  std::vector<vtkAbstractArray*> OutCellArrays, InCellArrays;
+  std::vector<vtkDataArray*> NullArrays;
+  std::vector<double> NullTuple;
+
+  vtkSMPThreadLocal<vtkProbeFilterScratch> Scratch;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkProbeFilterScratch &scratch = this->Scratch.Local();
+    if (!scratch.Locator)
+      {
+      scratch.Locator = vtkSmartPointer<vtkLocatorScratch>::New();
+      scratch.Weights.resize(this->MaxCellSize > 0 ? this->MaxCellSize : 1);
+      }
+    vtkGenericCell *cell = scratch.Locator->GetCell();
+    double *weights = &scratch.Weights[0];
+    std::vector<vtkProbeFilterQuery> &queries = scratch.Queries;
+    double pcoords[3];
+    size_t i, j;
+
+    for (vtkIdType batch = begin; batch < end; batch++)
+      {
+      if ( vtkSMPTools::GetThreadIndex() == 0 )
+        {
+        this->Filter->UpdateProgress(
+          static_cast<double>(batch)/this->NumberOfBatches);
+        }
+      if (this->Filter->GetAbortExecute())
+        {
+        return;
+        }
+
+      // Gather the points of the batch not probed yet, and their bounds.
+      vtkIdType ptId = batch*VTK_PROBE_FILTER_BATCH_SIZE;
+      vtkIdType last = ptId + VTK_PROBE_FILTER_BATCH_SIZE;
+      if (last > this->NumberOfPoints)
+        {
+        last = this->NumberOfPoints;
+        }
+      double bounds[6] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+                           VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+                           VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+      queries.clear();
+      for (; ptId < last; ptId++)
+        {
+        if (this->Mask[ptId] != 0)
+          {
+          continue;
+          }
+        vtkProbeFilterQuery query;
+        query.PointId = ptId;
+        this->Input->GetPoint(ptId, query.X);
+        for (j = 0; j < 3; j++)
+          {
+          bounds[2*j] = std::min(bounds[2*j], query.X[j]);
+          bounds[2*j+1] = std::max(bounds[2*j+1], query.X[j]);
+          }
+        queries.push_back(query);
+        }
+
+      // Sort them along the Morton curve.
+      double scale[3];
+      for (j = 0; j < 3; j++)
+        {
+        double length = bounds[2*j+1] - bounds[2*j];
+        scale[j] = (length > 0.0 ? 1023.0 / length : 0.0);
+        }
+      for (i = 0; i < queries.size(); i++)
+        {
+        vtkProbeFilterQuery &query = queries[i];
+        query.Code = 0;
+        for (j = 0; j < 3; j++)
+          {
+          vtkTypeUInt32 bin = static_cast<vtkTypeUInt32>(
+            (query.X[j] - bounds[2*j]) * scale[j]);
+          query.Code |= vtkProbeFilterSpreadBits(bin) << j;
+          }
+        }
+      std::sort(queries.begin(), queries.end());
+
+      for (i = 0; i < queries.size(); i++)
+        {
+        vtkProbeFilterQuery &query = queries[i];
+        vtkIdType cellId = this->Threaded ?
+          this->Locator->FindCell(query.X, this->Tol2, scratch.Locator,
+                                  pcoords, weights) :
+          this->Locator->FindCell(query.X, this->Tol2, cell,
+                                  pcoords, weights);
+        if (cellId >= 0)
+          {
+          vtkIdList *ptIds = cell->GetPointIds();
+          for (j = 0; j < this->OutPointArrays.size(); j++)
+            {
+            this->OutPointArrays[j]->InterpolateTuple(
+              query.PointId, ptIds, this->InPointArrays[j], weights);
+            }
+          for (j = 0; j < this->OutCellArrays.size(); j++)
+            {
+            this->OutCellArrays[j]->InsertTuple(
+              query.PointId, cellId, this->InCellArrays[j]);
+            }
+          // Marked 2 until the valid points are gathered in order.
+          this->Mask[query.PointId] = static_cast<char>(2);
+          }
+        else if (this->UseNullPoint)
+          {
+          for (j = 0; j < this->NullArrays.size(); j++)
+            {
+            this->NullArrays[j]->InsertTuple(query.PointId,
+                                             &this->NullTuple[0]);
+            }
+          }
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+void vtkProbeFilter::ProbePointsWithLocator(vtkDataSet *input, int srcIdx,
+                                            vtkDataSet *source,
+                                            vtkDataSet *output, double tol2)
+{
+  vtkPointData *pd = source->GetPointData();
+  vtkCellData *cd = source->GetCellData();
+  vtkPointData *outPD = output->GetPointData();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  int i;
+
+  // Build the locator, unless it is up to date with the source.
+  this->CellLocator->SetDataSet(source);
+  this->CellLocator->Update();
+
+  vtkProbeFilterFunctor functor;
+  functor.Filter = this;
+  functor.Input = input;
+  functor.Locator = this->CellLocator;
+  functor.Tol2 = tol2;
+  functor.NumberOfPoints = numPts;
+  functor.NumberOfBatches =
+    (numPts + VTK_PROBE_FILTER_BATCH_SIZE - 1) / VTK_PROBE_FILTER_BATCH_SIZE;
+  functor.MaxCellSize = source->GetMaxCellSize();
+  functor.Mask = this->MaskPoints->GetPointer(0);
+  functor.UseNullPoint = this->UseNullPoint;
+
+  // Size the output arrays for all the points, so that they are never
+  // reallocated while probing. Check that they can be written from several
+  // threads.
+  bool threadSafe = !this->CellLocator->GetLazyEvaluation();
+  int maxNumComps = 1;
+  for (i = 0; i < outPD->GetNumberOfArrays(); i++)
+    {
+    vtkAbstractArray *array = outPD->GetAbstractArray(i);
+    if (array->GetNumberOfTuples() < numPts)
+      {
+      array->Resize(numPts);
+      array->SetNumberOfTuples(numPts);
+      }
+    vtkDataArray *dataArray = vtkDataArray::SafeDownCast(array);
+    if (!dataArray || dataArray->GetDataType() == VTK_BIT ||
+        !dataArray->HasStandardMemoryLayout())
+      {
+      threadSafe = false;
+      }
+    if (dataArray && array != this->MaskPoints)
+      {
+      functor.NullArrays.push_back(dataArray);
+      maxNumComps = std::max(maxNumComps,
+                             dataArray->GetNumberOfComponents());
+      }
+    }
+  functor.NullTuple.resize(maxNumComps, 0.0);
+
+  for (i = 0; i < this->PointList->GetNumberOfFields(); i++)
+    {
+    if (this->PointList->GetFieldIndex(i) >= 0 &&
+        this->PointList->GetDSAIndex(srcIdx, i) >= 0)
+      {
+      functor.OutPointArrays.push_back(
+        outPD->GetAbstractArray(this->PointList->GetFieldIndex(i)));
+      functor.InPointArrays.push_back(
+        pd->GetAbstractArray(this->PointList->GetDSAIndex(srcIdx, i)));
+      }
+    }
+  vtkVectorOfArrays::iterator iter;
+  for (iter = this->CellArrays->begin(); iter != this->CellArrays->end();
+    ++iter)
+    {
+    vtkDataArray* inArray = cd->GetArray((*iter)->GetName());
+    if (inArray)
+      {
+      functor.OutCellArrays.push_back(*iter);
+      functor.InCellArrays.push_back(inArray);
+      }
+    }
+
+  functor.Threaded = this->EnableSMP && threadSafe;
+  if (functor.Threaded)
+    {
+    vtkSMPTools::For(0, functor.NumberOfBatches, 1, functor);
+    }
+  else
+    {
+    functor(0, functor.NumberOfBatches);
+    }
+
+  // Gather the valid points in increasing order.
+  char *maskArray = this->MaskPoints->GetPointer(0);
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+    if (maskArray[ptId] == static_cast<char>(2))
+      {
+      this->ValidPoints->InsertNextValue(ptId);
+      this->NumberOfValidPoints++;
+      maskArray[ptId] = static_cast<char>(1);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkProbeFilter::RequestInformation(
   vtkInformation *vtkNotUsed(request),
@@ -514,4 +829,6 @@ void vtkProbeFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ValidPointMaskArrayName: " << (this->ValidPointMaskArrayName?
     this->ValidPointMaskArrayName : "vtkValidPointMask") << "\n";
   os << indent << "ValidPoints: " << this->ValidPoints << "\n";
+  os << indent << "CellLocator: " << this->CellLocator << "\n";
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On" : "Off") << "\n";
 }
@@ -31,6 +31,16 @@
 // rendering techniques can be used to visualize the results. Another example:
 // a line or curve can be used to probe data to produce x-y plots along
 // that line or curve.
+//
+// By default the cell containing each point is found with the FindCell()
+// method of the source. A cell locator (e.g. vtkCellLocator,
+// vtkCellTreeLocator or vtkModifiedBSPTree) can be given instead with
+// SetCellLocator(). It is built on the source at the first execution and
+// reused by the following ones as long as the source and the locator are
+// not modified. With a cell locator the points are probed in batches, in
+// the order of a space-filling curve through each batch so that points
+// close in space are located one after the other, and the batches are
+// probed in parallel with vtkSMPTools if EnableSMP is on.
 
 #ifndef __vtkProbeFilter_h
 #define __vtkProbeFilter_h
@@ -39,6 +49,7 @@
 #include "vtkDataSetAlgorithm.h"
 #include "vtkDataSetAttributes.h" // needed for vtkDataSetAttributes::FieldList
 
+class vtkAbstractCellLocator;
 class vtkIdTypeArray;
 class vtkCharArray;
 class vtkMaskPoints;
@@ -86,6 +97,34 @@ public:
   vtkSetStringMacro(ValidPointMaskArrayName)
   vtkGetStringMacro(ValidPointMaskArrayName)
 
+  // Description:
+  // Set the locator used to find the cells of the source containing the
+  // points. The locator is (re)built only when the source or the locator
+  // were modified since it was last built, so that it is shared by the
+  // executions of the filter. When probing a composite source, it is
+  // rebuilt on each block. By default there is no cell locator and the
+  // FindCell() method of the source is used.
+  virtual void SetCellLocator(vtkAbstractCellLocator*);
+  vtkGetObjectMacro(CellLocator, vtkAbstractCellLocator);
+
+  // Description:
+  // When on, and a cell locator is set, probe the points with multiple
+  // threads using vtkSMPTools. The thread-safe FindCell() method of the
+  // locator, which takes a vtkLocatorScratch, is then called from several
+  // threads. vtkCellLocator, vtkCellTreeLocator and vtkModifiedBSPTree run
+  // these calls concurrently, other locators serialize them. The points
+  // are probed serially if the locator uses lazy evaluation, or if the
+  // source has attributes that cannot be written from several threads,
+  // such as bit or string arrays. The output does not depend on the number
+  // of threads. Off by default.
+  vtkSetMacro(EnableSMP, int);
+  vtkGetMacro(EnableSMP, int);
+  vtkBooleanMacro(EnableSMP, int);
+
+  // Description:
+  // Override GetMTime because we refer to the cell locator.
+  unsigned long GetMTime();
+
 //BTX
 protected:
   vtkProbeFilter();
@@ -120,6 +159,12 @@ protected:
   void ProbeEmptyPoints(vtkDataSet *input, int srcIdx, vtkDataSet *source,
     vtkDataSet *output);
 
+  // Description:
+  // Probe the points marked as not-probed with the cell locator, in
+  // batches. Called by ProbeEmptyPoints() when a cell locator is set.
+  void ProbePointsWithLocator(vtkDataSet *input, int srcIdx,
+    vtkDataSet *source, vtkDataSet *output, double tol2);
+
   char* ValidPointMaskArrayName;
   vtkIdTypeArray *ValidPoints;
   vtkCharArray* MaskPoints;
@@ -133,6 +178,9 @@ protected:
 
   vtkDataSetAttributes::FieldList* CellList;
   vtkDataSetAttributes::FieldList* PointList;
+
+  vtkAbstractCellLocator *CellLocator;
+  int EnableSMP;
 private:
   vtkProbeFilter(const vtkProbeFilter&);  // Not implemented.
   void operator=(const vtkProbeFilter&);  // Not implemented.
@@ -16,15 +16,18 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkGarbageCollector.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSpanSpace.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 vtkStandardNewMacro(vtkThreshold);
+vtkCxxSetObjectMacro(vtkThreshold,ScalarTree,vtkScalarTree);
 
 // Construct with lower threshold=0, upper threshold=1, and threshold
 // function=upper AllScalars=1.
@@ -38,6 +41,8 @@ vtkThreshold::vtkThreshold()
   this->ComponentMode          = VTK_COMPONENT_MODE_USE_SELECTED;
   this->SelectedComponent      = 0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->UseScalarTree          = 0;
+  this->ScalarTree             = NULL;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS_THEN_CELLS,
@@ -49,6 +54,7 @@ vtkThreshold::vtkThreshold()
 
 vtkThreshold::~vtkThreshold()
 {
+  this->SetScalarTree(NULL);
 }
 
 // Criterion is cells whose scalars are less or equal to lower threshold.
@@ -173,9 +179,43 @@ int vtkThreshold::RequestData(
   // are we using pointScalars?
   usePointScalars = (inScalars->GetNumberOfTuples() == numPts);
 
+  // If enabled, use a scalar tree to only check the cells whose scalar
+  // range intersects the thresholds, in the same order.
+  vtkIdList *cellIds = NULL;
+  vtkIdType numCellIds = input->GetNumberOfCells();
+  if ( this->UseScalarTree && usePointScalars &&
+       inScalars->GetNumberOfComponents() == 1 && numCellIds > 0 )
+    {
+    if ( this->ScalarTree == NULL )
+      {
+      this->ScalarTree = vtkSpanSpace::New();
+      }
+    this->ScalarTree->SetDataSet(input);
+    this->ScalarTree->SetScalars(inScalars);
+    double lower = -VTK_DOUBLE_MAX;
+    double upper = VTK_DOUBLE_MAX;
+    if ( this->ThresholdFunction == &vtkThreshold::Lower )
+      {
+      upper = this->LowerThreshold;
+      }
+    else if ( this->ThresholdFunction == &vtkThreshold::Upper )
+      {
+      lower = this->UpperThreshold;
+      }
+    else
+      {
+      lower = this->LowerThreshold;
+      upper = this->UpperThreshold;
+      }
+    cellIds = vtkIdList::New();
+    this->ScalarTree->FindCellsInRange(lower, upper, cellIds);
+    numCellIds = cellIds->GetNumberOfIds();
+    }
+
   // Check that the scalars of each cell satisfy the threshold criterion
-  for (cellId=0; cellId < input->GetNumberOfCells(); cellId++)
+  for (vtkIdType idx=0; idx < numCellIds; idx++)
     {
+    cellId = (cellIds ? cellIds->GetId(idx) : idx);
     cell = input->GetCell(cellId);
     cellPts = cell->GetPointIds();
     numCellPts = cell->GetNumberOfPoints();
@@ -243,6 +283,10 @@ int vtkThreshold::RequestData(
   // now clean up / update ourselves
   pointMap->Delete();
   newCellPts->Delete();
+  if ( cellIds )
+    {
+    cellIds->Delete();
+    }
 
   output->SetPoints(newPoints);
   newPoints->Delete();
@@ -390,6 +434,25 @@ void vtkThreshold::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Upper Threshold: " << this->UpperThreshold << "\n";
   os << indent << "Precision of the output points: "
      << this->OutputPointsPrecision << "\n";
+  os << indent << "Use Scalar Tree: "
+     << (this->UseScalarTree ? "On\n" : "Off\n");
+  if ( this->ScalarTree )
+    {
+    os << indent << "Scalar Tree: " << this->ScalarTree << "\n";
+    }
+  else
+    {
+    os << indent << "Scalar Tree: (none)\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkThreshold::ReportReferences(vtkGarbageCollector* collector)
+{
+  this->Superclass::ReportReferences(collector);
+  // The scalar tree shares our input and is therefore involved in a
+  // reference loop.
+  vtkGarbageCollectorReport(collector, this->ScalarTree, "ScalarTree");
 }
 
 //----------------------------------------------------------------------------
@@ -397,6 +460,11 @@ int vtkThreshold::ProcessRequest(vtkInformation* request,
                                      vtkInformationVector** inputVector,
                                      vtkInformationVector* outputVector)
 {
+  if(request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_MEMORY_ESTIMATE()))
+    {
+    return this->RequestMemoryEstimate(request, inputVector, outputVector);
+    }
+
   // generate the data
   if(request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT_INFORMATION()))
     {
@@ -405,29 +473,7 @@ int vtkThreshold::ProcessRequest(vtkInformation* request,
     vtkInformation *outInfo = outputVector->GetInformationObject(0);
 
     // get the range of the input if available
-    vtkInformation *fInfo = NULL;
-    vtkDataArray *inscalars = this->GetInputArrayToProcess(0, inputVector);
-    if (inscalars)
-      {
-      vtkInformationVector *miv = inInfo->Get(vtkDataObject::POINT_DATA_VECTOR());
-      for (int index = 0; index < miv->GetNumberOfInformationObjects(); index++)
-        {
-        vtkInformation *mInfo = miv->GetInformationObject(index);
-        const char *minfo_arrayname =
-          mInfo->Get(vtkDataObject::FIELD_ARRAY_NAME());
-        if (minfo_arrayname && !strcmp(minfo_arrayname, inscalars->GetName()))
-          {
-          fInfo = mInfo;
-          break;
-          }
-        }
-      }
-    else
-      {
-      fInfo = vtkDataObject::GetActiveFieldInformation
-        (inInfo, vtkDataObject::FIELD_ASSOCIATION_POINTS,
-         vtkDataSetAttributes::SCALARS);
-      }
+    vtkInformation *fInfo = this->GetInputFieldInformation(inputVector);
     if (!fInfo)
       {
       return 1;
@@ -497,3 +543,97 @@ int vtkThreshold::ProcessRequest(vtkInformation* request,
     }
   return this->Superclass::ProcessRequest(request, inputVector, outputVector);
 }
+
+//----------------------------------------------------------------------------
+vtkInformation* vtkThreshold::GetInputFieldInformation(
+  vtkInformationVector** inputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkDataArray *inscalars = this->GetInputArrayToProcess(0, inputVector);
+  if (inscalars)
+    {
+    vtkInformationVector *miv = inInfo->Get(vtkDataObject::POINT_DATA_VECTOR());
+    for (int index = 0; miv && index < miv->GetNumberOfInformationObjects();
+         index++)
+      {
+      vtkInformation *mInfo = miv->GetInformationObject(index);
+      const char *minfo_arrayname =
+        mInfo->Get(vtkDataObject::FIELD_ARRAY_NAME());
+      if (minfo_arrayname && inscalars->GetName() &&
+          !strcmp(minfo_arrayname, inscalars->GetName()))
+        {
+        return mInfo;
+        }
+      }
+    return NULL;
+    }
+  return vtkDataObject::GetActiveFieldInformation
+    (inInfo, vtkDataObject::FIELD_ASSOCIATION_POINTS,
+     vtkDataSetAttributes::SCALARS);
+}
+
+//----------------------------------------------------------------------------
+int vtkThreshold::RequestMemoryEstimate(vtkInformation*,
+                                        vtkInformationVector** inputVector,
+                                        vtkInformationVector* outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  if (!inInfo ||
+      !inInfo->Has(vtkStreamingDemandDrivenPipeline::ESTIMATED_NUMBER_OF_CELLS()) ||
+      !inInfo->Has(vtkStreamingDemandDrivenPipeline::ESTIMATED_NUMBER_OF_POINTS()))
+    {
+    return 1;
+    }
+
+  // The fraction of the cells kept is that of the scalar range selected
+  // by the criterion when the range is known, else one half.
+  double fraction = 0.5;
+  vtkInformation *fInfo = this->GetInputFieldInformation(inputVector);
+  double *range = fInfo ? fInfo->Get(vtkDataObject::PIECE_FIELD_RANGE()) : 0;
+  if (range && range[1] > range[0])
+    {
+    // Interval of the values selected, clamped to the range.
+    double lower = range[0];
+    double upper = range[1];
+    if (this->ThresholdFunction == &vtkThreshold::Lower)
+      {
+      upper = this->LowerThreshold;
+      }
+    else if (this->ThresholdFunction == &vtkThreshold::Upper)
+      {
+      lower = this->UpperThreshold;
+      }
+    else
+      {
+      lower = this->LowerThreshold;
+      upper = this->UpperThreshold;
+      }
+    lower = lower > range[0] ? lower : range[0];
+    upper = upper < range[1] ? upper : range[1];
+    fraction = upper > lower ? (upper - lower) / (range[1] - range[0]) : 0.0;
+    }
+
+  // The output is an unstructured grid: each kept cell stores its type,
+  // location and connectivity, with eight points for the hexahedra of
+  // structured inputs and four otherwise.
+  int cellSize = 4;
+  if (inInfo->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()))
+    {
+    cellSize = 8;
+    }
+  double bytesPerCell = 1 + (2 + cellSize) * sizeof(vtkIdType);
+  double bytesPerPoint =
+    3 * (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION ?
+         sizeof(double) : sizeof(float)) +
+    vtkStreamingDemandDrivenPipeline::GetEstimatedPointDataSize(inInfo);
+
+  vtkIdType numCells =
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::ESTIMATED_NUMBER_OF_CELLS());
+  vtkIdType numPoints =
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::ESTIMATED_NUMBER_OF_POINTS());
+  vtkStreamingDemandDrivenPipeline::SetEstimatedOutputSize(
+    outInfo, static_cast<vtkIdType>(fraction * numPoints),
+    static_cast<vtkIdType>(fraction * numCells), bytesPerPoint, bytesPerCell);
+  return 1;
+}
@@ -27,6 +27,9 @@
 //
 // By default only the first scalar value is used in the decision. Use the ComponentMode
 // and SelectedComponent ivars to control this behavior.
+//
+// Thresholding a dataset repeatedly with new values can be accelerated
+// with a vtkScalarTree (see UseScalarTree).
 
 // .SECTION See Also
 // vtkThresholdPoints vtkThresholdTextureCoords
@@ -47,6 +50,7 @@
 #define VTK_COMPONENT_MODE_USE_ANY         2
 
 class vtkDataArray;
+class vtkScalarTree;
 
 class VTKFILTERSCORE_EXPORT vtkThreshold : public vtkUnstructuredGridAlgorithm
 {
@@ -123,6 +127,22 @@ public:
   vtkGetMacro(AllScalars,int);
   vtkBooleanMacro(AllScalars,int);
 
+  // Description:
+  // Enable the use of a scalar tree to only check the cells whose scalar
+  // range intersects the thresholds. The tree is kept between executions,
+  // so that thresholding the same dataset with new values only visits
+  // these cells. Only used with single component point scalars. Off by
+  // default.
+  vtkSetMacro(UseScalarTree,int);
+  vtkGetMacro(UseScalarTree,int);
+  vtkBooleanMacro(UseScalarTree,int);
+
+  // Description:
+  // Specify the scalar tree used when UseScalarTree is on. By default, a
+  // vtkSpanSpace is created.
+  virtual void SetScalarTree(vtkScalarTree*);
+  vtkGetObjectMacro(ScalarTree,vtkScalarTree);
+
   // Description:
   // Set the data type of the output points (See the data types defined in
   // vtkType.h). The default data type is float.
@@ -147,11 +167,22 @@ protected:
   vtkThreshold();
   ~vtkThreshold();
 
+  virtual void ReportReferences(vtkGarbageCollector*);
+
   // Usual data generation method
   virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
 
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  // Description:
+  // Estimate the size of the output from the estimated size of the input
+  // and the part of the scalar range selected by the criterion.  Called
+  // for vtkStreamingDemandDrivenPipeline::REQUEST_MEMORY_ESTIMATE().
+  virtual int RequestMemoryEstimate(vtkInformation *, vtkInformationVector **,
+                                    vtkInformationVector *);
+
+  // Pipeline information of the point array to process, if any.
+  vtkInformation* GetInputFieldInformation(vtkInformationVector **);
 
   int    AllScalars;
   double LowerThreshold;
@@ -160,6 +191,8 @@ protected:
   int    ComponentMode;
   int    SelectedComponent;
   int OutputPointsPrecision;
+  int UseScalarTree;
+  vtkScalarTree *ScalarTree;
 
   //BTX
   int (vtkThreshold::*ThresholdFunction)(double s);
@@ -15,6 +15,7 @@
 #include "vtkVectorNorm.h"
 
 #include "vtkCellData.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
@@ -26,6 +27,35 @@
 
 vtkStandardNewMacro(vtkVectorNorm);
 
+// Compute the norms of the vectors, whatever the memory layout of the
+// array the accessor is bound to, and return the largest one.
+template <class Accessor>
+double vtkVectorNormCompute(vtkVectorNorm *self, Accessor vectors,
+                            float *norms, double progressStart)
+{
+  vtkIdType numVectors = vectors.GetNumberOfTuples();
+  vtkIdType progressInterval = numVectors/10+1;
+  double maxScalar = 0.0;
+  for (vtkIdType i=0; i < numVectors; i++)
+    {
+    double v0 = static_cast<double>(vectors.Get(i, 0));
+    double v1 = static_cast<double>(vectors.Get(i, 1));
+    double v2 = static_cast<double>(vectors.Get(i, 2));
+    double s = sqrt(v0*v0 + v1*v1 + v2*v2);
+    if ( s > maxScalar )
+      {
+      maxScalar = s;
+      }
+    norms[i] = static_cast<float>(s);
+
+    if ( ! (i % progressInterval) )
+      {
+      self->UpdateProgress (progressStart + 0.5*i/numVectors);
+      }
+    }
+  return maxScalar;
+}
+
 // Construct with normalize flag off.
 vtkVectorNorm::vtkVectorNorm()
 {
@@ -51,7 +81,7 @@ int vtkVectorNorm::RequestData(
   vtkIdType numVectors, i;
   int computePtScalars=1, computeCellScalars=1;
   vtkFloatArray *newScalars;
-  double v[3], s, maxScalar;
+  double maxScalar;
   vtkDataArray *ptVectors, *cellVectors;
   vtkPointData *pd=input->GetPointData(), *outPD=output->GetPointData();
   vtkCellData *cd=input->GetCellData(), *outCD=output->GetCellData();
@@ -81,40 +111,23 @@ int vtkVectorNorm::RequestData(
     }
 
   // Allocate / operate on point data
-  int abort=0;
-  vtkIdType progressInterval;
   if ( computePtScalars )
     {
     numVectors = ptVectors->GetNumberOfTuples();
     newScalars = vtkFloatArray::New();
     newScalars->SetNumberOfTuples(numVectors);
+    float *norms = newScalars->GetPointer(0);
 
-    progressInterval=numVectors/10+1;
-    for (maxScalar=0.0, i=0; i < numVectors && !abort; i++)
-      {
-      ptVectors->GetTuple(i, v);
-      s = sqrt((double)v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
-      if ( s > maxScalar )
-        {
-        maxScalar = s;
-        }
-      newScalars->SetComponent(i,0,s);
-
-      if ( ! (i % progressInterval) )
-        {
-        vtkDebugMacro(<<"Computing point vector norm #" << i);
-        this->UpdateProgress (0.5*i/numVectors);
-        }
-      }
+    maxScalar = 0.0;
+    vtkDataArrayAccessorMacro(ptVectors,
+      maxScalar = vtkVectorNormCompute(this, vtk_accessor, norms, 0.0));
 
     // If necessary, normalize
     if ( this->Normalize && maxScalar > 0.0 )
       {
       for (i=0; i < numVectors; i++)
         {
-        s = newScalars->GetComponent(i,0);
-        s /= maxScalar;
-        newScalars->SetComponent(i,0,s);
+        norms[i] = static_cast<float>(norms[i] / maxScalar);
         }
       }
 
@@ -130,32 +143,18 @@ int vtkVectorNorm::RequestData(
     numVectors = cellVectors->GetNumberOfTuples();
     newScalars = vtkFloatArray::New();
     newScalars->SetNumberOfTuples(numVectors);
+    float *norms = newScalars->GetPointer(0);
 
-    progressInterval=numVectors/10+1;
-    for (maxScalar=0.0, i=0; i < numVectors && !abort; i++)
-      {
-      cellVectors->GetTuple(i, v);
-      s = sqrt((double)v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
-      if ( s > maxScalar )
-        {
-        maxScalar = s;
-        }
-      newScalars->SetComponent(i,0,s);
-      if ( ! (i % progressInterval) )
-        {
-        vtkDebugMacro(<<"Computing cell vector norm #" << i);
-        this->UpdateProgress (0.5+0.5*i/numVectors);
-        }
-      }
+    maxScalar = 0.0;
+    vtkDataArrayAccessorMacro(cellVectors,
+      maxScalar = vtkVectorNormCompute(this, vtk_accessor, norms, 0.5));
 
     // If necessary, normalize
     if ( this->Normalize && maxScalar > 0.0 )
       {
       for (i=0; i < numVectors; i++)
         {
-        s = newScalars->GetComponent(i,0);
-        s /= maxScalar;
-        newScalars->SetComponent(i,0,s);
+        norms[i] = static_cast<float>(norms[i] / maxScalar);
         }
       }
 
@@ -18,6 +18,7 @@
 #include "vtkPolyData.h"
 #include "vtkGenericCell.h"
 #include "vtkIdListCollection.h"
+#include "vtkLocatorScratch.h"
 
 #include <stack>
 #include <vector>
@@ -666,23 +667,39 @@ int vtkModifiedBSPTree::IntersectWithLine(double p1[3],
                                           vtkIdType &cellId,
                                           vtkGenericCell *cell)
 {
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-    {
-    this->DataSet->GetCell(cellId, cell);
-    }
-  return hit;
+  this->BuildLocatorIfNeeded();
+  return this->IntersectWithLineInternal(p1, p2, tol, t, x, pcoords, subId, cellId, cell);
 }
 //---------------------------------------------------------------------------
 int vtkModifiedBSPTree::IntersectWithLine(double p1[3], double p2[3], double tol,
                                           double &t, double x[3], double pcoords[3], int &subId, vtkIdType &cellId)
+{
+  this->BuildLocatorIfNeeded();
+  return this->IntersectWithLineInternal(p1, p2, tol, t, x, pcoords, subId, cellId, this->GenericCell);
+}
+//---------------------------------------------------------------------------
+int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+                                          double &t, double x[3], double pcoords[3], int &subId, vtkIdType &cellId,
+                                          vtkLocatorScratch *scratch) const
+{
+  return this->IntersectWithLineInternal(p1, p2, tol, t, x, pcoords, subId, cellId, scratch->GetCell());
+}
+//---------------------------------------------------------------------------
+// The cells are tested in the given cell, so that concurrent queries
+// do not interfere. On a hit, it is left with the cell hit.
+int vtkModifiedBSPTree::IntersectWithLineInternal(const double p1[3], const double p2[3], double tol,
+                                                  double &t, double x[3], double pcoords[3], int &subId, vtkIdType &cellId,
+                                                  vtkGenericCell *cell) const
 {
   //
   BSPNode  *node, *Near, *Mid, *Far;
   double    ctmin, ctmax, tmin, tmax, _tmin, _tmax, tDist;
   double    ray_vec[3] = { p2[0]-p1[0], p2[1]-p1[1], p2[2]-p1[2] };
   //
-  this->BuildLocatorIfNeeded();
+  if (!this->mRoot)
+    {
+    return false;
+    }
   //
   // Does ray pass through root BBox
   tmin = 0; tmax = 1;
@@ -759,7 +776,8 @@ int vtkModifiedBSPTree::IntersectWithLine(double p1[3], double p2[3], double tol
         node = Near;
         }
       }
-    double t_hit, ipt[3];
+    double t_hit, ipt[3], cell_pcoords[3];
+    int cell_subId;
     // Ok, so we're a leaf node, first check the BBox against the ray
     // then test the candidates in our sorted ray direction order
     _tmin = tmin; _tmax = tmax;
@@ -779,7 +797,7 @@ int vtkModifiedBSPTree::IntersectWithLine(double p1[3], double p2[3], double tol
       ctmin = _tmin; ctmax = _tmax;
       if (BSPNode::RayMinMaxT(CellBounds[cell_ID], p1, ray_vec, ctmin, ctmax))
         {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, cell_pcoords, cell_subId, cell))
           {
           if (t_hit<closest_intersection)
             {
@@ -789,6 +807,10 @@ int vtkModifiedBSPTree::IntersectWithLine(double p1[3], double p2[3], double tol
             x[0] = ipt[0];
             x[1] = ipt[1];
             x[2] = ipt[2];
+            pcoords[0] = cell_pcoords[0];
+            pcoords[1] = cell_pcoords[1];
+            pcoords[2] = cell_pcoords[2];
+            subId = cell_subId;
             }
           }
         }
@@ -798,6 +820,7 @@ int vtkModifiedBSPTree::IntersectWithLine(double p1[3], double p2[3], double tol
   if (HIT)
     {
     t = closest_intersection;
+    this->DataSet->GetCell(cellId, cell);
     }
   //
   return HIT;
@@ -933,7 +956,7 @@ int vtkModifiedBSPTree::IntersectWithLine(
       ctmin = _tmin; ctmax = _tmax;
       if (BSPNode::RayMinMaxT(CellBounds[cell_ID], p1, ray_vec, ctmin, ctmax))
         {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, this->GenericCell))
           {
           if (points)
             {
@@ -987,10 +1010,11 @@ int vtkModifiedBSPTree::IntersectCellInternal(
   double &t,
   double ipt[3],
   double pcoords[3],
-  int &subId)
+  int &subId,
+  vtkGenericCell *cell) const
 {
-  this->DataSet->GetCell(cell_ID, this->GenericCell);
-  return this->GenericCell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
 //////////////////////////////////////////////////////////////////////////////
 // FindCell stuff
@@ -1005,6 +1029,27 @@ vtkIdType vtkModifiedBSPTree::FindCell(
   //
   this->BuildLocatorIfNeeded();
   //
+  return this->FindCellInternal(x, cell, pcoords, weights);
+}
+//---------------------------------------------------------------------------
+vtkIdType vtkModifiedBSPTree::FindCell(
+  const double x[3], double , vtkLocatorScratch *scratch,
+  double pcoords[3], double *weights) const
+{
+  double pos[3] = { x[0], x[1], x[2] };
+  return this->FindCellInternal(pos, scratch->GetCell(), pcoords, weights);
+}
+//---------------------------------------------------------------------------
+vtkIdType vtkModifiedBSPTree::FindCellInternal(
+  double x[3], vtkGenericCell *cell,
+  double pcoords[3], double *weights) const
+{
+  //
+  if (!this->mRoot)
+    {
+    return -1;
+    }
+  //
   nodestack ns;
   BSPNode   *node;
   ns.push(this->mRoot);
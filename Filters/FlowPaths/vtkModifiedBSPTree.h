@@ -208,6 +208,14 @@ class VTKFILTERSFLOWPATHS_EXPORT vtkModifiedBSPTree : public vtkAbstractCellLoca
     double p1[3], double p2[3], double tol, double &t, double x[3],
     double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell);
 
+  // Description:
+  // Thread-safe version of IntersectWithLine(). It does not build the
+  // locator, and finds nothing until it is built.
+  virtual int IntersectWithLine(
+    const double p1[3], const double p2[3], double tol, double &t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId,
+    vtkLocatorScratch *scratch) const;
+
   // Description:
   // Take the passed line segment and intersect it with the data set.
   // This method assumes that the data set is a vtkPolyData that describes
@@ -247,6 +255,12 @@ class VTKFILTERSFLOWPATHS_EXPORT vtkModifiedBSPTree : public vtkAbstractCellLoca
   virtual vtkIdType FindCell(double x[3], double tol2, vtkGenericCell *GenCell,
     double pcoords[3], double *weights);
 
+  // Description:
+  // Thread-safe version of FindCell(). It does not build the locator, and
+  // finds nothing until it is built.
+  virtual vtkIdType FindCell(const double x[3], double tol2,
+    vtkLocatorScratch *scratch, double pcoords[3], double *weights) const;
+
   bool InsideCellBounds(double x[3], vtkIdType cell_ID);
 
   // Description:
@@ -273,9 +287,18 @@ class VTKFILTERSFLOWPATHS_EXPORT vtkModifiedBSPTree : public vtkAbstractCellLoca
   // We provide a function which does the cell/ray test so that
   // it can be overriden by subclasses to perform special treatment
   // (Example : Particles stored in tree, have no dimension, so we must
-  // override the cell test to return a value based on some particle size
+  // override the cell test to return a value based on some particle size.
+  // The cell is tested in the given cell.
   virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
-    const double tol, double &t, double ipt[3], double pcoords[3], int &subId);
+    const double tol, double &t, double ipt[3], double pcoords[3], int &subId,
+    vtkGenericCell *cell) const;
+
+  // The queries, which neither build the locator nor keep state in it
+  vtkIdType FindCellInternal(double x[3], vtkGenericCell *cell,
+    double pcoords[3], double *weights) const;
+  int IntersectWithLineInternal(const double p1[3], const double p2[3], double tol,
+    double &t, double x[3], double pcoords[3], int &subId, vtkIdType &cellId,
+    vtkGenericCell *cell) const;
 
 //ETX
   void BuildLocatorIfNeeded();
@@ -0,0 +1,251 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMemoryLimitStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkMemoryLimitStreamer
+// .SECTION Description
+// Streams unstructured grids and polygonal data within several memory
+// limits and checks the number of pieces and the appended output.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMemoryLimitStreamer.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridAlgorithm.h"
+
+const vtkIdType NUMBER_OF_POINTS = 100000;
+
+//------------------------------------------------------------------------------
+// Fill a point set with the vertices of the requested piece, with their
+// ids as point data.
+static void FillPiece(vtkInformationVector* outputVector, vtkPointSet* output,
+                      vtkCellArray* verts)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  int piece = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  int numPieces = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+  vtkIdType begin = NUMBER_OF_POINTS * piece / numPieces;
+  vtkIdType end = NUMBER_OF_POINTS * (piece + 1) / numPieces;
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (vtkIdType i = begin; i < end; ++i)
+    {
+    vtkIdType id = points->InsertNextPoint(i, 0.0, 0.0);
+    verts->InsertNextCell(1, &id);
+    ids->InsertNextValue(i);
+    vectors->InsertNextTuple3(i, i, i);
+    }
+  output->SetPoints(points.GetPointer());
+  output->GetPointData()->AddArray(ids.GetPointer());
+  output->GetPointData()->AddArray(vectors.GetPointer());
+}
+
+//------------------------------------------------------------------------------
+// Let the output be divided into any number of pieces.
+static int SetMaximumNumberOfPieces(vtkInformationVector* outputVector)
+{
+  outputVector->GetInformationObject(0)->Set(
+    vtkStreamingDemandDrivenPipeline::MAXIMUM_NUMBER_OF_PIECES(), -1);
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+// Produces the requested piece of NUMBER_OF_POINTS vertices.
+class vtkVertexGridSource : public vtkUnstructuredGridAlgorithm
+{
+public:
+  static vtkVertexGridSource* New();
+  vtkTypeMacro(vtkVertexGridSource, vtkUnstructuredGridAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  vtkVertexGridSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfExecutions = 0;
+    }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+    {
+    return SetMaximumNumberOfPieces(outputVector);
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+    {
+    vtkUnstructuredGrid* output = vtkUnstructuredGrid::GetData(outputVector);
+    vtkNew<vtkCellArray> verts;
+    FillPiece(outputVector, output, verts.GetPointer());
+    output->SetCells(VTK_VERTEX, verts.GetPointer());
+    ++this->NumberOfExecutions;
+    return 1;
+    }
+
+private:
+  vtkVertexGridSource(const vtkVertexGridSource&);  // Not implemented.
+  void operator=(const vtkVertexGridSource&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkVertexGridSource);
+
+//------------------------------------------------------------------------------
+// Produces the requested piece of NUMBER_OF_POINTS vertices.
+class vtkVertexPolyDataSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkVertexPolyDataSource* New();
+  vtkTypeMacro(vtkVertexPolyDataSource, vtkPolyDataAlgorithm);
+
+protected:
+  vtkVertexPolyDataSource() { this->SetNumberOfInputPorts(0); }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+    {
+    return SetMaximumNumberOfPieces(outputVector);
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+    {
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkNew<vtkCellArray> verts;
+    FillPiece(outputVector, output, verts.GetPointer());
+    output->SetVerts(verts.GetPointer());
+    return 1;
+    }
+
+private:
+  vtkVertexPolyDataSource(const vtkVertexPolyDataSource&);  // Not implemented.
+  void operator=(const vtkVertexPolyDataSource&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkVertexPolyDataSource);
+
+//------------------------------------------------------------------------------
+// Check that the output has each vertex once.
+static bool CheckOutput(vtkDataObject* outputObject)
+{
+  vtkDataSet* output = vtkDataSet::SafeDownCast(outputObject);
+  vtkIdTypeArray* ids = output ? vtkIdTypeArray::SafeDownCast(
+    output->GetPointData()->GetArray("Ids")) : 0;
+  if (!ids || output->GetNumberOfPoints() != NUMBER_OF_POINTS ||
+      output->GetNumberOfCells() != NUMBER_OF_POINTS)
+    {
+    return false;
+    }
+  double sum = 0.0;
+  for (vtkIdType i = 0; i < NUMBER_OF_POINTS; ++i)
+    {
+    sum += ids->GetValue(i);
+    }
+  return sum == 0.5 * NUMBER_OF_POINTS * (NUMBER_OF_POINTS - 1);
+}
+
+//------------------------------------------------------------------------------
+int TestMemoryLimitStreamer(int, char*[])
+{
+  vtkNew<vtkVertexGridSource> source;
+  vtkNew<vtkMemoryLimitStreamer> streamer;
+  streamer->SetInputConnection(source->GetOutputPort());
+  streamer->SetInitialNumberOfStreamDivisions(4);
+
+  // A primed piece that fits is kept.
+  streamer->SetMemoryLimit(100000);
+  streamer->Update();
+  unsigned long wholeSize = 4 * streamer->GetPrimingMemorySize();
+  if (!vtkUnstructuredGrid::SafeDownCast(streamer->GetOutputDataObject(0)) ||
+      !CheckOutput(streamer->GetOutputDataObject(0)))
+    {
+    cerr << "Wrong output" << endl;
+    return EXIT_FAILURE;
+    }
+  if (streamer->GetNumberOfStreamDivisions() != 4 ||
+      source->NumberOfExecutions != 4)
+    {
+    cerr << "Primed piece not kept" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Otherwise each piece is divided until it fits.
+  source->NumberOfExecutions = 0;
+  unsigned long limit = wholeSize / 10;
+  streamer->SetMemoryLimit(limit);
+  streamer->Update();
+  int numberOfPieces = streamer->GetNumberOfStreamDivisions();
+  if (numberOfPieces < 12 || source->NumberOfExecutions !=
+      streamer->GetNumberOfPrimingPasses() - 1 + numberOfPieces)
+    {
+    cerr << "Wrong number of pieces: " << numberOfPieces
+         << ", priming passes: " << streamer->GetNumberOfPrimingPasses()
+         << endl;
+    return EXIT_FAILURE;
+    }
+  if (streamer->GetPrimingMemorySize() > limit ||
+      streamer->GetLargestPieceMemorySize() > limit + limit / 10)
+    {
+    cerr << "Piece larger than the limit: "
+         << streamer->GetLargestPieceMemorySize() << " KiB" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!CheckOutput(streamer->GetOutputDataObject(0)))
+    {
+    cerr << "Wrong streamed output" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The number of pieces is bounded.
+  streamer->SetMaximumNumberOfStreamDivisions(6);
+  streamer->Update();
+  if (streamer->GetNumberOfStreamDivisions() != 6 ||
+      !CheckOutput(streamer->GetOutputDataObject(0)))
+    {
+    cerr << "Maximum not respected" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Polygonal data is streamed as polygonal data.
+  vtkNew<vtkVertexPolyDataSource> polySource;
+  streamer->SetInputConnection(polySource->GetOutputPort());
+  streamer->SetMaximumNumberOfStreamDivisions(4096);
+  streamer->Update();
+  if (!vtkPolyData::SafeDownCast(streamer->GetOutputDataObject(0)) ||
+      !CheckOutput(streamer->GetOutputDataObject(0)) ||
+      streamer->GetNumberOfStreamDivisions() <= 4)
+    {
+    cerr << "Wrong polygonal output" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -23,7 +23,8 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
-#include "vtkTensor.h"
+#include "vtkScratchArena.h"
+#include "vtkSMPTools.h"
 
 #include <math.h>
 
@@ -43,6 +44,112 @@ vtkCellDerivatives::vtkCellDerivatives()
                                vtkDataSetAttributes::VECTORS);
 }
 
+//----------------------------------------------------------------------------
+// Computes the derivatives of a range of cells. All the temporaries come
+// from the per-thread pools of the arena, which are recycled at the
+// beginning of each range. The point values are gathered in buffers
+// allocated once per range for the largest cell, since the arena only
+// reclaims memory on Reset().
+class vtkCellDerivativesFunctor
+{
+public:
+  vtkCellDerivatives *Filter;
+  vtkDataSet *Input;
+  vtkScratchArena *Arena;
+  vtkDataArray *InScalars;
+  vtkDataArray *InVectors;
+  double *Gradients;
+  double *Vorticity;
+  double *Tensors;
+  int TensorMode;
+  vtkIdType NumberOfCells;
+  int MaxCellSize;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    if ( vtkSMPTools::GetThreadIndex() == 0 )
+      {
+      this->Filter->UpdateProgress(
+        static_cast<double>(begin)/this->NumberOfCells);
+      }
+
+    this->Arena->Reset();
+    vtkGenericCell *cell = this->Arena->GetGenericCell();
+    double pcoords[3], derivs[9], *d;
+    int subId;
+    double *scalars = this->InScalars ? this->Arena->Allocate<double>(
+      this->MaxCellSize*this->InScalars->GetNumberOfComponents()) : NULL;
+    double *vectors = this->InVectors ?
+      this->Arena->Allocate<double>(3*this->MaxCellSize) : NULL;
+
+    for (vtkIdType cellId=begin; cellId < end; cellId++)
+      {
+      this->Input->GetCell(cellId, cell);
+      subId = cell->GetParametricCenter(pcoords);
+      vtkIdType numPts = cell->PointIds->GetNumberOfIds();
+
+      if ( this->InScalars )
+        {
+        int numComp = this->InScalars->GetNumberOfComponents();
+        for (vtkIdType i=0; i < numPts; i++)
+          {
+          this->InScalars->GetTuple(cell->PointIds->GetId(i),
+                                    scalars + i*numComp);
+          }
+        cell->Derivatives(subId, pcoords, scalars, 1,
+                          this->Gradients + 3*cellId);
+        }
+
+      if ( this->InVectors )
+        {
+        for (vtkIdType i=0; i < numPts; i++)
+          {
+          this->InVectors->GetTuple(cell->PointIds->GetId(i),
+                                    vectors + 3*i);
+          }
+        cell->Derivatives(0, pcoords, vectors, 3, derivs);
+
+        // Insert appropriate tensor
+        if ( this->Tensors &&
+             this->TensorMode == VTK_TENSOR_MODE_COMPUTE_GRADIENT )
+          {
+          // Same storage as vtkTensor::SetComponent(i, j, derivs[3*i+j])
+          d = this->Tensors + 9*cellId;
+          for (int i=0; i < 3; i++)
+            {
+            for (int j=0; j < 3; j++)
+              {
+              d[i+3*j] = derivs[3*i+j];
+              }
+            }
+          }
+        else if ( this->Tensors &&
+                  this->TensorMode == VTK_TENSOR_MODE_COMPUTE_STRAIN )
+          {
+          d = this->Tensors + 9*cellId;
+          d[0] = derivs[0];
+          d[1] = 0.5*(derivs[1]+derivs[3]);
+          d[2] = 0.5*(derivs[2]+derivs[6]);
+          d[3] = 0.5*(derivs[1]+derivs[3]);
+          d[4] = derivs[4];
+          d[5] = 0.5*(derivs[5]+derivs[7]);
+          d[6] = 0.5*(derivs[2]+derivs[6]);
+          d[7] = 0.5*(derivs[5]+derivs[7]);
+          d[8] = derivs[8];
+          }
+
+        if ( this->Vorticity )
+          {
+          d = this->Vorticity + 3*cellId;
+          d[0] = derivs[7] - derivs[5];
+          d[1] = derivs[2] - derivs[6];
+          d[2] = derivs[3] - derivs[1];
+          }
+        }
+      }//for all cells
+  }
+};
+
 int vtkCellDerivatives::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -66,7 +173,7 @@ int vtkCellDerivatives::RequestData(
   vtkDoubleArray *outVorticity=NULL;
   vtkDoubleArray *outTensors=NULL;
   vtkIdType numCells=input->GetNumberOfCells();
-  int computeScalarDerivs=1, computeVectorDerivs=1, computeVorticity=1, subId;
+  int computeScalarDerivs=1, computeVectorDerivs=1, computeVorticity=1;
 
   // Initialize
   vtkDebugMacro(<<"Computing cell derivatives");
@@ -126,100 +233,53 @@ int vtkCellDerivatives::RequestData(
     computeVectorDerivs = 0;
     }
 
-  // If just passing data forget the loop
-  if ( computeScalarDerivs || computeVectorDerivs || computeVorticity )
+  if ( computeVectorDerivs || computeVorticity )
     {
-    double pcoords[3], derivs[9], w[3], *scalars, *vectors;
-    vtkGenericCell *cell = vtkGenericCell::New();
-    vtkIdType cellId;
-    vtkDoubleArray *cellScalars=vtkDoubleArray::New();
-    if ( computeScalarDerivs )
-      {
-      cellScalars->SetNumberOfComponents(inScalars->GetNumberOfComponents());
-      cellScalars->Allocate(cellScalars->GetNumberOfComponents()*VTK_CELL_SIZE);
-      cellScalars->SetName("Scalars");
-      }
-    vtkDoubleArray *cellVectors=vtkDoubleArray::New();
-    cellVectors->SetNumberOfComponents(3);
-    cellVectors->Allocate(3*VTK_CELL_SIZE);
-    cellVectors->SetName("Vectors");
-    vtkTensor* tens = vtkTensor::New();
-
-    // Loop over all cells computing derivatives
-    vtkIdType progressInterval = numCells/20 + 1;
-    for (cellId=0; cellId < numCells; cellId++)
+    if ( inVectors->GetNumberOfComponents() != 3 )
       {
-      if ( ! (cellId % progressInterval) )
+      vtkErrorMacro("Vectors must have 3 components");
+      computeVectorDerivs = computeVorticity = 0;
+      if ( outVorticity )
         {
-        vtkDebugMacro(<<"Computing cell #" << cellId);
-        this->UpdateProgress (static_cast<double>(cellId)/numCells);
+        outVorticity->Delete();
+        outVorticity = NULL;
         }
-
-      input->GetCell(cellId, cell);
-      subId = cell->GetParametricCenter(pcoords);
-
-      if ( computeScalarDerivs )
+      if ( outTensors )
         {
-        inScalars->GetTuples(cell->PointIds, cellScalars);
-        scalars = cellScalars->GetPointer(0);
-        cell->Derivatives(subId, pcoords, scalars, 1, derivs);
-        outGradients->SetTuple(cellId, derivs);
-        }
-
-      if ( computeVectorDerivs || computeVorticity )
-        {
-        inVectors->GetTuples(cell->PointIds, cellVectors);
-        vectors = cellVectors->GetPointer(0);
-        cell->Derivatives(0, pcoords, vectors, 3, derivs);
-
-        // Insert appropriate tensor
-        if ( this->TensorMode == VTK_TENSOR_MODE_COMPUTE_GRADIENT)
-          {
-          tens->SetComponent(0,0, derivs[0]);
-          tens->SetComponent(0,1, derivs[1]);
-          tens->SetComponent(0,2, derivs[2]);
-          tens->SetComponent(1,0, derivs[3]);
-          tens->SetComponent(1,1, derivs[4]);
-          tens->SetComponent(1,2, derivs[5]);
-          tens->SetComponent(2,0, derivs[6]);
-          tens->SetComponent(2,1, derivs[7]);
-          tens->SetComponent(2,2, derivs[8]);
-
-          outTensors->InsertTuple(cellId, tens->T);
-          }
-        else if (this->TensorMode == VTK_TENSOR_MODE_COMPUTE_STRAIN)
-          {
-          tens->SetComponent(0,0, derivs[0]);
-          tens->SetComponent(0,1, 0.5*(derivs[1]+derivs[3]));
-          tens->SetComponent(0,2, 0.5*(derivs[2]+derivs[6]));
-          tens->SetComponent(1,0, 0.5*(derivs[1]+derivs[3]));
-          tens->SetComponent(1,1, derivs[4]);
-          tens->SetComponent(1,2, 0.5*(derivs[5]+derivs[7]));
-          tens->SetComponent(2,0, 0.5*(derivs[2]+derivs[6]));
-          tens->SetComponent(2,1, 0.5*(derivs[5]+derivs[7]));
-          tens->SetComponent(2,2, derivs[8]);
-
-          outTensors->InsertTuple(cellId, tens->T);
-          }
-        else if (this->TensorMode == VTK_TENSOR_MODE_PASS_TENSORS)
-          {
-          // do nothing.
-          }
-
-        if ( computeVorticity )
-          {
-          w[0] = derivs[7] - derivs[5];
-          w[1] = derivs[2] - derivs[6];
-          w[2] = derivs[3] - derivs[1];
-          outVorticity->SetTuple(cellId, w);
-          }
+        outTensors->Delete();
+        outTensors = NULL;
         }
-      }//for all cells
+      }
+    }
 
+  // If just passing data forget the loop
+  if ( computeScalarDerivs || computeVectorDerivs || computeVorticity )
+    {
+    // Make sure the lazily built structures of the input (e.g. the cells
+    // of vtkPolyData) exist before the threads use them.
+    vtkGenericCell *cell = vtkGenericCell::New();
+    input->GetCell(0, cell);
     cell->Delete();
-    cellScalars->Delete();
-    cellVectors->Delete();
-    tens->Delete();
+
+    vtkScratchArena *arena = vtkScratchArena::New();
+    vtkCellDerivativesFunctor functor;
+    functor.Filter = this;
+    functor.Input = input;
+    functor.Arena = arena;
+    functor.InScalars = computeScalarDerivs ? inScalars : NULL;
+    functor.InVectors =
+      ( computeVectorDerivs || computeVorticity ) ? inVectors : NULL;
+    functor.Gradients =
+      computeScalarDerivs ? outGradients->GetPointer(0) : NULL;
+    functor.Vorticity =
+      computeVorticity ? outVorticity->GetPointer(0) : NULL;
+    functor.Tensors =
+      computeVectorDerivs ? outTensors->GetPointer(0) : NULL;
+    functor.TensorMode = this->TensorMode;
+    functor.NumberOfCells = numCells;
+    functor.MaxCellSize = input->GetMaxCellSize();
+    vtkSMPTools::For(0, numCells, functor);
+    arena->Delete();
     }//if something to compute
 
   // Pass appropriate data through to output
@@ -24,6 +24,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkGenericCell.h"
 #include "vtkIdListCollection.h"
+#include "vtkLocatorScratch.h"
 #include "vtkSmartPointer.h"
 #include "vtkCellArray.h"
 #include "vtkPolyData.h"
@@ -642,6 +643,23 @@ void vtkCellTreeLocator::BuildLocator()
 
 vtkIdType vtkCellTreeLocator::FindCell( double pos[3], double , vtkGenericCell *cell,  double pcoords[3],
   double* weights )
+{
+  return this->FindCellInternal(pos, cell, pcoords, weights);
+}
+
+//----------------------------------------------------------------------------
+
+vtkIdType vtkCellTreeLocator::FindCell(const double x[3], double,
+  vtkLocatorScratch *scratch, double pcoords[3], double *weights) const
+{
+  double pos[3] = { x[0], x[1], x[2] };
+  return this->FindCellInternal(pos, scratch->GetCell(), pcoords, weights);
+}
+
+//----------------------------------------------------------------------------
+
+vtkIdType vtkCellTreeLocator::FindCellInternal(double pos[3],
+  vtkGenericCell *cell, double pcoords[3], double* weights) const
 {
   if( this->Tree == 0 )
     {
@@ -717,17 +735,36 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3],
                                           vtkIdType &cellId,
                                           vtkGenericCell *cell)
 {
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-    {
-    this->DataSet->GetCell(cellId, cell);
-    }
-  return hit;
+  this->BuildLocatorIfNeeded();
+
+  return this->IntersectWithLineInternal(p1, p2, tol, t, x, pcoords, subId,
+                                         cellId, cell);
 }
 
 int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol,
   double& t, double x[3], double pcoords[3],
   int &subId, vtkIdType &cellIds)
+{
+  this->BuildLocatorIfNeeded();
+
+  return this->IntersectWithLineInternal(p1, p2, tol, t, x, pcoords, subId,
+                                         cellIds, this->GenericCell);
+}
+
+int vtkCellTreeLocator::IntersectWithLine(const double p1[3],
+  const double p2[3], double tol, double& t, double x[3], double pcoords[3],
+  int &subId, vtkIdType &cellId, vtkLocatorScratch *scratch) const
+{
+  return this->IntersectWithLineInternal(p1, p2, tol, t, x, pcoords, subId,
+                                         cellId, scratch->GetCell());
+}
+
+//----------------------------------------------------------------------------
+// The cells are tested in the given cell, so that concurrent queries do not
+// interfere. On a hit, it is left with the cell hit.
+int vtkCellTreeLocator::IntersectWithLineInternal(const double p1[3],
+  const double p2[3], double tol, double& t, double x[3], double pcoords[3],
+  int &subId, vtkIdType &cellIds, vtkGenericCell *cell) const
 {
   //
   vtkCellTreeNode  *node, *near, *far;
@@ -736,7 +773,10 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
 
   double cellBounds[6];
 
-  this->BuildLocatorIfNeeded();
+  if (this->Tree == 0)
+    {
+    return 0;
+    }
 
   // Does ray pass through root BBox
   tmin = 0; tmax = 1;
@@ -810,7 +850,8 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
         node = near;
         }
       }
-    double t_hit, ipt[3];
+    double t_hit, ipt[3], cellPcoords[3];
+    int cellSubId;
     // Ok, so we're a leaf node, first check the BBox against the ray
     // then test the candidates in our sorted ray direction order
     _tmin = tmin; _tmax = tmax;
@@ -840,7 +881,8 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
       ctmin = _tmin; ctmax = _tmax;
       if (this->RayMinMaxT(boundsPtr, p1, ray_vec, ctmin, ctmax))
         {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt,
+                                        cellPcoords, cellSubId, cell))
           {
           if (t_hit<closest_intersection)
             {
@@ -850,6 +892,10 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
             x[0] = ipt[0];
             x[1] = ipt[1];
             x[2] = ipt[2];
+            pcoords[0] = cellPcoords[0];
+            pcoords[1] = cellPcoords[1];
+            pcoords[2] = cellPcoords[2];
+            subId = cellSubId;
             }
 
 
@@ -861,6 +907,7 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
   if (HIT)
     {
     t = closest_intersection;
+    this->DataSet->GetCell(cellIds, cell);
     }
   //
   return HIT;
@@ -870,7 +917,7 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
 bool vtkCellTreeLocator::RayMinMaxT(const double origin[3],
   const double dir[3],
   double &rTmin,
-  double &rTmax)
+  double &rTmax) const
 {
   double tT;
   // X-Axis
@@ -1030,7 +1077,7 @@ bool vtkCellTreeLocator::RayMinMaxT(const double bounds[6],
   const double origin[3],
   const double dir[3],
   double &rTmin,
-  double &rTmax)
+  double &rTmax) const
 {
   double tT;
   // X-Axis
@@ -1174,7 +1221,7 @@ bool vtkCellTreeLocator::RayMinMaxT(const double bounds[6],
   return (true);
 }
 //----------------------------------------------------------------------------
-int vtkCellTreeLocator::getDominantAxis(const double dir[3])
+int vtkCellTreeLocator::getDominantAxis(const double dir[3]) const
 {
   double tX = (dir[0]>0) ? dir[0] : -dir[0];
   double tY = (dir[1]>0) ? dir[1] : -dir[1];
@@ -1197,7 +1244,7 @@ void vtkCellTreeLocator::Classify(const double origin[3],
   const double dir[3],
   double &rDist,
   vtkCellTreeNode *&near, vtkCellTreeNode *&parent,
-  vtkCellTreeNode *&far, int& mustCheck)
+  vtkCellTreeNode *&far, int& mustCheck) const
 {
   double tOriginToDivPlane = parent->GetLeftMaxValue() - origin[parent->GetDimension()];
   double tOriginToDivPlane2 = parent->GetRightMinValue() - origin[parent->GetDimension()];
@@ -1255,10 +1302,11 @@ int vtkCellTreeLocator::IntersectCellInternal(
   double &t,
   double ipt[3],
   double pcoords[3],
-  int &subId)
+  int &subId,
+  vtkGenericCell *cell) const
 {
-  this->DataSet->GetCell(cell_ID, this->GenericCell);
-  return this->GenericCell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
 //----------------------------------------------------------------------------
 void vtkCellTreeLocator::FreeSearchStructure(void)
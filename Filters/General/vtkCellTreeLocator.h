@@ -27,10 +27,12 @@
 // avtCellLocatorBIH class in the VisIT Visualization Tool
 
 // .SECTION Caveats
-//
+// The const FindCell() and IntersectWithLine() which take a
+// vtkLocatorScratch may be called from several threads at once, after the
+// locator is built.
 
 // .SECTION See Also
-// vtkLocator vtkCellLocator vtkModifiedBSPTree
+// vtkLocator vtkCellLocator vtkModifiedBSPTree vtkLocatorScratch
 
 
 #ifndef __vtkCellTreeLocator_h
@@ -64,6 +66,13 @@ class VTKFILTERSGENERAL_EXPORT vtkCellTreeLocator : public vtkAbstractCellLocato
     virtual vtkIdType FindCell(double pos[3], double vtkNotUsed, vtkGenericCell *cell,  double pcoords[3],
                                        double* weights );
 
+    // Description:
+    // Thread-safe version of FindCell(). It does not build the locator, and
+    // finds nothing until it is built.
+    virtual vtkIdType FindCell(const double x[3], double tol2,
+                               vtkLocatorScratch *scratch,
+                               double pcoords[3], double *weights) const;
+
     // Description:
     // Return intersection point (if any) AND the cell which was intersected by
     // the finite line. The cell is returned as a cell id and as a generic cell.
@@ -72,6 +81,14 @@ class VTKFILTERSGENERAL_EXPORT vtkCellTreeLocator : public vtkAbstractCellLocato
                                       int &subId, vtkIdType &cellId,
                                       vtkGenericCell *cell);
 
+    // Description:
+    // Thread-safe version of IntersectWithLine(). It does not build the
+    // locator, and finds nothing until it is built.
+    virtual int IntersectWithLine(
+      const double p1[3], const double p2[3], double tol, double& t,
+      double x[3], double pcoords[3], int &subId, vtkIdType &cellId,
+      vtkLocatorScratch *scratch) const;
+
     // Description:
     // Return a list of unique cell ids inside of a given bounding box. The
     // user must provide the vtkIdList to populate. This method returns data
@@ -191,39 +208,48 @@ protected:
      vtkCellTreeLocator();
     ~vtkCellTreeLocator();
 
+  // The queries, which neither build the locator nor keep state in it.
+  vtkIdType FindCellInternal(double pos[3], vtkGenericCell *cell,
+                             double pcoords[3], double *weights) const;
+  int IntersectWithLineInternal(const double p1[3], const double p2[3],
+    double tol, double& t, double x[3], double pcoords[3], int &subId,
+    vtkIdType &cellId, vtkGenericCell *cell) const;
+
    // Test ray against node BBox : clip t values to extremes
   bool RayMinMaxT(const double origin[3],
     const double dir[3],
     double &rTmin,
-    double &rTmax);
+    double &rTmax) const;
 
   bool RayMinMaxT(const double bounds[6],
     const double origin[3],
     const double dir[3],
     double &rTmin,
-    double &rTmax);
+    double &rTmax) const;
 
-  int getDominantAxis(const double dir[3]);
+  int getDominantAxis(const double dir[3]) const;
 
   // Order nodes as near/far relative to ray
   void Classify(const double origin[3],
     const double dir[3],
     double &rDist,
     vtkCellTreeNode *&near, vtkCellTreeNode *&mid,
-    vtkCellTreeNode *&far, int &mustCheck);
+    vtkCellTreeNode *&far, int &mustCheck) const;
 
   // From vtkModifiedBSPTRee
   // We provide a function which does the cell/ray test so that
   // it can be overriden by subclasses to perform special treatment
   // (Example : Particles stored in tree, have no dimension, so we must
-  // override the cell test to return a value based on some particle size
+  // override the cell test to return a value based on some particle size.
+  // The cell is tested in the given cell.
   virtual int IntersectCellInternal( vtkIdType cell_ID,  const double p1[3],
     const double p2[3],
     const double tol,
     double &t,
     double ipt[3],
     double pcoords[3],
-    int &subId);
+    int &subId,
+    vtkGenericCell *cell) const;
 
 
     int NumberOfBuckets;
@@ -729,6 +729,11 @@ int vtkClipDataSet::ProcessRequest(vtkInformation* request,
                                    vtkInformationVector** inputVector,
                                    vtkInformationVector* outputVector)
 {
+  if(request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_MEMORY_ESTIMATE()))
+    {
+    return this->RequestMemoryEstimate(request, inputVector, outputVector);
+    }
+
   if(request->Has(vtkStreamingDemandDrivenPipeline::
      REQUEST_UPDATE_EXTENT_INFORMATION()))
     {
@@ -833,3 +838,64 @@ int vtkClipDataSet::ProcessRequest(vtkInformation* request,
   return this->Superclass::ProcessRequest(request, inputVector,
                                           outputVector);
 }
+
+//-----------------------------------------------------------------------
+
+int vtkClipDataSet::RequestMemoryEstimate(vtkInformation*,
+                                          vtkInformationVector** inputVector,
+                                          vtkInformationVector* outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkInformation *clippedInfo = outputVector->GetInformationObject(1);
+  // The clipped output stays empty unless requested.
+  vtkStreamingDemandDrivenPipeline::SetEstimatedOutputSize(
+    clippedInfo, 0, 0, 0.0, 0.0);
+  if (!inInfo ||
+      !inInfo->Has(vtkStreamingDemandDrivenPipeline::ESTIMATED_NUMBER_OF_CELLS()) ||
+      !inInfo->Has(vtkStreamingDemandDrivenPipeline::ESTIMATED_NUMBER_OF_POINTS()))
+    {
+    return 1;
+    }
+  double numCells = static_cast<double>(
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::ESTIMATED_NUMBER_OF_CELLS()));
+  double numPoints = static_cast<double>(
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::ESTIMATED_NUMBER_OF_POINTS()));
+
+  // Each side keeps about half of the cells.  The cells crossed by the
+  // clip surface, about n^(2/3) of n cells, are split into about three
+  // tetrahedra each side and add a point each.
+  double crossed = 4.0 * pow(numCells, 2.0 / 3.0);
+  if (crossed > numCells)
+    {
+    crossed = numCells;
+    }
+  double outCells = 0.5 * (numCells - crossed) + 3.0 * crossed;
+  double outPoints = 0.5 * numPoints + crossed;
+
+  // Unstructured grid cells store their type, location and connectivity,
+  // with eight points for the hexahedra of structured inputs and four
+  // otherwise.
+  int cellSize =
+    inInfo->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()) ? 8 : 4;
+  double bytesPerCell = 1 + (2 + cellSize) * sizeof(vtkIdType);
+  double bytesPerPoint =
+    3 * (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION ?
+         sizeof(double) : sizeof(float)) +
+    vtkStreamingDemandDrivenPipeline::GetEstimatedPointDataSize(inInfo);
+  if (this->GenerateClipScalars)
+    {
+    bytesPerPoint += sizeof(float);
+    }
+
+  vtkStreamingDemandDrivenPipeline::SetEstimatedOutputSize(
+    outInfo, static_cast<vtkIdType>(outPoints),
+    static_cast<vtkIdType>(outCells), bytesPerPoint, bytesPerCell);
+  if (this->GenerateClippedOutput)
+    {
+    vtkStreamingDemandDrivenPipeline::SetEstimatedOutputSize(
+      clippedInfo, static_cast<vtkIdType>(outPoints),
+      static_cast<vtkIdType>(outCells), bytesPerPoint, bytesPerCell);
+    }
+  return 1;
+}
@@ -53,6 +53,7 @@
 
 // .SECTION See Also
 // vtkImplicitFunction vtkCutter vtkClipVolume vtkClipPolyData
+// vtkEdgePointLocator
 
 #ifndef __vtkClipDataSet_h
 #define __vtkClipDataSet_h
@@ -140,6 +141,9 @@ public:
   // Description:
   // Specify a spatial locator for merging points. By default, an
   // instance of vtkMergePoints is used.
+  // A vtkEdgePointLocator merges the points by the cell edge they are
+  // interpolated on instead of by coordinates: it is faster, needs no
+  // bounds, and never merges distinct points of thin cells.
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
 
@@ -171,6 +175,13 @@ protected:
 
   virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
   virtual int FillInputPortInformation(int port, vtkInformation *info);
+
+  // Description:
+  // Estimate the size of the outputs from the estimated size of the
+  // input.  Called for REQUEST_MEMORY_ESTIMATE.
+  virtual int RequestMemoryEstimate(vtkInformation *, vtkInformationVector **,
+                                    vtkInformationVector *);
+
   vtkImplicitFunction *ClipFunction;
 
   vtkIncrementalPointLocator *Locator;
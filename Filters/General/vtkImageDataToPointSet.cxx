@@ -20,6 +20,8 @@
 
 #include "vtkCellData.h"
 #include "vtkImageData.h"
+#include "vtkImplicitArray.h"
+#include "vtkImplicitArrayFunctions.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -27,12 +29,17 @@
 #include "vtkStructuredGrid.h"
 
 #include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+typedef vtkImplicitArray<double, vtkUniformGridPointsFunction>
+  vtkImageDataToPointSetPoints;
 
 vtkStandardNewMacro(vtkImageDataToPointSet);
 
 //-------------------------------------------------------------------------
 vtkImageDataToPointSet::vtkImageDataToPointSet()
 {
+  this->ImplicitPoints = 0;
 }
 
 vtkImageDataToPointSet::~vtkImageDataToPointSet()
@@ -42,6 +49,8 @@ vtkImageDataToPointSet::~vtkImageDataToPointSet()
 void vtkImageDataToPointSet::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ImplicitPoints: " << this->ImplicitPoints << endl;
 }
 
 //-------------------------------------------------------------------------
@@ -72,6 +81,19 @@ int vtkImageDataToPointSet::CopyStructure(vtkStructuredGrid *outData,
   outData->SetExtent(extent);
 
   vtkNew<vtkPoints> points;
+  if (this->ImplicitPoints)
+    {
+    vtkUniformGridPointsFunction function(origin, spacing, extent);
+    vtkSmartPointer<vtkImageDataToPointSetPoints> coords =
+      vtkSmartPointer<vtkImageDataToPointSetPoints>::New();
+    coords->SetNumberOfComponents(3);
+    coords->SetFunction(function);
+    coords->SetNumberOfTuples(function.GetNumberOfPoints());
+    points->SetData(coords);
+    outData->SetPoints(points.GetPointer());
+    return 1;
+    }
+
   points->SetDataTypeToDouble();
   points->SetNumberOfPoints(inData->GetNumberOfPoints());
 
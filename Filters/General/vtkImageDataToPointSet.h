@@ -44,6 +44,14 @@ public:
 
   static vtkImageDataToPointSet *New();
 
+  // Description:
+  // When on, the points of the output are a vtkImplicitArray that computes
+  // the coordinates from the origin and spacing of the input on demand,
+  // instead of storing them. Off by default.
+  vtkSetMacro(ImplicitPoints, int);
+  vtkGetMacro(ImplicitPoints, int);
+  vtkBooleanMacro(ImplicitPoints, int);
+
 protected:
   vtkImageDataToPointSet();
   ~vtkImageDataToPointSet();
@@ -54,6 +62,8 @@ protected:
 
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  int ImplicitPoints;
+
 private:
   vtkImageDataToPointSet(const vtkImageDataToPointSet &); // Not implemented
   void operator=(const vtkImageDataToPointSet &);         // Not implemented
@@ -0,0 +1,372 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryLimitStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryLimitStreamer.h"
+
+#include "vtkAlgorithmOutput.h"
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <set>
+
+vtkStandardNewMacro(vtkMemoryLimitStreamer);
+
+//----------------------------------------------------------------------------
+// Add the size of the outputs of an algorithm and of the algorithms
+// upstream, counting each object once.
+static void vtkMemoryLimitStreamerAddSize(vtkAlgorithm* algorithm,
+                                          std::set<vtkObject*>& visited,
+                                          unsigned long& size)
+{
+  if (!visited.insert(algorithm).second)
+    {
+    return;
+    }
+  vtkExecutive* executive = algorithm->GetExecutive();
+  for (int i = 0; i < algorithm->GetNumberOfOutputPorts(); ++i)
+    {
+    vtkDataObject* data = executive->GetOutputData(i);
+    if (data && visited.insert(data).second)
+      {
+      size += data->GetActualMemorySize();
+      }
+    }
+  for (int i = 0; i < algorithm->GetNumberOfInputPorts(); ++i)
+    {
+    for (int j = 0; j < algorithm->GetNumberOfInputConnections(i); ++j)
+      {
+      vtkAlgorithmOutput* input = algorithm->GetInputConnection(i, j);
+      if (input && input->GetProducer())
+        {
+        vtkMemoryLimitStreamerAddSize(input->GetProducer(), visited, size);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryLimitStreamer::vtkMemoryLimitStreamer()
+{
+  this->SetNumberOfInputPorts(1);
+  this->SetNumberOfOutputPorts(1);
+
+  // Pieces of at most 50000 KiB, found by dividing the 8 pieces of the
+  // priming pass at most up to 4096 pieces.
+  this->MemoryLimit = 50000;
+  this->InitialNumberOfStreamDivisions = 8;
+  this->MaximumNumberOfStreamDivisions = 4096;
+  this->NumberOfPrimingPasses = 0;
+  this->PrimingMemorySize = 0;
+  this->LargestPieceMemorySize = 0;
+  this->Priming = 0;
+  this->Primed = 0;
+
+  this->NumberOfPasses = this->InitialNumberOfStreamDivisions;
+
+  this->AppendPolyData = vtkAppendPolyData::New();
+  this->AppendFilter = vtkAppendFilter::New();
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryLimitStreamer::~vtkMemoryLimitStreamer()
+{
+  this->AppendPolyData->Delete();
+  this->AppendPolyData = 0;
+  this->AppendFilter->Delete();
+  this->AppendFilter = 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::ProcessRequest(vtkInformation* request,
+                                           vtkInformationVector** inputVector,
+                                           vtkInformationVector* outputVector)
+{
+  if(request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+    {
+    return this->RequestDataObject(request, inputVector, outputVector);
+    }
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::RequestDataObject(
+  vtkInformation*,
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  if (!inInfo)
+    {
+    return 0;
+    }
+  vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!input)
+    {
+    return 0;
+    }
+
+  // Polygonal data is appended as polygonal data, anything else as an
+  // unstructured grid.
+  const char* outputType =
+    input->IsA("vtkPolyData") ? "vtkPolyData" : "vtkUnstructuredGrid";
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!output || !output->IsA(outputType))
+    {
+    vtkDataObject* newOutput;
+    if (input->IsA("vtkPolyData"))
+      {
+      newOutput = vtkPolyData::New();
+      }
+    else
+      {
+      newOutput = vtkUnstructuredGrid::New();
+      }
+    outInfo->Set(vtkDataObject::DATA_OBJECT(), newOutput);
+    newOutput->Delete();
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::ClampNumberOfPasses(int n,
+                                                vtkInformation* inInfo,
+                                                vtkInformation* outInfo)
+{
+  if (n > this->MaximumNumberOfStreamDivisions)
+    {
+    n = this->MaximumNumberOfStreamDivisions;
+    }
+
+  // -1 means that the input can be divided into any number of pieces.
+  int maxPieces = -1;
+  if (inInfo->Has(vtkStreamingDemandDrivenPipeline::MAXIMUM_NUMBER_OF_PIECES()))
+    {
+    maxPieces = inInfo->Get(
+      vtkStreamingDemandDrivenPipeline::MAXIMUM_NUMBER_OF_PIECES());
+    }
+  if (maxPieces > 0)
+    {
+    int outNumPieces = outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    int limit = maxPieces / (outNumPieces > 0 ? outNumPieces : 1);
+    if (n > limit)
+      {
+      n = limit;
+      }
+    }
+  return n > 1 ? n : 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::RequestUpdateExtent(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // get the info object
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  // The first pass of an execution primes with the initial number of
+  // pieces.
+  if (this->CurrentIndex == 0 && !this->Primed && !this->Priming)
+    {
+    this->Priming = 1;
+    this->NumberOfPrimingPasses = 0;
+    this->PrimingMemorySize = 0;
+    this->NumberOfPasses = this->ClampNumberOfPasses(
+      this->InitialNumberOfStreamDivisions, inInfo, outInfo);
+    }
+
+  int outPiece = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  int outNumPieces = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+              outPiece * this->NumberOfPasses + this->CurrentIndex);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+              outNumPieces * this->NumberOfPasses);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::RequestData(vtkInformation *request,
+                                        vtkInformationVector **inputVector,
+                                        vtkInformationVector *outputVector)
+{
+  if (this->Priming)
+    {
+    unsigned long previousSize = this->PrimingMemorySize;
+    this->PrimingMemorySize = this->ComputeInputPipelineMemorySize();
+    ++this->NumberOfPrimingPasses;
+
+    // The whole input is about NumberOfPasses times the primed piece:
+    // divide each piece further until it fits, as long as dividing
+    // reduces the size of the first piece by 20% or more.
+    int numberOfPasses = this->NumberOfPasses;
+    if (this->MemoryLimit > 0 &&
+        this->PrimingMemorySize > this->MemoryLimit &&
+        (previousSize == 0 || this->PrimingMemorySize < 0.8 * previousSize))
+      {
+      unsigned long factor =
+        (this->PrimingMemorySize + this->MemoryLimit - 1) / this->MemoryLimit;
+      double n = static_cast<double>(numberOfPasses) * factor;
+      numberOfPasses = this->ClampNumberOfPasses(
+        n < VTK_INT_MAX ? static_cast<int>(n) : VTK_INT_MAX,
+        inputVector[0]->GetInformationObject(0),
+        outputVector->GetInformationObject(0));
+      }
+
+    if (numberOfPasses != static_cast<int>(this->NumberOfPasses))
+      {
+      // The primed piece is discarded: prime again with smaller pieces.
+      vtkDebugMacro("Streaming " << numberOfPasses << " pieces instead of "
+                    << this->NumberOfPasses << ", the first one uses "
+                    << this->PrimingMemorySize << " KiB");
+      this->NumberOfPasses = numberOfPasses;
+      request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+      return 1;
+      }
+
+    // The primed piece is kept as the first piece.
+    this->Priming = 0;
+    this->Primed = 1;
+    this->LargestPieceMemorySize = 0;
+    }
+
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::ExecutePass(
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkDataSet *input = vtkDataSet::GetData(inputVector[0]);
+  vtkDataObject *output = vtkDataObject::GetData(outputVector);
+  if (!input || !output)
+    {
+    this->Priming = 0;
+    this->Primed = 0;
+    return 0;
+    }
+
+  unsigned long size = this->ComputeInputPipelineMemorySize();
+  if (size > this->LargestPieceMemorySize)
+    {
+    this->LargestPieceMemorySize = size;
+    }
+
+  vtkDataSet *copy = input->NewInstance();
+  copy->ShallowCopy(input);
+  if (output->IsA("vtkPolyData"))
+    {
+    this->AppendPolyData->AddInputData(vtkPolyData::SafeDownCast(copy));
+    }
+  else
+    {
+    this->AppendFilter->AddInputData(copy);
+    }
+  copy->Delete();
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::PostExecute(
+  vtkInformationVector **vtkNotUsed(inputVector),
+  vtkInformationVector *outputVector)
+{
+  vtkDataObject *output = vtkDataObject::GetData(outputVector);
+  this->Priming = 0;
+  this->Primed = 0;
+
+  if (output->IsA("vtkPolyData"))
+    {
+    this->AppendPolyData->Update();
+    output->ShallowCopy(this->AppendPolyData->GetOutput());
+    this->AppendPolyData->RemoveAllInputConnections(0);
+    this->AppendPolyData->GetOutput()->Initialize();
+    }
+  else
+    {
+    this->AppendFilter->Update();
+    output->ShallowCopy(this->AppendFilter->GetOutput());
+    this->AppendFilter->RemoveAllInputConnections(0);
+    this->AppendFilter->GetOutput()->Initialize();
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkMemoryLimitStreamer::ComputeInputPipelineMemorySize()
+{
+  std::set<vtkObject*> visited;
+  visited.insert(this);
+  unsigned long size = 0;
+  for (int i = 0; i < this->GetNumberOfInputConnections(0); ++i)
+    {
+    vtkAlgorithmOutput* input = this->GetInputConnection(0, i);
+    if (input && input->GetProducer())
+      {
+      vtkMemoryLimitStreamerAddSize(input->GetProducer(), visited, size);
+      }
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryLimitStreamer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "MemoryLimit (in kb): " << this->MemoryLimit << endl;
+  os << indent << "InitialNumberOfStreamDivisions: "
+     << this->InitialNumberOfStreamDivisions << endl;
+  os << indent << "MaximumNumberOfStreamDivisions: "
+     << this->MaximumNumberOfStreamDivisions << endl;
+  os << indent << "NumberOfStreamDivisions: " << this->NumberOfPasses << endl;
+  os << indent << "NumberOfPrimingPasses: "
+     << this->NumberOfPrimingPasses << endl;
+  os << indent << "PrimingMemorySize: " << this->PrimingMemorySize << endl;
+  os << indent << "LargestPieceMemorySize: "
+     << this->LargestPieceMemorySize << endl;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::FillOutputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataSet");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+  return 1;
+}
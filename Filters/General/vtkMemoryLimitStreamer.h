@@ -0,0 +1,155 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryLimitStreamer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMemoryLimitStreamer - Streams unstructured data within a
+// memory limit.
+// .SECTION Description
+// vtkMemoryLimitStreamer streams its input pipeline, like
+// vtkPolyDataStreamer, but chooses the number of pieces itself so that
+// the data held by the input pipeline for one piece fits in
+// MemoryLimit.  The first pass of each execution is a priming pass: it
+// requests the first of InitialNumberOfStreamDivisions pieces and
+// measures the size of the outputs of all the algorithms upstream.  If
+// that piece does not fit, the number of pieces is multiplied by the
+// ratio of its size to the limit and the first piece is primed again,
+// until it fits or dividing no longer reduces its size.  The primed
+// piece is then kept and the remaining pieces are requested.  Like
+// vtkPolyDataStreamer, the streamer keeps a shallow copy of every piece
+// until the last pass, then appends them all into the output.
+//
+// The output is a vtkPolyData when the input is a vtkPolyData and a
+// vtkUnstructuredGrid otherwise.  Streaming only reduces the memory
+// used when the input pipeline handles piece requests, as do the
+// parallel XML readers, and when the output is smaller than the input,
+// as with contouring or clipping.
+//
+// .SECTION Caveats
+// The size of a piece is that of the outputs that the input pipeline
+// keeps, as reported by vtkDataObject::GetActualMemorySize(): arrays
+// shared by several outputs are counted several times, and the
+// temporary memory used while executing is not counted.  The limit
+// does not apply to the output of the streamer itself: the pieces kept
+// until the last pass hold as much memory as the whole output, and
+// appending them briefly needs a second copy of it, so the peak memory
+// of the streamer is about twice the size of its output.
+//
+// .SECTION See Also
+// vtkPolyDataStreamer vtkMemoryLimitImageDataStreamer vtkAppendFilter
+
+#ifndef __vtkMemoryLimitStreamer_h
+#define __vtkMemoryLimitStreamer_h
+
+#include "vtkFiltersGeneralModule.h" // For export macro
+#include "vtkStreamerBase.h"
+
+class vtkAppendFilter;
+class vtkAppendPolyData;
+
+class VTKFILTERSGENERAL_EXPORT vtkMemoryLimitStreamer : public vtkStreamerBase
+{
+public:
+  static vtkMemoryLimitStreamer *New();
+
+  vtkTypeMacro(vtkMemoryLimitStreamer,vtkStreamerBase);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set / Get the memory limit for one piece, in kibibytes.  The
+  // default is 50000.
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+
+  // Description:
+  // Set / Get the number of pieces of the priming pass, i.e. the
+  // smallest number of pieces, and the largest number of pieces.  The
+  // defaults are 8 and 4096.
+  vtkSetClampMacro(InitialNumberOfStreamDivisions, int, 1, VTK_INT_MAX);
+  vtkGetMacro(InitialNumberOfStreamDivisions, int);
+  vtkSetClampMacro(MaximumNumberOfStreamDivisions, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfStreamDivisions, int);
+
+  // Description:
+  // The number of pieces of the last execution, its number of priming
+  // passes, the size of the last primed piece and the size of the
+  // largest piece, in kibibytes.
+  int GetNumberOfStreamDivisions()
+  {
+    return this->NumberOfPasses;
+  }
+  vtkGetMacro(NumberOfPrimingPasses, int);
+  vtkGetMacro(PrimingMemorySize, unsigned long);
+  vtkGetMacro(LargestPieceMemorySize, unsigned long);
+
+  // Description:
+  // see vtkAlgorithm for details
+  virtual int ProcessRequest(vtkInformation*,
+                             vtkInformationVector**,
+                             vtkInformationVector*);
+
+protected:
+  vtkMemoryLimitStreamer();
+  ~vtkMemoryLimitStreamer();
+
+  virtual int FillOutputPortInformation(int port, vtkInformation* info);
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+
+  virtual int RequestDataObject(vtkInformation*,
+                                vtkInformationVector**,
+                                vtkInformationVector*);
+
+  virtual int RequestUpdateExtent(vtkInformation*,
+                                  vtkInformationVector**,
+                                  vtkInformationVector*);
+
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector**,
+                          vtkInformationVector*);
+
+  virtual int ExecutePass(vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
+
+  virtual int PostExecute(vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
+
+  // Description:
+  // Size, in kibibytes, of the outputs of the algorithms upstream.
+  unsigned long ComputeInputPipelineMemorySize();
+
+  // Description:
+  // Largest number of passes that the input can divide the requested
+  // output piece into, no larger than n.
+  int ClampNumberOfPasses(int n, vtkInformation* inInfo,
+                          vtkInformation* outInfo);
+
+  unsigned long MemoryLimit;
+  int InitialNumberOfStreamDivisions;
+  int MaximumNumberOfStreamDivisions;
+  int NumberOfPrimingPasses;
+  unsigned long PrimingMemorySize;
+  unsigned long LargestPieceMemorySize;
+
+  // Whether the current execution is priming, or has chosen its number
+  // of passes.
+  int Priming;
+  int Primed;
+
+private:
+  vtkMemoryLimitStreamer(const vtkMemoryLimitStreamer&);  // Not implemented.
+  void operator=(const vtkMemoryLimitStreamer&);  // Not implemented.
+
+  vtkAppendPolyData* AppendPolyData;
+  vtkAppendFilter* AppendFilter;
+};
+
+#endif
@@ -201,6 +201,28 @@ public:
       (x, radius, closestPoint, cell, cellId, subId, dist2, inside);
   }
 
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual void FindClosestPoint(
+    const double x[3], double closestPoint[3],
+    vtkLocatorScratch *scratch, vtkIdType &cellId,
+    int &subId, double& dist2) const
+  {
+    Superclass::
+      FindClosestPoint(x, closestPoint, scratch, cellId, subId, dist2);
+  }
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual int IntersectWithLine(
+    const double p1[3], const double p2[3], double tol, double& t,
+    double x[3], double pcoords[3], int &subId, vtkIdType &cellId,
+    vtkLocatorScratch *scratch) const
+  {
+    return Superclass::IntersectWithLine
+      (p1, p2, tol, t, x, pcoords, subId, cellId, scratch);
+  }
+
   // Description:
   // Compute an OBB from the list of points given. Return the corner point
   // and the three axes defining the orientation of the OBB. Also return
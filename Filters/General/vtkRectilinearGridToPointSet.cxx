@@ -19,6 +19,8 @@
 #include "vtkRectilinearGridToPointSet.h"
 
 #include "vtkCellData.h"
+#include "vtkImplicitArray.h"
+#include "vtkImplicitArrayFunctions.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -27,12 +29,17 @@
 #include "vtkStructuredGrid.h"
 
 #include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+typedef vtkImplicitArray<double, vtkRectilinearGridPointsFunction>
+  vtkRectilinearGridToPointSetPoints;
 
 vtkStandardNewMacro(vtkRectilinearGridToPointSet);
 
 //-------------------------------------------------------------------------
 vtkRectilinearGridToPointSet::vtkRectilinearGridToPointSet()
 {
+  this->ImplicitPoints = 0;
 }
 
 vtkRectilinearGridToPointSet::~vtkRectilinearGridToPointSet()
@@ -42,6 +49,8 @@ vtkRectilinearGridToPointSet::~vtkRectilinearGridToPointSet()
 void vtkRectilinearGridToPointSet::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ImplicitPoints: " << this->ImplicitPoints << endl;
 }
 
 //-------------------------------------------------------------------------
@@ -70,6 +79,19 @@ int vtkRectilinearGridToPointSet::CopyStructure(vtkStructuredGrid *outData,
   outData->SetExtent(extent);
 
   vtkNew<vtkPoints> points;
+  if (this->ImplicitPoints)
+    {
+    vtkRectilinearGridPointsFunction function(xcoord, ycoord, zcoord);
+    vtkSmartPointer<vtkRectilinearGridToPointSetPoints> coords =
+      vtkSmartPointer<vtkRectilinearGridToPointSetPoints>::New();
+    coords->SetNumberOfComponents(3);
+    coords->SetFunction(function);
+    coords->SetNumberOfTuples(function.GetNumberOfPoints());
+    points->SetData(coords);
+    outData->SetPoints(points.GetPointer());
+    return 1;
+    }
+
   points->SetDataTypeToDouble();
   points->SetNumberOfPoints(inData->GetNumberOfPoints());
 
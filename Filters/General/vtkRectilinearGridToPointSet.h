@@ -45,6 +45,14 @@ public:
 
   static vtkRectilinearGridToPointSet *New();
 
+  // Description:
+  // When on, the points of the output are a vtkImplicitArray that computes
+  // the coordinates from the coordinate arrays of the input on demand, instead
+  // of storing them. Off by default.
+  vtkSetMacro(ImplicitPoints, int);
+  vtkGetMacro(ImplicitPoints, int);
+  vtkBooleanMacro(ImplicitPoints, int);
+
 protected:
   vtkRectilinearGridToPointSet();
   ~vtkRectilinearGridToPointSet();
@@ -55,6 +63,8 @@ protected:
 
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  int ImplicitPoints;
+
 private:
   vtkRectilinearGridToPointSet(const vtkRectilinearGridToPointSet &); // Not implemented
   void operator=(const vtkRectilinearGridToPointSet &);         // Not implemented
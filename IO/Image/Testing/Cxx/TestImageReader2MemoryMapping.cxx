@@ -0,0 +1,216 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageReader2MemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Read a raw volume with and without memory mapping and compare.
+
+#include "vtkImageData.h"
+#include "vtkImageReader.h"
+#include "vtkImageReader2.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedShortArray.h"
+
+#include <cstdio>
+
+static const int Dims[3] = { 16, 12, 10 };
+static const int Components = 2;
+static const int HeaderSize = 64;
+
+static unsigned short FileValue(int x, int y, int z, int c)
+{
+  return static_cast<unsigned short>(((z * 37 + y) * 53 + x) * 2 + c);
+}
+
+// Compare the scalars of an output with the values of the file over
+// its extent.
+static bool CheckOutput(vtkImageData *image, bool swapped)
+{
+  int ext[6];
+  image->GetExtent(ext);
+  vtkUnsignedShortArray *scalars = vtkUnsignedShortArray::SafeDownCast(
+    image->GetPointData()->GetScalars());
+  if (!scalars || scalars->GetNumberOfComponents() != Components)
+    {
+    return false;
+    }
+  vtkIdType id = 0;
+  for (int z = ext[4]; z <= ext[5]; ++z)
+    {
+    for (int y = ext[2]; y <= ext[3]; ++y)
+      {
+      for (int x = ext[0]; x <= ext[1]; ++x)
+        {
+        for (int c = 0; c < Components; ++c, ++id)
+          {
+          unsigned short value = FileValue(x, y, z, c);
+          if (swapped)
+            {
+            value = static_cast<unsigned short>((value >> 8) | (value << 8));
+            }
+          if (scalars->GetValue(id) != value)
+            {
+            return false;
+            }
+          }
+        }
+      }
+    }
+  return id == scalars->GetNumberOfTuples() * Components;
+}
+
+static void SetUp(vtkImageReader2 *reader, const char *fileName)
+{
+  reader->SetFileName(fileName);
+  reader->SetFileDimensionality(3);
+  reader->SetDataScalarTypeToUnsignedShort();
+  reader->SetNumberOfScalarComponents(Components);
+  reader->SetDataExtent(0, Dims[0] - 1, 0, Dims[1] - 1, 0, Dims[2] - 1);
+  reader->SetHeaderSize(HeaderSize);
+  reader->FileLowerLeftOn();
+#ifdef VTK_WORDS_BIGENDIAN
+  reader->SetDataByteOrderToBigEndian();
+#else
+  reader->SetDataByteOrderToLittleEndian();
+#endif
+}
+
+int TestImageReader2MemoryMapping(int argc, char *argv[])
+{
+  if (argc < 2)
+    {
+    cout << "Usage: " << argv[0] << " outputFilename" << endl;
+    return EXIT_FAILURE;
+    }
+  const char *fileName = argv[1];
+
+  FILE *fp = fopen(fileName, "wb");
+  if (fp == NULL)
+    {
+    cerr << "Cannot write " << fileName << endl;
+    return EXIT_FAILURE;
+    }
+  char header[HeaderSize] = "raw volume";
+  fwrite(header, 1, HeaderSize, fp);
+  for (int z = 0; z < Dims[2]; ++z)
+    {
+    for (int y = 0; y < Dims[1]; ++y)
+      {
+      for (int x = 0; x < Dims[0]; ++x)
+        {
+        for (int c = 0; c < Components; ++c)
+          {
+          unsigned short value = FileValue(x, y, z, c);
+          fwrite(&value, sizeof(value), 1, fp);
+          }
+        }
+      }
+    }
+  fclose(fp);
+
+  // The whole volume.
+  vtkSmartPointer<vtkImageReader2> reader =
+    vtkSmartPointer<vtkImageReader2>::New();
+  SetUp(reader, fileName);
+  reader->MemoryMappingOn();
+  reader->Update();
+  vtkImageData *output = reader->GetOutput();
+  if (!CheckOutput(output, false))
+    {
+    cerr << "Wrong values in the mapped volume" << endl;
+    return EXIT_FAILURE;
+    }
+  if (strcmp(output->GetPointData()->GetScalars()->GetName(), "ImageFile"))
+    {
+    cerr << "Wrong scalars name for the mapped volume" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The output is a copy-on-write mapping: changing it leaves the file
+  // alone.
+  vtkUnsignedShortArray::SafeDownCast(output->GetPointData()->GetScalars())
+    ->SetValue(0, 12345);
+  vtkSmartPointer<vtkImageReader2> plain =
+    vtkSmartPointer<vtkImageReader2>::New();
+  SetUp(plain, fileName);
+  plain->Update();
+  if (!CheckOutput(plain->GetOutput(), false))
+    {
+    cerr << "Changing the mapped output modified the file" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // A range of slices is mapped from the middle of the file. The
+  // reader is modified so that it executes for the smaller extent.
+  int slices[6] = { 0, Dims[0] - 1, 0, Dims[1] - 1, 3, 6 };
+  reader->Modified();
+  reader->UpdateInformation();
+  reader->SetUpdateExtent(slices);
+  reader->Update();
+  output = reader->GetOutput();
+  if (output->GetExtent()[4] != 3 || output->GetExtent()[5] != 6)
+    {
+    cerr << "Wrong extent for the mapped slices" << endl;
+    return EXIT_FAILURE;
+    }
+  if (!CheckOutput(output, false))
+    {
+    cerr << "Wrong values in the mapped slices" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Partial rows cannot be mapped and are read.
+  int rows[6] = { 2, 9, 1, 5, 2, 4 };
+  reader->Modified();
+  reader->UpdateInformation();
+  reader->SetUpdateExtent(rows);
+  reader->Update();
+  if (!CheckOutput(reader->GetOutput(), false))
+    {
+    cerr << "Wrong values for partial rows" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // Swapped data is read as well.
+  vtkSmartPointer<vtkImageReader2> swapped =
+    vtkSmartPointer<vtkImageReader2>::New();
+  SetUp(swapped, fileName);
+  swapped->SetSwapBytes(!swapped->GetSwapBytes());
+  swapped->MemoryMappingOn();
+  swapped->Update();
+  if (!CheckOutput(swapped->GetOutput(), true))
+    {
+    cerr << "Wrong values for swapped data" << endl;
+    return EXIT_FAILURE;
+    }
+
+  // vtkImageReader maps the file too.
+  vtkSmartPointer<vtkImageReader> raw = vtkSmartPointer<vtkImageReader>::New();
+  SetUp(raw, fileName);
+  raw->SetScalarArrayName("values");
+  raw->MemoryMappingOn();
+  raw->Update();
+  if (!CheckOutput(raw->GetOutput(), false))
+    {
+    cerr << "Wrong values read by vtkImageReader" << endl;
+    return EXIT_FAILURE;
+    }
+  if (strcmp(raw->GetOutput()->GetPointData()->GetScalars()->GetName(),
+             "values"))
+    {
+    cerr << "Wrong scalars name for vtkImageReader" << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -418,6 +418,15 @@ void vtkImageReaderUpdate1(vtkImageReader *self, vtkImageData *data, T *inPtr)
 void vtkImageReader::ExecuteDataWithInformation(vtkDataObject *output,
                                                 vtkInformation *outInfo)
 {
+  // The file can only be used as is when no mask or transform applies.
+  if (!this->Transform && this->DataMask == static_cast<vtkTypeUInt64>(~0UL) &&
+      this->MapOutputData(vtkImageData::SafeDownCast(output), outInfo))
+    {
+    vtkImageData::SafeDownCast(output)->GetPointData()->GetScalars()
+      ->SetName(this->ScalarArrayName);
+    return;
+    }
+
   vtkImageData *data = this->AllocateOutputData(output, outInfo);
 
   void *ptr = NULL;
@@ -19,6 +19,7 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
@@ -69,6 +70,8 @@ vtkImageReader2::vtkImageReader2()
   this->FileNameSliceOffset = 0;
   this->FileNameSliceSpacing = 1;
 
+  this->MemoryMapping = 0;
+
   // Left over from short reader
   this->SwapBytes = 0;
   this->FileLowerLeft = 0;
@@ -453,6 +456,8 @@ void vtkImageReader2::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Swap Bytes: " << (this->SwapBytes ? "On\n" : "Off\n");
 
+  os << indent << "MemoryMapping: " << (this->MemoryMapping ? "On\n" : "Off\n");
+
   os << indent << "DataIncrements: (" << this->DataIncrements[0];
   for (idx = 1; idx < 2; ++idx)
     {
@@ -799,12 +804,72 @@ void vtkImageReader2Update(vtkImageReader2 *self, vtkImageData *data, OT *outPtr
     }
 }
 
+//----------------------------------------------------------------------------
+// The slices of the update extent are contiguous in a three dimensional
+// file when whole rows and slices are requested, so the file region can
+// be used as the scalars without reading it.
+int vtkImageReader2::MapOutputData(vtkImageData *data, vtkInformation *outInfo)
+{
+  int *uExt = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
+  if (!this->MemoryMapping || !data || !uExt ||
+      (!this->FileName && !this->FilePattern) ||
+      this->GetFileDimensionality() != 3 || !this->FileLowerLeft ||
+      this->GetSwapBytes() ||
+      uExt[0] != this->DataExtent[0] || uExt[1] != this->DataExtent[1] ||
+      uExt[2] != this->DataExtent[2] || uExt[3] != this->DataExtent[3] ||
+      uExt[4] > uExt[5] ||
+      vtkImageData::GetScalarType(outInfo) != this->DataScalarType ||
+      vtkImageData::GetNumberOfScalarComponents(outInfo) !=
+      this->NumberOfScalarComponents)
+    {
+    return 0;
+    }
+
+  this->ComputeDataIncrements();
+  vtkTypeInt64 offset = static_cast<vtkTypeInt64>(this->GetHeaderSize(uExt[4]))
+    + static_cast<vtkTypeInt64>(uExt[4] - this->DataExtent[4])
+    * static_cast<vtkTypeInt64>(this->DataIncrements[2]);
+  vtkTypeInt64 length = static_cast<vtkTypeInt64>(uExt[5] - uExt[4] + 1)
+    * static_cast<vtkTypeInt64>(this->DataIncrements[2]);
+  vtkIdType numberOfValues =
+    static_cast<vtkIdType>(uExt[1] - uExt[0] + 1) *
+    static_cast<vtkIdType>(uExt[3] - uExt[2] + 1) *
+    static_cast<vtkIdType>(uExt[5] - uExt[4] + 1) *
+    this->NumberOfScalarComponents;
+  this->ComputeInternalFileName(0);
+
+  vtkMemoryMappedFile *file = vtkMemoryMappedFile::New();
+  vtkDataArray *scalars = vtkDataArray::CreateDataArray(this->DataScalarType);
+  scalars->SetNumberOfComponents(this->NumberOfScalarComponents);
+  int mapped =
+    file->Map(this->InternalFileName, offset, length,
+              vtkMemoryMappedFile::CopyOnWrite) &&
+    scalars->SetMappedStorage(file, 0, numberOfValues);
+  if (mapped)
+    {
+    vtkDebugMacro("Mapped " << length << " bytes of "
+                  << this->InternalFileName << " at offset " << offset);
+    data->SetExtent(uExt);
+    data->GetPointData()->SetScalars(scalars);
+    }
+  scalars->Delete();
+  file->Delete();
+  return mapped;
+}
+
 //----------------------------------------------------------------------------
 // This function reads a data from a file.  The datas extent/axes
 // are assumed to be the same as the file extent/order.
 void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject *output,
                                                  vtkInformation *outInfo)
 {
+  if (this->MapOutputData(vtkImageData::SafeDownCast(output), outInfo))
+    {
+    vtkImageData::SafeDownCast(output)->GetPointData()->GetScalars()
+      ->SetName("ImageFile");
+    return;
+    }
+
   vtkImageData *data = this->AllocateOutputData(output, outInfo);
 
   void *ptr;
@@ -194,6 +194,17 @@ public:
   vtkGetMacro(FileLowerLeft, int);
   vtkSetMacro(FileLowerLeft, int);
 
+  // Description:
+  // When on, a three dimensional raw file that can be used as is (native
+  // byte order, lower left origin, whole slices requested) is mapped into
+  // memory with vtkMemoryMappedFile instead of being read: the output
+  // scalars point into a copy-on-write mapping of the file and pages are
+  // only loaded when accessed. Falls back to reading otherwise. Off by
+  // default.
+  vtkSetMacro(MemoryMapping, int);
+  vtkGetMacro(MemoryMapping, int);
+  vtkBooleanMacro(MemoryMapping, int);
+
   // Description:
   // Set/Get the internal file name
   virtual void ComputeInternalFileName(int slice);
@@ -256,12 +267,20 @@ protected:
   int FileNameSliceOffset;
   int FileNameSliceSpacing;
 
+  int MemoryMapping;
+
   virtual int RequestInformation(vtkInformation* request,
                                  vtkInformationVector** inputVector,
                                  vtkInformationVector* outputVector);
   virtual void ExecuteInformation();
   virtual void ExecuteDataWithInformation(vtkDataObject *data, vtkInformation *outInfo);
   virtual void ComputeDataIncrements();
+
+  // Description:
+  // Use a mapping of the file as the output scalars for the update
+  // extent if MemoryMapping is on and the file layout allows it.
+  // Returns 1 if the output is set up, 0 if the data must be read.
+  virtual int MapOutputData(vtkImageData *data, vtkInformation *outInfo);
 private:
   vtkImageReader2(const vtkImageReader2&);  // Not implemented.
   void operator=(const vtkImageReader2&);  // Not implemented.
@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLImageDataMemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write an image with raw appended data and read it back with and
+// without memory mapping.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+namespace
+{
+bool CompareArrays(vtkDataArray *a, vtkDataArray *b)
+{
+  if (!a || !b || a->GetDataType() != b->GetDataType() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+      a->GetNumberOfTuples() != b->GetNumberOfTuples())
+    {
+    return false;
+    }
+  vtkIdType n = a->GetNumberOfTuples() * a->GetNumberOfComponents();
+  return memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0),
+                static_cast<size_t>(n * a->GetDataTypeSize())) == 0;
+}
+
+bool CompareImages(vtkImageData *a, vtkImageData *b)
+{
+  const char *names[3] = { "values", "labels", "vectors" };
+  for (int i = 0; i < 3; ++i)
+    {
+    if (!CompareArrays(a->GetPointData()->GetArray(names[i]),
+                       b->GetPointData()->GetArray(names[i])))
+      {
+      cerr << "Array " << names[i] << " differs." << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestXMLImageDataMemoryMapping(int, char *[])
+{
+  const char filename[] = "TestXMLImageDataMemoryMapping.vti";
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, 19, 0, 14, 0, 9);
+  vtkIdType numberOfPoints = image->GetNumberOfPoints();
+
+  // Arrays of different value sizes. Any array whose data ends up not
+  // aligned for its type in the file is read instead of mapped.
+  vtkSmartPointer<vtkDoubleArray> values =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  values->SetName("values");
+  vtkSmartPointer<vtkUnsignedCharArray> labels =
+    vtkSmartPointer<vtkUnsignedCharArray>::New();
+  labels->SetName("labels");
+  vtkSmartPointer<vtkIntArray> vectors = vtkSmartPointer<vtkIntArray>::New();
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  values->SetNumberOfTuples(numberOfPoints);
+  labels->SetNumberOfTuples(numberOfPoints);
+  vectors->SetNumberOfTuples(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+    values->SetValue(i, 0.25 * i - 100.0);
+    labels->SetValue(i, static_cast<unsigned char>(i % 7));
+    for (int c = 0; c < 3; ++c)
+      {
+      vectors->SetValue(3 * i + c, static_cast<int>(i * (c + 1)));
+      }
+    }
+  image->GetPointData()->AddArray(values);
+  image->GetPointData()->AddArray(labels);
+  image->GetPointData()->AddArray(vectors);
+
+  vtkSmartPointer<vtkXMLImageDataWriter> writer =
+    vtkSmartPointer<vtkXMLImageDataWriter>::New();
+  writer->SetInputData(image);
+  writer->SetFileName(filename);
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressor(NULL);
+  if (!writer->Write())
+    {
+    cerr << "Cannot write " << filename << endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkSmartPointer<vtkXMLImageDataReader> reader =
+    vtkSmartPointer<vtkXMLImageDataReader>::New();
+  reader->SetFileName(filename);
+  reader->Update();
+
+  vtkSmartPointer<vtkXMLImageDataReader> mappingReader =
+    vtkSmartPointer<vtkXMLImageDataReader>::New();
+  mappingReader->SetFileName(filename);
+  mappingReader->MemoryMappingOn();
+  mappingReader->Update();
+
+  if (!CompareImages(image, reader->GetOutput()) ||
+      !CompareImages(image, mappingReader->GetOutput()))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The mapping is copy-on-write: changing the output does not change
+  // the file.
+  vtkDataArray *mapped =
+    mappingReader->GetOutput()->GetPointData()->GetArray("values");
+  mapped->SetTuple1(0, 1.0e6);
+  reader->Modified();
+  reader->Update();
+  if (!CompareImages(image, reader->GetOutput()))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Compressed data cannot be mapped and is read.
+  writer->SetCompressorTypeToZLib();
+  writer->Write();
+  mappingReader->Modified();
+  mappingReader->Update();
+  if (!CompareImages(image, mappingReader->GetOutput()))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -15,11 +15,13 @@
 #include "vtkXMLReader.h"
 
 #include "vtkCallbackCommand.h"
+#include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataCompressor.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkInstantiator.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataParser.h"
@@ -90,6 +92,7 @@ vtkXMLReader::vtkXMLReader()
   this->InformationError = 0;
   this->DataError = 0;
   this->ReadError = 0;
+  this->MemoryMapping = 0;
   this->ProgressRange[0] = 0;
   this->ProgressRange[1] = 1;
 
@@ -163,6 +166,39 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << ","
                                     << this->TimeStepRange[1] << ")\n";
+  os << indent << "MemoryMapping: " << this->MemoryMapping << "\n";
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLReader::MapAppendedArray(vtkXMLDataElement* da, vtkDataArray* array,
+                                   vtkIdType numValues)
+{
+  // Only data read from our own file can be mapped.
+  vtkTypeInt64 offset = 0;
+  if(!this->MemoryMapping || !array || !this->FileName ||
+     !this->FileStream || this->Stream != this->FileStream ||
+     !da->GetScalarAttribute("offset", offset))
+    {
+    return 0;
+    }
+
+  vtkTypeInt64 position = 0;
+  vtkTypeUInt64 size = 0;
+  vtkTypeUInt64 length =
+    static_cast<vtkTypeUInt64>(numValues) * array->GetDataTypeSize();
+  if(!this->XMLParser->FindRawAppendedData(offset, position, size) ||
+     size < length)
+    {
+    return 0;
+    }
+
+  vtkMemoryMappedFile* file = vtkMemoryMappedFile::New();
+  int result =
+    file->Map(this->FileName, position, static_cast<vtkTypeInt64>(length),
+              vtkMemoryMappedFile::CopyOnWrite) &&
+    array->SetMappedStorage(file, 0, numValues);
+  file->Delete();
+  return result;
 }
 
 //----------------------------------------------------------------------------
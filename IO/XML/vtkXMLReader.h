@@ -26,6 +26,7 @@
 
 class vtkAbstractArray;
 class vtkCallbackCommand;
+class vtkDataArray;
 class vtkDataArraySelection;
 class vtkDataSet;
 class vtkDataSetAttributes;
@@ -96,6 +97,17 @@ public:
   vtkGetVector2Macro(TimeStepRange, int);
   vtkSetVector2Macro(TimeStepRange, int);
 
+  // Description:
+  // When on, arrays stored in the appended data section of the file
+  // with raw encoding, no compression and the native byte order are
+  // not read: whole arrays use a copy-on-write mapping of the file as
+  // storage (see vtkMemoryMappedFile) and pages are only loaded when
+  // accessed. Arrays that are not suitably aligned in the file are read
+  // as usual. Off by default.
+  vtkSetMacro(MemoryMapping, int);
+  vtkGetMacro(MemoryMapping, int);
+  vtkBooleanMacro(MemoryMapping, int);
+
   virtual int ProcessRequest(vtkInformation *request,
                              vtkInformationVector **inputVector,
                              vtkInformationVector *outputVector);
@@ -244,6 +256,15 @@ protected:
   // Whether there was an error reading the XML.
   int ReadError;
 
+  // Whether appended arrays are mapped instead of read.
+  int MemoryMapping;
+
+  // Use the appended data of the given array element as the storage of
+  // the first numValues values of the array when MemoryMapping is on and
+  // the data can be used in place.  Returns 0 if the values must be read.
+  int MapAppendedArray(vtkXMLDataElement* da, vtkDataArray* array,
+                       vtkIdType numValues);
+
   // For structured data keep track of dimensions empty of cells.  For
   // unstructured data these are always zero.  This is used to support
   // 1-D and 2-D cell data.
@@ -911,6 +911,43 @@ size_t vtkXMLDataParser::ReadAppendedData(vtkTypeInt64 offset,
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::FindRawAppendedData(vtkTypeInt64 offset,
+                                          vtkTypeInt64& position,
+                                          vtkTypeUInt64& size)
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  int nativeByteOrder = vtkXMLDataParser::BigEndian;
+#else
+  int nativeByteOrder = vtkXMLDataParser::LittleEndian;
+#endif
+  if(!this->AppendedDataPosition || this->Compressor ||
+     this->ByteOrder != nativeByteOrder ||
+     vtkBase64InputStream::SafeDownCast(this->AppendedDataStream))
+    {
+    return 0;
+    }
+
+  // Read the length of the data from its header.
+  vtksys::auto_ptr<vtkXMLDataHeader>
+    uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  this->DataStream = this->AppendedDataStream;
+  this->SeekG(this->AppendedDataPosition+offset);
+  this->DataStream->SetStream(this->Stream);
+  this->DataStream->StartReading();
+  size_t r = this->DataStream->Read(uh->Data(), headerSize);
+  this->DataStream->EndReading();
+  if(r < headerSize)
+    {
+    return 0;
+    }
+
+  position = this->AppendedDataPosition+offset+headerSize;
+  size = uh->Get(0);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -84,6 +84,15 @@ public:
   // stream.  Returns the number of words read.
   size_t ReadBinaryData(void* buffer, vtkTypeUInt64 startWord,
                         size_t maxWords, int wordType);
+
+  // Description:
+  // Locate the data of an appended data section that can be used in
+  // place, without decoding: raw encoding, no compressor and the native
+  // byte order. On success, position is set to the absolute stream
+  // position of the first byte of data, size to the number of bytes
+  // and 1 is returned. Returns 0 if the data must be read.
+  int FindRawAppendedData(vtkTypeInt64 offset, vtkTypeInt64& position,
+                          vtkTypeUInt64& size);
   //ETX
 
   // Description:
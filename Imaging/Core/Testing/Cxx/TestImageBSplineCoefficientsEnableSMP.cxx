@@ -0,0 +1,72 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageBSplineCoefficientsEnableSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkImageBSplineCoefficients with EnableSMP on by default
+// .SECTION Description
+// Computes the b-spline coefficients of the wavelet with the global default
+// of EnableSMP off and on, and checks that the outputs are the same: the
+// filter, which must not be split along the axis it processes, keeps
+// EnableSMP off.
+
+#include "vtkDataArray.h"
+#include "vtkImageBSplineCoefficients.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedImageAlgorithm.h"
+
+//------------------------------------------------------------------------------
+// The coefficients of the wavelet.
+static vtkSmartPointer<vtkImageData> ComputeCoefficients()
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(0, 31, 0, 31, 0, 31);
+  vtkNew<vtkImageBSplineCoefficients> coefficients;
+  coefficients->SetInputConnection(wavelet->GetOutputPort());
+  coefficients->Update();
+
+  vtkSmartPointer<vtkImageData> output = vtkSmartPointer<vtkImageData>::New();
+  output->DeepCopy(coefficients->GetOutput());
+  return output;
+}
+
+//------------------------------------------------------------------------------
+int TestImageBSplineCoefficientsEnableSMP(int, char*[])
+{
+  vtkSmartPointer<vtkImageData> expected = ComputeCoefficients();
+
+  vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(1);
+  vtkSmartPointer<vtkImageData> output = ComputeCoefficients();
+  vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(0);
+
+  vtkDataArray* a = expected->GetPointData()->GetScalars();
+  vtkDataArray* b = output->GetPointData()->GetScalars();
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples())
+    {
+    cerr << "Wrong size of output" << endl;
+    return EXIT_FAILURE;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    if (a->GetComponent(i, 0) != b->GetComponent(i, 0))
+      {
+      cerr << "Wrong coefficient at point " << i << endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
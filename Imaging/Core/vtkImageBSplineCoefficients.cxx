@@ -38,6 +38,8 @@ vtkImageBSplineCoefficients::vtkImageBSplineCoefficients()
   this->Bypass = 0;
   this->DataWasPassed = 0;
   this->Iteration = 0;
+  // each iteration filters whole rows along one axis
+  this->EnableSMP = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -33,6 +33,18 @@ vtkImageCast::vtkImageCast()
 }
 
 
+//----------------------------------------------------------------------------
+int vtkImageCast::ComputeModifiedOutputExtent(
+  int vtkNotUsed(inputPort), int vtkNotUsed(connection),
+  int inExt[6], int outExt[6])
+{
+  for (int idx = 0; idx < 6; ++idx)
+    {
+    outExt[idx] = inExt[idx];
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // Just change the Image type.
 int vtkImageCast::RequestInformation (
@@ -69,6 +69,11 @@ public:
   vtkGetMacro(ClampOverflow, int);
   vtkBooleanMacro(ClampOverflow, int);
 
+  // Description:
+  // Casting is done voxel by voxel: the output only changes where the
+  // input changed.
+  virtual int ComputeModifiedOutputExtent(int inputPort, int connection,
+                                          int inExt[6], int outExt[6]);
 
 protected:
   vtkImageCast();
@@ -35,6 +35,9 @@ vtkImageDifference::vtkImageDifference()
   this->AllowShift = 1;
   this->Averaging = 1;
   this->SetNumberOfInputPorts(2);
+  // the errors are reset at each call of ThreadedRequestData() and summed
+  // over NumberOfThreads, which the bricks of EnableSMP would break
+  this->EnableSMP = 0;
 }
 
 
@@ -277,6 +277,18 @@ void vtkImageMask::ThreadedRequestData(
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkImageMask::ComputeModifiedOutputExtent(
+  int vtkNotUsed(inputPort), int vtkNotUsed(connection),
+  int inExt[6], int outExt[6])
+{
+  for (int idx = 0; idx < 6; ++idx)
+    {
+    outExt[idx] = inExt[idx];
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // The output extent is the intersection.
 int vtkImageMask::RequestInformation (
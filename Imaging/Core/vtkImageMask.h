@@ -80,6 +80,12 @@ public:
   virtual void SetInput1Data(vtkDataObject *in) { this->SetInputData(0,in); }
   virtual void SetInput2Data(vtkDataObject *in) { this->SetInputData(1,in); }
 
+  // Description:
+  // Each output voxel depends on the image and mask voxels at the same
+  // place only.
+  virtual int ComputeModifiedOutputExtent(int inputPort, int connection,
+                                          int inExt[6], int outExt[6]);
+
 protected:
   vtkImageMask();
   ~vtkImageMask();
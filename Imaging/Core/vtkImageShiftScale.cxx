@@ -48,6 +48,18 @@ void vtkImageShiftScale::PrintSelf(ostream& os, vtkIndent indent)
      << "\n";
 }
 
+//----------------------------------------------------------------------------
+int vtkImageShiftScale::ComputeModifiedOutputExtent(
+  int vtkNotUsed(inputPort), int vtkNotUsed(connection),
+  int inExt[6], int outExt[6])
+{
+  for (int idx = 0; idx < 6; ++idx)
+    {
+    outExt[idx] = inExt[idx];
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkImageShiftScale::RequestInformation(vtkInformation*,
                                            vtkInformationVector**,
@@ -78,6 +78,12 @@ public:
   vtkGetMacro(ClampOverflow, int);
   vtkBooleanMacro(ClampOverflow, int);
 
+  // Description:
+  // Each output value is computed from the input value at the same
+  // place, so only the modified extent of the input is recomputed.
+  virtual int ComputeModifiedOutputExtent(int inputPort, int connection,
+                                          int inExt[6], int outExt[6]);
+
 protected:
   vtkImageShiftScale();
   ~vtkImageShiftScale();
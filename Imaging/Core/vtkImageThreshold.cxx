@@ -96,6 +96,18 @@ void vtkImageThreshold::ThresholdBetween(double lower, double upper)
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkImageThreshold::ComputeModifiedOutputExtent(
+  int vtkNotUsed(inputPort), int vtkNotUsed(connection),
+  int inExt[6], int outExt[6])
+{
+  for (int idx = 0; idx < 6; ++idx)
+    {
+    outExt[idx] = inExt[idx];
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkImageThreshold::RequestInformation (
   vtkInformation * vtkNotUsed(request),
@@ -99,6 +99,12 @@ public:
   void SetOutputScalarTypeToUnsignedChar()
     {this->SetOutputScalarType(VTK_UNSIGNED_CHAR);}
 
+  // Description:
+  // Thresholding is done voxel by voxel: the output only changes where
+  // the input changed.
+  virtual int ComputeModifiedOutputExtent(int inputPort, int connection,
+                                          int inExt[6], int outExt[6]);
+
 protected:
   vtkImageThreshold();
   ~vtkImageThreshold() {};
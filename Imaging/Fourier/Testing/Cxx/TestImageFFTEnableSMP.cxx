@@ -0,0 +1,86 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageFFTEnableSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkImageFFT with EnableSMP on by default
+// .SECTION Description
+// Transforms the wavelet with vtkImageFFT and back with vtkImageRFFT, with
+// the global default of EnableSMP off and on, and checks that the outputs
+// are the same: the filters, which split their extents along the axes
+// they do not process, keep EnableSMP off.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageFFT.h"
+#include "vtkImageRFFT.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedImageAlgorithm.h"
+
+//------------------------------------------------------------------------------
+// The forward and inverse transforms of the wavelet.
+static void Transform(vtkSmartPointer<vtkImageData> outputs[2])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(0, 31, 0, 31, 0, 31);
+  vtkNew<vtkImageFFT> fft;
+  fft->SetInputConnection(wavelet->GetOutputPort());
+  vtkNew<vtkImageRFFT> rfft;
+  rfft->SetInputConnection(fft->GetOutputPort());
+  rfft->Update();
+
+  outputs[0] = vtkSmartPointer<vtkImageData>::New();
+  outputs[0]->DeepCopy(fft->GetOutput());
+  outputs[1] = vtkSmartPointer<vtkImageData>::New();
+  outputs[1]->DeepCopy(rfft->GetOutput());
+}
+
+//------------------------------------------------------------------------------
+int TestImageFFTEnableSMP(int, char*[])
+{
+  vtkSmartPointer<vtkImageData> expected[2];
+  Transform(expected);
+
+  vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(1);
+  vtkSmartPointer<vtkImageData> outputs[2];
+  Transform(outputs);
+  vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(0);
+
+  for (int i = 0; i < 2; ++i)
+    {
+    vtkDataArray* a = expected[i]->GetPointData()->GetScalars();
+    vtkDataArray* b = outputs[i]->GetPointData()->GetScalars();
+    if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+        a->GetNumberOfComponents() != b->GetNumberOfComponents())
+      {
+      cerr << "Wrong size of output " << i << endl;
+      return EXIT_FAILURE;
+      }
+    for (vtkIdType j = 0; j < a->GetNumberOfTuples(); ++j)
+      {
+      for (int k = 0; k < a->GetNumberOfComponents(); ++k)
+        {
+        if (a->GetComponent(j, k) != b->GetComponent(j, k))
+          {
+          cerr << "Wrong value in output " << i << " at point " << j
+               << endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
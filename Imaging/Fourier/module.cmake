@@ -4,4 +4,6 @@ vtk_module(vtkImagingFourier
     StandAlone
   DEPENDS
     vtkImagingCore
+  TEST_DEPENDS
+    vtkTestingCore
   )
@@ -24,6 +24,13 @@
 
 vtkStandardNewMacro(vtkImageFFT);
 
+//----------------------------------------------------------------------------
+vtkImageFFT::vtkImageFFT()
+{
+  // each pass transforms whole rows along one axis
+  this->EnableSMP = 0;
+}
+
 //----------------------------------------------------------------------------
 // This extent of the components changes to real and imaginary values.
 int vtkImageFFT::IterativeRequestInformation(
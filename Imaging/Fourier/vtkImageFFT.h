@@ -50,7 +50,7 @@ public:
                   int num, int total);
 
 protected:
-  vtkImageFFT() {};
+  vtkImageFFT();
   ~vtkImageFFT() {};
 
   virtual int IterativeRequestInformation(vtkInformation* in,
@@ -24,6 +24,13 @@
 
 vtkStandardNewMacro(vtkImageRFFT);
 
+//----------------------------------------------------------------------------
+vtkImageRFFT::vtkImageRFFT()
+{
+  // each pass inverts whole rows along one axis
+  this->EnableSMP = 0;
+}
+
 //----------------------------------------------------------------------------
 // This extent of the components changes to real and imaginary values.
 int vtkImageRFFT::IterativeRequestInformation(
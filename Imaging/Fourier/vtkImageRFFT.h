@@ -56,7 +56,7 @@ public:
                   int num, int total);
 
 protected:
-  vtkImageRFFT() {};
+  vtkImageRFFT();
   ~vtkImageRFFT() {};
 
   virtual int IterativeRequestInformation(vtkInformation* in,
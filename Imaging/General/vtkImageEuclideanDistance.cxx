@@ -32,6 +32,8 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
   this->Initialize = 1;
   this->ConsiderAnisotropy = 1;
   this->Algorithm = VTK_EDT_SAITO;
+  // each pass computes the distances along whole rows of one axis
+  this->EnableSMP = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -141,6 +141,30 @@ void vtkImageGaussianSmooth::InternalRequestUpdateExtent(int *inExt,
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkImageGaussianSmooth::ComputeModifiedOutputExtent(
+  int vtkNotUsed(inputPort), int vtkNotUsed(connection),
+  int inExt[6], int outExt[6])
+{
+  int idx, radius;
+
+  for (idx = 0; idx < 6; ++idx)
+    {
+    outExt[idx] = inExt[idx];
+    }
+
+  // The kernel is symmetric: expand filtered axes by its radius
+  for (idx = 0; idx < this->Dimensionality; ++idx)
+    {
+    radius = static_cast<int>(this->StandardDeviations[idx]
+                              * this->RadiusFactors[idx]);
+    outExt[idx*2] -= radius;
+    outExt[idx*2+1] += radius;
+    }
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // For a given position along the convolution axis, this method loops over
 // all other axes, and performs the convolution. Boundary conditions handled
@@ -70,6 +70,12 @@ public:
   vtkSetMacro(Dimensionality, int);
   vtkGetMacro(Dimensionality, int);
 
+  // Description:
+  // A modified input extent modifies the output voxels that are within
+  // the radius of the kernel along the filtered axes.
+  virtual int ComputeModifiedOutputExtent(int inputPort, int connection,
+                                          int inExt[6], int outExt[6]);
+
 protected:
   vtkImageGaussianSmooth();
   ~vtkImageGaussianSmooth();